@@ -125,6 +125,11 @@
 #define configUSE_MUTEXES						1
 #define configQUEUE_REGISTRY_SIZE				8
 #define configCHECK_FOR_STACK_OVERFLOW			2
+
+/* Set to 1 to place a no-access MMU page below each task stack, in which case
+vApplicationStackGuardHook() must also be provided.  See the comments in
+portmacro.h.  Also used by FreeRTOS_asm_vectors.S. */
+#define configUSE_STACK_GUARD_PAGES				0
 #define configUSE_RECURSIVE_MUTEXES				1
 #define configUSE_MALLOC_FAILED_HOOK			1
 #define configUSE_APPLICATION_TASK_TAG			0
@@ -164,7 +169,9 @@ comes from the ulHighFrequencyTimerCounts variable which is incremented in a
 high frequency timer that is already being started as part of the interrupt
 nesting test. */
 #define configGENERATE_RUN_TIME_STATS	1
-extern volatile uint32_t ulHighFrequencyTimerCounts;
+#ifndef __ASSEMBLER__
+	extern volatile uint32_t ulHighFrequencyTimerCounts;
+#endif
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #define portGET_RUN_TIME_COUNTER_VALUE() ulHighFrequencyTimerCounts
 
@@ -177,7 +184,9 @@ command interpreter running. */
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
-void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#ifndef __ASSEMBLER__
+	void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#endif
 #define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
 
 
@@ -191,10 +200,11 @@ void vAssertCalled( const char * pcFile, unsigned long ulLine );
  * that is suitable for use on the Zynq MPU.  FreeRTOS_Tick_Handler() must
  * be installed as the peripheral's interrupt handler.
  */
-void vConfigureTickInterrupt( void );
+#ifndef __ASSEMBLER__
+	void vConfigureTickInterrupt( void );
+	void vClearTickInterrupt( void );
+#endif
 #define configSETUP_TICK_INTERRUPT() vConfigureTickInterrupt()
-
-void vClearTickInterrupt( void );
 #define configCLEAR_TICK_INTERRUPT() vClearTickInterrupt()
 
 /* The following constant describe the hardware, and are correct for the
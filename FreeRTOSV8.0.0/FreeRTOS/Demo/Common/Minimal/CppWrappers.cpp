@@ -0,0 +1,513 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the C++ classes declared in freertos.hpp.  The classes are used by
+ * standard demo tasks, so they are tested alongside the other demo tasks and
+ * checked by the same check task.  Requires a C++11 compiler and
+ * configSUPPORT_STATIC_ALLOCATION to be set to 1.
+ *
+ * Queue tasks - A producer task suspends the scheduler using a
+ * freertos::SchedulerLock, fills a freertos::Queue with structures then
+ * checks a further send fails, before resuming the scheduler.  The last
+ * structure is sent to the front of the queue so the sequence numbers are
+ * still in order.  A higher priority consumer task peeks then receives each
+ * structure, and checks both copies are intact and in sequence.
+ *
+ * Mutex tasks - Two tasks of equal priority increment a shared count while
+ * holding a freertos::Mutex through a freertos::LockGuard, yielding between
+ * reading and writing the count so an update that was not protected by the
+ * mutex would be lost.  Every few loops a task holds the mutex across a delay,
+ * during which the other task's attempt to take the mutex with a shorter block
+ * time must fail.
+ *
+ * Lifetime task - Repeatedly creates freertos::Task objects on its own stack
+ * and lets them go out of scope.  Checks a task that ends itself using
+ * deleteSelf() is not deleted again by the destructor, that the destructor
+ * deletes a task that has not ended, and that a task given up using release()
+ * is not deleted by the destructor.  The created tasks have a higher priority
+ * than the lifetime task, so run as soon as they are created.  Only one of
+ * them exists at a time, and the lifetime task waits for the idle task to
+ * free each before creating the next, so the number of tasks checked by the
+ * "death" demo tasks is not upset.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "freertos.hpp"
+
+/* Demo program include files. */
+#include "CppWrappers.h"
+
+/* The stack size of every task created by this file. */
+#define cppSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+/* The number of items the queue can hold. */
+#define cppQUEUE_LENGTH				( 5 )
+
+/* The time the producer task waits between filling the queue. */
+#define cppPRODUCER_DELAY			( ( TickType_t ) 3 )
+
+/* Once every cppHOLD_INTERVAL loops a mutex task holds the mutex across a
+delay of cppHOLD_TICKS.  Before taking the mutex the other task tries to take
+it with a block time of cppTRY_TICKS, which is shorter, so fails when the mutex
+is being held. */
+#define cppHOLD_INTERVAL			( 8UL )
+#define cppHOLD_TICKS				( ( TickType_t ) 3 )
+#define cppTRY_TICKS				( ( TickType_t ) 1 )
+
+/* The time the lifetime task waits after each test, giving the idle task the
+chance to free the TCB of a deleted task before another is created. */
+#define cppLIFETIME_DELAY			( ( TickType_t ) 20 )
+
+/* A block time of 0 just means "don't block". */
+#define cppDONT_BLOCK				( ( TickType_t ) 0 )
+
+/*-----------------------------------------------------------*/
+
+typedef freertos::Task< cppSTACK_SIZE > CppTask;
+
+/* The item sent through the queue.  ulCheck always holds the inverse of
+ulSequence, so a corrupted copy can be detected. */
+struct CppMessage
+{
+	uint32_t ulSequence;
+	uint32_t ulCheck;
+};
+
+/*
+ * The tasks described at the top of this file.
+ */
+static void prvProducerTask( void *pvParameters );
+static void prvConsumerTask( void *pvParameters );
+static void prvMutexTask( void *pvParameters );
+static void prvLifetimeTask( void *pvParameters );
+
+/*
+ * The tasks created by the lifetime task.  prvSelfDeletingTask() ends itself
+ * using deleteSelf().  prvSuspendingTask() suspends itself, and ends itself
+ * using vTaskDelete( NULL ) if it is resumed.
+ */
+static void prvSelfDeletingTask( void *pvParameters );
+static void prvSuspendingTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The queue and mutex used by the tasks.  Being at file scope, they are
+constructed before main() is called. */
+static freertos::Queue< CppMessage, cppQUEUE_LENGTH > xQueue;
+static freertos::Mutex xMutex;
+
+/* The count protected by xMutex, and the number of times each mutex task has
+incremented it. */
+static volatile uint32_t ulSharedCount = 0UL;
+static volatile uint32_t ulMutexLoops[ 2 ] = { 0UL, 0UL };
+
+/* Incremented each time a mutex task fails to take the mutex because the other
+task is holding it. */
+static volatile uint32_t ulMutexTimeouts = 0UL;
+
+/* Incremented as the tests progress, so the check function can tell the tasks
+are still running. */
+static volatile uint32_t ulMessagesReceived = 0UL;
+static volatile uint32_t ulLifetimeCycles = 0UL;
+
+/* Incremented each time a task created by the lifetime task runs. */
+static volatile uint32_t ulTransientRuns = 0UL;
+
+/* Set to pdTRUE if any of the tasks detect an error. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartCppWrapperTasks( UBaseType_t uxPriority )
+{
+	/* The objects hold the stacks of the tasks, so must exist for as long as
+	the tasks do.  They are constructed, and so the tasks are created, the
+	first time this function is called. */
+	static CppTask xProducerTask( prvProducerTask, "CppProd", uxPriority );
+	static CppTask xConsumerTask( prvConsumerTask, "CppCons", uxPriority + 1 );
+	static CppTask xMutexTask1( prvMutexTask, "CppMut1", uxPriority, ( void * ) 0 );
+	static CppTask xMutexTask2( prvMutexTask, "CppMut2", uxPriority, ( void * ) 1 );
+	static CppTask xLifetimeTask( prvLifetimeTask, "CppLife", uxPriority );
+
+	configASSERT( xProducerTask.created() );
+	configASSERT( xConsumerTask.created() );
+	configASSERT( xMutexTask1.created() );
+	configASSERT( xMutexTask2.created() );
+	configASSERT( xLifetimeTask.created() );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+CppMessage xMessage;
+uint32_t ulSequence = 0UL;
+UBaseType_t ux;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		{
+			/* Suspend the scheduler so the consumer task cannot run until the
+			queue has been filled. */
+			freertos::SchedulerLock xLock;
+
+			/* Send all but the first item of the sequence to the back of the
+			queue, then the first item to the front. */
+			for( ux = 1; ux < cppQUEUE_LENGTH; ux++ )
+			{
+				xMessage.ulSequence = ulSequence + ( uint32_t ) ux;
+				xMessage.ulCheck = ~xMessage.ulSequence;
+
+				if( xQueue.send( xMessage, cppDONT_BLOCK ) == false )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+
+			xMessage.ulSequence = ulSequence;
+			xMessage.ulCheck = ~xMessage.ulSequence;
+
+			if( xQueue.sendToFront( xMessage, cppDONT_BLOCK ) == false )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			/* The queue is now full. */
+			if( ( xQueue.spacesAvailable() != 0 ) || ( xQueue.messagesWaiting() != cppQUEUE_LENGTH ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( xQueue.send( xMessage, cppDONT_BLOCK ) != false )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			ulSequence += cppQUEUE_LENGTH;
+
+			/* The scheduler is resumed when xLock goes out of scope, and the
+			consumer task empties the queue. */
+		}
+
+		if( xQueue.messagesWaiting() != 0 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		vTaskDelay( cppPRODUCER_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+CppMessage xPeeked, xReceived;
+uint32_t ulExpected = 0UL;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueue.peek( xPeeked ) == false )
+		{
+			xErrorDetected = pdTRUE;
+			continue;
+		}
+
+		/* Nothing else reads from the queue, so the item that was peeked must
+		still be there. */
+		if( xQueue.receive( xReceived, cppDONT_BLOCK ) == false )
+		{
+			xErrorDetected = pdTRUE;
+			continue;
+		}
+
+		if( ( xPeeked.ulSequence != xReceived.ulSequence ) || ( xPeeked.ulCheck != xReceived.ulCheck ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( ( xReceived.ulSequence != ulExpected ) || ( xReceived.ulCheck != ~ulExpected ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulExpected = xReceived.ulSequence + 1UL;
+		ulMessagesReceived++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void *pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+uint32_t ulCount;
+TaskHandle_t xHolder;
+
+	for( ;; )
+	{
+		{
+			/* First try to take the mutex with a short block time.  This only
+			fails if the other task is holding the mutex across a delay. */
+			freertos::LockGuard< freertos::Mutex > xGuard( xMutex, cppTRY_TICKS );
+
+			if( xGuard.locked() == false )
+			{
+				/* The other task might have given the mutex back since the
+				attempt timed out, but this task cannot be holding it. */
+				xHolder = xSemaphoreGetMutexHolder( xMutex.handle() );
+
+				if( xHolder == xTaskGetCurrentTaskHandle() )
+				{
+					xErrorDetected = pdTRUE;
+				}
+
+				ulMutexTimeouts++;
+			}
+		}
+
+		{
+			freertos::LockGuard< freertos::Mutex > xGuard( xMutex );
+
+			if( xGuard.locked() == false )
+			{
+				/* Should not happen as the block time is indefinite. */
+				xErrorDetected = pdTRUE;
+				continue;
+			}
+
+			/* Yield between reading and writing the count, so the other task
+			would corrupt the count if it could take the mutex. */
+			ulCount = ulSharedCount;
+			taskYIELD();
+			ulSharedCount = ulCount + 1UL;
+			ulMutexLoops[ uxIndex ]++;
+
+			if( ulSharedCount != ( ulMutexLoops[ 0 ] + ulMutexLoops[ 1 ] ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			/* Every few loops, hold the mutex across a delay that is longer than
+			the block time the other task uses on its first attempt. */
+			if( ( ulMutexLoops[ uxIndex ] % cppHOLD_INTERVAL ) == 0UL )
+			{
+				vTaskDelay( cppHOLD_TICKS );
+			}
+
+			/* The mutex is given back when xGuard goes out of scope. */
+		}
+
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLifetimeTask( void *pvParameters )
+{
+const UBaseType_t uxTransientPriority = uxTaskPriorityGet( NULL ) + 1;
+uint32_t ulRunsBefore;
+TaskHandle_t xReleased;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* A task that ends itself using deleteSelf().  The task runs, and
+		ends, before the constructor returns, after which the destructor must
+		not delete it again. */
+		{
+			ulRunsBefore = ulTransientRuns;
+			CppTask xTask( prvSelfDeletingTask, "CppSelf", uxTransientPriority, &xTask );
+
+			if( ( ulTransientRuns != ( ulRunsBefore + 1UL ) ) || ( xTask.created() != false ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		vTaskDelay( cppLIFETIME_DELAY );
+
+		/* A task that is still in existence when its object goes out of scope,
+		so is deleted by the destructor. */
+		{
+			ulRunsBefore = ulTransientRuns;
+			CppTask xTask( prvSuspendingTask, "CppDel", uxTransientPriority );
+
+			if( ( ulTransientRuns != ( ulRunsBefore + 1UL ) ) || ( xTask.created() == false ) || ( eTaskGetState( xTask.handle() ) != eSuspended ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		vTaskDelay( cppLIFETIME_DELAY );
+
+		/* A task that is given up using release(), then resumed so it ends
+		itself using vTaskDelete( NULL ).  The destructor must not delete it
+		again. */
+		{
+			ulRunsBefore = ulTransientRuns;
+			CppTask xTask( prvSuspendingTask, "CppRel", uxTransientPriority );
+
+			xReleased = xTask.release();
+
+			if( ( xReleased == NULL ) || ( xTask.created() != false ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+			else
+			{
+				/* The task has the higher priority so runs to completion before
+				vTaskResume() returns. */
+				vTaskResume( xReleased );
+			}
+
+			if( ulTransientRuns != ( ulRunsBefore + 2UL ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		vTaskDelay( cppLIFETIME_DELAY );
+
+		ulLifetimeCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelfDeletingTask( void *pvParameters )
+{
+CppTask * const pxThisTask = static_cast< CppTask * >( pvParameters );
+
+	ulTransientRuns++;
+
+	/* The object that holds this task is passed in as the parameter. */
+	pxThisTask->deleteSelf();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendingTask( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	ulTransientRuns++;
+	vTaskSuspend( NULL );
+
+	/* Only gets here if the task was released and resumed. */
+	ulTransientRuns++;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreCppWrapperTasksStillRunning( void )
+{
+static uint32_t ulLastMessagesReceived = 0UL, ulLastLifetimeCycles = 0UL, ulLastMutexTimeouts = 0UL;
+static uint32_t ulLastMutexLoops[ 2 ] = { 0UL, 0UL };
+BaseType_t xReturn = pdPASS;
+UBaseType_t ux;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulMessagesReceived == ulLastMessagesReceived )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulLifetimeCycles == ulLastLifetimeCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulMutexTimeouts == ulLastMutexTimeouts )
+	{
+		xReturn = pdFAIL;
+	}
+
+	for( ux = 0; ux < 2; ux++ )
+	{
+		if( ulMutexLoops[ ux ] == ulLastMutexLoops[ ux ] )
+		{
+			xReturn = pdFAIL;
+		}
+
+		ulLastMutexLoops[ ux ] = ulMutexLoops[ ux ];
+	}
+
+	ulLastMessagesReceived = ulMessagesReceived;
+	ulLastLifetimeCycles = ulLifetimeCycles;
+	ulLastMutexTimeouts = ulMutexTimeouts;
+
+	return xReturn;
+}
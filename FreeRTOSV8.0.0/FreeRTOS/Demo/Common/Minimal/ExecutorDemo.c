@@ -0,0 +1,545 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the executor API in executor.h.
+ *
+ * One executor runs all the routines below on the stack of a single task:
+ *
+ * Periodic routine - Uses exDELAY_UNTIL() to run every exPERIOD ticks, and
+ * checks it never runs before its wake time, and is never late by a whole
+ * period.
+ *
+ * Delay routine - Uses exDELAY() and checks the delay is never short.
+ *
+ * Semaphore routine - Blocks in exSEMAPHORE_TAKE() until the control task
+ * gives the semaphore, then blocks again with a short block time, which must
+ * expire as the control task only gives the semaphore once per cycle.
+ *
+ * Queue routine - Blocks in exQUEUE_RECEIVE() and checks that the values sent
+ * by the control task arrive in order.
+ *
+ * Event group routine - Blocks in exEVENT_GROUP_WAIT_BITS() waiting for two
+ * bits that the control task sets a few ticks apart.  Setting the first bit
+ * wakes the executor, but the routine must block again until both bits are
+ * set, and must then clear them.
+ *
+ * Notification routine - Blocks in exWAIT_NOTIFICATION() and is notified from
+ * a software timer callback and, by vExecutorPeriodicISRDemo(), from the tick
+ * hook.
+ *
+ * The control task, which has a priority above that of the executor task,
+ * posts to the routines as described above.  Each cycle it also creates two
+ * routines that record the order in which they run and then end.  The
+ * routine with the higher routine priority is created last, but must run
+ * first.  Routines that end are deleted by the executor.  Before ending, each
+ * tries to receive from an empty queue that is a member of a queue set, which
+ * the executor cannot wait for, so the receive must fail straight away.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "timers.h"
+#include "executor.h"
+
+#if configUSE_QUEUE_SETS != 1
+	#error ExecutorDemo.c needs configUSE_QUEUE_SETS set to 1 in FreeRTOSConfig.h.
+#endif
+
+/* Demo program include files. */
+#include "ExecutorDemo.h"
+
+/* The number of objects the routines block on - the semaphore, the queue and
+the event group. */
+#define exNUM_WAIT_OBJECTS		( 3 )
+
+/* The period of the periodic routine, and the delay used by the delay
+routine. */
+#define exPERIOD				( ( TickType_t ) 10 )
+#define exDELAY_TICKS			( ( TickType_t ) 7 )
+
+/* The short block time used by the semaphore routine, which must expire. */
+#define exSHORT_BLOCK_TICKS		( ( TickType_t ) 5 )
+
+/* The event group bits set by the control task. */
+#define exBIT_0					( ( EventBits_t ) 0x01 )
+#define exBIT_1					( ( EventBits_t ) 0x02 )
+#define exALL_BITS				( exBIT_0 | exBIT_1 )
+
+/* The time between the control task setting the two event group bits, and the
+time the control task waits between cycles. */
+#define exBIT_DELAY				( ( TickType_t ) 3 )
+#define exCYCLE_DELAY			( ( TickType_t ) 50 )
+
+/* The period of the software timer that notifies the notification routine,
+and the number of tick interrupts between the notifications sent by
+vExecutorPeriodicISRDemo(). */
+#define exTIMER_PERIOD			( ( TickType_t ) 20 )
+#define exISR_PERIOD			( 15UL )
+
+/* The routine priorities used. */
+#define exLOW_PRIORITY			( 0 )
+#define exHIGH_PRIORITY			( configMAX_EXECUTOR_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The routines described at the top of this file.
+ */
+static void prvPeriodicRoutine( RoutineHandle_t xHandle, void *pvParameter );
+static void prvDelayRoutine( RoutineHandle_t xHandle, void *pvParameter );
+static void prvSemaphoreRoutine( RoutineHandle_t xHandle, void *pvParameter );
+static void prvQueueRoutine( RoutineHandle_t xHandle, void *pvParameter );
+static void prvEventGroupRoutine( RoutineHandle_t xHandle, void *pvParameter );
+static void prvNotificationRoutine( RoutineHandle_t xHandle, void *pvParameter );
+
+/*
+ * The routines created each cycle by the control task.  The parameter is the
+ * routine priority, which is recorded in uxRunOrder[].
+ */
+static void prvOneShotRoutine( RoutineHandle_t xHandle, void *pvParameter );
+
+/*
+ * The control task described at the top of this file.
+ */
+static void prvExecutorControlTask( void *pvParameters );
+
+/*
+ * The callback of the software timer that notifies the notification routine.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* The executor, and the objects the routines block on. */
+static ExecutorHandle_t xExecutor = NULL;
+static SemaphoreHandle_t xSemaphore = NULL;
+static QueueHandle_t xQueue = NULL;
+static EventGroupHandle_t xEventGroup = NULL;
+
+/* A queue that is a member of a queue set, so cannot be added to the wait set
+of the executor. */
+static QueueHandle_t xSetMemberQueue = NULL;
+
+/* The notification routine, which is notified by the software timer and the
+tick hook. */
+static RoutineHandle_t xNotificationRoutine = NULL;
+
+/* The routine priorities of the one-shot routines, in the order in which they
+ran. */
+static volatile UBaseType_t uxRunOrder[ 2 ];
+static volatile UBaseType_t uxRunCount = 0;
+
+/* Incremented by each routine, and by the control task, so the check function
+can tell they are still running. */
+static volatile uint32_t ulPeriodicCycles = 0UL, ulDelayCycles = 0UL, ulSemaphoreCycles = 0UL;
+static volatile uint32_t ulQueueCycles = 0UL, ulEventGroupCycles = 0UL, ulNotifications = 0UL;
+static volatile uint32_t ulControlCycles = 0UL;
+
+/* Set to pdTRUE if an error is detected. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartExecutorTasks( UBaseType_t uxPriority )
+{
+TimerHandle_t xTimer;
+QueueSetHandle_t xQueueSet;
+
+	xSemaphore = xSemaphoreCreateBinary();
+	xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	xEventGroup = xEventGroupCreate();
+	xExecutor = xExecutorCreate( "Exec", exNUM_WAIT_OBJECTS, uxPriority, configMINIMAL_STACK_SIZE * 2 );
+	xTimer = xTimerCreate( "ExTimer", exTIMER_PERIOD, pdTRUE, NULL, prvTimerCallback );
+	configASSERT( xSemaphore );
+	configASSERT( xQueue );
+	configASSERT( xEventGroup );
+	configASSERT( xExecutor );
+	configASSERT( xTimer );
+
+	xSetMemberQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	xQueueSet = xQueueCreateSet( 1 );
+	configASSERT( xSetMemberQueue );
+	configASSERT( xQueueSet );
+	xQueueAddToSet( xSetMemberQueue, xQueueSet );
+
+	xExecutorCreateRoutine( xExecutor, prvPeriodicRoutine, NULL, exHIGH_PRIORITY, NULL );
+	xExecutorCreateRoutine( xExecutor, prvDelayRoutine, NULL, exLOW_PRIORITY, NULL );
+	xExecutorCreateRoutine( xExecutor, prvSemaphoreRoutine, NULL, exLOW_PRIORITY, NULL );
+	xExecutorCreateRoutine( xExecutor, prvQueueRoutine, NULL, exLOW_PRIORITY, NULL );
+	xExecutorCreateRoutine( xExecutor, prvEventGroupRoutine, NULL, exLOW_PRIORITY, NULL );
+	xExecutorCreateRoutine( xExecutor, prvNotificationRoutine, NULL, exLOW_PRIORITY, &xNotificationRoutine );
+
+	/* The scheduler has not started, so the timer does not start until it
+	does. */
+	xTimerStart( xTimer, 0 );
+
+	xTaskCreate( prvExecutorControlTask, "ExCtrl", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvExecutorControlTask( void *pvParameters )
+{
+uint32_t ulValue = 0UL;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xSemaphoreGive( xSemaphore );
+
+		if( xQueueSend( xQueue, &ulValue, 0 ) == pdPASS )
+		{
+			ulValue++;
+		}
+
+		/* The event group routine is woken by the first bit, but must not
+		return until both are set. */
+		xEventGroupSetBits( xEventGroup, exBIT_0 );
+		vTaskDelay( exBIT_DELAY );
+		xEventGroupSetBits( xEventGroup, exBIT_1 );
+
+		/* This task has a priority above that of the executor task, so both
+		routines are handed to the executor before either runs. */
+		uxRunCount = 0;
+		xExecutorCreateRoutine( xExecutor, prvOneShotRoutine, ( void * ) exLOW_PRIORITY, exLOW_PRIORITY, NULL );
+		xExecutorCreateRoutine( xExecutor, prvOneShotRoutine, ( void * ) exHIGH_PRIORITY, exHIGH_PRIORITY, NULL );
+
+		vTaskDelay( exCYCLE_DELAY );
+
+		if( ( uxRunCount != 2 ) || ( uxRunOrder[ 0 ] != exHIGH_PRIORITY ) || ( uxRunOrder[ 1 ] != exLOW_PRIORITY ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The event group routine cleared the bits. */
+		if( xEventGroupGetBits( xEventGroup ) != 0 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulControlCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+/* Variables that must keep their value while the routine is blocked must be
+static. */
+static TickType_t xLastWakeTime;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		exDELAY_UNTIL( xHandle, &xLastWakeTime, exPERIOD );
+
+		/* The unsigned subtraction wraps if the routine ran early. */
+		if( ( xTaskGetTickCount() - xLastWakeTime ) >= exPERIOD )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulPeriodicCycles++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static TickType_t xTimeBefore;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	for( ;; )
+	{
+		xTimeBefore = xTaskGetTickCount();
+		exDELAY( xHandle, exDELAY_TICKS );
+
+		if( ( xTaskGetTickCount() - xTimeBefore ) < exDELAY_TICKS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulDelayCycles++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static BaseType_t xResult;
+static TickType_t xTimeBefore;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	for( ;; )
+	{
+		exSEMAPHORE_TAKE( xHandle, xSemaphore, portMAX_DELAY, &xResult );
+
+		if( xResult != pdTRUE )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The semaphore is only given once per cycle, so this must time
+		out. */
+		xTimeBefore = xTaskGetTickCount();
+		exSEMAPHORE_TAKE( xHandle, xSemaphore, exSHORT_BLOCK_TICKS, &xResult );
+
+		if( ( xResult != pdFALSE ) || ( ( xTaskGetTickCount() - xTimeBefore ) < exSHORT_BLOCK_TICKS ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulSemaphoreCycles++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static BaseType_t xResult;
+static uint32_t ulValue, ulExpectedValue = 0UL;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	for( ;; )
+	{
+		exQUEUE_RECEIVE( xHandle, xQueue, &ulValue, portMAX_DELAY, &xResult );
+
+		if( ( xResult != pdTRUE ) || ( ulValue != ulExpectedValue ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulExpectedValue = ulValue + 1UL;
+		ulQueueCycles++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventGroupRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static EventBits_t uxBits;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	for( ;; )
+	{
+		exEVENT_GROUP_WAIT_BITS( xHandle, xEventGroup, exALL_BITS, pdTRUE, pdTRUE, portMAX_DELAY, &uxBits );
+
+		if( ( uxBits & exALL_BITS ) != exALL_BITS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulEventGroupCycles++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotificationRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static BaseType_t xResult;
+
+	( void ) pvParameter;
+
+	exSTART( xHandle );
+
+	for( ;; )
+	{
+		exWAIT_NOTIFICATION( xHandle, portMAX_DELAY, &xResult );
+
+		if( xResult != pdTRUE )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulNotifications++;
+	}
+
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvOneShotRoutine( RoutineHandle_t xHandle, void *pvParameter )
+{
+static BaseType_t xResult;
+static uint32_t ulValue;
+
+	exSTART( xHandle );
+
+	if( uxRunCount < 2 )
+	{
+		uxRunOrder[ uxRunCount ] = ( UBaseType_t ) pvParameter;
+	}
+
+	uxRunCount++;
+
+	/* The queue cannot be waited for, so the receive fails without
+	blocking, however long the block time. */
+	exQUEUE_RECEIVE( xHandle, xSetMemberQueue, &ulValue, portMAX_DELAY, &xResult );
+
+	if( xResult != pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Running to the end deletes the routine. */
+	exEND( xHandle );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	xExecutorNotifyRoutine( xNotificationRoutine );
+}
+/*-----------------------------------------------------------*/
+
+void vExecutorPeriodicISRDemo( void )
+{
+static uint32_t ulCallCount = 0UL;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook().  The tick interrupt performs a context
+	switch if one is needed, so xHigherPriorityTaskWoken is not used. */
+	ulCallCount++;
+
+	if( ulCallCount >= exISR_PERIOD )
+	{
+		ulCallCount = 0UL;
+		xExecutorNotifyRoutineFromISR( xNotificationRoutine, &xHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreExecutorTasksStillRunning( void )
+{
+static uint32_t ulLastPeriodicCycles = 0UL, ulLastDelayCycles = 0UL, ulLastSemaphoreCycles = 0UL;
+static uint32_t ulLastQueueCycles = 0UL, ulLastEventGroupCycles = 0UL, ulLastNotifications = 0UL;
+static uint32_t ulLastControlCycles = 0UL;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( ulPeriodicCycles == ulLastPeriodicCycles ) || ( ulDelayCycles == ulLastDelayCycles ) || ( ulSemaphoreCycles == ulLastSemaphoreCycles ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( ulQueueCycles == ulLastQueueCycles ) || ( ulEventGroupCycles == ulLastEventGroupCycles ) || ( ulNotifications == ulLastNotifications ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulControlCycles == ulLastControlCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastPeriodicCycles = ulPeriodicCycles;
+	ulLastDelayCycles = ulDelayCycles;
+	ulLastSemaphoreCycles = ulSemaphoreCycles;
+	ulLastQueueCycles = ulQueueCycles;
+	ulLastEventGroupCycles = ulEventGroupCycles;
+	ulLastNotifications = ulNotifications;
+	ulLastControlCycles = ulControlCycles;
+
+	return xReturn;
+}
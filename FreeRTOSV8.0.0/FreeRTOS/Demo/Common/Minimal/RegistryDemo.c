@@ -0,0 +1,539 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the object registry API in registry.h.
+ *
+ * A monitor task repeatedly creates one object of each type, checks that
+ * each is found in the registry with the expected type, name and state, and
+ * that each appears exactly once in a snapshot of the whole registry taken a
+ * few entries at a time.  It then deletes the objects and checks they are no
+ * longer registered.
+ *
+ * The mutex test also creates a task with a priority above that of the
+ * monitor task that blocks on a mutex the monitor task holds.  The snapshots
+ * must show the mutex holder, the blocked task, and the priority the monitor
+ * task inherited.  The task is deleted while it is blocked, and must leave the
+ * registry straight away.  The monitor task waits for the idle task to free
+ * the deleted task before continuing, so the number of tasks checked by the
+ * "death" demo tasks is not upset.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "registry.h"
+
+/* Demo program include files. */
+#include "RegistryDemo.h"
+
+/* The number of objects that must appear in a snapshot of the whole registry
+- the queue, recursive mutex, counting semaphore, event group and timer
+created by prvTestObjects(), and the monitor task itself. */
+#define regNUM_OBJECTS			( 6 )
+
+/* The index of the timer in the array of objects.  The objects before it are
+deleted directly, the timer by the timer service task. */
+#define regTIMER_INDEX			( 4 )
+
+/* The length of the queue, and the number of items the monitor task sends to
+it. */
+#define regQUEUE_LENGTH			( 3 )
+#define regQUEUE_ITEMS			( 2 )
+
+/* The maximum and initial counts of the counting semaphore. */
+#define regMAX_COUNT			( 4 )
+#define regINITIAL_COUNT		( 1 )
+
+/* The bits set in the event group. */
+#define regEVENT_BITS			( ( EventBits_t ) 0x05 )
+
+/* The period of the timer, which never expires while the test runs. */
+#define regTIMER_PERIOD			( ( TickType_t ) 1000 )
+
+/* The number of snapshots copied by each call to uxObjectRegistrySnapshot(),
+kept small so a snapshot of the whole registry takes many calls. */
+#define regSNAPSHOT_BATCH		( 4 )
+
+/* The time the monitor task waits for the timer service task to process a
+command, and for the idle task to free a deleted task. */
+#define regSHORT_DELAY			( ( TickType_t ) 5 )
+#define regCYCLE_DELAY			( ( TickType_t ) 50 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The monitor task described at the top of this file, and the tests it
+ * performs.
+ */
+static void prvRegistryMonitorTask( void *pvParameters );
+static void prvTestMutex( void );
+static void prvTestObjects( void );
+
+/*
+ * The task that blocks on the mutex held by the monitor task.
+ */
+static void prvBlockingTask( void *pvParameters );
+
+/*
+ * The callback of the timer, which is deleted before it expires.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * Return the number of times pvObject appears in a snapshot of the whole
+ * registry.
+ */
+static UBaseType_t prvCountInSnapshot( void *pvObject );
+
+/*
+ * Look up pvObject, and flag an error if it is not registered with the
+ * expected type and name.
+ */
+static void prvCheckObject( void *pvObject, uint8_t ucType, const char *pcName, ObjectSnapshot_t *pxSnapshot );
+
+/*-----------------------------------------------------------*/
+
+/* The names given to the objects. */
+static const char * const pcQueueName = "RegQueue";
+static const char * const pcEventGroupName = "RegEvents";
+static const char * const pcTimerName = "RegTimer";
+
+/* The mutex the blocking task blocks on. */
+static SemaphoreHandle_t xMutex = NULL;
+
+/* The priority of the monitor task. */
+static UBaseType_t uxMonitorPriority = tskIDLE_PRIORITY;
+
+/* Incremented each time the monitor task completes all its tests, so the
+check function can tell the task is still running. */
+static volatile uint32_t ulCycles = 0UL;
+
+/* Set to pdTRUE if an error is detected. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartRegistryTasks( UBaseType_t uxPriority )
+{
+	uxMonitorPriority = uxPriority;
+	xTaskCreate( prvRegistryMonitorTask, "RegMon", configMINIMAL_STACK_SIZE * 2, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRegistryMonitorTask( void *pvParameters )
+{
+ObjectSnapshot_t xSnapshot;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The monitor task itself is registered, with its name and
+		priority. */
+		prvCheckObject( xTaskGetCurrentTaskHandle(), registryTYPE_TASK, NULL, &xSnapshot );
+
+		if( ( strcmp( xSnapshot.pcName, "RegMon" ) != 0 ) || ( xSnapshot.ucState != ( uint8_t ) eRunning ) || ( xSnapshot.xValue != ( TickType_t ) uxMonitorPriority ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* Something that is not an object is not found. */
+		if( ( ucObjectRegistryGetType( ( void * ) &xSnapshot ) != registryTYPE_NONE ) || ( xObjectRegistrySetName( ( void * ) &xSnapshot, pcQueueName ) != pdFAIL ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		prvTestMutex();
+		prvTestObjects();
+
+		vTaskDelay( regCYCLE_DELAY );
+		ulCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestMutex( void )
+{
+ObjectSnapshot_t xSnapshot;
+TaskHandle_t xBlockingTask = NULL;
+
+	xMutex = xSemaphoreCreateMutex();
+
+	if( xMutex == NULL )
+	{
+		xErrorDetected = pdTRUE;
+		return;
+	}
+
+	xSemaphoreTake( xMutex, 0 );
+
+	/* The blocking task has the higher priority so runs, and blocks on the
+	mutex, before xTaskCreate() returns. */
+	if( xTaskCreate( prvBlockingTask, "RegBlk", configMINIMAL_STACK_SIZE, NULL, uxMonitorPriority + 1, &xBlockingTask ) == pdPASS )
+	{
+		prvCheckObject( xMutex, registryTYPE_MUTEX, NULL, &xSnapshot );
+
+		if( ( xSnapshot.pvOwner != ( void * ) xTaskGetCurrentTaskHandle() ) || ( xSnapshot.uxLevel != 0 ) || ( xSnapshot.uxWaitingToReceive != 1 ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		prvCheckObject( xBlockingTask, registryTYPE_TASK, NULL, &xSnapshot );
+
+		if( xSnapshot.ucState != ( uint8_t ) eBlocked )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The monitor task inherited the priority of the blocked task, but
+		its base priority is unchanged. */
+		prvCheckObject( xTaskGetCurrentTaskHandle(), registryTYPE_TASK, NULL, &xSnapshot );
+
+		if( ( xSnapshot.uxLevel != ( uxMonitorPriority + 1 ) ) || ( xSnapshot.xValue != ( TickType_t ) uxMonitorPriority ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* A deleted task leaves the registry at once, before the idle task
+		frees it. */
+		vTaskDelete( xBlockingTask );
+
+		if( ucObjectRegistryGetType( xBlockingTask ) != registryTYPE_NONE )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	else
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xSemaphoreGive( xMutex );
+	prvCheckObject( xMutex, registryTYPE_MUTEX, NULL, &xSnapshot );
+
+	if( ( xSnapshot.pvOwner != NULL ) || ( xSnapshot.uxLevel != 1 ) || ( xSnapshot.uxWaitingToReceive != 0 ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* See the comments in prvTestObjects(). */
+	vTaskSuspendAll();
+	{
+		vSemaphoreDelete( xMutex );
+
+		if( ucObjectRegistryGetType( xMutex ) != registryTYPE_NONE )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	xTaskResumeAll();
+
+	/* Let the idle task free the deleted task. */
+	vTaskDelay( regCYCLE_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestObjects( void )
+{
+QueueHandle_t xQueue;
+SemaphoreHandle_t xRecursiveMutex, xCountingSemaphore;
+EventGroupHandle_t xEventGroup;
+TimerHandle_t xTimer;
+ObjectSnapshot_t xSnapshot;
+void *pvObjects[ regNUM_OBJECTS ];
+uint32_t ulValue = 0UL;
+UBaseType_t ux;
+
+	xQueue = xQueueCreate( regQUEUE_LENGTH, sizeof( uint32_t ) );
+	xRecursiveMutex = xSemaphoreCreateRecursiveMutex();
+	xCountingSemaphore = xSemaphoreCreateCounting( regMAX_COUNT, regINITIAL_COUNT );
+	xEventGroup = xEventGroupCreate();
+	xTimer = xTimerCreate( pcTimerName, regTIMER_PERIOD, pdTRUE, NULL, prvTimerCallback );
+
+	pvObjects[ 0 ] = xQueue;
+	pvObjects[ 1 ] = xRecursiveMutex;
+	pvObjects[ 2 ] = xCountingSemaphore;
+	pvObjects[ 3 ] = xEventGroup;
+	pvObjects[ regTIMER_INDEX ] = xTimer;
+	pvObjects[ regTIMER_INDEX + 1 ] = xTaskGetCurrentTaskHandle();
+
+	if( ( xQueue == NULL ) || ( xRecursiveMutex == NULL ) || ( xCountingSemaphore == NULL ) || ( xEventGroup == NULL ) || ( xTimer == NULL ) )
+	{
+		/* The FreeRTOS heap is sized so this does not happen. */
+		xErrorDetected = pdTRUE;
+		return;
+	}
+
+	/* Queues are named by the queue registry API, which names objects in the
+	object registry when it is in use. */
+	vQueueAddToRegistry( xQueue, pcQueueName );
+
+	for( ux = 0; ux < regQUEUE_ITEMS; ux++ )
+	{
+		xQueueSend( xQueue, &ulValue, 0 );
+	}
+
+	prvCheckObject( xQueue, registryTYPE_QUEUE, pcQueueName, &xSnapshot );
+
+	if( ( xSnapshot.uxLevel != regQUEUE_ITEMS ) || ( xSnapshot.uxCapacity != regQUEUE_LENGTH ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xSemaphoreTakeRecursive( xRecursiveMutex, 0 );
+	xSemaphoreTakeRecursive( xRecursiveMutex, 0 );
+	prvCheckObject( xRecursiveMutex, registryTYPE_RECURSIVE_MUTEX, NULL, &xSnapshot );
+
+	if( ( xSnapshot.pvOwner != ( void * ) xTaskGetCurrentTaskHandle() ) || ( xSnapshot.xValue != ( TickType_t ) 2 ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xSemaphoreGiveRecursive( xRecursiveMutex );
+	xSemaphoreGiveRecursive( xRecursiveMutex );
+
+	prvCheckObject( xCountingSemaphore, registryTYPE_COUNTING_SEMAPHORE, NULL, &xSnapshot );
+
+	if( ( xSnapshot.uxLevel != regINITIAL_COUNT ) || ( xSnapshot.uxCapacity != regMAX_COUNT ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Event groups do not have a name until one is set. */
+	xEventGroupSetBits( xEventGroup, regEVENT_BITS );
+	prvCheckObject( xEventGroup, registryTYPE_EVENT_GROUP, NULL, &xSnapshot );
+
+	if( ( xObjectRegistrySetName( xEventGroup, pcEventGroupName ) != pdPASS ) || ( xSnapshot.xValue != ( TickType_t ) regEVENT_BITS ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	prvCheckObject( xEventGroup, registryTYPE_EVENT_GROUP, pcEventGroupName, &xSnapshot );
+
+	/* The timer is dormant until the timer service task processes the start
+	command. */
+	prvCheckObject( xTimer, registryTYPE_TIMER, pcTimerName, &xSnapshot );
+
+	if( ( xSnapshot.uxLevel != pdFALSE ) || ( xSnapshot.uxCapacity != pdTRUE ) || ( xSnapshot.xValue != regTIMER_PERIOD ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xTimerStart( xTimer, 0 );
+	vTaskDelay( regSHORT_DELAY );
+	prvCheckObject( xTimer, registryTYPE_TIMER, pcTimerName, &xSnapshot );
+
+	if( xSnapshot.uxLevel == pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Each object is in the snapshot of the whole registry exactly once. */
+	for( ux = 0; ux < regNUM_OBJECTS; ux++ )
+	{
+		if( prvCountInSnapshot( pvObjects[ ux ] ) != 1 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+
+	/* Objects leave the registry as soon as they are deleted.  The scheduler
+	is suspended so no other task can create an object at the same address
+	before the registry is checked. */
+	vTaskSuspendAll();
+	{
+		vQueueDelete( xQueue );
+		vSemaphoreDelete( xRecursiveMutex );
+		vSemaphoreDelete( xCountingSemaphore );
+		vEventGroupDelete( xEventGroup );
+
+		for( ux = 0; ux < regTIMER_INDEX; ux++ )
+		{
+			if( ( ucObjectRegistryGetType( pvObjects[ ux ] ) != registryTYPE_NONE ) || ( xObjectRegistryGetSnapshot( pvObjects[ ux ], &xSnapshot ) != pdFAIL ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	/* The timer leaves the registry when the timer service task processes the
+	delete command.  By then another object might be using the same memory,
+	so the check is that the timer with this name has gone. */
+	xTimerDelete( xTimer, 0 );
+	vTaskDelay( regSHORT_DELAY );
+
+	if( ( xObjectRegistryGetSnapshot( xTimer, &xSnapshot ) != pdFAIL ) && ( xSnapshot.pcName == pcTimerName ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockingTask( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	/* The monitor task holds the mutex, and deletes this task while it is
+	blocked. */
+	xSemaphoreTake( xMutex, portMAX_DELAY );
+
+	/* Should not get here. */
+	xErrorDetected = pdTRUE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	/* The timer is deleted long before it expires. */
+	xErrorDetected = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCountInSnapshot( void *pvObject )
+{
+ObjectSnapshot_t xSnapshots[ regSNAPSHOT_BATCH ];
+UBaseType_t uxEntry = 0, uxCopied, ux, uxCount = 0;
+
+	while( uxEntry < configOBJECT_REGISTRY_SIZE )
+	{
+		uxCopied = uxObjectRegistrySnapshot( xSnapshots, regSNAPSHOT_BATCH, &uxEntry );
+
+		if( uxCopied > regSNAPSHOT_BATCH )
+		{
+			xErrorDetected = pdTRUE;
+			break;
+		}
+
+		for( ux = 0; ux < uxCopied; ux++ )
+		{
+			if( xSnapshots[ ux ].ucType == registryTYPE_NONE )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( xSnapshots[ ux ].pvObject == pvObject )
+			{
+				uxCount++;
+			}
+		}
+	}
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckObject( void *pvObject, uint8_t ucType, const char *pcName, ObjectSnapshot_t *pxSnapshot )
+{
+	if( xObjectRegistryGetSnapshot( pvObject, pxSnapshot ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+		memset( ( void * ) pxSnapshot, 0x00, sizeof( ObjectSnapshot_t ) );
+		pxSnapshot->pcName = "";
+	}
+	else if( ( pxSnapshot->pvObject != pvObject ) || ( pxSnapshot->ucType != ucType ) || ( ucObjectRegistryGetType( pvObject ) != ucType ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+	else if( ( pcName != NULL ) && ( pxSnapshot->pcName != pcName ) )
+	{
+		/* The registry holds a pointer to the name, not a copy. */
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreRegistryTasksStillRunning( void )
+{
+static uint32_t ulLastCycles = 0UL;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulCycles == ulLastCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastCycles = ulCycles;
+
+	return xReturn;
+}
@@ -0,0 +1,485 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the tick timer API in tick_timers.h.  Tick timer callbacks execute
+ * from the tick interrupt, so the tests check that each callback executes on
+ * exactly the tick on which its timer is due.
+ *
+ * Periodic timers - ttNUM_PERIODIC auto-reload timers run continuously.  Some
+ * have a period longer than the timer wheel, so are seen by the tick more than
+ * once before they expire.  Each callback checks it executed exactly one
+ * period after the previous execution - the timers neither drift nor jitter.
+ *
+ * Control task - Uses a one-shot timer to check that a timer expires exactly
+ * ttONE_SHOT_PERIOD ticks after it is started, and is then dormant; that a
+ * stopped timer does not expire; that a timer that is reset expires one period
+ * after it was reset; and that changing the period of a timer restarts it with
+ * the new period.  It then starts an auto-reload timer whose callback stops
+ * the timer from within the callback after ttSTOP_AFTER expiries, and gives a
+ * semaphore on which the control task is blocked.  Finally it creates and
+ * starts another timer, and deletes it before it expires.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "tick_timers.h"
+
+/* Demo program include files. */
+#include "TickTimerDemo.h"
+
+/* The number of continuously running auto-reload timers. */
+#define ttNUM_PERIODIC			( 3 )
+
+/* The period used by the control task's one-shot timer, and the period it is
+changed to. */
+#define ttONE_SHOT_PERIOD		( ( TickType_t ) 10 )
+#define ttCHANGED_PERIOD		( ( TickType_t ) 3 )
+
+/* The period of the timer that stops itself, and the number of times it
+expires before it does so. */
+#define ttSELF_STOP_PERIOD		( ( TickType_t ) 2 )
+#define ttSTOP_AFTER			( 5UL )
+
+/* Long enough for any of the control task's timers to have expired. */
+#define ttWAIT_TICKS			( ( TickType_t ) 25 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The control task described at the top of this file, and the tests it
+ * performs.
+ */
+static void prvTickTimerControlTask( void *pvParameters );
+static void prvTestOneShot( void );
+static void prvTestStop( void );
+static void prvTestReset( void );
+static void prvTestChangePeriod( void );
+static void prvTestStopFromCallback( void );
+static void prvTestDelete( void );
+
+/*
+ * Start the one-shot timer and return the tick count at which it was started.
+ */
+static TickType_t prvStartOneShot( void );
+
+/*
+ * The timer callback functions.
+ */
+static void prvPeriodicCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+static void prvOneShotCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+static void prvSelfStopCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+static void prvDeletedCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+/*-----------------------------------------------------------*/
+
+/* The periods of the continuously running timers.  The wheel has
+configTICK_TIMER_WHEEL_SIZE slots, so the longer periods wrap around it. */
+static const TickType_t xPeriods[ ttNUM_PERIODIC ] = { 5, 7, configTICK_TIMER_WHEEL_SIZE + 9 };
+
+/* The number of times, and the tick count at which, each continuously running
+timer last expired. */
+static volatile uint32_t ulPeriodicExpiries[ ttNUM_PERIODIC ] = { 0UL };
+static volatile TickType_t xLastExpiry[ ttNUM_PERIODIC ] = { 0 };
+
+/* The timers used by the control task. */
+static TickTimerHandle_t xOneShotTimer = NULL, xSelfStopTimer = NULL;
+
+/* The number of times, and the tick count at which, the one-shot and self
+stopping timers last expired. */
+static volatile uint32_t ulOneShotExpiries = 0UL, ulSelfStopExpiries = 0UL;
+static volatile TickType_t xOneShotExpiry = 0, xSelfStopExpiry = 0;
+
+/* Set if the callback of the deleted timer ever executes. */
+static volatile uint32_t ulDeletedExpiries = 0UL;
+
+/* Given by the self stopping timer's callback. */
+static SemaphoreHandle_t xSelfStopSemaphore = NULL;
+
+/* Incremented each time the control task completes all its tests, so the
+check function can tell the task is still running. */
+static volatile uint32_t ulCycles = 0UL;
+
+/* Set to pdTRUE if an error is detected. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartTickTimerTasks( UBaseType_t uxPriority )
+{
+TickTimerHandle_t xTimer;
+UBaseType_t ux;
+
+	for( ux = 0; ux < ttNUM_PERIODIC; ux++ )
+	{
+		xTimer = xTickTimerCreate( xPeriods[ ux ], pdTRUE, ( void * ) ux, prvPeriodicCallback );
+		configASSERT( xTimer );
+
+		/* The scheduler has not started, so the tick count is 0. */
+		vTickTimerStart( xTimer );
+	}
+
+	xOneShotTimer = xTickTimerCreate( ttONE_SHOT_PERIOD, pdFALSE, NULL, prvOneShotCallback );
+	xSelfStopTimer = xTickTimerCreate( ttSELF_STOP_PERIOD, pdTRUE, NULL, prvSelfStopCallback );
+	xSelfStopSemaphore = xSemaphoreCreateBinary();
+	configASSERT( xOneShotTimer );
+	configASSERT( xSelfStopTimer );
+	configASSERT( xSelfStopSemaphore );
+
+	xTaskCreate( prvTickTimerControlTask, "TTCtrl", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickTimerControlTask( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		prvTestOneShot();
+		prvTestStop();
+		prvTestReset();
+		prvTestChangePeriod();
+		prvTestStopFromCallback();
+		prvTestDelete();
+
+		ulCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvStartOneShot( void )
+{
+TickType_t xStartTime;
+
+	/* The critical section ensures the tick count does not change between it
+	being sampled and the timer being started. */
+	taskENTER_CRITICAL();
+	{
+		xStartTime = xTaskGetTickCount();
+		vTickTimerStart( xOneShotTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	return xStartTime;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestOneShot( void )
+{
+TickType_t xStartTime;
+
+	ulOneShotExpiries = 0UL;
+	xStartTime = prvStartOneShot();
+
+	if( xTickTimerIsActive( xOneShotTimer ) == pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	vTaskDelay( ttWAIT_TICKS );
+
+	/* The timer expired once, exactly one period after it was started, and
+	is now dormant. */
+	if( ( ulOneShotExpiries != 1UL ) || ( ( xOneShotExpiry - xStartTime ) != ttONE_SHOT_PERIOD ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xTickTimerIsActive( xOneShotTimer ) != pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestStop( void )
+{
+	ulOneShotExpiries = 0UL;
+	( void ) prvStartOneShot();
+	vTaskDelay( ttONE_SHOT_PERIOD / 2 );
+	vTickTimerStop( xOneShotTimer );
+
+	if( xTickTimerIsActive( xOneShotTimer ) != pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Stopping a dormant timer has no effect. */
+	vTickTimerStop( xOneShotTimer );
+	vTaskDelay( ttWAIT_TICKS );
+
+	if( ulOneShotExpiries != 0UL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestReset( void )
+{
+TickType_t xResetTime;
+
+	ulOneShotExpiries = 0UL;
+	( void ) prvStartOneShot();
+	vTaskDelay( ttONE_SHOT_PERIOD / 2 );
+
+	/* Restart the active timer, so it expires one period after now rather
+	than one period after it was first started. */
+	taskENTER_CRITICAL();
+	{
+		xResetTime = xTaskGetTickCount();
+		vTickTimerReset( xOneShotTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	vTaskDelay( ttWAIT_TICKS );
+
+	if( ( ulOneShotExpiries != 1UL ) || ( ( xOneShotExpiry - xResetTime ) != ttONE_SHOT_PERIOD ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestChangePeriod( void )
+{
+TickType_t xChangeTime;
+
+	ulOneShotExpiries = 0UL;
+
+	/* Changing the period of a dormant timer also starts it. */
+	taskENTER_CRITICAL();
+	{
+		xChangeTime = xTaskGetTickCount();
+		vTickTimerChangePeriod( xOneShotTimer, ttCHANGED_PERIOD );
+	}
+	taskEXIT_CRITICAL();
+
+	vTaskDelay( ttWAIT_TICKS );
+
+	if( ( ulOneShotExpiries != 1UL ) || ( ( xOneShotExpiry - xChangeTime ) != ttCHANGED_PERIOD ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Put the period back for the next cycle.  This starts the timer again, so
+	stop it. */
+	vTickTimerChangePeriod( xOneShotTimer, ttONE_SHOT_PERIOD );
+	vTickTimerStop( xOneShotTimer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestStopFromCallback( void )
+{
+TickType_t xStartTime;
+
+	ulSelfStopExpiries = 0UL;
+
+	taskENTER_CRITICAL();
+	{
+		xStartTime = xTaskGetTickCount();
+		vTickTimerStart( xSelfStopTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	/* The callback gives the semaphore when it stops the timer. */
+	if( xSemaphoreTake( xSelfStopSemaphore, ttWAIT_TICKS ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( ulSelfStopExpiries != ttSTOP_AFTER ) || ( ( xSelfStopExpiry - xStartTime ) != ( ttSTOP_AFTER * ttSELF_STOP_PERIOD ) ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	vTaskDelay( ttWAIT_TICKS );
+
+	/* The timer stopped itself. */
+	if( ( ulSelfStopExpiries != ttSTOP_AFTER ) || ( xTickTimerIsActive( xSelfStopTimer ) != pdFALSE ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDelete( void )
+{
+TickTimerHandle_t xTimer;
+
+	xTimer = xTickTimerCreate( ttONE_SHOT_PERIOD, pdTRUE, NULL, prvDeletedCallback );
+
+	if( xTimer == NULL )
+	{
+		xErrorDetected = pdTRUE;
+		return;
+	}
+
+	vTickTimerStart( xTimer );
+	vTaskDelay( ttONE_SHOT_PERIOD / 2 );
+
+	/* Deleting an active timer stops it first. */
+	vTickTimerDelete( xTimer );
+	vTaskDelay( ttWAIT_TICKS );
+
+	if( ulDeletedExpiries != 0UL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) pvTickTimerGetTimerID( xTimer );
+const TickType_t xTimeNow = xTaskGetTickCountFromISR();
+
+	/* The callback does not unblock a task. */
+	( void ) pxHigherPriorityTaskWoken;
+
+	/* The timers were started when the tick count was 0, so each expiry is
+	exactly one period after the last. */
+	if( ( xTimeNow - xLastExpiry[ uxIndex ] ) != xPeriods[ uxIndex ] )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xLastExpiry[ uxIndex ] = xTimeNow;
+	ulPeriodicExpiries[ uxIndex ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvOneShotCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) pxHigherPriorityTaskWoken;
+
+	/* A one-shot timer is dormant by the time its callback executes. */
+	if( xTickTimerIsActive( xTimer ) != pdFALSE )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xOneShotExpiry = xTaskGetTickCountFromISR();
+	ulOneShotExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelfStopCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	xSelfStopExpiry = xTaskGetTickCountFromISR();
+	ulSelfStopExpiries++;
+
+	if( ulSelfStopExpiries >= ttSTOP_AFTER )
+	{
+		vTickTimerStopFromISR( xTimer );
+		xSemaphoreGiveFromISR( xSelfStopSemaphore, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeletedCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) xTimer;
+	( void ) pxHigherPriorityTaskWoken;
+
+	ulDeletedExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreTickTimerTasksStillRunning( void )
+{
+static uint32_t ulLastCycles = 0UL;
+static uint32_t ulLastPeriodicExpiries[ ttNUM_PERIODIC ] = { 0UL };
+BaseType_t xReturn = pdPASS;
+UBaseType_t ux;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulCycles == ulLastCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastCycles = ulCycles;
+
+	for( ux = 0; ux < ttNUM_PERIODIC; ux++ )
+	{
+		if( ulPeriodicExpiries[ ux ] == ulLastPeriodicExpiries[ ux ] )
+		{
+			xReturn = pdFAIL;
+		}
+
+		ulLastPeriodicExpiries[ ux ] = ulPeriodicExpiries[ ux ];
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,685 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the wait set API in waitset.h.
+ *
+ * A control task owns a wait set that has a level triggered queue, a level
+ * triggered counting semaphore and an edge triggered event group as members,
+ * and repeatedly performs the following tests:
+ *
+ * Empty - A wait set with no ready members returns no events, either at once
+ * or after the block time has expired.
+ *
+ * Level and edge triggering - A level triggered member is reported by every
+ * call to uxWaitSetWait() until it has been drained.  An edge triggered event
+ * group is reported once for any number of posts, with all the bits of
+ * interest that were set since it was last reported, and is not reported if
+ * only bits that are not of interest are set.
+ *
+ * Multiple ready members - After posting to every member, and notifying the
+ * wait set twice, a single call returns one event for each member plus a
+ * single notification that holds both notification values.  When the caller
+ * only has room for one event at a time, two members that remain ready are
+ * reported alternately, so neither starves the other.
+ *
+ * Blocking - The control task blocks on the wait set while a higher priority
+ * task posts to one member (or notifies the wait set).  The control task must
+ * be unblocked by that post, and be told which member was posted to.
+ *
+ * Membership - An object cannot be added to a wait set twice, or to a wait
+ * set that is full.  A member that is removed is no longer reported, and a
+ * member that is added when it is already ready is reported straight away.  A
+ * member that is deleted while it is ready is removed from the wait set
+ * automatically.
+ *
+ * In addition, vWaitSetPeriodicISRDemo() is called from the tick hook.  It
+ * alternately sends an incrementing value to a queue that is a member of a
+ * second wait set, and notifies that wait set.  A task blocked on the second
+ * wait set checks that every value and every notification arrives.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "waitset.h"
+
+/* Demo program include files. */
+#include "WaitSetDemo.h"
+
+/* The number of permanent members of the control task's wait set, and the
+number it has room for.  The spare place is used by the membership test. */
+#define wsNUM_MEMBERS			( 3 )
+#define wsMAX_MEMBERS			( wsNUM_MEMBERS + 1 )
+
+/* The length of the queues, and the maximum count of the counting semaphore,
+that are members of the wait sets. */
+#define wsQUEUE_LENGTH			( 5 )
+
+/* The event group bits the wait set is interested in, and a bit it is not
+interested in. */
+#define wsBIT_0					( ( EventBits_t ) 0x01 )
+#define wsBIT_1					( ( EventBits_t ) 0x02 )
+#define wsBITS_OF_INTEREST		( wsBIT_0 | wsBIT_1 )
+#define wsOTHER_BIT				( ( EventBits_t ) 0x04 )
+
+/* Values passed into xWaitSetNotify(). */
+#define wsNOTIFY_BIT_0			( ( EventBits_t ) 0x10 )
+#define wsNOTIFY_BIT_1			( ( EventBits_t ) 0x20 )
+
+/* The user data registered with each member, so the events can be checked. */
+#define wsQUEUE_DATA			( ( void * ) 0x01 )
+#define wsSEMAPHORE_DATA		( ( void * ) 0x02 )
+#define wsEVENT_GROUP_DATA		( ( void * ) 0x03 )
+
+/* The block time used by the empty test, the time the posting task waits
+before it posts, and the maximum time the control task waits for the post. */
+#define wsEMPTY_BLOCK_TICKS		( ( TickType_t ) 5 )
+#define wsPOST_DELAY			( ( TickType_t ) 5 )
+#define wsPOST_TIMEOUT			( ( TickType_t ) 100 )
+
+/* The number of tick interrupts between the posts made by
+vWaitSetPeriodicISRDemo(). */
+#define wsISR_PERIOD			( 10UL )
+
+/* The members the posting task posts to in turn. */
+#define wsPOST_QUEUE			( 0 )
+#define wsPOST_SEMAPHORE		( 1 )
+#define wsPOST_EVENT_GROUP		( 2 )
+#define wsPOST_NOTIFY			( 3 )
+#define wsNUM_POST_TARGETS		( 4 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The control task described at the top of this file, and the tests it
+ * performs.
+ */
+static void prvWaitSetControlTask( void *pvParameters );
+static void prvTestEmpty( void );
+static void prvTestLevelAndEdge( void );
+static void prvTestMultipleReady( void );
+static void prvTestBlocking( void );
+static void prvTestMembership( void );
+
+/*
+ * The task that posts to a member of the control task's wait set while the
+ * control task is blocked on it.
+ */
+static void prvWaitSetPostTask( void *pvParameters );
+
+/*
+ * The task that receives the values and notifications posted by
+ * vWaitSetPeriodicISRDemo().
+ */
+static void prvWaitSetISRTask( void *pvParameters );
+
+/*
+ * Wait on the control task's wait set without blocking, and return the
+ * number of events.
+ */
+static UBaseType_t prvPoll( WaitSetEvent_t *pxEvents, UBaseType_t uxMaxEvents );
+
+/*
+ * Remove all the data from the queue, and all the counts from the semaphore.
+ */
+static void prvDrain( void );
+
+/*-----------------------------------------------------------*/
+
+/* The control task's wait set and its members. */
+static WaitSetHandle_t xWaitSet = NULL;
+static QueueHandle_t xQueue = NULL;
+static SemaphoreHandle_t xSemaphore = NULL;
+static EventGroupHandle_t xEventGroup = NULL;
+
+/* Used by the control task to tell the posting task to post to the member
+indexed by uxPostTarget. */
+static SemaphoreHandle_t xPostSemaphore = NULL;
+static volatile UBaseType_t uxPostTarget = wsPOST_QUEUE;
+
+/* The wait set used by vWaitSetPeriodicISRDemo(), and its member queue. */
+static WaitSetHandle_t xISRWaitSet = NULL;
+static QueueHandle_t xISRQueue = NULL;
+
+/* The next value sent by vWaitSetPeriodicISRDemo(), and the number of values
+and notifications received by the task blocked on the wait set. */
+static volatile uint32_t ulISRValue = 0UL;
+static volatile uint32_t ulISRValuesReceived = 0UL, ulISRNotifications = 0UL;
+
+/* Incremented each time the control task completes all its tests, so the
+check function can tell the task is still running. */
+static volatile uint32_t ulCycles = 0UL;
+
+/* Set to pdTRUE if an error is detected. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartWaitSetTasks( UBaseType_t uxPriority )
+{
+	xWaitSet = xWaitSetCreate( wsMAX_MEMBERS );
+	xQueue = xQueueCreate( wsQUEUE_LENGTH, sizeof( uint32_t ) );
+	xSemaphore = xSemaphoreCreateCounting( wsQUEUE_LENGTH, 0 );
+	xEventGroup = xEventGroupCreate();
+	xPostSemaphore = xSemaphoreCreateBinary();
+	configASSERT( xWaitSet );
+	configASSERT( xQueue );
+	configASSERT( xSemaphore );
+	configASSERT( xEventGroup );
+	configASSERT( xPostSemaphore );
+
+	xWaitSetAddQueue( xWaitSet, xQueue, waitsetLEVEL_TRIGGERED, wsQUEUE_DATA );
+	xWaitSetAddQueue( xWaitSet, xSemaphore, waitsetLEVEL_TRIGGERED, wsSEMAPHORE_DATA );
+	xWaitSetAddEventGroup( xWaitSet, xEventGroup, wsBITS_OF_INTEREST, waitsetEDGE_TRIGGERED, wsEVENT_GROUP_DATA );
+
+	xISRWaitSet = xWaitSetCreate( 1 );
+	xISRQueue = xQueueCreate( wsQUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xISRWaitSet );
+	configASSERT( xISRQueue );
+	xWaitSetAddQueue( xISRWaitSet, xISRQueue, waitsetLEVEL_TRIGGERED, NULL );
+
+	/* The posting task has the higher priority, so it posts as soon as its
+	delay expires. */
+	xTaskCreate( prvWaitSetControlTask, "WSCtrl", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvWaitSetPostTask, "WSPost", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, NULL );
+	xTaskCreate( prvWaitSetISRTask, "WSISR", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitSetControlTask( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		prvTestEmpty();
+		prvTestLevelAndEdge();
+		prvTestMultipleReady();
+		prvTestBlocking();
+		prvTestMembership();
+
+		ulCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvPoll( WaitSetEvent_t *pxEvents, UBaseType_t uxMaxEvents )
+{
+	return uxWaitSetWait( xWaitSet, pxEvents, uxMaxEvents, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDrain( void )
+{
+uint32_t ulValue;
+
+	while( xQueueReceive( xQueue, &ulValue, 0 ) == pdPASS )
+	{
+	}
+
+	while( xSemaphoreTake( xSemaphore, 0 ) == pdPASS )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestEmpty( void )
+{
+WaitSetEvent_t xEvent;
+TickType_t xTimeBefore;
+
+	if( prvPoll( &xEvent, 1 ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xTimeBefore = xTaskGetTickCount();
+
+	if( uxWaitSetWait( xWaitSet, &xEvent, 1, wsEMPTY_BLOCK_TICKS ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( xTaskGetTickCount() - xTimeBefore ) < wsEMPTY_BLOCK_TICKS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestLevelAndEdge( void )
+{
+WaitSetEvent_t xEvent;
+uint32_t ulValue = 0UL;
+
+	/* The queue is reported for as long as it holds data, not once per
+	send. */
+	xQueueSend( xQueue, &ulValue, 0 );
+	xQueueSend( xQueue, &ulValue, 0 );
+
+	if( ( prvPoll( &xEvent, 1 ) != 1 ) || ( xEvent.pvObject != xQueue ) || ( xEvent.pvUserData != wsQUEUE_DATA ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( prvPoll( &xEvent, 1 ) != 1 ) || ( xEvent.pvObject != xQueue ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	prvDrain();
+
+	if( prvPoll( &xEvent, 1 ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* The event group is reported once, with both bits, however many times
+	its bits are set.  The bits stay set in the event group. */
+	xEventGroupSetBits( xEventGroup, wsBIT_0 );
+	xEventGroupSetBits( xEventGroup, wsBIT_1 );
+	xEventGroupSetBits( xEventGroup, wsBIT_0 );
+
+	if( ( prvPoll( &xEvent, 1 ) != 1 ) || ( xEvent.pvObject != xEventGroup ) || ( xEvent.pvUserData != wsEVENT_GROUP_DATA ) || ( xEvent.uxEventBits != wsBITS_OF_INTEREST ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( prvPoll( &xEvent, 1 ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Setting a bit that is not of interest does not signal the wait set. */
+	xEventGroupSetBits( xEventGroup, wsOTHER_BIT );
+
+	if( prvPoll( &xEvent, 1 ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xEventGroupClearBits( xEventGroup, wsBITS_OF_INTEREST | wsOTHER_BIT );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestMultipleReady( void )
+{
+WaitSetEvent_t xEvents[ wsMAX_MEMBERS ];
+UBaseType_t uxEvent, uxCount;
+uint32_t ulValue = 0UL;
+BaseType_t xQueueSeen = pdFALSE, xSemaphoreSeen = pdFALSE, xEventGroupSeen = pdFALSE;
+void *pvFirst;
+
+	xQueueSend( xQueue, &ulValue, 0 );
+	xSemaphoreGive( xSemaphore );
+	xEventGroupSetBits( xEventGroup, wsBIT_1 );
+	xWaitSetNotify( xWaitSet, wsNOTIFY_BIT_0 );
+	xWaitSetNotify( xWaitSet, wsNOTIFY_BIT_1 );
+
+	/* The notification is reported first, then one event per member. */
+	uxCount = uxWaitSetWait( xWaitSet, xEvents, wsMAX_MEMBERS, 0 );
+
+	if( ( uxCount != ( wsNUM_MEMBERS + 1 ) ) || ( xEvents[ 0 ].pvObject != xWaitSet ) || ( xEvents[ 0 ].uxEventBits != ( wsNOTIFY_BIT_0 | wsNOTIFY_BIT_1 ) ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	for( uxEvent = 1; uxEvent < uxCount; uxEvent++ )
+	{
+		if( ( xEvents[ uxEvent ].pvObject == xQueue ) && ( xEvents[ uxEvent ].pvUserData == wsQUEUE_DATA ) )
+		{
+			xQueueSeen = pdTRUE;
+		}
+		else if( ( xEvents[ uxEvent ].pvObject == xSemaphore ) && ( xEvents[ uxEvent ].pvUserData == wsSEMAPHORE_DATA ) )
+		{
+			xSemaphoreSeen = pdTRUE;
+		}
+		else if( ( xEvents[ uxEvent ].pvObject == xEventGroup ) && ( xEvents[ uxEvent ].uxEventBits == wsBIT_1 ) )
+		{
+			xEventGroupSeen = pdTRUE;
+		}
+		else
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+
+	if( ( xQueueSeen == pdFALSE ) || ( xSemaphoreSeen == pdFALSE ) || ( xEventGroupSeen == pdFALSE ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xEventGroupClearBits( xEventGroup, wsBITS_OF_INTEREST );
+
+	/* The queue and semaphore are still ready, so with room for only one
+	event they must take turns. */
+	if( prvPoll( xEvents, 1 ) != 1 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	pvFirst = xEvents[ 0 ].pvObject;
+
+	if( ( prvPoll( xEvents, 1 ) != 1 ) || ( xEvents[ 0 ].pvObject == pvFirst ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( prvPoll( xEvents, 1 ) != 1 ) || ( xEvents[ 0 ].pvObject != pvFirst ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	prvDrain();
+
+	if( prvPoll( xEvents, wsMAX_MEMBERS ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestBlocking( void )
+{
+WaitSetEvent_t xEvent;
+UBaseType_t uxTarget;
+void *pvExpected;
+
+	for( uxTarget = 0; uxTarget < wsNUM_POST_TARGETS; uxTarget++ )
+	{
+		switch( uxTarget )
+		{
+			case wsPOST_QUEUE		:	pvExpected = xQueue;		break;
+			case wsPOST_SEMAPHORE	:	pvExpected = xSemaphore;	break;
+			case wsPOST_EVENT_GROUP	:	pvExpected = xEventGroup;	break;
+			default					:	pvExpected = xWaitSet;		break;
+		}
+
+		/* The posting task has the higher priority so runs as soon as the
+		semaphore is given, and blocks for wsPOST_DELAY ticks before it
+		posts.  By then this task is blocked on the wait set. */
+		uxPostTarget = uxTarget;
+		xSemaphoreGive( xPostSemaphore );
+
+		if( ( uxWaitSetWait( xWaitSet, &xEvent, 1, wsPOST_TIMEOUT ) != 1 ) || ( xEvent.pvObject != pvExpected ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		prvDrain();
+		xEventGroupClearBits( xEventGroup, wsBITS_OF_INTEREST );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestMembership( void )
+{
+WaitSetEvent_t xEvent;
+SemaphoreHandle_t xTemporary;
+
+	/* Objects can only be added once. */
+	if( xWaitSetAddQueue( xWaitSet, xQueue, waitsetLEVEL_TRIGGERED, NULL ) != pdFAIL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* A member that has been removed is not reported, and cannot be removed
+	again. */
+	if( xWaitSetRemove( xWaitSet, xEventGroup ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xEventGroupSetBits( xEventGroup, wsBIT_0 );
+
+	if( ( prvPoll( &xEvent, 1 ) != 0 ) || ( xWaitSetRemove( xWaitSet, xEventGroup ) != pdFAIL ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* A member that is ready when it is added is reported straight away, even
+	though it is edge triggered. */
+	if( xWaitSetAddEventGroup( xWaitSet, xEventGroup, wsBITS_OF_INTEREST, waitsetEDGE_TRIGGERED, wsEVENT_GROUP_DATA ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( prvPoll( &xEvent, 1 ) != 1 ) || ( xEvent.pvObject != xEventGroup ) || ( xEvent.uxEventBits != wsBIT_0 ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xEventGroupClearBits( xEventGroup, wsBITS_OF_INTEREST );
+
+	/* Fill the wait set, then check it cannot take another member. */
+	xTemporary = xSemaphoreCreateBinary();
+
+	if( xTemporary == NULL )
+	{
+		xErrorDetected = pdTRUE;
+		return;
+	}
+
+	if( xWaitSetAddQueue( xWaitSet, xTemporary, waitsetLEVEL_TRIGGERED, NULL ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWaitSetAddQueue( xWaitSet, xPostSemaphore, waitsetLEVEL_TRIGGERED, NULL ) != pdFAIL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Deleting a member that is ready removes it from the wait set, and frees
+	its place for another object. */
+	xSemaphoreGive( xTemporary );
+	vSemaphoreDelete( xTemporary );
+
+	if( prvPoll( &xEvent, 1 ) != 0 )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWaitSetAddQueue( xWaitSet, xPostSemaphore, waitsetLEVEL_TRIGGERED, NULL ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWaitSetRemove( xWaitSet, xPostSemaphore ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitSetPostTask( void *pvParameters )
+{
+uint32_t ulValue = 0UL;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xSemaphoreTake( xPostSemaphore, portMAX_DELAY );
+		vTaskDelay( wsPOST_DELAY );
+
+		switch( uxPostTarget )
+		{
+			case wsPOST_QUEUE		:	xQueueSend( xQueue, &ulValue, 0 );				break;
+			case wsPOST_SEMAPHORE	:	xSemaphoreGive( xSemaphore );					break;
+			case wsPOST_EVENT_GROUP	:	xEventGroupSetBits( xEventGroup, wsBIT_0 );		break;
+			default					:	xWaitSetNotify( xWaitSet, wsNOTIFY_BIT_0 );		break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitSetISRTask( void *pvParameters )
+{
+WaitSetEvent_t xEvents[ 2 ];
+UBaseType_t uxEvent, uxCount;
+uint32_t ulValue, ulExpectedValue = 0UL;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		uxCount = uxWaitSetWait( xISRWaitSet, xEvents, 2, portMAX_DELAY );
+
+		for( uxEvent = 0; uxEvent < uxCount; uxEvent++ )
+		{
+			if( xEvents[ uxEvent ].pvObject == xISRQueue )
+			{
+				/* The values must arrive in order, with none missing. */
+				while( xQueueReceive( xISRQueue, &ulValue, 0 ) == pdPASS )
+				{
+					if( ulValue != ulExpectedValue )
+					{
+						xErrorDetected = pdTRUE;
+					}
+
+					ulExpectedValue = ulValue + 1UL;
+					ulISRValuesReceived++;
+				}
+			}
+			else if( ( xEvents[ uxEvent ].pvObject == xISRWaitSet ) && ( xEvents[ uxEvent ].uxEventBits == wsNOTIFY_BIT_0 ) )
+			{
+				ulISRNotifications++;
+			}
+			else
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vWaitSetPeriodicISRDemo( void )
+{
+static uint32_t ulCallCount = 0UL, ulPosts = 0UL;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook().  The tick interrupt performs a context
+	switch if one is needed, so xHigherPriorityTaskWoken is not used. */
+	ulCallCount++;
+
+	if( ulCallCount >= wsISR_PERIOD )
+	{
+		ulCallCount = 0UL;
+
+		if( ( ulPosts & 0x01UL ) == 0UL )
+		{
+			/* The value is only moved on if it was sent, so a full queue does
+			not cause a gap in the sequence. */
+			if( xQueueSendFromISR( xISRQueue, ( void * ) &ulISRValue, &xHigherPriorityTaskWoken ) == pdPASS )
+			{
+				ulISRValue++;
+			}
+		}
+		else
+		{
+			xWaitSetNotifyFromISR( xISRWaitSet, wsNOTIFY_BIT_0, &xHigherPriorityTaskWoken );
+		}
+
+		ulPosts++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreWaitSetTasksStillRunning( void )
+{
+static uint32_t ulLastCycles = 0UL, ulLastISRValuesReceived = 0UL, ulLastISRNotifications = 0UL;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulCycles == ulLastCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( ulISRValuesReceived == ulLastISRValuesReceived ) || ( ulISRNotifications == ulLastISRNotifications ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastCycles = ulCycles;
+	ulLastISRValuesReceived = ulISRValuesReceived;
+	ulLastISRNotifications = ulISRNotifications;
+
+	return xReturn;
+}
@@ -0,0 +1,589 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the work queue API in workqueue.h.
+ *
+ * A work queue of wqNUM_WORKERS workers is created when the demo is started.
+ * A control task, which has a priority below that of the workers, then
+ * repeatedly performs the following tests:
+ *
+ * Submit and flush - A number of work items are submitted, along with an item
+ * that submits itself again from within its own function until it has
+ * executed wqCHAIN_LENGTH times.  The work queue is then flushed, after which
+ * every item must have executed the expected number of times.
+ *
+ * Cancel - With the scheduler suspended, so the workers cannot run, an item is
+ * submitted, then submitted again, which must fail as it is already waiting.
+ * The item is then cancelled, after which cancelling it again must fail.  The
+ * item must not execute.
+ *
+ * Delayed work - A delayed item is submitted and must execute no sooner than
+ * wqDELAY_TICKS ticks later, and before twice that time has passed.  A second
+ * delayed item is cancelled before it becomes ready, so must not execute.
+ *
+ * Slow work - An item that blocks for wqSLOW_TICKS is submitted at the same
+ * time as a number of quick items.  Some of the quick items are given to the
+ * worker that executes the slow item, so the other worker has to steal them.
+ * All the quick items must execute within wqSLOW_TICKS ticks, so none can
+ * have waited behind the slow item.  A slow function passed to
+ * xTimerPendFunctionCall() would delay everything behind it in the timer
+ * command queue instead.
+ *
+ * Delete - A second work queue with a single worker is created.  Deleting it
+ * must fail while a delayed item is waiting, and succeed once the item has
+ * been cancelled and another item has been submitted and flushed.  Only one
+ * such worker exists at a time, and the control task waits for the idle task
+ * to free it before continuing, so the number of tasks checked by the "death"
+ * demo tasks is not upset.
+ *
+ * In addition, vWorkQueuePeriodicISRDemo() submits an item to the work queue
+ * from the tick hook every wqISR_PERIOD ticks.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workqueue.h"
+
+/* Demo program include files. */
+#include "WorkQueueDemo.h"
+
+/* The number of workers in the work queue used by the control task. */
+#define wqNUM_WORKERS			( 2 )
+
+/* The number of quick work items submitted by each test. */
+#define wqNUM_ITEMS				( 8 )
+
+/* The number of times the chained item executes each time it is submitted by
+the control task. */
+#define wqCHAIN_LENGTH			( 5UL )
+
+/* The delay used by the delayed work test, and the time the slow work item
+blocks for. */
+#define wqDELAY_TICKS			( ( TickType_t ) 10 )
+#define wqSLOW_TICKS			( ( TickType_t ) 20 )
+
+/* The maximum time the control task waits for a work queue to be flushed. */
+#define wqFLUSH_TIMEOUT			( ( TickType_t ) 100 )
+
+/* The number of tick interrupts between the submissions made by
+vWorkQueuePeriodicISRDemo(). */
+#define wqISR_PERIOD			( 10UL )
+
+/* The time the control task waits between each set of tests, and after
+deleting a work queue, to give the idle task the chance to free the deleted
+worker. */
+#define wqCYCLE_DELAY			( ( TickType_t ) 20 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The control task described at the top of this file, and the tests it
+ * performs.
+ */
+static void prvWorkQueueControlTask( void *pvParameters );
+static void prvTestSubmitAndFlush( void );
+static void prvTestCancel( void );
+static void prvTestDelayedWork( void );
+static void prvTestSlowWork( void );
+static void prvTestDelete( void );
+
+/*
+ * The functions executed by the work items.  The parameter passed into
+ * prvCountingWork() is the index of the item.
+ */
+static void prvCountingWork( void *pvParameters );
+static void prvChainedWork( void *pvParameters );
+static void prvSlowWork( void *pvParameters );
+static void prvISRWork( void *pvParameters );
+
+/*
+ * Zero the execution counts of the quick work items.
+ */
+static void prvResetCounts( void );
+
+/*-----------------------------------------------------------*/
+
+/* The work queue used by the control task and by vWorkQueuePeriodicISRDemo(),
+and the priority of its workers. */
+static WorkQueueHandle_t xWorkQueue = NULL;
+static UBaseType_t uxWorkerPriority = tskIDLE_PRIORITY;
+
+/* The work items, and the number of times, and the tick count at which, each
+of the quick items last executed. */
+static WorkItem_t xItems[ wqNUM_ITEMS ], xChainedItem, xSlowItem, xISRItem;
+static volatile uint32_t ulExecutions[ wqNUM_ITEMS ];
+static volatile TickType_t xExecutionTime[ wqNUM_ITEMS ];
+static volatile uint32_t ulChainedExecutions = 0UL, ulSlowExecutions = 0UL;
+
+/* The number of items submitted by, and executed on behalf of,
+vWorkQueuePeriodicISRDemo(). */
+static volatile uint32_t ulISRSubmissions = 0UL, ulISRExecutions = 0UL;
+
+/* Incremented each time the control task completes all its tests, so the
+check function can tell the task is still running. */
+static volatile uint32_t ulCycles = 0UL;
+
+/* Set to pdTRUE if an error is detected. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartWorkQueueTasks( UBaseType_t uxPriority )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+	{
+		vWorkItemInitialise( &( xItems[ ux ] ), prvCountingWork, ( void * ) ux );
+	}
+
+	vWorkItemInitialise( &xChainedItem, prvChainedWork, NULL );
+	vWorkItemInitialise( &xSlowItem, prvSlowWork, NULL );
+	vWorkItemInitialise( &xISRItem, prvISRWork, NULL );
+
+	/* The workers run above the control task, so an item submitted by the
+	control task executes straight away unless the scheduler is suspended. */
+	uxWorkerPriority = uxPriority + 1;
+	xWorkQueue = xWorkQueueCreate( "WQWork", wqNUM_WORKERS, uxWorkerPriority, configMINIMAL_STACK_SIZE );
+	configASSERT( xWorkQueue );
+
+	xTaskCreate( prvWorkQueueControlTask, "WQCtrl", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkQueueControlTask( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		prvTestSubmitAndFlush();
+		prvTestCancel();
+		prvTestDelayedWork();
+		prvTestSlowWork();
+		prvTestDelete();
+
+		ulCycles++;
+		vTaskDelay( wqCYCLE_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSubmitAndFlush( void )
+{
+UBaseType_t ux;
+
+	prvResetCounts();
+	ulChainedExecutions = 0UL;
+
+	for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+	{
+		if( xWorkQueueSubmit( xWorkQueue, &( xItems[ ux ] ) ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+
+	if( xWorkQueueSubmit( xWorkQueue, &xChainedItem ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* The flush waits for the chained item to stop submitting itself. */
+	if( xWorkQueueFlush( xWorkQueue, wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+	{
+		if( ulExecutions[ ux ] != 1UL )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+
+	if( ulChainedExecutions != wqCHAIN_LENGTH )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestCancel( void )
+{
+	prvResetCounts();
+
+	/* The workers cannot run while the scheduler is suspended, so the item
+	is still waiting when it is submitted again and when it is cancelled. */
+	vTaskSuspendAll();
+	{
+		if( xWorkQueueSubmit( xWorkQueue, &( xItems[ 0 ] ) ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( xWorkQueueSubmit( xWorkQueue, &( xItems[ 0 ] ) ) != pdFAIL )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( xWorkQueueCancel( xWorkQueue, &( xItems[ 0 ] ) ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( xWorkQueueCancel( xWorkQueue, &( xItems[ 0 ] ) ) != pdFAIL )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	xTaskResumeAll();
+
+	if( xWorkQueueFlush( xWorkQueue, wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ulExecutions[ 0 ] != 0UL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDelayedWork( void )
+{
+TickType_t xSubmitTime, xLatency;
+
+	prvResetCounts();
+
+	/* Suspend the scheduler so the time sampled here is the time the work
+	queue samples when the items are submitted. */
+	vTaskSuspendAll();
+	{
+		xSubmitTime = xTaskGetTickCount();
+
+		if( xWorkQueueSubmitDelayed( xWorkQueue, &( xItems[ 0 ] ), wqDELAY_TICKS ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( xWorkQueueSubmitDelayed( xWorkQueue, &( xItems[ 1 ] ), wqDELAY_TICKS ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The delayed item is already waiting. */
+		if( xWorkQueueSubmit( xWorkQueue, &( xItems[ 0 ] ) ) != pdFAIL )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	xTaskResumeAll();
+
+	if( xWorkQueueCancel( xWorkQueue, &( xItems[ 1 ] ) ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* The flush must wait for the delayed item to execute. */
+	if( xWorkQueueFlush( xWorkQueue, wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	xLatency = xExecutionTime[ 0 ] - xSubmitTime;
+
+	if( ( ulExecutions[ 0 ] != 1UL ) || ( xLatency < wqDELAY_TICKS ) || ( xLatency >= ( wqDELAY_TICKS * 2 ) ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ulExecutions[ 1 ] != 0UL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSlowWork( void )
+{
+TickType_t xSubmitTime;
+UBaseType_t ux;
+
+	prvResetCounts();
+	ulSlowExecutions = 0UL;
+
+	/* Submit everything before any worker runs, so the items are shared
+	between the workers in turn. */
+	vTaskSuspendAll();
+	{
+		xSubmitTime = xTaskGetTickCount();
+
+		if( xWorkQueueSubmit( xWorkQueue, &xSlowItem ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+		{
+			if( xWorkQueueSubmit( xWorkQueue, &( xItems[ ux ] ) ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	if( xWorkQueueFlush( xWorkQueue, wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* A quick item that waited behind the slow item would not have executed
+	until wqSLOW_TICKS had passed. */
+	for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+	{
+		if( ( ulExecutions[ ux ] != 1UL ) || ( ( xExecutionTime[ ux ] - xSubmitTime ) >= wqSLOW_TICKS ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+
+	if( ulSlowExecutions != 1UL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDelete( void )
+{
+WorkQueueHandle_t xTemporary;
+
+	prvResetCounts();
+
+	xTemporary = xWorkQueueCreate( "WQTemp", 1, uxWorkerPriority, configMINIMAL_STACK_SIZE );
+
+	if( xTemporary == NULL )
+	{
+		xErrorDetected = pdTRUE;
+		return;
+	}
+
+	/* A work queue that has a delayed item waiting cannot be deleted. */
+	if( xWorkQueueSubmitDelayed( xTemporary, &( xItems[ 0 ] ), wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWorkQueueDelete( xTemporary ) != pdFAIL )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWorkQueueCancel( xTemporary, &( xItems[ 0 ] ) ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* The work queue works as normal after the failed delete. */
+	if( xWorkQueueSubmit( xTemporary, &( xItems[ 1 ] ) ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWorkQueueFlush( xTemporary, wqFLUSH_TIMEOUT ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( ( ulExecutions[ 0 ] != 0UL ) || ( ulExecutions[ 1 ] != 1UL ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	if( xWorkQueueDelete( xTemporary ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Give the idle task the chance to free the deleted worker. */
+	vTaskDelay( wqCYCLE_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetCounts( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < wqNUM_ITEMS; ux++ )
+	{
+		ulExecutions[ ux ] = 0UL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountingWork( void *pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+	ulExecutions[ uxIndex ]++;
+	xExecutionTime[ uxIndex ] = xTaskGetTickCount();
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainedWork( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	ulChainedExecutions++;
+
+	/* An item can be submitted again from within its own function. */
+	if( ulChainedExecutions < wqCHAIN_LENGTH )
+	{
+		if( xWorkQueueSubmit( xWorkQueue, &xChainedItem ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowWork( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	/* Occupy the worker. */
+	vTaskDelay( wqSLOW_TICKS );
+	ulSlowExecutions++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvISRWork( void *pvParameters )
+{
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	ulISRExecutions++;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueuePeriodicISRDemo( void )
+{
+static uint32_t ulCallCount = 0UL;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook().  The tick interrupt performs a context
+	switch if one is needed, so xHigherPriorityTaskWoken is not used. */
+	ulCallCount++;
+
+	if( ulCallCount >= wqISR_PERIOD )
+	{
+		ulCallCount = 0UL;
+
+		/* Fails if the item submitted last time has not started executing,
+		which is not an error. */
+		if( xWorkQueueSubmitFromISR( xWorkQueue, &xISRItem, &xHigherPriorityTaskWoken ) == pdPASS )
+		{
+			ulISRSubmissions++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreWorkQueueTasksStillRunning( void )
+{
+static uint32_t ulLastCycles = 0UL, ulLastISRExecutions = 0UL;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulCycles == ulLastCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* An item submitted from the tick hook executes at most once. */
+	if( ( ulISRExecutions == ulLastISRExecutions ) || ( ulISRExecutions > ulISRSubmissions ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastCycles = ulCycles;
+	ulLastISRExecutions = ulISRExecutions;
+
+	return xReturn;
+}
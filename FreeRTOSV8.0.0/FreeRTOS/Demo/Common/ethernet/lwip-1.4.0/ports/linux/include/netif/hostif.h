@@ -0,0 +1,219 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef HOSTIF_H
+#define HOSTIF_H
+
+/*
+ * Common code for the network interfaces that exchange Ethernet frames with
+ * the Linux host through a file descriptor (see tapif.h and vwire.h).
+ *
+ * Frames are received in batches by a polling task.  Each batch is read
+ * straight into pbufs that were allocated from the pbuf pool in advance, so
+ * the pbufs are handed to the stack without copying.  Frames are transmitted
+ * by gathering the pbuf chain with writev(), again without copying.
+ *
+ * With LWIP_NETIF_RXRING frames are instead received into the buffers of a
+ * receive ring (see netif/rxring.h), the receive task playing the part of a
+ * DMA-enabled MAC that fills the armed descriptors in order.  This is a host
+ * model of the ring code that a driver for real hardware would use.
+ */
+
+#include <sys/uio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lwip/opt.h"
+#include "lwip/mem.h"
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+
+#if LWIP_NETIF_RXRING
+	#include "netif/rxring.h"
+#endif
+
+/* The maximum number of frames read by the receive task in one go. */
+#ifndef HOSTIF_RX_BATCH
+	#define HOSTIF_RX_BATCH				32
+#endif
+
+/* Priority and stack size of the task that polls for received frames.  By
+default the task runs at the priority of the tcpip thread, so a whole batch is
+queued before the tcpip thread starts to process it. */
+#ifndef HOSTIF_RX_TASK_PRIORITY
+	#define HOSTIF_RX_TASK_PRIORITY		TCPIP_THREAD_PRIO
+#endif
+
+#ifndef HOSTIF_RX_TASK_STACK_SIZE
+	#define HOSTIF_RX_TASK_STACK_SIZE	configMINIMAL_STACK_SIZE
+#endif
+
+/* When there is nothing to receive the receive task first waits up to
+HOSTIF_RX_WAIT_MS milliseconds in poll(), then blocks for HOSTIF_RX_POLL_TICKS
+ticks before polling again.  Waiting in poll() holds up the whole simulation
+while the host thread sleeps, but without it the virtual time simulator races
+ahead of whatever is at the other end of the link and the TCP retransmission
+timers expire long before the peer has had a chance to reply.  Set
+HOSTIF_RX_WAIT_MS to 0 to only poll once per HOSTIF_RX_POLL_TICKS ticks. */
+#ifndef HOSTIF_RX_WAIT_MS
+	#define HOSTIF_RX_WAIT_MS			1
+#endif
+
+#ifndef HOSTIF_RX_POLL_TICKS
+	#define HOSTIF_RX_POLL_TICKS		1
+#endif
+
+/* The number of ticks a transmit is retried for while the host is not
+accepting frames before the frame is dropped. */
+#ifndef HOSTIF_TX_RETRY_TICKS
+	#define HOSTIF_TX_RETRY_TICKS		10
+#endif
+
+/* Largest frame handled, including any padding added by ETH_PAD_SIZE. */
+#define HOSTIF_MAX_FRAME_SIZE			( ETH_PAD_SIZE + 1514 )
+
+/* The number of pool pbufs, and so I/O vectors, a maximum size frame can
+occupy. */
+#define HOSTIF_MAX_IOV					( ( HOSTIF_MAX_FRAME_SIZE / PBUF_POOL_BUFSIZE ) + 2 )
+
+/* The number of descriptors in the receive ring, and the number of buffers
+they are armed with.  Buffers beyond the number of descriptors are what the
+stack can hold on to before the ring starts to copy frames. */
+#ifndef HOSTIF_RX_RING_SIZE
+	#define HOSTIF_RX_RING_SIZE			( HOSTIF_RX_BATCH * 2 )
+#endif
+
+#ifndef HOSTIF_RX_RING_BUFFERS
+	#define HOSTIF_RX_RING_BUFFERS		( HOSTIF_RX_RING_SIZE * 2 )
+#endif
+
+#define HOSTIF_RX_RING_BUFFER_SIZE		LWIP_MEM_ALIGN_SIZE( HOSTIF_MAX_FRAME_SIZE )
+
+/* The number of I/O vectors a transmitted frame is gathered from.  Chains sent
+with tcp_write_pbuf() can reference several application buffers per segment.
+A chain with more pbufs than this is copied into a bounce buffer instead. */
+#ifndef HOSTIF_TX_MAX_IOV
+	#define HOSTIF_TX_MAX_IOV			( HOSTIF_MAX_IOV * 4 )
+#endif
+
+struct hostif;
+
+/*
+ * Reads up to iFrames frames from the file descriptor without blocking.  Frame
+ * x must be scattered into the pxHostIf->xRxIov[ x ] vectors, and its length
+ * written to pxHostIf->lRxLength[ x ].  Returns the number of frames read.
+ */
+typedef int ( *hostif_receive_fn )( struct hostif *pxHostIf, int iFrames );
+
+struct hostif
+{
+	struct netif *pxNetIf;
+	int iFd;
+	hostif_receive_fn pxReceive;
+
+	/* Pbufs waiting for the next batch of frames, and the vectors that point
+	into them.  Slots handed to the stack are NULL until refilled. */
+	struct pbuf *pxRxPbuf[ HOSTIF_RX_BATCH ];
+	struct iovec xRxIov[ HOSTIF_RX_BATCH ][ HOSTIF_MAX_IOV ];
+	int iRxIovCount[ HOSTIF_RX_BATCH ];
+	long lRxLength[ HOSTIF_RX_BATCH ];
+
+	#if LWIP_NETIF_RXRING
+		/* The receive ring, and the descriptor table of the modelled MAC
+		that the ring arms. */
+		struct rxring xRxRing;
+		struct rxring_buf *pxRxRingDesc[ HOSTIF_RX_RING_SIZE ];
+		struct rxring_buf xRxRingBuf[ HOSTIF_RX_RING_BUFFERS ];
+		struct iovec xRxDesc[ HOSTIF_RX_RING_SIZE ];
+		u8_t *pucRxRingMem;
+	#endif
+
+	/* Holds a frame whose chain is too long to be gathered. */
+	u8_t ucTxBounce[ HOSTIF_MAX_FRAME_SIZE ];
+
+	/* Counters for tuning the batch size. */
+	u32_t ulRxBatches;
+	u32_t ulRxFrames;
+	u32_t ulRxNoBuffer;
+	u32_t ulTxFrames;
+	u32_t ulTxRetries;
+	u32_t ulTxBounced;
+};
+
+/*
+ * Called by the init function of a driver once it has opened iFd.  Fills in
+ * the netif, allocates the hostif state (pointed to by pxNetIf->state) and
+ * starts the receive task.  iFd must be non-blocking.
+ */
+err_t hostif_init( struct netif *pxNetIf, int iFd, hostif_receive_fn pxReceive, char cName0, char cName1 );
+
+/*
+ * Scatter or gather a pbuf chain to or from I/O vectors.  Returns the number of
+ * vectors used, or -1 if there are not enough.
+ */
+int hostif_pbuf_to_iov( struct pbuf *p, struct iovec *pxIov, int iMaxIov );
+
+#endif /* HOSTIF_H */
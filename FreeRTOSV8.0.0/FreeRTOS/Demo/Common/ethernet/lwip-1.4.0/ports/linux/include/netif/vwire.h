@@ -0,0 +1,141 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef VWIRE_H
+#define VWIRE_H
+
+/*
+ * A virtual wire - a point to point Ethernet link between two lwIP network
+ * interfaces that is carried by a pair of connected host sockets, so
+ * throughput can be measured without any network hardware or host
+ * configuration.  Create the wire with vwire_create(), then pass a pointer to
+ * one of the two descriptors as the state parameter of netif_add():
+ *
+ *     int iWire[ 2 ];
+ *
+ *     vwire_create( iWire );
+ *     if( fork() == 0 )
+ *     {
+ *         close( iWire[ 0 ] );
+ *         ...start the scheduler, then from a task...
+ *         netif_add( &xNetIf, &xIPAddr, &xNetMask, &xGateway, &iWire[ 1 ], vwire_init, tcpip_input );
+ *     }
+ *
+ * Each end of the wire is owned by a different process, each running its own
+ * copy of FreeRTOS and lwIP.  Two stacks cannot share one process: lwIP keeps
+ * its state (netif list, pcbs, ARP table, pools) in global variables, and the
+ * simulator port runs a single scheduler per process.  The program that
+ * creates the wire forks the second stack itself, so the wire still needs no
+ * host configuration, privileges or TAP devices.  See
+ * Demo/lwIP_Posix_GCC_Simulator/iperf.c.
+ *
+ * Frames are received with recvmmsg(), a whole batch per system call.  The
+ * MAC address is derived from the IP address.
+ *
+ * vwire_create_impaired() creates a wire that behaves like a long or lossy
+ * path instead: a relay process sits between the two ends and delays, rate
+ * limits and drops frames, much like the Linux netem queuing discipline.
+ */
+
+#include "netif/hostif.h"
+
+/* Size of the host socket buffers in each direction.  This is the amount of
+data that can be in flight on the wire. */
+#ifndef VWIRE_SOCKET_BUFFER_SIZE
+	#define VWIRE_SOCKET_BUFFER_SIZE	( 1024 * 1024 )
+#endif
+
+/*
+ * Create the two ends of a wire.  Returns 0 on success, or -1 with errno set.
+ */
+int vwire_create( int piEnds[ 2 ] );
+
+/* Path characteristics applied by vwire_create_impaired(), the same in both
+directions.  A member left at zero disables that impairment. */
+typedef struct xVWIRE_IMPAIRMENT
+{
+	unsigned long ulDelayMs;			/* One way propagation delay. */
+	unsigned long ulLossPerMillion;		/* Random frame loss, in frames per million. */
+	unsigned long ulRateKbps;			/* Link rate, in kbit/s. */
+	unsigned long ulQueueFrames;		/* Frames queued per direction before tail drop, 0 for the default. */
+	unsigned int uiSeed;				/* Seed of the loss generator, so runs are repeatable. */
+} xVWireImpairment;
+
+/* Frames the relay queues per direction when ulQueueFrames is zero. */
+#ifndef VWIRE_IMPAIRED_QUEUE_FRAMES
+	#define VWIRE_IMPAIRED_QUEUE_FRAMES	4096
+#endif
+
+/*
+ * Create the two ends of a wire, with the frames passing through a relay
+ * process that applies the impairments described by pxImpairment.  The relay
+ * exits when the process that created it does.  Returns 0 on success, or -1
+ * with errno set.
+ */
+int vwire_create_impaired( int piEnds[ 2 ], const xVWireImpairment *pxImpairment );
+
+err_t vwire_init( struct netif *pxNetIf );
+
+#endif /* VWIRE_H */
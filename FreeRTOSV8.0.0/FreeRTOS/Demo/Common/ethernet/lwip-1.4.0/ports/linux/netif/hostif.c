@@ -0,0 +1,528 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/snmp.h"
+#include "netif/etharp.h"
+#include "netif/hostif.h"
+
+/*
+ * Polls the file descriptor, handing each batch of received frames to the
+ * stack.
+ */
+static void prvReceiveTask( void *pvParameters );
+
+/*
+ * Read one batch of frames and pass them to the stack.  Returns the number of
+ * frames read.
+ */
+static int prvReceiveBatch( struct hostif *pxHostIf );
+
+/*
+ * Make sure every receive slot has a pbuf to receive into.  Returns the number
+ * of consecutive slots, from the first, that are ready.
+ */
+static int prvRefillReceiveSlots( struct hostif *pxHostIf );
+
+#if LWIP_NETIF_RXRING
+
+	/*
+	 * Arms a descriptor of the modelled MAC.
+	 */
+	static void prvRxRingPost( struct rxring *pxRing, u16_t usDesc, u8_t *pucMem, u16_t usLength );
+
+#endif
+
+/*
+ * Send a frame to the host.
+ */
+static err_t prvLowLevelOutput( struct netif *pxNetIf, struct pbuf *p );
+
+/*-----------------------------------------------------------*/
+
+int hostif_pbuf_to_iov( struct pbuf *p, struct iovec *pxIov, int iMaxIov )
+{
+int iCount = 0;
+
+	while( p != NULL )
+	{
+		if( p->len != 0 )
+		{
+			if( iCount == iMaxIov )
+			{
+				iCount = -1;
+				break;
+			}
+
+			pxIov[ iCount ].iov_base = p->payload;
+			pxIov[ iCount ].iov_len = p->len;
+			iCount++;
+		}
+
+		p = p->next;
+	}
+
+	return iCount;
+}
+/*-----------------------------------------------------------*/
+
+#if LWIP_NETIF_RXRING
+
+static void prvRxRingPost( struct rxring *pxRing, u16_t usDesc, u8_t *pucMem, u16_t usLength )
+{
+struct hostif *pxHostIf = ( struct hostif * ) pxRing->state;
+
+	pxHostIf->xRxDesc[ usDesc ].iov_base = pucMem;
+	pxHostIf->xRxDesc[ usDesc ].iov_len = usLength;
+}
+/*-----------------------------------------------------------*/
+
+static int prvRefillReceiveSlots( struct hostif *pxHostIf )
+{
+struct rxring *pxRing = &( pxHostIf->xRxRing );
+int x, iReady;
+u16_t usDesc;
+
+	rxring_refill( pxRing, 0 );
+
+	/* Like a MAC, receive into the armed descriptors in order, starting at
+	the head of the ring. */
+	iReady = LWIP_MIN( ( int ) pxRing->armed, HOSTIF_RX_BATCH );
+	usDesc = pxRing->head;
+
+	for( x = 0; x < iReady; x++ )
+	{
+		pxHostIf->xRxIov[ x ][ 0 ] = pxHostIf->xRxDesc[ usDesc ];
+		pxHostIf->iRxIovCount[ x ] = 1;
+		usDesc = ( usDesc + 1 == pxRing->size ) ? 0 : usDesc + 1;
+	}
+
+	if( iReady == 0 )
+	{
+		/* All the buffers are held by the stack.  Frames are left with the
+		host until some are freed. */
+		pxHostIf->ulRxNoBuffer++;
+	}
+
+	return iReady;
+}
+
+#else /* LWIP_NETIF_RXRING */
+
+static int prvRefillReceiveSlots( struct hostif *pxHostIf )
+{
+int x;
+struct pbuf *p;
+
+	for( x = 0; x < HOSTIF_RX_BATCH; x++ )
+	{
+		if( pxHostIf->pxRxPbuf[ x ] == NULL )
+		{
+			p = pbuf_alloc( PBUF_RAW, HOSTIF_MAX_FRAME_SIZE, PBUF_POOL );
+
+			if( p == NULL )
+			{
+				/* The pool is exhausted, so only receive into the slots that
+				are ready.  Frames are left with the host until the stack frees
+				some pbufs, which is the only flow control there is. */
+				pxHostIf->ulRxNoBuffer++;
+				break;
+			}
+
+			#if ETH_PAD_SIZE
+				pbuf_header( p, -ETH_PAD_SIZE ); /* drop the padding word */
+			#endif
+
+			pxHostIf->iRxIovCount[ x ] = hostif_pbuf_to_iov( p, pxHostIf->xRxIov[ x ], HOSTIF_MAX_IOV );
+			LWIP_ASSERT( "HOSTIF_MAX_IOV too small", pxHostIf->iRxIovCount[ x ] > 0 );
+			pxHostIf->pxRxPbuf[ x ] = p;
+		}
+	}
+
+	return x;
+}
+
+#endif /* LWIP_NETIF_RXRING */
+/*-----------------------------------------------------------*/
+
+static int prvReceiveBatch( struct hostif *pxHostIf )
+{
+int iReady, iReceived, x;
+struct pbuf *p;
+struct netif *pxNetIf = pxHostIf->pxNetIf;
+
+	iReady = prvRefillReceiveSlots( pxHostIf );
+	iReceived = 0;
+
+	if( iReady > 0 )
+	{
+		iReceived = pxHostIf->pxReceive( pxHostIf, iReady );
+	}
+
+	if( iReceived > 0 )
+	{
+		pxHostIf->ulRxBatches++;
+		pxHostIf->ulRxFrames += ( u32_t ) iReceived;
+	}
+
+	for( x = 0; x < iReceived; x++ )
+	{
+		#if LWIP_NETIF_RXRING
+		{
+			if( ( pxHostIf->lRxLength[ x ] < ( long ) SIZEOF_ETH_HDR ) || ( pxHostIf->lRxLength[ x ] > ( long ) ( HOSTIF_MAX_FRAME_SIZE - ETH_PAD_SIZE ) ) )
+			{
+				/* Runt or truncated frame.  The buffer stays with the ring. */
+				rxring_skip( &( pxHostIf->xRxRing ) );
+				LINK_STATS_INC( link.lenerr );
+				LINK_STATS_INC( link.drop );
+				continue;
+			}
+
+			/* The pbuf refers to the ring buffer unless the ring is short of
+			buffers, and already includes the padding word. */
+			p = rxring_input( &( pxHostIf->xRxRing ), ( u16_t ) pxHostIf->lRxLength[ x ] );
+
+			if( p == NULL )
+			{
+				LINK_STATS_INC( link.memerr );
+				LINK_STATS_INC( link.drop );
+				continue;
+			}
+		}
+		#else /* LWIP_NETIF_RXRING */
+		{
+			p = pxHostIf->pxRxPbuf[ x ];
+
+			if( ( pxHostIf->lRxLength[ x ] < ( long ) SIZEOF_ETH_HDR ) || ( pxHostIf->lRxLength[ x ] > ( long ) ( HOSTIF_MAX_FRAME_SIZE - ETH_PAD_SIZE ) ) )
+			{
+				/* Runt or truncated frame.  Leave the pbuf in its slot to be
+				received into again. */
+				LINK_STATS_INC( link.lenerr );
+				LINK_STATS_INC( link.drop );
+				continue;
+			}
+
+			/* Hand the pbuf the frame was received into to the stack as it
+			is, trimmed to the frame length. */
+			pxHostIf->pxRxPbuf[ x ] = NULL;
+			pbuf_realloc( p, ( u16_t ) pxHostIf->lRxLength[ x ] );
+
+			#if ETH_PAD_SIZE
+				pbuf_header( p, ETH_PAD_SIZE ); /* reclaim the padding word */
+			#endif
+		}
+		#endif /* LWIP_NETIF_RXRING */
+
+		LINK_STATS_INC( link.recv );
+		snmp_add_ifinoctets( pxNetIf, p->tot_len );
+
+		if( pxNetIf->input( p, pxNetIf ) != ERR_OK )
+		{
+			LWIP_DEBUGF( NETIF_DEBUG, ( "hostif: input error\n" ) );
+			LINK_STATS_INC( link.drop );
+			pbuf_free( p );
+		}
+	}
+
+	return iReceived;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void *pvParameters )
+{
+struct hostif *pxHostIf = ( struct hostif * ) pvParameters;
+int iReceived;
+
+	#if HOSTIF_RX_WAIT_MS > 0
+		struct pollfd xPollFd;
+
+		xPollFd.fd = pxHostIf->iFd;
+		xPollFd.events = POLLIN;
+	#endif
+
+	for( ;; )
+	{
+		iReceived = prvReceiveBatch( pxHostIf );
+
+		if( iReceived == HOSTIF_RX_BATCH )
+		{
+			/* There is probably more waiting.  Let the tcpip thread process
+			this batch before reading the next. */
+			taskYIELD();
+		}
+		else if( iReceived == 0 )
+		{
+			#if HOSTIF_RX_WAIT_MS > 0
+			{
+				if( poll( &xPollFd, 1, HOSTIF_RX_WAIT_MS ) > 0 )
+				{
+					continue;
+				}
+			}
+			#endif
+
+			vTaskDelay( HOSTIF_RX_POLL_TICKS );
+		}
+		else
+		{
+			/* The host has been drained. */
+			vTaskDelay( HOSTIF_RX_POLL_TICKS );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLowLevelOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+struct hostif *pxHostIf = ( struct hostif * ) pxNetIf->state;
+struct iovec xIov[ HOSTIF_TX_MAX_IOV ];
+int iIovCount;
+ssize_t xSent;
+TickType_t xRetries = 0;
+err_t xReturn = ERR_OK;
+
+	#if ETH_PAD_SIZE
+		pbuf_header( p, -ETH_PAD_SIZE ); /* drop the padding word */
+	#endif
+
+	/* Gather the chain straight from the pbufs rather than copying it into a
+	contiguous buffer. */
+	iIovCount = hostif_pbuf_to_iov( p, xIov, ( int ) ( sizeof( xIov ) / sizeof( xIov[ 0 ] ) ) );
+
+	if( ( iIovCount < 0 ) && ( p->tot_len <= sizeof( pxHostIf->ucTxBounce ) ) )
+	{
+		/* Too fragmented to gather, which is only expected of zero-copy
+		chains, so copy it. */
+		xIov[ 0 ].iov_base = pxHostIf->ucTxBounce;
+		xIov[ 0 ].iov_len = pbuf_copy_partial( p, pxHostIf->ucTxBounce, p->tot_len, 0 );
+		iIovCount = 1;
+		pxHostIf->ulTxBounced++;
+	}
+
+	if( iIovCount < 0 )
+	{
+		LINK_STATS_INC( link.lenerr );
+		LINK_STATS_INC( link.drop );
+		snmp_inc_ifoutdiscards( pxNetIf );
+		xReturn = ERR_BUF;
+	}
+	else
+	{
+		for( ;; )
+		{
+			xSent = writev( pxHostIf->iFd, xIov, iIovCount );
+
+			if( ( xSent < 0 ) && ( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) || ( errno == ENOBUFS ) ) && ( xRetries < HOSTIF_TX_RETRY_TICKS ) )
+			{
+				/* The host buffers are full.  Give whatever is at the other
+				end a chance to catch up rather than drop the frame, as the
+				stack does not retry frames dropped here. */
+				xRetries++;
+				pxHostIf->ulTxRetries++;
+				vTaskDelay( 1 );
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if( xSent != ( ssize_t ) p->tot_len )
+		{
+			LINK_STATS_INC( link.memerr );
+			LINK_STATS_INC( link.drop );
+			snmp_inc_ifoutdiscards( pxNetIf );
+			xReturn = ERR_BUF;
+		}
+		else
+		{
+			LINK_STATS_INC( link.xmit );
+			pxHostIf->ulTxFrames++;
+			snmp_add_ifoutoctets( pxNetIf, p->tot_len );
+
+			if( ( ( ( u8_t * ) p->payload )[ 0 ] & 1 ) != 0 )
+			{
+				/* broadcast or multicast packet*/
+				snmp_inc_ifoutnucastpkts( pxNetIf );
+			}
+			else
+			{
+				/* unicast packet */
+				snmp_inc_ifoutucastpkts( pxNetIf );
+			}
+		}
+	}
+
+	#if ETH_PAD_SIZE
+		pbuf_header( p, ETH_PAD_SIZE ); /* reclaim the padding word */
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+err_t hostif_init( struct netif *pxNetIf, int iFd, hostif_receive_fn pxReceive, char cName0, char cName1 )
+{
+struct hostif *pxHostIf;
+u32_t ulAddress;
+err_t xReturn = ERR_OK;
+
+	LWIP_ASSERT( "pxNetIf != NULL", ( pxNetIf != NULL ) );
+
+	pxHostIf = ( struct hostif * ) pvPortMalloc( sizeof( struct hostif ) );
+
+	if( pxHostIf == NULL )
+	{
+		LWIP_DEBUGF( NETIF_DEBUG, ( "hostif_init: out of memory\n" ) );
+		xReturn = ERR_MEM;
+	}
+	else
+	{
+		memset( pxHostIf, 0x00, sizeof( struct hostif ) );
+		pxHostIf->pxNetIf = pxNetIf;
+		pxHostIf->iFd = iFd;
+		pxHostIf->pxReceive = pxReceive;
+
+		#if LWIP_NETIF_HOSTNAME
+		{
+			/* Initialize interface hostname */
+			pxNetIf->hostname = "lwip";
+		}
+		#endif /* LWIP_NETIF_HOSTNAME */
+
+		pxNetIf->state = pxHostIf;
+		pxNetIf->name[ 0 ] = cName0;
+		pxNetIf->name[ 1 ] = cName1;
+		pxNetIf->output = etharp_output;
+		pxNetIf->linkoutput = prvLowLevelOutput;
+		pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_IGMP | NETIF_FLAG_LINK_UP;
+		pxNetIf->mtu = 1500;
+
+		/* A locally administered MAC address derived from the IP address,
+		which netif_add() sets before calling the init function, so each end
+		of a link gets a different address without any configuration. */
+		ulAddress = ntohl( ip4_addr_get_u32( &( pxNetIf->ip_addr ) ) );
+		pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+		pxNetIf->hwaddr[ 0 ] = 0x02;
+		pxNetIf->hwaddr[ 1 ] = 0x00;
+		pxNetIf->hwaddr[ 2 ] = ( u8_t ) ( ulAddress >> 24 );
+		pxNetIf->hwaddr[ 3 ] = ( u8_t ) ( ulAddress >> 16 );
+		pxNetIf->hwaddr[ 4 ] = ( u8_t ) ( ulAddress >> 8 );
+		pxNetIf->hwaddr[ 5 ] = ( u8_t ) ulAddress;
+
+		#if LWIP_NETIF_RXRING
+		{
+			/* The buffer memory of the ring, which the host (the modelled
+			MAC) receives into. */
+			pxHostIf->pucRxRingMem = ( u8_t * ) pvPortMalloc( HOSTIF_RX_RING_BUFFERS * HOSTIF_RX_RING_BUFFER_SIZE );
+
+			if( pxHostIf->pucRxRingMem == NULL )
+			{
+				xReturn = ERR_MEM;
+			}
+			else
+			{
+				rxring_init( &( pxHostIf->xRxRing ), pxHostIf->pxRxRingDesc, HOSTIF_RX_RING_SIZE, pxHostIf->xRxRingBuf, pxHostIf->pucRxRingMem, HOSTIF_RX_RING_BUFFERS, HOSTIF_RX_RING_BUFFER_SIZE, prvRxRingPost, NULL, pxHostIf );
+			}
+		}
+		#endif
+
+		if( xReturn == ERR_OK )
+		{
+			if( xTaskCreate( prvReceiveTask, "HostIfRx", HOSTIF_RX_TASK_STACK_SIZE, pxHostIf, HOSTIF_RX_TASK_PRIORITY, NULL ) != pdPASS )
+			{
+				xReturn = ERR_MEM;
+			}
+		}
+
+		if( xReturn != ERR_OK )
+		{
+			#if LWIP_NETIF_RXRING
+			{
+				vPortFree( pxHostIf->pucRxRingMem );
+			}
+			#endif
+
+			pxNetIf->state = NULL;
+			vPortFree( pxHostIf );
+		}
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,188 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "netif/tapif.h"
+
+/* Define those to better describe your network interface. */
+#define IFNAME0 't'
+#define IFNAME1 'p'
+
+/*
+ * Read frames from the TAP device.  A TAP device returns one frame per read(),
+ * so unlike a socket it cannot be read in batches with recvmmsg().  Each frame
+ * is still read directly into its pbuf chain with readv().
+ */
+static int prvTapReceive( struct hostif *pxHostIf, int iFrames );
+
+/*
+ * Open the named TAP device.  Returns the non-blocking file descriptor, or -1.
+ */
+static int prvOpenTapDevice( const char *pcDevice );
+
+/*-----------------------------------------------------------*/
+
+static int prvTapReceive( struct hostif *pxHostIf, int iFrames )
+{
+int x;
+ssize_t xLength;
+
+	for( x = 0; x < iFrames; x++ )
+	{
+		xLength = readv( pxHostIf->iFd, pxHostIf->xRxIov[ x ], pxHostIf->iRxIovCount[ x ] );
+
+		if( xLength < 0 )
+		{
+			/* EAGAIN once the device has been drained. */
+			if( ( errno != EAGAIN ) && ( errno != EWOULDBLOCK ) )
+			{
+				LWIP_DEBUGF( NETIF_DEBUG, ( "tapif: read failed, errno %d\n", errno ) );
+			}
+
+			break;
+		}
+
+		pxHostIf->lRxLength[ x ] = ( long ) xLength;
+	}
+
+	return x;
+}
+/*-----------------------------------------------------------*/
+
+static int prvOpenTapDevice( const char *pcDevice )
+{
+int iFd;
+struct ifreq xRequest;
+
+	iFd = open( "/dev/net/tun", O_RDWR | O_NONBLOCK );
+
+	if( iFd < 0 )
+	{
+		LWIP_DEBUGF( NETIF_DEBUG, ( "tapif: cannot open /dev/net/tun, errno %d\n", errno ) );
+	}
+	else
+	{
+		/* Attach to the TAP device, with no packet information header in front
+		of the frames. */
+		memset( &xRequest, 0x00, sizeof( xRequest ) );
+		xRequest.ifr_flags = IFF_TAP | IFF_NO_PI;
+		strncpy( xRequest.ifr_name, pcDevice, IFNAMSIZ - 1 );
+
+		if( ioctl( iFd, TUNSETIFF, ( void * ) &xRequest ) < 0 )
+		{
+			LWIP_DEBUGF( NETIF_DEBUG, ( "tapif: cannot attach to %s, errno %d\n", pcDevice, errno ) );
+			close( iFd );
+			iFd = -1;
+		}
+	}
+
+	return iFd;
+}
+/*-----------------------------------------------------------*/
+
+err_t tapif_init( struct netif *pxNetIf )
+{
+const char *pcDevice;
+int iFd;
+err_t xReturn;
+
+	LWIP_ASSERT( "pxNetIf != NULL", ( pxNetIf != NULL ) );
+
+	pcDevice = ( const char * ) pxNetIf->state;
+
+	if( pcDevice == NULL )
+	{
+		pcDevice = TAPIF_DEFAULT_DEVICE;
+	}
+
+	iFd = prvOpenTapDevice( pcDevice );
+
+	if( iFd < 0 )
+	{
+		xReturn = ERR_IF;
+	}
+	else
+	{
+		xReturn = hostif_init( pxNetIf, iFd, prvTapReceive, IFNAME0, IFNAME1 );
+
+		if( xReturn != ERR_OK )
+		{
+			close( iFd );
+		}
+	}
+
+	return xReturn;
+}
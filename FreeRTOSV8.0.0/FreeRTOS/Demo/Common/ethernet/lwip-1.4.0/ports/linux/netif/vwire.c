@@ -0,0 +1,448 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* recvmmsg() is a GNU extension. */
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+/* Standard includes. */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "netif/vwire.h"
+
+/* Define those to better describe your network interface. */
+#define IFNAME0 'v'
+#define IFNAME1 'w'
+
+/* Largest frame the impairment relay can carry. */
+#define vwireMAX_FRAME_SIZE		2048
+
+/* A frame held by the impairment relay until it is due. */
+typedef struct xWIRE_FRAME
+{
+	unsigned long long ullDue;		/* Time at which the frame leaves the relay, in microseconds. */
+	size_t xLength;
+	unsigned char ucData[ vwireMAX_FRAME_SIZE ];
+} xWireFrame;
+
+/* One direction of the impairment relay - a FIFO of delayed frames. */
+typedef struct xWIRE_DIRECTION
+{
+	int iFromFd;
+	int iToFd;
+	xWireFrame *pxFrames;
+	unsigned long ulSize;
+	unsigned long ulHead;
+	unsigned long ulCount;
+	unsigned long long ullLinkFree;	/* Time at which the link has sent the last frame queued. */
+	int iSendBlocked;
+} xWireDirection;
+
+/*
+ * Receive a batch of frames with a single recvmmsg() call, each scattered
+ * directly into its pbuf chain.
+ */
+static int prvWireReceive( struct hostif *pxHostIf, int iFrames );
+
+/*
+ * The relay process body used by vwire_create_impaired().  Never returns.
+ */
+static void prvRelay( int iFdA, int iFdB, const xVWireImpairment *pxImpairment );
+
+/*
+ * Queue the frames waiting on the receiving socket of one relay direction,
+ * dropping those the loss generator or a full queue selects.
+ */
+static void prvRelayReceive( xWireDirection *pxDirection, const xVWireImpairment *pxImpairment, unsigned int *puiSeed );
+
+/*
+ * Pass on the frames of one relay direction that are due.
+ */
+static void prvRelaySend( xWireDirection *pxDirection, unsigned long long ullNow );
+
+/*
+ * The monotonic time in microseconds.
+ */
+static unsigned long long prvNow( void );
+
+/*-----------------------------------------------------------*/
+
+static int prvWireReceive( struct hostif *pxHostIf, int iFrames )
+{
+struct mmsghdr xMessages[ HOSTIF_RX_BATCH ];
+int iReceived, x;
+
+	memset( xMessages, 0x00, sizeof( struct mmsghdr ) * ( size_t ) iFrames );
+
+	for( x = 0; x < iFrames; x++ )
+	{
+		xMessages[ x ].msg_hdr.msg_iov = pxHostIf->xRxIov[ x ];
+		xMessages[ x ].msg_hdr.msg_iovlen = ( size_t ) pxHostIf->iRxIovCount[ x ];
+	}
+
+	iReceived = recvmmsg( pxHostIf->iFd, xMessages, ( unsigned int ) iFrames, MSG_DONTWAIT, NULL );
+
+	if( iReceived < 0 )
+	{
+		/* EAGAIN if there was nothing to receive. */
+		if( ( errno != EAGAIN ) && ( errno != EWOULDBLOCK ) )
+		{
+			LWIP_DEBUGF( NETIF_DEBUG, ( "vwire: receive failed, errno %d\n", errno ) );
+		}
+
+		iReceived = 0;
+	}
+
+	for( x = 0; x < iReceived; x++ )
+	{
+		if( ( xMessages[ x ].msg_hdr.msg_flags & MSG_TRUNC ) != 0 )
+		{
+			/* Too long for the pbuf, have it dropped as a bad length. */
+			pxHostIf->lRxLength[ x ] = 0L;
+		}
+		else
+		{
+			pxHostIf->lRxLength[ x ] = ( long ) xMessages[ x ].msg_len;
+		}
+	}
+
+	return iReceived;
+}
+/*-----------------------------------------------------------*/
+
+int vwire_create( int piEnds[ 2 ] )
+{
+int iReturn, iSize = VWIRE_SOCKET_BUFFER_SIZE, x;
+
+	/* Datagram sockets keep the frame boundaries. */
+	iReturn = socketpair( AF_UNIX, SOCK_DGRAM, 0, piEnds );
+
+	if( iReturn == 0 )
+	{
+		for( x = 0; x < 2; x++ )
+		{
+			( void ) setsockopt( piEnds[ x ], SOL_SOCKET, SO_SNDBUF, &iSize, sizeof( iSize ) );
+			( void ) setsockopt( piEnds[ x ], SOL_SOCKET, SO_RCVBUF, &iSize, sizeof( iSize ) );
+			( void ) fcntl( piEnds[ x ], F_SETFL, fcntl( piEnds[ x ], F_GETFL ) | O_NONBLOCK );
+		}
+	}
+
+	return iReturn;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long long prvNow( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( unsigned long long ) xNow.tv_sec * 1000000ULL ) + ( ( unsigned long long ) xNow.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRelayReceive( xWireDirection *pxDirection, const xVWireImpairment *pxImpairment, unsigned int *puiSeed )
+{
+xWireFrame *pxFrame;
+unsigned char ucDiscard[ vwireMAX_FRAME_SIZE ];
+unsigned long long ullNow, ullDeparture;
+ssize_t xReceived;
+
+	for( ;; )
+	{
+		if( pxDirection->ulCount < pxDirection->ulSize )
+		{
+			pxFrame = &( pxDirection->pxFrames[ ( pxDirection->ulHead + pxDirection->ulCount ) % pxDirection->ulSize ] );
+			xReceived = recv( pxDirection->iFromFd, pxFrame->ucData, sizeof( pxFrame->ucData ), MSG_DONTWAIT );
+		}
+		else
+		{
+			/* The queue is full, the frame is dropped at the tail. */
+			pxFrame = NULL;
+			xReceived = recv( pxDirection->iFromFd, ucDiscard, sizeof( ucDiscard ), MSG_DONTWAIT );
+		}
+
+		if( xReceived <= 0 )
+		{
+			break;
+		}
+
+		if( pxFrame == NULL )
+		{
+			continue;
+		}
+
+		if( ( pxImpairment->ulLossPerMillion != 0UL ) && ( ( unsigned long ) rand_r( puiSeed ) % 1000000UL ) < pxImpairment->ulLossPerMillion )
+		{
+			continue;
+		}
+
+		/* The frame leaves once the link has sent the frames before it and
+		then itself, and arrives one propagation delay later. */
+		ullNow = prvNow();
+		ullDeparture = ( pxDirection->ullLinkFree > ullNow ) ? pxDirection->ullLinkFree : ullNow;
+
+		if( pxImpairment->ulRateKbps != 0UL )
+		{
+			ullDeparture += ( ( unsigned long long ) xReceived * 8000ULL ) / pxImpairment->ulRateKbps;
+		}
+
+		pxDirection->ullLinkFree = ullDeparture;
+		pxFrame->ullDue = ullDeparture + ( ( unsigned long long ) pxImpairment->ulDelayMs * 1000ULL );
+		pxFrame->xLength = ( size_t ) xReceived;
+		pxDirection->ulCount++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRelaySend( xWireDirection *pxDirection, unsigned long long ullNow )
+{
+xWireFrame *pxFrame;
+
+	pxDirection->iSendBlocked = 0;
+
+	while( pxDirection->ulCount > 0UL )
+	{
+		pxFrame = &( pxDirection->pxFrames[ pxDirection->ulHead ] );
+
+		if( pxFrame->ullDue > ullNow )
+		{
+			break;
+		}
+
+		if( send( pxDirection->iToFd, pxFrame->ucData, pxFrame->xLength, MSG_DONTWAIT ) < 0 )
+		{
+			if( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) )
+			{
+				/* The receiving end is not keeping up, try again once it
+				has made room. */
+				pxDirection->iSendBlocked = 1;
+				break;
+			}
+		}
+
+		pxDirection->ulHead = ( pxDirection->ulHead + 1UL ) % pxDirection->ulSize;
+		pxDirection->ulCount--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRelay( int iFdA, int iFdB, const xVWireImpairment *pxImpairment )
+{
+xWireDirection xDirections[ 2 ];
+struct pollfd xPollFds[ 2 ];
+struct timespec xTimeout;
+unsigned long long ullNow, ullNext;
+unsigned int uiSeed = pxImpairment->uiSeed;
+int x;
+
+	memset( xDirections, 0x00, sizeof( xDirections ) );
+	xDirections[ 0 ].iFromFd = iFdA;
+	xDirections[ 0 ].iToFd = iFdB;
+	xDirections[ 1 ].iFromFd = iFdB;
+	xDirections[ 1 ].iToFd = iFdA;
+
+	for( x = 0; x < 2; x++ )
+	{
+		xDirections[ x ].ulSize = ( pxImpairment->ulQueueFrames != 0UL ) ? pxImpairment->ulQueueFrames : VWIRE_IMPAIRED_QUEUE_FRAMES;
+		xDirections[ x ].pxFrames = malloc( sizeof( xWireFrame ) * xDirections[ x ].ulSize );
+
+		if( xDirections[ x ].pxFrames == NULL )
+		{
+			_exit( 1 );
+		}
+	}
+
+	for( ;; )
+	{
+		/* Sleep until a frame arrives, a queued frame is due or a blocked
+		receiver has made room. */
+		ullNow = prvNow();
+		ullNext = 0ULL;
+
+		for( x = 0; x < 2; x++ )
+		{
+			xPollFds[ x ].fd = xDirections[ x ].iFromFd;
+			xPollFds[ x ].events = POLLIN;
+		}
+
+		for( x = 0; x < 2; x++ )
+		{
+			/* A direction that could not send waits for its receiver to make
+			room - its sending socket is the receiving socket of the other
+			direction.  Otherwise it waits for its first frame to be due. */
+			if( xDirections[ x ].iSendBlocked != 0 )
+			{
+				xPollFds[ 1 - x ].events |= POLLOUT;
+			}
+			else if( xDirections[ x ].ulCount > 0UL )
+			{
+				if( ( ullNext == 0ULL ) || ( xDirections[ x ].pxFrames[ xDirections[ x ].ulHead ].ullDue < ullNext ) )
+				{
+					ullNext = xDirections[ x ].pxFrames[ xDirections[ x ].ulHead ].ullDue;
+				}
+			}
+		}
+
+		if( ullNext == 0ULL )
+		{
+			( void ) ppoll( xPollFds, 2, NULL, NULL );
+		}
+		else
+		{
+			ullNext = ( ullNext > ullNow ) ? ( ullNext - ullNow ) : 0ULL;
+			xTimeout.tv_sec = ( time_t ) ( ullNext / 1000000ULL );
+			xTimeout.tv_nsec = ( long ) ( ( ullNext % 1000000ULL ) * 1000ULL );
+			( void ) ppoll( xPollFds, 2, &xTimeout, NULL );
+		}
+
+		for( x = 0; x < 2; x++ )
+		{
+			prvRelayReceive( &( xDirections[ x ] ), pxImpairment, &uiSeed );
+		}
+
+		ullNow = prvNow();
+
+		for( x = 0; x < 2; x++ )
+		{
+			prvRelaySend( &( xDirections[ x ] ), ullNow );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+int vwire_create_impaired( int piEnds[ 2 ], const xVWireImpairment *pxImpairment )
+{
+int iWireA[ 2 ], iWireB[ 2 ];
+pid_t xParent, xRelay;
+
+	if( vwire_create( iWireA ) != 0 )
+	{
+		return -1;
+	}
+
+	if( vwire_create( iWireB ) != 0 )
+	{
+		close( iWireA[ 0 ] );
+		close( iWireA[ 1 ] );
+		return -1;
+	}
+
+	xParent = getpid();
+	xRelay = fork();
+
+	if( xRelay < 0 )
+	{
+		close( iWireA[ 0 ] );
+		close( iWireA[ 1 ] );
+		close( iWireB[ 0 ] );
+		close( iWireB[ 1 ] );
+		return -1;
+	}
+
+	if( xRelay == 0 )
+	{
+		/* The relay forwards between the far sides of the two socket
+		pairs, and goes away with its creator. */
+		close( iWireA[ 0 ] );
+		close( iWireB[ 0 ] );
+		( void ) prctl( PR_SET_PDEATHSIG, SIGKILL );
+
+		if( getppid() != xParent )
+		{
+			_exit( 0 );
+		}
+
+		prvRelay( iWireA[ 1 ], iWireB[ 1 ], pxImpairment );
+	}
+
+	close( iWireA[ 1 ] );
+	close( iWireB[ 1 ] );
+	piEnds[ 0 ] = iWireA[ 0 ];
+	piEnds[ 1 ] = iWireB[ 0 ];
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+err_t vwire_init( struct netif *pxNetIf )
+{
+	LWIP_ASSERT( "pxNetIf != NULL", ( pxNetIf != NULL ) );
+	LWIP_ASSERT( "pxNetIf->state != NULL", ( pxNetIf->state != NULL ) );
+
+	return hostif_init( pxNetIf, *( ( int * ) pxNetIf->state ), prvWireReceive, IFNAME0, IFNAME1 );
+}
@@ -111,7 +111,7 @@ netconn_delete(struct netconn *conn)
 
   msg.function = do_delconn;
   msg.msg.conn = conn;
-  tcpip_apimsg(&msg);
+  TCPIP_APIMSG(&msg);
 
   netconn_free(conn);
 
@@ -200,8 +200,7 @@ netconn_connect(struct netconn *conn, ip_addr_t *addr, u16_t port)
   msg.msg.conn = conn;
   msg.msg.msg.bc.ipaddr = addr;
   msg.msg.msg.bc.port = port;
-  /* This is the only function which need to not block tcpip_thread */
-  err = tcpip_apimsg(&msg);
+  err = TCPIP_APIMSG(&msg);
 
   NETCONN_SET_SAFE_ERR(conn, err);
   return err;
@@ -631,9 +630,7 @@ netconn_close_shutdown(struct netconn *conn, u8_t how)
   msg.msg.conn = conn;
   /* shutting down both ends is the same as closing */
   msg.msg.msg.sd.shut = how;
-  /* because of the LWIP_TCPIP_CORE_LOCKING implementation of do_close,
-     don't use TCPIP_APIMSG here */
-  err = tcpip_apimsg(&msg);
+  err = TCPIP_APIMSG(&msg);
 
   NETCONN_SET_SAFE_ERR(conn, err);
   return err;
@@ -794,11 +794,19 @@ do_close_internal(struct netconn *conn)
       API_EVENT(conn, NETCONN_EVT_SENDPLUS, 0);
     }
     /* wake up the application task */
-    sys_sem_signal(&conn->op_completed);
+#if LWIP_TCPIP_CORE_LOCKING
+    if ((conn->flags & NETCONN_FLAG_WRITE_DELAYED) != 0)
+#endif
+    {
+      sys_sem_signal(&conn->op_completed);
+    }
   } else {
     /* Closing failed, restore some of the callbacks */
     /* Closing of listen pcb will never fail! */
     LWIP_ASSERT("Closing a listen pcb may not fail!", (conn->pcb.tcp->state != LISTEN));
+#if LWIP_TCPIP_CORE_LOCKING
+    conn->flags |= NETCONN_FLAG_WRITE_DELAYED;
+#endif
     tcp_sent(conn->pcb.tcp, sent_tcp);
     tcp_poll(conn->pcb.tcp, poll_tcp, 4);
     tcp_err(conn->pcb.tcp, err_tcp);
@@ -808,6 +816,31 @@ do_close_internal(struct netconn *conn)
   /* If closing didn't succeed, we get called again either
      from poll_tcp or from sent_tcp */
 }
+
+/**
+ * Start closing a TCP netconn in state NETCONN_CLOSE. With
+ * LWIP_TCPIP_CORE_LOCKING, this runs in the application thread, so if the
+ * close cannot be finished at once, release the core and wait until
+ * poll_tcp, sent_tcp or err_tcp has finished it.
+ *
+ * @param conn the TCP netconn to close
+ */
+static void
+do_close_start(struct netconn *conn)
+{
+#if LWIP_TCPIP_CORE_LOCKING
+  conn->flags &= ~NETCONN_FLAG_WRITE_DELAYED;
+  do_close_internal(conn);
+  if (conn->state == NETCONN_CLOSE) {
+    UNLOCK_TCPIP_CORE();
+    sys_arch_sem_wait(&conn->op_completed, 0);
+    LOCK_TCPIP_CORE();
+    LWIP_ASSERT("state!", conn->state == NETCONN_NONE);
+  }
+#else /* LWIP_TCPIP_CORE_LOCKING */
+  do_close_internal(conn);
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+}
 #endif /* LWIP_TCP */
 
 /**
@@ -853,7 +886,7 @@ do_delconn(struct api_msg_msg *msg)
         msg->conn->state = NETCONN_CLOSE;
         msg->msg.sd.shut = NETCONN_SHUT_RDWR;
         msg->conn->current_msg = msg;
-        do_close_internal(msg->conn);
+        do_close_start(msg->conn);
         /* API_EVENT is called inside do_close_internal, before releasing
            the application thread, so we can return at this point! */
         return;
@@ -870,9 +903,11 @@ do_delconn(struct api_msg_msg *msg)
     API_EVENT(msg->conn, NETCONN_EVT_RCVPLUS, 0);
     API_EVENT(msg->conn, NETCONN_EVT_SENDPLUS, 0);
   }
+#if !LWIP_TCPIP_CORE_LOCKING
   if (sys_sem_valid(&msg->conn->op_completed)) {
     sys_sem_signal(&msg->conn->op_completed);
   }
+#endif /* !LWIP_TCPIP_CORE_LOCKING */
 }
 
 /**
@@ -1005,6 +1040,14 @@ do_connect(struct api_msg_msg *msg)
           msg->conn->current_msg = msg;
           /* sys_sem_signal() is called from do_connected (or err_tcp()),
           * when the connection is established! */
+#if LWIP_TCPIP_CORE_LOCKING
+          /* do_connected runs in tcpip_thread, so release the core while
+             waiting for it */
+          UNLOCK_TCPIP_CORE();
+          sys_arch_sem_wait(&msg->conn->op_completed, 0);
+          LOCK_TCPIP_CORE();
+          LWIP_ASSERT("state!", msg->conn->state == NETCONN_NONE);
+#endif /* LWIP_TCPIP_CORE_LOCKING */
           return;
         }
       }
@@ -1016,7 +1059,7 @@ do_connect(struct api_msg_msg *msg)
     break;
     }
   }
-  sys_sem_signal(&msg->conn->op_completed);
+  TCPIP_APIMSG_ACK(msg);
 }
 
 /**
@@ -1439,7 +1482,7 @@ do_close(struct api_msg_msg *msg)
         msg->conn->write_offset == 0);
       msg->conn->state = NETCONN_CLOSE;
       msg->conn->current_msg = msg;
-      do_close_internal(msg->conn);
+      do_close_start(msg->conn);
       /* for tcp netconns, do_close_internal ACKs the message */
       return;
     }
@@ -1448,7 +1491,7 @@ do_close(struct api_msg_msg *msg)
   {
     msg->err = ERR_VAL;
   }
-  sys_sem_signal(&msg->conn->op_completed);
+  TCPIP_APIMSG_ACK(msg);
 }
 
 #if LWIP_IGMP
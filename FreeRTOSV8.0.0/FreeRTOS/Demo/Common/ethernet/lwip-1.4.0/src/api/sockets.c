@@ -80,6 +80,18 @@ struct lwip_sock {
   int err;
   /** counter of how many threads are waiting for this socket using select */
   int select_waiting;
+#if LWIP_SOCKET_EPOLL
+  /** epoll instance this socket is registered with (index + 1), 0 if none */
+  u8_t ep_set;
+  /** 1 while this socket is on the ready list of its epoll instance */
+  u8_t ep_ready;
+  /** events and user data registered with lwip_epoll_ctl */
+  u32_t ep_events;
+  epoll_data_t ep_data;
+  /** neighbours on the ready list (socket indices, -1 at either end) */
+  int ep_next;
+  int ep_prev;
+#endif /* LWIP_SOCKET_EPOLL */
 };
 
 /** Description for a task waiting in select */
@@ -94,12 +106,36 @@ struct lwip_select_cb {
   fd_set *writeset;
   /** unimplemented: exceptset passed to select */
   fd_set *exceptset;
+#if LWIP_SOCKET_POLL
+  /** pollfds passed to poll (NULL for select) */
+  struct pollfd *poll_fds;
+  /** number of pollfds passed to poll */
+  nfds_t poll_nfds;
+#endif /* LWIP_SOCKET_POLL */
   /** don't signal the same semaphore twice: set to 1 when signalled */
   int sem_signalled;
   /** semaphore to wake up a task waiting for select */
   sys_sem_t sem;
 };
 
+#if LWIP_SOCKET_EPOLL
+/** Description for an epoll instance */
+struct lwip_epoll {
+  /** 1 while this instance is in use */
+  u8_t used;
+  /** don't signal the semaphore twice: set to 1 when signalled */
+  u8_t sem_signalled;
+  /** number of tasks waiting in lwip_epoll_wait */
+  int waiting;
+  /** first and last socket on the ready list (-1 if empty) and its length */
+  int ready_head;
+  int ready_tail;
+  int ready_count;
+  /** semaphore to wake up a task waiting in lwip_epoll_wait */
+  sys_sem_t sem;
+};
+#endif /* LWIP_SOCKET_EPOLL */
+
 /** This struct is used to pass data to the set/getsockopt_internal
  * functions running in tcpip_thread context (only a void* is allowed) */
 struct lwip_setgetsockopt_data {
@@ -129,6 +165,10 @@ static struct lwip_select_cb *select_cb_list;
 /** This counter is increased from lwip_select when the list is chagned
     and checked in event_callback to see if it has changed. */
 static volatile int select_cb_ctr;
+#if LWIP_SOCKET_EPOLL
+/** The global array of epoll instances */
+static struct lwip_epoll epolls[LWIP_SOCKET_EPOLL_NUM];
+#endif /* LWIP_SOCKET_EPOLL */
 
 /** Table to quickly map an lwIP error (err_t) to a socket error
   * by using -err as an index */
@@ -175,6 +215,12 @@ static const int err_to_errno_table[] = {
 static void event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len);
 static void lwip_getsockopt_internal(void *arg);
 static void lwip_setsockopt_internal(void *arg);
+#if LWIP_SOCKET_POLL
+static int lwip_poll_should_wake(struct lwip_select_cb *scb, int s, struct lwip_sock *sock);
+#endif /* LWIP_SOCKET_POLL */
+#if LWIP_SOCKET_EPOLL
+static int lwip_epoll_close(int epfd);
+#endif /* LWIP_SOCKET_EPOLL */
 
 /**
  * Initialize this module. This function has to be called before any other
@@ -231,6 +277,125 @@ tryget_socket(int s)
   return &sockets[s];
 }
 
+#if LWIP_SOCKET_POLL || LWIP_SOCKET_EPOLL
+/**
+ * Get the events a socket is ready for: POLLIN, POLLOUT and POLLERR.
+ * Must be called protected (SYS_ARCH_PROTECT).
+ *
+ * @param sock the socket to check
+ * @return the POLL* bits of the events that are ready
+ */
+static u32_t
+lwip_sock_events(struct lwip_sock *sock)
+{
+  u32_t events = 0;
+
+  if ((sock->lastdata != NULL) || (sock->rcvevent > 0)) {
+    events |= POLLIN;
+  }
+  if (sock->sendevent != 0) {
+    events |= POLLOUT;
+  }
+  if (sock->errevent != 0) {
+    events |= POLLERR;
+  }
+  return events;
+}
+#endif /* LWIP_SOCKET_POLL || LWIP_SOCKET_EPOLL */
+
+#if LWIP_SOCKET_EPOLL
+/**
+ * Append a socket to the ready list of an epoll instance.
+ * Must be called protected.
+ */
+static void
+lwip_epoll_ready(struct lwip_epoll *ep, int s)
+{
+  struct lwip_sock *sock = &sockets[s];
+
+  sock->ep_next = -1;
+  sock->ep_prev = ep->ready_tail;
+  if (ep->ready_tail >= 0) {
+    sockets[ep->ready_tail].ep_next = s;
+  } else {
+    ep->ready_head = s;
+  }
+  ep->ready_tail = s;
+  ep->ready_count++;
+  sock->ep_ready = 1;
+}
+
+/**
+ * Take a socket off the ready list of an epoll instance.
+ * Must be called protected.
+ */
+static void
+lwip_epoll_unready(struct lwip_epoll *ep, int s)
+{
+  struct lwip_sock *sock = &sockets[s];
+
+  if (sock->ep_prev >= 0) {
+    sockets[sock->ep_prev].ep_next = sock->ep_next;
+  } else {
+    ep->ready_head = sock->ep_next;
+  }
+  if (sock->ep_next >= 0) {
+    sockets[sock->ep_next].ep_prev = sock->ep_prev;
+  } else {
+    ep->ready_tail = sock->ep_prev;
+  }
+  ep->ready_count--;
+  sock->ep_ready = 0;
+}
+
+/**
+ * Bring the ready list of the epoll instance a socket is registered with up
+ * to date after the socket's state changed, and wake up a task waiting in
+ * lwip_epoll_wait if the socket is ready. Must be called protected.
+ *
+ * @param s the socket index
+ * @param sock the socket whose state changed
+ */
+static void
+lwip_epoll_update(int s, struct lwip_sock *sock)
+{
+  struct lwip_epoll *ep;
+
+  if (sock->ep_set == 0) {
+    return;
+  }
+  ep = &epolls[sock->ep_set - 1];
+  if ((lwip_sock_events(sock) & (sock->ep_events | EPOLLERR)) != 0) {
+    if (!sock->ep_ready) {
+      lwip_epoll_ready(ep, s);
+    }
+    if ((ep->waiting > 0) && !ep->sem_signalled) {
+      ep->sem_signalled = 1;
+      sys_sem_signal(&ep->sem);
+    }
+  } else if (sock->ep_ready) {
+    lwip_epoll_unready(ep, s);
+  }
+}
+
+/**
+ * Map an epoll descriptor to its epoll instance.
+ *
+ * @param epfd epoll descriptor returned by lwip_epoll_create
+ * @return the epoll instance or NULL if not found
+ */
+static struct lwip_epoll *
+get_epoll(int epfd)
+{
+  if ((epfd < NUM_SOCKETS) || (epfd >= NUM_SOCKETS + LWIP_SOCKET_EPOLL_NUM) ||
+      !epolls[epfd - NUM_SOCKETS].used) {
+    set_errno(EBADF);
+    return NULL;
+  }
+  return &epolls[epfd - NUM_SOCKETS];
+}
+#endif /* LWIP_SOCKET_EPOLL */
+
 /**
  * Allocate a new socket for a given netconn.
  *
@@ -263,6 +428,10 @@ alloc_socket(struct netconn *newconn, int accepted)
       sockets[i].errevent   = 0;
       sockets[i].err        = 0;
       sockets[i].select_waiting = 0;
+#if LWIP_SOCKET_EPOLL
+      sockets[i].ep_set     = 0;
+      sockets[i].ep_ready   = 0;
+#endif /* LWIP_SOCKET_EPOLL */
       return i;
     }
     SYS_ARCH_UNPROTECT(lev);
@@ -289,6 +458,13 @@ free_socket(struct lwip_sock *sock, int is_tcp)
 
   /* Protect socket array */
   SYS_ARCH_PROTECT(lev);
+#if LWIP_SOCKET_EPOLL
+  /* a closed socket is removed from its epoll instance */
+  if (sock->ep_ready) {
+    lwip_epoll_unready(&epolls[sock->ep_set - 1], (int)(sock - sockets));
+  }
+  sock->ep_set     = 0;
+#endif /* LWIP_SOCKET_EPOLL */
   sock->conn       = NULL;
   SYS_ARCH_UNPROTECT(lev);
   /* don't use 'sock' after this line, as another task might have allocated it */
@@ -445,6 +621,12 @@ lwip_close(int s)
 
   LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_close(%d)\n", s));
 
+#if LWIP_SOCKET_EPOLL
+  if (s >= NUM_SOCKETS) {
+    return lwip_epoll_close(s);
+  }
+#endif /* LWIP_SOCKET_EPOLL */
+
   sock = get_socket(s);
   if (!sock) {
     return -1;
@@ -722,6 +904,16 @@ lwip_recvfrom(int s, void *mem, size_t len, int flags,
     }
   } while (!done);
 
+#if LWIP_SOCKET_EPOLL
+  {
+    /* lastdata has changed without a netconn event */
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+    lwip_epoll_update(s, sock);
+    SYS_ARCH_UNPROTECT(lev);
+  }
+#endif /* LWIP_SOCKET_EPOLL */
+
   if (off > 0) {
     /* update receive window */
     netconn_recved(sock->conn, (u32_t)off);
@@ -793,9 +985,7 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
   u16_t short_size;
   const struct sockaddr_in *to_in;
   u16_t remote_port;
-#if !LWIP_TCPIP_CORE_LOCKING
   struct netbuf buf;
-#endif
 
   sock = get_socket(s);
   if (!sock) {
@@ -821,64 +1011,6 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
              sock_set_errno(sock, err_to_errno(ERR_ARG)); return -1;);
   to_in = (const struct sockaddr_in *)(void*)to;
 
-#if LWIP_TCPIP_CORE_LOCKING
-  /* Should only be consider like a sample or a simple way to experiment this option (no check of "to" field...) */
-  {
-    struct pbuf* p;
-    ip_addr_t *remote_addr;
-
-#if LWIP_NETIF_TX_SINGLE_PBUF
-    p = pbuf_alloc(PBUF_TRANSPORT, short_size, PBUF_RAM);
-    if (p != NULL) {
-#if LWIP_CHECKSUM_ON_COPY
-      u16_t chksum = 0;
-      if (sock->conn->type != NETCONN_RAW) {
-        chksum = LWIP_CHKSUM_COPY(p->payload, data, short_size);
-      } else
-#endif /* LWIP_CHECKSUM_ON_COPY */
-      MEMCPY(p->payload, data, size);
-#else /* LWIP_NETIF_TX_SINGLE_PBUF */
-    p = pbuf_alloc(PBUF_TRANSPORT, short_size, PBUF_REF);
-    if (p != NULL) {
-      p->payload = (void*)data;
-#endif /* LWIP_NETIF_TX_SINGLE_PBUF */
-
-      if (to_in != NULL) {
-        inet_addr_to_ipaddr_p(remote_addr, &to_in->sin_addr);
-        remote_port = ntohs(to_in->sin_port);
-      } else {
-        remote_addr = &sock->conn->pcb.raw->remote_ip;
-        if (sock->conn->type == NETCONN_RAW) {
-          remote_port = 0;
-        } else {
-          remote_port = sock->conn->pcb.udp->remote_port;
-        }
-      }
-
-      LOCK_TCPIP_CORE();
-      if (sock->conn->type == NETCONN_RAW) {
-        err = sock->conn->last_err = raw_sendto(sock->conn->pcb.raw, p, remote_addr);
-      } else {
-#if LWIP_UDP
-#if LWIP_CHECKSUM_ON_COPY && LWIP_NETIF_TX_SINGLE_PBUF
-        err = sock->conn->last_err = udp_sendto_chksum(sock->conn->pcb.udp, p,
-          remote_addr, remote_port, 1, chksum);
-#else /* LWIP_CHECKSUM_ON_COPY && LWIP_NETIF_TX_SINGLE_PBUF */
-        err = sock->conn->last_err = udp_sendto(sock->conn->pcb.udp, p,
-          remote_addr, remote_port);
-#endif /* LWIP_CHECKSUM_ON_COPY && LWIP_NETIF_TX_SINGLE_PBUF */
-#else /* LWIP_UDP */
-        err = ERR_ARG;
-#endif /* LWIP_UDP */
-      }
-      UNLOCK_TCPIP_CORE();
-      
-      pbuf_free(p);
-    } else {
-      err = ERR_MEM;
-    }
-  }
-#else /* LWIP_TCPIP_CORE_LOCKING */
   /* initialize a buffer */
   buf.p = buf.ptr = NULL;
 #if LWIP_CHECKSUM_ON_COPY
@@ -926,7 +1058,6 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
 
   /* deallocated the buffer */
   netbuf_free(&buf);
-#endif /* LWIP_TCPIP_CORE_LOCKING */
   sock_set_errno(sock, err_to_errno(err));
   return (err == ERR_OK ? short_size : -1);
 }
@@ -1068,6 +1199,58 @@ lwip_selscan(int maxfdp1, fd_set *readset_in, fd_set *writeset_in, fd_set *excep
   return nready;
 }
 
+/**
+ * Put a task waiting in select or poll on the select_cb_list.
+ *
+ * @param select_cb the waiting task's description (local to select or poll)
+ */
+static void
+lwip_select_cb_link(struct lwip_select_cb *select_cb)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  /* Protect the select_cb_list */
+  SYS_ARCH_PROTECT(lev);
+
+  /* Put this select_cb on top of list */
+  select_cb->next = select_cb_list;
+  if (select_cb_list != NULL) {
+    select_cb_list->prev = select_cb;
+  }
+  select_cb_list = select_cb;
+  /* Increasing this counter tells even_callback that the list has changed. */
+  select_cb_ctr++;
+
+  /* Now we can safely unprotect */
+  SYS_ARCH_UNPROTECT(lev);
+}
+
+/**
+ * Take a task waiting in select or poll off the select_cb_list.
+ *
+ * @param select_cb the waiting task's description (local to select or poll)
+ */
+static void
+lwip_select_cb_unlink(struct lwip_select_cb *select_cb)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  SYS_ARCH_PROTECT(lev);
+  if (select_cb->next != NULL) {
+    select_cb->next->prev = select_cb->prev;
+  }
+  if (select_cb_list == select_cb) {
+    LWIP_ASSERT("select_cb->prev == NULL", select_cb->prev == NULL);
+    select_cb_list = select_cb->next;
+  } else {
+    LWIP_ASSERT("select_cb->prev != NULL", select_cb->prev != NULL);
+    select_cb->prev->next = select_cb->next;
+  }
+  /* Increasing this counter tells even_callback that the list has changed. */
+  select_cb_ctr++;
+  SYS_ARCH_UNPROTECT(lev);
+}
+
 /**
  * Processing exceptset is not yet implemented.
  */
@@ -1112,6 +1295,10 @@ lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset,
     select_cb.readset = readset;
     select_cb.writeset = writeset;
     select_cb.exceptset = exceptset;
+#if LWIP_SOCKET_POLL
+    select_cb.poll_fds = NULL;
+    select_cb.poll_nfds = 0;
+#endif /* LWIP_SOCKET_POLL */
     select_cb.sem_signalled = 0;
     err = sys_sem_new(&select_cb.sem, 0);
     if (err != ERR_OK) {
@@ -1120,20 +1307,7 @@ lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset,
       return -1;
     }
 
-    /* Protect the select_cb_list */
-    SYS_ARCH_PROTECT(lev);
-
-    /* Put this select_cb on top of list */
-    select_cb.next = select_cb_list;
-    if (select_cb_list != NULL) {
-      select_cb_list->prev = &select_cb;
-    }
-    select_cb_list = &select_cb;
-    /* Increasing this counter tells even_callback that the list has changed. */
-    select_cb_ctr++;
-
-    /* Now we can safely unprotect */
-    SYS_ARCH_UNPROTECT(lev);
+    lwip_select_cb_link(&select_cb);
 
     /* Increase select_waiting for each socket we are interested in */
     for(i = 0; i < maxfdp1; i++) {
@@ -1180,21 +1354,7 @@ lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset,
         SYS_ARCH_UNPROTECT(lev);
       }
     }
-    /* Take us off the list */
-    SYS_ARCH_PROTECT(lev);
-    if (select_cb.next != NULL) {
-      select_cb.next->prev = select_cb.prev;
-    }
-    if (select_cb_list == &select_cb) {
-      LWIP_ASSERT("select_cb.prev == NULL", select_cb.prev == NULL);
-      select_cb_list = select_cb.next;
-    } else {
-      LWIP_ASSERT("select_cb.prev != NULL", select_cb.prev != NULL);
-      select_cb.prev->next = select_cb.next;
-    }
-    /* Increasing this counter tells even_callback that the list has changed. */
-    select_cb_ctr++;
-    SYS_ARCH_UNPROTECT(lev);
+    lwip_select_cb_unlink(&select_cb);
 
     sys_sem_free(&select_cb.sem);
     if (waitres == SYS_ARCH_TIMEOUT)  {
@@ -1226,6 +1386,368 @@ return_copy_fdsets:
   return nready;
 }
 
+#if LWIP_SOCKET_POLL
+/**
+ * Go through the pollfds and store the events that are ready for each of
+ * them in its revents. Negative fds are ignored, invalid ones get POLLNVAL.
+ *
+ * @param fds the pollfds passed to lwip_poll
+ * @param nfds the number of pollfds
+ * @return number of pollfds with events (>= 0)
+ */
+static int
+lwip_pollscan(struct pollfd *fds, nfds_t nfds)
+{
+  nfds_t i;
+  int nready = 0;
+  u32_t events;
+  struct lwip_sock *sock;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  for (i = 0; i < nfds; i++) {
+    fds[i].revents = 0;
+    if (fds[i].fd < 0) {
+      continue;
+    }
+    SYS_ARCH_PROTECT(lev);
+    sock = tryget_socket(fds[i].fd);
+    events = (sock != NULL) ? lwip_sock_events(sock) : POLLNVAL;
+    SYS_ARCH_UNPROTECT(lev);
+    /* POLLERR and POLLNVAL are reported even if not requested */
+    fds[i].revents = (short)(events & ((u32_t)fds[i].events | POLLERR | POLLNVAL));
+    if (fds[i].revents != 0) {
+      LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_pollscan: fd=%d revents=0x%x\n", fds[i].fd, fds[i].revents));
+      nready++;
+    }
+  }
+  return nready;
+}
+
+/**
+ * Count a task waiting in poll in (or out of) select_waiting of each socket
+ * it polls, so that event_callback looks for it.
+ */
+static void
+lwip_poll_waiting(struct pollfd *fds, nfds_t nfds, int inc)
+{
+  nfds_t i;
+  struct lwip_sock *sock;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  for (i = 0; i < nfds; i++) {
+    SYS_ARCH_PROTECT(lev);
+    sock = tryget_socket(fds[i].fd);
+    if (sock != NULL) {
+      sock->select_waiting += inc;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+  }
+}
+
+/**
+ * Check whether an event on socket 's' satisfies a task waiting in poll.
+ * Called protected from event_callback.
+ */
+static int
+lwip_poll_should_wake(struct lwip_select_cb *scb, int s, struct lwip_sock *sock)
+{
+  nfds_t i;
+  u32_t events = lwip_sock_events(sock);
+
+  for (i = 0; i < scb->poll_nfds; i++) {
+    if ((scb->poll_fds[i].fd == s) &&
+        ((events & ((u32_t)scb->poll_fds[i].events | POLLERR)) != 0)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Wait for events on a set of sockets. Unlike lwip_select, this only looks
+ * at the sockets passed in, not at every socket up to the highest one.
+ *
+ * @param fds the sockets and the events to wait for, revents is set on return
+ * @param nfds the number of entries in fds
+ * @param timeout in milliseconds, -1 to wait forever, 0 not to wait at all
+ * @return the number of entries with revents set, 0 on timeout, -1 on error
+ */
+int
+lwip_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+  u32_t waitres = 0;
+  int nready;
+  struct lwip_select_cb select_cb;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_poll(%p, %d, %d)\n", (void *)fds, (int)nfds, timeout));
+
+  if ((fds == NULL) && (nfds != 0)) {
+    set_errno(EINVAL);
+    return -1;
+  }
+
+  nready = lwip_pollscan(fds, nfds);
+  if (!nready && (timeout != 0)) {
+    select_cb.next = NULL;
+    select_cb.prev = NULL;
+    select_cb.readset = NULL;
+    select_cb.writeset = NULL;
+    select_cb.exceptset = NULL;
+    select_cb.poll_fds = fds;
+    select_cb.poll_nfds = nfds;
+    select_cb.sem_signalled = 0;
+    if (sys_sem_new(&select_cb.sem, 0) != ERR_OK) {
+      /* failed to create semaphore */
+      set_errno(ENOMEM);
+      return -1;
+    }
+
+    lwip_select_cb_link(&select_cb);
+    lwip_poll_waiting(fds, nfds, 1);
+
+    /* Scan again: there could have been events between the last scan
+       (whithout us on the list) and putting us on the list! */
+    nready = lwip_pollscan(fds, nfds);
+    if (!nready) {
+      /* 0 means wait forever for sys_arch_sem_wait */
+      waitres = sys_arch_sem_wait(&select_cb.sem, (timeout < 0) ? 0 : (u32_t)timeout);
+    }
+
+    lwip_poll_waiting(fds, nfds, -1);
+    lwip_select_cb_unlink(&select_cb);
+    sys_sem_free(&select_cb.sem);
+
+    if (!nready && (waitres != SYS_ARCH_TIMEOUT)) {
+      nready = lwip_pollscan(fds, nfds);
+    }
+  }
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_poll: nready=%d\n", nready));
+  set_errno(0);
+  return nready;
+}
+#endif /* LWIP_SOCKET_POLL */
+
+#if LWIP_SOCKET_EPOLL
+/**
+ * Create an epoll instance.
+ *
+ * @param size unused (must be > 0)
+ * @return the epoll descriptor, -1 on error
+ */
+int
+lwip_epoll_create(int size)
+{
+  int i;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  if (size <= 0) {
+    set_errno(EINVAL);
+    return -1;
+  }
+  for (i = 0; i < LWIP_SOCKET_EPOLL_NUM; i++) {
+    SYS_ARCH_PROTECT(lev);
+    if (!epolls[i].used) {
+      epolls[i].used = 1;
+      SYS_ARCH_UNPROTECT(lev);
+      epolls[i].sem_signalled = 0;
+      epolls[i].waiting = 0;
+      epolls[i].ready_head = -1;
+      epolls[i].ready_tail = -1;
+      epolls[i].ready_count = 0;
+      if (sys_sem_new(&epolls[i].sem, 0) != ERR_OK) {
+        epolls[i].used = 0;
+        set_errno(ENOMEM);
+        return -1;
+      }
+      LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_create() = %d\n", NUM_SOCKETS + i));
+      set_errno(0);
+      return NUM_SOCKETS + i;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+  }
+  set_errno(EMFILE);
+  return -1;
+}
+
+/**
+ * Close an epoll instance, deregistering its sockets. Called from lwip_close.
+ */
+static int
+lwip_epoll_close(int epfd)
+{
+  struct lwip_epoll *ep;
+  int i;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  ep = get_epoll(epfd);
+  if (ep == NULL) {
+    return -1;
+  }
+  SYS_ARCH_PROTECT(lev);
+  if (ep->waiting > 0) {
+    SYS_ARCH_UNPROTECT(lev);
+    set_errno(EBUSY);
+    return -1;
+  }
+  for (i = 0; i < NUM_SOCKETS; i++) {
+    if (sockets[i].ep_set == epfd - NUM_SOCKETS + 1) {
+      sockets[i].ep_set = 0;
+      sockets[i].ep_ready = 0;
+    }
+  }
+  ep->used = 0;
+  SYS_ARCH_UNPROTECT(lev);
+  sys_sem_free(&ep->sem);
+  set_errno(0);
+  return 0;
+}
+
+/**
+ * Register, change or deregister the interest of an epoll instance in a
+ * socket. A socket can only be registered with one epoll instance.
+ *
+ * @param epfd the epoll descriptor
+ * @param op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @param s the socket
+ * @param event the events to wait for (EPOLLIN, EPOLLOUT; EPOLLERR is always
+ *        reported) and the data to return with them (unused for EPOLL_CTL_DEL)
+ * @return 0 on success, -1 on error
+ */
+int
+lwip_epoll_ctl(int epfd, int op, int s, struct epoll_event *event)
+{
+  struct lwip_epoll *ep;
+  struct lwip_sock *sock;
+  u8_t set;
+  int err = 0;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_ctl(%d, %d, %d)\n", epfd, op, s));
+  ep = get_epoll(epfd);
+  if (ep == NULL) {
+    return -1;
+  }
+  sock = get_socket(s);
+  if (sock == NULL) {
+    return -1;
+  }
+  if ((op != EPOLL_CTL_DEL) && (event == NULL)) {
+    set_errno(EINVAL);
+    return -1;
+  }
+  set = (u8_t)(epfd - NUM_SOCKETS + 1);
+
+  SYS_ARCH_PROTECT(lev);
+  switch (op) {
+  case EPOLL_CTL_ADD:
+    if (sock->ep_set != 0) {
+      err = (sock->ep_set == set) ? EEXIST : EBUSY;
+      break;
+    }
+    sock->ep_set = set;
+    sock->ep_ready = 0;
+    /* fall through */
+  case EPOLL_CTL_MOD:
+    if (sock->ep_set != set) {
+      err = ENOENT;
+      break;
+    }
+    sock->ep_events = event->events;
+    sock->ep_data = event->data;
+    lwip_epoll_update(s, sock);
+    break;
+  case EPOLL_CTL_DEL:
+    if (sock->ep_set != set) {
+      err = ENOENT;
+      break;
+    }
+    if (sock->ep_ready) {
+      lwip_epoll_unready(ep, s);
+    }
+    sock->ep_set = 0;
+    break;
+  default:
+    err = EINVAL;
+    break;
+  }
+  SYS_ARCH_UNPROTECT(lev);
+
+  set_errno(err);
+  return (err == 0) ? 0 : -1;
+}
+
+/**
+ * Wait for events on the sockets registered with an epoll instance. Only
+ * the sockets on its ready list are looked at. Sockets stay ready as long as
+ * their state does (level-triggered); they are returned round-robin if more
+ * are ready than fit into 'events'.
+ *
+ * @param epfd the epoll descriptor
+ * @param events where to store the ready events
+ * @param maxevents the size of 'events'
+ * @param timeout in milliseconds, -1 to wait forever, 0 not to wait at all
+ * @return the number of events stored, 0 on timeout, -1 on error
+ */
+int
+lwip_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+  struct lwip_epoll *ep;
+  struct lwip_sock *sock;
+  int i, s, n;
+  u32_t ready, waited;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  ep = get_epoll(epfd);
+  if (ep == NULL) {
+    return -1;
+  }
+  if ((events == NULL) || (maxevents <= 0)) {
+    set_errno(EINVAL);
+    return -1;
+  }
+
+  SYS_ARCH_PROTECT(lev);
+  for (;;) {
+    n = 0;
+    for (i = ep->ready_count; (i > 0) && (n < maxevents); i--) {
+      s = ep->ready_head;
+      sock = &sockets[s];
+      lwip_epoll_unready(ep, s);
+      ready = lwip_sock_events(sock) & (sock->ep_events | EPOLLERR);
+      if (ready != 0) {
+        /* still ready: queue it at the tail again */
+        lwip_epoll_ready(ep, s);
+        events[n].events = ready;
+        events[n].data = sock->ep_data;
+        n++;
+      }
+    }
+    if ((n > 0) || (timeout == 0)) {
+      break;
+    }
+    ep->waiting++;
+    SYS_ARCH_UNPROTECT(lev);
+    /* 0 means wait forever for sys_arch_sem_wait */
+    waited = sys_arch_sem_wait(&ep->sem, (timeout < 0) ? 0 : (u32_t)timeout);
+    SYS_ARCH_PROTECT(lev);
+    ep->waiting--;
+    ep->sem_signalled = 0;
+    if (waited == SYS_ARCH_TIMEOUT) {
+      /* have a last look */
+      timeout = 0;
+    } else if (timeout > 0) {
+      timeout = (waited < (u32_t)timeout) ? (int)(timeout - waited) : 0;
+    }
+  }
+  SYS_ARCH_UNPROTECT(lev);
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_epoll_wait(%d): %d ready\n", epfd, n));
+  set_errno(0);
+  return n;
+}
+#endif /* LWIP_SOCKET_EPOLL */
+
 /**
  * Callback registered in the netconn layer for each socket-netconn.
  * Processes recvevent (data available) and wakes up tasks waiting for select.
@@ -1292,6 +1814,9 @@ event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len)
       LWIP_ASSERT("unknown event", 0);
       break;
   }
+#if LWIP_SOCKET_EPOLL
+  lwip_epoll_update(s, sock);
+#endif /* LWIP_SOCKET_EPOLL */
 
   if (sock->select_waiting == 0) {
     /* noone is waiting for this socket, no need to check select_cb_list */
@@ -1326,6 +1851,11 @@ again:
           do_signal = 1;
         }
       }
+#if LWIP_SOCKET_POLL
+      if (!do_signal && (scb->poll_fds != NULL)) {
+        do_signal = lwip_poll_should_wake(scb, s, sock);
+      }
+#endif /* LWIP_SOCKET_POLL */
       if (do_signal) {
         scb->sem_signalled = 1;
         /* Don't call SYS_ARCH_UNPROTECT() before signaling the semaphore, as this might
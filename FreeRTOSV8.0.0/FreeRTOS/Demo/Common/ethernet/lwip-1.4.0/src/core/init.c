@@ -99,9 +99,24 @@
 #if (LWIP_TCP && (MEMP_NUM_TCP_PCB<=0))
   #error "If you want to use TCP, you have to define MEMP_NUM_TCP_PCB>=1 in your lwipopts.h"
 #endif
-#if (LWIP_TCP && (TCP_WND > 0xffff))
+#if (LWIP_TCP && !LWIP_WND_SCALE && (TCP_WND > 0xffff))
   #error "If you want to use TCP, TCP_WND must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
 #endif
+#if (LWIP_TCP && !LWIP_WND_SCALE && (TCP_SND_BUF > 0xffff))
+  #error "If you want to use TCP, TCP_SND_BUF must fit in an u16_t, so, you have to reduce it in your lwipopts.h or set LWIP_WND_SCALE"
+#endif
+#if (LWIP_TCP && LWIP_WND_SCALE && ((TCP_RCV_SCALE > 14) || (TCP_WND > (0xffffUL << TCP_RCV_SCALE))))
+  #error "If you want to use LWIP_WND_SCALE, TCP_RCV_SCALE must be 14 or less and TCP_WND must fit in (0xffff << TCP_RCV_SCALE)"
+#endif
+#if (LWIP_TCP && LWIP_WND_SCALE && (TCP_WND > (2 * TCP_SND_BUF)))
+  #warning "TCP_SND_BUF is less than half of TCP_WND, so a sender using these options cannot fill the window they offer, raise TCP_SND_BUF in your lwipopts.h"
+#endif
+#if (LWIP_TCP && (TCP_SNDLOWAT >= 0xffff))
+  #error "TCP_SNDLOWAT must be less than 0xffff (the most tcp_sndbuf() reports), or sockets never become writable again, reduce it in your lwipopts.h"
+#endif
+#if (LWIP_TCP && LWIP_TCP_SACK && !TCP_QUEUE_OOSEQ)
+  #error "LWIP_TCP_SACK needs TCP_QUEUE_OOSEQ, the SACK blocks are built from the out-of-sequence queue"
+#endif
 #if (LWIP_TCP && (TCP_SND_QUEUELEN > 0xffff))
   #error "If you want to use TCP, TCP_SND_QUEUELEN must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
 #endif
@@ -114,6 +129,18 @@
 #if (LWIP_TCP && TCP_LISTEN_BACKLOG && (TCP_DEFAULT_LISTEN_BACKLOG < 0) || (TCP_DEFAULT_LISTEN_BACKLOG > 0xff))
   #error "If you want to use TCP backlog, TCP_DEFAULT_LISTEN_BACKLOG must fit into an u8_t"
 #endif
+#if (LWIP_TCP && TCP_PCB_HASH && (((TCP_PCB_HASH_SIZE & (TCP_PCB_HASH_SIZE - 1)) != 0) || ((TCP_LISTEN_HASH_SIZE & (TCP_LISTEN_HASH_SIZE - 1)) != 0)))
+  #error "If you want to use TCP_PCB_HASH, TCP_PCB_HASH_SIZE and TCP_LISTEN_HASH_SIZE must be powers of two"
+#endif
+#if (LWIP_UDP && UDP_PCB_HASH && ((UDP_PCB_HASH_SIZE & (UDP_PCB_HASH_SIZE - 1)) != 0))
+  #error "If you want to use UDP_PCB_HASH, UDP_PCB_HASH_SIZE must be a power of two"
+#endif
+#if (LWIP_ARP && ARP_TABLE_HASH && ((ARP_TABLE_HASH_SIZE & (ARP_TABLE_HASH_SIZE - 1)) != 0))
+  #error "If you want to use ARP_TABLE_HASH, ARP_TABLE_HASH_SIZE must be a power of two"
+#endif
+#if (SYS_TIMEOUT_WHEEL && ((SYS_TIMEOUT_WHEEL_SIZE & (SYS_TIMEOUT_WHEEL_SIZE - 1)) != 0))
+  #error "If you want to use SYS_TIMEOUT_WHEEL, SYS_TIMEOUT_WHEEL_SIZE must be a power of two"
+#endif
 #if (LWIP_IGMP && (MEMP_NUM_IGMP_GROUP<=1))
   #error "If you want to use IGMP, you have to define MEMP_NUM_IGMP_GROUP>1 in your lwipopts.h"
 #endif
@@ -129,6 +156,9 @@
 #if (!LWIP_NETCONN && LWIP_SOCKET)
   #error "If you want to use Socket API, you have to define LWIP_NETCONN=1 in your lwipopts.h"
 #endif
+#if (LWIP_SOCKET && LWIP_SOCKET_EPOLL && ((LWIP_SOCKET_EPOLL_NUM < 1) || (LWIP_SOCKET_EPOLL_NUM > 254)))
+  #error "If you want to use LWIP_SOCKET_EPOLL, LWIP_SOCKET_EPOLL_NUM must be between 1 and 254"
+#endif
 #if (((!LWIP_DHCP) || (!LWIP_AUTOIP)) && LWIP_DHCP_AUTOIP_COOP)
   #error "If you want to use DHCP/AUTOIP cooperation mode, you have to define LWIP_DHCP=1 and LWIP_AUTOIP=1 in your lwipopts.h"
 #endif
@@ -184,6 +214,12 @@
 #if LWIP_TCP && LWIP_NETIF_TX_SINGLE_PBUF && !TCP_OVERSIZE
   #error "LWIP_NETIF_TX_SINGLE_PBUF needs TCP_OVERSIZE enabled to create single-pbuf TCP packets"
 #endif
+#if LWIP_TCP && LWIP_TCP_ZEROCOPY && LWIP_NETIF_TX_SINGLE_PBUF
+  #error "LWIP_TCP_ZEROCOPY sends pbuf chains, it cannot be used with LWIP_NETIF_TX_SINGLE_PBUF"
+#endif
+#if LWIP_NETIF_RXRING && !LWIP_SUPPORT_CUSTOM_PBUF
+  #error "LWIP_NETIF_RXRING needs LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
 #if IP_FRAG && IP_FRAG_USES_STATIC_BUF && LWIP_NETIF_TX_SINGLE_PBUF
   #error "LWIP_NETIF_TX_SINGLE_PBUF does not work with IP_FRAG_USES_STATIC_BUF==1 as that creates pbuf queues"
 #endif
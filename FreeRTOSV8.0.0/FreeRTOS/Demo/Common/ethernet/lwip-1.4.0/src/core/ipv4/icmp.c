@@ -148,7 +148,7 @@ icmp_input(struct pbuf *p, struct netif *inp)
        */
       struct pbuf *r;
       /* switch p->payload to ip header */
-      if (pbuf_header(p, hlen)) {
+      if (pbuf_header_force(p, hlen)) {
         LWIP_ASSERT("icmp_input: moving p->payload to ip header failed\n", 0);
         goto memerr;
       }
@@ -210,7 +210,7 @@ icmp_input(struct pbuf *p, struct netif *inp)
     /* increase number of echo replies attempted to send */
     snmp_inc_icmpoutechoreps();
 
-    if(pbuf_header(p, hlen)) {
+    if(pbuf_header_force(p, hlen)) {
       LWIP_ASSERT("Can't move over header in packet", 0);
     } else {
       err_t ret;
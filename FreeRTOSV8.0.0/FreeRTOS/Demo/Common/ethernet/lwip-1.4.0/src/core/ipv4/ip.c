@@ -152,6 +152,10 @@ ip_route(ip_addr_t *dest)
  * packet, decrements the TTL value of the packet, adjusts the
  * checksum and outputs the packet on the appropriate interface.
  *
+ * If the link layer header cannot be added in front of the packet (e.g.
+ * because it is a PBUF_REF pbuf referring to a receive ring buffer), a
+ * PBUF_RAM copy of the packet is forwarded instead.
+ *
  * @param p the packet to forward (p->payload points to IP header)
  * @param iphdr the IP header of the input packet
  * @param inp the netif on which this packet was received
@@ -160,6 +164,7 @@ static void
 ip_forward(struct pbuf *p, struct ip_hdr *iphdr, struct netif *inp)
 {
   struct netif *netif;
+  struct pbuf *q;
 
   PERF_START;
 
@@ -215,9 +220,31 @@ ip_forward(struct pbuf *p, struct ip_hdr *iphdr, struct netif *inp)
   IP_STATS_INC(ip.xmit);
   snmp_inc_ipforwdatagrams();
 
+  /* make sure the link layer header fits in front of the packet */
+  if (pbuf_header(p, PBUF_LINK_HLEN) == 0) {
+    pbuf_header(p, -PBUF_LINK_HLEN);
+    q = p;
+  } else {
+    q = pbuf_alloc(PBUF_LINK, p->tot_len, PBUF_RAM);
+    if (q == NULL) {
+      LWIP_DEBUGF(IP_DEBUG, ("ip_forward: could not allocate a copy of the packet\n"));
+      IP_STATS_INC(ip.memerr);
+      IP_STATS_INC(ip.drop);
+      snmp_inc_ipoutdiscards();
+      return;
+    }
+    if (pbuf_copy(q, p) != ERR_OK) {
+      pbuf_free(q);
+      return;
+    }
+  }
+
   PERF_STOP("ip_forward");
   /* transmit pbuf on chosen interface */
-  netif->output(netif, p, &current_iphdr_dest);
+  netif->output(netif, q, &current_iphdr_dest);
+  if (q != p) {
+    pbuf_free(q);
+  }
   return;
 return_noroute:
   snmp_inc_ipoutnoroutes();
@@ -785,7 +812,7 @@ ip_output(struct pbuf *p, ip_addr_t *src, ip_addr_t *dest,
  */
 err_t
 ip_output_hinted(struct pbuf *p, ip_addr_t *src, ip_addr_t *dest,
-          u8_t ttl, u8_t tos, u8_t proto, u8_t *addr_hint)
+          u8_t ttl, u8_t tos, u8_t proto, netif_addr_idx_t *addr_hint)
 {
   struct netif *netif;
   err_t err;
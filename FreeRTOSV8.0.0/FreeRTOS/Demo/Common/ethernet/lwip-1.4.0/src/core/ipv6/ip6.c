@@ -330,7 +330,7 @@ ip_output(struct pbuf *p, struct ip_addr *src, struct ip_addr *dest,
 #if LWIP_NETIF_HWADDRHINT
 err_t
 ip_output_hinted(struct pbuf *p, struct ip_addr *src, struct ip_addr *dest,
-          u8_t ttl, u8_t tos, u8_t proto, u8_t *addr_hint)
+          u8_t ttl, u8_t tos, u8_t proto, netif_addr_idx_t *addr_hint)
 {
   struct netif *netif;
   err_t err;
@@ -58,11 +58,45 @@
 #include "lwip/dns.h"
 
 
+/** Wrap-around safe 'time a is before time b' */
+#define TIMEO_BEFORE(a, b) ((s32_t)((a) - (b)) < 0)
+
+#if SYS_TIMEOUT_WHEEL
+/** The timing wheel: a list of timeouts per slot, in the order they were set */
+static struct sys_timeo *timeo_wheel[SYS_TIMEOUT_WHEEL_SIZE];
+/** The pending timeouts indexed by handler and argument, for sys_untimeout() */
+static struct sys_timeo *timeo_hash[SYS_TIMEOUT_WHEEL_SIZE];
+/** All timeouts due before this time have been called */
+static u32_t timeo_wheel_time;
+/** The number of pending timeouts */
+static u16_t timeo_count;
+/** The time the earliest pending timeout is due, if timeo_next_valid */
+static u32_t timeo_next;
+static u8_t timeo_next_valid;
+/** While a handler runs, the time it was due: timeouts it sets count from
+    there, so that periodic timers do not drift */
+static u32_t timeo_handler_time;
+static u8_t timeo_in_handler;
+#else /* SYS_TIMEOUT_WHEEL */
 /** The one and only timeout list */
 static struct sys_timeo *next_timeout;
 #if NO_SYS
 static u32_t timeouts_last_time;
 #endif /* NO_SYS */
+#endif /* SYS_TIMEOUT_WHEEL */
+
+#if !NO_SYS && LWIP_TCPIP_CORE_LOCKING
+/** With core locking, other threads set timeouts (holding the core lock)
+    while tcpip_thread waits in sys_timeouts_mbox_fetch(): the mbox it waits
+    on, or NULL while it is not waiting */
+static sys_mbox_t *timeo_wait_mbox;
+/** When the current wait started and when it ends (unless forever) */
+static u32_t timeo_wait_start;
+static u32_t timeo_wait_end;
+static u8_t timeo_wait_forever;
+/** A wake-up (NULL message) has been posted to timeo_wait_mbox */
+static u8_t timeo_wake_posted;
+#endif /* !NO_SYS && LWIP_TCPIP_CORE_LOCKING */
 
 #if LWIP_TCP
 /** global variable that shows if the tcp timer is currently scheduled or not */
@@ -220,6 +254,9 @@ dns_timer(void *arg)
 /** Initialize this module */
 void sys_timeouts_init(void)
 {
+#if SYS_TIMEOUT_WHEEL
+  timeo_wheel_time = sys_now();
+#endif /* SYS_TIMEOUT_WHEEL */
 #if IP_REASSEMBLY
   sys_timeout(IP_TMR_INTERVAL, ip_reass_timer, NULL);
 #endif /* IP_REASSEMBLY */
@@ -240,12 +277,221 @@ void sys_timeouts_init(void)
   sys_timeout(DNS_TMR_INTERVAL, dns_timer, NULL);
 #endif /* LWIP_DNS */
 
-#if NO_SYS
+#if NO_SYS && !SYS_TIMEOUT_WHEEL
   /* Initialise timestamp for sys_check_timeouts */
   timeouts_last_time = sys_now();
 #endif
 }
 
+#if SYS_TIMEOUT_WHEEL
+/** Bucket of a handler and argument in timeo_hash */
+static u16_t
+sys_timeo_hash_index(sys_timeout_handler handler, void *arg)
+{
+  mem_ptr_t x = (mem_ptr_t)handler ^ (mem_ptr_t)arg;
+
+  return (u16_t)((x ^ (x >> 5) ^ (x >> 11)) & (SYS_TIMEOUT_WHEEL_SIZE - 1));
+}
+
+/** Append a timeout to the wheel slot of its due time */
+static void
+sys_timeo_wheel_add(struct sys_timeo *timeout)
+{
+  struct sys_timeo **slot = &timeo_wheel[timeout->time & (SYS_TIMEOUT_WHEEL_SIZE - 1)];
+
+  timeout->next = NULL;
+  if (*slot == NULL) {
+    timeout->prev = timeout;
+    *slot = timeout;
+  } else {
+    timeout->prev = (*slot)->prev;
+    (*slot)->prev->next = timeout;
+    (*slot)->prev = timeout;
+  }
+}
+
+/** Take a timeout out of its wheel slot */
+static void
+sys_timeo_wheel_remove(struct sys_timeo *timeout)
+{
+  struct sys_timeo **slot = &timeo_wheel[timeout->time & (SYS_TIMEOUT_WHEEL_SIZE - 1)];
+
+  if (*slot == timeout) {
+    *slot = timeout->next;
+    if (timeout->next != NULL) {
+      timeout->next->prev = timeout->prev;
+    }
+  } else {
+    timeout->prev->next = timeout->next;
+    if (timeout->next != NULL) {
+      timeout->next->prev = timeout->prev;
+    } else {
+      (*slot)->prev = timeout->prev;
+    }
+  }
+}
+
+/** Remove a pending timeout from the wheel and the index */
+static void
+sys_timeo_remove(struct sys_timeo *timeout)
+{
+  struct sys_timeo **t = &timeo_hash[sys_timeo_hash_index(timeout->h, timeout->arg)];
+
+  while (*t != timeout) {
+    LWIP_ASSERT("timeout not in its index bucket", *t != NULL);
+    t = &(*t)->hash_next;
+  }
+  *t = timeout->hash_next;
+  sys_timeo_wheel_remove(timeout);
+  timeo_count--;
+  if (timeo_next_valid && (timeout->time == timeo_next)) {
+    timeo_next_valid = 0;
+  }
+}
+
+/**
+ * Find the time the earliest pending timeout is due, walking the wheel from
+ * timeo_wheel_time if that is not known. At least one timeout must be pending.
+ */
+static u32_t
+sys_timeo_next(void)
+{
+  struct sys_timeo *t;
+  u32_t time, earliest = 0;
+  u16_t n;
+  u8_t found = 0;
+
+  if (timeo_next_valid) {
+    return timeo_next;
+  }
+  for (n = 0, time = timeo_wheel_time; n < SYS_TIMEOUT_WHEEL_SIZE; n++, time++) {
+    for (t = timeo_wheel[time & (SYS_TIMEOUT_WHEEL_SIZE - 1)]; t != NULL; t = t->next) {
+      if (t->time == time) {
+        /* due in this revolution, nothing can be earlier */
+        earliest = time;
+        found = 1;
+        n = SYS_TIMEOUT_WHEEL_SIZE;
+        break;
+      }
+      if (!found || TIMEO_BEFORE(t->time, earliest)) {
+        earliest = t->time;
+        found = 1;
+      }
+    }
+  }
+  LWIP_ASSERT("sys_timeo_next: no pending timeouts", found);
+  timeo_next = earliest;
+  timeo_next_valid = 1;
+  return earliest;
+}
+
+/**
+ * Call the handlers of all timeouts due at or before 'now', earliest first
+ * and in the order they were set for the same time.
+ */
+static void
+sys_timeo_call_due(u32_t now)
+{
+  struct sys_timeo *t;
+  u32_t due;
+  sys_timeout_handler handler;
+  void *arg;
+
+  while (timeo_count > 0) {
+    due = sys_timeo_next();
+    if (TIMEO_BEFORE(now, due)) {
+      break;
+    }
+    for (t = timeo_wheel[due & (SYS_TIMEOUT_WHEEL_SIZE - 1)]; t->time != due; t = t->next) {
+      LWIP_ASSERT("due timeout not in its slot", t->next != NULL);
+    }
+    timeo_wheel_time = due;
+    sys_timeo_remove(t);
+    handler = t->h;
+    arg = t->arg;
+#if LWIP_DEBUG_TIMERNAMES
+    if (handler != NULL) {
+      LWIP_DEBUGF(TIMERS_DEBUG, ("stw calling h=%s arg=%p\n",
+        t->handler_name, arg));
+    }
+#endif /* LWIP_DEBUG_TIMERNAMES */
+    memp_free(MEMP_SYS_TIMEOUT, t);
+    if (handler != NULL) {
+      timeo_handler_time = due;
+      timeo_in_handler = 1;
+      handler(arg);
+      timeo_in_handler = 0;
+    }
+  }
+  /* everything due before now has been called */
+  if (TIMEO_BEFORE(timeo_wheel_time, now)) {
+    timeo_wheel_time = now;
+  }
+}
+#endif /* SYS_TIMEOUT_WHEEL */
+
+#if !NO_SYS && LWIP_TCPIP_CORE_LOCKING
+#if !SYS_TIMEOUT_WHEEL
+/**
+ * Take the time tcpip_thread has waited so far off the head of the (relative)
+ * timeout list, so that a timeout set by another thread counts from now.
+ */
+static void
+sys_timeo_age(void)
+{
+  u32_t now = sys_now();
+  u32_t diff = now - timeo_wait_start;
+
+  timeo_wait_start = now;
+  if (next_timeout != NULL) {
+    next_timeout->time = (next_timeout->time > diff) ? (next_timeout->time - diff) : 0;
+  }
+}
+#endif /* !SYS_TIMEOUT_WHEEL */
+
+/**
+ * Wake up tcpip_thread if another thread has set a timeout due at 'due' while
+ * tcpip_thread waits for a message until later than that.
+ */
+static void
+sys_timeo_wake(u32_t due)
+{
+  if ((timeo_wait_mbox != NULL) && !timeo_wake_posted &&
+      (timeo_wait_forever || TIMEO_BEFORE(due, timeo_wait_end))) {
+    /* if the mbox is full, tcpip_thread is woken up anyway */
+    sys_mbox_trypost(timeo_wait_mbox, NULL);
+    timeo_wake_posted = 1;
+  }
+}
+
+/**
+ * Wait for a message with the core unlocked: other threads may set and
+ * remove timeouts meanwhile, sys_timeo_wake() posts a NULL message if
+ * tcpip_thread has to recompute its wait.
+ */
+static u32_t
+sys_timeo_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
+{
+  u32_t time_needed;
+
+  timeo_wait_mbox = mbox;
+  timeo_wait_start = sys_now();
+  timeo_wait_end = timeo_wait_start + timeout;
+  timeo_wait_forever = (timeout == 0);
+  UNLOCK_TCPIP_CORE();
+  time_needed = sys_arch_mbox_fetch(mbox, msg, timeout);
+  LOCK_TCPIP_CORE();
+  timeo_wait_mbox = NULL;
+  timeo_wake_posted = 0;
+#if !SYS_TIMEOUT_WHEEL
+  sys_timeo_age();
+#endif /* !SYS_TIMEOUT_WHEEL */
+  return time_needed;
+}
+#else /* !NO_SYS && LWIP_TCPIP_CORE_LOCKING */
+#define sys_timeo_mbox_fetch(mbox, msg, timeout) sys_arch_mbox_fetch(mbox, msg, timeout)
+#endif /* !NO_SYS && LWIP_TCPIP_CORE_LOCKING */
+
 /**
  * Create a one-shot timer (aka timeout). Timeouts are processed in the
  * following cases:
@@ -264,7 +510,10 @@ void
 sys_timeout(u32_t msecs, sys_timeout_handler handler, void *arg)
 #endif /* LWIP_DEBUG_TIMERNAMES */
 {
-  struct sys_timeo *timeout, *t;
+  struct sys_timeo *timeout;
+#if !SYS_TIMEOUT_WHEEL
+  struct sys_timeo *t;
+#endif /* !SYS_TIMEOUT_WHEEL */
 
   timeout = (struct sys_timeo *)memp_malloc(MEMP_SYS_TIMEOUT);
   if (timeout == NULL) {
@@ -281,6 +530,36 @@ sys_timeout(u32_t msecs, sys_timeout_handler handler, void *arg)
     (void *)timeout, msecs, handler_name, (void *)arg));
 #endif /* LWIP_DEBUG_TIMERNAMES */
 
+#if SYS_TIMEOUT_WHEEL
+  {
+    u16_t index = sys_timeo_hash_index(handler, arg);
+
+    timeout->time += timeo_in_handler ? timeo_handler_time : sys_now();
+    if (TIMEO_BEFORE(timeout->time, timeo_wheel_time)) {
+      /* cannot go before what has already been called */
+      timeout->time = timeo_wheel_time;
+    }
+#if !NO_SYS && LWIP_TCPIP_CORE_LOCKING
+    sys_timeo_wake(timeout->time);
+#endif /* !NO_SYS && LWIP_TCPIP_CORE_LOCKING */
+    sys_timeo_wheel_add(timeout);
+    timeout->hash_next = timeo_hash[index];
+    timeo_hash[index] = timeout;
+    if ((timeo_count == 0) ||
+        (timeo_next_valid && TIMEO_BEFORE(timeout->time, timeo_next))) {
+      timeo_next = timeout->time;
+      timeo_next_valid = 1;
+    }
+    timeo_count++;
+  }
+#else /* SYS_TIMEOUT_WHEEL */
+#if !NO_SYS && LWIP_TCPIP_CORE_LOCKING
+  if (timeo_wait_mbox != NULL) {
+    /* set by another thread while tcpip_thread waits */
+    sys_timeo_age();
+    sys_timeo_wake(timeo_wait_start + msecs);
+  }
+#endif /* !NO_SYS && LWIP_TCPIP_CORE_LOCKING */
   if (next_timeout == NULL) {
     next_timeout = timeout;
     return;
@@ -303,6 +582,7 @@ sys_timeout(u32_t msecs, sys_timeout_handler handler, void *arg)
       }
     }
   }
+#endif /* SYS_TIMEOUT_WHEEL */
 }
 
 /**
@@ -318,6 +598,21 @@ sys_timeout(u32_t msecs, sys_timeout_handler handler, void *arg)
 void
 sys_untimeout(sys_timeout_handler handler, void *arg)
 {
+#if SYS_TIMEOUT_WHEEL
+  struct sys_timeo *t, *match = NULL;
+
+  /* the matching timeout due first, and of those the one set first */
+  for (t = timeo_hash[sys_timeo_hash_index(handler, arg)]; t != NULL; t = t->hash_next) {
+    if ((t->h == handler) && (t->arg == arg) &&
+        ((match == NULL) || !TIMEO_BEFORE(match->time, t->time))) {
+      match = t;
+    }
+  }
+  if (match != NULL) {
+    sys_timeo_remove(match);
+    memp_free(MEMP_SYS_TIMEOUT, match);
+  }
+#else /* SYS_TIMEOUT_WHEEL */
   struct sys_timeo *prev_t, *t;
 
   if (next_timeout == NULL) {
@@ -342,6 +637,7 @@ sys_untimeout(sys_timeout_handler handler, void *arg)
     }
   }
   return;
+#endif /* SYS_TIMEOUT_WHEEL */
 }
 
 #if NO_SYS
@@ -355,6 +651,9 @@ sys_untimeout(sys_timeout_handler handler, void *arg)
 void
 sys_check_timeouts(void)
 {
+#if SYS_TIMEOUT_WHEEL
+  sys_timeo_call_due(sys_now());
+#else /* SYS_TIMEOUT_WHEEL */
   struct sys_timeo *tmptimeout;
   u32_t diff;
   sys_timeout_handler handler;
@@ -370,7 +669,7 @@ sys_check_timeouts(void)
     {
       had_one = 0;
       tmptimeout = next_timeout;
-      if (tmptimeout->time <= diff) {
+      if (tmptimeout && (tmptimeout->time <= diff)) {
         /* timeout has expired */
         had_one = 1;
         timeouts_last_time = now;
@@ -392,6 +691,7 @@ sys_check_timeouts(void)
     /* repeat until all expired timers have been called */
     }while(had_one);
   }
+#endif /* SYS_TIMEOUT_WHEEL */
 }
 
 /** Set back the timestamp of the last call to sys_check_timeouts()
@@ -402,7 +702,42 @@ sys_check_timeouts(void)
 void
 sys_restart_timeouts(void)
 {
+#if SYS_TIMEOUT_WHEEL
+  struct sys_timeo *first = NULL, *last = NULL, *t;
+  u32_t now = sys_now();
+  u32_t shift = now - timeo_wheel_time;
+  u16_t i;
+
+  if (!TIMEO_BEFORE(timeo_wheel_time, now)) {
+    return;
+  }
+  /* take all timeouts off the wheel, keeping the order within a slot... */
+  for (i = 0; i < SYS_TIMEOUT_WHEEL_SIZE; i++) {
+    while ((t = timeo_wheel[i]) != NULL) {
+      sys_timeo_wheel_remove(t);
+      if (last == NULL) {
+        first = t;
+      } else {
+        last->next = t;
+      }
+      last = t;
+    }
+  }
+  if (last != NULL) {
+    last->next = NULL;
+  }
+  /* ...and put them back later by the time that has passed unchecked */
+  while (first != NULL) {
+    t = first;
+    first = t->next;
+    t->time += shift;
+    sys_timeo_wheel_add(t);
+  }
+  timeo_next += shift;
+  timeo_wheel_time = now;
+#else /* SYS_TIMEOUT_WHEEL */
   timeouts_last_time = sys_now();
+#endif /* SYS_TIMEOUT_WHEEL */
 }
 
 #else /* NO_SYS */
@@ -410,6 +745,8 @@ sys_restart_timeouts(void)
 /**
  * Wait (forever) for a message to arrive in an mbox.
  * While waiting, timeouts are processed.
+ * With LWIP_TCPIP_CORE_LOCKING, this must be called with the core locked:
+ * it is only released while actually waiting.
  *
  * @param mbox the mbox to fetch the message from
  * @param msg the place to store the message
@@ -417,6 +754,43 @@ sys_restart_timeouts(void)
 void
 sys_timeouts_mbox_fetch(sys_mbox_t *mbox, void **msg)
 {
+#if SYS_TIMEOUT_WHEEL
+  u32_t now, due;
+
+ again:
+  if (timeo_count == 0) {
+    sys_timeo_mbox_fetch(mbox, msg, 0);
+#if LWIP_TCPIP_CORE_LOCKING
+    if (*msg == NULL) {
+      /* woken up by sys_timeo_wake() */
+      goto again;
+    }
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+    return;
+  }
+  now = sys_now();
+  due = sys_timeo_next();
+  if (TIMEO_BEFORE(now, due)) {
+    if (sys_timeo_mbox_fetch(mbox, msg, due - now) != SYS_ARCH_TIMEOUT) {
+#if LWIP_TCPIP_CORE_LOCKING
+      if (*msg == NULL) {
+        /* woken up by sys_timeo_wake() */
+        goto again;
+      }
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+      /* a message was received before the timeout occured */
+      return;
+    }
+    /* trust the timeout, even if sys_now() has not got there yet */
+    now = sys_now();
+    if (TIMEO_BEFORE(now, due)) {
+      now = due;
+    }
+  }
+  sys_timeo_call_due(now);
+  LWIP_TCPIP_THREAD_ALIVE();
+  goto again;
+#else /* SYS_TIMEOUT_WHEEL */
   u32_t time_needed;
   struct sys_timeo *tmptimeout;
   sys_timeout_handler handler;
@@ -424,13 +798,21 @@ sys_timeouts_mbox_fetch(sys_mbox_t *mbox, void **msg)
 
  again:
   if (!next_timeout) {
-    time_needed = sys_arch_mbox_fetch(mbox, msg, 0);
+    time_needed = sys_timeo_mbox_fetch(mbox, msg, 0);
   } else {
     if (next_timeout->time > 0) {
-      time_needed = sys_arch_mbox_fetch(mbox, msg, next_timeout->time);
+      time_needed = sys_timeo_mbox_fetch(mbox, msg, next_timeout->time);
     } else {
       time_needed = SYS_ARCH_TIMEOUT;
     }
+#if LWIP_TCPIP_CORE_LOCKING
+    /* other threads may have changed the list while we were waiting, and
+       sys_timeo_mbox_fetch has already aged it: only call a due timeout */
+    if ((time_needed == SYS_ARCH_TIMEOUT) &&
+        ((next_timeout == NULL) || (next_timeout->time > 0))) {
+      goto again;
+    }
+#endif /* LWIP_TCPIP_CORE_LOCKING */
 
     if (time_needed == SYS_ARCH_TIMEOUT) {
       /* If time == SYS_ARCH_TIMEOUT, a timeout occured before a message
@@ -448,11 +830,7 @@ sys_timeouts_mbox_fetch(sys_mbox_t *mbox, void **msg)
 #endif /* LWIP_DEBUG_TIMERNAMES */
       memp_free(MEMP_SYS_TIMEOUT, tmptimeout);
       if (handler != NULL) {
-        /* For LWIP_TCPIP_CORE_LOCKING, lock the core before calling the
-           timeout handler function. */
-        LOCK_TCPIP_CORE();
         handler(arg);
-        UNLOCK_TCPIP_CORE();
       }
       LWIP_TCPIP_THREAD_ALIVE();
 
@@ -462,13 +840,22 @@ sys_timeouts_mbox_fetch(sys_mbox_t *mbox, void **msg)
       /* If time != SYS_ARCH_TIMEOUT, a message was received before the timeout
          occured. The time variable is set to the number of
          milliseconds we waited for the message. */
+#if !LWIP_TCPIP_CORE_LOCKING
       if (time_needed < next_timeout->time) {
         next_timeout->time -= time_needed;
       } else {
         next_timeout->time = 0;
       }
+#endif /* !LWIP_TCPIP_CORE_LOCKING */
     }
   }
+#if LWIP_TCPIP_CORE_LOCKING
+  if (*msg == NULL) {
+    /* woken up by sys_timeo_wake() */
+    goto again;
+  }
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+#endif /* SYS_TIMEOUT_WHEEL */
 }
 
 #endif /* NO_SYS */
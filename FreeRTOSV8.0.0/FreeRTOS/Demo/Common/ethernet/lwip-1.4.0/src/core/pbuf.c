@@ -369,7 +369,7 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
     return NULL;
   }
 
-  if (LWIP_MEM_ALIGN_SIZE(offset) + length < payload_mem_len) {
+  if (LWIP_MEM_ALIGN_SIZE(offset) + length > payload_mem_len) {
     LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_LEVEL_WARNING, ("pbuf_alloced_custom(length=%"U16_F") buffer too short\n", length));
     return NULL;
   }
@@ -479,13 +479,14 @@ pbuf_realloc(struct pbuf *p, u16_t new_len)
  * If hdr_size_inc is 0, this function does nothing and returns succesful.
  *
  * PBUF_ROM and PBUF_REF type buffers cannot have their sizes increased, so
- * the call will fail. A check is made that the increase in header size does
- * not move the payload pointer in front of the start of the buffer.
+ * the call will fail (unless force is set, see pbuf_header_force()). A check
+ * is made that the increase in header size does not move the payload pointer
+ * in front of the start of the buffer.
  * @return non-zero on failure, zero on success.
  *
  */
-u8_t
-pbuf_header(struct pbuf *p, s16_t header_size_increment)
+static u8_t
+pbuf_header_impl(struct pbuf *p, s16_t header_size_increment, u8_t force)
 {
   u16_t type;
   void *payload;
@@ -538,6 +539,9 @@ pbuf_header(struct pbuf *p, s16_t header_size_increment)
     if ((header_size_increment < 0) && (increment_magnitude <= p->len)) {
       /* increase payload pointer */
       p->payload = (u8_t *)p->payload - header_size_increment;
+    } else if ((header_size_increment > 0) && force) {
+      /* the caller knows the memory in front of payload belongs to p */
+      p->payload = (u8_t *)p->payload - header_size_increment;
     } else {
       /* cannot expand payload to front (yet!)
        * bail out unsuccesfully */
@@ -558,6 +562,28 @@ pbuf_header(struct pbuf *p, s16_t header_size_increment)
   return 0;
 }
 
+/**
+ * Adjusts the ->payload pointer so that space for a header
+ * (dis)appears in the pbuf payload, see pbuf_header_impl().
+ */
+u8_t
+pbuf_header(struct pbuf *p, s16_t header_size_increment)
+{
+  return pbuf_header_impl(p, header_size_increment, 0);
+}
+
+/**
+ * Same as pbuf_header() but also lets PBUF_REF and PBUF_ROM pbufs grow
+ * to the front. Only for restoring a header that was hidden with
+ * pbuf_header() before, e.g. on a received packet that refers to a
+ * driver's receive buffer (see netif/rxring.c).
+ */
+u8_t
+pbuf_header_force(struct pbuf *p, s16_t header_size_increment)
+{
+  return pbuf_header_impl(p, header_size_increment, 1);
+}
+
 /**
  * Dereference a pbuf chain or queue and deallocate any no-longer-used
  * pbufs at the head of this chain or queue.
@@ -807,6 +833,51 @@ pbuf_dechain(struct pbuf *p)
   return ((tail_gone > 0) ? NULL : q);
 }
 
+#if LWIP_TCP && TCP_QUEUE_OOSEQ && LWIP_WND_SCALE
+/**
+ * Splits a pbuf chain whose total length may have overflowed the u16_t
+ * tot_len field into a first part of at most 0xffff bytes and the rest.
+ *
+ * Used by TCP with window scaling, where the segments taken off the ooseq
+ * queue at once may add up to more than 64k.
+ *
+ * @param p pbuf chain to split, its tot_len fields are corrected
+ * @param rest receives the remainder of the chain, or NULL if it fit
+ */
+void
+pbuf_split_64k(struct pbuf *p, struct pbuf **rest)
+{
+  struct pbuf *q, *r;
+  u16_t tot_len_front;
+
+  *rest = NULL;
+  if ((p != NULL) && (p->next != NULL)) {
+    tot_len_front = p->len;
+    q = p;
+    r = p->next;
+    /* continue until the total length (summed up as u16_t) overflows */
+    while ((r != NULL) && ((u16_t)(tot_len_front + r->len) > tot_len_front)) {
+      tot_len_front += r->len;
+      q = r;
+      r = r->next;
+    }
+    /* q is the last pbuf of the first part */
+    q->next = NULL;
+    if (r != NULL) {
+      /* the tot_len fields of the first part were summed up modulo 2^16,
+         so subtracting the rest gives the right value again */
+      for (q = p; q != NULL; q = q->next) {
+        q->tot_len -= r->tot_len;
+        LWIP_ASSERT("tot_len/len mismatch in last pbuf",
+                    (q->next != NULL) || (q->tot_len == q->len));
+      }
+      /* the tot_len fields of the rest need no correction */
+      *rest = r;
+    }
+  }
+}
+#endif /* LWIP_TCP && TCP_QUEUE_OOSEQ && LWIP_WND_SCALE */
+
 /**
  *
  * Create PBUF_RAM copies of pbufs.
@@ -97,6 +97,14 @@ struct tcp_pcb ** const tcp_pcb_lists[] = {&tcp_listen_pcbs.pcbs, &tcp_bound_pcb
 /** Only used for temporary storage. */
 struct tcp_pcb *tcp_tmp_pcb;
 
+#if TCP_PCB_HASH
+/** Hash tables over tcp_active_pcbs and tcp_tw_pcbs, indexed by 4-tuple */
+static struct tcp_pcb *tcp_active_hash[TCP_PCB_HASH_SIZE];
+static struct tcp_pcb *tcp_tw_hash[TCP_PCB_HASH_SIZE];
+/** Hash table over tcp_listen_pcbs, indexed by local port */
+static struct tcp_pcb_listen *tcp_listen_hash[TCP_LISTEN_HASH_SIZE];
+#endif /* TCP_PCB_HASH */
+
 /** Timer counter to handle calling slow-timer from tcp_tmr() */ 
 static u8_t tcp_timer;
 static u16_t tcp_new_port(void);
@@ -140,7 +148,7 @@ tcp_close_shutdown(struct tcp_pcb *pcb, u8_t rst_on_unacked_data)
   err_t err;
 
   if (rst_on_unacked_data && (pcb->state != LISTEN)) {
-    if ((pcb->refused_data != NULL) || (pcb->rcv_wnd != TCP_WND)) {
+    if ((pcb->refused_data != NULL) || (pcb->rcv_wnd != TCP_WND_MAX(pcb))) {
       /* Not all data received by application, send RST to tell the remote
          side about this. */
       LWIP_ASSERT("pcb->flags & TF_RXCLOSED", pcb->flags & TF_RXCLOSED);
@@ -556,8 +564,8 @@ u32_t tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb)
     } else {
       /* keep the right edge of window constant */
       u32_t new_rcv_ann_wnd = pcb->rcv_ann_right_edge - pcb->rcv_nxt;
-      LWIP_ASSERT("new_rcv_ann_wnd <= 0xffff", new_rcv_ann_wnd <= 0xffff);
-      pcb->rcv_ann_wnd = (u16_t)new_rcv_ann_wnd;
+      LWIP_ASSERT("new_rcv_ann_wnd <= TCP_WND_MAX", new_rcv_ann_wnd <= TCP_WND_MAX(pcb));
+      pcb->rcv_ann_wnd = (tcpwnd_size_t)new_rcv_ann_wnd;
     }
     return 0;
   }
@@ -576,12 +584,14 @@ tcp_recved(struct tcp_pcb *pcb, u16_t len)
 {
   int wnd_inflation;
 
+#if !LWIP_WND_SCALE
   LWIP_ASSERT("tcp_recved: len would wrap rcv_wnd\n",
               len <= 0xffff - pcb->rcv_wnd );
+#endif /* !LWIP_WND_SCALE */
 
   pcb->rcv_wnd += len;
-  if (pcb->rcv_wnd > TCP_WND) {
-    pcb->rcv_wnd = TCP_WND;
+  if (pcb->rcv_wnd > TCP_WND_MAX(pcb)) {
+    pcb->rcv_wnd = TCP_WND_MAX(pcb);
   }
 
   wnd_inflation = tcp_update_rcv_ann_wnd(pcb);
@@ -595,8 +605,8 @@ tcp_recved(struct tcp_pcb *pcb, u16_t len)
     tcp_output(pcb);
   }
 
-  LWIP_DEBUGF(TCP_DEBUG, ("tcp_recved: recveived %"U16_F" bytes, wnd %"U16_F" (%"U16_F").\n",
-         len, pcb->rcv_wnd, TCP_WND - pcb->rcv_wnd));
+  LWIP_DEBUGF(TCP_DEBUG, ("tcp_recved: recveived %"U16_F" bytes, wnd %"TCPWNDSIZE_F" (%"TCPWNDSIZE_F").\n",
+         len, pcb->rcv_wnd, TCP_WND_MAX(pcb) - pcb->rcv_wnd));
 }
 
 /**
@@ -705,8 +715,10 @@ tcp_connect(struct tcp_pcb *pcb, ip_addr_t *ipaddr, u16_t port,
   pcb->snd_nxt = iss;
   pcb->lastack = iss - 1;
   pcb->snd_lbb = iss - 1;
-  pcb->rcv_wnd = TCP_WND;
-  pcb->rcv_ann_wnd = TCP_WND;
+  /* The window is only scaled once the SYN-ACK carries the peer's
+     window scale option */
+  pcb->rcv_wnd = TCPWND16(TCP_WND);
+  pcb->rcv_ann_wnd = TCPWND16(TCP_WND);
   pcb->rcv_ann_right_edge = pcb->rcv_nxt;
   pcb->snd_wnd = TCP_WND;
   /* As initial send MSS, we use TCP_MSS but limit it to 536.
@@ -750,7 +762,7 @@ void
 tcp_slowtmr(void)
 {
   struct tcp_pcb *pcb, *prev;
-  u16_t eff_wnd;
+  tcpwnd_size_t eff_wnd;
   u8_t pcb_remove;      /* flag if a PCB should be removed */
   u8_t pcb_reset;       /* flag if a RST should be sent when removing */
   err_t err;
@@ -820,8 +832,8 @@ tcp_slowtmr(void)
             pcb->ssthresh = (pcb->mss << 1);
           }
           pcb->cwnd = pcb->mss;
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_slowtmr: cwnd %"U16_F
-                                       " ssthresh %"U16_F"\n",
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_slowtmr: cwnd %"TCPWNDSIZE_F
+                                       " ssthresh %"TCPWNDSIZE_F"\n",
                                        pcb->cwnd, pcb->ssthresh));
  
           /* The following needs to be called AFTER cwnd is set to one
@@ -916,6 +928,7 @@ tcp_slowtmr(void)
         LWIP_ASSERT("tcp_slowtmr: first pcb == tcp_active_pcbs", tcp_active_pcbs == pcb);
         tcp_active_pcbs = pcb->next;
       }
+      TCP_HASH_RMV(&tcp_active_pcbs, pcb);
 
       TCP_EVENT_ERR(pcb->errf, pcb->callback_arg, ERR_ABRT);
       if (pcb_reset) {
@@ -973,6 +986,7 @@ tcp_slowtmr(void)
         LWIP_ASSERT("tcp_slowtmr: first pcb == tcp_tw_pcbs", tcp_tw_pcbs == pcb);
         tcp_tw_pcbs = pcb->next;
       }
+      TCP_HASH_RMV(&tcp_tw_pcbs, pcb);
       pcb2 = pcb;
       pcb = pcb->next;
       memp_free(MEMP_TCP_PCB, pcb2);
@@ -999,12 +1013,8 @@ tcp_fasttmr(void)
     /* If there is data which was previously "refused" by upper layer */
     if (pcb->refused_data != NULL) {
       /* Notify again application with data previously received. */
-      err_t err;
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_fasttmr: notify kept packet\n"));
-      TCP_EVENT_RECV(pcb, pcb->refused_data, ERR_OK, err);
-      if (err == ERR_OK) {
-        pcb->refused_data = NULL;
-      } else if (err == ERR_ABRT) {
+      if (tcp_process_refused_data(pcb) == ERR_ABRT) {
         /* if err == ERR_ABRT, 'pcb' is already deallocated */
         pcb = NULL;
       }
@@ -1022,6 +1032,50 @@ tcp_fasttmr(void)
   }
 }
 
+/**
+ * Passes data previously refused by the application (pcb->refused_data)
+ * to it again.
+ *
+ * @param pcb the tcp_pcb holding refused data
+ * @return ERR_OK if the data was taken, ERR_ABRT if the pcb was aborted
+ *         (and deallocated) by the recv callback, another err_t if the data
+ *         was refused again and is still on pcb->refused_data
+ */
+err_t
+tcp_process_refused_data(struct tcp_pcb *pcb)
+{
+  struct pbuf *refused_data = pcb->refused_data;
+  struct pbuf *rest;
+  err_t err;
+
+  while (refused_data != NULL) {
+    rest = NULL;
+#if TCP_QUEUE_OOSEQ && LWIP_WND_SCALE
+    /* With window scaling, refused_data may hold more than 64k (see
+       tcp_input): pass it on in parts a pbuf chain can describe. */
+    pbuf_split_64k(refused_data, &rest);
+#endif /* TCP_QUEUE_OOSEQ && LWIP_WND_SCALE */
+    pcb->refused_data = NULL;
+    TCP_EVENT_RECV(pcb, refused_data, ERR_OK, err);
+    if (err == ERR_ABRT) {
+      /* 'pcb' is already deallocated */
+      if (rest != NULL) {
+        pbuf_free(rest);
+      }
+      return ERR_ABRT;
+    }
+    if (err != ERR_OK) {
+      if (rest != NULL) {
+        pbuf_cat(refused_data, rest);
+      }
+      pcb->refused_data = refused_data;
+      return err;
+    }
+    refused_data = rest;
+  }
+  return ERR_OK;
+}
+
 /**
  * Deallocates a list of TCP segments (tcp_seg structures).
  *
@@ -1210,8 +1264,8 @@ tcp_alloc(u8_t prio)
     pcb->prio = prio;
     pcb->snd_buf = TCP_SND_BUF;
     pcb->snd_queuelen = 0;
-    pcb->rcv_wnd = TCP_WND;
-    pcb->rcv_ann_wnd = TCP_WND;
+    pcb->rcv_wnd = TCPWND16(TCP_WND);
+    pcb->rcv_ann_wnd = TCPWND16(TCP_WND);
     pcb->tos = 0;
     pcb->ttl = TCP_TTL;
     /* As initial send MSS, we use TCP_MSS but limit it to 536.
@@ -1455,6 +1509,158 @@ tcp_pcb_remove(struct tcp_pcb **pcblist, struct tcp_pcb *pcb)
   LWIP_ASSERT("tcp_pcb_remove: tcp_pcbs_sane()", tcp_pcbs_sane());
 }
 
+#if TCP_PCB_HASH
+/**
+ * Hash a connection 4-tuple to a bucket of tcp_active_hash/tcp_tw_hash.
+ * Both addresses and both ports are mixed in, so connections spread over
+ * the table whether they differ by peer address or only by peer port.
+ */
+static u32_t
+tcp_pcb_hash_index(ip_addr_t *remote_ip, u16_t remote_port,
+                   ip_addr_t *local_ip, u16_t local_port)
+{
+  u32_t h;
+
+  h = ip4_addr_get_u32(remote_ip) ^ ip4_addr_get_u32(local_ip) ^
+      (((u32_t)remote_port << 16) | local_port);
+  h ^= h >> 16;
+  h *= 0x7feb352dUL;
+  h ^= h >> 15;
+  return h & (TCP_PCB_HASH_SIZE - 1);
+}
+
+#define TCP_LISTEN_HASH_INDEX(port) ((port) & (TCP_LISTEN_HASH_SIZE - 1))
+
+/**
+ * Get the hash bucket a PCB belongs to when it is on the list pcbs.
+ *
+ * @return the bucket, or NULL if the PCBs on that list are not indexed
+ */
+static struct tcp_pcb **
+tcp_pcb_hash_bucket(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  u32_t index;
+
+  if (pcbs == &tcp_listen_pcbs.pcbs) {
+    return (struct tcp_pcb **)&tcp_listen_hash[TCP_LISTEN_HASH_INDEX(pcb->local_port)];
+  }
+  if ((pcbs == &tcp_active_pcbs) || (pcbs == &tcp_tw_pcbs)) {
+    index = tcp_pcb_hash_index(&pcb->remote_ip, pcb->remote_port,
+                               &pcb->local_ip, pcb->local_port);
+    return (pcbs == &tcp_active_pcbs) ? &tcp_active_hash[index] : &tcp_tw_hash[index];
+  }
+  return NULL;
+}
+
+/**
+ * Add a PCB that has just been put on the list pcbs to the matching hash
+ * table. Called by TCP_REG.
+ *
+ * The hash_next member is at the same place in struct tcp_pcb and
+ * struct tcp_pcb_listen, so listening PCBs are chained the same way.
+ */
+void
+tcp_pcb_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *npcb)
+{
+  struct tcp_pcb **bucket = tcp_pcb_hash_bucket(pcbs, npcb);
+
+  if (bucket != NULL) {
+    npcb->hash_next = *bucket;
+    *bucket = npcb;
+  }
+}
+
+/**
+ * Remove a PCB that has just been taken off the list pcbs from the matching
+ * hash table. Called by TCP_RMV, and by tcp_slowtmr() which unlinks expired
+ * PCBs itself.
+ */
+void
+tcp_pcb_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *npcb)
+{
+  struct tcp_pcb **bucket = tcp_pcb_hash_bucket(pcbs, npcb);
+
+  if (bucket != NULL) {
+    for (; *bucket != NULL; bucket = &(*bucket)->hash_next) {
+      if (*bucket == npcb) {
+        *bucket = npcb->hash_next;
+        break;
+      }
+    }
+    npcb->hash_next = NULL;
+  }
+}
+
+/**
+ * Find the active (pcbs == &tcp_active_pcbs) or TIME-WAIT
+ * (pcbs == &tcp_tw_pcbs) PCB of a connection.
+ *
+ * @return the PCB, or NULL if there is none
+ */
+struct tcp_pcb *
+tcp_pcb_hash_lookup(struct tcp_pcb **pcbs,
+                    ip_addr_t *remote_ip, u16_t remote_port,
+                    ip_addr_t *local_ip, u16_t local_port)
+{
+  struct tcp_pcb *pcb;
+  u32_t index = tcp_pcb_hash_index(remote_ip, remote_port, local_ip, local_port);
+
+  pcb = (pcbs == &tcp_active_pcbs) ? tcp_active_hash[index] : tcp_tw_hash[index];
+  for (; pcb != NULL; pcb = pcb->hash_next) {
+    if (pcb->remote_port == remote_port &&
+       pcb->local_port == local_port &&
+       ip_addr_cmp(&(pcb->remote_ip), remote_ip) &&
+       ip_addr_cmp(&(pcb->local_ip), local_ip)) {
+      break;
+    }
+  }
+  return pcb;
+}
+
+/**
+ * Find the LISTENing PCB for a connection request, with the same rules as
+ * the list walk in tcp_input(): with SO_REUSE a PCB bound to local_ip is
+ * preferred over one bound to IP_ADDR_ANY.
+ *
+ * @return the PCB, or NULL if there is none
+ */
+struct tcp_pcb_listen *
+tcp_listen_hash_lookup(ip_addr_t *local_ip, u16_t local_port)
+{
+  struct tcp_pcb_listen *lpcb;
+#if SO_REUSE
+  struct tcp_pcb_listen *lpcb_any = NULL;
+#endif /* SO_REUSE */
+
+  for (lpcb = tcp_listen_hash[TCP_LISTEN_HASH_INDEX(local_port)]; lpcb != NULL; lpcb = lpcb->hash_next) {
+    if (lpcb->local_port == local_port) {
+#if SO_REUSE
+      if (ip_addr_cmp(&(lpcb->local_ip), local_ip)) {
+        /* found an exact match */
+        break;
+      } else if(ip_addr_isany(&(lpcb->local_ip))) {
+        /* found an ANY-match */
+        lpcb_any = lpcb;
+      }
+#else /* SO_REUSE */
+      if (ip_addr_cmp(&(lpcb->local_ip), local_ip) ||
+          ip_addr_isany(&(lpcb->local_ip))) {
+        /* found a match */
+        break;
+      }
+#endif /* SO_REUSE */
+    }
+  }
+#if SO_REUSE
+  if (lpcb == NULL) {
+    /* only pass to ANY if no specific local IP has been found */
+    lpcb = lpcb_any;
+  }
+#endif /* SO_REUSE */
+  return lpcb;
+}
+#endif /* TCP_PCB_HASH */
+
 /**
  * Calculates a new initial sequence number for new connections.
  *
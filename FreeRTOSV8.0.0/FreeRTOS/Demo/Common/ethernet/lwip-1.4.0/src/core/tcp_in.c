@@ -69,12 +69,21 @@ static u16_t tcplen;
 static u8_t recv_flags;
 static struct pbuf *recv_data;
 
+#if LWIP_TCP_SACK
+/* SACK blocks of the incoming segment, set by tcp_parseopt() */
+static u8_t sack_count;
+static u32_t sack_left[4], sack_right[4];
+#endif /* LWIP_TCP_SACK */
+
 struct tcp_pcb *tcp_input_pcb;
 
 /* Forward declarations. */
 static err_t tcp_process(struct tcp_pcb *pcb);
 static void tcp_receive(struct tcp_pcb *pcb);
 static void tcp_parseopt(struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+static void tcp_sack_receive(struct tcp_pcb *pcb);
+#endif /* LWIP_TCP_SACK */
 
 static err_t tcp_listen_input(struct tcp_pcb_listen *pcb);
 static err_t tcp_timewait_input(struct tcp_pcb *pcb);
@@ -93,10 +102,10 @@ tcp_input(struct pbuf *p, struct netif *inp)
 {
   struct tcp_pcb *pcb, *prev;
   struct tcp_pcb_listen *lpcb;
-#if SO_REUSE
+#if SO_REUSE && !TCP_PCB_HASH
   struct tcp_pcb *lpcb_prev = NULL;
   struct tcp_pcb_listen *lpcb_any = NULL;
-#endif /* SO_REUSE */
+#endif /* SO_REUSE && !TCP_PCB_HASH */
   u8_t hdrlen;
   err_t err;
 
@@ -178,7 +187,10 @@ tcp_input(struct pbuf *p, struct netif *inp)
      for an active connection. */
   prev = NULL;
 
-  
+#if TCP_PCB_HASH
+  pcb = tcp_pcb_hash_lookup(&tcp_active_pcbs, &current_iphdr_src, tcphdr->src,
+                            &current_iphdr_dest, tcphdr->dest);
+#else /* TCP_PCB_HASH */
   for(pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
     LWIP_ASSERT("tcp_input: active pcb->state != CLOSED", pcb->state != CLOSED);
     LWIP_ASSERT("tcp_input: active pcb->state != TIME-WAIT", pcb->state != TIME_WAIT);
@@ -202,10 +214,22 @@ tcp_input(struct pbuf *p, struct netif *inp)
     }
     prev = pcb;
   }
+#endif /* TCP_PCB_HASH */
 
   if (pcb == NULL) {
     /* If it did not go to an active connection, we check the connections
        in the TIME-WAIT state. */
+#if TCP_PCB_HASH
+    pcb = tcp_pcb_hash_lookup(&tcp_tw_pcbs, &current_iphdr_src, tcphdr->src,
+                              &current_iphdr_dest, tcphdr->dest);
+    if (pcb != NULL) {
+      LWIP_ASSERT("tcp_input: TIME-WAIT pcb->state == TIME-WAIT", pcb->state == TIME_WAIT);
+      LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packed for TIME_WAITing connection.\n"));
+      tcp_timewait_input(pcb);
+      pbuf_free(p);
+      return;
+    }
+#else /* TCP_PCB_HASH */
     for(pcb = tcp_tw_pcbs; pcb != NULL; pcb = pcb->next) {
       LWIP_ASSERT("tcp_input: TIME-WAIT pcb->state == TIME-WAIT", pcb->state == TIME_WAIT);
       if (pcb->remote_port == tcphdr->src &&
@@ -221,10 +245,15 @@ tcp_input(struct pbuf *p, struct netif *inp)
         return;
       }
     }
+#endif /* TCP_PCB_HASH */
 
     /* Finally, if we still did not get a match, we check all PCBs that
        are LISTENing for incoming connections. */
     prev = NULL;
+#if TCP_PCB_HASH
+    /* No move-to-front here, the lookup does not depend on list order. */
+    lpcb = tcp_listen_hash_lookup(&current_iphdr_dest, tcphdr->dest);
+#else /* TCP_PCB_HASH */
     for(lpcb = tcp_listen_pcbs.listen_pcbs; lpcb != NULL; lpcb = lpcb->next) {
       if (lpcb->local_port == tcphdr->dest) {
 #if SO_REUSE
@@ -254,6 +283,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
       prev = lpcb_prev;
     }
 #endif /* SO_REUSE */
+#endif /* TCP_PCB_HASH */
     if (lpcb != NULL) {
       /* Move this PCB to the front of the list so that subsequent
          lookups will be faster (we exploit locality in TCP segment
@@ -301,10 +331,8 @@ tcp_input(struct pbuf *p, struct netif *inp)
     if (pcb->refused_data != NULL) {
       /* Notify again application with data previously received. */
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: notify kept packet\n"));
-      TCP_EVENT_RECV(pcb, pcb->refused_data, ERR_OK, err);
-      if (err == ERR_OK) {
-        pcb->refused_data = NULL;
-      } else if ((err == ERR_ABRT) || (tcplen > 0)) {
+      if ((tcp_process_refused_data(pcb) == ERR_ABRT) ||
+          ((pcb->refused_data != NULL) && (tcplen > 0))) {
         /* if err == ERR_ABRT, 'pcb' is already deallocated */
         /* Drop incoming packets because pcb is "full" (only if the incoming
            segment contains data). */
@@ -339,10 +367,24 @@ tcp_input(struct pbuf *p, struct netif *inp)
            called when new send buffer space is available, we call it
            now. */
         if (pcb->acked > 0) {
+#if LWIP_WND_SCALE
+          /* pcb->acked may not fit in the u16_t of the sent callback, in
+             which case the callback is called more than once. */
+          tcpwnd_size_t acked = pcb->acked;
+          while (acked > 0) {
+            u16_t acked16 = (u16_t)LWIP_MIN(acked, 0xffff);
+            acked -= acked16;
+            TCP_EVENT_SENT(pcb, acked16, err);
+            if (err == ERR_ABRT) {
+              goto aborted;
+            }
+          }
+#else /* LWIP_WND_SCALE */
           TCP_EVENT_SENT(pcb, pcb->acked, err);
           if (err == ERR_ABRT) {
             goto aborted;
           }
+#endif /* LWIP_WND_SCALE */
         }
 
         if (recv_data != NULL) {
@@ -354,20 +396,37 @@ tcp_input(struct pbuf *p, struct netif *inp)
             tcp_abort(pcb);
             goto aborted;
           }
-          if (flags & TCP_PSH) {
-            recv_data->flags |= PBUF_FLAG_PUSH;
-          }
+          while (recv_data != NULL) {
+            struct pbuf *rest = NULL;
+#if TCP_QUEUE_OOSEQ && LWIP_WND_SCALE
+            /* With window scaling, the segments taken off the ooseq queue
+               may add up to more than a pbuf chain can describe: pass them
+               on in parts of at most 64k. */
+            pbuf_split_64k(recv_data, &rest);
+#endif /* TCP_QUEUE_OOSEQ && LWIP_WND_SCALE */
+            if (flags & TCP_PSH) {
+              recv_data->flags |= PBUF_FLAG_PUSH;
+            }
 
-          /* Notify application that data has been received. */
-          TCP_EVENT_RECV(pcb, recv_data, ERR_OK, err);
-          if (err == ERR_ABRT) {
-            goto aborted;
-          }
+            /* Notify application that data has been received. */
+            TCP_EVENT_RECV(pcb, recv_data, ERR_OK, err);
+            if (err == ERR_ABRT) {
+              if (rest != NULL) {
+                pbuf_free(rest);
+              }
+              goto aborted;
+            }
 
-          /* If the upper layer can't receive this data, store it */
-          if (err != ERR_OK) {
-            pcb->refused_data = recv_data;
-            LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: keep incoming packet, because pcb is \"full\"\n"));
+            /* If the upper layer can't receive this data, store it */
+            if (err != ERR_OK) {
+              if (rest != NULL) {
+                pbuf_cat(recv_data, rest);
+              }
+              pcb->refused_data = recv_data;
+              LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: keep incoming packet, because pcb is \"full\"\n"));
+              break;
+            }
+            recv_data = rest;
           }
         }
 
@@ -376,7 +435,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
         if (recv_flags & TF_GOT_FIN) {
           /* correct rcv_wnd as the application won't call tcp_recved()
              for the FIN's seqno */
-          if (pcb->rcv_wnd != TCP_WND) {
+          if (pcb->rcv_wnd != TCP_WND_MAX(pcb)) {
             pcb->rcv_wnd++;
           }
           TCP_EVENT_CLOSED(pcb, err);
@@ -496,6 +555,12 @@ tcp_listen_input(struct tcp_pcb_listen *pcb)
 
     /* Parse any options in the SYN. */
     tcp_parseopt(npcb);
+#if LWIP_WND_SCALE
+    if (npcb->flags & TF_WND_SCALE) {
+      /* The unscaled window of the SYN is no useful ssthresh (RFC 5681) */
+      npcb->ssthresh = TCP_SND_BUF;
+    }
+#endif /* LWIP_WND_SCALE */
 #if TCP_CALCULATE_EFF_SEND_MSS
     npcb->mss = tcp_eff_send_mss(npcb->mss, &(npcb->remote_ip));
 #endif /* TCP_CALCULATE_EFF_SEND_MSS */
@@ -643,6 +708,13 @@ tcp_process(struct tcp_pcb *pcb)
       /* Set ssthresh again after changing pcb->mss (already set in tcp_connect
        * but for the default value of pcb->mss) */
       pcb->ssthresh = pcb->mss * 10;
+#if LWIP_WND_SCALE
+      if (pcb->flags & TF_WND_SCALE) {
+        /* A large window is only reached slowly in congestion avoidance:
+           start with ssthresh "arbitrarily high" (RFC 5681) instead. */
+        pcb->ssthresh = TCP_SND_BUF;
+      }
+#endif /* LWIP_WND_SCALE */
 
       pcb->cwnd = ((pcb->cwnd == 1) ? (pcb->mss * 2) : pcb->mss);
       LWIP_ASSERT("pcb->snd_queuelen > 0", (pcb->snd_queuelen > 0));
@@ -681,7 +753,7 @@ tcp_process(struct tcp_pcb *pcb)
     if (flags & TCP_ACK) {
       /* expected ACK number? */
       if (TCP_SEQ_BETWEEN(ackno, pcb->lastack+1, pcb->snd_nxt)) {
-        u16_t old_cwnd;
+        tcpwnd_size_t old_cwnd;
         pcb->state = ESTABLISHED;
         LWIP_DEBUGF(TCP_DEBUG, ("TCP connection established %"U16_F" -> %"U16_F".\n", inseg.tcphdr->src, inseg.tcphdr->dest));
 #if LWIP_CALLBACK_API
@@ -853,24 +925,30 @@ tcp_receive(struct tcp_pcb *pcb)
   u32_t right_wnd_edge;
   u16_t new_tot_len;
   int found_dupack = 0;
+  tcpwnd_size_t tcphdr_wnd;
+#if LWIP_TCP_SACK
+  u8_t partial_ack = 0;
+#endif /* LWIP_TCP_SACK */
 
   if (flags & TCP_ACK) {
     right_wnd_edge = pcb->snd_wnd + pcb->snd_wl2;
+    /* SYN segments don't get here, so the window is always scaled */
+    tcphdr_wnd = SND_WND_SCALE(pcb, tcphdr->wnd);
 
     /* Update window. */
     if (TCP_SEQ_LT(pcb->snd_wl1, seqno) ||
        (pcb->snd_wl1 == seqno && TCP_SEQ_LT(pcb->snd_wl2, ackno)) ||
-       (pcb->snd_wl2 == ackno && tcphdr->wnd > pcb->snd_wnd)) {
-      pcb->snd_wnd = tcphdr->wnd;
+       (pcb->snd_wl2 == ackno && tcphdr_wnd > pcb->snd_wnd)) {
+      pcb->snd_wnd = tcphdr_wnd;
       pcb->snd_wl1 = seqno;
       pcb->snd_wl2 = ackno;
       if (pcb->snd_wnd > 0 && pcb->persist_backoff > 0) {
           pcb->persist_backoff = 0;
       }
-      LWIP_DEBUGF(TCP_WND_DEBUG, ("tcp_receive: window update %"U16_F"\n", pcb->snd_wnd));
+      LWIP_DEBUGF(TCP_WND_DEBUG, ("tcp_receive: window update %"TCPWNDSIZE_F"\n", pcb->snd_wnd));
 #if TCP_WND_DEBUG
     } else {
-      if (pcb->snd_wnd != tcphdr->wnd) {
+      if (pcb->snd_wnd != tcphdr_wnd) {
         LWIP_DEBUGF(TCP_WND_DEBUG, 
                     ("tcp_receive: no window update lastack %"U32_F" ackno %"
                      U32_F" wl1 %"U32_F" seqno %"U32_F" wl2 %"U32_F"\n",
@@ -879,6 +957,12 @@ tcp_receive(struct tcp_pcb *pcb)
 #endif /* TCP_WND_DEBUG */
     }
 
+#if LWIP_TCP_SACK
+    if (sack_count > 0) {
+      tcp_sack_receive(pcb);
+    }
+#endif /* LWIP_TCP_SACK */
+
     /* (From Stevens TCP/IP Illustrated Vol II, p970.) Its only a
      * duplicate ack if:
      * 1) It doesn't ACK new data 
@@ -914,9 +998,16 @@ tcp_receive(struct tcp_pcb *pcb)
               if (pcb->dupacks + 1 > pcb->dupacks)
                 ++pcb->dupacks;
               if (pcb->dupacks > 3) {
+#if LWIP_TCP_SACK
+                if (((pcb->flags & (TF_INFR | TF_SACK)) == (TF_INFR | TF_SACK)) &&
+                    tcp_rexmit_hole(pcb, 0)) {
+                  /* The segment that left the network is replaced by a
+                     retransmission, not by new data: cwnd stays. */
+                } else
+#endif /* LWIP_TCP_SACK */
                 /* Inflate the congestion window, but not if it means that
                    the value overflows. */
-                if ((u16_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
+                if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
                   pcb->cwnd += pcb->mss;
                 }
               } else if (pcb->dupacks == 3) {
@@ -939,8 +1030,17 @@ tcp_receive(struct tcp_pcb *pcb)
          in fast retransmit. Also reset the congestion window to the
          slow start threshold. */
       if (pcb->flags & TF_INFR) {
-        pcb->flags &= ~TF_INFR;
-        pcb->cwnd = pcb->ssthresh;
+#if LWIP_TCP_SACK
+        if ((pcb->flags & TF_SACK) && TCP_SEQ_LT(ackno, pcb->recover)) {
+          /* A partial ACK: more was lost from the window, stay in fast
+             recovery and retransmit the next hole (below). */
+          partial_ack = 1;
+        } else
+#endif /* LWIP_TCP_SACK */
+        {
+          pcb->flags &= ~TF_INFR;
+          pcb->cwnd = pcb->ssthresh;
+        }
       }
 
       /* Reset the number of retransmissions. */
@@ -949,8 +1049,9 @@ tcp_receive(struct tcp_pcb *pcb)
       /* Reset the retransmission time-out. */
       pcb->rto = (pcb->sa >> 3) + pcb->sv;
 
-      /* Update the send buffer space. Diff between the two can never exceed 64K? */
-      pcb->acked = (u16_t)(ackno - pcb->lastack);
+      /* Update the send buffer space. Diff between the two can never exceed 64K
+         unless the window is scaled. */
+      pcb->acked = (tcpwnd_size_t)(ackno - pcb->lastack);
 
       pcb->snd_buf += pcb->acked;
 
@@ -961,17 +1062,25 @@ tcp_receive(struct tcp_pcb *pcb)
       /* Update the congestion control variables (cwnd and
          ssthresh). */
       if (pcb->state >= ESTABLISHED) {
+#if LWIP_TCP_SACK
+        if (partial_ack) {
+          /* Deflate the window by the data acknowledged and let one more
+             segment out, the retransmission (RFC 6582). */
+          pcb->cwnd = ((pcb->cwnd > pcb->acked) ? (pcb->cwnd - pcb->acked) : 0) + pcb->mss;
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: partial ACK cwnd %"TCPWNDSIZE_F"\n", pcb->cwnd));
+        } else
+#endif /* LWIP_TCP_SACK */
         if (pcb->cwnd < pcb->ssthresh) {
-          if ((u16_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
+          if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
             pcb->cwnd += pcb->mss;
           }
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: slow start cwnd %"U16_F"\n", pcb->cwnd));
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: slow start cwnd %"TCPWNDSIZE_F"\n", pcb->cwnd));
         } else {
-          u16_t new_cwnd = (pcb->cwnd + pcb->mss * pcb->mss / pcb->cwnd);
+          tcpwnd_size_t new_cwnd = (pcb->cwnd + pcb->mss * pcb->mss / pcb->cwnd);
           if (new_cwnd > pcb->cwnd) {
             pcb->cwnd = new_cwnd;
           }
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: congestion avoidance cwnd %"U16_F"\n", pcb->cwnd));
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: congestion avoidance cwnd %"TCPWNDSIZE_F"\n", pcb->cwnd));
         }
       }
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_receive: ACK for %"U32_F", unacked->seqno %"U32_F":%"U32_F"\n",
@@ -1019,6 +1128,12 @@ tcp_receive(struct tcp_pcb *pcb)
         pcb->rtime = 0;
 
       pcb->polltmr = 0;
+
+#if LWIP_TCP_SACK
+      if (partial_ack) {
+        tcp_rexmit_hole(pcb, 1);
+      }
+#endif /* LWIP_TCP_SACK */
     } else {
       /* Fix bug bug #21582: out of sequence ACK, didn't really ack anything */
       pcb->acked = 0;
@@ -1334,11 +1449,24 @@ tcp_receive(struct tcp_pcb *pcb)
 
 
         /* Acknowledge the segment(s). */
+#if LWIP_TCP_SACK
+        if ((pcb->flags & TF_SACK) && (pcb->ooseq != NULL)) {
+          /* Part of a gap was filled: report what is still missing
+             right away (RFC 5681). */
+          tcp_ack_now(pcb);
+        } else
+#endif /* LWIP_TCP_SACK */
         tcp_ack(pcb);
 
       } else {
         /* We get here if the incoming segment is out-of-sequence. */
+#if LWIP_TCP_SACK
+        /* Reported in the first SACK block of the ACK sent below, once the
+           segment has been queued. */
+        pcb->sack_recent = seqno;
+#else /* LWIP_TCP_SACK */
         tcp_send_empty_ack(pcb);
+#endif /* LWIP_TCP_SACK */
 #if TCP_QUEUE_OOSEQ
         /* We queue the segment on the ->ooseq queue. */
         if (pcb->ooseq == NULL) {
@@ -1461,6 +1589,9 @@ tcp_receive(struct tcp_pcb *pcb)
           }
         }
 #endif /* TCP_QUEUE_OOSEQ */
+#if LWIP_TCP_SACK
+        tcp_send_empty_ack(pcb);
+#endif /* LWIP_TCP_SACK */
 
       }
     } else {
@@ -1482,7 +1613,8 @@ tcp_receive(struct tcp_pcb *pcb)
  * Parses the options contained in the incoming segment. 
  *
  * Called from tcp_listen_input() and tcp_process().
- * Currently, only the MSS option is supported!
+ * Supported are MSS, timestamps, window scale and SACK (the latter three
+ * only if enabled in lwipopts.h).
  *
  * @param pcb the tcp_pcb for which a segment arrived
  */
@@ -1495,7 +1627,13 @@ tcp_parseopt(struct tcp_pcb *pcb)
 #if LWIP_TCP_TIMESTAMPS
   u32_t tsval;
 #endif
+#if LWIP_TCP_SACK
+  u8_t i, n;
+#endif /* LWIP_TCP_SACK */
 
+#if LWIP_TCP_SACK
+  sack_count = 0;
+#endif /* LWIP_TCP_SACK */
   opts = (u8_t *)tcphdr + TCP_HLEN;
 
   /* Parse the TCP MSS option, if present. */
@@ -1527,6 +1665,64 @@ tcp_parseopt(struct tcp_pcb *pcb)
         /* Advance to next option */
         c += 0x04;
         break;
+#if LWIP_WND_SCALE
+      case 0x03:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: WND_SCALE\n"));
+        if (opts[c + 1] != 0x03 || c + 0x03 > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        /* Only valid in a SYN, and only the first time (RFC 7323) */
+        if ((flags & TCP_SYN) && !(pcb->flags & TF_WND_SCALE)) {
+          pcb->snd_scale = LWIP_MIN(opts[c + 2], 14);
+          pcb->rcv_scale = TCP_RCV_SCALE;
+          pcb->flags |= TF_WND_SCALE;
+          /* Both sides scale now: the full window may be announced. */
+          pcb->rcv_wnd = TCP_WND;
+          pcb->rcv_ann_wnd = TCP_WND;
+        }
+        /* Advance to next option */
+        c += 0x03;
+        break;
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+      case 0x04:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK_PERM\n"));
+        if (opts[c + 1] != 0x02 || c + 0x02 > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        if (flags & TCP_SYN) {
+          pcb->flags |= TF_SACK;
+        }
+        /* Advance to next option */
+        c += 0x02;
+        break;
+      case 0x05:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK\n"));
+        if (opts[c + 1] < 0x0A || ((opts[c + 1] - 2) & 7) != 0 ||
+            c + opts[c + 1] > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        if ((pcb->flags & TF_SACK) && !(flags & TCP_SYN)) {
+          n = LWIP_MIN((opts[c + 1] - 2) >> 3, 4);
+          for (i = 0; i < n; i++) {
+            u8_t *b = &opts[c + 2 + (i << 3)];
+            sack_left[i] = ((u32_t)b[0] << 24) | ((u32_t)b[1] << 16) |
+              ((u32_t)b[2] << 8) | (u32_t)b[3];
+            sack_right[i] = ((u32_t)b[4] << 24) | ((u32_t)b[5] << 16) |
+              ((u32_t)b[6] << 8) | (u32_t)b[7];
+          }
+          sack_count = n;
+        }
+        /* Advance to next option */
+        c += opts[c + 1];
+        break;
+#endif /* LWIP_TCP_SACK */
 #if LWIP_TCP_TIMESTAMPS
       case 0x08:
         LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: TS\n"));
@@ -1564,4 +1760,48 @@ tcp_parseopt(struct tcp_pcb *pcb)
   }
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Updates the SACK scoreboard from the blocks parsed by tcp_parseopt():
+ * segments on the unacked queue that the peer holds are marked with
+ * TF_SEG_SACKED and sack_high is moved to the highest sequence number
+ * reported.
+ *
+ * @param pcb the tcp_pcb for which a segment arrived
+ */
+static void
+tcp_sack_receive(struct tcp_pcb *pcb)
+{
+  struct tcp_seg *seg;
+  u32_t left, right;
+  u8_t i;
+
+  if (TCP_SEQ_LT(pcb->sack_high, pcb->lastack)) {
+    pcb->sack_high = pcb->lastack;
+  }
+  for (i = 0; i < sack_count; i++) {
+    left = sack_left[i];
+    right = sack_right[i];
+    /* Ignore D-SACKs, empty blocks and blocks for data never sent */
+    if (TCP_SEQ_LEQ(right, ackno) || TCP_SEQ_GEQ(left, right) ||
+        TCP_SEQ_GT(right, pcb->snd_nxt)) {
+      continue;
+    }
+    if (TCP_SEQ_GT(right, pcb->sack_high)) {
+      pcb->sack_high = right;
+    }
+    for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+      u32_t seqno_seg = ntohl(seg->tcphdr->seqno);
+      if (TCP_SEQ_GEQ(seqno_seg, right)) {
+        break;
+      }
+      if (TCP_SEQ_GEQ(seqno_seg, left) &&
+          TCP_SEQ_LEQ(seqno_seg + TCP_TCPLEN(seg), right)) {
+        seg->flags |= TF_SEG_SACKED;
+      }
+    }
+  }
+}
+#endif /* LWIP_TCP_SACK */
+
 #endif /* LWIP_TCP */
@@ -103,7 +103,7 @@ tcp_output_alloc_header(struct tcp_pcb *pcb, u16_t optlen, u16_t datalen,
     tcphdr->seqno = seqno_be;
     tcphdr->ackno = htonl(pcb->rcv_nxt);
     TCPH_HDRLEN_FLAGS_SET(tcphdr, (5 + optlen / 4), TCP_ACK);
-    tcphdr->wnd = htons(pcb->rcv_ann_wnd);
+    tcphdr->wnd = htons(TCPWND16(RCV_WND_SCALE(pcb, pcb->rcv_ann_wnd)));
     tcphdr->chksum = 0;
     tcphdr->urgp = 0;
 
@@ -303,7 +303,7 @@ tcp_write_checks(struct tcp_pcb *pcb, u16_t len)
 
   /* fail on too much data */
   if (len > pcb->snd_buf) {
-    LWIP_DEBUGF(TCP_OUTPUT_DEBUG | 3, ("tcp_write: too much data (len=%"U16_F" > snd_buf=%"U16_F")\n",
+    LWIP_DEBUGF(TCP_OUTPUT_DEBUG | 3, ("tcp_write: too much data (len=%"U16_F" > snd_buf=%"TCPWNDSIZE_F")\n",
       len, pcb->snd_buf));
     pcb->flags |= TF_NAGLEMEMERR;
     return ERR_MEM;
@@ -701,6 +701,201 @@ memerr:
   return ERR_MEM;
 }
 
+#if LWIP_TCP_ZEROCOPY
+/** Free-callback function of a 'struct tcp_zc_ref', called by pbuf_free
+ * when the segment holding it is freed. */
+static void
+tcp_zc_free_ref(struct pbuf *p)
+{
+  struct tcp_zc_ref *zcr = (struct tcp_zc_ref *)p;
+  LWIP_ASSERT("zcr != NULL", zcr != NULL);
+  LWIP_ASSERT("zcr == p", (void *)zcr == (void *)p);
+  if (zcr->original != NULL) {
+    pbuf_free(zcr->original);
+  }
+  memp_free(MEMP_TCP_ZC_REF, zcr);
+}
+
+/**
+ * Write the data of a pbuf chain for sending without copying it (but
+ * does not send it immediately, see tcp_write()).
+ *
+ * The new segments reference the payload of the pbufs of the chain, each
+ * holding a reference (pbuf_ref) on the pbuf it points into. The caller
+ * keeps its own reference and may pbuf_free() the chain right after this
+ * call returns, but must not change the data. Each pbuf of the chain is
+ * deallocated once all segments referencing it have been acknowledged and
+ * freed, or the connection is closed: for a custom pbuf (see
+ * pbuf_alloced_custom()), that call of its free function is the send
+ * completion. The data always starts a new segment.
+ *
+ * @param pcb Protocol control block for the TCP connection to enqueue data for.
+ * @param p pbuf chain holding the data to be enqueued for sending
+ * @param apiflags TCP_WRITE_FLAG_MORE or 0 (TCP_WRITE_FLAG_COPY is ignored)
+ * @return ERR_OK if enqueued, another err_t on error (nothing is enqueued
+ *         then and p is not referenced)
+ */
+err_t
+tcp_write_pbuf(struct tcp_pcb *pcb, struct pbuf *p, u8_t apiflags)
+{
+  struct tcp_seg *last_unsent = NULL, *seg = NULL, *prev_seg = NULL, *queue = NULL;
+  struct pbuf *q = p;
+  u16_t q_off = 0; /* position in q */
+  u16_t len, pos = 0; /* position in the data of p */
+  u16_t queuelen;
+  u8_t optlen = 0;
+  u8_t optflags = 0;
+  err_t err;
+
+  LWIP_ERROR("tcp_write_pbuf: p == NULL (programmer violates API)",
+             p != NULL, return ERR_ARG;);
+  len = p->tot_len;
+  LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_write_pbuf(pcb=%p, p=%p, len=%"U16_F", apiflags=%"U16_F")\n",
+    (void *)pcb, (void *)p, len, (u16_t)apiflags));
+
+  err = tcp_write_checks(pcb, len);
+  if ((err != ERR_OK) || (len == 0)) {
+    return err;
+  }
+  queuelen = pcb->snd_queuelen;
+
+#if LWIP_TCP_TIMESTAMPS
+  if ((pcb->flags & TF_TIMESTAMP)) {
+    optflags = TF_SEG_OPTS_TS;
+    optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
+  }
+#endif /* LWIP_TCP_TIMESTAMPS */
+
+  /* Create the new segments: a PBUF_RAM pbuf for the headers, followed by
+   * one pbuf per part of p the segment covers. */
+  while (pos < len) {
+    struct pbuf *hdr;
+    u16_t left = len - pos;
+    u16_t max_len = pcb->mss - optlen;
+    u16_t seglen = left > max_len ? max_len : left;
+    u16_t filled;
+#if TCP_CHECKSUM_ON_COPY
+    u16_t chksum = 0;
+    u8_t chksum_swapped = 0;
+#endif /* TCP_CHECKSUM_ON_COPY */
+
+    if ((hdr = pbuf_alloc(PBUF_TRANSPORT, optlen, PBUF_RAM)) == NULL) {
+      LWIP_DEBUGF(TCP_OUTPUT_DEBUG | 2, ("tcp_write_pbuf: could not allocate memory for header pbuf\n"));
+      goto memerr;
+    }
+    for (filled = 0; filled < seglen; ) {
+      struct tcp_zc_ref *zcr;
+      struct pbuf *ref;
+      u16_t reflen;
+
+      /* skip to the pbuf holding the next byte */
+      while (q_off >= q->len) {
+        q_off -= q->len;
+        q = q->next;
+        LWIP_ASSERT("tcp_write_pbuf: tot_len does not match chain", q != NULL);
+      }
+      reflen = LWIP_MIN(q->len - q_off, seglen - filled);
+      zcr = (struct tcp_zc_ref *)memp_malloc(MEMP_TCP_ZC_REF);
+      if (zcr == NULL) {
+        LWIP_DEBUGF(TCP_OUTPUT_DEBUG | 2, ("tcp_write_pbuf: could not allocate memory for zero-copy pbuf\n"));
+        pbuf_free(hdr);
+        goto memerr;
+      }
+      /* We can use PBUF_RAW here since the data appears after the
+       * header pbuf. A header will never be prepended. */
+      ref = pbuf_alloced_custom(PBUF_RAW, reflen, PBUF_REF, &zcr->pc,
+                                (u8_t *)q->payload + q_off, reflen);
+      LWIP_ASSERT("tcp_write_pbuf: PBUF_RAW custom pbuf always fits", ref != NULL);
+      zcr->pc.custom_free_function = tcp_zc_free_ref;
+      zcr->original = q;
+      pbuf_ref(q);
+      pbuf_cat(hdr, ref);
+#if TCP_CHECKSUM_ON_COPY
+      /* calculate the checksum of nocopy-data */
+      tcp_seg_add_chksum(~inet_chksum(ref->payload, reflen), reflen,
+        &chksum, &chksum_swapped);
+#endif /* TCP_CHECKSUM_ON_COPY */
+      filled += reflen;
+      q_off += reflen;
+    }
+
+    queuelen += pbuf_clen(hdr);
+
+    /* Now that there are more segments queued, we check again if the
+     * length of the queue exceeds the configured maximum or
+     * overflows. */
+    if ((queuelen > TCP_SND_QUEUELEN) || (queuelen > TCP_SNDQUEUELEN_OVERFLOW)) {
+      LWIP_DEBUGF(TCP_OUTPUT_DEBUG | 2, ("tcp_write_pbuf: queue too long %"U16_F" (%"U16_F")\n", queuelen, TCP_SND_QUEUELEN));
+      pbuf_free(hdr);
+      goto memerr;
+    }
+
+    if ((seg = tcp_create_segment(pcb, hdr, 0, pcb->snd_lbb + pos, optflags)) == NULL) {
+      goto memerr;
+    }
+#if TCP_CHECKSUM_ON_COPY
+    seg->chksum = chksum;
+    seg->chksum_swapped = chksum_swapped;
+    seg->flags |= TF_SEG_DATA_CHECKSUMMED;
+#endif /* TCP_CHECKSUM_ON_COPY */
+
+    /* first segment of to-be-queued data? */
+    if (queue == NULL) {
+      queue = seg;
+    } else {
+      /* Attach the segment to the end of the queued segments */
+      LWIP_ASSERT("prev_seg != NULL", prev_seg != NULL);
+      prev_seg->next = seg;
+    }
+    /* remember last segment of to-be-queued data for next iteration */
+    prev_seg = seg;
+
+    LWIP_DEBUGF(TCP_OUTPUT_DEBUG | LWIP_DBG_TRACE, ("tcp_write_pbuf: queueing %"U32_F":%"U32_F"\n",
+      ntohl(seg->tcphdr->seqno),
+      ntohl(seg->tcphdr->seqno) + TCP_TCPLEN(seg)));
+
+    pos += seglen;
+  }
+
+  /* Append queue to pcb->unsent. The tail of the last unsent segment must
+   * not be filled anymore, the data of p comes after it. */
+  if (pcb->unsent == NULL) {
+    pcb->unsent = queue;
+  } else {
+    for (last_unsent = pcb->unsent; last_unsent->next != NULL;
+         last_unsent = last_unsent->next);
+    last_unsent->next = queue;
+  }
+#if TCP_OVERSIZE
+  pcb->unsent_oversize = 0;
+#endif /* TCP_OVERSIZE */
+
+  pcb->snd_lbb += len;
+  pcb->snd_buf -= len;
+  pcb->snd_queuelen = queuelen;
+
+  LWIP_DEBUGF(TCP_QLEN_DEBUG, ("tcp_write_pbuf: %"S16_F" (after enqueued)\n",
+    pcb->snd_queuelen));
+
+  /* Set the PSH flag in the last segment that we enqueued. */
+  if ((apiflags & TCP_WRITE_FLAG_MORE) == 0) {
+    TCPH_SET_FLAG(seg->tcphdr, TCP_PSH);
+  }
+
+  return ERR_OK;
+memerr:
+  pcb->flags |= TF_NAGLEMEMERR;
+  TCP_STATS_INC(tcp.memerr);
+
+  /* freeing the segments drops the references taken on p */
+  if (queue != NULL) {
+    tcp_segs_free(queue);
+  }
+  LWIP_DEBUGF(TCP_QLEN_DEBUG | LWIP_DBG_STATE, ("tcp_write_pbuf: %"S16_F" (with mem err)\n", pcb->snd_queuelen));
+  return ERR_MEM;
+}
+#endif /* LWIP_TCP_ZEROCOPY */
+
 /**
  * Enqueue TCP options for transmission.
  *
@@ -735,6 +930,17 @@ tcp_enqueue_flags(struct tcp_pcb *pcb, u8_t flags)
 
   if (flags & TCP_SYN) {
     optflags = TF_SEG_OPTS_MSS;
+#if LWIP_WND_SCALE
+    /* Offer window scaling in a SYN, but only answer a SYN that offered it */
+    if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_WND_SCALE)) {
+      optflags |= TF_SEG_OPTS_WND_SCALE;
+    }
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+    if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_SACK)) {
+      optflags |= TF_SEG_OPTS_SACK_PERM;
+    }
+#endif /* LWIP_TCP_SACK */
   }
 #if LWIP_TCP_TIMESTAMPS
   if ((pcb->flags & TF_TIMESTAMP)) {
@@ -828,6 +1034,73 @@ tcp_build_timestamp_option(struct tcp_pcb *pcb, u32_t *opts)
 }
 #endif
 
+#if LWIP_TCP_SACK
+/**
+ * Collect the SACK blocks to report from the out-of-sequence queue.
+ * Contiguous segments are reported as one block. As RFC 2018 asks, the
+ * block holding the segment that arrived last comes first; the others
+ * follow in sequence order for as long as there is room.
+ *
+ * @param pcb tcp_pcb
+ * @param left left edges of the blocks (host byte order)
+ * @param right right edges of the blocks (host byte order)
+ * @return the number of blocks (at most TCP_SACK_MAX_BLOCKS(pcb))
+ */
+static u8_t
+tcp_sack_blocks(struct tcp_pcb *pcb, u32_t *left, u32_t *right)
+{
+  struct tcp_seg *seg;
+  u32_t l, r;
+  u8_t n = 0, i;
+  u8_t max = TCP_SACK_MAX_BLOCKS(pcb);
+
+  for (seg = pcb->ooseq; seg != NULL; ) {
+    l = seg->tcphdr->seqno;
+    r = l + TCP_TCPLEN(seg);
+    for (seg = seg->next; (seg != NULL) && (seg->tcphdr->seqno == r); seg = seg->next) {
+      r += TCP_TCPLEN(seg);
+    }
+    if (TCP_SEQ_BETWEEN(pcb->sack_recent, l, r - 1)) {
+      /* the most recent block goes first, at the expense of the last one */
+      if (n < max) {
+        n++;
+      }
+      for (i = n - 1; i > 0; i--) {
+        left[i] = left[i - 1];
+        right[i] = right[i - 1];
+      }
+      left[0] = l;
+      right[0] = r;
+    } else if (n < max) {
+      left[n] = l;
+      right[n] = r;
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * Build a SACK option (aligned by two NOPs) at the specified options pointer
+ *
+ * @param opts option pointer where to store the SACK option
+ * @param left left edges of the blocks (host byte order)
+ * @param right right edges of the blocks (host byte order)
+ * @param n number of blocks
+ */
+static void
+tcp_build_sack_option(u32_t *opts, u32_t *left, u32_t *right, u8_t n)
+{
+  u8_t i;
+
+  opts[0] = htonl(0x01010500UL | (2 + 8 * n));
+  for (i = 0; i < n; i++) {
+    opts[1 + 2 * i] = htonl(left[i]);
+    opts[2 + 2 * i] = htonl(right[i]);
+  }
+}
+#endif /* LWIP_TCP_SACK */
+
 /** Send an ACK without data.
  *
  * @param pcb Protocol control block for the TCP connection to send the ACK
@@ -838,12 +1111,22 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
   struct pbuf *p;
   struct tcp_hdr *tcphdr;
   u8_t optlen = 0;
+#if LWIP_TCP_SACK
+  u32_t sack_left[4], sack_right[4];
+  u8_t sack_n = 0;
+#endif /* LWIP_TCP_SACK */
 
 #if LWIP_TCP_TIMESTAMPS
   if (pcb->flags & TF_TIMESTAMP) {
     optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
   }
 #endif
+#if LWIP_TCP_SACK
+  if ((pcb->flags & TF_SACK) && (pcb->ooseq != NULL)) {
+    sack_n = tcp_sack_blocks(pcb, sack_left, sack_right);
+    optlen += 4 + 8 * sack_n;
+  }
+#endif /* LWIP_TCP_SACK */
 
   p = tcp_output_alloc_header(pcb, optlen, 0, htonl(pcb->snd_nxt));
   if (p == NULL) {
@@ -864,6 +1147,12 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
     tcp_build_timestamp_option(pcb, (u32_t *)(tcphdr + 1));
   }
 #endif 
+#if LWIP_TCP_SACK
+  if (sack_n > 0) {
+    tcp_build_sack_option((u32_t *)(void *)((u8_t *)(tcphdr + 1) + optlen - 4 - 8 * sack_n),
+                          sack_left, sack_right, sack_n);
+  }
+#endif /* LWIP_TCP_SACK */
 
 #if CHECKSUM_GEN_TCP
   tcphdr->chksum = inet_chksum_pseudo(p, &(pcb->local_ip), &(pcb->remote_ip),
@@ -881,6 +1170,18 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
   return ERR_OK;
 }
 
+#if LWIP_TCP_SACK
+/** Whether seg may be sent: it fits into the window or, during SACK based
+ * recovery, it is the retransmission of a hole (already below snd_nxt) */
+#define TCP_SEG_IN_WND(pcb, seg, wnd) \
+  ((ntohl((seg)->tcphdr->seqno) - (pcb)->lastack + (seg)->len <= (wnd)) || \
+   ((((pcb)->flags & (TF_INFR | TF_SACK)) == (TF_INFR | TF_SACK)) && \
+    TCP_SEQ_LEQ(ntohl((seg)->tcphdr->seqno) + (seg)->len, (pcb)->snd_nxt)))
+#else /* LWIP_TCP_SACK */
+#define TCP_SEG_IN_WND(pcb, seg, wnd) \
+  (ntohl((seg)->tcphdr->seqno) - (pcb)->lastack + (seg)->len <= (wnd))
+#endif /* LWIP_TCP_SACK */
+
 /**
  * Find out what we can send and send it
  *
@@ -916,8 +1217,7 @@ tcp_output(struct tcp_pcb *pcb)
    * If data is to be sent, we will just piggyback the ACK (see below).
    */
   if (pcb->flags & TF_ACK_NOW &&
-     (seg == NULL ||
-      ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len > wnd)) {
+     (seg == NULL || !TCP_SEG_IN_WND(pcb, seg, wnd))) {
      return tcp_send_empty_ack(pcb);
   }
 
@@ -935,13 +1235,13 @@ tcp_output(struct tcp_pcb *pcb)
 #endif /* TCP_OUTPUT_DEBUG */
 #if TCP_CWND_DEBUG
   if (seg == NULL) {
-    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"U16_F
-                                 ", cwnd %"U16_F", wnd %"U32_F
+    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"TCPWNDSIZE_F
+                                 ", cwnd %"TCPWNDSIZE_F", wnd %"U32_F
                                  ", seg == NULL, ack %"U32_F"\n",
                                  pcb->snd_wnd, pcb->cwnd, wnd, pcb->lastack));
   } else {
     LWIP_DEBUGF(TCP_CWND_DEBUG, 
-                ("tcp_output: snd_wnd %"U16_F", cwnd %"U16_F", wnd %"U32_F
+                ("tcp_output: snd_wnd %"TCPWNDSIZE_F", cwnd %"TCPWNDSIZE_F", wnd %"U32_F
                  ", effwnd %"U32_F", seq %"U32_F", ack %"U32_F"\n",
                  pcb->snd_wnd, pcb->cwnd, wnd,
                  ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len,
@@ -949,8 +1249,7 @@ tcp_output(struct tcp_pcb *pcb)
   }
 #endif /* TCP_CWND_DEBUG */
   /* data available and window allows it to be sent? */
-  while (seg != NULL &&
-         ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len <= wnd) {
+  while (seg != NULL && TCP_SEG_IN_WND(pcb, seg, wnd)) {
     LWIP_ASSERT("RST not expected here!", 
                 (TCPH_FLAGS(seg->tcphdr) & TCP_RST) == 0);
     /* Stop sending if the nagle algorithm would prevent it
@@ -965,7 +1264,7 @@ tcp_output(struct tcp_pcb *pcb)
       break;
     }
 #if TCP_CWND_DEBUG
-    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"U16_F", cwnd %"U16_F", wnd %"U32_F", effwnd %"U32_F", seq %"U32_F", ack %"U32_F", i %"S16_F"\n",
+    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"TCPWNDSIZE_F", cwnd %"TCPWNDSIZE_F", wnd %"U32_F", effwnd %"U32_F", seq %"U32_F", ack %"U32_F", i %"S16_F"\n",
                             pcb->snd_wnd, pcb->cwnd, wnd,
                             ntohl(seg->tcphdr->seqno) + seg->len -
                             pcb->lastack,
@@ -1057,9 +1356,17 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
   seg->tcphdr->ackno = htonl(pcb->rcv_nxt);
 
   /* advertise our receive window size in this TCP segment */
-  seg->tcphdr->wnd = htons(pcb->rcv_ann_wnd);
-
-  pcb->rcv_ann_right_edge = pcb->rcv_nxt + pcb->rcv_ann_wnd;
+#if LWIP_WND_SCALE
+  if (TCPH_FLAGS(seg->tcphdr) & TCP_SYN) {
+    /* The window in a SYN segment is never scaled */
+    seg->tcphdr->wnd = htons(TCPWND16(pcb->rcv_ann_wnd));
+    pcb->rcv_ann_right_edge = pcb->rcv_nxt + TCPWND16(pcb->rcv_ann_wnd);
+  } else
+#endif /* LWIP_WND_SCALE */
+  {
+    seg->tcphdr->wnd = htons(TCPWND16(RCV_WND_SCALE(pcb, pcb->rcv_ann_wnd)));
+    pcb->rcv_ann_right_edge = pcb->rcv_nxt + pcb->rcv_ann_wnd;
+  }
 
   /* Add any requested options.  NB MSS option is only set on SYN
      packets, so ignore it here */
@@ -1069,6 +1376,20 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
     TCP_BUILD_MSS_OPTION(*opts);
     opts += 1;
   }
+#if LWIP_WND_SCALE
+  if (seg->flags & TF_SEG_OPTS_WND_SCALE) {
+    /* NOP, kind 3, length 3, shift count */
+    *opts = PP_HTONL(0x01030300UL | TCP_RCV_SCALE);
+    opts += 1;
+  }
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+  if (seg->flags & TF_SEG_OPTS_SACK_PERM) {
+    /* NOP, NOP, kind 4, length 2 */
+    *opts = PP_HTONL(0x01010402UL);
+    opts += 1;
+  }
+#endif /* LWIP_TCP_SACK */
 #if LWIP_TCP_TIMESTAMPS
   pcb->ts_lastacksent = pcb->rcv_nxt;
 
@@ -1204,7 +1525,7 @@ tcp_rst(u32_t seqno, u32_t ackno,
   tcphdr->seqno = htonl(seqno);
   tcphdr->ackno = htonl(ackno);
   TCPH_HDRLEN_FLAGS_SET(tcphdr, TCP_HLEN/4, TCP_RST | TCP_ACK);
-  tcphdr->wnd = PP_HTONS(TCP_WND);
+  tcphdr->wnd = PP_HTONS(TCPWND16(TCP_WND));
   tcphdr->chksum = 0;
   tcphdr->urgp = 0;
 
@@ -1236,6 +1557,17 @@ tcp_rexmit_rto(struct tcp_pcb *pcb)
     return;
   }
 
+#if LWIP_TCP_SACK
+  /* The receiver may have dropped data it SACKed (RFC 2018), so forget the
+     scoreboard and resend everything. A timeout also ends fast recovery. */
+  for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+    seg->flags &= ~TF_SEG_SACKED;
+  }
+  pcb->sack_high = pcb->lastack;
+  pcb->rexmit_high = pcb->lastack;
+  pcb->flags &= ~TF_INFR;
+#endif /* LWIP_TCP_SACK */
+
   /* Move all unacked segments to the head of the unsent queue */
   for (seg = pcb->unacked; seg->next != NULL; seg = seg->next);
   /* concatenate unsent queue after unacked queue */
@@ -1256,27 +1588,27 @@ tcp_rexmit_rto(struct tcp_pcb *pcb)
 }
 
 /**
- * Requeue the first unacked segment for retransmission
+ * Requeue one unacked segment for retransmission
  *
- * Called by tcp_receive() for fast retramsmit.
+ * Called by tcp_rexmit() and, to fill the holes reported by SACK, by
+ * tcp_rexmit_hole().
  *
- * @param pcb the tcp_pcb for which to retransmit the first unacked segment
+ * @param pcb the tcp_pcb for which to retransmit seg
+ * @param seg a segment on pcb->unacked
  */
 void
-tcp_rexmit(struct tcp_pcb *pcb)
+tcp_rexmit_seg(struct tcp_pcb *pcb, struct tcp_seg *seg)
 {
-  struct tcp_seg *seg;
   struct tcp_seg **cur_seg;
 
-  if (pcb->unacked == NULL) {
-    return;
+  /* Unlink the segment from the unacked queue */
+  for (cur_seg = &(pcb->unacked); *cur_seg != seg; cur_seg = &((*cur_seg)->next)) {
+    LWIP_ASSERT("tcp_rexmit_seg: seg not on unacked", *cur_seg != NULL);
   }
+  *cur_seg = seg->next;
 
-  /* Move the first unacked segment to the unsent queue */
+  /* Move it to the unsent queue */
   /* Keep the unsent queue sorted. */
-  seg = pcb->unacked;
-  pcb->unacked = seg->next;
-
   cur_seg = &(pcb->unsent);
   while (*cur_seg &&
     TCP_SEQ_LT(ntohl((*cur_seg)->tcphdr->seqno), ntohl(seg->tcphdr->seqno))) {
@@ -1285,8 +1617,6 @@ tcp_rexmit(struct tcp_pcb *pcb)
   seg->next = *cur_seg;
   *cur_seg = seg;
 
-  ++pcb->nrtx;
-
   /* Don't take any rtt measurements after retransmitting. */
   pcb->rttest = 0;
 
@@ -1296,6 +1626,25 @@ tcp_rexmit(struct tcp_pcb *pcb)
      and thus tcp_output directly returns. */
 }
 
+/**
+ * Requeue the first unacked segment for retransmission
+ *
+ * Called by tcp_receive() for fast retramsmit.
+ *
+ * @param pcb the tcp_pcb for which to retransmit the first unacked segment
+ */
+void
+tcp_rexmit(struct tcp_pcb *pcb)
+{
+  if (pcb->unacked == NULL) {
+    return;
+  }
+
+  tcp_rexmit_seg(pcb, pcb->unacked);
+
+  ++pcb->nrtx;
+}
+
 
 /**
  * Handle retransmission after three dupacks received
@@ -1312,6 +1661,14 @@ tcp_rexmit_fast(struct tcp_pcb *pcb)
                  "), fast retransmit %"U32_F"\n",
                  (u16_t)pcb->dupacks, pcb->lastack,
                  ntohl(pcb->unacked->tcphdr->seqno)));
+#if LWIP_TCP_SACK
+    /* Recovery lasts until everything sent so far is acknowledged */
+    pcb->recover = pcb->snd_nxt;
+    if (TCP_SEQ_LT(pcb->sack_high, pcb->lastack)) {
+      pcb->sack_high = pcb->lastack;
+    }
+    pcb->rexmit_high = ntohl(pcb->unacked->tcphdr->seqno) + TCP_TCPLEN(pcb->unacked);
+#endif /* LWIP_TCP_SACK */
     tcp_rexmit(pcb);
 
     /* Set ssthresh to half of the minimum of the current
@@ -1325,7 +1682,7 @@ tcp_rexmit_fast(struct tcp_pcb *pcb)
     /* The minimum value for ssthresh should be 2 MSS */
     if (pcb->ssthresh < 2*pcb->mss) {
       LWIP_DEBUGF(TCP_FR_DEBUG, 
-                  ("tcp_receive: The minimum value for ssthresh %"U16_F
+                  ("tcp_receive: The minimum value for ssthresh %"TCPWNDSIZE_F
                    " should be min 2 mss %"U16_F"...\n",
                    pcb->ssthresh, 2*pcb->mss));
       pcb->ssthresh = 2*pcb->mss;
@@ -1336,6 +1693,46 @@ tcp_rexmit_fast(struct tcp_pcb *pcb)
   } 
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Retransmit the next hole during fast recovery: the first unacked segment
+ * that has not been SACKed or retransmitted yet, and lies below data the
+ * receiver has SACKed (RFC 6675). After a partial ACK the segment at the
+ * new left edge counts as lost even without SACK information above it
+ * (RFC 6582).
+ *
+ * Called by tcp_receive() for each further duplicate ACK and each partial
+ * ACK received in fast recovery.
+ *
+ * @param pcb the tcp_pcb in fast recovery
+ * @param partial_ack 1 if the ACK being processed acknowledged new data
+ * @return 1 if a segment was requeued, 0 if there is no hole to fill
+ */
+u8_t
+tcp_rexmit_hole(struct tcp_pcb *pcb, u8_t partial_ack)
+{
+  struct tcp_seg *seg;
+  u32_t seqno;
+
+  for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+    seqno = ntohl(seg->tcphdr->seqno);
+    if (!(partial_ack && (seg == pcb->unacked)) &&
+        TCP_SEQ_GT(seqno + TCP_TCPLEN(seg), pcb->sack_high)) {
+      /* nothing SACKed above this one */
+      break;
+    }
+    if (((seg->flags & TF_SEG_SACKED) == 0) &&
+        TCP_SEQ_GEQ(seqno, pcb->rexmit_high)) {
+      LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_rexmit_hole: retransmit %"U32_F"\n", seqno));
+      pcb->rexmit_high = seqno + TCP_TCPLEN(seg);
+      tcp_rexmit_seg(pcb, seg);
+      return 1;
+    }
+  }
+  return 0;
+}
+#endif /* LWIP_TCP_SACK */
+
 
 /**
  * Send keepalive packets to keep a connection active although
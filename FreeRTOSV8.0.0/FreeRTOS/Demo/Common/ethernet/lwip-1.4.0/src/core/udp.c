@@ -68,6 +68,68 @@
 /* exported in udp.h (was static) */
 struct udp_pcb *udp_pcbs;
 
+#if UDP_PCB_HASH
+/** Hash table over udp_pcbs, indexed by local port. Within a bucket, pcbs
+ * bound to the same port are kept in the order the udp_pcbs list walk would
+ * find them, so the 'first unconnected pcb' rule still holds. That is the
+ * order of their hash_stamp, newest first, as udp_input() only moves pcbs to
+ * the front of their bucket and leaves udp_pcbs alone. */
+static struct udp_pcb *udp_pcb_hash[UDP_PCB_HASH_SIZE];
+static u32_t udp_pcb_hash_stamp;
+
+#define UDP_PCB_HASH_INDEX(port) ((port) & (UDP_PCB_HASH_SIZE - 1))
+
+/**
+ * Put a pcb that has just been bound at the front of its hash bucket.
+ */
+static void
+udp_pcb_hash_add(struct udp_pcb *pcb)
+{
+  struct udp_pcb **bucket = &udp_pcb_hash[UDP_PCB_HASH_INDEX(pcb->local_port)];
+
+  pcb->hash_next = *bucket;
+  pcb->hash_stamp = ++udp_pcb_hash_stamp;
+  *bucket = pcb;
+}
+
+/**
+ * Put a pcb that has been rebound to another port into its new hash bucket.
+ * It keeps its place on udp_pcbs, so it goes behind the pcbs bound to the
+ * same port that were moved to the front of the list after it.
+ */
+static void
+udp_pcb_hash_add_rebound(struct udp_pcb *pcb)
+{
+  struct udp_pcb **bucket = &udp_pcb_hash[UDP_PCB_HASH_INDEX(pcb->local_port)];
+
+  for (; *bucket != NULL; bucket = &(*bucket)->hash_next) {
+    if (((*bucket)->local_port == pcb->local_port) &&
+        ((s32_t)(pcb->hash_stamp - (*bucket)->hash_stamp) > 0)) {
+      break;
+    }
+  }
+  pcb->hash_next = *bucket;
+  *bucket = pcb;
+}
+
+/**
+ * Remove a pcb from its hash bucket. Does nothing if the pcb was never bound.
+ */
+static void
+udp_pcb_hash_remove(struct udp_pcb *pcb)
+{
+  struct udp_pcb **bucket = &udp_pcb_hash[UDP_PCB_HASH_INDEX(pcb->local_port)];
+
+  for (; *bucket != NULL; bucket = &(*bucket)->hash_next) {
+    if (*bucket == pcb) {
+      *bucket = pcb->hash_next;
+      break;
+    }
+  }
+  pcb->hash_next = NULL;
+}
+#endif /* UDP_PCB_HASH */
+
 /**
  * Process an incoming UDP datagram.
  *
@@ -159,7 +221,11 @@ udp_input(struct pbuf *p, struct netif *inp)
      * 'Perfect match' pcbs (connected to the remote port & ip address) are
      * preferred. If no perfect match is found, the first unconnected pcb that
      * matches the local port and ip address gets the datagram. */
+#if UDP_PCB_HASH
+    for (pcb = udp_pcb_hash[UDP_PCB_HASH_INDEX(dest)]; pcb != NULL; pcb = pcb->hash_next) {
+#else /* UDP_PCB_HASH */
     for (pcb = udp_pcbs; pcb != NULL; pcb = pcb->next) {
+#endif /* UDP_PCB_HASH */
       local_match = 0;
       /* print the PCB local and remote address */
       LWIP_DEBUGF(UDP_DEBUG,
@@ -195,12 +261,24 @@ udp_input(struct pbuf *p, struct netif *inp)
           (ip_addr_isany(&pcb->remote_ip) ||
            ip_addr_cmp(&(pcb->remote_ip), &current_iphdr_src))) {
         /* the first fully matching PCB */
+#if UDP_PCB_HASH
+        /* the list walk would have moved it to the front of udp_pcbs */
+        pcb->hash_stamp = ++udp_pcb_hash_stamp;
+#endif /* UDP_PCB_HASH */
         if (prev != NULL) {
+#if UDP_PCB_HASH
+          /* move the pcb to the front of its bucket so that is
+             found faster next time */
+          prev->hash_next = pcb->hash_next;
+          pcb->hash_next = udp_pcb_hash[UDP_PCB_HASH_INDEX(dest)];
+          udp_pcb_hash[UDP_PCB_HASH_INDEX(dest)] = pcb;
+#else /* UDP_PCB_HASH */
           /* move the pcb to the front of udp_pcbs so that is
              found faster next time */
           prev->next = pcb->next;
           pcb->next = udp_pcbs;
           udp_pcbs = pcb;
+#endif /* UDP_PCB_HASH */
         } else {
           UDP_STATS_INC(udp.cachehit);
         }
@@ -283,7 +361,11 @@ udp_input(struct pbuf *p, struct netif *inp)
            if SOF_REUSEADDR is set on the first match */
         struct udp_pcb *mpcb;
         u8_t p_header_changed = 0;
+#if UDP_PCB_HASH
+        for (mpcb = udp_pcb_hash[UDP_PCB_HASH_INDEX(dest)]; mpcb != NULL; mpcb = mpcb->hash_next) {
+#else /* UDP_PCB_HASH */
         for (mpcb = udp_pcbs; mpcb != NULL; mpcb = mpcb->next) {
+#endif /* UDP_PCB_HASH */
           if (mpcb != pcb) {
             /* compare PCB local addr+port to UDP destination addr+port */
             if ((mpcb->local_port == dest) &&
@@ -302,7 +384,7 @@ udp_input(struct pbuf *p, struct netif *inp)
                 struct pbuf *q;
                 /* for that, move payload to IP header again */
                 if (p_header_changed == 0) {
-                  pbuf_header(p, (s16_t)((IPH_HL(iphdr) * 4) + UDP_HLEN));
+                  pbuf_header_force(p, (s16_t)((IPH_HL(iphdr) * 4) + UDP_HLEN));
                   p_header_changed = 1;
                 }
                 q = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
@@ -342,7 +424,7 @@ udp_input(struct pbuf *p, struct netif *inp)
       if (!broadcast &&
           !ip_addr_ismulticast(&current_iphdr_dest)) {
         /* move payload pointer back to ip header */
-        pbuf_header(p, (IPH_HL(iphdr) * 4) + UDP_HLEN);
+        pbuf_header_force(p, (IPH_HL(iphdr) * 4) + UDP_HLEN);
         LWIP_ASSERT("p->payload == iphdr", (p->payload == iphdr));
         icmp_dest_unreach(p, ICMP_DUR_PORT);
       }
@@ -770,6 +852,13 @@ udp_bind(struct udp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
       return ERR_USE;
     }
   }
+#if UDP_PCB_HASH
+  if ((rebind != 0) && (pcb->local_port != port)) {
+    /* rebound to another port: move to the new port's bucket */
+    udp_pcb_hash_remove(pcb);
+    rebind = 2;
+  }
+#endif /* UDP_PCB_HASH */
   pcb->local_port = port;
   snmp_insert_udpidx_tree(pcb);
   /* pcb not active yet? */
@@ -778,6 +867,13 @@ udp_bind(struct udp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
     pcb->next = udp_pcbs;
     udp_pcbs = pcb;
   }
+#if UDP_PCB_HASH
+  if (rebind == 0) {
+    udp_pcb_hash_add(pcb);
+  } else if (rebind == 2) {
+    udp_pcb_hash_add_rebound(pcb);
+  }
+#endif /* UDP_PCB_HASH */
   LWIP_DEBUGF(UDP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE,
               ("udp_bind: bound to %"U16_F".%"U16_F".%"U16_F".%"U16_F", port %"U16_F"\n",
                ip4_addr1_16(&pcb->local_ip), ip4_addr2_16(&pcb->local_ip),
@@ -852,6 +948,9 @@ udp_connect(struct udp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
   /* PCB not yet on the list, add PCB now */
   pcb->next = udp_pcbs;
   udp_pcbs = pcb;
+#if UDP_PCB_HASH
+  udp_pcb_hash_add(pcb);
+#endif /* UDP_PCB_HASH */
   return ERR_OK;
 }
 
@@ -901,6 +1000,9 @@ udp_remove(struct udp_pcb *pcb)
   struct udp_pcb *pcb2;
 
   snmp_delete_udpidx_tree(pcb);
+#if UDP_PCB_HASH
+  udp_pcb_hash_remove(pcb);
+#endif /* UDP_PCB_HASH */
   /* pcb to be removed is first in list? */
   if (udp_pcbs == pcb) {
     /* make list start at 2nd pcb */
@@ -59,9 +59,10 @@ extern "C" {
 #define NETCONN_DONTBLOCK 0x04
 
 /* Flags for struct netconn.flags (u8_t) */
-/** TCP: when data passed to netconn_write doesn't fit into the send buffer,
-    this temporarily stores whether to wake up the original application task
-    if data couldn't be sent in the first try. */
+/** TCP: when data passed to netconn_write doesn't fit into the send buffer
+    (or a close can't be finished at once), this temporarily stores whether
+    to wake up the original application task if the operation couldn't be
+    finished in the first try. */
 #define NETCONN_FLAG_WRITE_DELAYED            0x01
 /** Should this netconn avoid blocking? */
 #define NETCONN_FLAG_NON_BLOCKING             0x02
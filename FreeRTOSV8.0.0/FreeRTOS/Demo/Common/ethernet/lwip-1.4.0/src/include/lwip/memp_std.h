@@ -42,6 +42,9 @@ LWIP_MEMPOOL(UDP_PCB,        MEMP_NUM_UDP_PCB,         sizeof(struct udp_pcb),
 LWIP_MEMPOOL(TCP_PCB,        MEMP_NUM_TCP_PCB,         sizeof(struct tcp_pcb),        "TCP_PCB")
 LWIP_MEMPOOL(TCP_PCB_LISTEN, MEMP_NUM_TCP_PCB_LISTEN,  sizeof(struct tcp_pcb_listen), "TCP_PCB_LISTEN")
 LWIP_MEMPOOL(TCP_SEG,        MEMP_NUM_TCP_SEG,         sizeof(struct tcp_seg),        "TCP_SEG")
+#if LWIP_TCP_ZEROCOPY
+LWIP_MEMPOOL(TCP_ZC_REF,     MEMP_NUM_TCP_ZC_REF,      sizeof(struct tcp_zc_ref),     "TCP_ZC_REF")
+#endif /* LWIP_TCP_ZEROCOPY */
 #endif /* LWIP_TCP */
 
 #if IP_REASSEMBLY
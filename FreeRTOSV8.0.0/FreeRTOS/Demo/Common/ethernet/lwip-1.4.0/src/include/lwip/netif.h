@@ -56,6 +56,13 @@ extern "C" {
 /* Throughout this file, IP addresses are expected to be in
  * the same byte order as in IP_PCB. */
 
+/** Type of an ARP table index, as cached in the address hints */
+#if LWIP_ARP && (ARP_TABLE_SIZE > 0x7f)
+typedef u16_t netif_addr_idx_t;
+#else /* LWIP_ARP && (ARP_TABLE_SIZE > 0x7f) */
+typedef u8_t netif_addr_idx_t;
+#endif /* LWIP_ARP && (ARP_TABLE_SIZE > 0x7f) */
+
 /** must be the maximum of all used hardware address lengths
     across all types of interfaces in use */
 #define NETIF_MAX_HWADDR_LEN 6U
@@ -213,8 +220,12 @@ struct netif {
   netif_igmp_mac_filter_fn igmp_mac_filter;
 #endif /* LWIP_IGMP */
 #if LWIP_NETIF_HWADDRHINT
-  u8_t *addr_hint;
+  netif_addr_idx_t *addr_hint;
 #endif /* LWIP_NETIF_HWADDRHINT */
+#if LWIP_ARP
+  /** ARP table index of the last neighbour resolved on this netif */
+  netif_addr_idx_t arp_hint;
+#endif /* LWIP_ARP */
 #if ENABLE_LOOPBACK
   /* List of packets to be queued for ourselves. */
   struct pbuf *loop_first;
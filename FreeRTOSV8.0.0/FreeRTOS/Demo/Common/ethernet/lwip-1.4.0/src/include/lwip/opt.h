@@ -76,6 +76,27 @@
 #define NO_SYS_NO_TIMERS                0
 #endif
 
+/**
+ * SYS_TIMEOUT_WHEEL==1: Keep the sys_timeout() timeouts on a hashed timing
+ * wheel with one slot per millisecond instead of a sorted list, so that
+ * sys_timeout() and sys_untimeout() take constant time however many timeouts
+ * are pending. Timeouts are kept as absolute sys_now() times, so the port
+ * must provide sys_now() also when NO_SYS==0.
+ */
+#ifndef SYS_TIMEOUT_WHEEL
+#define SYS_TIMEOUT_WHEEL               0
+#endif
+
+/**
+ * SYS_TIMEOUT_WHEEL_SIZE: the number of slots in the timing wheel, and of
+ * buckets in the index used by sys_untimeout(). Must be a power of two.
+ * Timeouts further away than this many milliseconds are passed over once
+ * per revolution.
+ */
+#ifndef SYS_TIMEOUT_WHEEL_SIZE
+#define SYS_TIMEOUT_WHEEL_SIZE          256
+#endif
+
 /**
  * MEMCPY: override this if you have a faster implementation at hand than the
  * one included in your C library
@@ -267,6 +288,16 @@
 #define MEMP_NUM_TCP_SEG                16
 #endif
 
+/**
+ * MEMP_NUM_TCP_ZC_REF: the number of references into application buffers
+ * simultaneously queued by tcp_write_pbuf(): one per segment, plus one for
+ * each buffer boundary inside a segment.
+ * (requires the LWIP_TCP_ZEROCOPY option)
+ */
+#ifndef MEMP_NUM_TCP_ZC_REF
+#define MEMP_NUM_TCP_ZC_REF             MEMP_NUM_TCP_SEG
+#endif
+
 /**
  * MEMP_NUM_REASSDATA: the number of IP packets simultaneously queued for
  * reassembly (whole packets, not fragments!)
@@ -426,11 +457,30 @@
 
 /**
  * ARP_TABLE_SIZE: Number of active MAC-IP address pairs cached.
+ * At most 0x7fff; above 0x7f the address hints grow to 16 bits.
  */
 #ifndef ARP_TABLE_SIZE
 #define ARP_TABLE_SIZE                  10
 #endif
 
+/**
+ * ARP_TABLE_HASH==1: Index the ARP table by IP address and, when it is full,
+ * recycle the least recently used entry, so that neither a lookup nor adding
+ * an entry has to scan the whole table. Meant for large ARP_TABLE_SIZE.
+ * Costs ARP_TABLE_HASH_SIZE indices, plus three indices per entry.
+ */
+#ifndef ARP_TABLE_HASH
+#define ARP_TABLE_HASH                  0
+#endif
+
+/**
+ * ARP_TABLE_HASH_SIZE: the number of buckets in the ARP hash table. Must be
+ * a power of two. Around ARP_TABLE_SIZE keeps the chains short.
+ */
+#ifndef ARP_TABLE_HASH_SIZE
+#define ARP_TABLE_HASH_SIZE             64
+#endif
+
 /**
  * ARP_QUEUEING==1: Multiple outgoing packets are queued during hardware address
  * resolution. By default, only the most recent packet is queued per IP address.
@@ -865,6 +915,24 @@
 #define UDP_TTL                         (IP_DEFAULT_TTL)
 #endif
 
+/**
+ * UDP_PCB_HASH==1: Index the bound UDP pcbs by their local port, so that
+ * udp_input() only has to look at the pcbs that can match the destination
+ * port of a datagram instead of walking all of udp_pcbs.  Costs
+ * UDP_PCB_HASH_SIZE pointers, plus one pointer per pcb.
+ */
+#ifndef UDP_PCB_HASH
+#define UDP_PCB_HASH                    0
+#endif
+
+/**
+ * UDP_PCB_HASH_SIZE: the number of buckets in the UDP pcb hash table.
+ * Must be a power of two.
+ */
+#ifndef UDP_PCB_HASH_SIZE
+#define UDP_PCB_HASH_SIZE               16
+#endif
+
 /**
  * LWIP_NETBUF_RECVINFO==1: append destination addr and port to every netbuf.
  */
@@ -964,10 +1032,16 @@
  * TCP_SNDLOWAT: TCP writable space (bytes). This must be less than
  * TCP_SND_BUF. It is the amount of space which must be available in the
  * TCP snd_buf for select to return writable (combined with TCP_SNDQUEUELOWAT).
+ * tcp_sndbuf() never reports more than 0xffff, so with LWIP_WND_SCALE this
+ * must also stay well below 0xffff.
  */
 #ifndef TCP_SNDLOWAT
+#if LWIP_WND_SCALE
+#define TCP_SNDLOWAT                    LWIP_MIN((TCP_SND_BUF)/2, 0xffff - (4 * (TCP_MSS)) - 1)
+#else
 #define TCP_SNDLOWAT                    ((TCP_SND_BUF)/2)
 #endif
+#endif
 
 /**
  * TCP_SNDQUEUELOWAT: TCP writable bufs (pbuf count). This must be grater
@@ -1019,6 +1093,77 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * LWIP_WND_SCALE==1: support the TCP window scale option (RFC 7323), so that
+ * windows larger than 64KB can be used on links with a high bandwidth-delay
+ * product. TCP_WND and TCP_SND_BUF may then exceed 0xffff and the window
+ * fields of the pcb grow to 32 bits. Without the peer's agreement the
+ * receive window stays limited to 0xffff.
+ */
+#ifndef LWIP_WND_SCALE
+#define LWIP_WND_SCALE                  0
+#endif
+
+/**
+ * TCP_RCV_SCALE: the receive window shift count offered in the window scale
+ * option (0..14). TCP_WND must fit in (0xffff << TCP_RCV_SCALE).
+ */
+#ifndef TCP_RCV_SCALE
+#define TCP_RCV_SCALE                   0
+#endif
+
+/**
+ * LWIP_TCP_SACK==1: support selective acknowledgements (RFC 2018). The
+ * receiver reports the segments held on the out-of-sequence queue in SACK
+ * blocks, and the sender uses the blocks it receives to retransmit only the
+ * holes during fast recovery instead of waiting for a retransmission timeout.
+ * Needs TCP_QUEUE_OOSEQ.
+ */
+#ifndef LWIP_TCP_SACK
+#define LWIP_TCP_SACK                   0
+#endif
+
+/**
+ * LWIP_TCP_ZEROCOPY==1: Provide tcp_write_pbuf(), which queues the data of
+ * a pbuf chain for sending without copying it. The segments reference the
+ * application's pbufs, which therefore live until all of their data has been
+ * acknowledged (or the connection is gone): a custom pbuf (see
+ * pbuf_alloced_custom()) gets its free function called at that point, which
+ * makes a send-completion callback. Needs netifs that can send pbuf chains
+ * (scatter-gather), so LWIP_NETIF_TX_SINGLE_PBUF must be 0.
+ */
+#ifndef LWIP_TCP_ZEROCOPY
+#define LWIP_TCP_ZEROCOPY               0
+#endif
+
+/**
+ * TCP_PCB_HASH==1: Index the active and TIME-WAIT pcbs by their 4-tuple, and
+ * the listening pcbs by their local port, so that tcp_input() does not have
+ * to walk the pcb lists to demultiplex every incoming segment.  Costs
+ * 2 * TCP_PCB_HASH_SIZE + TCP_LISTEN_HASH_SIZE pointers, plus one pointer
+ * per pcb.
+ */
+#ifndef TCP_PCB_HASH
+#define TCP_PCB_HASH                    0
+#endif
+
+/**
+ * TCP_PCB_HASH_SIZE: the number of buckets in each of the active and
+ * TIME-WAIT pcb hash tables. Must be a power of two. Around
+ * MEMP_NUM_TCP_PCB keeps the chains short.
+ */
+#ifndef TCP_PCB_HASH_SIZE
+#define TCP_PCB_HASH_SIZE               64
+#endif
+
+/**
+ * TCP_LISTEN_HASH_SIZE: the number of buckets in the listening pcb hash
+ * table. Must be a power of two.
+ */
+#ifndef TCP_LISTEN_HASH_SIZE
+#define TCP_LISTEN_HASH_SIZE            16
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
@@ -1159,6 +1304,16 @@
 #define LWIP_NETIF_TX_SINGLE_PBUF             0
 #endif /* LWIP_NETIF_TX_SINGLE_PBUF */
 
+/**
+ * LWIP_NETIF_RXRING==1: Support receive descriptor rings (netif/rxring.c)
+ * for DMA-enabled MACs: the driver's receive buffers are passed up as custom
+ * pbufs and go back to the ring when freed, instead of being copied into
+ * PBUF_POOL pbufs.
+ */
+#ifndef LWIP_NETIF_RXRING
+#define LWIP_NETIF_RXRING                     0
+#endif
+
 /*
    ------------------------------------
    ---------- LOOPIF options ----------
@@ -1339,8 +1494,13 @@
    ----------------------------------------------
 */
 /**
- * LWIP_TCPIP_CORE_LOCKING: (EXPERIMENTAL!)
- * Don't use it if you're not an active lwIP project member
+ * LWIP_TCPIP_CORE_LOCKING==1: Run the netconn and socket API functions in
+ * the calling thread, holding a global core lock (a sys_mutex_t), instead of
+ * posting a message to tcpip_thread and waiting for it to be processed.
+ * Blocking connect, close and write release the lock while they wait.
+ * The port's sys_mutex_t should be a real mutex with priority inheritance
+ * (not LWIP_COMPAT_MUTEX), since tcpip_thread blocks on it while an
+ * application thread is in the core.
  */
 #ifndef LWIP_TCPIP_CORE_LOCKING
 #define LWIP_TCPIP_CORE_LOCKING         0
@@ -1443,6 +1603,33 @@
 #define SO_REUSE_RXTOALL                0
 #endif
 
+/**
+ * LWIP_SOCKET_POLL==1: Enable lwip_poll(). Unlike lwip_select(), it only
+ * looks at the sockets passed to it instead of every socket up to maxfdp1.
+ */
+#ifndef LWIP_SOCKET_POLL
+#define LWIP_SOCKET_POLL                0
+#endif
+
+/**
+ * LWIP_SOCKET_EPOLL==1: Enable lwip_epoll_create(), lwip_epoll_ctl() and
+ * lwip_epoll_wait(). Each epoll instance keeps a list of its ready sockets,
+ * updated by the socket events, so waiting costs only as much as the number
+ * of ready sockets. Level-triggered only; a socket can be registered with
+ * one epoll instance at a time.
+ */
+#ifndef LWIP_SOCKET_EPOLL
+#define LWIP_SOCKET_EPOLL               0
+#endif
+
+/**
+ * LWIP_SOCKET_EPOLL_NUM: the number of epoll instances that can be open at
+ * the same time. Their descriptors follow the socket descriptors.
+ */
+#ifndef LWIP_SOCKET_EPOLL_NUM
+#define LWIP_SOCKET_EPOLL_NUM           2
+#endif
+
 /*
    ----------------------------------------
    ---------- Statistics options ----------
@@ -301,6 +301,49 @@ typedef struct ip_mreq {
 
 #endif /* FD_SET */
 
+#if LWIP_SOCKET_POLL || LWIP_SOCKET_EPOLL
+/* Events for lwip_poll and lwip_epoll_wait */
+#ifndef POLLIN
+  #define POLLIN    0x01
+  #define POLLPRI   0x02  /* unused */
+  #define POLLOUT   0x04
+  #define POLLERR   0x08
+  #define POLLHUP   0x10  /* unused */
+  #define POLLNVAL  0x20
+
+  typedef unsigned int nfds_t;
+
+  struct pollfd {
+    int fd;
+    short events;
+    short revents;
+  };
+#endif /* POLLIN */
+#endif /* LWIP_SOCKET_POLL || LWIP_SOCKET_EPOLL */
+
+#if LWIP_SOCKET_EPOLL
+#ifndef EPOLLIN
+  #define EPOLLIN   POLLIN
+  #define EPOLLOUT  POLLOUT
+  #define EPOLLERR  POLLERR
+
+  #define EPOLL_CTL_ADD 1
+  #define EPOLL_CTL_DEL 2
+  #define EPOLL_CTL_MOD 3
+
+  typedef union epoll_data {
+    void *ptr;
+    int fd;
+    u32_t u32;
+  } epoll_data_t;
+
+  struct epoll_event {
+    u32_t events;
+    epoll_data_t data;
+  };
+#endif /* EPOLLIN */
+#endif /* LWIP_SOCKET_EPOLL */
+
 /** LWIP_TIMEVAL_PRIVATE: if you want to use the struct timeval provided
  * by your system, set this to 0 and include <sys/time.h> in cc.h */ 
 #ifndef LWIP_TIMEVAL_PRIVATE
@@ -339,6 +382,14 @@ int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptse
                 struct timeval *timeout);
 int lwip_ioctl(int s, long cmd, void *argp);
 int lwip_fcntl(int s, int cmd, int val);
+#if LWIP_SOCKET_POLL
+int lwip_poll(struct pollfd *fds, nfds_t nfds, int timeout);
+#endif /* LWIP_SOCKET_POLL */
+#if LWIP_SOCKET_EPOLL
+int lwip_epoll_create(int size);
+int lwip_epoll_ctl(int epfd, int op, int s, struct epoll_event *event);
+int lwip_epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+#endif /* LWIP_SOCKET_EPOLL */
 
 #if LWIP_COMPAT_SOCKETS
 #define accept(a,b,c)         lwip_accept(a,b,c)
@@ -358,6 +409,14 @@ int lwip_fcntl(int s, int cmd, int val);
 #define socket(a,b,c)         lwip_socket(a,b,c)
 #define select(a,b,c,d,e)     lwip_select(a,b,c,d,e)
 #define ioctlsocket(a,b,c)    lwip_ioctl(a,b,c)
+#if LWIP_SOCKET_POLL
+#define poll(a,b,c)           lwip_poll(a,b,c)
+#endif /* LWIP_SOCKET_POLL */
+#if LWIP_SOCKET_EPOLL
+#define epoll_create(a)       lwip_epoll_create(a)
+#define epoll_ctl(a,b,c,d)    lwip_epoll_ctl(a,b,c,d)
+#define epoll_wait(a,b,c,d)   lwip_epoll_wait(a,b,c,d)
+#endif /* LWIP_SOCKET_EPOLL */
 
 #if LWIP_POSIX_SOCKETS_IO_NAMES
 #define read(a,b,c)           lwip_read(a,b,c)
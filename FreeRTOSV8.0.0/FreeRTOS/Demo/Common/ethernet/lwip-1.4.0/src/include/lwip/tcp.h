@@ -151,11 +151,19 @@ enum tcp_state {
 #define DEF_ACCEPT_CALLBACK
 #endif /* LWIP_CALLBACK_API */
 
+#if TCP_PCB_HASH
+  /* next pcb in the same tcp_input() demultiplexing hash bucket */
+#define DEF_HASH_NEXT(type)  type *hash_next;
+#else /* TCP_PCB_HASH */
+#define DEF_HASH_NEXT(type)
+#endif /* TCP_PCB_HASH */
+
 /**
  * members common to struct tcp_pcb and struct tcp_listen_pcb
  */
 #define TCP_PCB_COMMON(type) \
   type *next; /* for the linked list */ \
+  DEF_HASH_NEXT(type) \
   enum tcp_state state; /* TCP state */ \
   u8_t prio; \
   void *callback_arg; \
@@ -165,6 +173,22 @@ enum tcp_state {
   u16_t local_port
 
 
+#if LWIP_WND_SCALE
+/* scaled windows need 32 bits */
+typedef u32_t tcpwnd_size_t;
+#define TCPWNDSIZE_F U32_F
+#else /* LWIP_WND_SCALE */
+typedef u16_t tcpwnd_size_t;
+#define TCPWNDSIZE_F U16_F
+#endif /* LWIP_WND_SCALE */
+
+#if LWIP_WND_SCALE || LWIP_TCP_SACK
+/* all 8 bits of the original flags are taken */
+typedef u16_t tcpflags_t;
+#else /* LWIP_WND_SCALE || LWIP_TCP_SACK */
+typedef u8_t tcpflags_t;
+#endif /* LWIP_WND_SCALE || LWIP_TCP_SACK */
+
 /* the TCP protocol control block */
 struct tcp_pcb {
 /** common PCB members */
@@ -175,22 +199,28 @@ struct tcp_pcb {
   /* ports are in host byte order */
   u16_t remote_port;
   
-  u8_t flags;
-#define TF_ACK_DELAY   ((u8_t)0x01U)   /* Delayed ACK. */
-#define TF_ACK_NOW     ((u8_t)0x02U)   /* Immediate ACK. */
-#define TF_INFR        ((u8_t)0x04U)   /* In fast recovery. */
-#define TF_TIMESTAMP   ((u8_t)0x08U)   /* Timestamp option enabled */
-#define TF_RXCLOSED    ((u8_t)0x10U)   /* rx closed by tcp_shutdown */
-#define TF_FIN         ((u8_t)0x20U)   /* Connection was closed locally (FIN segment enqueued). */
-#define TF_NODELAY     ((u8_t)0x40U)   /* Disable Nagle algorithm */
-#define TF_NAGLEMEMERR ((u8_t)0x80U)   /* nagle enabled, memerr, try to output to prevent delayed ACK to happen */
+  tcpflags_t flags;
+#define TF_ACK_DELAY   ((tcpflags_t)0x01U)   /* Delayed ACK. */
+#define TF_ACK_NOW     ((tcpflags_t)0x02U)   /* Immediate ACK. */
+#define TF_INFR        ((tcpflags_t)0x04U)   /* In fast recovery. */
+#define TF_TIMESTAMP   ((tcpflags_t)0x08U)   /* Timestamp option enabled */
+#define TF_RXCLOSED    ((tcpflags_t)0x10U)   /* rx closed by tcp_shutdown */
+#define TF_FIN         ((tcpflags_t)0x20U)   /* Connection was closed locally (FIN segment enqueued). */
+#define TF_NODELAY     ((tcpflags_t)0x40U)   /* Disable Nagle algorithm */
+#define TF_NAGLEMEMERR ((tcpflags_t)0x80U)   /* nagle enabled, memerr, try to output to prevent delayed ACK to happen */
+#if LWIP_WND_SCALE
+#define TF_WND_SCALE   ((tcpflags_t)0x0100U) /* Window scale option enabled */
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+#define TF_SACK        ((tcpflags_t)0x0200U) /* Selective ACK option enabled */
+#endif /* LWIP_TCP_SACK */
 
   /* the rest of the fields are in host byte order
      as we have to do some math with them */
   /* receiver variables */
   u32_t rcv_nxt;   /* next seqno expected */
-  u16_t rcv_wnd;   /* receiver window available */
-  u16_t rcv_ann_wnd; /* receiver window to announce */
+  tcpwnd_size_t rcv_wnd;   /* receiver window available */
+  tcpwnd_size_t rcv_ann_wnd; /* receiver window to announce */
   u32_t rcv_ann_right_edge; /* announced right edge of window */
 
   /* Timers */
@@ -215,19 +245,19 @@ struct tcp_pcb {
   u8_t dupacks;
   
   /* congestion avoidance/control variables */
-  u16_t cwnd;  
-  u16_t ssthresh;
+  tcpwnd_size_t cwnd;  
+  tcpwnd_size_t ssthresh;
 
   /* sender variables */
   u32_t snd_nxt;   /* next new seqno to be sent */
-  u16_t snd_wnd;   /* sender window */
+  tcpwnd_size_t snd_wnd;   /* sender window */
   u32_t snd_wl1, snd_wl2; /* Sequence and acknowledgement numbers of last
                              window update. */
   u32_t snd_lbb;       /* Sequence number of next byte to be buffered. */
 
-  u16_t acked;
+  tcpwnd_size_t acked;
   
-  u16_t snd_buf;   /* Available buffer space for sending (in bytes). */
+  tcpwnd_size_t snd_buf;   /* Available buffer space for sending (in bytes). */
 #define TCP_SNDQUEUELEN_OVERFLOW (0xffffU-3)
   u16_t snd_queuelen; /* Available buffer space for sending (in tcp_segs). */
 
@@ -263,6 +293,23 @@ struct tcp_pcb {
   u32_t ts_recent;
 #endif /* LWIP_TCP_TIMESTAMPS */
 
+#if LWIP_WND_SCALE
+  u8_t snd_scale;  /* shift count applied to windows received */
+  u8_t rcv_scale;  /* shift count applied to windows sent */
+#endif /* LWIP_WND_SCALE */
+
+#if LWIP_TCP_SACK
+  /* sender: fast recovery lasts until everything sent before it started
+     (up to 'recover') is acknowledged. Segments below sack_high that have
+     not been SACKed are holes, retransmitted once each from rexmit_high. */
+  u32_t recover;
+  u32_t sack_high;
+  u32_t rexmit_high;
+  /* receiver: the segment that arrived out of sequence last, reported in
+     the first SACK block */
+  u32_t sack_recent;
+#endif /* LWIP_TCP_SACK */
+
   /* idle time before KEEPALIVE is sent */
   u32_t keep_idle;
 #if LWIP_TCP_KEEPALIVE
@@ -321,7 +368,7 @@ void             tcp_poll    (struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interv
 void             tcp_err     (struct tcp_pcb *pcb, tcp_err_fn err);
 
 #define          tcp_mss(pcb)             (((pcb)->flags & TF_TIMESTAMP) ? ((pcb)->mss - 12)  : (pcb)->mss)
-#define          tcp_sndbuf(pcb)          ((pcb)->snd_buf)
+#define          tcp_sndbuf(pcb)          ((u16_t)LWIP_MIN((pcb)->snd_buf, 0xffff))
 #define          tcp_sndqueuelen(pcb)     ((pcb)->snd_queuelen)
 #define          tcp_nagle_disable(pcb)   ((pcb)->flags |= TF_NODELAY)
 #define          tcp_nagle_enable(pcb)    ((pcb)->flags &= ~TF_NODELAY)
@@ -355,6 +402,9 @@ err_t            tcp_shutdown(struct tcp_pcb *pcb, int shut_rx, int shut_tx);
 
 err_t            tcp_write   (struct tcp_pcb *pcb, const void *dataptr, u16_t len,
                               u8_t apiflags);
+#if LWIP_TCP_ZEROCOPY
+err_t            tcp_write_pbuf(struct tcp_pcb *pcb, struct pbuf *p, u8_t apiflags);
+#endif /* LWIP_TCP_ZEROCOPY */
 
 void             tcp_setprio (struct tcp_pcb *pcb, u8_t prio);
 
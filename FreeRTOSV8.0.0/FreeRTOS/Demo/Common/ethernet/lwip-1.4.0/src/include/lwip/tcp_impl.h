@@ -70,7 +70,11 @@ err_t            tcp_send_empty_ack(struct tcp_pcb *pcb);
 void             tcp_rexmit  (struct tcp_pcb *pcb);
 void             tcp_rexmit_rto  (struct tcp_pcb *pcb);
 void             tcp_rexmit_fast (struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+u8_t             tcp_rexmit_hole (struct tcp_pcb *pcb, u8_t partial_ack);
+#endif /* LWIP_TCP_SACK */
 u32_t            tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb);
+err_t            tcp_process_refused_data(struct tcp_pcb *pcb);
 
 /**
  * This is the Nagle algorithm: try to combine user data to send as few TCP
@@ -293,12 +297,48 @@ struct tcp_seg {
 #define TF_SEG_OPTS_TS          (u8_t)0x02U /* Include timestamp option. */
 #define TF_SEG_DATA_CHECKSUMMED (u8_t)0x04U /* ALL data (not the header) is
                                                checksummed into 'chksum' */
+#define TF_SEG_OPTS_WND_SCALE   (u8_t)0x08U /* Include window scale option. */
+#define TF_SEG_OPTS_SACK_PERM   (u8_t)0x10U /* Include SACK permitted option. */
+#define TF_SEG_SACKED           (u8_t)0x20U /* Unacked segment SACKed by the
+                                               receiver */
   struct tcp_hdr *tcphdr;  /* the TCP header */
 };
 
+#if LWIP_TCP_ZEROCOPY
+/** A pbuf describing part of a pbuf passed to tcp_write_pbuf(). It holds a
+ * reference on that pbuf until the segment it belongs to is freed. */
+struct tcp_zc_ref {
+  struct pbuf_custom pc;
+  struct pbuf *original;
+};
+#endif /* LWIP_TCP_ZEROCOPY */
+
 #define LWIP_TCP_OPT_LENGTH(flags)              \
   (flags & TF_SEG_OPTS_MSS ? 4  : 0) +          \
-  (flags & TF_SEG_OPTS_TS  ? 12 : 0)
+  (flags & TF_SEG_OPTS_TS  ? 12 : 0) +          \
+  (flags & TF_SEG_OPTS_WND_SCALE ? 4 : 0) +     \
+  (flags & TF_SEG_OPTS_SACK_PERM ? 4 : 0)
+
+#if LWIP_WND_SCALE
+/* Windows are sent shifted right by rcv_scale and received shifted left by
+   snd_scale, except in SYN segments, whose window is never scaled. */
+#define RCV_WND_SCALE(pcb, wnd) (((wnd) >> (pcb)->rcv_scale))
+#define SND_WND_SCALE(pcb, wnd) (((tcpwnd_size_t)(wnd) << (pcb)->snd_scale))
+#define TCPWND16(x)             ((u16_t)LWIP_MIN((x), 0xFFFF))
+/* Without the peer's agreement to scale, our window must fit in 16 bits */
+#define TCP_WND_MAX(pcb)        ((tcpwnd_size_t)(((pcb)->flags & TF_WND_SCALE) ? TCP_WND : TCPWND16(TCP_WND)))
+#else /* LWIP_WND_SCALE */
+#define RCV_WND_SCALE(pcb, wnd) (wnd)
+#define SND_WND_SCALE(pcb, wnd) (wnd)
+#define TCPWND16(x)             (x)
+#define TCP_WND_MAX(pcb)        TCP_WND
+#endif /* LWIP_WND_SCALE */
+
+#if LWIP_TCP_SACK
+/* Room for SACK blocks in an ACK: 40 bytes of options less the timestamp,
+   less 2 NOPs, the kind and the length, 8 bytes per block */
+#define TCP_SACK_MAX_BLOCKS(pcb)  (((pcb)->flags & TF_TIMESTAMP) ? 3 : 4)
+#endif /* LWIP_TCP_SACK */
 
 /** This returns a TCP header option for MSS in an u32_t */
 #define TCP_BUILD_MSS_OPTION(x) (x) = PP_HTONL(((u32_t)2 << 24) |          \
@@ -324,6 +364,23 @@ extern struct tcp_pcb *tcp_tw_pcbs;      /* List of all TCP PCBs in TIME-WAIT. *
 
 extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
 
+#if TCP_PCB_HASH
+/* Hash indexes over the lists above, kept in sync by TCP_REG and TCP_RMV:
+   active and TIME-WAIT PCBs are indexed by their 4-tuple, LISTENing PCBs
+   by their local port. PCBs in tcp_bound_pcbs are not indexed. */
+void tcp_pcb_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *npcb);
+void tcp_pcb_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *npcb);
+struct tcp_pcb *tcp_pcb_hash_lookup(struct tcp_pcb **pcbs,
+       ip_addr_t *remote_ip, u16_t remote_port,
+       ip_addr_t *local_ip, u16_t local_port);
+struct tcp_pcb_listen *tcp_listen_hash_lookup(ip_addr_t *local_ip, u16_t local_port);
+#define TCP_HASH_ADD(pcbs, npcb) tcp_pcb_hash_add((pcbs), (npcb))
+#define TCP_HASH_RMV(pcbs, npcb) tcp_pcb_hash_remove((pcbs), (npcb))
+#else /* TCP_PCB_HASH */
+#define TCP_HASH_ADD(pcbs, npcb)
+#define TCP_HASH_RMV(pcbs, npcb)
+#endif /* TCP_PCB_HASH */
+
 /* Axioms about the above lists:   
    1) Every TCP PCB that is not CLOSED is in one of the lists.
    2) A PCB is only in one of the lists.
@@ -347,6 +404,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                             (npcb)->next = *(pcbs); \
                             LWIP_ASSERT("TCP_REG: npcb->next != npcb", (npcb)->next != (npcb)); \
                             *(pcbs) = (npcb); \
+                            TCP_HASH_ADD(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
               tcp_timer_needed(); \
                             } while(0)
@@ -362,6 +420,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                                } \
                             } \
                             (npcb)->next = NULL; \
+                            TCP_HASH_RMV(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
                             LWIP_DEBUGF(TCP_DEBUG, ("TCP_RMV: removed %p from %p\n", (npcb), *(pcbs))); \
                             } while(0)
@@ -372,6 +431,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
   do {                                             \
     (npcb)->next = *pcbs;                          \
     *(pcbs) = (npcb);                              \
+    TCP_HASH_ADD(pcbs, npcb);                      \
     tcp_timer_needed();                            \
   } while (0)
 
@@ -391,6 +451,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
       }                                            \
     }                                              \
     (npcb)->next = NULL;                           \
+    TCP_HASH_RMV(pcbs, npcb);                      \
   } while(0)
 
 #endif /* LWIP_DEBUG */
@@ -64,6 +64,14 @@ typedef void (* sys_timeout_handler)(void *arg);
 
 struct sys_timeo {
   struct sys_timeo *next;
+#if SYS_TIMEOUT_WHEEL
+  /** previous timeout in the same wheel slot (the head points to the tail) */
+  struct sys_timeo *prev;
+  /** next timeout in the same sys_untimeout() index bucket */
+  struct sys_timeo *hash_next;
+#endif /* SYS_TIMEOUT_WHEEL */
+  /** time left after the previous timeout, or the sys_now() time at which
+      this one is due with SYS_TIMEOUT_WHEEL */
   u32_t time;
   sys_timeout_handler h;
   void *arg;
@@ -95,6 +95,13 @@ struct udp_pcb {
 /* Protocol specific PCB members */
 
   struct udp_pcb *next;
+#if UDP_PCB_HASH
+  /** next pcb in the same udp_pcb_hash bucket */
+  struct udp_pcb *hash_next;
+  /** when the pcb was last moved to the front of udp_pcbs, had the list
+      been walked instead of the hash table */
+  u32_t hash_stamp;
+#endif /* UDP_PCB_HASH */
 
   u8_t flags;
   /** ports are in host byte order */
@@ -178,9 +178,13 @@ struct etharp_q_entry {
 };
 #endif /* ARP_QUEUEING */
 
+#if ARP_TABLE_HASH
+void etharp_init(void);
+#else /* ARP_TABLE_HASH */
 #define etharp_init() /* Compatibility define, not init needed. */
+#endif /* ARP_TABLE_HASH */
 void etharp_tmr(void);
-s8_t etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
+s16_t etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
          struct eth_addr **eth_ret, ip_addr_t **ip_ret);
 err_t etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr);
 err_t etharp_query(struct netif *netif, ip_addr_t *ipaddr, struct pbuf *q);
@@ -0,0 +1,125 @@
+/*
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+#ifndef __NETIF_RXRING_H__
+#define __NETIF_RXRING_H__
+
+#include "lwip/opt.h"
+
+#if LWIP_NETIF_RXRING /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rxring;
+
+/** One receive buffer. Passed up to the stack as a custom pbuf that
+ * refers to mem, it goes back to its ring when that pbuf is freed. */
+struct rxring_buf {
+  /** must be first: the pbuf handed to the stack */
+  struct pbuf_custom pc;
+  struct rxring *ring;
+  /** next buffer on the ring's free list */
+  struct rxring_buf *next;
+  /** buffer memory (ring->buf_size bytes), the MAC writes frames to
+   * mem + ETH_PAD_SIZE */
+  u8_t *mem;
+};
+
+/** Arm descriptor 'desc' to receive a frame into the 'len' bytes at 'mem' */
+typedef void (*rxring_post_fn)(struct rxring *ring, u16_t desc, u8_t *mem, u16_t len);
+/** Tell the MAC that 'count' descriptors have been armed, starting at
+ * 'first' (e.g. write the tail pointer register). May be NULL. */
+typedef void (*rxring_kick_fn)(struct rxring *ring, u16_t first, u16_t count);
+/** Called from pbuf_free() (i.e. from any thread) when a buffer comes back
+ * to a ring that had none armed, e.g. to wake the receive task. May be NULL. */
+typedef void (*rxring_wake_fn)(struct rxring *ring);
+
+/**
+ * A receive descriptor ring. The descriptors between tail and head are
+ * empty, all others are armed and owned by the MAC, which fills them in
+ * order starting at head.
+ */
+struct rxring {
+  /** buffer armed in each descriptor, NULL if the descriptor is empty */
+  struct rxring_buf **desc;
+  u16_t size;
+  /** next descriptor the MAC fills */
+  u16_t head;
+  /** next empty descriptor to arm */
+  u16_t tail;
+  /** number of armed descriptors */
+  u16_t armed;
+  u16_t buf_size;
+  /** descriptors are only re-armed in groups of at least this many */
+  u16_t refill_batch;
+  /** frames are copied into PBUF_POOL pbufs rather than passed up while
+   * no more than this many descriptors are armed, so that buffers held by
+   * the stack cannot starve the ring */
+  u16_t low_water;
+  /** buffers not armed nor held by the stack; also touched by pbuf_free() */
+  struct rxring_buf *free;
+  u16_t free_count;
+
+  rxring_post_fn post;
+  rxring_kick_fn kick;
+  rxring_wake_fn wake;
+  /** for the driver */
+  void *state;
+
+  /** frames passed up without copying */
+  u32_t passed;
+  /** frames copied because the ring was low on buffers */
+  u32_t copied;
+  /** frames dropped, the buffer was re-armed */
+  u32_t dropped;
+  /** calls to kick */
+  u32_t kicks;
+  /** refills that found fewer free buffers than empty descriptors */
+  u32_t starved;
+};
+
+void rxring_init(struct rxring *ring, struct rxring_buf **desc, u16_t size,
+                 struct rxring_buf *bufs, u8_t *mem, u16_t num_bufs, u16_t buf_size,
+                 rxring_post_fn post, rxring_kick_fn kick, void *state);
+u16_t rxring_refill(struct rxring *ring, u8_t force);
+struct pbuf *rxring_input(struct rxring *ring, u16_t len);
+void rxring_skip(struct rxring *ring);
+
+/** The buffer memory armed in descriptor 'idx', or NULL if it is empty */
+#define rxring_desc_mem(ring, idx) \
+  (((ring)->desc[idx] != NULL) ? ((ring)->desc[idx]->mem + ETH_PAD_SIZE) : NULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_NETIF_RXRING */
+
+#endif /* __NETIF_RXRING_H__ */
@@ -107,13 +107,27 @@ struct etharp_entry {
 #if ETHARP_SUPPORT_STATIC_ENTRIES
   u8_t static_entry;
 #endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
+#if ARP_TABLE_HASH
+  /** next entry in the same hash bucket, or on the free list */
+  netif_addr_idx_t next;
+  /** more and less recently used neighbours on the LRU list */
+  netif_addr_idx_t lru_prev, lru_next;
+#endif /* ARP_TABLE_HASH */
 };
 
 static struct etharp_entry arp_table[ARP_TABLE_SIZE];
 
-#if !LWIP_NETIF_HWADDRHINT
-static u8_t etharp_cached_entry;
-#endif /* !LWIP_NETIF_HWADDRHINT */
+#if ARP_TABLE_HASH
+/** Terminates the index lists threaded through arp_table */
+#define ARP_NONE ARP_TABLE_SIZE
+
+/** Hash table over the used entries of arp_table, indexed by IP address */
+static netif_addr_idx_t arp_hash[ARP_TABLE_HASH_SIZE];
+/** List of the unused entries of arp_table */
+static netif_addr_idx_t arp_free;
+/** List of the used entries of arp_table, most recently used first */
+static netif_addr_idx_t arp_lru_first, arp_lru_last;
+#endif /* ARP_TABLE_HASH */
 
 /** Try hard to create a new entry - we want the IP address to appear in
     the cache (even if this means removing an active entry or so). */
@@ -122,20 +136,91 @@ static u8_t etharp_cached_entry;
 #define ETHARP_FLAG_STATIC_ENTRY 4
 
 #if LWIP_NETIF_HWADDRHINT
-#define ETHARP_SET_HINT(netif, hint)  if (((netif) != NULL) && ((netif)->addr_hint != NULL))  \
-                                      *((netif)->addr_hint) = (hint);
+#define ETHARP_SET_HINT(netif, hint)  do { if ((netif)->addr_hint != NULL) { \
+                                        *((netif)->addr_hint) = (hint); }     \
+                                      (netif)->arp_hint = (hint); } while(0)
 #else /* LWIP_NETIF_HWADDRHINT */
-#define ETHARP_SET_HINT(netif, hint)  (etharp_cached_entry = (hint))
+#define ETHARP_SET_HINT(netif, hint)  ((netif)->arp_hint = (hint))
 #endif /* LWIP_NETIF_HWADDRHINT */
 
+#if ARP_TABLE_HASH
+#define ETHARP_LRU_TOUCH(i)  do { if (arp_lru_first != (i)) { \
+                               etharp_lru_unlink(i);           \
+                               etharp_lru_push(i); } } while(0)
+#else /* ARP_TABLE_HASH */
+#define ETHARP_LRU_TOUCH(i)
+#endif /* ARP_TABLE_HASH */
+
 static err_t update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth_addr *ethaddr, u8_t flags);
 
 
 /* Some checks, instead of etharp_init(): */
-#if (LWIP_ARP && (ARP_TABLE_SIZE > 0x7f))
-  #error "ARP_TABLE_SIZE must fit in an s8_t, you have to reduce it in your lwipopts.h"
+#if (LWIP_ARP && (ARP_TABLE_SIZE > 0x7fff))
+  #error "ARP_TABLE_SIZE must fit in an s16_t, you have to reduce it in your lwipopts.h"
 #endif
 
+#if ARP_TABLE_HASH
+/**
+ * Initialize the ARP table: all entries unused, all hash buckets empty.
+ */
+void
+etharp_init(void)
+{
+  u16_t i;
+
+  for (i = 0; i < ARP_TABLE_HASH_SIZE; ++i) {
+    arp_hash[i] = ARP_NONE;
+  }
+  for (i = 0; i < ARP_TABLE_SIZE; ++i) {
+    arp_table[i].state = ETHARP_STATE_EMPTY;
+    arp_table[i].next = (netif_addr_idx_t)(i + 1);
+  }
+  arp_free = 0;
+  arp_lru_first = ARP_NONE;
+  arp_lru_last = ARP_NONE;
+}
+
+/** Hash an IP address to its bucket in arp_hash. Hosts on the same subnet
+ * differ in the low order bits, which are kept as they are. */
+static u16_t
+etharp_hash_index(ip_addr_t *ipaddr)
+{
+  u32_t addr = ntohl(ip4_addr_get_u32(ipaddr));
+
+  return (u16_t)((addr ^ (addr >> 16)) & (ARP_TABLE_HASH_SIZE - 1));
+}
+
+/** Take an entry off the LRU list */
+static void
+etharp_lru_unlink(netif_addr_idx_t i)
+{
+  if (arp_table[i].lru_prev != ARP_NONE) {
+    arp_table[arp_table[i].lru_prev].lru_next = arp_table[i].lru_next;
+  } else {
+    arp_lru_first = arp_table[i].lru_next;
+  }
+  if (arp_table[i].lru_next != ARP_NONE) {
+    arp_table[arp_table[i].lru_next].lru_prev = arp_table[i].lru_prev;
+  } else {
+    arp_lru_last = arp_table[i].lru_prev;
+  }
+}
+
+/** Put an entry at the front of the LRU list */
+static void
+etharp_lru_push(netif_addr_idx_t i)
+{
+  arp_table[i].lru_prev = ARP_NONE;
+  arp_table[i].lru_next = arp_lru_first;
+  if (arp_lru_first != ARP_NONE) {
+    arp_table[arp_lru_first].lru_prev = i;
+  } else {
+    arp_lru_last = i;
+  }
+  arp_lru_first = i;
+}
+#endif /* ARP_TABLE_HASH */
+
 
 #if ARP_QUEUEING
 /**
@@ -177,6 +262,20 @@ free_entry(int i)
     free_etharp_q(arp_table[i].q);
     arp_table[i].q = NULL;
   }
+#if ARP_TABLE_HASH
+  {
+    /* unlink from its hash chain and the LRU list, put on the free list */
+    netif_addr_idx_t *pi = &arp_hash[etharp_hash_index(&arp_table[i].ipaddr)];
+    while (*pi != i) {
+      LWIP_ASSERT("entry not in its hash chain", *pi != ARP_NONE);
+      pi = &arp_table[*pi].next;
+    }
+    *pi = arp_table[i].next;
+    etharp_lru_unlink((netif_addr_idx_t)i);
+    arp_table[i].next = arp_free;
+    arp_free = (netif_addr_idx_t)i;
+  }
+#endif /* ARP_TABLE_HASH */
   /* recycle entry for re-use */      
   arp_table[i].state = ETHARP_STATE_EMPTY;
 #if ETHARP_SUPPORT_STATIC_ENTRIES
@@ -202,7 +301,7 @@ free_entry(int i)
 void
 etharp_tmr(void)
 {
-  u8_t i;
+  u16_t i;
 
   LWIP_DEBUGF(ETHARP_DEBUG, ("etharp_timer\n"));
   /* remove expired entries from the ARP table */
@@ -246,6 +345,8 @@ etharp_tmr(void)
  * In all cases, attempt to create new entries from an empty entry. If no
  * empty entries are available and ETHARP_FLAG_TRY_HARD flag is set, recycle
  * old entries. Heuristic choose the least important entry for recycling.
+ * With ARP_TABLE_HASH, 'old' means least recently used rather than least
+ * recently updated.
  *
  * @param ipaddr IP address to find in ARP cache, or to add if not found.
  * @param flags @see definition of ETHARP_FLAG_*
@@ -254,14 +355,101 @@ etharp_tmr(void)
  * @return The ARP entry index that matched or is created, ERR_MEM if no
  * entry is found or could be recycled.
  */
-static s8_t
+#if ARP_TABLE_HASH
+static s16_t
 find_entry(ip_addr_t *ipaddr, u8_t flags)
 {
-  s8_t old_pending = ARP_TABLE_SIZE, old_stable = ARP_TABLE_SIZE;
-  s8_t empty = ARP_TABLE_SIZE;
-  u8_t i = 0, age_pending = 0, age_stable = 0;
+  netif_addr_idx_t i, old_pending = ARP_NONE, old_queue = ARP_NONE;
+  u16_t index;
+
+  /* a) search the hash chain of the address */
+  if (ipaddr != NULL) {
+    for (i = arp_hash[etharp_hash_index(ipaddr)]; i != ARP_NONE; i = arp_table[i].next) {
+      if (ip_addr_cmp(ipaddr, &arp_table[i].ipaddr)) {
+        LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: found matching entry %"U16_F"\n", (u16_t)i));
+        if ((flags & ETHARP_FLAG_FIND_ONLY) == 0) {
+          ETHARP_LRU_TOUCH(i);
+        }
+        return (s16_t)i;
+      }
+    }
+  }
+  /* { we have no match } => try to create a new entry */
+
+  /* don't create new entry, only search? */
+  if (((flags & ETHARP_FLAG_FIND_ONLY) != 0) ||
+      /* or no empty entry found and not allowed to recycle? */
+      ((arp_free == ARP_NONE) && ((flags & ETHARP_FLAG_TRY_HARD) == 0))) {
+    LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: no empty entry found and not allowed to recycle\n"));
+    return (s16_t)ERR_MEM;
+  }
+
+  /* b) no empty entry left, choose the least destructive one to recycle:
+   * 1) least recently used stable entry
+   * 2) least recently used pending entry without queued packets
+   * 3) least recently used pending entry with queued packets
+   */
+  if (arp_free == ARP_NONE) {
+    for (i = arp_lru_last; i != ARP_NONE; i = arp_table[i].lru_prev) {
+      if (arp_table[i].state == ETHARP_STATE_STABLE) {
+#if ETHARP_SUPPORT_STATIC_ENTRIES
+        /* static entries are never recycled */
+        if (arp_table[i].static_entry == 0)
+#endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
+        {
+          break;
+        }
+      } else if (arp_table[i].q == NULL) {
+        if (old_pending == ARP_NONE) {
+          old_pending = i;
+        }
+      } else if (old_queue == ARP_NONE) {
+        old_queue = i;
+      }
+    }
+    if (i == ARP_NONE) {
+      i = (old_pending != ARP_NONE) ? old_pending : old_queue;
+    }
+    if (i == ARP_NONE) {
+      LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: no empty or recyclable entries found\n"));
+      return (s16_t)ERR_MEM;
+    }
+    LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: recycling entry %"U16_F"\n", (u16_t)i));
+    /* queued packets are freed in free_entry, which puts i on the free list */
+    free_entry(i);
+  }
+
+  /* c) create the new entry from the first empty one */
+  i = arp_free;
+  arp_free = arp_table[i].next;
+  LWIP_ASSERT("arp_table[i].state == ETHARP_STATE_EMPTY",
+    arp_table[i].state == ETHARP_STATE_EMPTY);
+
+  /* IP address given? */
+  if (ipaddr != NULL) {
+    /* set IP address */
+    ip_addr_copy(arp_table[i].ipaddr, *ipaddr);
+  }
+  index = etharp_hash_index(&arp_table[i].ipaddr);
+  arp_table[i].next = arp_hash[index];
+  arp_hash[index] = i;
+  etharp_lru_push(i);
+  arp_table[i].ctime = 0;
+#if ETHARP_SUPPORT_STATIC_ENTRIES
+  arp_table[i].static_entry = 0;
+#endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
+  return (s16_t)i;
+}
+#else /* ARP_TABLE_HASH */
+static s16_t
+find_entry(ip_addr_t *ipaddr, u8_t flags)
+{
+  s16_t old_pending = ARP_TABLE_SIZE, old_stable = ARP_TABLE_SIZE;
+  s16_t empty = ARP_TABLE_SIZE;
+  u16_t i = 0;
+  u8_t age_pending = 0, age_stable = 0;
   /* oldest entry with packets on queue */
-  s8_t old_queue = ARP_TABLE_SIZE;
+  s16_t old_queue = ARP_TABLE_SIZE;
   /* its age */
   u8_t age_queue = 0;
 
@@ -335,7 +523,7 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
       /* or no empty entry found and not allowed to recycle? */
       ((empty == ARP_TABLE_SIZE) && ((flags & ETHARP_FLAG_TRY_HARD) == 0))) {
     LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: no empty entry found and not allowed to recycle\n"));
-    return (s8_t)ERR_MEM;
+    return (s16_t)ERR_MEM;
   }
   
   /* b) choose the least destructive entry to recycle:
@@ -372,7 +560,7 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
       /* no empty or recyclable entries found */
     } else {
       LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: no empty or recyclable entries found\n"));
-      return (s8_t)ERR_MEM;
+      return (s16_t)ERR_MEM;
     }
 
     /* { empty or recyclable entry found } */
@@ -393,8 +581,9 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
 #if ETHARP_SUPPORT_STATIC_ENTRIES
   arp_table[i].static_entry = 0;
 #endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
-  return (err_t)i;
+  return (s16_t)i;
 }
+#endif /* ARP_TABLE_HASH */
 
 /**
  * Send an IP packet on the network using netif->linkoutput
@@ -442,7 +631,7 @@ etharp_send_ip(struct netif *netif, struct pbuf *p, struct eth_addr *src, struct
 static err_t
 update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth_addr *ethaddr, u8_t flags)
 {
-  s8_t i;
+  s16_t i;
   LWIP_ASSERT("netif->hwaddr_len == ETHARP_HWADDR_LEN", netif->hwaddr_len == ETHARP_HWADDR_LEN);
   LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("update_arp_entry: %"U16_F".%"U16_F".%"U16_F".%"U16_F" - %02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F":%02"X16_F"\n",
     ip4_addr1_16(ipaddr), ip4_addr2_16(ipaddr), ip4_addr3_16(ipaddr), ip4_addr4_16(ipaddr),
@@ -546,7 +735,7 @@ etharp_add_static_entry(ip_addr_t *ipaddr, struct eth_addr *ethaddr)
 err_t
 etharp_remove_static_entry(ip_addr_t *ipaddr)
 {
-  s8_t i;
+  s16_t i;
   LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("etharp_remove_static_entry: %"U16_F".%"U16_F".%"U16_F".%"U16_F"\n",
     ip4_addr1_16(ipaddr), ip4_addr2_16(ipaddr), ip4_addr3_16(ipaddr), ip4_addr4_16(ipaddr)));
 
@@ -579,11 +768,11 @@ etharp_remove_static_entry(ip_addr_t *ipaddr)
  * @param ip_ret points to return pointer
  * @return table index if found, -1 otherwise
  */
-s8_t
+s16_t
 etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
          struct eth_addr **eth_ret, ip_addr_t **ip_ret)
 {
-  s8_t i;
+  s16_t i;
 
   LWIP_ASSERT("eth_ret != NULL && ip_ret != NULL",
     eth_ret != NULL && ip_ret != NULL);
@@ -893,23 +1082,25 @@ etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr)
         }
       }
     }
+    {
+      /* entry last used on this netif */
+      netif_addr_idx_t etharp_cached_entry = netif->arp_hint;
 #if LWIP_NETIF_HWADDRHINT
-    if (netif->addr_hint != NULL) {
-      /* per-pcb cached entry was given */
-      u8_t etharp_cached_entry = *(netif->addr_hint);
-      if (etharp_cached_entry < ARP_TABLE_SIZE) {
+      if (netif->addr_hint != NULL) {
+        /* per-pcb cached entry was given */
+        etharp_cached_entry = *(netif->addr_hint);
+      }
 #endif /* LWIP_NETIF_HWADDRHINT */
-        if ((arp_table[etharp_cached_entry].state == ETHARP_STATE_STABLE) &&
-            (ip_addr_cmp(ipaddr, &arp_table[etharp_cached_entry].ipaddr))) {
-          /* the per-pcb-cached entry is stable and the right one! */
-          ETHARP_STATS_INC(etharp.cachehit);
-          return etharp_send_ip(netif, q, (struct eth_addr*)(netif->hwaddr),
-            &arp_table[etharp_cached_entry].ethaddr);
-        }
-#if LWIP_NETIF_HWADDRHINT
+      if ((etharp_cached_entry < ARP_TABLE_SIZE) &&
+          (arp_table[etharp_cached_entry].state == ETHARP_STATE_STABLE) &&
+          (ip_addr_cmp(ipaddr, &arp_table[etharp_cached_entry].ipaddr))) {
+        /* the cached entry is stable and the right one! */
+        ETHARP_STATS_INC(etharp.cachehit);
+        ETHARP_LRU_TOUCH(etharp_cached_entry);
+        return etharp_send_ip(netif, q, (struct eth_addr*)(netif->hwaddr),
+          &arp_table[etharp_cached_entry].ethaddr);
       }
     }
-#endif /* LWIP_NETIF_HWADDRHINT */
     /* queue on destination Ethernet address belonging to ipaddr */
     return etharp_query(netif, ipaddr, q);
   }
@@ -958,7 +1149,7 @@ etharp_query(struct netif *netif, ip_addr_t *ipaddr, struct pbuf *q)
 {
   struct eth_addr * srcaddr = (struct eth_addr *)netif->hwaddr;
   err_t result = ERR_MEM;
-  s8_t i; /* ARP entry index */
+  s16_t i; /* ARP entry index */
 
   /* non-unicast address? */
   if (ip_addr_isbroadcast(ipaddr, netif) ||
@@ -1011,7 +1202,7 @@ etharp_query(struct netif *netif, ip_addr_t *ipaddr, struct pbuf *q)
   /* stable entry? */
   if (arp_table[i].state == ETHARP_STATE_STABLE) {
     /* we have a valid IP->Ethernet address mapping */
-    ETHARP_SET_HINT(netif, i);
+    ETHARP_SET_HINT(netif, (netif_addr_idx_t)i);
     /* send the packet */
     result = etharp_send_ip(netif, q, srcaddr, &(arp_table[i].ethaddr));
   /* pending entry? (either just created or already pending */
@@ -191,7 +191,9 @@ low_level_input(struct netif *netif)
        * This does not necessarily have to be a memcpy, you can also preallocate
        * pbufs for a DMA-enabled MAC and after receiving truncate it to the
        * actually received size. In this case, ensure the tot_len member of the
-       * pbuf is the sum of the chained pbuf len members.
+       * pbuf is the sum of the chained pbuf len members. For a MAC with
+       * a receive descriptor ring, netif/rxring.c passes the ring buffers
+       * up as custom pbufs instead of this function.
        */
       read data into(q->payload, q->len);
     }
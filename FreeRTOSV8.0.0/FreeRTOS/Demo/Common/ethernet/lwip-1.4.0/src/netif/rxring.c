@@ -0,0 +1,274 @@
+/**
+ * @file
+ * Receive descriptor rings for DMA-enabled MACs
+ *
+ * The MAC receives frames straight into buffers owned by the ring. A
+ * received frame is passed up as a custom pbuf (see pbuf_alloced_custom())
+ * referring to its buffer, and the buffer goes back to the ring's free list
+ * when the stack frees that pbuf, so frames are never copied on the way in.
+ *
+ * Empty descriptors are re-armed in batches (refill_batch), so that the MAC
+ * is kicked once per batch rather than once per frame. Buffers held by the
+ * stack (e.g. in the TCP out-of-sequence queue or an application's receive
+ * mailbox) are not available to the MAC: once no more than low_water
+ * descriptors are armed, frames are copied into PBUF_POOL pbufs and their
+ * buffer is kept by the ring. When the pool is empty as well, frames are
+ * dropped. Either way the MAC always has buffers to receive into.
+ *
+ * A driver would:
+ * - allocate the descriptor pointers, the rxring_bufs and the (DMA-able)
+ *   buffer memory, and call rxring_init() to arm the descriptors
+ * - for each completed descriptor, starting at ring->head, call
+ *   rxring_input() (or rxring_skip() for errored frames) and pass the pbuf
+ *   to netif->input
+ * - call rxring_refill() once it has processed the completed descriptors
+ */
+
+/*
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_NETIF_RXRING /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/def.h"
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "netif/rxring.h"
+
+#include <string.h>
+
+/** Put a buffer on the free list of its ring. */
+static void
+rxring_put(struct rxring_buf *buf)
+{
+  struct rxring *ring = buf->ring;
+  u8_t starving;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  buf->next = ring->free;
+  ring->free = buf;
+  ring->free_count++;
+  starving = (ring->armed == 0);
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if (starving && (ring->wake != NULL)) {
+    ring->wake(ring);
+  }
+}
+
+/** Free-callback function of the pbufs passed up by rxring_input() */
+static void
+rxring_free_buf(struct pbuf *p)
+{
+  rxring_put((struct rxring_buf *)p);
+}
+
+/**
+ * Initialize a receive ring and arm all of its descriptors.
+ *
+ * @param ring the ring to initialize
+ * @param desc array of 'size' descriptor pointers
+ * @param size number of descriptors
+ * @param bufs array of 'num_bufs' buffers; more buffers than descriptors
+ *        leave room for frames held by the stack
+ * @param mem num_bufs * buf_size bytes of buffer memory
+ * @param num_bufs number of buffers
+ * @param buf_size bytes per buffer: ETH_PAD_SIZE plus the largest frame
+ * @param post called to arm a descriptor
+ * @param kick called after a batch of descriptors was armed (may be NULL)
+ * @param state stored in ring->state for the driver
+ */
+void
+rxring_init(struct rxring *ring, struct rxring_buf **desc, u16_t size,
+            struct rxring_buf *bufs, u8_t *mem, u16_t num_bufs, u16_t buf_size,
+            rxring_post_fn post, rxring_kick_fn kick, void *state)
+{
+  u16_t i;
+
+  LWIP_ASSERT("rxring_init: ring != NULL", ring != NULL);
+  LWIP_ASSERT("rxring_init: size > 0", size > 0);
+  LWIP_ASSERT("rxring_init: buf_size > ETH_PAD_SIZE", buf_size > ETH_PAD_SIZE);
+  LWIP_ASSERT("rxring_init: post != NULL", post != NULL);
+
+  memset(ring, 0, sizeof(struct rxring));
+  ring->desc = desc;
+  ring->size = size;
+  ring->buf_size = buf_size;
+  ring->refill_batch = LWIP_MAX(size / 4, 1);
+  ring->low_water = size / 8;
+  ring->post = post;
+  ring->kick = kick;
+  ring->state = state;
+
+  for (i = 0; i < size; i++) {
+    desc[i] = NULL;
+  }
+  for (i = num_bufs; i > 0; i--) {
+    struct rxring_buf *buf = &bufs[i - 1];
+    buf->pc.custom_free_function = rxring_free_buf;
+    buf->ring = ring;
+    buf->mem = mem + (u32_t)(i - 1) * buf_size;
+    buf->next = ring->free;
+    ring->free = buf;
+  }
+  ring->free_count = num_bufs;
+
+  rxring_refill(ring, 1);
+}
+
+/**
+ * Arm empty descriptors with free buffers, in ring order starting at
+ * ring->tail. Nothing is done unless at least ring->refill_batch
+ * descriptors are empty, the ring is at its low water mark or 'force' is
+ * set.
+ *
+ * @param ring the ring to refill
+ * @param force refill even if fewer than refill_batch descriptors are empty
+ * @return the number of armed descriptors
+ */
+u16_t
+rxring_refill(struct rxring *ring, u8_t force)
+{
+  struct rxring_buf *list, *buf;
+  u16_t empty, n, first;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  empty = ring->size - ring->armed;
+  if ((empty == 0) ||
+      (!force && (empty < ring->refill_batch) && (ring->armed > ring->low_water))) {
+    return ring->armed;
+  }
+
+  /* take up to 'empty' buffers off the free list in one go */
+  SYS_ARCH_PROTECT(old_level);
+  list = ring->free;
+  for (n = 0, buf = list; (n < empty) && (buf != NULL); n++) {
+    if ((n + 1 == empty) || (buf->next == NULL)) {
+      ring->free = buf->next;
+      buf->next = NULL;
+      n++;
+      break;
+    }
+    buf = buf->next;
+  }
+  ring->free_count -= n;
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if (n < empty) {
+    ring->starved++;
+  }
+  if (n == 0) {
+    return ring->armed;
+  }
+
+  first = ring->tail;
+  for (buf = list; buf != NULL; buf = buf->next) {
+    LWIP_ASSERT("rxring_refill: descriptor is armed", ring->desc[ring->tail] == NULL);
+    ring->desc[ring->tail] = buf;
+    ring->post(ring, ring->tail, buf->mem + ETH_PAD_SIZE, ring->buf_size - ETH_PAD_SIZE);
+    ring->tail = (ring->tail + 1 == ring->size) ? 0 : ring->tail + 1;
+  }
+  ring->armed += n;
+
+  if (ring->kick != NULL) {
+    ring->kick(ring, first, n);
+    ring->kicks++;
+  }
+  return ring->armed;
+}
+
+/** Take the buffer of the descriptor at ring->head off the ring. */
+static struct rxring_buf *
+rxring_take(struct rxring *ring)
+{
+  struct rxring_buf *buf = ring->desc[ring->head];
+
+  LWIP_ASSERT("rxring_take: descriptor is not armed", (buf != NULL) && (ring->armed > 0));
+  ring->desc[ring->head] = NULL;
+  ring->head = (ring->head + 1 == ring->size) ? 0 : ring->head + 1;
+  ring->armed--;
+  return buf;
+}
+
+/**
+ * Take the frame the MAC received in the descriptor at ring->head.
+ *
+ * @param ring the ring the frame was received on
+ * @param len length of the frame (without ETH_PAD_SIZE)
+ * @return a pbuf holding the frame (with ETH_PAD_SIZE in front), which
+ *         refers to the ring buffer unless the ring is low on buffers; NULL
+ *         if the frame had to be dropped
+ */
+struct pbuf *
+rxring_input(struct rxring *ring, u16_t len)
+{
+  struct rxring_buf *buf = rxring_take(ring);
+  struct pbuf *p;
+
+  if (len > ring->buf_size - ETH_PAD_SIZE) {
+    ring->dropped++;
+    rxring_put(buf);
+    return NULL;
+  }
+
+  if (ring->armed <= ring->low_water) {
+    /* The stack holds too many buffers: copy the frame and keep the buffer
+       for the MAC. */
+    p = pbuf_alloc(PBUF_RAW, len + ETH_PAD_SIZE, PBUF_POOL);
+    if (p != NULL) {
+      pbuf_take(p, buf->mem, len + ETH_PAD_SIZE);
+      ring->copied++;
+    } else {
+      ring->dropped++;
+    }
+    rxring_put(buf);
+    return p;
+  }
+
+  p = pbuf_alloced_custom(PBUF_RAW, len + ETH_PAD_SIZE, PBUF_REF, &buf->pc,
+                          buf->mem, ring->buf_size);
+  LWIP_ASSERT("rxring_input: frame fits the buffer", p != NULL);
+  ring->passed++;
+  return p;
+}
+
+/**
+ * Drop the frame the MAC received in the descriptor at ring->head (e.g.
+ * because of a receive error) and keep its buffer.
+ *
+ * @param ring the ring the frame was received on
+ */
+void
+rxring_skip(struct rxring *ring)
+{
+  ring->dropped++;
+  rxring_put(rxring_take(ring));
+}
+
+#endif /* LWIP_NETIF_RXRING */
@@ -0,0 +1,126 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Used by "make sizes" to check that the C++ classes in freertos.hpp cost no
+ * more code than calling the C API directly.  The file is compiled twice, once
+ * with cppsizeUSE_CLASSES set to 1 and once with it set to 0, and the sizes of
+ * the two versions of vCppSizeTest() are compared.  It is not linked into the
+ * demo.
+ *
+ * The objects used by vCppSizeTest() are declared but not defined, so the
+ * compiler cannot make use of their values and no constructors are generated.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#if ( cppsizeUSE_CLASSES == 1 )
+
+	#include "freertos.hpp"
+
+	extern freertos::Queue< uint32_t, 4 > xSizeQueue;
+	extern freertos::Mutex xSizeMutex;
+
+	extern "C" void vCppSizeTest( void )
+	{
+	uint32_t ulValue;
+	freertos::LockGuard< freertos::Mutex > xGuard( xSizeMutex, 10 );
+
+		if( xGuard.locked() )
+		{
+			if( xSizeQueue.receive( ulValue, 0 ) )
+			{
+				ulValue++;
+				( void ) xSizeQueue.send( ulValue, 0 );
+			}
+		}
+	}
+
+#else
+
+	extern QueueHandle_t xSizeQueue;
+	extern SemaphoreHandle_t xSizeMutex;
+
+	extern "C" void vCppSizeTest( void )
+	{
+	uint32_t ulValue;
+
+		if( xSemaphoreTake( xSizeMutex, 10 ) == pdTRUE )
+		{
+			if( xQueueReceive( xSizeQueue, &ulValue, 0 ) == pdTRUE )
+			{
+				ulValue++;
+				( void ) xQueueSend( xSizeQueue, &ulValue, 0 );
+			}
+
+			( void ) xSemaphoreGive( xSizeMutex );
+		}
+	}
+
+#endif /* cppsizeUSE_CLASSES */
@@ -0,0 +1,1500 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Benchmarks of kernel features, run by "RTOSDemo bench [name...]" in place
+ * of the demo tasks.  Each benchmark prints one line per configuration it
+ * measures.  The ones that compare build options are run for each build by
+ * "make bench".
+ *
+ * Two clocks are used.  Latencies are measured in virtual time, using
+ * ullPortSimGetVirtualTime(), which counts kernel entries and so measures the
+ * work the simulated system does between two events.  It is the same on every
+ * run.  The cost of a kernel operation is measured in host CPU time, which
+ * includes the cost of the simulator itself (a context switch is a
+ * swapcontext() call, for example), so only the differences between builds
+ * are meaningful.
+ *
+ * workqueue - Latency from an interrupt deferring a short handler to the
+ * handler starting, with xTimerPendFunctionCallFromISR() and with a work queue
+ * of one and of two workers.  The interrupt is raised at pseudo random times,
+ * and a task below the priority of the handlers keeps the processor busy.
+ * Under the light load nothing else is deferred.  Under the mixed load one
+ * interrupt in benchWQ_SLOW_RATIO also defers a slow handler, which runs for
+ * benchWQ_SLOW_TICKS ticks, and a software timer with a callback that runs for
+ * a tick expires every benchWQ_TIMER_PERIOD ticks.
+ *
+ * ticktimer - How late the callbacks of a daemon (timers.h) timer and of a
+ * tick timer (tick_timers.h) run, both auto-reloading every benchTT_PERIOD
+ * ticks, relative to the tick at which they are due.  A task below the
+ * priority of the timer service task keeps the processor busy.  Under the
+ * mixed load another daemon timer, with a callback that runs for
+ * benchTT_SLOW_TICKS ticks, expires every benchTT_SLOW_PERIOD ticks, and an
+ * interrupt raised on average every benchTT_MEAN_PERIOD ticks pends a function
+ * that runs for a tick.  The host time taken to start then stop each kind of
+ * timer from a task is also measured.
+ *
+ * select - The host time taken for a task at priority 1 to give a semaphore to
+ * the benchmark task, which is waiting for it, and for the benchmark task to
+ * wait for it again.  Each round trip selects the highest priority ready task
+ * twice, once after the benchmark task is unblocked and once, which is the
+ * case the generic method is slow at, after it blocks again with no ready
+ * task above priority 1.  The selection method and the number of priorities
+ * are set by the build.
+ *
+ * create - The host time taken by xTaskCreate() and by vTaskDelete() for a
+ * task with a stack of benchCR_STACK_SIZE words that never runs, with the heap
+ * unfragmented and with benchCR_FRAGMENTS small free blocks in front of the
+ * free space.  The benchmark task lets the idle task run after each task is
+ * deleted, outside the timed calls, so the idle task can free it or refill its
+ * stack.  Whether the task pool is used, and how its stacks are refilled, is
+ * set by the build.
+ *
+ * hwm - The host time taken by uxTaskGetSystemState() with benchHWM_TASKS
+ * tasks, each with a stack of benchHWM_STACK_SIZE words that is almost all
+ * unused, the first time it is called and on average over the next
+ * benchHWM_REPORTS calls.  How many words below each task's high water mark
+ * are checked again per call is set by the build.
+ *
+ * tick - The host time taken by xTaskGetTickCount() and by
+ * xTaskCheckForTimeOut(), with the tick count type set by the build.
+ *
+ * reclaim - A task at priority 2, which never blocks, creates benchRC_TASKS
+ * tasks at priority 3, each of which deletes itself as soon as it runs, then
+ * carries on running for benchRC_BUSY_TICKS ticks.  The idle task cannot run
+ * until it stops.  The benchmark reports the most tasks that were waiting to
+ * be freed at once, the least free heap, and how many were still waiting
+ * when the busy task stopped.  Whether a reclaimer task frees them, and at
+ * what priority, is set by the build.  A reclaimer above the busy task must
+ * not run when the busy task deletes a task with the scheduler suspended
+ * until the scheduler is resumed.
+ *
+ * switch - The host time per context switch when a ring of tasks at the same
+ * priority yield to each other in turn, for rings of 64, 1024 and 4096 tasks.
+ * The larger rings touch more TCBs than fit in the host's caches.  Whether the
+ * TCB is split into hot and cold parts is set by the build.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#include "tick_timers.h"
+#include "workqueue.h"
+
+/* Demo includes. */
+#include "bench.h"
+
+/* Priority of the task that runs the benchmarks.  It only blocks while each
+benchmark runs, so it is placed just below the timer service task. */
+#define benchTASK_PRIORITY				( configTIMER_TASK_PRIORITY - 1 )
+#define benchTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+
+/* The simulated interrupt used by the benchmarks, and the seed of the
+generator that decides when it is raised. */
+#define benchINTERRUPT_NUMBER			( 3UL )
+#define benchSEED						( 1UL )
+
+/* The workqueue benchmark - see the top of this file. */
+#define benchWQ_SAMPLES					( 20000UL )
+#define benchWQ_MEAN_PERIOD				( ( TickType_t ) 4 )
+#define benchWQ_SLOW_RATIO				( 8UL )
+#define benchWQ_SLOW_TICKS				( ( TickType_t ) 3 )
+#define benchWQ_TIMER_PERIOD			( ( TickType_t ) 10 )
+#define benchWQ_TIMER_TICKS				( ( TickType_t ) 1 )
+#define benchWQ_ITEMS					( 64UL )
+
+/* How the workqueue benchmark defers its handlers. */
+#define benchWQ_PEND_FUNCTION_CALL		( 0 )
+#define benchWQ_WORK_QUEUE				( 1 )
+
+/* The ticktimer benchmark - see the top of this file. */
+#define benchTT_SAMPLES					( 10000UL )
+#define benchTT_PERIOD					( ( TickType_t ) 10 )
+#define benchTT_SLOW_PERIOD				( ( TickType_t ) 7 )
+#define benchTT_SLOW_TICKS				( ( TickType_t ) 2 )
+#define benchTT_MEAN_PERIOD				( ( TickType_t ) 8 )
+#define benchTT_COMMANDS				( 200000UL )
+
+/* The two timers measured by the ticktimer benchmark. */
+#define benchTT_DAEMON					( 0 )
+#define benchTT_TICK					( 1 )
+
+/* The select benchmark - see the top of this file. */
+#define benchSEL_ROUND_TRIPS			( 1000000UL )
+
+/* The create benchmark - see the top of this file. */
+#define benchCR_TASKS					( 20000UL )
+#define benchCR_STACK_SIZE				( configMINIMAL_STACK_SIZE * 8 )
+#define benchCR_FRAGMENTS				( 500UL )
+#define benchCR_FRAGMENT_SIZE			( ( size_t ) 8 )
+
+/* The hwm benchmark - see the top of this file. */
+#define benchHWM_TASKS					( 150UL )
+#define benchHWM_STACK_SIZE				( ( unsigned short ) 2048 )
+#define benchHWM_REPORTS				( 1000UL )
+
+/* The tick benchmark - see the top of this file. */
+#define benchTICK_CALLS					( 2000000UL )
+
+/* The reclaim benchmark - see the top of this file. */
+#define benchRC_TASKS					( 1000UL )
+#define benchRC_BUSY_TICKS				( ( TickType_t ) 100 )
+
+/* The switch benchmark - see the top of this file. */
+#define benchSW_SWITCHES				( 1000000UL )
+#define benchSW_MAX_RING				( 4096UL )
+
+#if configSPLIT_TCB == 1
+	#define benchSW_TCB					"split TCB"
+#else
+	#define benchSW_TCB					"single TCB"
+#endif
+
+#if configUSE_READY_PRIORITY_BITMAP == 1
+	#define benchSEL_METHOD				"bitmap"
+#elif configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+	#define benchSEL_METHOD				"port optimised"
+#else
+	#define benchSEL_METHOD				"generic"
+#endif
+
+#if ( configUSE_TASK_POOL == 1 ) && ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+	#define benchCR_METHOD				"task pool, lazy stack fill"
+#elif configUSE_TASK_POOL == 1
+	#define benchCR_METHOD				"task pool"
+#else
+	#define benchCR_METHOD				"no task pool"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* A benchmark, and the name by which it is selected on the command line. */
+typedef struct xBENCHMARK
+{
+	const char *pcName;
+	BaseType_t ( *pxFunction )( void );
+} xBenchmark;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the selected benchmarks, then ends the scheduler.
+ */
+static void prvBenchTask( void *pvParameters );
+
+/*
+ * The benchmarks.  Each returns pdFAIL if a check made along the way failed.
+ */
+static BaseType_t prvWorkQueueBenchmark( void );
+static BaseType_t prvTickTimerBenchmark( void );
+static BaseType_t prvSelectBenchmark( void );
+static BaseType_t prvCreateBenchmark( void );
+static BaseType_t prvHighWaterMarkBenchmark( void );
+static BaseType_t prvTickBenchmark( void );
+static BaseType_t prvReclaimBenchmark( void );
+static BaseType_t prvSwitchBenchmark( void );
+
+/*
+ * One configuration of the workqueue benchmark.  uxWorkers is only used when
+ * xMethod is benchWQ_WORK_QUEUE.
+ */
+static BaseType_t prvMeasureDeferral( BaseType_t xMethod, UBaseType_t uxWorkers, BaseType_t xMixedLoad );
+
+/*
+ * The interrupt handler, the deferred handlers and the software timer
+ * callback of the workqueue benchmark.
+ */
+static uint32_t prvDeferringInterrupt( void );
+static void prvFastWork( void *pvParameter );
+static void prvFastFunction( void *pvParameter1, uint32_t ulParameter2 );
+static void prvSlowWork( void *pvParameter );
+static void prvSlowFunction( void *pvParameter1, uint32_t ulParameter2 );
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * One load of the ticktimer benchmark.
+ */
+static BaseType_t prvMeasureJitter( BaseType_t xMixedLoad );
+
+/*
+ * Measures the time taken to start then stop each kind of timer.
+ */
+static void prvMeasureTimerCommands( void );
+
+/*
+ * The callbacks of the timers measured by the ticktimer benchmark, the
+ * callback of the slow timer, and the interrupt handler and pended function
+ * that add to the load.
+ */
+static void prvDaemonTimerCallback( TimerHandle_t xTimer );
+static void prvTickTimerCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+static void prvRecordExpiry( UBaseType_t uxTimer );
+static void prvSlowTimerCallback( TimerHandle_t xTimer );
+static uint32_t prvPendingInterrupt( void );
+static void prvPendedFunction( void *pvParameter1, uint32_t ulParameter2 );
+
+/*
+ * The task that gives the semaphore in the select benchmark.
+ */
+static void prvGivingTask( void *pvParameters );
+
+/*
+ * One heap layout of the create benchmark.
+ */
+static BaseType_t prvMeasureCreation( BaseType_t xFragmented );
+
+/*
+ * The task created by the create and hwm benchmarks, which suspends itself
+ * whenever it runs.
+ */
+static void prvSuspendingTask( void *pvParameters );
+
+/*
+ * The task that creates the tasks in the reclaim benchmark, and the tasks it
+ * creates.
+ */
+static void prvCreatingTask( void *pvParameters );
+static void prvSelfDeletingTask( void *pvParameters );
+
+/*
+ * One ring size of the switch benchmark, and the tasks in the ring.
+ */
+static BaseType_t prvMeasureSwitches( unsigned long ulRingSize );
+static void prvRingTask( void *pvParameters );
+
+/*
+ * A task that never blocks, used as background load.
+ */
+static void prvBusyTask( void *pvParameters );
+
+/*
+ * Runs for xTicks ticks of virtual time without blocking.
+ */
+static void prvSpin( TickType_t xTicks );
+
+/*
+ * Sorts the ulSamples samples in pulSamples, which are in units of virtual
+ * time, then prints their mean, median, 99th percentile and maximum in ticks.
+ */
+static void prvPrintLatencies( uint32_t *pulSamples, unsigned long ulSamples );
+static int prvCompareSamples( const void *pv1, const void *pv2 );
+
+/*
+ * The host time, in seconds.
+ */
+static double prvHostTime( void );
+
+/*-----------------------------------------------------------*/
+
+static const xBenchmark xBenchmarks[] =
+{
+	{ "workqueue", prvWorkQueueBenchmark },
+	{ "ticktimer", prvTickTimerBenchmark },
+	{ "select", prvSelectBenchmark },
+	{ "create", prvCreateBenchmark },
+	{ "hwm", prvHighWaterMarkBenchmark },
+	{ "tick", prvTickBenchmark },
+	{ "reclaim", prvReclaimBenchmark },
+	{ "switch", prvSwitchBenchmark }
+};
+
+#define benchNUM_BENCHMARKS				( sizeof( xBenchmarks ) / sizeof( xBenchmarks[ 0 ] ) )
+
+/* The benchmarks given on the command line. */
+static int iSelected = 0;
+static char **ppcSelected = NULL;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/* State of the workqueue benchmark.  The interrupt takes the work items in
+turn, and each records the virtual time at which it was deferred. */
+static BaseType_t xDeferMethod = benchWQ_PEND_FUNCTION_CALL, xDeferSlowWork = pdFALSE;
+static WorkQueueHandle_t xWorkQueue = NULL;
+static WorkItem_t xFastItems[ benchWQ_ITEMS ], xSlowItems[ benchWQ_ITEMS ];
+static uint64_t ullDeferredAt[ benchWQ_ITEMS ];
+static volatile BaseType_t xFastPending[ benchWQ_ITEMS ], xSlowPending[ benchWQ_ITEMS ];
+static unsigned long ulInterrupts = 0UL, ulNextItem = 0UL, ulNextSlowItem = 0UL;
+static volatile unsigned long ulSamples = 0UL, ulFailedDeferrals = 0UL;
+static double dSubmitSeconds = 0.0;
+static uint32_t ulLatencies[ benchWQ_SAMPLES ];
+static SemaphoreHandle_t xDone = NULL;
+
+/* State of the ticktimer benchmark - the tick at which both timers were
+started, and the number of times each has expired. */
+static TickType_t xTimersStarted = 0;
+static unsigned long ulExpiries[ 2 ];
+static uint32_t ulLateness[ 2 ][ benchTT_SAMPLES ];
+static uint64_t ullLastExpiry[ 2 ];
+static uint32_t ulMinInterval[ 2 ], ulMaxInterval[ 2 ];
+static volatile unsigned long ulPendFailures = 0UL;
+
+/* The semaphore given by the giving task in the select benchmark. */
+static SemaphoreHandle_t xSelectSemaphore = NULL;
+
+/* The blocks allocated by the create benchmark to fragment the heap. */
+static void *pvFragments[ benchCR_FRAGMENTS * 2UL ];
+
+/* State of the reclaim benchmark, written by the creating task. */
+static UBaseType_t uxMostPending = 0, uxPendingAtEnd = 0;
+static size_t xLeastFreeHeap = 0;
+static volatile BaseType_t xReclaimFailed = pdFALSE;
+
+/* State of the switch benchmark - the tasks in the ring, and the number of
+times they have run. */
+static TaskHandle_t xRing[ benchSW_MAX_RING ];
+static volatile unsigned long ulSwitches = 0UL;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartBenchmarks( int argc, char *argv[] )
+{
+int i;
+size_t x;
+
+	for( i = 0; i < argc; i++ )
+	{
+		for( x = 0; x < benchNUM_BENCHMARKS; x++ )
+		{
+			if( strcmp( argv[ i ], xBenchmarks[ x ].pcName ) == 0 )
+			{
+				break;
+			}
+		}
+
+		if( x == benchNUM_BENCHMARKS )
+		{
+			printf( "bench: unknown benchmark %s\r\n", argv[ i ] );
+			return pdFAIL;
+		}
+	}
+
+	iSelected = argc;
+	ppcSelected = argv;
+	vPortSimSetSeed( benchSEED );
+
+	return xTaskCreate( prvBenchTask, "Bench", benchTASK_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iBenchmarksFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void *pvParameters )
+{
+BaseType_t xPassed = pdPASS;
+size_t x;
+int i;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	for( x = 0; x < benchNUM_BENCHMARKS; x++ )
+	{
+		/* Run every benchmark if none were named. */
+		for( i = 0; i < iSelected; i++ )
+		{
+			if( strcmp( ppcSelected[ i ], xBenchmarks[ x ].pcName ) == 0 )
+			{
+				break;
+			}
+		}
+
+		if( ( iSelected == 0 ) || ( i < iSelected ) )
+		{
+			if( xBenchmarks[ x ].pxFunction() != pdPASS )
+			{
+				printf( "bench: %s: FAILED\r\n", xBenchmarks[ x ].pcName );
+				xPassed = pdFAIL;
+			}
+
+			/* Let the idle task free the tasks the benchmark deleted, so the
+			next one starts with the same heap. */
+			while( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 0 )
+			{
+				vTaskDelay( 1 );
+			}
+		}
+	}
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWorkQueueBenchmark( void )
+{
+TaskHandle_t xBusyTask;
+TimerHandle_t xTimer;
+BaseType_t xPassed = pdPASS, xMixedLoad;
+
+	xDone = xSemaphoreCreateBinary();
+	xTimer = xTimerCreate( "BenchTmr", benchWQ_TIMER_PERIOD, pdTRUE, NULL, prvTimerCallback );
+	configASSERT( xDone );
+	configASSERT( xTimer );
+	xTaskCreate( prvBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xBusyTask );
+	vPortSetInterruptHandler( benchINTERRUPT_NUMBER, prvDeferringInterrupt );
+
+	for( xMixedLoad = pdFALSE; xMixedLoad <= pdTRUE; xMixedLoad++ )
+	{
+		if( xMixedLoad != pdFALSE )
+		{
+			xTimerStart( xTimer, portMAX_DELAY );
+		}
+
+		if( prvMeasureDeferral( benchWQ_PEND_FUNCTION_CALL, 0, xMixedLoad ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+
+		if( prvMeasureDeferral( benchWQ_WORK_QUEUE, 1, xMixedLoad ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+
+		if( prvMeasureDeferral( benchWQ_WORK_QUEUE, 2, xMixedLoad ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	xTimerDelete( xTimer, portMAX_DELAY );
+	vTaskDelete( xBusyTask );
+	vSemaphoreDelete( xDone );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasureDeferral( BaseType_t xMethod, UBaseType_t uxWorkers, BaseType_t xMixedLoad )
+{
+const char *pcLoad = ( xMixedLoad != pdFALSE ) ? "mixed" : "light";
+unsigned long x;
+BaseType_t xPassed = pdPASS;
+
+	xDeferMethod = xMethod;
+	xDeferSlowWork = xMixedLoad;
+
+	if( xMethod == benchWQ_WORK_QUEUE )
+	{
+		/* The workers run at the priority of the timer service task, so they
+		compete with it as they would in an application. */
+		xWorkQueue = xWorkQueueCreate( "BenchWQ", uxWorkers, configTIMER_TASK_PRIORITY, configMINIMAL_STACK_SIZE );
+		configASSERT( xWorkQueue );
+
+		for( x = 0UL; x < benchWQ_ITEMS; x++ )
+		{
+			vWorkItemInitialise( &( xFastItems[ x ] ), prvFastWork, ( void * ) x );
+			vWorkItemInitialise( &( xSlowItems[ x ] ), prvSlowWork, ( void * ) x );
+		}
+	}
+
+	for( x = 0UL; x < benchWQ_ITEMS; x++ )
+	{
+		xFastPending[ x ] = pdFALSE;
+		xSlowPending[ x ] = pdFALSE;
+	}
+
+	ulInterrupts = 0UL;
+	ulNextItem = 0UL;
+	ulNextSlowItem = 0UL;
+	ulSamples = 0UL;
+	ulFailedDeferrals = 0UL;
+	dSubmitSeconds = 0.0;
+
+	/* Run until the fast handler has taken enough samples. */
+	vPortSimInjectInterrupt( benchINTERRUPT_NUMBER, benchWQ_MEAN_PERIOD );
+	xSemaphoreTake( xDone, portMAX_DELAY );
+	vPortSimInjectInterrupt( benchINTERRUPT_NUMBER, 0 );
+
+	if( xMethod == benchWQ_WORK_QUEUE )
+	{
+		if( xWorkQueueFlush( xWorkQueue, portMAX_DELAY ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+
+		if( xWorkQueueDelete( xWorkQueue ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+
+		printf( "bench: workqueue: %s load, work queue, %u worker(s):    ", pcLoad, ( unsigned int ) uxWorkers );
+	}
+	else
+	{
+		/* Let the timer service task finish the slow handlers. */
+		vTaskDelay( benchWQ_SLOW_TICKS * ( TickType_t ) benchWQ_ITEMS );
+		printf( "bench: workqueue: %s load, xTimerPendFunctionCallFromISR: ", pcLoad );
+	}
+
+	printf( "%.0f ns to defer, latency ", dSubmitSeconds * 1e9 / ( double ) ulInterrupts );
+	prvPrintLatencies( ulLatencies, benchWQ_SAMPLES );
+	printf( ", %lu failed\r\n", ulFailedDeferrals );
+
+	if( ulFailedDeferrals != 0UL )
+	{
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvDeferringInterrupt( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE, xDeferred = pdFAIL;
+unsigned long ulItem = ulNextItem;
+double dStart;
+
+	ulNextItem = ( ulNextItem + 1UL ) % benchWQ_ITEMS;
+	ulInterrupts++;
+
+	if( ( xFastPending[ ulItem ] != pdFALSE ) || ( ulSamples >= benchWQ_SAMPLES ) )
+	{
+		/* Every work item is still waiting, or the benchmark is complete. */
+		ulFailedDeferrals += ( ulSamples < benchWQ_SAMPLES ) ? 1UL : 0UL;
+		return pdFALSE;
+	}
+
+	xFastPending[ ulItem ] = pdTRUE;
+	ullDeferredAt[ ulItem ] = ullPortSimGetVirtualTime();
+
+	dStart = prvHostTime();
+
+	if( xDeferMethod == benchWQ_WORK_QUEUE )
+	{
+		xDeferred = xWorkQueueSubmitFromISR( xWorkQueue, &( xFastItems[ ulItem ] ), &xHigherPriorityTaskWoken );
+	}
+	else
+	{
+		xDeferred = xTimerPendFunctionCallFromISR( prvFastFunction, NULL, ( uint32_t ) ulItem, &xHigherPriorityTaskWoken );
+	}
+
+	dSubmitSeconds += prvHostTime() - dStart;
+
+	if( xDeferred != pdPASS )
+	{
+		xFastPending[ ulItem ] = pdFALSE;
+		ulFailedDeferrals++;
+	}
+
+	if( ( xDeferSlowWork != pdFALSE ) && ( ( ulInterrupts % benchWQ_SLOW_RATIO ) == 0UL ) )
+	{
+		ulItem = ulNextSlowItem;
+
+		if( xSlowPending[ ulItem ] == pdFALSE )
+		{
+			ulNextSlowItem = ( ulNextSlowItem + 1UL ) % benchWQ_ITEMS;
+			xSlowPending[ ulItem ] = pdTRUE;
+
+			if( xDeferMethod == benchWQ_WORK_QUEUE )
+			{
+				xDeferred = xWorkQueueSubmitFromISR( xWorkQueue, &( xSlowItems[ ulItem ] ), &xHigherPriorityTaskWoken );
+			}
+			else
+			{
+				xDeferred = xTimerPendFunctionCallFromISR( prvSlowFunction, NULL, ( uint32_t ) ulItem, &xHigherPriorityTaskWoken );
+			}
+
+			if( xDeferred != pdPASS )
+			{
+				xSlowPending[ ulItem ] = pdFALSE;
+				ulFailedDeferrals++;
+			}
+		}
+		else
+		{
+			ulFailedDeferrals++;
+		}
+	}
+
+	return ( uint32_t ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastWork( void *pvParameter )
+{
+unsigned long ulItem = ( unsigned long ) pvParameter;
+
+	if( ulSamples < benchWQ_SAMPLES )
+	{
+		ulLatencies[ ulSamples ] = ( uint32_t ) ( ullPortSimGetVirtualTime() - ullDeferredAt[ ulItem ] );
+		ulSamples++;
+
+		if( ulSamples == benchWQ_SAMPLES )
+		{
+			xSemaphoreGive( xDone );
+		}
+	}
+
+	xFastPending[ ulItem ] = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	prvFastWork( ( void * ) ( unsigned long ) ulParameter2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowWork( void *pvParameter )
+{
+	prvSpin( benchWQ_SLOW_TICKS );
+	xSlowPending[ ( unsigned long ) pvParameter ] = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	prvSpin( benchWQ_SLOW_TICKS );
+	xSlowPending[ ulParameter2 ] = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	prvSpin( benchWQ_TIMER_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTickTimerBenchmark( void )
+{
+TaskHandle_t xBusyTask;
+BaseType_t xPassed = pdPASS;
+
+	/* Given once by each timer. */
+	xDone = xSemaphoreCreateCounting( 2, 0 );
+	configASSERT( xDone );
+	xTaskCreate( prvBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xBusyTask );
+	vPortSetInterruptHandler( benchINTERRUPT_NUMBER, prvPendingInterrupt );
+
+	if( prvMeasureJitter( pdFALSE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( prvMeasureJitter( pdTRUE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	prvMeasureTimerCommands();
+
+	vTaskDelete( xBusyTask );
+	vSemaphoreDelete( xDone );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasureJitter( BaseType_t xMixedLoad )
+{
+const char *pcLoad = ( xMixedLoad != pdFALSE ) ? "mixed" : "light";
+const char * const pcNames[ 2 ] = { "daemon timer", "tick timer  " };
+TimerHandle_t xDaemonTimer, xSlowTimer = NULL;
+TickTimerHandle_t xTickTimer;
+UBaseType_t uxTimer;
+BaseType_t xPassed = pdPASS;
+
+	xDaemonTimer = xTimerCreate( "BenchTmr", benchTT_PERIOD, pdTRUE, NULL, prvDaemonTimerCallback );
+	xTickTimer = xTickTimerCreate( benchTT_PERIOD, pdTRUE, NULL, prvTickTimerCallback );
+	configASSERT( xDaemonTimer );
+	configASSERT( xTickTimer );
+
+	for( uxTimer = benchTT_DAEMON; uxTimer <= benchTT_TICK; uxTimer++ )
+	{
+		ulExpiries[ uxTimer ] = 0UL;
+		ulMinInterval[ uxTimer ] = ~( ( uint32_t ) 0 );
+		ulMaxInterval[ uxTimer ] = 0UL;
+	}
+
+	ulPendFailures = 0UL;
+
+	if( xMixedLoad != pdFALSE )
+	{
+		xSlowTimer = xTimerCreate( "BenchSlow", benchTT_SLOW_PERIOD, pdTRUE, NULL, prvSlowTimerCallback );
+		configASSERT( xSlowTimer );
+		xTimerStart( xSlowTimer, portMAX_DELAY );
+		vPortSimInjectInterrupt( benchINTERRUPT_NUMBER, benchTT_MEAN_PERIOD );
+	}
+
+	/* This task is below the priority of the timer service task, so the
+	daemon timer has been started by the time xTimerStart() returns, and both
+	timers are started on the same tick. */
+	vTaskSuspendAll();
+	{
+		xTimersStarted = xTaskGetTickCount();
+		vTickTimerStart( xTickTimer );
+		xTimerStart( xDaemonTimer, 0 );
+	}
+	xTaskResumeAll();
+
+	/* Both callbacks give the semaphore once they have taken enough
+	samples. */
+	xSemaphoreTake( xDone, portMAX_DELAY );
+	xSemaphoreTake( xDone, portMAX_DELAY );
+
+	vPortSimInjectInterrupt( benchINTERRUPT_NUMBER, 0 );
+	vTickTimerDelete( xTickTimer );
+	xTimerDelete( xDaemonTimer, portMAX_DELAY );
+
+	if( xSlowTimer != NULL )
+	{
+		xTimerDelete( xSlowTimer, portMAX_DELAY );
+	}
+
+	/* Let the timer service task finish the pended functions. */
+	vTaskDelay( benchTT_MEAN_PERIOD );
+
+	for( uxTimer = benchTT_DAEMON; uxTimer <= benchTT_TICK; uxTimer++ )
+	{
+		printf( "bench: ticktimer: %s load, %s: late by ", pcLoad, pcNames[ uxTimer ] );
+		prvPrintLatencies( ulLateness[ uxTimer ], benchTT_SAMPLES );
+		printf( ", interval %.2f to %.2f ticks\r\n", ( double ) ulMinInterval[ uxTimer ] / ( double ) configSIM_CALLS_PER_TICK,
+				( double ) ulMaxInterval[ uxTimer ] / ( double ) configSIM_CALLS_PER_TICK );
+	}
+
+	if( ulPendFailures != 0UL )
+	{
+		printf( "bench: ticktimer: %lu function calls could not be pended\r\n", ulPendFailures );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTimerCommands( void )
+{
+TimerHandle_t xDaemonTimer;
+TickTimerHandle_t xTickTimer;
+unsigned long x;
+double dStart, dDaemonSeconds, dTickSeconds;
+
+	xDaemonTimer = xTimerCreate( "BenchTmr", benchTT_PERIOD, pdFALSE, NULL, prvDaemonTimerCallback );
+	xTickTimer = xTickTimerCreate( benchTT_PERIOD, pdFALSE, NULL, prvTickTimerCallback );
+	configASSERT( xDaemonTimer );
+	configASSERT( xTickTimer );
+
+	/* Each command sent to the timer service task, which has a higher
+	priority than this task, switches to it and back. */
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchTT_COMMANDS; x++ )
+	{
+		xTimerStart( xDaemonTimer, portMAX_DELAY );
+		xTimerStop( xDaemonTimer, portMAX_DELAY );
+	}
+
+	dDaemonSeconds = prvHostTime() - dStart;
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchTT_COMMANDS; x++ )
+	{
+		vTickTimerStart( xTickTimer );
+		vTickTimerStop( xTickTimer );
+	}
+
+	dTickSeconds = prvHostTime() - dStart;
+
+	vTickTimerDelete( xTickTimer );
+	xTimerDelete( xDaemonTimer, portMAX_DELAY );
+
+	printf( "bench: ticktimer: start and stop: daemon timer %.0f ns, tick timer %.0f ns\r\n",
+			dDaemonSeconds * 1e9 / ( double ) benchTT_COMMANDS, dTickSeconds * 1e9 / ( double ) benchTT_COMMANDS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDaemonTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	prvRecordExpiry( benchTT_DAEMON );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickTimerCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) xTimer;
+	( void ) pxHigherPriorityTaskWoken;
+	prvRecordExpiry( benchTT_TICK );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordExpiry( UBaseType_t uxTimer )
+{
+uint64_t ullNow = ullPortSimGetVirtualTime(), ullDue;
+uint32_t ulInterval;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulExpiry = ulExpiries[ uxTimer ];
+
+	if( ulExpiry < benchTT_SAMPLES )
+	{
+		/* The tick count and the virtual time both start from 0 when the
+		scheduler starts. */
+		ullDue = ( ( uint64_t ) xTimersStarted + ( ( uint64_t ) ( ulExpiry + 1UL ) * ( uint64_t ) benchTT_PERIOD ) ) * ( uint64_t ) configSIM_CALLS_PER_TICK;
+		ulLateness[ uxTimer ][ ulExpiry ] = ( uint32_t ) ( ullNow - ullDue );
+
+		if( ulExpiry > 0UL )
+		{
+			ulInterval = ( uint32_t ) ( ullNow - ullLastExpiry[ uxTimer ] );
+
+			if( ulInterval < ulMinInterval[ uxTimer ] )
+			{
+				ulMinInterval[ uxTimer ] = ulInterval;
+			}
+
+			if( ulInterval > ulMaxInterval[ uxTimer ] )
+			{
+				ulMaxInterval[ uxTimer ] = ulInterval;
+			}
+		}
+
+		ullLastExpiry[ uxTimer ] = ullNow;
+		ulExpiries[ uxTimer ]++;
+
+		if( ulExpiries[ uxTimer ] == benchTT_SAMPLES )
+		{
+			/* The tick timer callback runs inside the tick interrupt. */
+			if( uxTimer == benchTT_TICK )
+			{
+				xSemaphoreGiveFromISR( xDone, &xHigherPriorityTaskWoken );
+			}
+			else
+			{
+				xSemaphoreGive( xDone );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	prvSpin( benchTT_SLOW_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPendingInterrupt( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( xTimerPendFunctionCallFromISR( prvPendedFunction, NULL, 0, &xHigherPriorityTaskWoken ) != pdPASS )
+	{
+		ulPendFailures++;
+	}
+
+	return ( uint32_t ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) pvParameter1;
+	( void ) ulParameter2;
+	prvSpin( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSelectBenchmark( void )
+{
+TaskHandle_t xGivingTask;
+unsigned long x;
+double dStart, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	xSelectSemaphore = xSemaphoreCreateBinary();
+	configASSERT( xSelectSemaphore );
+
+	/* The giving task runs whenever this task is blocked. */
+	xTaskCreate( prvGivingTask, "Giver", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xGivingTask );
+
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchSEL_ROUND_TRIPS; x++ )
+	{
+		if( xSemaphoreTake( xSelectSemaphore, portMAX_DELAY ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	dSeconds = prvHostTime() - dStart;
+
+	vTaskDelete( xGivingTask );
+	vSemaphoreDelete( xSelectSemaphore );
+
+	printf( "bench: select: %s, %u priorities: %.0f ns per round trip\r\n", benchSEL_METHOD, ( unsigned int ) configMAX_PRIORITIES,
+			dSeconds * 1e9 / ( double ) benchSEL_ROUND_TRIPS );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGivingTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xSemaphoreGive( xSelectSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateBenchmark( void )
+{
+BaseType_t xPassed = pdPASS;
+
+	if( prvMeasureCreation( pdFALSE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( prvMeasureCreation( pdTRUE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasureCreation( BaseType_t xFragmented )
+{
+const char *pcHeap = ( xFragmented != pdFALSE ) ? "fragmented" : "unfragmented";
+TaskHandle_t xTask;
+unsigned long x;
+double dStart, dCreateSeconds = 0.0, dDeleteSeconds = 0.0;
+BaseType_t xPassed = pdPASS;
+
+	if( xFragmented != pdFALSE )
+	{
+		/* Allocate pairs of small blocks from the start of the free space,
+		then free the first of each pair.  The heap is searched first fit, so
+		every allocation made by xTaskCreate() then walks past the free ones. */
+		for( x = 0UL; x < ( benchCR_FRAGMENTS * 2UL ); x++ )
+		{
+			pvFragments[ x ] = pvPortMalloc( benchCR_FRAGMENT_SIZE );
+			configASSERT( pvFragments[ x ] );
+		}
+
+		for( x = 0UL; x < ( benchCR_FRAGMENTS * 2UL ); x += 2UL )
+		{
+			vPortFree( pvFragments[ x ] );
+		}
+	}
+
+	for( x = 0UL; x < benchCR_TASKS; x++ )
+	{
+		/* The task is below the priority of this task, so it never runs. */
+		dStart = prvHostTime();
+
+		if( xTaskCreate( prvSuspendingTask, "Short", benchCR_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+			break;
+		}
+
+		dCreateSeconds += prvHostTime() - dStart;
+		dStart = prvHostTime();
+		vTaskDelete( xTask );
+		dDeleteSeconds += prvHostTime() - dStart;
+
+		/* Let the idle task free the task, or refill its stack if it was
+		recycled and the stack is filled lazily. */
+		do
+		{
+			vTaskDelay( 1 );
+		} while( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 0 );
+	}
+
+	if( xFragmented != pdFALSE )
+	{
+		for( x = 1UL; x < ( benchCR_FRAGMENTS * 2UL ); x += 2UL )
+		{
+			vPortFree( pvFragments[ x ] );
+		}
+	}
+
+	printf( "bench: create: %s, %s heap: xTaskCreate() %.0f ns, vTaskDelete() %.0f ns\r\n", benchCR_METHOD, pcHeap,
+			dCreateSeconds * 1e9 / ( double ) benchCR_TASKS, dDeleteSeconds * 1e9 / ( double ) benchCR_TASKS );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvHighWaterMarkBenchmark( void )
+{
+TaskHandle_t xTasks[ benchHWM_TASKS ];
+TaskStatus_t *pxStatus;
+UBaseType_t uxArraySize, uxTask, uxMinimum = ~( ( UBaseType_t ) 0 );
+unsigned long x;
+double dStart, dFirstSeconds, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	for( x = 0UL; x < benchHWM_TASKS; x++ )
+	{
+		if( xTaskCreate( prvSuspendingTask, "Stack", benchHWM_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xTasks[ x ] ) ) != pdPASS )
+		{
+			return pdFAIL;
+		}
+	}
+
+	/* Let each task run once. */
+	vTaskDelay( 1 );
+
+	uxArraySize = uxTaskGetNumberOfTasks();
+	pxStatus = ( TaskStatus_t * ) pvPortMalloc( uxArraySize * sizeof( TaskStatus_t ) );
+	configASSERT( pxStatus );
+
+	dStart = prvHostTime();
+	uxTaskGetSystemState( pxStatus, uxArraySize, NULL );
+	dFirstSeconds = prvHostTime() - dStart;
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchHWM_REPORTS; x++ )
+	{
+		if( uxTaskGetSystemState( pxStatus, uxArraySize, NULL ) != uxArraySize )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	dSeconds = prvHostTime() - dStart;
+
+	/* The tasks created above all have the same high water mark, which must
+	not depend on the build. */
+	for( uxTask = 0; uxTask < uxArraySize; uxTask++ )
+	{
+		if( ( strcmp( pxStatus[ uxTask ].pcTaskName, "Stack" ) == 0 ) && ( pxStatus[ uxTask ].usStackHighWaterMark < uxMinimum ) )
+		{
+			uxMinimum = pxStatus[ uxTask ].usStackHighWaterMark;
+		}
+	}
+
+	vPortFree( pxStatus );
+
+	for( x = 0UL; x < benchHWM_TASKS; x++ )
+	{
+		vTaskDelete( xTasks[ x ] );
+	}
+
+	printf( "bench: hwm: scan words %u, %lu tasks of %u words: first report %.0f us, later reports %.1f us, high water mark %u words\r\n",
+			( unsigned int ) configSTACK_HIGH_WATER_MARK_SCAN_WORDS, benchHWM_TASKS, ( unsigned int ) benchHWM_STACK_SIZE,
+			dFirstSeconds * 1e6, dSeconds * 1e6 / ( double ) benchHWM_REPORTS, ( unsigned int ) uxMinimum );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTickBenchmark( void )
+{
+TimeOut_t xTimeOut;
+TickType_t xTicksToWait = portMAX_DELAY - 1, xTotal = 0;
+unsigned long x;
+double dStart, dGetSeconds, dCheckSeconds;
+BaseType_t xPassed = pdPASS;
+
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchTICK_CALLS; x++ )
+	{
+		xTotal += xTaskGetTickCount();
+	}
+
+	dGetSeconds = prvHostTime() - dStart;
+
+	/* The timeout is too long to expire while the benchmark runs. */
+	vTaskSetTimeOutState( &xTimeOut );
+	dStart = prvHostTime();
+
+	for( x = 0UL; x < benchTICK_CALLS; x++ )
+	{
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	dCheckSeconds = prvHostTime() - dStart;
+
+	/* Just to stop the sum being optimised away. */
+	( void ) xTotal;
+
+	printf( "bench: tick: %u bit ticks: xTaskGetTickCount() %.1f ns, xTaskCheckForTimeOut() %.1f ns\r\n",
+			( unsigned int ) ( sizeof( TickType_t ) * 8U ), dGetSeconds * 1e9 / ( double ) benchTICK_CALLS,
+			dCheckSeconds * 1e9 / ( double ) benchTICK_CALLS );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReclaimBenchmark( void )
+{
+TaskHandle_t xCreatingTask;
+size_t xFreeHeap = xPortGetFreeHeapSize();
+TickType_t xWaited = 0;
+BaseType_t xPassed = pdPASS;
+
+	xDone = xSemaphoreCreateBinary();
+	configASSERT( xDone );
+
+	uxMostPending = 0;
+	xLeastFreeHeap = xFreeHeap;
+	xReclaimFailed = pdFALSE;
+
+	xTaskCreate( prvCreatingTask, "Creator", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xCreatingTask );
+	xSemaphoreTake( xDone, portMAX_DELAY );
+	vTaskDelete( xCreatingTask );
+
+	/* Now the idle task can run too. */
+	while( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 0 )
+	{
+		vTaskDelay( 1 );
+		xWaited++;
+	}
+
+	vSemaphoreDelete( xDone );
+
+	#if ( configUSE_TASK_RECLAIMER == 1 )
+	{
+		printf( "bench: reclaim: reclaimer task at priority %u: ", ( unsigned int ) configTASK_RECLAIMER_PRIORITY );
+	}
+	#else
+	{
+		printf( "bench: reclaim: idle task: " );
+	}
+	#endif
+
+	printf( "at most %u waiting, heap used %lu bytes, %u waiting after %u busy ticks, %u ticks to free the rest\r\n",
+			( unsigned int ) uxMostPending, ( unsigned long ) ( xFreeHeap - xLeastFreeHeap ), ( unsigned int ) uxPendingAtEnd,
+			( unsigned int ) benchRC_BUSY_TICKS, ( unsigned int ) xWaited );
+
+	if( ( xReclaimFailed != pdFALSE ) || ( xPortGetFreeHeapSize() != xFreeHeap ) )
+	{
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreatingTask( void *pvParameters )
+{
+unsigned long x;
+UBaseType_t uxPending;
+size_t xFreeHeap;
+
+	( void ) pvParameters;
+
+	#if ( configUSE_TASK_RECLAIMER == 1 )
+	{
+	TaskHandle_t xTask;
+
+		if( ( UBaseType_t ) configTASK_RECLAIMER_PRIORITY > uxTaskPriorityGet( NULL ) )
+		{
+			/* Deleting the task wakes the reclaimer, which must wait for the
+			scheduler to be resumed before it runs. */
+			vTaskSuspendAll();
+			{
+				xTaskCreate( prvSuspendingTask, "Short", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask );
+				vTaskDelete( xTask );
+
+				if( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 1 )
+				{
+					xReclaimFailed = pdTRUE;
+				}
+			}
+			xTaskResumeAll();
+
+			if( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 0 )
+			{
+				xReclaimFailed = pdTRUE;
+			}
+		}
+	}
+	#endif /* configUSE_TASK_RECLAIMER */
+
+	for( x = 0UL; x < benchRC_TASKS; x++ )
+	{
+		/* The new task runs, and deletes itself, before this call returns. */
+		if( xTaskCreate( prvSelfDeletingTask, "Short", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, NULL ) != pdPASS )
+		{
+			xReclaimFailed = pdTRUE;
+		}
+
+		uxPending = uxTaskGetPendingReclaimCount();
+		xFreeHeap = xPortGetFreeHeapSize();
+
+		if( uxPending > uxMostPending )
+		{
+			uxMostPending = uxPending;
+		}
+
+		if( xFreeHeap < xLeastFreeHeap )
+		{
+			xLeastFreeHeap = xFreeHeap;
+		}
+	}
+
+	prvSpin( benchRC_BUSY_TICKS );
+	uxPendingAtEnd = uxTaskGetPendingReclaimCount();
+	xSemaphoreGive( xDone );
+
+	/* Keep the processor busy until deleted. */
+	for( ;; )
+	{
+		prvSpin( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSelfDeletingTask( void *pvParameters )
+{
+	( void ) pvParameters;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSwitchBenchmark( void )
+{
+BaseType_t xPassed = pdPASS;
+
+	xDone = xSemaphoreCreateBinary();
+	configASSERT( xDone );
+
+	if( prvMeasureSwitches( 64UL ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( prvMeasureSwitches( 1024UL ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( prvMeasureSwitches( benchSW_MAX_RING ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	vSemaphoreDelete( xDone );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasureSwitches( unsigned long ulRingSize )
+{
+unsigned long x;
+double dStart, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	for( x = 0UL; x < ulRingSize; x++ )
+	{
+		if( xTaskCreate( prvRingTask, "Ring", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xRing[ x ] ) ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+			ulRingSize = x;
+			break;
+		}
+	}
+
+	/* Let every task run once before starting the clock. */
+	ulSwitches = 0UL;
+	vTaskDelay( 1 );
+	ulSwitches = 0UL;
+
+	dStart = prvHostTime();
+
+	if( xPassed == pdPASS )
+	{
+		xSemaphoreTake( xDone, portMAX_DELAY );
+	}
+
+	dSeconds = prvHostTime() - dStart;
+
+	for( x = 0UL; x < ulRingSize; x++ )
+	{
+		vTaskDelete( xRing[ x ] );
+	}
+
+	/* Let the idle task free the tasks. */
+	while( uxTaskGetPendingReclaimCount() != ( UBaseType_t ) 0 )
+	{
+		vTaskDelay( 1 );
+	}
+
+	printf( "bench: switch: %s, ring of %lu tasks: %.0f ns per switch\r\n", benchSW_TCB, ulRingSize,
+			dSeconds * 1e9 / ( double ) benchSW_SWITCHES );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRingTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulSwitches++;
+
+		if( ulSwitches == benchSW_SWITCHES )
+		{
+			xSemaphoreGive( xDone );
+		}
+
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendingTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		prvSpin( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpin( TickType_t xTicks )
+{
+TickType_t xStart = xTaskGetTickCount();
+
+	/* Reading the tick count enters the kernel, which is what makes virtual
+	time advance (see configSIM_CALLS_PER_TICK). */
+	while( ( xTaskGetTickCount() - xStart ) < xTicks )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintLatencies( uint32_t *pulSamples, unsigned long ulSamples )
+{
+uint64_t ullTotal = 0ULL;
+unsigned long x;
+const double dTick = ( double ) configSIM_CALLS_PER_TICK;
+
+	qsort( pulSamples, ulSamples, sizeof( pulSamples[ 0 ] ), prvCompareSamples );
+
+	for( x = 0UL; x < ulSamples; x++ )
+	{
+		ullTotal += pulSamples[ x ];
+	}
+
+	printf( "mean %.2f, median %.2f, 99th percentile %.2f, max %.2f ticks",
+			( double ) ullTotal / ( double ) ulSamples / dTick, ( double ) pulSamples[ ulSamples / 2UL ] / dTick,
+			( double ) pulSamples[ ( ulSamples * 99UL ) / 100UL ] / dTick, ( double ) pulSamples[ ulSamples - 1UL ] / dTick );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void *pv1, const void *pv2 )
+{
+uint32_t ul1 = *( ( const uint32_t * ) pv1 ), ul2 = *( ( const uint32_t * ) pv2 );
+
+	return ( ul1 < ul2 ) ? -1 : ( ( ul1 > ul2 ) ? 1 : 0 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvHostTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,508 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ *******************************************************************************
+ * NOTE: The POSIX simulator port runs every task on a single host thread and
+ * measures time in virtual ticks rather than wall clock time.  When all the
+ * tasks are blocked the simulator jumps straight to the next tick at which a
+ * task will unblock, so the duration of a run depends on the amount of work
+ * the tasks perform, not on the amount of time that is simulated.  This makes
+ * the port suitable for running long soak tests in a short time.  It is not
+ * suitable for measuring real time behaviour.
+ *******************************************************************************
+ *
+ * main() creates the standard demo tasks, a "Check" task and a simulated
+ * peripheral interrupt, then starts the scheduler.  Usage:
+ *
+ *     RTOSDemo [seed] [seconds]
+ *     RTOSDemo bench [name...]
+ *
+ * The second form runs the benchmarks in bench.c instead of the demo.
+ *
+ * seed (default 1) seeds the generator that decides when the simulated
+ * peripheral interrupt fires.  Two runs that use the same seed execute
+ * identically, so a failure found by a soak run can be replayed.
+ *
+ * seconds (default 3600) is the amount of virtual time to simulate.
+ *
+ * "Check" task - This executes every 2.5 (virtual) seconds at a high priority.
+ * Its main function is to check that all the standard demo tasks and the
+ * simulated interrupt are still operational.  The status is printed once per
+ * simulated minute.  When the requested amount of time has been simulated the
+ * check task prints a summary and ends the scheduler.  The process exit code
+ * is 0 if no errors were found, and 1 if an error was found.
+ *
+ * Peripheral interrupt - interrupt mainSIM_INTERRUPT_NUMBER is raised at
+ * pseudo random virtual times, on average once every mainSIM_INTERRUPT_PERIOD
+ * ticks.  Its handler gives a semaphore to unblock the "ISR" task, which
+ * counts the number of interrupts processed.
+ *
+ * The standard demo tasks that never block (such as the floating point tasks)
+ * are not included because a task that neither blocks nor calls the kernel
+ * cannot be preempted on a single host thread.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "semphr.h"
+
+/* Standard demo includes. */
+#include "BlockQ.h"
+#include "integer.h"
+#include "semtest.h"
+#include "PollQ.h"
+#include "GenQTest.h"
+#include "QPeek.h"
+#include "recmutex.h"
+#include "blocktim.h"
+#include "TimerDemo.h"
+#include "countsem.h"
+#include "death.h"
+#include "dynamic.h"
+#include "QueueSet.h"
+#include "QueueOverwrite.h"
+#include "EventGroupsDemo.h"
+#include "CppWrappers.h"
+#include "WorkQueueDemo.h"
+#include "TickTimerDemo.h"
+#include "WaitSetDemo.h"
+#include "ExecutorDemo.h"
+#include "RegistryDemo.h"
+
+/* Benchmark includes. */
+#include "bench.h"
+
+/* Priorities at which the tasks are created. */
+#define mainCHECK_TASK_PRIORITY			( configMAX_PRIORITIES - 2 )
+#define mainISR_TASK_PRIORITY			( configMAX_PRIORITIES - 3 )
+#define mainQUEUE_POLL_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainSEM_TEST_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainBLOCK_Q_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define mainCREATOR_TASK_PRIORITY		( tskIDLE_PRIORITY + 3 )
+#define mainINTEGER_TASK_PRIORITY		( tskIDLE_PRIORITY )
+#define mainGEN_QUEUE_TASK_PRIORITY		( tskIDLE_PRIORITY )
+#define mainQUEUE_OVERWRITE_PRIORITY	( tskIDLE_PRIORITY )
+#define mainCPP_WRAPPER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainWORK_QUEUE_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainTICK_TIMER_PRIORITY			( tskIDLE_PRIORITY + 2 )
+#define mainWAIT_SET_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainEXECUTOR_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainREGISTRY_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#define mainTIMER_TEST_PERIOD			( 50 )
+
+/* The frequency at which the check task executes, and the frequency at which
+it prints its status. */
+#define mainCHECK_PERIOD				( 2500 / portTICK_PERIOD_MS )
+#define mainREPORT_PERIOD				( 60000 / portTICK_PERIOD_MS )
+
+/* The simulated peripheral interrupt.  Numbers 0 and 1 are used by the
+kernel. */
+#define mainSIM_INTERRUPT_NUMBER		( 2UL )
+#define mainSIM_INTERRUPT_PERIOD		( ( TickType_t ) 7 )
+
+/* Defaults used when the seed and run length are not given on the command
+line. */
+#define mainDEFAULT_SEED				( 1UL )
+#define mainDEFAULT_RUN_SECONDS			( 3600UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The check task, as described at the top of this file.
+ */
+static void prvCheckTask( void *pvParameters );
+
+/*
+ * The task unblocked by the simulated peripheral interrupt, and the interrupt
+ * handler itself.
+ */
+static void prvISRTask( void *pvParameters );
+static uint32_t prvSimulatedPeripheralInterrupt( void );
+
+/*
+ * Prototypes for the standard FreeRTOS callback/hook functions implemented
+ * within this file.
+ */
+void vApplicationMallocFailedHook( void );
+void vApplicationTickHook( void );
+
+/*-----------------------------------------------------------*/
+
+/* The variable into which error messages are latched. */
+static const char *pcStatusMessage = "OK";
+
+/* The semaphore given by the simulated peripheral interrupt, and the number
+of times the interrupt has been processed by prvISRTask(). */
+static SemaphoreHandle_t xISRSemaphore = NULL;
+static volatile uint32_t ulISRCount = 0UL;
+
+/* The number of ticks to simulate. */
+static uint64_t ullRunTicks = 0ULL;
+
+/* Set to 1 if an error is detected.  Used as the process exit code. */
+static int iExitCode = 0;
+
+/* Set to pdTRUE once the demo tasks have been created, as the tick hook uses
+the objects they create.  They are not created when running benchmarks. */
+static BaseType_t xDemoTasksCreated = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+uint32_t ulSeed = mainDEFAULT_SEED;
+uint32_t ulRunSeconds = mainDEFAULT_RUN_SECONDS;
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+	{
+		if( xStartBenchmarks( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iBenchmarksFinish();
+	}
+
+	if( argc > 1 )
+	{
+		ulSeed = ( uint32_t ) strtoul( argv[ 1 ], NULL, 0 );
+	}
+
+	if( argc > 2 )
+	{
+		ulRunSeconds = ( uint32_t ) strtoul( argv[ 2 ], NULL, 0 );
+	}
+
+	ullRunTicks = ( uint64_t ) ulRunSeconds * ( uint64_t ) configTICK_RATE_HZ;
+	printf( "Simulating %u seconds with seed %u\r\n", ( unsigned int ) ulRunSeconds, ( unsigned int ) ulSeed );
+
+	/* Start the check task as described at the top of this file. */
+	xTaskCreate( prvCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY, NULL );
+
+	/* Create the simulated peripheral interrupt and the task it unblocks. */
+	xISRSemaphore = xSemaphoreCreateBinary();
+	configASSERT( xISRSemaphore );
+	xTaskCreate( prvISRTask, "ISR", configMINIMAL_STACK_SIZE, NULL, mainISR_TASK_PRIORITY, NULL );
+	vPortSetInterruptHandler( mainSIM_INTERRUPT_NUMBER, prvSimulatedPeripheralInterrupt );
+	vPortSimSetSeed( ulSeed );
+	vPortSimInjectInterrupt( mainSIM_INTERRUPT_NUMBER, mainSIM_INTERRUPT_PERIOD );
+
+	/* Create the standard demo tasks. */
+	vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+	vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
+	vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
+	vStartIntegerMathTasks( mainINTEGER_TASK_PRIORITY );
+	vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+	vStartQueuePeekTasks();
+	vStartRecursiveMutexTasks();
+	vCreateBlockTimeTasks();
+	vStartCountingSemaphoreTasks();
+	vStartDynamicPriorityTasks();
+	vStartQueueSetTasks();
+	vStartQueueOverwriteTask( mainQUEUE_OVERWRITE_PRIORITY );
+	vStartEventGroupTasks();
+	vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
+	vStartCppWrapperTasks( mainCPP_WRAPPER_PRIORITY );
+	vStartWorkQueueTasks( mainWORK_QUEUE_PRIORITY );
+	vStartTickTimerTasks( mainTICK_TIMER_PRIORITY );
+	vStartWaitSetTasks( mainWAIT_SET_PRIORITY );
+	vStartExecutorTasks( mainEXECUTOR_PRIORITY );
+	vStartRegistryTasks( mainREGISTRY_PRIORITY );
+
+	/* The suicide tasks must be created last as they need to know how many
+	tasks were running prior to their creation.  This then allows them to
+	ascertain whether or not the correct/expected number of tasks are running at
+	any given time. */
+	vCreateSuicidalTasks( mainCREATOR_TASK_PRIORITY );
+	xDemoTasksCreated = pdTRUE;
+
+	/* Start the scheduler itself.  This returns when the check task ends the
+	scheduler. */
+	vTaskStartScheduler();
+
+	return iExitCode;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void *pvParameters )
+{
+TickType_t xNextWakeTime, xLastReportTime;
+uint64_t ullElapsedTicks = 0ULL;
+uint32_t ulLastISRCount = 0UL;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	/* Initialise xNextWakeTime - this only needs to be done once. */
+	xNextWakeTime = xTaskGetTickCount();
+	xLastReportTime = xNextWakeTime;
+
+	for( ;; )
+	{
+		/* Place this task in the blocked state until it is time to run again. */
+		vTaskDelayUntil( &xNextWakeTime, mainCHECK_PERIOD );
+		ullElapsedTicks += ( uint64_t ) mainCHECK_PERIOD;
+
+		/* Check the standard demo tasks are running without error. */
+		if( xAreTimerDemoTasksStillRunning( mainCHECK_PERIOD ) != pdTRUE )
+		{
+			pcStatusMessage = "Error: TimerDemo";
+		}
+		else if( xAreEventGroupTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: EventGroup";
+		}
+		else if( xAreIntegerMathsTaskStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: IntMath";
+		}
+		else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: GenQueue";
+		}
+		else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: QueuePeek";
+		}
+		else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: BlockQueue";
+		}
+		else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: SemTest";
+		}
+		else if( xArePollingQueuesStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: PollQueue";
+		}
+		else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: RecMutex";
+		}
+		else if( xAreBlockTimeTestTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: BlockTime";
+		}
+		else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: CountSem";
+		}
+		else if( xIsCreateTaskStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: Death";
+		}
+		else if( xAreDynamicPriorityTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Dynamic";
+		}
+		else if( xAreQueueSetTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Queue set";
+		}
+		else if( xIsQueueOverwriteTaskStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Queue overwrite";
+		}
+		else if( xAreCppWrapperTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: C++ wrappers";
+		}
+		else if( xAreWorkQueueTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Work queue";
+		}
+		else if( xAreTickTimerTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Tick timers";
+		}
+		else if( xAreWaitSetTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Wait sets";
+		}
+		else if( xAreExecutorTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Executor";
+		}
+		else if( xAreRegistryTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Object registry";
+		}
+		else if( ulISRCount == ulLastISRCount )
+		{
+			pcStatusMessage = "Error: Simulated interrupt";
+		}
+
+		ulLastISRCount = ulISRCount;
+
+		/* An error, once found, is latched. */
+		if( pcStatusMessage[ 0 ] == 'E' )
+		{
+			iExitCode = 1;
+		}
+
+		/* This is the only task that uses stdout so its ok to call printf()
+		directly. */
+		if( ( ( xNextWakeTime - xLastReportTime ) >= mainREPORT_PERIOD ) || ( ullElapsedTicks >= ullRunTicks ) )
+		{
+			xLastReportTime = xNextWakeTime;
+			printf( "%s - %u s, %u interrupts\r\n", pcStatusMessage, ( unsigned int ) ( ullElapsedTicks / configTICK_RATE_HZ ), ( unsigned int ) ulISRCount );
+			fflush( stdout );
+		}
+
+		if( ullElapsedTicks >= ullRunTicks )
+		{
+			vTaskEndScheduler();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvISRTask( void *pvParameters )
+{
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xSemaphoreTake( xISRSemaphore, portMAX_DELAY );
+		ulISRCount++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSimulatedPeripheralInterrupt( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xSemaphoreGiveFromISR( xISRSemaphore, &xHigherPriorityTaskWoken );
+
+	/* Returning a non-zero value causes the simulator to switch to the
+	unblocked task if it has a higher priority than the interrupted task. */
+	return ( uint32_t ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* Called if a call to pvPortMalloc() fails because there is insufficient
+	free memory available in the FreeRTOS heap. */
+	vAssertCalled( __LINE__, __FILE__ );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( xDemoTasksCreated == pdFALSE )
+	{
+		return;
+	}
+
+	/* Call the periodic timer test, which tests the timer API functions that
+	can be called from an ISR. */
+	vTimerPeriodicISRTests();
+
+	/* Call the periodic queue overwrite from ISR demo. */
+	vQueueOverwritePeriodicISRDemo();
+
+	/* Write to a queue that is in use as part of the queue set demo to
+	demonstrate using queue sets from an ISR. */
+	vQueueSetAccessQueueSetFromISR();
+
+	/* Exercise event groups from interrupts. */
+	vPeriodicEventGroupsProcessing();
+
+	/* Submit work to a work queue from an interrupt. */
+	vWorkQueuePeriodicISRDemo();
+
+	/* Post to, and notify, a wait set from an interrupt. */
+	vWaitSetPeriodicISRDemo();
+
+	/* Notify an executor routine from an interrupt. */
+	vExecutorPeriodicISRDemo();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName )
+{
+	/* Report the failure and exit.  Re-running with the same seed reproduces
+	the failure. */
+	printf( "ASSERT! Line %lu, file %s\r\n", ulLine, pcFileName );
+	fflush( stdout );
+	exit( 2 );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,582 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests of the ARP table (see ARP_TABLE_HASH in lwip/opt.h).
+ *
+ * Everything runs inside the tcpip thread.  Two network interfaces are
+ * created, 10.0.8.1/16 and 10.1.8.1/24.  Neighbours are added to the table
+ * by passing ARP replies from them straight to ethernet_input(), and packets
+ * are sent to them with etharp_output().  The tests check that:
+ *
+ * - the table can be filled past its capacity, keeping a static entry and
+ *   ARP_TABLE_SIZE - 1 of the neighbours,
+ * - with ARP_TABLE_HASH, the least recently used neighbour is the one
+ *   recycled, counting a packet sent to a neighbour as a use, and only the
+ *   most recently added neighbours are left after the table has been
+ *   refilled several times over,
+ * - the entries expire, apart from the static one,
+ * - each interface remembers the neighbour it last sent to, so sending to a
+ *   neighbour on each interface in turn hits that hint every time,
+ * - a hint left pointing at an entry recycled for another neighbour is not
+ *   used - the packet waits for an ARP request to be answered instead of
+ *   going to the new neighbour.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/stats.h"
+#include "lwip/tcpip.h"
+#include "netif/etharp.h"
+
+/* Demo includes. */
+#include "arptest.h"
+
+/* The neighbours that fill the table - how many times over it is refilled,
+and the number of neighbours that takes. */
+#define arptestREFILLS					3
+#define arptestNEIGHBOURS				( ARP_TABLE_SIZE * ( arptestREFILLS + 2 ) )
+
+/* The neighbour the static entry is added for. */
+#define arptestSTATIC					0x7000
+
+/* The number of times each interface sends to its neighbour in the hint
+test. */
+#define arptestHINT_ROUNDS				100
+
+/* More calls to etharp_tmr() than ARP_MAXAGE in etharp.c. */
+#define arptestEXPIRE_CALLS				255
+
+/* The ARP hardware type of Ethernet. */
+#define arptestHWTYPE_ETHERNET			1
+
+/* Priority and stack size of the task that runs the tests. */
+#define arptestTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define arptestTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/*-----------------------------------------------------------*/
+
+/* An interface, and the last frame it sent. */
+typedef struct xTEST_NETIF
+{
+	struct netif xNetIf;
+	unsigned long ulSent;
+	struct eth_addr xLastDestination;
+	u16_t usLastType;
+} xTestNetIf;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, then runs prvRunTests() in it.
+ */
+static void prvArpTestTask( void *pvParameters );
+
+/*
+ * The body of the test - runs in the tcpip thread.
+ */
+static void prvRunTests( void *pvParameters );
+
+/*
+ * The tests.  Each returns pdPASS if it passed.
+ */
+static BaseType_t prvTestFill( void );
+static BaseType_t prvTestExpiry( void );
+static BaseType_t prvTestHint( void );
+
+/*
+ * The address and hardware address of neighbour ulNeighbour of an interface.
+ */
+static void prvNeighbour( xTestNetIf *pxNetIf, unsigned long ulNeighbour, ip_addr_t *pxAddress, struct eth_addr *pxHardwareAddress );
+
+/*
+ * Receives an ARP reply to the interface from one of its neighbours, which
+ * adds the neighbour to the table.
+ */
+static void prvReply( xTestNetIf *pxNetIf, unsigned long ulNeighbour );
+
+/*
+ * Sends a packet to one of the interface's neighbours.  Returns pdTRUE if it
+ * was sent to the neighbour's hardware address straight away.
+ */
+static BaseType_t prvSend( xTestNetIf *pxNetIf, unsigned long ulNeighbour );
+
+/*
+ * Returns pdTRUE if the neighbour is in the table, with the right hardware
+ * address.
+ */
+static BaseType_t prvFound( xTestNetIf *pxNetIf, unsigned long ulNeighbour );
+
+/*
+ * Counts the neighbours ulFirst to ulLast that are in the table.
+ */
+static unsigned long prvCountFound( xTestNetIf *pxNetIf, unsigned long ulFirst, unsigned long ulLast );
+
+/*
+ * Network interface callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+
+/*-----------------------------------------------------------*/
+
+/* The interfaces. */
+static xTestNetIf xFirstNetIf, xSecondNetIf;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartArpTest( int argc, char *argv[] )
+{
+	( void ) argv;
+
+	if( argc > 0 )
+	{
+		printf( "arptest: no arguments are taken\r\n" );
+		return pdFAIL;
+	}
+
+	return xTaskCreate( prvArpTestTask, "ArpTest", arptestTASK_STACK_SIZE, NULL, arptestTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iArpTestFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvArpTestTask( void *pvParameters )
+{
+sys_sem_t xDone;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* lwIP's core functions may only be called from the tcpip thread. */
+	tcpip_callback( prvRunTests, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTests( void *pvParameters )
+{
+ip_addr_t xAddress, xNetMask, xGateway;
+BaseType_t xPassed = pdPASS;
+
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xAddress, 10, 0, 8, 1 );
+	IP4_ADDR( &xNetMask, 255, 255, 0, 0 );
+	netif_add( &xFirstNetIf.xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xFirstNetIf.xNetIf );
+	IP4_ADDR( &xAddress, 10, 1, 8, 1 );
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	netif_add( &xSecondNetIf.xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xSecondNetIf.xNetIf );
+
+	if( ( prvTestFill() != pdPASS ) || ( prvTestExpiry() != pdPASS ) || ( prvTestHint() != pdPASS ) )
+	{
+		xPassed = pdFAIL;
+	}
+
+	printf( "arptest: %s, %d entries: %s\r\n", ARP_TABLE_HASH ? "hash" : "list", ARP_TABLE_SIZE,
+			( xPassed == pdPASS ) ? "tests passed" : "FAILED" );
+
+	netif_remove( &xFirstNetIf.xNetIf );
+	netif_remove( &xSecondNetIf.xNetIf );
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestFill( void )
+{
+xTestNetIf *pxNetIf = &xFirstNetIf;
+unsigned long ulNeighbour, ulFull = ARP_TABLE_SIZE - 1;
+ip_addr_t xAddress;
+struct eth_addr xHardwareAddress;
+BaseType_t xPassed = pdPASS;
+
+	/* One entry is static, the rest are neighbours 0 to ulFull - 1. */
+	prvNeighbour( pxNetIf, arptestSTATIC, &xAddress, &xHardwareAddress );
+	etharp_add_static_entry( &xAddress, &xHardwareAddress );
+
+	for( ulNeighbour = 0UL; ulNeighbour < ulFull; ulNeighbour++ )
+	{
+		prvReply( pxNetIf, ulNeighbour );
+	}
+
+	if( prvCountFound( pxNetIf, 0UL, ulFull - 1UL ) != ulFull )
+	{
+		printf( "arptest: fill: %lu of %lu neighbours found\r\n", prvCountFound( pxNetIf, 0UL, ulFull - 1UL ), ulFull );
+		xPassed = pdFAIL;
+	}
+
+	/* Use neighbour 0, then add one more neighbour than there is room for. */
+	if( prvSend( pxNetIf, 0UL ) == pdFALSE )
+	{
+		printf( "arptest: fill: packet to neighbour 0 not sent\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	prvReply( pxNetIf, ulFull );
+
+	if( ( prvFound( pxNetIf, ulFull ) == pdFALSE ) || ( prvCountFound( pxNetIf, 0UL, ulFull ) != ulFull ) )
+	{
+		printf( "arptest: fill: neighbour %lu not added in place of one other\r\n", ulFull );
+		xPassed = pdFAIL;
+	}
+
+	#if ARP_TABLE_HASH
+	{
+		/* Neighbour 1 was the least recently used. */
+		if( ( prvFound( pxNetIf, 0UL ) == pdFALSE ) || ( prvFound( pxNetIf, 1UL ) != pdFALSE ) )
+		{
+			printf( "arptest: fill: neighbour 1 was not the one recycled\r\n" );
+			xPassed = pdFAIL;
+		}
+	}
+	#endif /* ARP_TABLE_HASH */
+
+	/* Refill the table several times over. */
+	for( ulNeighbour = ulFull + 1UL; ulNeighbour < arptestNEIGHBOURS; ulNeighbour++ )
+	{
+		prvReply( pxNetIf, ulNeighbour );
+	}
+
+	if( ( prvFound( pxNetIf, arptestNEIGHBOURS - 1UL ) == pdFALSE ) || ( prvCountFound( pxNetIf, 0UL, arptestNEIGHBOURS - 1UL ) != ulFull ) )
+	{
+		printf( "arptest: fill: %lu neighbours found after refilling, not %lu\r\n", prvCountFound( pxNetIf, 0UL, arptestNEIGHBOURS - 1UL ), ulFull );
+		xPassed = pdFAIL;
+	}
+
+	#if ARP_TABLE_HASH
+	{
+		if( prvCountFound( pxNetIf, arptestNEIGHBOURS - ulFull, arptestNEIGHBOURS - 1UL ) != ulFull )
+		{
+			printf( "arptest: fill: the most recently added neighbours were recycled\r\n" );
+			xPassed = pdFAIL;
+		}
+	}
+	#endif /* ARP_TABLE_HASH */
+
+	/* Static entries are never recycled. */
+	if( prvFound( pxNetIf, arptestSTATIC ) == pdFALSE )
+	{
+		printf( "arptest: fill: static entry recycled\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestExpiry( void )
+{
+BaseType_t x, xPassed = pdPASS;
+
+	for( x = 0; x < arptestEXPIRE_CALLS; x++ )
+	{
+		etharp_tmr();
+	}
+
+	if( prvCountFound( &xFirstNetIf, 0UL, arptestNEIGHBOURS - 1UL ) != 0UL )
+	{
+		printf( "arptest: expiry: %lu neighbours not expired\r\n", prvCountFound( &xFirstNetIf, 0UL, arptestNEIGHBOURS - 1UL ) );
+		xPassed = pdFAIL;
+	}
+
+	if( prvFound( &xFirstNetIf, arptestSTATIC ) == pdFALSE )
+	{
+		printf( "arptest: expiry: static entry expired\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestHint( void )
+{
+STAT_COUNTER xHits;
+unsigned long ulNeighbour, ulSent;
+BaseType_t x, xPassed = pdPASS;
+
+	prvReply( &xFirstNetIf, 0UL );
+	prvReply( &xSecondNetIf, 0UL );
+
+	/* Once each interface has looked its neighbour up in the table, every
+	packet it sends uses its hint. */
+	prvSend( &xFirstNetIf, 0UL );
+	prvSend( &xSecondNetIf, 0UL );
+	xHits = lwip_stats.etharp.cachehit;
+
+	for( x = 0; x < arptestHINT_ROUNDS; x++ )
+	{
+		if( ( prvSend( &xFirstNetIf, 0UL ) == pdFALSE ) || ( prvSend( &xSecondNetIf, 0UL ) == pdFALSE ) )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	xHits = lwip_stats.etharp.cachehit - xHits;
+
+	if( ( xPassed != pdPASS ) || ( xHits != 2 * arptestHINT_ROUNDS ) )
+	{
+		printf( "arptest: hint: %u of %d packets used the hint\r\n", ( unsigned int ) xHits, 2 * arptestHINT_ROUNDS );
+		xPassed = pdFAIL;
+	}
+
+	/* Recycle every entry, including the one the first interface's hint
+	points to, for other neighbours.  The table is aged as it fills, so that
+	without ARP_TABLE_HASH the oldest entries are recycled too. */
+	for( ulNeighbour = 1UL; ulNeighbour <= 2UL * ARP_TABLE_SIZE; ulNeighbour++ )
+	{
+		prvReply( &xFirstNetIf, ulNeighbour );
+		etharp_tmr();
+	}
+
+	xHits = lwip_stats.etharp.cachehit;
+	ulSent = xFirstNetIf.ulSent;
+
+	if( ( prvFound( &xFirstNetIf, 0UL ) != pdFALSE ) || ( prvSend( &xFirstNetIf, 0UL ) != pdFALSE ) )
+	{
+		printf( "arptest: hint: packet sent to a recycled entry\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	if( ( lwip_stats.etharp.cachehit != xHits ) || ( xFirstNetIf.ulSent != ulSent + 1UL ) ||
+		( xFirstNetIf.usLastType != PP_HTONS( ETHTYPE_ARP ) ) )
+	{
+		printf( "arptest: hint: no ARP request sent for a recycled entry\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	/* The reply sends the packet that was waiting for it. */
+	prvReply( &xFirstNetIf, 0UL );
+
+	if( ( xFirstNetIf.ulSent != ulSent + 2UL ) || ( xFirstNetIf.usLastType != PP_HTONS( ETHTYPE_IP ) ) )
+	{
+		printf( "arptest: hint: packet not sent once the neighbour replied\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNeighbour( xTestNetIf *pxNetIf, unsigned long ulNeighbour, ip_addr_t *pxAddress, struct eth_addr *pxHardwareAddress )
+{
+u32_t ulHost = ip4_addr_get_u32( &( pxNetIf->xNetIf.ip_addr ) );
+
+	/* Counting up from the host after the interface's own. */
+	ulHost = ntohl( ulHost ) + 1UL + ( u32_t ) ulNeighbour;
+	ip4_addr_set_u32( pxAddress, htonl( ulHost ) );
+
+	pxHardwareAddress->addr[ 0 ] = 0x02;
+	pxHardwareAddress->addr[ 1 ] = ( pxNetIf == &xFirstNetIf ) ? 1 : 2;
+	pxHardwareAddress->addr[ 2 ] = 0;
+	pxHardwareAddress->addr[ 3 ] = ( u8_t ) ( ulNeighbour >> 16 );
+	pxHardwareAddress->addr[ 4 ] = ( u8_t ) ( ulNeighbour >> 8 );
+	pxHardwareAddress->addr[ 5 ] = ( u8_t ) ulNeighbour;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReply( xTestNetIf *pxNetIf, unsigned long ulNeighbour )
+{
+struct pbuf *p;
+struct eth_hdr *pxEthernet;
+struct etharp_hdr *pxARP;
+ip_addr_t xAddress;
+struct eth_addr xHardwareAddress;
+
+	prvNeighbour( pxNetIf, ulNeighbour, &xAddress, &xHardwareAddress );
+
+	p = pbuf_alloc( PBUF_RAW, SIZEOF_ETHARP_PACKET, PBUF_RAM );
+	configASSERT( p );
+	memset( p->payload, 0x00, SIZEOF_ETHARP_PACKET );
+	pxEthernet = ( struct eth_hdr * ) p->payload;
+	pxARP = ( struct etharp_hdr * ) ( ( u8_t * ) p->payload + SIZEOF_ETH_HDR );
+
+	SMEMCPY( &pxEthernet->dest, pxNetIf->xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	SMEMCPY( &pxEthernet->src, &xHardwareAddress, ETHARP_HWADDR_LEN );
+	pxEthernet->type = PP_HTONS( ETHTYPE_ARP );
+
+	pxARP->hwtype = PP_HTONS( arptestHWTYPE_ETHERNET );
+	pxARP->proto = PP_HTONS( ETHTYPE_IP );
+	pxARP->hwlen = ETHARP_HWADDR_LEN;
+	pxARP->protolen = sizeof( ip_addr_t );
+	pxARP->opcode = PP_HTONS( ARP_REPLY );
+	SMEMCPY( &pxARP->shwaddr, &xHardwareAddress, ETHARP_HWADDR_LEN );
+	SMEMCPY( &pxARP->sipaddr, &xAddress, sizeof( ip_addr_t ) );
+	SMEMCPY( &pxARP->dhwaddr, pxNetIf->xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	SMEMCPY( &pxARP->dipaddr, &( pxNetIf->xNetIf.ip_addr ), sizeof( ip_addr_t ) );
+
+	if( pxNetIf->xNetIf.input( p, &( pxNetIf->xNetIf ) ) != ERR_OK )
+	{
+		pbuf_free( p );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSend( xTestNetIf *pxNetIf, unsigned long ulNeighbour )
+{
+struct pbuf *p;
+ip_addr_t xAddress;
+struct eth_addr xHardwareAddress;
+unsigned long ulSent = pxNetIf->ulSent;
+
+	prvNeighbour( pxNetIf, ulNeighbour, &xAddress, &xHardwareAddress );
+
+	/* An empty IP packet is enough for etharp_output(). */
+	p = pbuf_alloc( PBUF_IP, 0, PBUF_RAM );
+	configASSERT( p );
+	etharp_output( &( pxNetIf->xNetIf ), p, &xAddress );
+	pbuf_free( p );
+
+	return ( ( pxNetIf->ulSent == ulSent + 1UL ) && ( pxNetIf->usLastType == PP_HTONS( ETHTYPE_IP ) ) &&
+			 ( memcmp( &( pxNetIf->xLastDestination ), &xHardwareAddress, ETHARP_HWADDR_LEN ) == 0 ) ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFound( xTestNetIf *pxNetIf, unsigned long ulNeighbour )
+{
+ip_addr_t xAddress, *pxFoundAddress;
+struct eth_addr xHardwareAddress, *pxFoundHardwareAddress;
+
+	prvNeighbour( pxNetIf, ulNeighbour, &xAddress, &xHardwareAddress );
+
+	/* Looking an entry up does not count as a use. */
+	if( etharp_find_addr( &( pxNetIf->xNetIf ), &xAddress, &pxFoundHardwareAddress, &pxFoundAddress ) < 0 )
+	{
+		return pdFALSE;
+	}
+
+	return ( memcmp( pxFoundHardwareAddress, &xHardwareAddress, ETHARP_HWADDR_LEN ) == 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCountFound( xTestNetIf *pxNetIf, unsigned long ulFirst, unsigned long ulLast )
+{
+unsigned long ulNeighbour, ulFound = 0UL;
+
+	for( ulNeighbour = ulFirst; ulNeighbour <= ulLast; ulNeighbour++ )
+	{
+		if( prvFound( pxNetIf, ulNeighbour ) != pdFALSE )
+		{
+			ulFound++;
+		}
+	}
+
+	return ulFound;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 'a';
+	pxNetIf->name[ 1 ] = 't';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x04, ETHARP_HWADDR_LEN );
+	pxNetIf->hwaddr[ 5 ] = ( pxNetIf == &xFirstNetIf.xNetIf ) ? 1 : 2;
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+xTestNetIf *pxTestNetIf = ( pxNetIf == &xFirstNetIf.xNetIf ) ? &xFirstNetIf : &xSecondNetIf;
+struct eth_hdr *pxEthernet = ( struct eth_hdr * ) p->payload;
+
+	pxTestNetIf->ulSent++;
+	SMEMCPY( &( pxTestNetIf->xLastDestination ), &pxEthernet->dest, ETHARP_HWADDR_LEN );
+	pxTestNetIf->usLastType = pxEthernet->type;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
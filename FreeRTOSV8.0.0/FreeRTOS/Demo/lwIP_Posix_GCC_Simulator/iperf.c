@@ -0,0 +1,753 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * An iperf style TCP throughput test between two copies of the stack, joined
+ * by a virtual wire (see netif/vwire.h).
+ *
+ * xStartIperf() creates the wire and forks.  The parent process is the
+ * server: it accepts one connection, checks that the stream it receives
+ * carries the expected pattern, and reports the throughput once it has
+ * received all the data.  The child process is the client: it sends the
+ * requested number of bytes as fast as the stack allows.  The server then
+ * replies with a single status byte, so the client knows all its data was
+ * delivered before it closes the connection.  Each process runs its own
+ * scheduler, tcpip thread and netif, as two boards on either end of a cable
+ * would.
+ *
+ * The throughput is reported both in host time, which measures how much CPU
+ * time the stack needs to move the data, and in virtual time, which is what
+ * the stack itself sees.  The client also reports the CPU time it used per
+ * megabyte sent.
+ *
+ * The client sends with netconn_write(), which copies the data into the
+ * segments.  When built with LWIP_TCP_ZEROCOPY (the zerocopy build in the
+ * makefile) it passes the data to tcp_write_pbuf() instead, in buffers that
+ * are custom pbufs, and checks that the free function of each buffer - its
+ * send completion - is called exactly once, after the end of its data has
+ * been acknowledged.  Either way the data is taken from one copy of the
+ * pattern, so none of the CPU time is spent generating it.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/api.h"
+#include "lwip/tcp.h"
+#include "lwip/tcpip.h"
+#include "netif/vwire.h"
+
+/* Demo includes. */
+#include "iperf.h"
+
+/* The TCP port the server listens on - the iperf default. */
+#define iperfPORT						5001
+
+/* The amount of data sent when none is given on the command line. */
+#define iperfDEFAULT_MEGABYTES			64UL
+
+/* The size of the buffer passed to each netconn_write() call, and of the
+buffers passed to tcp_write_pbuf(). */
+#define iperfWRITE_SIZE					( 64 * 1024 )
+#define iperfZEROCOPY_BUFFER_SIZE		( 8 * 1024 )
+
+/* Priority and stack size of the task that sets up the stack and then acts
+as the client or the server. */
+#define iperfTASK_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define iperfTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/* How long (in virtual time) the server waits for the client to connect or
+send more data, and the client waits for the status byte, before the test is
+failed. */
+#define iperfTIMEOUT_MS					10000
+
+/* How often, and how many times, the client tries to connect. */
+#define iperfCONNECT_RETRY_DELAY		( 100 / portTICK_PERIOD_MS )
+#define iperfCONNECT_ATTEMPTS			100
+
+/* The byte found at offset ullOffset of the stream.  Every byte depends on
+its offset, so lost, duplicated or reordered data is detected. */
+#define iperfPATTERN( ullOffset )		( ( uint8_t ) ( ( ullOffset ) ^ ( ( ullOffset ) >> 9 ) ) )
+
+/* The pattern repeats every 2^17 bytes, so the client sends from one copy of
+it.  Each write starts a multiple of its size into the stream, and the sizes
+divide the period, so each write starts at the same place in the copy every
+time round.  This makes each zero-copy buffer a fixed part of the copy. */
+#define iperfPATTERN_PERIOD				( 128 * 1024 )
+#define iperfZEROCOPY_BUFFERS			( iperfPATTERN_PERIOD / iperfZEROCOPY_BUFFER_SIZE )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Brings up the stack and the end of the wire owned by this process, then
+ * runs the client or the server.
+ */
+static void prvIperfTask( void *pvParameters );
+
+/*
+ * The two ends of the test.  Both return the exit code of the process.
+ */
+static int prvServer( void );
+static int prvClient( void );
+
+#if LWIP_TCP_ZEROCOPY
+
+/*
+ * Sends the data on pxConnection with tcp_write_pbuf().
+ */
+static err_t prvSendZeroCopy( struct netconn *pxConnection );
+
+/*
+ * Queues the buffers that follow with tcp_write_pbuf(), as many as fit in
+ * the send buffer - runs in the tcpip thread.
+ */
+static void prvZeroCopyWrite( void *pvParameters );
+
+/*
+ * The free function of the zero-copy buffers, called in the tcpip thread.
+ */
+static void prvZeroCopySent( struct pbuf *p );
+
+/*
+ * Waits for the send completion of a zero-copy buffer.
+ */
+static err_t prvWaitForZeroCopySent( void );
+
+/*
+ * Waits for every zero-copy buffer sent to complete.  Returns pdPASS if each
+ * did once, and after its data was acknowledged.
+ */
+static BaseType_t prvCheckZeroCopy( void );
+
+#else /* LWIP_TCP_ZEROCOPY */
+
+/*
+ * Sends the data on pxConnection with netconn_write().
+ */
+static err_t prvSendCopy( struct netconn *pxConnection );
+
+#endif /* LWIP_TCP_ZEROCOPY */
+
+/*
+ * The monotonic host time, in seconds.
+ */
+static double prvHostTime( void );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The wire, and the end of it owned by this process. */
+static int iWire[ 2 ];
+static int iEnd = 0;
+
+/* The child process, in the parent. */
+static pid_t xClientPid = 0;
+
+/* The amount of data to send. */
+static uint64_t ullBytes = ( uint64_t ) iperfDEFAULT_MEGABYTES * 1024ULL * 1024ULL;
+
+/* The network interface of this process. */
+static struct netif xNetIf;
+
+/* The exit code of this process. */
+static int iResult = 1;
+
+/* The copy of the pattern the client sends from. */
+static uint8_t ucPattern[ iperfPATTERN_PERIOD ];
+
+#if LWIP_TCP_ZEROCOPY
+
+/* Zero-copy buffer x is the part of ucPattern at x * iperfZEROCOPY_BUFFER_SIZE.
+It is in flight from when tcp_write_pbuf() queues it until its free function
+is called, which must not be before the sequence number in ulZeroCopyEnd[ x ]
+has been acknowledged. */
+static struct pbuf_custom xZeroCopyBuffers[ iperfZEROCOPY_BUFFERS ];
+static BaseType_t xZeroCopyInFlight[ iperfZEROCOPY_BUFFERS ];
+static u32_t ulZeroCopyEnd[ iperfZEROCOPY_BUFFERS ];
+
+/* The connection's pcb, the number of buffers to send, and what
+tcp_write_pbuf() last returned. */
+static struct tcp_pcb *pxZeroCopyPcb;
+static unsigned long ulZeroCopyBuffers;
+static err_t xZeroCopyError;
+
+/* Given when prvZeroCopyWrite() has run, and when a buffer completes. */
+static sys_sem_t xZeroCopyWritten, xZeroCopySent;
+
+/* The buffers queued and completed, those completed before their data was
+acknowledged, and completions of buffers that were not in flight. */
+static volatile unsigned long ulZeroCopyQueued = 0UL, ulZeroCopyCompleted = 0UL, ulZeroCopyEarly = 0UL, ulZeroCopyUnexpected = 0UL;
+
+#endif /* LWIP_TCP_ZEROCOPY */
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartIperf( int argc, char *argv[] )
+{
+xVWireImpairment xImpairment;
+int iReturn;
+
+	if( argc > 0 )
+	{
+		ullBytes = ( uint64_t ) strtoul( argv[ 0 ], NULL, 0 ) * 1024ULL * 1024ULL;
+	}
+
+	if( argc > 1 )
+	{
+		memset( &xImpairment, 0x00, sizeof( xImpairment ) );
+		xImpairment.ulDelayMs = strtoul( argv[ 1 ], NULL, 0 );
+
+		if( argc > 2 )
+		{
+			xImpairment.ulLossPerMillion = strtoul( argv[ 2 ], NULL, 0 );
+		}
+
+		if( argc > 3 )
+		{
+			xImpairment.ulRateKbps = strtoul( argv[ 3 ], NULL, 0 );
+		}
+
+		if( argc > 4 )
+		{
+			xImpairment.ulQueueFrames = strtoul( argv[ 4 ], NULL, 0 );
+		}
+
+		/* A fixed seed, so a run that fails can be repeated. */
+		xImpairment.uiSeed = 1U;
+		iReturn = vwire_create_impaired( iWire, &xImpairment );
+	}
+	else
+	{
+		iReturn = vwire_create( iWire );
+	}
+
+	if( iReturn != 0 )
+	{
+		perror( "iperf: cannot create the wire" );
+		return pdFAIL;
+	}
+
+	/* Nothing may be buffered in stdout when the process is duplicated. */
+	fflush( stdout );
+	xClientPid = fork();
+
+	if( xClientPid < 0 )
+	{
+		perror( "iperf: cannot fork" );
+		return pdFAIL;
+	}
+
+	/* The parent is the server, at 10.0.0.1.  The child is the client, at
+	10.0.0.2. */
+	iEnd = ( xClientPid == 0 ) ? 1 : 0;
+	close( iWire[ 1 - iEnd ] );
+
+	return xTaskCreate( prvIperfTask, "Iperf", iperfTASK_STACK_SIZE, NULL, iperfTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iIperfFinish( void )
+{
+int iStatus;
+
+	if( xClientPid > 0 )
+	{
+		/* Fail the test if the client failed, even if the server did not
+		notice. */
+		if( waitpid( xClientPid, &iStatus, 0 ) != xClientPid )
+		{
+			iResult = 1;
+		}
+		else if( !WIFEXITED( iStatus ) || ( WEXITSTATUS( iStatus ) != 0 ) )
+		{
+			iResult = 1;
+		}
+	}
+
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIperfTask( void *pvParameters )
+{
+sys_sem_t xStarted;
+ip_addr_t xIPAddr, xNetMask, xGateway;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	/* Start the tcpip thread, and wait for it to be ready. */
+	sys_sem_new( &xStarted, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xStarted );
+	sys_sem_wait( &xStarted );
+	sys_sem_free( &xStarted );
+
+	IP4_ADDR( &xIPAddr, 10, 0, 0, iEnd + 1 );
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	netif_add( &xNetIf, &xIPAddr, &xNetMask, &xGateway, &iWire[ iEnd ], vwire_init, tcpip_input );
+	netif_set_default( &xNetIf );
+	netif_set_up( &xNetIf );
+
+	if( iEnd == 0 )
+	{
+		iResult = prvServer();
+	}
+	else
+	{
+		iResult = prvClient();
+	}
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static int prvServer( void )
+{
+struct netconn *pxListener, *pxConnection;
+struct netbuf *pxBuffer;
+void *pvData;
+u16_t usLength, x;
+uint64_t ullReceived = 0ULL, ullMismatch = 0ULL;
+uint8_t *pucData, ucStatus;
+double dStart = 0.0, dSeconds;
+TickType_t xStart = 0;
+err_t xError = ERR_OK;
+int iReturn;
+
+	pxListener = netconn_new( NETCONN_TCP );
+	configASSERT( pxListener );
+	netconn_bind( pxListener, IP_ADDR_ANY, iperfPORT );
+	netconn_listen( pxListener );
+	netconn_set_recvtimeout( pxListener, iperfTIMEOUT_MS );
+
+	xError = netconn_accept( pxListener, &pxConnection );
+	netconn_delete( pxListener );
+
+	if( xError != ERR_OK )
+	{
+		printf( "iperf: no connection, error %d\r\n", ( int ) xError );
+		return 1;
+	}
+
+	netconn_set_recvtimeout( pxConnection, iperfTIMEOUT_MS );
+
+	while( ( ullReceived < ullBytes ) && ( ( xError = netconn_recv( pxConnection, &pxBuffer ) ) == ERR_OK ) )
+	{
+		if( ullReceived == 0ULL )
+		{
+			dStart = prvHostTime();
+			xStart = xTaskGetTickCount();
+		}
+
+		do
+		{
+			netbuf_data( pxBuffer, &pvData, &usLength );
+			pucData = ( uint8_t * ) pvData;
+
+			for( x = 0; x < usLength; x++ )
+			{
+				if( pucData[ x ] != iperfPATTERN( ullReceived + x ) )
+				{
+					if( ullMismatch == 0ULL )
+					{
+						printf( "iperf: first mismatch at offset %llu\r\n", ( unsigned long long ) ( ullReceived + x ) );
+					}
+
+					ullMismatch++;
+				}
+			}
+
+			ullReceived += usLength;
+		} while( netbuf_next( pxBuffer ) >= 0 );
+
+		netbuf_delete( pxBuffer );
+	}
+
+	dSeconds = prvHostTime() - dStart;
+	xStart = xTaskGetTickCount() - xStart;
+	iReturn = ( ( xError == ERR_OK ) && ( ullReceived == ullBytes ) && ( ullMismatch == 0ULL ) ) ? 0 : 1;
+
+	if( xError == ERR_OK )
+	{
+		/* Tell the client the result, then wait for it to close the
+		connection.  Its close is not needed for the result, so a timeout
+		here is not an error. */
+		ucStatus = ( uint8_t ) iReturn;
+		xError = netconn_write( pxConnection, &ucStatus, sizeof( ucStatus ), NETCONN_COPY );
+
+		while( netconn_recv( pxConnection, &pxBuffer ) == ERR_OK )
+		{
+			netbuf_delete( pxBuffer );
+		}
+	}
+	else
+	{
+		printf( "iperf: receive failed, error %d\r\n", ( int ) xError );
+	}
+
+	netconn_close( pxConnection );
+	netconn_delete( pxConnection );
+
+	printf( "iperf: received %llu of %llu bytes, %llu wrong, in %.3f s host time (%.1f Mbit/s) and %u ms virtual time (%.1f Mbit/s)\r\n",
+			( unsigned long long ) ullReceived, ( unsigned long long ) ullBytes, ( unsigned long long ) ullMismatch,
+			dSeconds, ( dSeconds > 0.0 ) ? ( ( double ) ullReceived * 8.0 / dSeconds / 1e6 ) : 0.0,
+			( unsigned int ) ( xStart * portTICK_PERIOD_MS ),
+			( xStart > 0 ) ? ( ( double ) ullReceived * 8.0 / ( ( double ) ( xStart * portTICK_PERIOD_MS ) / 1000.0 ) / 1e6 ) : 0.0 );
+
+	return iReturn;
+}
+/*-----------------------------------------------------------*/
+
+static int prvClient( void )
+{
+struct netconn *pxConnection = NULL;
+struct netbuf *pxBuffer;
+ip_addr_t xServer;
+size_t x;
+int iAttempt;
+uint8_t ucStatus = 1U;
+err_t xError = ERR_CONN;
+double dStart, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	IP4_ADDR( &xServer, 10, 0, 0, 1 );
+
+	for( x = 0; x < sizeof( ucPattern ); x++ )
+	{
+		ucPattern[ x ] = iperfPATTERN( x );
+	}
+
+	/* The server may not be listening yet. */
+	for( iAttempt = 0; ( iAttempt < iperfCONNECT_ATTEMPTS ) && ( xError != ERR_OK ); iAttempt++ )
+	{
+		if( pxConnection != NULL )
+		{
+			netconn_delete( pxConnection );
+			vTaskDelay( iperfCONNECT_RETRY_DELAY );
+		}
+
+		pxConnection = netconn_new( NETCONN_TCP );
+		configASSERT( pxConnection );
+		xError = netconn_connect( pxConnection, &xServer, iperfPORT );
+	}
+
+	if( xError != ERR_OK )
+	{
+		printf( "iperf: cannot connect, error %d\r\n", ( int ) xError );
+		netconn_delete( pxConnection );
+		return 1;
+	}
+
+	dStart = prvCPUTime();
+
+	#if LWIP_TCP_ZEROCOPY
+	{
+		xError = prvSendZeroCopy( pxConnection );
+	}
+	#else
+	{
+		xError = prvSendCopy( pxConnection );
+	}
+	#endif
+
+	if( xError == ERR_OK )
+	{
+		/* Wait for the server to report that all the data arrived intact. */
+		netconn_set_recvtimeout( pxConnection, iperfTIMEOUT_MS );
+		xError = netconn_recv( pxConnection, &pxBuffer );
+
+		if( xError == ERR_OK )
+		{
+			netbuf_copy( pxBuffer, &ucStatus, sizeof( ucStatus ) );
+			netbuf_delete( pxBuffer );
+		}
+		else
+		{
+			printf( "iperf: no status from the server, error %d\r\n", ( int ) xError );
+		}
+	}
+	else
+	{
+		printf( "iperf: write failed, error %d\r\n", ( int ) xError );
+	}
+
+	#if LWIP_TCP_ZEROCOPY
+	{
+		/* Before the pcb goes. */
+		xPassed = prvCheckZeroCopy();
+	}
+	#endif
+
+	dSeconds = prvCPUTime() - dStart;
+
+	if( ucStatus == 0U )
+	{
+		printf( "iperf: client used %.1f us CPU per megabyte sent with %s\r\n", ( dSeconds * 1e6 ) / ( ( double ) ullBytes / ( 1024.0 * 1024.0 ) ),
+				LWIP_TCP_ZEROCOPY ? "tcp_write_pbuf()" : "netconn_write()" );
+	}
+
+	netconn_close( pxConnection );
+	netconn_delete( pxConnection );
+
+	return ( ( ucStatus == 0U ) && ( xPassed == pdPASS ) ) ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+#if !LWIP_TCP_ZEROCOPY
+
+static err_t prvSendCopy( struct netconn *pxConnection )
+{
+uint64_t ullSent = 0ULL;
+size_t xLength;
+err_t xError = ERR_OK;
+
+	while( ( ullSent < ullBytes ) && ( xError == ERR_OK ) )
+	{
+		xLength = iperfWRITE_SIZE;
+
+		if( ( ullBytes - ullSent ) < ( uint64_t ) xLength )
+		{
+			xLength = ( size_t ) ( ullBytes - ullSent );
+		}
+
+		xError = netconn_write( pxConnection, &ucPattern[ ullSent % iperfPATTERN_PERIOD ], xLength, NETCONN_COPY );
+		ullSent += xLength;
+	}
+
+	return xError;
+}
+/*-----------------------------------------------------------*/
+
+#else /* LWIP_TCP_ZEROCOPY */
+
+static err_t prvSendZeroCopy( struct netconn *pxConnection )
+{
+err_t xError = ERR_OK;
+
+	pxZeroCopyPcb = pxConnection->pcb.tcp;
+	ulZeroCopyBuffers = ( unsigned long ) ( ( ullBytes + iperfZEROCOPY_BUFFER_SIZE - 1ULL ) / iperfZEROCOPY_BUFFER_SIZE );
+	sys_sem_new( &xZeroCopyWritten, 0 );
+	sys_sem_new( &xZeroCopySent, 0 );
+
+	/* tcp_write_pbuf() is part of the raw API, so it is called in the tcpip
+	thread, which queues as many buffers as it can each time. */
+	while( ( ulZeroCopyQueued < ulZeroCopyBuffers ) && ( xError == ERR_OK ) )
+	{
+		tcpip_callback( prvZeroCopyWrite, NULL );
+		sys_sem_wait( &xZeroCopyWritten );
+
+		if( ( xZeroCopyError != ERR_OK ) && ( xZeroCopyError != ERR_MEM ) )
+		{
+			xError = xZeroCopyError;
+		}
+		else if( ulZeroCopyQueued < ulZeroCopyBuffers )
+		{
+			xError = prvWaitForZeroCopySent();
+		}
+	}
+
+	return xError;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyWrite( void *pvParameters )
+{
+size_t xBuffer;
+u16_t usLength;
+struct pbuf *p;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	/* Stops when the send buffer is full (ERR_MEM), or at a buffer still in
+	flight from the last time round the pattern. */
+	xZeroCopyError = ERR_OK;
+
+	while( ( ulZeroCopyQueued < ulZeroCopyBuffers ) && ( xZeroCopyError == ERR_OK ) )
+	{
+		xBuffer = ( size_t ) ( ulZeroCopyQueued % iperfZEROCOPY_BUFFERS );
+
+		if( xZeroCopyInFlight[ xBuffer ] != pdFALSE )
+		{
+			break;
+		}
+
+		usLength = iperfZEROCOPY_BUFFER_SIZE;
+
+		if( ( ullBytes - ( ( uint64_t ) ulZeroCopyQueued * iperfZEROCOPY_BUFFER_SIZE ) ) < ( uint64_t ) usLength )
+		{
+			usLength = ( u16_t ) ( ullBytes - ( ( uint64_t ) ulZeroCopyQueued * iperfZEROCOPY_BUFFER_SIZE ) );
+		}
+
+		p = pbuf_alloced_custom( PBUF_RAW, usLength, PBUF_REF, &xZeroCopyBuffers[ xBuffer ],
+								 &ucPattern[ xBuffer * iperfZEROCOPY_BUFFER_SIZE ], iperfZEROCOPY_BUFFER_SIZE );
+		configASSERT( p );
+		xZeroCopyBuffers[ xBuffer ].custom_free_function = prvZeroCopySent;
+
+		/* If this fails nothing references p, which is set up again next
+		time. */
+		xZeroCopyError = tcp_write_pbuf( pxZeroCopyPcb, p, 0 );
+
+		if( xZeroCopyError == ERR_OK )
+		{
+			ulZeroCopyEnd[ xBuffer ] = pxZeroCopyPcb->snd_lbb;
+			xZeroCopyInFlight[ xBuffer ] = pdTRUE;
+			ulZeroCopyQueued++;
+
+			/* The segments hold their own references to the buffer now. */
+			pbuf_free( p );
+		}
+	}
+
+	tcp_output( pxZeroCopyPcb );
+	sys_sem_signal( &xZeroCopyWritten );
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopySent( struct pbuf *p )
+{
+size_t xBuffer = ( size_t ) ( ( struct pbuf_custom * ) p - xZeroCopyBuffers );
+
+	if( xZeroCopyInFlight[ xBuffer ] == pdFALSE )
+	{
+		ulZeroCopyUnexpected++;
+	}
+	else
+	{
+		if( ( s32_t ) ( pxZeroCopyPcb->lastack - ulZeroCopyEnd[ xBuffer ] ) < 0 )
+		{
+			ulZeroCopyEarly++;
+		}
+
+		xZeroCopyInFlight[ xBuffer ] = pdFALSE;
+		ulZeroCopyCompleted++;
+	}
+
+	sys_sem_signal( &xZeroCopySent );
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvWaitForZeroCopySent( void )
+{
+	return ( sys_arch_sem_wait( &xZeroCopySent, iperfTIMEOUT_MS ) == SYS_ARCH_TIMEOUT ) ? ERR_TIMEOUT : ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckZeroCopy( void )
+{
+	while( ( ulZeroCopyCompleted < ulZeroCopyQueued ) && ( prvWaitForZeroCopySent() == ERR_OK ) )
+	{
+		/* Wait for the acknowledgements still to come. */
+	}
+
+	printf( "iperf: %lu buffers sent with tcp_write_pbuf(), %lu completed, %lu before they were acknowledged, %lu more than once\r\n",
+			ulZeroCopyQueued, ulZeroCopyCompleted, ulZeroCopyEarly, ulZeroCopyUnexpected );
+
+	if( ( ulZeroCopyQueued != ulZeroCopyBuffers ) ||
+		( ulZeroCopyCompleted != ulZeroCopyQueued ) || ( ulZeroCopyEarly != 0UL ) || ( ulZeroCopyUnexpected != 0UL ) )
+	{
+		printf( "iperf: zero-copy send completions FAILED\r\n" );
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* LWIP_TCP_ZEROCOPY */
+
+static double prvHostTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,177 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * lwIP options for the lwIP on POSIX simulator demo.  The options that size
+ * the TCP window, the send buffer and the mailboxes can be overridden from the
+ * make command line.  The bigwnd build in the makefile, for example, is made
+ * with:
+ *
+ *     make OBJ_DIR=obj/bigwnd PROGRAM=obj/bigwnd/lwIPDemo EXTRA_CFLAGS="-DLWIP_WND_SCALE=1 -DTCP_RCV_SCALE=2 '-DTCP_WND=(128*TCP_MSS)' '-DTCP_SND_BUF=(128*TCP_MSS)' -DTCPIP_MBOX_SIZE=1024 -DDEFAULT_TCP_RECVMBOX_SIZE=256"
+ *
+ * The options are passed to the shell unquoted, so the parentheses must be
+ * quoted.  TCP_SND_BUF must grow with TCP_WND, as otherwise the sending copy
+ * of the stack cannot fill the window the receiving one offers.  With the
+ * window alone raised to 128 segments iperf runs at a third of the speed it
+ * does with the defaults, or less.
+ */
+
+#ifndef __LWIPOPTS_H__
+#define __LWIPOPTS_H__
+
+/* The host's sys/time.h defines struct timeval. */
+#include <sys/time.h>
+#define LWIP_TIMEVAL_PRIVATE			0
+
+/* ---------- Threads ---------- */
+#define NO_SYS							0
+#define TCPIP_THREAD_NAME				"tcpip"
+#define TCPIP_THREAD_PRIO				( configMAX_PRIORITIES - 2 )
+#define TCPIP_THREAD_STACKSIZE			1024
+#define DEFAULT_THREAD_STACKSIZE		1024
+#ifndef TCPIP_MBOX_SIZE
+	#define TCPIP_MBOX_SIZE				256
+#endif
+
+#ifndef DEFAULT_TCP_RECVMBOX_SIZE
+	#define DEFAULT_TCP_RECVMBOX_SIZE	64
+#endif
+
+#define DEFAULT_UDP_RECVMBOX_SIZE		64
+#define DEFAULT_ACCEPTMBOX_SIZE			16
+
+/* ---------- APIs ---------- */
+#define LWIP_NETCONN					1
+#define LWIP_SOCKET						1
+#define LWIP_SO_RCVTIMEO				1
+#define LWIP_SO_RCVBUF					1
+/* lwip_poll() and the epoll-style calls, tested by polltest.c. */
+#define LWIP_SOCKET_POLL				1
+#define LWIP_SOCKET_EPOLL				1
+#define LWIP_DHCP						0
+#define LWIP_DNS						0
+#define LWIP_IGMP						0
+
+/* ---------- Memory ---------- */
+#define MEM_ALIGNMENT					4
+#define MEM_SIZE						( 4 * 1024 * 1024 )
+#define MEMP_NUM_PBUF					256
+/* Enough for the 256 pcbs of udpdemux.c. */
+#define MEMP_NUM_UDP_PCB				300
+/* Enough for the 256 connections, and the pcbs they leave in TIME-WAIT, of
+the benchmark in tcpdemux.c. */
+#define MEMP_NUM_TCP_PCB				640
+#define MEMP_NUM_TCP_PCB_LISTEN			8
+#define MEMP_NUM_TCP_SEG				1024
+#define MEMP_NUM_SYS_TIMEOUT			16
+#define MEMP_NUM_NETBUF					256
+/* Enough for the two ends of the 244 connections of polltest.c. */
+#define MEMP_NUM_NETCONN				512
+#define MEMP_NUM_TCPIP_MSG_API			64
+#define MEMP_NUM_TCPIP_MSG_INPKT		512
+#define MEMP_NUM_ARP_QUEUE				64
+#define PBUF_POOL_SIZE					1024
+#define PBUF_POOL_BUFSIZE				1600
+
+/* ---------- IP ---------- */
+/* Needed by the forwarding test in rxbench.c. */
+#define IP_FORWARD						1
+
+/* ---------- Link layer ---------- */
+/* Keep the IP header 4 byte aligned behind the 14 byte Ethernet header. */
+#define ETH_PAD_SIZE					2
+
+/* Receive into the buffers of a modelled descriptor ring (see netif/rxring.h
+and netif/hostif.h), rather than into pool pbufs. */
+#define LWIP_NETIF_RXRING				1
+
+/* rxbench.c adds its peers to the ARP table rather than answering ARP
+requests. */
+#define ETHARP_SUPPORT_STATIC_ENTRIES	1
+
+/* ---------- TCP ---------- */
+#define TCP_MSS							1460
+
+#ifndef TCP_WND
+	#define TCP_WND						( 32 * TCP_MSS )
+#endif
+
+#ifndef TCP_SND_BUF
+	#define TCP_SND_BUF					( 32 * TCP_MSS )
+#endif
+
+#define TCP_SND_QUEUELEN				( 4 * ( TCP_SND_BUF ) / ( TCP_MSS ) )
+
+#ifndef LWIP_TCP_SACK
+	#define LWIP_TCP_SACK				1
+#endif
+
+/* ---------- Statistics ---------- */
+#define LWIP_STATS						1
+#define LWIP_STATS_DISPLAY				0
+/* 32 bit counters, as tcpdemux.c counts more than 65535 segments. */
+#define LWIP_STATS_LARGE				1
+
+#endif /* __LWIPOPTS_H__ */
@@ -0,0 +1,269 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ *******************************************************************************
+ * NOTE: This demo uses the POSIX simulator port, which runs every task on a
+ * single host thread and measures time in virtual ticks.  See the comments at
+ * the top of Demo/Posix_GCC_Simulator/main.c.
+ *******************************************************************************
+ *
+ * A host build of the lwIP TCP/IP stack running on FreeRTOS, using the Linux
+ * lwIP port in Demo/Common/ethernet/lwip-1.4.0/ports/linux.  It needs no
+ * network hardware and no host configuration, so it can be run by a CI job
+ * ("make check").  Usage:
+ *
+ *     lwIPDemo iperf [megabytes [delay_ms [loss_per_million [rate_kbps [queue_frames]]]]]
+ *     lwIPDemo rxbench [frames [payload_bytes [held_datagrams]]]
+ *     lwIPDemo tcpdemux [connections...]
+ *     lwIPDemo udpdemux [datagrams]
+ *     lwIPDemo arptest
+ *     lwIPDemo rrbench [round_trips [connections [message_bytes]]]
+ *     lwIPDemo polltest [idle_connections [round_trips]]
+ *
+ * iperf - Measures TCP throughput between two copies of the stack joined by a
+ * virtual wire, optionally impaired to behave like a long or lossy path.  See
+ * iperf.c.
+ *
+ * rxbench - Tests the receive descriptor ring, then measures the packets per
+ * second the stack receives with and without it.  See rxbench.c.
+ *
+ * tcpdemux - Opens and closes thousands of TCP connections, checking the pcb
+ * lists and hash tables, then measures the segments per second the stack
+ * receives with different numbers of connections open.  See tcpdemux.c.
+ *
+ * udpdemux - Checks which UDP pcb receives each datagram, then measures the
+ * datagrams per second the stack receives with 256 pcbs bound.  See
+ * udpdemux.c.
+ *
+ * arptest - Fills the ARP table past its capacity, checking which entries are
+ * recycled, and checks the hint each interface keeps of the neighbour it last
+ * sent to.  See arptest.c.
+ *
+ * rrbench - Tests connect, send, recv and close through the sockets API, then
+ * measures the request/response latency of small messages.  See rrbench.c.
+ *
+ * polltest - Tests select, poll and the epoll-style calls of the sockets API
+ * with many idle connections and a few active ones, then measures the round
+ * trip of a small message with each.  See polltest.c.
+ *
+ * The process exit code is 0 if the test passed, 1 if it failed and 2 if an
+ * assertion failed.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "iperf.h"
+#include "rxbench.h"
+#include "tcpdemux.h"
+#include "udpdemux.h"
+#include "arptest.h"
+#include "rrbench.h"
+#include "polltest.h"
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Prototypes for the standard FreeRTOS callback/hook functions implemented
+ * within this file.
+ */
+void vApplicationMallocFailedHook( void );
+
+/*
+ * Print the usage message.
+ */
+static void prvUsage( const char *pcName );
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "iperf" ) == 0 ) )
+	{
+		if( xStartIperf( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		/* Start the scheduler itself.  This returns when the test ends the
+		scheduler. */
+		vTaskStartScheduler();
+
+		return iIperfFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "rxbench" ) == 0 ) )
+	{
+		if( xStartRxBench( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iRxBenchFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "tcpdemux" ) == 0 ) )
+	{
+		if( xStartTcpDemux( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iTcpDemuxFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "udpdemux" ) == 0 ) )
+	{
+		if( xStartUdpDemux( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iUdpDemuxFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "arptest" ) == 0 ) )
+	{
+		if( xStartArpTest( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iArpTestFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "rrbench" ) == 0 ) )
+	{
+		if( xStartRrBench( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iRrBenchFinish();
+	}
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "polltest" ) == 0 ) )
+	{
+		if( xStartPollTest( argc - 2, &argv[ 2 ] ) != pdPASS )
+		{
+			return 1;
+		}
+
+		vTaskStartScheduler();
+
+		return iPollTestFinish();
+	}
+
+	prvUsage( argv[ 0 ] );
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUsage( const char *pcName )
+{
+	printf( "usage: %s iperf [megabytes [delay_ms [loss_per_million [rate_kbps [queue_frames]]]]]\r\n", pcName );
+	printf( "       %s rxbench [frames [payload_bytes [held_datagrams]]]\r\n", pcName );
+	printf( "       %s tcpdemux [connections...]\r\n", pcName );
+	printf( "       %s udpdemux [datagrams]\r\n", pcName );
+	printf( "       %s arptest\r\n", pcName );
+	printf( "       %s rrbench [round_trips [connections [message_bytes]]]\r\n", pcName );
+	printf( "       %s polltest [idle_connections [round_trips]]\r\n", pcName );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* Called if a call to pvPortMalloc() fails because there is insufficient
+	free memory available in the FreeRTOS heap. */
+	vAssertCalled( __LINE__, __FILE__ );
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName )
+{
+	/* Report the failure and exit, failing the test. */
+	printf( "ASSERT! Line %lu, file %s\r\n", ulLine, pcFileName );
+	fflush( stdout );
+	exit( 2 );
+}
+/*-----------------------------------------------------------*/
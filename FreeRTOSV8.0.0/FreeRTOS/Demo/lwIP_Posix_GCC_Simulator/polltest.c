@@ -0,0 +1,1087 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests and a benchmark of lwip_select(), lwip_poll() and the epoll-style
+ * calls (LWIP_SOCKET_POLL and LWIP_SOCKET_EPOLL in lwip/opt.h) with many idle
+ * connections and a few active ones.
+ *
+ * As in rrbench.c, a single interface, 10.0.9.1/24, passes every frame it
+ * sends back to its own input through tcpip_input(), so both ends of each
+ * connection are in this process.  polltestACTIVE active connections are
+ * opened first, then the idle ones, so the active sockets have the lowest
+ * numbers.  A server task waits for the server ends of the connections with
+ * one of the three calls and echoes what it receives, reading at most
+ * polltestSERVER_BUFFER bytes at a time and never blocking in recv().  The
+ * tests check that:
+ *
+ * - lwip_poll() and lwip_epoll_wait() time out when nothing is ready, report
+ *   a socket that can be written and an invalid socket, and wake up when data
+ *   arrives,
+ * - the epoll calls refuse to add a socket twice or to two instances, report
+ *   a socket for as long as it has data (level-triggered), follow a change of
+ *   events and stop reporting a socket once it is deleted, or once its
+ *   instance is closed,
+ * - with each call, messages sent on all the active connections at once come
+ *   back unchanged, although they are longer than the server reads at a time
+ *   and although lwip_epoll_wait() returns fewer events than there are
+ *   sockets ready,
+ * - with each call, the server sees idle connections closed by the client,
+ * - the server is never woken for a socket it then finds nothing to read on.
+ *
+ * The benchmark measures, in host CPU time, a round trip of a small message on
+ * one connection while the server waits for the active connections only, then
+ * for the idle ones as well.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/sockets.h"
+#include "lwip/tcpip.h"
+#include "netif/etharp.h"
+
+/* Demo includes. */
+#include "polltest.h"
+
+#if !LWIP_SOCKET_POLL || !LWIP_SOCKET_EPOLL
+	#error polltest.c needs LWIP_SOCKET_POLL and LWIP_SOCKET_EPOLL set in lwipopts.h
+#endif
+
+/* The port the connections are made to. */
+#define polltestPORT					7
+
+/* The active connections, and the most idle ones (each connection uses two
+sockets, see MEMP_NUM_NETCONN in lwipopts.h). */
+#define polltestACTIVE					4
+#define polltestMAX_IDLE				240
+#define polltestMAX_CONNECTIONS			( polltestACTIVE + polltestMAX_IDLE )
+
+/* Defaults used when the arguments are not given on the command line. */
+#define polltestDEFAULT_IDLE			200UL
+#define polltestDEFAULT_ROUND_TRIPS		10000UL
+
+/* The size of the messages of the benchmark, and of those sent on all the
+active connections at once, which is more than the server reads at a
+time. */
+#define polltestMESSAGE_BYTES			32
+#define polltestBURST_BYTES				100
+#define polltestBURSTS					200
+#define polltestSERVER_BUFFER			64
+
+/* The events lwip_epoll_wait() returns at most, fewer than the active
+connections. */
+#define polltestMAX_EVENTS				2
+
+/* The timeout tested, how long the server waits before it looks whether it
+has been asked to stop, how long the client waits for an echo and how long it
+waits for the server to see a close. */
+#define polltestTIMEOUT_MS				50
+#define polltestSERVER_WAIT_MS			200
+#define polltestRECV_TIMEOUT_MS			2000
+#define polltestCLOSE_WAIT_MS			1000UL
+
+/* The idle connections each call is shown closed. */
+#define polltestCLOSES					2
+
+/* Marks the socket added to an epoll instance by the tests. */
+#define polltestEPOLL_DATA				0x5a5aUL
+
+/* Priority and stack size of the client and server tasks. */
+#define polltestTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define polltestTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/*-----------------------------------------------------------*/
+
+/* The calls the server can wait with. */
+typedef enum
+{
+	eSelect = 0,
+	ePoll,
+	eEpoll,
+	eMechanisms
+} Mechanism_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, adds the interface and opens the connections, then
+ * runs the tests and the benchmark as the client.
+ */
+static void prvPollTestTask( void *pvParameters );
+
+/*
+ * The server.  Waits with the call in eServerMechanism for the first
+ * xServerConnections connections, until it has echoed a message on the first
+ * connection that was sent after xStopServer was set.
+ */
+static void prvServerTask( void *pvParameters );
+
+/*
+ * Reads what connection xConnection has to read and echoes it, or closes the
+ * connection if the client closed it - called by the server.
+ */
+static void prvServe( size_t xConnection );
+
+/*
+ * Starts the server, and stops it by sending it one more message.
+ * prvStopServer() returns pdPASS if the server echoed the message and saw no
+ * error.
+ */
+static void prvStartServer( Mechanism_t eMechanism, size_t xConnections );
+static BaseType_t prvStopServer( void );
+
+/*
+ * Adds the interface - runs in the tcpip thread.
+ */
+static void prvAddNetIf( void *pvParameters );
+
+/*
+ * The tests.  Each returns pdPASS if it passed.
+ */
+static BaseType_t prvTestPoll( void );
+static BaseType_t prvTestEpoll( void );
+static BaseType_t prvTestBurst( Mechanism_t eMechanism );
+static BaseType_t prvTestClose( Mechanism_t eMechanism, size_t xFirstIdle );
+
+/*
+ * Measures and prints the time taken by a round trip on the first connection
+ * while the server waits for xConnections connections.  Returns pdPASS if
+ * every message came back unchanged.
+ */
+static BaseType_t prvMeasure( Mechanism_t eMechanism, size_t xConnections );
+
+/*
+ * Creates a socket listening on polltestPORT.
+ */
+static int prvListen( void );
+
+/*
+ * Creates a socket connected to polltestPORT, with TCP_NODELAY set.  Returns
+ * the socket, or -1 if the connect failed.
+ */
+static int prvConnect( void );
+
+/*
+ * Sends xLength bytes of pucMessage, and checks the same bytes come back.
+ * Returns pdPASS if they did.
+ */
+static BaseType_t prvRoundTrip( int iSocket, const u8_t *pucMessage, size_t xLength );
+
+/*
+ * Sends all of xLength bytes.  Returns pdPASS if they were sent.
+ */
+static BaseType_t prvSendAll( int iSocket, const u8_t *pucData, size_t xLength );
+
+/*
+ * Receives xLength bytes and checks they are those of pucExpected.  Returns
+ * pdPASS if they were.
+ */
+static BaseType_t prvReceiveAll( int iSocket, const u8_t *pucExpected, size_t xLength );
+
+/*
+ * Returns the ticks passed since xStart, in milliseconds.
+ */
+static unsigned long prvMillisecondsSince( TickType_t xStart );
+
+/*
+ * Network interface callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The interface and its address. */
+static struct netif xNetIf;
+static ip_addr_t xAddress;
+
+/* Frames the interface could not pass back to its input. */
+static volatile unsigned long ulDropped = 0UL;
+
+/* The client and server ends of the connections, the active ones first.  A
+server end is set to -1 once the server has closed it. */
+static int iClient[ polltestMAX_CONNECTIONS ], iServer[ polltestMAX_CONNECTIONS ];
+
+/* What the server waits with and for, the flag that stops it and whether it
+has echoed the message sent after the flag was set. */
+static Mechanism_t eServerMechanism;
+static size_t xServerConnections;
+static volatile BaseType_t xStopServer;
+static BaseType_t xServerStopping;
+
+/* Given by the server when it stops. */
+static sys_sem_t xServerStopped;
+
+/* The connections the server has seen closed by the client, the times it was
+woken for a socket with nothing to read, and the calls that failed. */
+static volatile unsigned long ulServerClosed = 0UL, ulServerSpurious = 0UL, ulServerErrors = 0UL;
+
+/* The messages sent, and the buffer they come back to. */
+static u8_t ucMessage[ polltestACTIVE + polltestBURST_BYTES ], ucReply[ polltestBURST_BYTES ];
+
+/* The arguments. */
+static unsigned long ulIdle = polltestDEFAULT_IDLE;
+static unsigned long ulRoundTrips = polltestDEFAULT_ROUND_TRIPS;
+
+/* The names of the calls, for the output. */
+static const char * const pcMechanismNames[ eMechanisms ] = { "select", "poll", "epoll" };
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartPollTest( int argc, char *argv[] )
+{
+	if( argc > 0 )
+	{
+		ulIdle = strtoul( argv[ 0 ], NULL, 0 );
+	}
+
+	if( argc > 1 )
+	{
+		ulRoundTrips = strtoul( argv[ 1 ], NULL, 0 );
+	}
+
+	if( ulIdle > polltestMAX_IDLE )
+	{
+		printf( "polltest: at most %d idle connections\r\n", polltestMAX_IDLE );
+		return pdFAIL;
+	}
+
+	return xTaskCreate( prvPollTestTask, "PollTest", polltestTASK_STACK_SIZE, NULL, polltestTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iPollTestFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPollTestTask( void *pvParameters )
+{
+sys_sem_t xDone;
+BaseType_t xPassed = pdPASS;
+Mechanism_t eMechanism;
+size_t x, xConnections = polltestACTIVE + ( size_t ) ulIdle;
+int iListener, iOne = 1, iTimeout = polltestRECV_TIMEOUT_MS;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* netif_add() may only be called from the tcpip thread. */
+	tcpip_callback( prvAddNetIf, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	sys_sem_new( &xServerStopped, 0 );
+
+	for( x = 0; x < sizeof( ucMessage ); x++ )
+	{
+		ucMessage[ x ] = ( u8_t ) ( x * 7U );
+	}
+
+	/* Each connection is accepted as soon as it is made, so the server ends
+	are in the same order as the client ends. */
+	iListener = prvListen();
+
+	for( x = 0; ( x < xConnections ) && ( xPassed == pdPASS ); x++ )
+	{
+		iClient[ x ] = prvConnect();
+
+		if( iClient[ x ] < 0 )
+		{
+			printf( "polltest: connection %u failed\r\n", ( unsigned int ) x );
+			xPassed = pdFAIL;
+		}
+		else
+		{
+			iServer[ x ] = lwip_accept( iListener, NULL, NULL );
+			configASSERT( iServer[ x ] >= 0 );
+			lwip_setsockopt( iServer[ x ], IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof( iOne ) );
+			lwip_setsockopt( iClient[ x ], SOL_SOCKET, SO_RCVTIMEO, &iTimeout, sizeof( iTimeout ) );
+		}
+	}
+
+	if( ( xPassed != pdPASS ) || ( prvTestPoll() != pdPASS ) || ( prvTestEpoll() != pdPASS ) )
+	{
+		xPassed = pdFAIL;
+	}
+
+	/* With each call, the active connections only, then the idle ones as
+	well. */
+	for( eMechanism = eSelect; ( eMechanism < eMechanisms ) && ( xPassed == pdPASS ); eMechanism++ )
+	{
+		prvStartServer( eMechanism, polltestACTIVE );
+		xPassed = prvMeasure( eMechanism, polltestACTIVE );
+
+		if( prvStopServer() != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+
+		if( xPassed == pdPASS )
+		{
+			prvStartServer( eMechanism, xConnections );
+			xPassed = prvTestBurst( eMechanism );
+
+			if( xPassed == pdPASS )
+			{
+				xPassed = prvMeasure( eMechanism, xConnections );
+			}
+
+			if( prvStopServer() != pdPASS )
+			{
+				xPassed = pdFAIL;
+			}
+		}
+	}
+
+	/* Closes some of the idle connections, after the benchmark so that each
+	call is measured with the same connections open. */
+	for( eMechanism = eSelect; ( eMechanism < eMechanisms ) && ( xPassed == pdPASS ); eMechanism++ )
+	{
+		prvStartServer( eMechanism, xConnections );
+		xPassed = prvTestClose( eMechanism, polltestACTIVE + ( ( size_t ) eMechanism * polltestCLOSES ) );
+
+		if( prvStopServer() != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	if( ulDropped != 0UL )
+	{
+		printf( "polltest: %lu frames dropped\r\n", ulDropped );
+		xPassed = pdFAIL;
+	}
+
+	printf( "polltest: %s\r\n", ( xPassed == pdPASS ) ? "tests passed" : "FAILED" );
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvServerTask( void *pvParameters )
+{
+static struct pollfd xPollFds[ polltestMAX_CONNECTIONS ];
+struct epoll_event xEvent, xEvents[ polltestMAX_EVENTS ];
+struct timeval xWait;
+fd_set xReadSet;
+int iEpoll = -1, iMaxSocket = -1, iReady, i;
+size_t x;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	if( eServerMechanism == eEpoll )
+	{
+		iEpoll = lwip_epoll_create( 1 );
+		configASSERT( iEpoll >= 0 );
+	}
+
+	for( x = 0; x < xServerConnections; x++ )
+	{
+		if( iServer[ x ] > iMaxSocket )
+		{
+			iMaxSocket = iServer[ x ];
+		}
+
+		xPollFds[ x ].fd = iServer[ x ];
+		xPollFds[ x ].events = POLLIN;
+
+		if( ( iEpoll >= 0 ) && ( iServer[ x ] >= 0 ) )
+		{
+			xEvent.events = EPOLLIN;
+			xEvent.data.u32 = ( u32_t ) x;
+			configASSERT( lwip_epoll_ctl( iEpoll, EPOLL_CTL_ADD, iServer[ x ], &xEvent ) == 0 );
+		}
+	}
+
+	while( xServerStopping == pdFALSE )
+	{
+		switch( eServerMechanism )
+		{
+			case eSelect :
+
+				FD_ZERO( &xReadSet );
+
+				for( x = 0; x < xServerConnections; x++ )
+				{
+					if( iServer[ x ] >= 0 )
+					{
+						FD_SET( iServer[ x ], &xReadSet );
+					}
+				}
+
+				xWait.tv_sec = 0;
+				xWait.tv_usec = polltestSERVER_WAIT_MS * 1000;
+				iReady = lwip_select( iMaxSocket + 1, &xReadSet, NULL, NULL, &xWait );
+
+				for( x = 0; ( x < xServerConnections ) && ( iReady > 0 ); x++ )
+				{
+					if( ( iServer[ x ] >= 0 ) && FD_ISSET( iServer[ x ], &xReadSet ) )
+					{
+						iReady--;
+						prvServe( x );
+					}
+				}
+				break;
+
+			case ePoll :
+
+				iReady = lwip_poll( xPollFds, ( nfds_t ) xServerConnections, polltestSERVER_WAIT_MS );
+
+				for( x = 0; ( x < xServerConnections ) && ( iReady > 0 ); x++ )
+				{
+					if( xPollFds[ x ].revents != 0 )
+					{
+						iReady--;
+						prvServe( x );
+						xPollFds[ x ].fd = iServer[ x ];
+					}
+				}
+				break;
+
+			default :
+
+				/* Closing a socket removes it from the epoll instance. */
+				iReady = lwip_epoll_wait( iEpoll, xEvents, polltestMAX_EVENTS, polltestSERVER_WAIT_MS );
+
+				for( i = 0; i < iReady; i++ )
+				{
+					prvServe( ( size_t ) xEvents[ i ].data.u32 );
+				}
+				break;
+		}
+
+		if( iReady < 0 )
+		{
+			ulServerErrors++;
+			break;
+		}
+	}
+
+	if( iEpoll >= 0 )
+	{
+		lwip_close( iEpoll );
+	}
+
+	sys_sem_signal( &xServerStopped );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvServe( size_t xConnection )
+{
+static u8_t ucBuffer[ polltestSERVER_BUFFER ];
+int iReceived;
+BaseType_t xStop = xStopServer;
+
+	/* The socket was reported readable, so this does not block, and as the
+	buffer can be smaller than what arrived the socket can stay readable. */
+	iReceived = lwip_recv( iServer[ xConnection ], ucBuffer, sizeof( ucBuffer ), MSG_DONTWAIT );
+
+	if( iReceived > 0 )
+	{
+		if( prvSendAll( iServer[ xConnection ], ucBuffer, ( size_t ) iReceived ) != pdPASS )
+		{
+			ulServerErrors++;
+		}
+
+		/* The client only sets the flag once it has had the echo of every
+		message it sent before, so this is the message sent after. */
+		if( ( xStop != pdFALSE ) && ( xConnection == 0 ) )
+		{
+			xServerStopping = pdTRUE;
+		}
+	}
+	else if( iReceived == 0 )
+	{
+		lwip_close( iServer[ xConnection ] );
+		iServer[ xConnection ] = -1;
+		ulServerClosed++;
+	}
+	else
+	{
+		ulServerSpurious++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartServer( Mechanism_t eMechanism, size_t xConnections )
+{
+	eServerMechanism = eMechanism;
+	xServerConnections = xConnections;
+	xStopServer = pdFALSE;
+	xServerStopping = pdFALSE;
+	ulServerSpurious = 0UL;
+	ulServerErrors = 0UL;
+
+	xTaskCreate( prvServerTask, "Server", polltestTASK_STACK_SIZE, NULL, polltestTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStopServer( void )
+{
+BaseType_t xPassed;
+
+	/* The server may not have started to wait yet, so it is stopped by a
+	message rather than by the flag alone. */
+	xStopServer = pdTRUE;
+	xPassed = prvRoundTrip( iClient[ 0 ], ucMessage, 1 );
+
+	if( sys_arch_sem_wait( &xServerStopped, polltestRECV_TIMEOUT_MS ) == SYS_ARCH_TIMEOUT )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( ( xPassed != pdPASS ) || ( ulServerSpurious != 0UL ) || ( ulServerErrors != 0UL ) )
+	{
+		printf( "polltest: %s: %lu spurious wakeups, %lu errors\r\n", pcMechanismNames[ eServerMechanism ], ulServerSpurious, ulServerErrors );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddNetIf( void *pvParameters )
+{
+ip_addr_t xNetMask, xGateway;
+struct eth_addr xHardwareAddress;
+
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xAddress, 10, 0, 9, 1 );
+	netif_add( &xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, tcpip_input );
+	netif_set_up( &xNetIf );
+
+	/* The interface's own address, so it sends to itself without an ARP
+	request. */
+	SMEMCPY( &xHardwareAddress, xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	etharp_add_static_entry( &xAddress, &xHardwareAddress );
+
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestPoll( void )
+{
+struct pollfd xFds[ 4 ];
+TickType_t xStart;
+unsigned long ulWaited;
+int iReady;
+u8_t ucByte;
+
+	xFds[ 0 ].fd = iServer[ 0 ];
+	xFds[ 0 ].events = POLLIN;
+	xFds[ 1 ].fd = iClient[ 0 ];
+	xFds[ 1 ].events = POLLOUT;
+	xFds[ 2 ].fd = -1;
+	xFds[ 2 ].events = POLLIN;
+	xFds[ 3 ].fd = MEMP_NUM_NETCONN;
+	xFds[ 3 ].events = POLLIN;
+
+	xStart = xTaskGetTickCount();
+	iReady = lwip_poll( xFds, 1, polltestTIMEOUT_MS );
+	ulWaited = prvMillisecondsSince( xStart );
+
+	if( ( iReady != 0 ) || ( ulWaited < polltestTIMEOUT_MS ) )
+	{
+		printf( "polltest: poll: returned %d after %lu ms with nothing ready\r\n", iReady, ulWaited );
+		return pdFAIL;
+	}
+
+	/* The client end can be written, the negative fd is ignored and the
+	invalid one reported. */
+	iReady = lwip_poll( xFds, 4, 0 );
+
+	if( ( iReady != 2 ) || ( xFds[ 0 ].revents != 0 ) || ( xFds[ 1 ].revents != POLLOUT ) || ( xFds[ 2 ].revents != 0 ) || ( xFds[ 3 ].revents != POLLNVAL ) )
+	{
+		printf( "polltest: poll: returned %d, revents 0x%x 0x%x 0x%x 0x%x\r\n", iReady, xFds[ 0 ].revents, xFds[ 1 ].revents, xFds[ 2 ].revents, xFds[ 3 ].revents );
+		return pdFAIL;
+	}
+
+	/* Woken by data arriving, and not once it has been read. */
+	ucByte = 1;
+	lwip_send( iClient[ 0 ], &ucByte, 1, 0 );
+	iReady = lwip_poll( xFds, 1, polltestRECV_TIMEOUT_MS );
+
+	if( ( iReady != 1 ) || ( xFds[ 0 ].revents != POLLIN ) )
+	{
+		printf( "polltest: poll: returned %d, revents 0x%x with data to read\r\n", iReady, xFds[ 0 ].revents );
+		return pdFAIL;
+	}
+
+	lwip_recv( iServer[ 0 ], &ucByte, 1, 0 );
+	iReady = lwip_poll( xFds, 1, 0 );
+
+	if( iReady != 0 )
+	{
+		printf( "polltest: poll: returned %d once the data was read\r\n", iReady );
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestEpoll( void )
+{
+struct epoll_event xEvent, xEvents[ 4 ];
+TickType_t xStart;
+unsigned long ulWaited;
+int iEpoll, iOther, iReady;
+u8_t ucByte = 2;
+BaseType_t xPassed = pdFAIL;
+
+	iEpoll = lwip_epoll_create( 1 );
+	iOther = lwip_epoll_create( 1 );
+	configASSERT( ( iEpoll >= 0 ) && ( iOther >= 0 ) );
+
+	xEvent.events = EPOLLIN;
+	xEvent.data.u32 = polltestEPOLL_DATA;
+
+	/* One instance per socket, and only the one it was added to can change or
+	delete it. */
+	if( ( lwip_epoll_ctl( iEpoll, EPOLL_CTL_ADD, iServer[ 0 ], &xEvent ) != 0 ) ||
+		( lwip_epoll_ctl( iEpoll, EPOLL_CTL_ADD, iServer[ 0 ], &xEvent ) != -1 ) ||
+		( lwip_epoll_ctl( iOther, EPOLL_CTL_ADD, iServer[ 0 ], &xEvent ) != -1 ) ||
+		( lwip_epoll_ctl( iOther, EPOLL_CTL_MOD, iServer[ 0 ], &xEvent ) != -1 ) ||
+		( lwip_epoll_ctl( iOther, EPOLL_CTL_DEL, iServer[ 0 ], NULL ) != -1 ) )
+	{
+		printf( "polltest: epoll: a socket was added twice\r\n" );
+	}
+	else
+	{
+		xStart = xTaskGetTickCount();
+		iReady = lwip_epoll_wait( iEpoll, xEvents, 4, polltestTIMEOUT_MS );
+		ulWaited = prvMillisecondsSince( xStart );
+
+		if( ( iReady != 0 ) || ( ulWaited < polltestTIMEOUT_MS ) )
+		{
+			printf( "polltest: epoll: returned %d after %lu ms with nothing ready\r\n", iReady, ulWaited );
+		}
+		else
+		{
+			lwip_send( iClient[ 0 ], &ucByte, 1, 0 );
+			iReady = lwip_epoll_wait( iEpoll, xEvents, 4, polltestRECV_TIMEOUT_MS );
+
+			if( ( iReady != 1 ) || ( xEvents[ 0 ].events != EPOLLIN ) || ( xEvents[ 0 ].data.u32 != polltestEPOLL_DATA ) )
+			{
+				printf( "polltest: epoll: returned %d with data to read\r\n", iReady );
+			}
+			else if( lwip_epoll_wait( iEpoll, xEvents, 4, 0 ) != 1 )
+			{
+				printf( "polltest: epoll: data not read is not reported again\r\n" );
+			}
+			else
+			{
+				xPassed = pdPASS;
+			}
+		}
+	}
+
+	if( xPassed == pdPASS )
+	{
+		xPassed = pdFAIL;
+		xEvent.events = EPOLLOUT;
+		lwip_epoll_ctl( iEpoll, EPOLL_CTL_MOD, iServer[ 0 ], &xEvent );
+		iReady = lwip_epoll_wait( iEpoll, xEvents, 4, 0 );
+
+		if( ( iReady != 1 ) || ( xEvents[ 0 ].events != EPOLLOUT ) )
+		{
+			printf( "polltest: epoll: returned %d, events 0x%x after EPOLL_CTL_MOD\r\n", iReady, ( unsigned int ) xEvents[ 0 ].events );
+		}
+		else
+		{
+			xEvent.events = EPOLLIN;
+			lwip_epoll_ctl( iEpoll, EPOLL_CTL_MOD, iServer[ 0 ], &xEvent );
+			lwip_recv( iServer[ 0 ], &ucByte, 1, 0 );
+
+			if( lwip_epoll_wait( iEpoll, xEvents, 4, 0 ) != 0 )
+			{
+				printf( "polltest: epoll: reported once the data was read\r\n" );
+			}
+			else
+			{
+				xPassed = pdPASS;
+			}
+		}
+	}
+
+	if( xPassed == pdPASS )
+	{
+		/* Not reported once deleted, and free to be added again once the
+		instance it was added to is closed. */
+		xPassed = pdFAIL;
+		lwip_epoll_ctl( iEpoll, EPOLL_CTL_DEL, iServer[ 0 ], NULL );
+		lwip_send( iClient[ 0 ], &ucByte, 1, 0 );
+
+		if( ( lwip_epoll_wait( iEpoll, xEvents, 4, polltestTIMEOUT_MS ) != 0 ) || ( lwip_epoll_ctl( iEpoll, EPOLL_CTL_DEL, iServer[ 0 ], NULL ) != -1 ) )
+		{
+			printf( "polltest: epoll: reported after EPOLL_CTL_DEL\r\n" );
+		}
+		else if( ( lwip_epoll_ctl( iOther, EPOLL_CTL_ADD, iServer[ 0 ], &xEvent ) != 0 ) || ( lwip_close( iOther ) != 0 ) ||
+				 ( lwip_epoll_ctl( iEpoll, EPOLL_CTL_ADD, iServer[ 0 ], &xEvent ) != 0 ) )
+		{
+			printf( "polltest: epoll: a socket was not removed from a closed instance\r\n" );
+			iOther = -1;
+		}
+		else
+		{
+			iOther = -1;
+
+			if( lwip_epoll_wait( iEpoll, xEvents, 4, 0 ) != 1 )
+			{
+				printf( "polltest: epoll: data to read not reported after EPOLL_CTL_ADD\r\n" );
+			}
+			else
+			{
+				xPassed = pdPASS;
+			}
+		}
+
+		lwip_recv( iServer[ 0 ], &ucByte, 1, 0 );
+	}
+
+	if( iOther >= 0 )
+	{
+		lwip_close( iOther );
+	}
+
+	lwip_close( iEpoll );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestBurst( Mechanism_t eMechanism )
+{
+size_t x;
+int iBurst;
+
+	for( iBurst = 0; iBurst < polltestBURSTS; iBurst++ )
+	{
+		for( x = 0; x < polltestACTIVE; x++ )
+		{
+			if( prvSendAll( iClient[ x ], &ucMessage[ x ], polltestBURST_BYTES ) != pdPASS )
+			{
+				printf( "polltest: %s: send failed\r\n", pcMechanismNames[ eMechanism ] );
+				return pdFAIL;
+			}
+		}
+
+		for( x = 0; x < polltestACTIVE; x++ )
+		{
+			if( prvReceiveAll( iClient[ x ], &ucMessage[ x ], polltestBURST_BYTES ) != pdPASS )
+			{
+				printf( "polltest: %s: message %d on connection %u not echoed\r\n", pcMechanismNames[ eMechanism ], iBurst, ( unsigned int ) x );
+				return pdFAIL;
+			}
+		}
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestClose( Mechanism_t eMechanism, size_t xFirstIdle )
+{
+unsigned long ulClosed;
+TickType_t xStart;
+size_t x;
+
+	for( x = xFirstIdle; ( x < xFirstIdle + polltestCLOSES ) && ( x < xServerConnections ); x++ )
+	{
+		ulClosed = ulServerClosed;
+		lwip_close( iClient[ x ] );
+		iClient[ x ] = -1;
+		xStart = xTaskGetTickCount();
+
+		while( ( ulServerClosed == ulClosed ) && ( prvMillisecondsSince( xStart ) <= polltestCLOSE_WAIT_MS ) )
+		{
+			vTaskDelay( 1 );
+		}
+
+		if( ( ulServerClosed == ulClosed ) || ( iServer[ x ] != -1 ) )
+		{
+			printf( "polltest: %s: the server did not see connection %u closed\r\n", pcMechanismNames[ eMechanism ], ( unsigned int ) x );
+			return pdFAIL;
+		}
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasure( Mechanism_t eMechanism, size_t xConnections )
+{
+unsigned long ulStep;
+double dStart, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	dStart = prvCPUTime();
+
+	for( ulStep = 0UL; ( ulStep < ulRoundTrips ) && ( xPassed == pdPASS ); ulStep++ )
+	{
+		xPassed = prvRoundTrip( iClient[ 0 ], ucMessage, polltestMESSAGE_BYTES );
+	}
+
+	dSeconds = prvCPUTime() - dStart;
+
+	if( ulStep > 0UL )
+	{
+		printf( "polltest: %s, %u idle connections: %.2f us per round trip (%lu round trips)\r\n", pcMechanismNames[ eMechanism ],
+				( unsigned int ) ( xConnections - polltestACTIVE ), ( dSeconds * 1e6 ) / ( double ) ulStep, ulStep );
+	}
+
+	if( xPassed != pdPASS )
+	{
+		printf( "polltest: %s: benchmark FAILED\r\n", pcMechanismNames[ eMechanism ] );
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static int prvListen( void )
+{
+struct sockaddr_in xLocal;
+int iSocket;
+
+	iSocket = lwip_socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( iSocket >= 0 );
+
+	memset( &xLocal, 0, sizeof( xLocal ) );
+	xLocal.sin_len = sizeof( xLocal );
+	xLocal.sin_family = AF_INET;
+	xLocal.sin_port = htons( polltestPORT );
+	xLocal.sin_addr.s_addr = htonl( INADDR_ANY );
+
+	configASSERT( lwip_bind( iSocket, ( struct sockaddr * ) &xLocal, sizeof( xLocal ) ) == 0 );
+	configASSERT( lwip_listen( iSocket, TCP_DEFAULT_LISTEN_BACKLOG ) == 0 );
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+static int prvConnect( void )
+{
+struct sockaddr_in xServer;
+int iSocket, iOne = 1;
+
+	iSocket = lwip_socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( iSocket >= 0 );
+
+	memset( &xServer, 0, sizeof( xServer ) );
+	xServer.sin_len = sizeof( xServer );
+	xServer.sin_family = AF_INET;
+	xServer.sin_port = htons( polltestPORT );
+	xServer.sin_addr.s_addr = xAddress.addr;
+
+	if( lwip_connect( iSocket, ( struct sockaddr * ) &xServer, sizeof( xServer ) ) != 0 )
+	{
+		lwip_close( iSocket );
+		return -1;
+	}
+
+	lwip_setsockopt( iSocket, IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof( iOne ) );
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRoundTrip( int iSocket, const u8_t *pucMessage, size_t xLength )
+{
+	if( prvSendAll( iSocket, pucMessage, xLength ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	return prvReceiveAll( iSocket, pucMessage, xLength );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendAll( int iSocket, const u8_t *pucData, size_t xLength )
+{
+int iSent;
+
+	while( xLength > 0 )
+	{
+		iSent = lwip_send( iSocket, pucData, xLength, 0 );
+
+		if( iSent <= 0 )
+		{
+			return pdFAIL;
+		}
+
+		pucData += iSent;
+		xLength -= ( size_t ) iSent;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReceiveAll( int iSocket, const u8_t *pucExpected, size_t xLength )
+{
+size_t xReceived = 0;
+int iReceived;
+
+	while( xReceived < xLength )
+	{
+		iReceived = lwip_recv( iSocket, &ucReply[ xReceived ], xLength - xReceived, 0 );
+
+		if( iReceived <= 0 )
+		{
+			return pdFAIL;
+		}
+
+		xReceived += ( size_t ) iReceived;
+	}
+
+	return ( memcmp( ucReply, pucExpected, xLength ) == 0 ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvMillisecondsSince( TickType_t xStart )
+{
+	return ( unsigned long ) ( ( xTaskGetTickCount() - xStart ) * portTICK_PERIOD_MS );
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 'p';
+	pxNetIf->name[ 1 ] = 't';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x06, ETHARP_HWADDR_LEN );
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+struct pbuf *q;
+
+	/* The frame is received later by the tcpip thread, as a driver's would
+	be. */
+	q = pbuf_alloc( PBUF_RAW, p->tot_len, PBUF_POOL );
+
+	if( q == NULL )
+	{
+		ulDropped++;
+	}
+	else
+	{
+		pbuf_copy( q, p );
+
+		if( pxNetIf->input( q, pxNetIf ) != ERR_OK )
+		{
+			pbuf_free( q );
+			ulDropped++;
+		}
+	}
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
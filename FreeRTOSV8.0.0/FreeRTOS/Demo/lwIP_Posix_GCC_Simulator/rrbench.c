@@ -0,0 +1,751 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests and a request/response latency benchmark of the sockets API, built
+ * with and without LWIP_TCPIP_CORE_LOCKING (see lwip/opt.h).  Without it each
+ * socket call is passed to the tcpip thread as a message, which the calling
+ * task waits for.  With it the call runs in the calling task, holding the
+ * core lock.
+ *
+ * A single interface, 10.0.9.1/24, passes every frame it sends back to its
+ * own input through tcpip_input(), so both ends of each connection are in
+ * this process and every segment is received by the tcpip thread, as it would
+ * be from a network driver.  A client task talks to two server tasks, one that
+ * echoes what it receives and one that sends a byte then closes the
+ * connection.  The tests check that:
+ *
+ * - a connect to a port nothing listens on fails,
+ * - messages of different sizes come back unchanged, on one connection after
+ *   another,
+ * - a recv() with nothing to receive gives up after SO_RCVTIMEO, and the
+ *   connection can still be used,
+ * - the echo server sees each close by the client, and the client sees the
+ *   close by the other server.
+ *
+ * The benchmark then measures, in host CPU time, the round trip of small
+ * messages on one connection with TCP_NODELAY set, then a connect, one round
+ * trip and a close on a new connection each time.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/sockets.h"
+#include "lwip/tcpip.h"
+#include "netif/etharp.h"
+
+/* Demo includes. */
+#include "rrbench.h"
+
+/* The ports of the echo server and of the server that closes first, and a
+port nothing listens on. */
+#define rrbenchECHO_PORT				7
+#define rrbenchCLOSING_PORT				8
+#define rrbenchREFUSED_PORT				9
+
+/* Defaults used when the arguments are not given on the command line. */
+#define rrbenchDEFAULT_ROUND_TRIPS		20000UL
+#define rrbenchDEFAULT_CONNECTIONS		2000UL
+#define rrbenchDEFAULT_MESSAGE_BYTES	32UL
+
+/* The largest message, which is also the size of the servers' buffers. */
+#define rrbenchMAX_MESSAGE				4096
+
+/* The receive timeout tested, and the connections the close test opens. */
+#define rrbenchRECV_TIMEOUT_MS			50
+#define rrbenchCLOSE_CONNECTIONS		10UL
+
+/* How long the client waits for the echo server to see a close. */
+#define rrbenchCLOSE_WAIT_MS			1000UL
+
+/* Priority and stack size of the client and server tasks. */
+#define rrbenchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define rrbenchTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, adds the interface, then runs the tests and the
+ * benchmark as the client.
+ */
+static void prvRrBenchTask( void *pvParameters );
+
+/*
+ * The servers.  pvParameters is the listening socket.
+ */
+static void prvEchoServerTask( void *pvParameters );
+static void prvClosingServerTask( void *pvParameters );
+
+/*
+ * Adds the interface - runs in the tcpip thread.
+ */
+static void prvAddNetIf( void *pvParameters );
+
+/*
+ * The tests.  Each returns pdPASS if it passed.
+ */
+static BaseType_t prvTestRefused( void );
+static BaseType_t prvTestEcho( void );
+static BaseType_t prvTestTimeout( void );
+static BaseType_t prvTestClose( void );
+
+/*
+ * Measures and prints the time taken by a round trip on one connection, and
+ * by a connect, a round trip and a close.  Returns pdPASS if every message
+ * came back unchanged.
+ */
+static BaseType_t prvMeasure( void );
+
+/*
+ * Creates a socket listening on usPort.
+ */
+static int prvListen( u16_t usPort );
+
+/*
+ * Creates a socket connected to usPort, with TCP_NODELAY set.  Returns the
+ * socket, or -1 if the connect failed.
+ */
+static int prvConnect( u16_t usPort );
+
+/*
+ * Sends xLength bytes of pucMessage to the echo server, and checks the same
+ * bytes come back.  Returns pdPASS if they did.
+ */
+static BaseType_t prvRoundTrip( int iSocket, const u8_t *pucMessage, size_t xLength );
+
+/*
+ * Sends all of xLength bytes.  Returns pdPASS if they were sent.
+ */
+static BaseType_t prvSendAll( int iSocket, const u8_t *pucData, size_t xLength );
+
+/*
+ * Waits until the echo server has seen ulClosed closes.  Returns pdPASS if
+ * it did within rrbenchCLOSE_WAIT_MS.
+ */
+static BaseType_t prvWaitForClosed( unsigned long ulClosed );
+
+/*
+ * Network interface callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The interface and its address. */
+static struct netif xNetIf;
+static ip_addr_t xAddress;
+
+/* Frames the interface could not pass back to its input. */
+static volatile unsigned long ulDropped = 0UL;
+
+/* The number of connections the echo server has seen closed by the client. */
+static volatile unsigned long ulServerClosed = 0UL;
+
+/* The messages sent, and the buffer they come back to. */
+static u8_t ucMessage[ rrbenchMAX_MESSAGE ], ucReply[ rrbenchMAX_MESSAGE ];
+
+/* The arguments. */
+static unsigned long ulRoundTrips = rrbenchDEFAULT_ROUND_TRIPS;
+static unsigned long ulConnections = rrbenchDEFAULT_CONNECTIONS;
+static unsigned long ulMessageBytes = rrbenchDEFAULT_MESSAGE_BYTES;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartRrBench( int argc, char *argv[] )
+{
+	if( argc > 0 )
+	{
+		ulRoundTrips = strtoul( argv[ 0 ], NULL, 0 );
+	}
+
+	if( argc > 1 )
+	{
+		ulConnections = strtoul( argv[ 1 ], NULL, 0 );
+	}
+
+	if( argc > 2 )
+	{
+		ulMessageBytes = strtoul( argv[ 2 ], NULL, 0 );
+	}
+
+	if( ( ulMessageBytes < 1UL ) || ( ulMessageBytes > rrbenchMAX_MESSAGE ) )
+	{
+		printf( "rrbench: the messages must be from 1 to %d bytes\r\n", rrbenchMAX_MESSAGE );
+		return pdFAIL;
+	}
+
+	return xTaskCreate( prvRrBenchTask, "RrBench", rrbenchTASK_STACK_SIZE, NULL, rrbenchTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iRrBenchFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRrBenchTask( void *pvParameters )
+{
+sys_sem_t xDone;
+BaseType_t xPassed = pdPASS;
+size_t x;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* netif_add() may only be called from the tcpip thread. */
+	tcpip_callback( prvAddNetIf, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	for( x = 0; x < sizeof( ucMessage ); x++ )
+	{
+		ucMessage[ x ] = ( u8_t ) ( x ^ ( x >> 8 ) );
+	}
+
+	xTaskCreate( prvEchoServerTask, "Echo", rrbenchTASK_STACK_SIZE, ( void * ) ( intptr_t ) prvListen( rrbenchECHO_PORT ), rrbenchTASK_PRIORITY, NULL );
+	xTaskCreate( prvClosingServerTask, "Closing", rrbenchTASK_STACK_SIZE, ( void * ) ( intptr_t ) prvListen( rrbenchCLOSING_PORT ), rrbenchTASK_PRIORITY, NULL );
+
+	if( ( prvTestRefused() != pdPASS ) || ( prvTestEcho() != pdPASS ) || ( prvTestTimeout() != pdPASS ) || ( prvTestClose() != pdPASS ) )
+	{
+		xPassed = pdFAIL;
+	}
+
+	printf( "rrbench: %s: %s\r\n", LWIP_TCPIP_CORE_LOCKING ? "core locking" : "messages", ( xPassed == pdPASS ) ? "tests passed" : "FAILED" );
+
+	if( prvMeasure() != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( ulDropped != 0UL )
+	{
+		printf( "rrbench: %lu frames dropped\r\n", ulDropped );
+		xPassed = pdFAIL;
+	}
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+
+	/* The servers are left waiting in accept(). */
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEchoServerTask( void *pvParameters )
+{
+int iListener = ( int ) ( intptr_t ) pvParameters, iSocket, iReceived, iOne = 1;
+static u8_t ucBuffer[ rrbenchMAX_MESSAGE ];
+
+	for( ;; )
+	{
+		iSocket = lwip_accept( iListener, NULL, NULL );
+		configASSERT( iSocket >= 0 );
+		lwip_setsockopt( iSocket, IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof( iOne ) );
+
+		do
+		{
+			iReceived = lwip_recv( iSocket, ucBuffer, sizeof( ucBuffer ), 0 );
+		} while( ( iReceived > 0 ) && ( prvSendAll( iSocket, ucBuffer, ( size_t ) iReceived ) == pdPASS ) );
+
+		if( iReceived == 0 )
+		{
+			ulServerClosed++;
+		}
+
+		lwip_close( iSocket );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvClosingServerTask( void *pvParameters )
+{
+int iListener = ( int ) ( intptr_t ) pvParameters, iSocket;
+const u8_t ucByte = 0x5a;
+
+	for( ;; )
+	{
+		iSocket = lwip_accept( iListener, NULL, NULL );
+		configASSERT( iSocket >= 0 );
+		lwip_send( iSocket, &ucByte, sizeof( ucByte ), 0 );
+		lwip_close( iSocket );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddNetIf( void *pvParameters )
+{
+ip_addr_t xNetMask, xGateway;
+struct eth_addr xHardwareAddress;
+
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xAddress, 10, 0, 9, 1 );
+	netif_add( &xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, tcpip_input );
+	netif_set_up( &xNetIf );
+
+	/* The interface's own address, so it sends to itself without an ARP
+	request. */
+	SMEMCPY( &xHardwareAddress, xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	etharp_add_static_entry( &xAddress, &xHardwareAddress );
+
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestRefused( void )
+{
+int iSocket;
+
+	iSocket = prvConnect( rrbenchREFUSED_PORT );
+
+	if( iSocket >= 0 )
+	{
+		printf( "rrbench: refused: connected to a port nothing listens on\r\n" );
+		lwip_close( iSocket );
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestEcho( void )
+{
+static const size_t xLengths[] = { 1, 32, 100, 1000, TCP_MSS, TCP_MSS + 1, rrbenchMAX_MESSAGE };
+int iSocket, iConnection;
+size_t x;
+
+	for( iConnection = 0; iConnection < 3; iConnection++ )
+	{
+		iSocket = prvConnect( rrbenchECHO_PORT );
+
+		if( iSocket < 0 )
+		{
+			printf( "rrbench: echo: connect failed\r\n" );
+			return pdFAIL;
+		}
+
+		for( x = 0; x < sizeof( xLengths ) / sizeof( xLengths[ 0 ] ); x++ )
+		{
+			if( prvRoundTrip( iSocket, ucMessage, xLengths[ x ] ) != pdPASS )
+			{
+				printf( "rrbench: echo: %u byte message not echoed\r\n", ( unsigned int ) xLengths[ x ] );
+				lwip_close( iSocket );
+				return pdFAIL;
+			}
+		}
+
+		lwip_close( iSocket );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestTimeout( void )
+{
+int iSocket, iReceived, iError = 0, iTimeout = rrbenchRECV_TIMEOUT_MS;
+socklen_t xLength = sizeof( iError );
+TickType_t xStart, xWaited;
+BaseType_t xPassed = pdPASS;
+
+	iSocket = prvConnect( rrbenchECHO_PORT );
+
+	if( iSocket < 0 )
+	{
+		printf( "rrbench: timeout: connect failed\r\n" );
+		return pdFAIL;
+	}
+
+	lwip_setsockopt( iSocket, SOL_SOCKET, SO_RCVTIMEO, &iTimeout, sizeof( iTimeout ) );
+	xStart = xTaskGetTickCount();
+	iReceived = lwip_recv( iSocket, ucReply, sizeof( ucReply ), 0 );
+	xWaited = xTaskGetTickCount() - xStart;
+
+	/* The port does not define ERRNO, so the error is read from the
+	socket. */
+	lwip_getsockopt( iSocket, SOL_SOCKET, SO_ERROR, &iError, &xLength );
+
+	if( ( iReceived != -1 ) || ( iError != EWOULDBLOCK ) || ( xWaited < ( rrbenchRECV_TIMEOUT_MS / portTICK_PERIOD_MS ) ) )
+	{
+		printf( "rrbench: timeout: recv() returned %d, error %d, after %u ms\r\n", iReceived, iError, ( unsigned int ) ( xWaited * portTICK_PERIOD_MS ) );
+		xPassed = pdFAIL;
+	}
+	else if( prvRoundTrip( iSocket, ucMessage, 32 ) != pdPASS )
+	{
+		printf( "rrbench: timeout: message not echoed after the timeout\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	lwip_close( iSocket );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestClose( void )
+{
+unsigned long ulConnection, ulClosed;
+int iSocket, iReceived;
+BaseType_t xPassed = pdPASS;
+
+	/* The client closes, the echo server sees it. */
+	for( ulConnection = 0UL; ( ulConnection < rrbenchCLOSE_CONNECTIONS ) && ( xPassed == pdPASS ); ulConnection++ )
+	{
+		ulClosed = ulServerClosed;
+		iSocket = prvConnect( rrbenchECHO_PORT );
+
+		if( ( iSocket < 0 ) || ( prvRoundTrip( iSocket, ucMessage, 1 ) != pdPASS ) )
+		{
+			printf( "rrbench: close: connection %lu to the echo server failed\r\n", ulConnection );
+			xPassed = pdFAIL;
+		}
+		else
+		{
+			lwip_close( iSocket );
+
+			if( prvWaitForClosed( ulClosed + 1UL ) != pdPASS )
+			{
+				printf( "rrbench: close: the echo server did not see connection %lu closed\r\n", ulConnection );
+				xPassed = pdFAIL;
+			}
+		}
+	}
+
+	/* The other server closes, the client sees it after the byte sent
+	before. */
+	for( ulConnection = 0UL; ( ulConnection < rrbenchCLOSE_CONNECTIONS ) && ( xPassed == pdPASS ); ulConnection++ )
+	{
+		iSocket = prvConnect( rrbenchCLOSING_PORT );
+
+		if( iSocket < 0 )
+		{
+			printf( "rrbench: close: connection %lu to the closing server failed\r\n", ulConnection );
+			xPassed = pdFAIL;
+		}
+		else
+		{
+			iReceived = lwip_recv( iSocket, ucReply, sizeof( ucReply ), 0 );
+
+			if( ( iReceived != 1 ) || ( lwip_recv( iSocket, ucReply, sizeof( ucReply ), 0 ) != 0 ) )
+			{
+				printf( "rrbench: close: the client did not see connection %lu closed\r\n", ulConnection );
+				xPassed = pdFAIL;
+			}
+
+			lwip_close( iSocket );
+		}
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasure( void )
+{
+unsigned long ulStep;
+double dStart, dSeconds;
+const char *pcMode = LWIP_TCPIP_CORE_LOCKING ? "core locking" : "messages";
+int iSocket;
+BaseType_t xPassed = pdPASS;
+
+	if( ulRoundTrips > 0UL )
+	{
+		iSocket = prvConnect( rrbenchECHO_PORT );
+		configASSERT( iSocket >= 0 );
+		dStart = prvCPUTime();
+
+		for( ulStep = 0UL; ( ulStep < ulRoundTrips ) && ( xPassed == pdPASS ); ulStep++ )
+		{
+			xPassed = prvRoundTrip( iSocket, ucMessage, ( size_t ) ulMessageBytes );
+		}
+
+		dSeconds = prvCPUTime() - dStart;
+		lwip_close( iSocket );
+
+		printf( "rrbench: %s, %lu byte messages: %.2f us per round trip (%lu round trips)\r\n", pcMode, ulMessageBytes,
+				( dSeconds * 1e6 ) / ( double ) ulStep, ulStep );
+	}
+
+	if( ulConnections > 0UL )
+	{
+		dStart = prvCPUTime();
+
+		for( ulStep = 0UL; ( ulStep < ulConnections ) && ( xPassed == pdPASS ); ulStep++ )
+		{
+			iSocket = prvConnect( rrbenchECHO_PORT );
+
+			if( iSocket < 0 )
+			{
+				xPassed = pdFAIL;
+			}
+			else
+			{
+				xPassed = prvRoundTrip( iSocket, ucMessage, ( size_t ) ulMessageBytes );
+				lwip_close( iSocket );
+			}
+		}
+
+		dSeconds = prvCPUTime() - dStart;
+
+		printf( "rrbench: %s, %lu byte messages: %.2f us per connect, round trip and close (%lu connections)\r\n", pcMode, ulMessageBytes,
+				( dSeconds * 1e6 ) / ( double ) ulStep, ulStep );
+	}
+
+	if( xPassed != pdPASS )
+	{
+		printf( "rrbench: benchmark FAILED\r\n" );
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static int prvListen( u16_t usPort )
+{
+struct sockaddr_in xLocal;
+int iSocket;
+
+	iSocket = lwip_socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( iSocket >= 0 );
+
+	memset( &xLocal, 0, sizeof( xLocal ) );
+	xLocal.sin_len = sizeof( xLocal );
+	xLocal.sin_family = AF_INET;
+	xLocal.sin_port = htons( usPort );
+	xLocal.sin_addr.s_addr = htonl( INADDR_ANY );
+
+	configASSERT( lwip_bind( iSocket, ( struct sockaddr * ) &xLocal, sizeof( xLocal ) ) == 0 );
+	configASSERT( lwip_listen( iSocket, TCP_DEFAULT_LISTEN_BACKLOG ) == 0 );
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+static int prvConnect( u16_t usPort )
+{
+struct sockaddr_in xServer;
+int iSocket, iOne = 1;
+
+	iSocket = lwip_socket( AF_INET, SOCK_STREAM, 0 );
+	configASSERT( iSocket >= 0 );
+
+	memset( &xServer, 0, sizeof( xServer ) );
+	xServer.sin_len = sizeof( xServer );
+	xServer.sin_family = AF_INET;
+	xServer.sin_port = htons( usPort );
+	xServer.sin_addr.s_addr = xAddress.addr;
+
+	if( lwip_connect( iSocket, ( struct sockaddr * ) &xServer, sizeof( xServer ) ) != 0 )
+	{
+		lwip_close( iSocket );
+		return -1;
+	}
+
+	lwip_setsockopt( iSocket, IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof( iOne ) );
+
+	return iSocket;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRoundTrip( int iSocket, const u8_t *pucMessage, size_t xLength )
+{
+size_t xReceived = 0;
+int iReceived;
+
+	if( prvSendAll( iSocket, pucMessage, xLength ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	while( xReceived < xLength )
+	{
+		iReceived = lwip_recv( iSocket, &ucReply[ xReceived ], xLength - xReceived, 0 );
+
+		if( iReceived <= 0 )
+		{
+			return pdFAIL;
+		}
+
+		xReceived += ( size_t ) iReceived;
+	}
+
+	return ( memcmp( ucReply, pucMessage, xLength ) == 0 ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendAll( int iSocket, const u8_t *pucData, size_t xLength )
+{
+int iSent;
+
+	while( xLength > 0 )
+	{
+		iSent = lwip_send( iSocket, pucData, xLength, 0 );
+
+		if( iSent <= 0 )
+		{
+			return pdFAIL;
+		}
+
+		pucData += iSent;
+		xLength -= ( size_t ) iSent;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWaitForClosed( unsigned long ulClosed )
+{
+TickType_t xStart = xTaskGetTickCount();
+
+	while( ulServerClosed < ulClosed )
+	{
+		if( ( xTaskGetTickCount() - xStart ) > ( rrbenchCLOSE_WAIT_MS / portTICK_PERIOD_MS ) )
+		{
+			return pdFAIL;
+		}
+
+		vTaskDelay( 1 );
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 'r';
+	pxNetIf->name[ 1 ] = 'r';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x06, ETHARP_HWADDR_LEN );
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+struct pbuf *q;
+
+	/* Called by the tcpip thread, or with core locking by the task that holds
+	the core lock.  Either way the frame is received later by the tcpip
+	thread, as a driver's would be. */
+	q = pbuf_alloc( PBUF_RAW, p->tot_len, PBUF_POOL );
+
+	if( q == NULL )
+	{
+		ulDropped++;
+	}
+	else
+	{
+		pbuf_copy( q, p );
+
+		if( pxNetIf->input( q, pxNetIf ) != ERR_OK )
+		{
+			pbuf_free( q );
+			ulDropped++;
+		}
+	}
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,641 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests and a packets per second benchmark of the receive descriptor ring
+ * (see netif/rxring.h).
+ *
+ * A modelled MAC writes frames into the buffers armed in its descriptors,
+ * and the frames are passed straight to ethernet_input() from inside the
+ * tcpip thread, so the numbers measure the stack and the receive path alone.
+ * Each test is run twice: once receiving the way the skeleton ethernetif.c
+ * does, by copying every frame into a pool pbuf, and once with the ring,
+ * which passes its buffers up as custom (PBUF_REF) pbufs.
+ *
+ * Two network interfaces are created: the receiving interface, 10.0.1.1/24,
+ * and a transmit only interface, 10.0.2.1/24.  The tests check that frames
+ * received into the ring are handled like any other:
+ *
+ * - an ICMP echo request is answered,
+ * - a UDP datagram to a closed port is answered with a port unreachable,
+ * - a datagram for 10.0.2.2 is forwarded through the second interface with
+ *   its TTL decremented.  This needs a copy, as the Ethernet header cannot be
+ *   added in front of a PBUF_REF pbuf.
+ *
+ * The benchmark then sends UDP datagrams to a bound port.  The receive
+ * callback can hold on to the most recent datagrams, as an application
+ * reading from a mailbox would, to show the ring falling back to copying when
+ * the stack holds too many of its buffers.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/icmp.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/ip.h"
+#include "lwip/mem.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+#include "netif/etharp.h"
+#include "netif/rxring.h"
+
+/* Demo includes. */
+#include "rxbench.h"
+
+/* The modelled MAC - the number of descriptors, and the number of buffers
+the ring arms them with. */
+#define rxbenchRING_SIZE				256
+#define rxbenchRING_BUFFERS				512
+#define rxbenchBUFFER_SIZE				LWIP_MEM_ALIGN_SIZE( ETH_PAD_SIZE + 1514 )
+
+/* The number of frames the MAC receives before the driver processes them
+and refills the ring. */
+#define rxbenchBURST					32
+
+/* Defaults used when the arguments are not given on the command line. */
+#define rxbenchDEFAULT_FRAMES			1000000UL
+#define rxbenchDEFAULT_PAYLOAD			18
+#define rxbenchMAX_HELD					512
+
+/* The port the benchmark datagrams are sent to, and a port nothing is bound
+to. */
+#define rxbenchPORT						7
+#define rxbenchCLOSED_PORT				9
+
+/* The TTL of the generated datagrams. */
+#define rxbenchTTL						64
+
+/* Priority and stack size of the task that runs the benchmark. */
+#define rxbenchTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define rxbenchTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/* The first bytes of the last frame sent by an interface are kept for the
+tests. */
+#define rxbenchCAPTURE_SIZE				64
+
+/*-----------------------------------------------------------*/
+
+/* A transmitting interface - the frames it sent, and the start of the last
+one. */
+typedef struct xBENCH_NETIF
+{
+	struct netif xNetIf;
+	unsigned long ulSent;
+	u8_t ucLast[ rxbenchCAPTURE_SIZE ];
+} xBenchNetIf;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, then runs prvRunBenchmark() in it.
+ */
+static void prvRxBenchTask( void *pvParameters );
+
+/*
+ * The body of the benchmark - runs in the tcpip thread.
+ */
+static void prvRunBenchmark( void *pvParameters );
+
+/*
+ * Runs the tests of one receive mode.  Returns pdPASS if all passed.
+ */
+static BaseType_t prvRunTests( BaseType_t xUseRing );
+
+/*
+ * Measures and prints the packets per second of one receive mode.
+ */
+static void prvMeasure( BaseType_t xUseRing );
+
+/*
+ * The modelled MAC receives ulFrames copies of the frame in ucFrame, and the
+ * driver passes them to the stack.
+ */
+static void prvReceive( BaseType_t xUseRing, unsigned long ulFrames );
+
+/*
+ * Builds a frame from 10.0.1.2 to pxDestination in ucFrame, and returns its
+ * length (without ETH_PAD_SIZE).  usPort is the destination port of a UDP
+ * datagram; 0 builds an ICMP echo request instead.
+ */
+static u16_t prvBuildFrame( ip_addr_t *pxDestination, u16_t usPort, u16_t usPayload );
+
+/*
+ * Network interface and receive ring callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+static void prvRingPost( struct rxring *pxRing, u16_t usDesc, u8_t *pucMem, u16_t usLength );
+static void prvRingKick( struct rxring *pxRing, u16_t usFirst, u16_t usCount );
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *p, ip_addr_t *pxAddr, u16_t usPort );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The receiving and the transmit only interfaces. */
+static xBenchNetIf xRxNetIf, xTxNetIf;
+
+/* The ring and the memory it manages. */
+static struct rxring xRing;
+static struct rxring_buf *pxRingDesc[ rxbenchRING_SIZE ];
+static struct rxring_buf xRingBuf[ rxbenchRING_BUFFERS ];
+static u8_t ucRingMem[ rxbenchRING_BUFFERS ][ rxbenchBUFFER_SIZE ];
+
+/* The descriptors of the modelled MAC - the buffer each is armed with - and
+the next one it fills.  In the copy mode every descriptor keeps its own buffer
+in ucCopyMem. */
+static u8_t *pucMacDesc[ rxbenchRING_SIZE ];
+static u16_t usMacHead = 0;
+static u8_t ucCopyMem[ rxbenchRING_SIZE ][ rxbenchBUFFER_SIZE ];
+
+/* The frame the MAC receives, and its length without ETH_PAD_SIZE. */
+static u8_t ucFrame[ rxbenchBUFFER_SIZE ];
+static u16_t usFrameLength = 0;
+
+/* Datagrams held by the receive callback. */
+static struct pbuf *pxHeld[ rxbenchMAX_HELD ];
+static unsigned long ulHeld = 0UL, ulNextHeld = 0UL;
+static unsigned long ulReceived = 0UL;
+
+/* The command line arguments. */
+static unsigned long ulFrames = rxbenchDEFAULT_FRAMES;
+static u16_t usPayload = rxbenchDEFAULT_PAYLOAD;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartRxBench( int argc, char *argv[] )
+{
+	if( argc > 0 )
+	{
+		ulFrames = strtoul( argv[ 0 ], NULL, 0 );
+	}
+
+	if( argc > 1 )
+	{
+		usPayload = ( u16_t ) strtoul( argv[ 1 ], NULL, 0 );
+	}
+
+	if( argc > 2 )
+	{
+		ulHeld = strtoul( argv[ 2 ], NULL, 0 );
+	}
+
+	if( ( usPayload > ( 1500 - IP_HLEN - UDP_HLEN ) ) || ( ulHeld > rxbenchMAX_HELD ) )
+	{
+		printf( "rxbench: the payload is limited to %d bytes and the held datagrams to %d\r\n", 1500 - IP_HLEN - UDP_HLEN, rxbenchMAX_HELD );
+		return pdFAIL;
+	}
+
+	return xTaskCreate( prvRxBenchTask, "RxBench", rxbenchTASK_STACK_SIZE, NULL, rxbenchTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iRxBenchFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRxBenchTask( void *pvParameters )
+{
+sys_sem_t xDone;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* lwIP's core functions may only be called from the tcpip thread. */
+	tcpip_callback( prvRunBenchmark, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunBenchmark( void *pvParameters )
+{
+ip_addr_t xIPAddr, xNetMask, xGateway;
+struct eth_addr xPeer;
+struct udp_pcb *pxPCB;
+BaseType_t xPassed = pdPASS;
+
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xIPAddr, 10, 0, 1, 1 );
+	netif_add( &xRxNetIf.xNetIf, &xIPAddr, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xRxNetIf.xNetIf );
+	IP4_ADDR( &xIPAddr, 10, 0, 2, 1 );
+	netif_add( &xTxNetIf.xNetIf, &xIPAddr, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xTxNetIf.xNetIf );
+
+	/* The peers on either side, so no ARP requests are needed. */
+	memset( &xPeer, 0x02, sizeof( xPeer ) );
+	IP4_ADDR( &xIPAddr, 10, 0, 1, 2 );
+	etharp_add_static_entry( &xIPAddr, &xPeer );
+	IP4_ADDR( &xIPAddr, 10, 0, 2, 2 );
+	etharp_add_static_entry( &xIPAddr, &xPeer );
+
+	pxPCB = udp_new();
+	configASSERT( pxPCB );
+	udp_bind( pxPCB, IP_ADDR_ANY, rxbenchPORT );
+	udp_recv( pxPCB, prvUDPReceive, NULL );
+
+	rxring_init( &xRing, pxRingDesc, rxbenchRING_SIZE, xRingBuf, &ucRingMem[ 0 ][ 0 ], rxbenchRING_BUFFERS,
+				 rxbenchBUFFER_SIZE, prvRingPost, prvRingKick, NULL );
+
+	if( prvRunTests( pdFALSE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( prvRunTests( pdTRUE ) != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( ulFrames > 0UL )
+	{
+		prvMeasure( pdFALSE );
+		prvMeasure( pdTRUE );
+	}
+
+	udp_remove( pxPCB );
+	netif_remove( &xRxNetIf.xNetIf );
+	netif_remove( &xTxNetIf.xNetIf );
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRunTests( BaseType_t xUseRing )
+{
+const char *pcMode = ( xUseRing != pdFALSE ) ? "ring" : "copy";
+struct ip_hdr *pxIP;
+struct icmp_echo_hdr *pxICMP;
+ip_addr_t xDestination;
+unsigned long ulSent;
+BaseType_t xPassed = pdPASS;
+
+	/* An echo request is answered with an echo reply. */
+	IP4_ADDR( &xDestination, 10, 0, 1, 1 );
+	usFrameLength = prvBuildFrame( &xDestination, 0, 56 );
+	ulSent = xRxNetIf.ulSent;
+	prvReceive( xUseRing, 1UL );
+	pxIP = ( struct ip_hdr * ) &xRxNetIf.ucLast[ SIZEOF_ETH_HDR ];
+	pxICMP = ( struct icmp_echo_hdr * ) ( pxIP + 1 );
+
+	if( ( xRxNetIf.ulSent != ulSent + 1UL ) || ( IPH_PROTO( pxIP ) != IP_PROTO_ICMP ) || ( ICMPH_TYPE( pxICMP ) != ICMP_ER ) )
+	{
+		printf( "rxbench: %s: no echo reply\r\n", pcMode );
+		xPassed = pdFAIL;
+	}
+
+	/* A datagram to a closed port is answered with a port unreachable. */
+	usFrameLength = prvBuildFrame( &xDestination, rxbenchCLOSED_PORT, 18 );
+	ulSent = xRxNetIf.ulSent;
+	prvReceive( xUseRing, 1UL );
+
+	if( ( xRxNetIf.ulSent != ulSent + 1UL ) || ( IPH_PROTO( pxIP ) != IP_PROTO_ICMP ) || ( ICMPH_TYPE( pxICMP ) != ICMP_DUR ) )
+	{
+		printf( "rxbench: %s: no port unreachable\r\n", pcMode );
+		xPassed = pdFAIL;
+	}
+
+	/* A datagram for the other network is forwarded, with its TTL
+	decremented and its header checksum still valid. */
+	IP4_ADDR( &xDestination, 10, 0, 2, 2 );
+	usFrameLength = prvBuildFrame( &xDestination, rxbenchCLOSED_PORT, 18 );
+	ulSent = xTxNetIf.ulSent;
+	prvReceive( xUseRing, 1UL );
+	pxIP = ( struct ip_hdr * ) &xTxNetIf.ucLast[ SIZEOF_ETH_HDR ];
+
+	if( ( xTxNetIf.ulSent != ulSent + 1UL ) || ( IPH_PROTO( pxIP ) != IP_PROTO_UDP ) ||
+		( IPH_TTL( pxIP ) != rxbenchTTL - 1 ) || ( inet_chksum( pxIP, IP_HLEN ) != 0 ) )
+	{
+		printf( "rxbench: %s: datagram not forwarded\r\n", pcMode );
+		xPassed = pdFAIL;
+	}
+
+	if( xPassed == pdPASS )
+	{
+		printf( "rxbench: %s: tests passed\r\n", pcMode );
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( BaseType_t xUseRing )
+{
+ip_addr_t xDestination;
+u32_t ulPassed = xRing.passed, ulCopied = xRing.copied, ulDropped = xRing.dropped, ulKicks = xRing.kicks;
+double dStart, dSeconds;
+
+	IP4_ADDR( &xDestination, 10, 0, 1, 1 );
+	usFrameLength = prvBuildFrame( &xDestination, rxbenchPORT, usPayload );
+	ulReceived = 0UL;
+
+	dStart = prvCPUTime();
+	prvReceive( xUseRing, ulFrames );
+	dSeconds = prvCPUTime() - dStart;
+
+	/* Let go of the held datagrams. */
+	for( ulNextHeld = 0UL; ulNextHeld < rxbenchMAX_HELD; ulNextHeld++ )
+	{
+		if( pxHeld[ ulNextHeld ] != NULL )
+		{
+			pbuf_free( pxHeld[ ulNextHeld ] );
+			pxHeld[ ulNextHeld ] = NULL;
+		}
+	}
+
+	ulNextHeld = 0UL;
+
+	printf( "rxbench: %s: %u byte frames, %lu held: %.3f Mpps, %lu of %lu received",
+			( xUseRing != pdFALSE ) ? "ring" : "copy", ( unsigned int ) usFrameLength, ulHeld,
+			( dSeconds > 0.0 ) ? ( ( double ) ulFrames / dSeconds / 1e6 ) : 0.0, ulReceived, ulFrames );
+
+	if( xUseRing != pdFALSE )
+	{
+		printf( " (%u passed up, %u copied, %u dropped, %.3f kicks per frame)",
+				( unsigned int ) ( xRing.passed - ulPassed ), ( unsigned int ) ( xRing.copied - ulCopied ),
+				( unsigned int ) ( xRing.dropped - ulDropped ), ( double ) ( xRing.kicks - ulKicks ) / ( double ) ulFrames );
+	}
+
+	printf( "\r\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceive( BaseType_t xUseRing, unsigned long ulFrames )
+{
+unsigned long ulBurst, x;
+struct pbuf *p;
+u8_t *pucMem;
+
+	while( ulFrames > 0UL )
+	{
+		ulBurst = ( ulFrames < rxbenchBURST ) ? ulFrames : rxbenchBURST;
+		ulFrames -= ulBurst;
+
+		for( x = 0UL; x < ulBurst; x++ )
+		{
+			if( xUseRing != pdFALSE )
+			{
+				if( xRing.armed == 0 )
+				{
+					/* Every buffer is held by the stack.  A real MAC would
+					drop frames until rxring_refill() finds a free one. */
+					rxring_refill( &xRing, 1 );
+
+					if( xRing.armed == 0 )
+					{
+						continue;
+					}
+				}
+
+				/* The MAC writes the frame into the armed buffer. */
+				memcpy( pucMacDesc[ xRing.head ], &ucFrame[ ETH_PAD_SIZE ], usFrameLength );
+				p = rxring_input( &xRing, usFrameLength );
+			}
+			else
+			{
+				/* The MAC writes the frame into the descriptor's own buffer,
+				then the driver copies it into a pool pbuf. */
+				pucMem = &ucCopyMem[ usMacHead ][ 0 ];
+				usMacHead = ( usMacHead + 1 == rxbenchRING_SIZE ) ? 0 : usMacHead + 1;
+				memcpy( pucMem, &ucFrame[ ETH_PAD_SIZE ], usFrameLength );
+
+				p = pbuf_alloc( PBUF_RAW, usFrameLength + ETH_PAD_SIZE, PBUF_POOL );
+
+				if( p != NULL )
+				{
+					pbuf_header( p, -ETH_PAD_SIZE );
+					pbuf_take( p, pucMem, usFrameLength );
+					pbuf_header( p, ETH_PAD_SIZE );
+				}
+			}
+
+			if( ( p != NULL ) && ( xRxNetIf.xNetIf.input( p, &xRxNetIf.xNetIf ) != ERR_OK ) )
+			{
+				pbuf_free( p );
+			}
+		}
+
+		if( xUseRing != pdFALSE )
+		{
+			rxring_refill( &xRing, 0 );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static u16_t prvBuildFrame( ip_addr_t *pxDestination, u16_t usPort, u16_t usPayload )
+{
+struct eth_hdr *pxEthernet = ( struct eth_hdr * ) ucFrame;
+struct ip_hdr *pxIP = ( struct ip_hdr * ) &ucFrame[ SIZEOF_ETH_HDR ];
+struct udp_hdr *pxUDP = ( struct udp_hdr * ) ( pxIP + 1 );
+struct icmp_echo_hdr *pxICMP = ( struct icmp_echo_hdr * ) ( pxIP + 1 );
+ip_addr_t xSource;
+u16_t usIPLength = IP_HLEN + UDP_HLEN + usPayload;
+
+	/* UDP and ICMP echo headers are both 8 bytes. */
+	LWIP_ASSERT( "header sizes", sizeof( struct icmp_echo_hdr ) == UDP_HLEN );
+
+	memset( ucFrame, 0x00, sizeof( ucFrame ) );
+	memset( &ucFrame[ SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN ], 0x55, usPayload );
+
+	SMEMCPY( &pxEthernet->dest, xRxNetIf.xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	memset( &pxEthernet->src, 0x02, ETHARP_HWADDR_LEN );
+	pxEthernet->type = PP_HTONS( ETHTYPE_IP );
+
+	IP4_ADDR( &xSource, 10, 0, 1, 2 );
+	IPH_VHLTOS_SET( pxIP, 4, IP_HLEN / 4, 0 );
+	IPH_LEN_SET( pxIP, htons( usIPLength ) );
+	IPH_TTL_SET( pxIP, rxbenchTTL );
+	IPH_PROTO_SET( pxIP, ( usPort != 0 ) ? IP_PROTO_UDP : IP_PROTO_ICMP );
+	ip_addr_copy( pxIP->src, xSource );
+	ip_addr_copy( pxIP->dest, *pxDestination );
+	IPH_CHKSUM_SET( pxIP, inet_chksum( pxIP, IP_HLEN ) );
+
+	if( usPort != 0 )
+	{
+		/* No UDP checksum. */
+		pxUDP->src = PP_HTONS( 1024 );
+		pxUDP->dest = htons( usPort );
+		pxUDP->len = htons( UDP_HLEN + usPayload );
+	}
+	else
+	{
+		ICMPH_TYPE_SET( pxICMP, ICMP_ECHO );
+		pxICMP->chksum = inet_chksum( pxICMP, UDP_HLEN + usPayload );
+	}
+
+	return SIZEOF_ETH_HDR - ETH_PAD_SIZE + usIPLength;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 'r';
+	pxNetIf->name[ 1 ] = 'b';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x04, ETHARP_HWADDR_LEN );
+	pxNetIf->hwaddr[ 5 ] = ( pxNetIf == &xRxNetIf.xNetIf ) ? 1 : 2;
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+xBenchNetIf *pxBenchNetIf = ( pxNetIf == &xRxNetIf.xNetIf ) ? &xRxNetIf : &xTxNetIf;
+
+	pxBenchNetIf->ulSent++;
+	memset( pxBenchNetIf->ucLast, 0x00, sizeof( pxBenchNetIf->ucLast ) );
+	pbuf_copy_partial( p, pxBenchNetIf->ucLast, sizeof( pxBenchNetIf->ucLast ), 0 );
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRingPost( struct rxring *pxRing, u16_t usDesc, u8_t *pucMem, u16_t usLength )
+{
+	( void ) pxRing;
+	( void ) usLength;
+
+	/* Arm the descriptor of the modelled MAC. */
+	pucMacDesc[ usDesc ] = pucMem;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRingKick( struct rxring *pxRing, u16_t usFirst, u16_t usCount )
+{
+	/* A real driver would write the MAC's tail pointer register here. */
+	( void ) pxRing;
+	( void ) usFirst;
+	( void ) usCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *p, ip_addr_t *pxAddr, u16_t usPort )
+{
+	( void ) pvArg;
+	( void ) pxPCB;
+	( void ) pxAddr;
+	( void ) usPort;
+
+	ulReceived++;
+
+	if( ulHeld == 0UL )
+	{
+		pbuf_free( p );
+	}
+	else
+	{
+		/* Hold on to the datagram, letting go of the oldest one held. */
+		if( pxHeld[ ulNextHeld ] != NULL )
+		{
+			pbuf_free( pxHeld[ ulNextHeld ] );
+		}
+
+		pxHeld[ ulNextHeld ] = p;
+		ulNextHeld = ( ulNextHeld + 1UL ) % ulHeld;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
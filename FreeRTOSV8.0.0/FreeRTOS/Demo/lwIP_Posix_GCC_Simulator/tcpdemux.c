@@ -0,0 +1,840 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A pcb churn test and a segments per second benchmark of the way tcp_input()
+ * finds the pcb of each incoming segment (see TCP_PCB_HASH in lwip/opt.h).
+ *
+ * Everything runs inside the tcpip thread, on one network interface,
+ * 10.0.5.1/24, that sends its frames back to itself.  Both ends of every
+ * connection are therefore pcbs of the one stack, and every segment goes
+ * through tcp_input().  The frames the interface sends are queued, and after
+ * each step the queue is fed back to ethernet_input() until it is empty.
+ *
+ * The churn test keeps tcpdemuxCHURN_OPEN connections open while it opens
+ * and closes tcpdemuxCHURN_CONNECTIONS more, exchanging a byte each way on
+ * each one.  The connections are closed by the client, closed by the server,
+ * or reset, in turn.  There are more of them than there are pcbs, so pcbs in
+ * TIME-WAIT are taken for new connections.  After each step the test checks
+ * that every byte reached the right connection, that the active pcb list
+ * holds the open connections and nothing else, and, with TCP_PCB_HASH, that
+ * the hash lookups find every active, TIME-WAIT and listening pcb, and no
+ * longer find the connections that were reset.
+ *
+ * The benchmark opens each of the given numbers of connections in turn, then
+ * sends a byte on each in round robin.  The delayed acknowledgements are sent
+ * after each round.  It reports the segments received per second of CPU time.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/stats.h"
+#include "lwip/tcp_impl.h"
+#include "lwip/tcpip.h"
+#include "netif/etharp.h"
+
+/* Demo includes. */
+#include "tcpdemux.h"
+
+/* The frames sent by the interface that have still to be received. */
+#define tcpdemuxQUEUE_SIZE				1024
+
+/* The port the connections are made to. */
+#define tcpdemuxPORT					5001
+
+/* The churn test - see the top of this file. */
+#define tcpdemuxCHURN_OPEN				64
+#define tcpdemuxCHURN_CONNECTIONS		2000UL
+
+/* The benchmark - the connection counts used when none are given on the
+command line, and the number of segments received at each. */
+#define tcpdemuxMAX_CONNECTIONS			256
+#define tcpdemuxMAX_COUNTS				8
+#define tcpdemuxSEGMENTS				400000UL
+
+/* Priority and stack size of the task that runs the test. */
+#define tcpdemuxTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define tcpdemuxTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/* The two ends of a connection. */
+#define tcpdemuxCLIENT					0
+#define tcpdemuxSERVER					1
+
+/*-----------------------------------------------------------*/
+
+/* One end of a connection - its pcb, which is NULL once it has been closed,
+and the bytes it has received. */
+typedef struct xCONNECTION_END
+{
+	struct xCONNECTION *pxConnection;
+	struct tcp_pcb *pxPCB;
+	unsigned long ulReceived;
+} xConnectionEnd;
+
+/* A connection, and the byte its ends send each other. */
+typedef struct xCONNECTION
+{
+	xConnectionEnd xEnds[ 2 ];
+	u8_t ucId;
+} xConnection;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, then runs prvRunTests() in it.
+ */
+static void prvTcpDemuxTask( void *pvParameters );
+
+/*
+ * The body of the test - runs in the tcpip thread.
+ */
+static void prvRunTests( void *pvParameters );
+
+/*
+ * The churn test.  Returns pdPASS if it passed.
+ */
+static BaseType_t prvChurn( void );
+
+/*
+ * Measures and prints the segments per second received with uxConnections
+ * connections open.
+ */
+static BaseType_t prvMeasure( UBaseType_t uxConnections );
+
+/*
+ * Opens a connection, and optionally sends its byte from each end.  Returns
+ * pdPASS if the connection was accepted, and each end received the byte sent
+ * by the other.
+ */
+static BaseType_t prvOpen( xConnection *pxConnection, u8_t ucId, BaseType_t xExchange );
+
+/*
+ * Closes or resets a connection from one end.
+ */
+static void prvClose( xConnectionEnd *pxEnd );
+static void prvReset( xConnectionEnd *pxEnd );
+
+/*
+ * Sends the connection's byte from one end.
+ */
+static void prvSend( xConnectionEnd *pxEnd );
+
+/*
+ * Checks the pcb lists against the open connections, and against the hash
+ * tables when TCP_PCB_HASH is 1.  Returns pdPASS if they match.
+ */
+static BaseType_t prvCheckPCBs( UBaseType_t uxOpen );
+
+/*
+ * Returns pdTRUE if either end of the connection from usPort is on the active
+ * or TIME-WAIT pcb list, or in their hash tables when TCP_PCB_HASH is 1.
+ */
+static BaseType_t prvFound( u16_t usPort );
+
+/*
+ * Receives the frames sent by the interface until there are none left.
+ */
+static void prvDrain( void );
+
+/*
+ * Network interface and TCP callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+static err_t prvAccept( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr );
+static err_t prvConnected( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr );
+static err_t prvReceive( void *pvArg, struct tcp_pcb *pxPCB, struct pbuf *p, err_t xErr );
+static void prvError( void *pvArg, err_t xErr );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The interface, its address, and the frames it has sent. */
+static struct netif xNetIf;
+static ip_addr_t xAddress;
+static struct pbuf *pxQueue[ tcpdemuxQUEUE_SIZE ];
+static unsigned long ulQueueHead = 0UL, ulQueued = 0UL, ulQueueDrops = 0UL;
+
+/* The listening pcb, and the connection it assigns the next pcb it accepts
+to. */
+static struct tcp_pcb *pxListener = NULL;
+static xConnection *pxAccepting = NULL;
+
+/* The connections. */
+static xConnection xConnections[ tcpdemuxMAX_CONNECTIONS ];
+
+/* Set when a connection receives a byte that is not its own. */
+static BaseType_t xMisdelivered = pdFALSE;
+
+/* The connection counts given on the command line. */
+static UBaseType_t uxCounts[ tcpdemuxMAX_COUNTS ] = { 1, 16, 64, 256 };
+static int iCounts = 4;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartTcpDemux( int argc, char *argv[] )
+{
+int i;
+
+	if( argc > tcpdemuxMAX_COUNTS )
+	{
+		printf( "tcpdemux: at most %d connection counts can be given\r\n", tcpdemuxMAX_COUNTS );
+		return pdFAIL;
+	}
+
+	if( argc > 0 )
+	{
+		iCounts = argc;
+	}
+
+	for( i = 0; i < argc; i++ )
+	{
+		uxCounts[ i ] = ( UBaseType_t ) strtoul( argv[ i ], NULL, 0 );
+
+		if( uxCounts[ i ] > tcpdemuxMAX_CONNECTIONS )
+		{
+			printf( "tcpdemux: the connections are limited to %d\r\n", tcpdemuxMAX_CONNECTIONS );
+			return pdFAIL;
+		}
+	}
+
+	return xTaskCreate( prvTcpDemuxTask, "TcpDemux", tcpdemuxTASK_STACK_SIZE, NULL, tcpdemuxTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iTcpDemuxFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTcpDemuxTask( void *pvParameters )
+{
+sys_sem_t xDone;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* lwIP's core functions may only be called from the tcpip thread. */
+	tcpip_callback( prvRunTests, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTests( void *pvParameters )
+{
+ip_addr_t xNetMask, xGateway;
+struct eth_addr xHardwareAddress;
+BaseType_t xPassed = pdPASS;
+int i;
+
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xAddress, 10, 0, 5, 1 );
+	netif_add( &xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xNetIf );
+
+	/* The interface's own address, so it sends to itself without an ARP
+	request. */
+	SMEMCPY( &xHardwareAddress, xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	etharp_add_static_entry( &xAddress, &xHardwareAddress );
+
+	pxListener = tcp_new();
+	configASSERT( pxListener );
+	tcp_bind( pxListener, IP_ADDR_ANY, tcpdemuxPORT );
+	pxListener = tcp_listen_with_backlog( pxListener, TCP_DEFAULT_LISTEN_BACKLOG );
+	configASSERT( pxListener );
+	tcp_accept( pxListener, prvAccept );
+
+	if( prvChurn() != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	for( i = 0; i < iCounts; i++ )
+	{
+		if( prvMeasure( uxCounts[ i ] ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	tcp_close( pxListener );
+	netif_remove( &xNetIf );
+
+	if( ulQueueDrops != 0UL )
+	{
+		printf( "tcpdemux: %lu frames dropped\r\n", ulQueueDrops );
+		xPassed = pdFAIL;
+	}
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvChurn( void )
+{
+xConnection *pxConnection;
+struct tcp_pcb *pxPCB;
+unsigned long ulStep, ulReset = 0UL;
+u16_t usPort = 0;
+UBaseType_t uxOpen = 0, uxTimeWait = 0;
+BaseType_t xPassed = pdPASS;
+
+	for( ulStep = 0UL; ( ulStep < tcpdemuxCHURN_CONNECTIONS + tcpdemuxCHURN_OPEN ) && ( xPassed == pdPASS ); ulStep++ )
+	{
+		pxConnection = &xConnections[ ulStep % tcpdemuxCHURN_OPEN ];
+
+		/* Close the oldest connection - from the client, from the server, or
+		by resetting it. */
+		if( ulStep >= tcpdemuxCHURN_OPEN )
+		{
+			switch( ulStep % 3UL )
+			{
+				case 0 :
+					prvClose( &( pxConnection->xEnds[ tcpdemuxCLIENT ] ) );
+					break;
+
+				case 1 :
+					prvClose( &( pxConnection->xEnds[ tcpdemuxSERVER ] ) );
+					break;
+
+				default :
+					usPort = pxConnection->xEnds[ tcpdemuxCLIENT ].pxPCB->local_port;
+					prvReset( &( pxConnection->xEnds[ tcpdemuxCLIENT ] ) );
+					ulReset++;
+					break;
+			}
+
+			prvDrain();
+			uxOpen--;
+
+			if( ( pxConnection->xEnds[ tcpdemuxCLIENT ].pxPCB != NULL ) || ( pxConnection->xEnds[ tcpdemuxSERVER ].pxPCB != NULL ) )
+			{
+				printf( "tcpdemux: churn: connection %lu not closed\r\n", ulStep - tcpdemuxCHURN_OPEN );
+				xPassed = pdFAIL;
+			}
+
+			/* Neither end of a reset connection is left behind. */
+			if( ( ( ulStep % 3UL ) == 2UL ) && ( prvFound( usPort ) != pdFALSE ) )
+			{
+				printf( "tcpdemux: churn: reset connection %lu still found\r\n", ulStep - tcpdemuxCHURN_OPEN );
+				xPassed = pdFAIL;
+			}
+		}
+
+		if( ulStep < tcpdemuxCHURN_CONNECTIONS )
+		{
+			if( prvOpen( pxConnection, ( u8_t ) ulStep, pdTRUE ) != pdPASS )
+			{
+				printf( "tcpdemux: churn: connection %lu failed\r\n", ulStep );
+				xPassed = pdFAIL;
+			}
+
+			uxOpen++;
+		}
+
+		if( prvCheckPCBs( uxOpen ) != pdPASS )
+		{
+			xPassed = pdFAIL;
+		}
+	}
+
+	if( xMisdelivered != pdFALSE )
+	{
+		printf( "tcpdemux: churn: a byte reached the wrong connection\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	/* Every connection that was closed rather than reset left a pcb in
+	TIME-WAIT.  Those no longer on the list were taken by tcp_alloc() when
+	the pool ran out. */
+	for( pxPCB = tcp_tw_pcbs; pxPCB != NULL; pxPCB = pxPCB->next )
+	{
+		uxTimeWait++;
+	}
+
+	if( uxTimeWait >= tcpdemuxCHURN_CONNECTIONS - ulReset )
+	{
+		printf( "tcpdemux: churn: no TIME-WAIT pcbs were reused\r\n" );
+		xPassed = pdFAIL;
+	}
+
+	printf( "tcpdemux: churn: %lu connections, %lu reset, %lu TIME-WAIT pcbs reused: %s\r\n", tcpdemuxCHURN_CONNECTIONS,
+			ulReset, tcpdemuxCHURN_CONNECTIONS - ulReset - ( unsigned long ) uxTimeWait,
+			( xPassed == pdPASS ) ? "tests passed" : "FAILED" );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMeasure( UBaseType_t uxConnections )
+{
+UBaseType_t x;
+unsigned long ulRound, ulRounds;
+unsigned long ulSegments;
+double dStart, dSeconds;
+BaseType_t xPassed = pdPASS;
+
+	if( uxConnections == 0 )
+	{
+		return pdPASS;
+	}
+
+	for( x = 0; x < uxConnections; x++ )
+	{
+		if( prvOpen( &xConnections[ x ], ( u8_t ) x, pdFALSE ) != pdPASS )
+		{
+			printf( "tcpdemux: connection %u failed\r\n", ( unsigned int ) x );
+			xPassed = pdFAIL;
+			uxConnections = x;
+			break;
+		}
+	}
+
+	/* Each round sends a segment from every client, and an acknowledgement
+	from every server. */
+	ulRounds = tcpdemuxSEGMENTS / ( 2UL * ( unsigned long ) uxConnections );
+	ulSegments = lwip_stats.tcp.recv;
+	dStart = prvCPUTime();
+
+	for( ulRound = 0UL; ulRound < ulRounds; ulRound++ )
+	{
+		for( x = 0; x < uxConnections; x++ )
+		{
+			prvSend( &( xConnections[ x ].xEnds[ tcpdemuxCLIENT ] ) );
+		}
+
+		prvDrain();
+		tcp_fasttmr();
+		prvDrain();
+	}
+
+	dSeconds = prvCPUTime() - dStart;
+	ulSegments = lwip_stats.tcp.recv - ulSegments;
+
+	for( x = 0; x < uxConnections; x++ )
+	{
+		if( xConnections[ x ].xEnds[ tcpdemuxSERVER ].ulReceived != ulRounds )
+		{
+			xPassed = pdFAIL;
+		}
+
+		prvClose( &( xConnections[ x ].xEnds[ tcpdemuxCLIENT ] ) );
+		prvDrain();
+	}
+
+	printf( "tcpdemux: %s, %u connections: %.0f segments/s (%lu segments)%s\r\n", TCP_PCB_HASH ? "hash" : "list",
+			( unsigned int ) uxConnections, ( dSeconds > 0.0 ) ? ( ( double ) ulSegments / dSeconds ) : 0.0,
+			ulSegments, ( xPassed == pdPASS ) ? "" : ", FAILED" );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvOpen( xConnection *pxConnection, u8_t ucId, BaseType_t xExchange )
+{
+xConnectionEnd *pxClient = &( pxConnection->xEnds[ tcpdemuxCLIENT ] );
+xConnectionEnd *pxServer = &( pxConnection->xEnds[ tcpdemuxSERVER ] );
+struct tcp_pcb *pxPCB;
+
+	pxConnection->ucId = ucId;
+	pxClient->pxConnection = pxConnection;
+	pxClient->ulReceived = 0UL;
+	pxServer->pxConnection = pxConnection;
+	pxServer->pxPCB = NULL;
+	pxServer->ulReceived = 0UL;
+
+	pxPCB = tcp_new();
+	pxClient->pxPCB = pxPCB;
+
+	if( pxPCB == NULL )
+	{
+		return pdFAIL;
+	}
+
+	tcp_arg( pxPCB, pxClient );
+	tcp_recv( pxPCB, prvReceive );
+	tcp_err( pxPCB, prvError );
+	tcp_nagle_disable( pxPCB );
+
+	/* The handshake completes before prvDrain() returns. */
+	pxAccepting = pxConnection;
+	tcp_connect( pxPCB, &xAddress, tcpdemuxPORT, prvConnected );
+	prvDrain();
+	pxAccepting = NULL;
+
+	if( ( pxServer->pxPCB == NULL ) || ( pxServer->pxPCB->remote_port != pxPCB->local_port ) )
+	{
+		return pdFAIL;
+	}
+
+	if( xExchange != pdFALSE )
+	{
+		prvSend( pxClient );
+		prvSend( pxServer );
+		prvDrain();
+
+		if( ( pxClient->ulReceived != 1UL ) || ( pxServer->ulReceived != 1UL ) )
+		{
+			return pdFAIL;
+		}
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvClose( xConnectionEnd *pxEnd )
+{
+struct tcp_pcb *pxPCB = pxEnd->pxPCB;
+
+	/* lwIP finishes closing the pcb without calling back. */
+	pxEnd->pxPCB = NULL;
+	tcp_arg( pxPCB, NULL );
+	tcp_recv( pxPCB, NULL );
+	tcp_err( pxPCB, NULL );
+
+	if( tcp_close( pxPCB ) != ERR_OK )
+	{
+		tcp_abort( pxPCB );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReset( xConnectionEnd *pxEnd )
+{
+struct tcp_pcb *pxPCB = pxEnd->pxPCB;
+
+	pxEnd->pxPCB = NULL;
+	tcp_err( pxPCB, NULL );
+	tcp_abort( pxPCB );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSend( xConnectionEnd *pxEnd )
+{
+	tcp_write( pxEnd->pxPCB, &( pxEnd->pxConnection->ucId ), 1, TCP_WRITE_FLAG_COPY );
+	tcp_output( pxEnd->pxPCB );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckPCBs( UBaseType_t uxOpen )
+{
+struct tcp_pcb *pxPCB;
+UBaseType_t uxActive = 0;
+BaseType_t xPassed = pdPASS;
+
+	for( pxPCB = tcp_active_pcbs; pxPCB != NULL; pxPCB = pxPCB->next )
+	{
+		uxActive++;
+
+		#if TCP_PCB_HASH
+		{
+			if( tcp_pcb_hash_lookup( &tcp_active_pcbs, &( pxPCB->remote_ip ), pxPCB->remote_port, &( pxPCB->local_ip ), pxPCB->local_port ) != pxPCB )
+			{
+				printf( "tcpdemux: active pcb %u -> %u not in the hash table\r\n", pxPCB->local_port, pxPCB->remote_port );
+				xPassed = pdFAIL;
+			}
+		}
+		#endif /* TCP_PCB_HASH */
+	}
+
+	#if TCP_PCB_HASH
+	{
+		for( pxPCB = tcp_tw_pcbs; pxPCB != NULL; pxPCB = pxPCB->next )
+		{
+			if( ( tcp_pcb_hash_lookup( &tcp_tw_pcbs, &( pxPCB->remote_ip ), pxPCB->remote_port, &( pxPCB->local_ip ), pxPCB->local_port ) != pxPCB ) ||
+				( tcp_pcb_hash_lookup( &tcp_active_pcbs, &( pxPCB->remote_ip ), pxPCB->remote_port, &( pxPCB->local_ip ), pxPCB->local_port ) != NULL ) )
+			{
+				printf( "tcpdemux: TIME-WAIT pcb %u -> %u not in the TIME-WAIT hash table only\r\n", pxPCB->local_port, pxPCB->remote_port );
+				xPassed = pdFAIL;
+			}
+		}
+
+		if( tcp_listen_hash_lookup( &xAddress, tcpdemuxPORT ) != ( struct tcp_pcb_listen * ) pxListener )
+		{
+			printf( "tcpdemux: listening pcb not in the hash table\r\n" );
+			xPassed = pdFAIL;
+		}
+	}
+	#endif /* TCP_PCB_HASH */
+
+	/* Both ends of each open connection, and nothing else. */
+	if( uxActive != 2 * uxOpen )
+	{
+		printf( "tcpdemux: %u active pcbs with %u connections open\r\n", ( unsigned int ) uxActive, ( unsigned int ) uxOpen );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFound( u16_t usPort )
+{
+struct tcp_pcb **ppxLists[ 2 ] = { &tcp_active_pcbs, &tcp_tw_pcbs };
+struct tcp_pcb *pxPCB;
+BaseType_t x;
+
+	for( x = 0; x < 2; x++ )
+	{
+		for( pxPCB = *ppxLists[ x ]; pxPCB != NULL; pxPCB = pxPCB->next )
+		{
+			if( ( pxPCB->local_port == usPort ) || ( pxPCB->remote_port == usPort ) )
+			{
+				return pdTRUE;
+			}
+		}
+
+		#if TCP_PCB_HASH
+		{
+			if( ( tcp_pcb_hash_lookup( ppxLists[ x ], &xAddress, usPort, &xAddress, tcpdemuxPORT ) != NULL ) ||
+				( tcp_pcb_hash_lookup( ppxLists[ x ], &xAddress, tcpdemuxPORT, &xAddress, usPort ) != NULL ) )
+			{
+				return pdTRUE;
+			}
+		}
+		#endif /* TCP_PCB_HASH */
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDrain( void )
+{
+struct pbuf *p;
+
+	while( ulQueued > 0UL )
+	{
+		p = pxQueue[ ulQueueHead ];
+		ulQueueHead = ( ulQueueHead + 1UL ) % tcpdemuxQUEUE_SIZE;
+		ulQueued--;
+
+		if( xNetIf.input( p, &xNetIf ) != ERR_OK )
+		{
+			pbuf_free( p );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 't';
+	pxNetIf->name[ 1 ] = 'd';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x04, ETHARP_HWADDR_LEN );
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+struct pbuf *q;
+
+	( void ) pxNetIf;
+
+	/* The frame is received later, by prvDrain(), as receiving it now would
+	call back into tcp_input() from inside tcp_input(). */
+	q = pbuf_alloc( PBUF_RAW, p->tot_len, PBUF_POOL );
+
+	if( ( q == NULL ) || ( ulQueued == tcpdemuxQUEUE_SIZE ) )
+	{
+		if( q != NULL )
+		{
+			pbuf_free( q );
+		}
+
+		ulQueueDrops++;
+	}
+	else
+	{
+		pbuf_copy( q, p );
+		pxQueue[ ( ulQueueHead + ulQueued ) % tcpdemuxQUEUE_SIZE ] = q;
+		ulQueued++;
+	}
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvAccept( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr )
+{
+xConnectionEnd *pxServer;
+
+	( void ) pvArg;
+	( void ) xErr;
+
+	if( pxAccepting == NULL )
+	{
+		tcp_abort( pxPCB );
+		return ERR_ABRT;
+	}
+
+	pxServer = &( pxAccepting->xEnds[ tcpdemuxSERVER ] );
+	pxServer->pxPCB = pxPCB;
+	tcp_arg( pxPCB, pxServer );
+	tcp_recv( pxPCB, prvReceive );
+	tcp_err( pxPCB, prvError );
+	tcp_nagle_disable( pxPCB );
+	tcp_accepted( pxListener );
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvConnected( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr )
+{
+	( void ) pvArg;
+	( void ) pxPCB;
+
+	return xErr;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvReceive( void *pvArg, struct tcp_pcb *pxPCB, struct pbuf *p, err_t xErr )
+{
+xConnectionEnd *pxEnd = ( xConnectionEnd * ) pvArg;
+struct pbuf *q;
+u16_t x;
+
+	( void ) xErr;
+
+	if( p == NULL )
+	{
+		/* The other end closed the connection, so close this one too. */
+		prvClose( pxEnd );
+		return ERR_OK;
+	}
+
+	for( q = p; q != NULL; q = q->next )
+	{
+		for( x = 0; x < q->len; x++ )
+		{
+			if( ( ( u8_t * ) q->payload )[ x ] != pxEnd->pxConnection->ucId )
+			{
+				xMisdelivered = pdTRUE;
+			}
+		}
+	}
+
+	pxEnd->ulReceived += p->tot_len;
+	tcp_recved( pxPCB, p->tot_len );
+	pbuf_free( p );
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( void *pvArg, err_t xErr )
+{
+xConnectionEnd *pxEnd = ( xConnectionEnd * ) pvArg;
+
+	/* The pcb has already been freed. */
+	( void ) xErr;
+	pxEnd->pxPCB = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
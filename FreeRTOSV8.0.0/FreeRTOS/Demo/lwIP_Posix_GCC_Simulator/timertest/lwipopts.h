@@ -0,0 +1,106 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * lwIP options for timertest.c.  The timer test runs the sys_timeout() code
+ * without an operating system (NO_SYS == 1), as that is the only way
+ * sys_check_timeouts() and sys_restart_timeouts() are built, so it uses these
+ * options rather than the lwipopts.h of the demo.  Nothing but the timeouts
+ * and the pools they come from is built.
+ */
+
+#ifndef __LWIPOPTS_H__
+#define __LWIPOPTS_H__
+
+/* ---------- Threads ---------- */
+#define NO_SYS							1
+
+/* ---------- APIs ---------- */
+#define LWIP_NETCONN					0
+#define LWIP_SOCKET						0
+
+/* ---------- Protocols ---------- */
+/* None, so sys_timeouts_init() sets no timeouts of its own. */
+#define LWIP_ARP						0
+#define LWIP_RAW						0
+#define LWIP_UDP						0
+#define LWIP_TCP						0
+#define LWIP_DHCP						0
+#define LWIP_AUTOIP						0
+#define LWIP_IGMP						0
+#define LWIP_DNS						0
+#define IP_REASSEMBLY					0
+#define IP_FRAG							0
+
+/* ---------- Memory ---------- */
+#define MEM_ALIGNMENT					4
+/* The 1000 timeouts of the benchmark, or the few hundred the trace keeps
+pending. */
+#define MEMP_NUM_SYS_TIMEOUT			2048
+
+/* ---------- Statistics ---------- */
+#define LWIP_STATS						0
+
+#endif /* __LWIPOPTS_H__ */
@@ -0,0 +1,666 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests and a benchmark of the lwIP timeouts - sys_timeout(), sys_untimeout(),
+ * sys_check_timeouts() and sys_restart_timeouts() - kept on the sorted list
+ * or on the timing wheel (see SYS_TIMEOUT_WHEEL in lwip/opt.h).  Usage:
+ *
+ *     timertest [timeouts...]
+ *
+ * sys_check_timeouts() and sys_restart_timeouts() are only built without an
+ * operating system, so this is not part of lwIPDemo: it is built with NO_SYS
+ * set (see lwipopts.h in this directory) and keeps its own clock, which
+ * starts timertestWRAP_AFTER milliseconds before it wraps.  The tests check
+ * that:
+ *
+ * - timeouts are called earliest first, those due in the same millisecond in
+ *   the order they were set, and one set by a handler counts from the time
+ *   that handler was due,
+ * - sys_untimeout() removes the matching timeout that is due first, does
+ *   nothing if no timeout matches both the handler and the argument, and
+ *   can remove a timeout due in the same millisecond as the handler calling
+ *   it,
+ * - after sys_check_timeouts() has not been called for a while,
+ *   sys_restart_timeouts() moves every pending timeout later by that time.
+ *
+ * The benchmark keeps each number of timeouts given on the command line (10,
+ * 100 and 1000 by default) pending, and times sys_untimeout() then
+ * sys_timeout() of one of them at random, as TCP does each time it restarts
+ * a timer, with the clock moving on a millisecond every timertestSTEPS_PER_MS
+ * pairs.
+ *
+ * The trace then runs timertestTRACE_STEPS random sys_timeout(),
+ * sys_untimeout(), clock ticks and restarts, with a fixed seed, and prints a
+ * digest of which handler was called when, with which argument.  "make check"
+ * compares the digest printed with and without SYS_TIMEOUT_WHEEL, as both
+ * must call every handler at the same time and in the same order.
+ *
+ * The list counts a timeout set outside a handler from the last time
+ * sys_check_timeouts() called a handler, not from sys_now(), and
+ * sys_restart_timeouts() moves the pending timeouts by the time since then.
+ * The tests and the trace only set timeouts and restart where those are the
+ * same, which is where both backends are meant to agree.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* lwIP includes. */
+#include "lwip/memp.h"
+#include "lwip/timers.h"
+
+/* The clock starts this many milliseconds before it wraps, so the tests run
+across the wrap. */
+#define timertestWRAP_AFTER				100UL
+
+/* How long sys_check_timeouts() is not called for in the restart test. */
+#define timertestSLEEP_MS				10000UL
+
+/* The benchmark - the most timeouts it keeps pending, the sys_untimeout() and
+sys_timeout() pairs it times for each number of them, how often the clock
+moves on, and the range of the timeouts it sets. */
+#define timertestMAX_TIMEOUTS			1000
+#define timertestOPERATIONS				200000UL
+#define timertestSTEPS_PER_MS			10UL
+#define timertestMIN_MS					100UL
+#define timertestMAX_MS					5000UL
+
+/* The trace - its steps, the arguments it passes, the longest timeout and the
+longest time without calling sys_check_timeouts() it sets. */
+#define timertestTRACE_STEPS			200000UL
+#define timertestTRACE_ARGS				64
+#define timertestTRACE_MAX_MS			600UL
+#define timertestTRACE_MAX_SLEEP_MS		5000UL
+#define timertestTRACE_SEED				12345UL
+
+/* The most handler calls a test records. */
+#define timertestMAX_CALLS				16
+
+/* The argument passed for number x - the handlers tell the timeouts apart by
+it. */
+#define timertestARG( x )				( ( void * ) &cArgs[ x ] )
+
+/*-----------------------------------------------------------*/
+
+/* A handler call recorded by a test - the number of its argument, and when it
+was made, in milliseconds from the start of the test. */
+typedef struct xCALL
+{
+	int iId;
+	u32_t ulTime;
+} xCall;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tests.  Each returns 1 if it passed.
+ */
+static int prvTestOrder( void );
+static int prvTestUntimeout( void );
+static int prvTestRestart( void );
+
+/*
+ * Measures and prints the time sys_untimeout() then sys_timeout() takes with
+ * iTimeouts pending.
+ */
+static void prvMeasure( int iTimeouts );
+
+/*
+ * Runs the trace and prints its digest.
+ */
+static void prvTrace( void );
+
+/*
+ * Starts a test: makes the current time the one new timeouts count from, and
+ * forgets the calls recorded so far.  Nothing may be pending.
+ */
+static void prvStart( void );
+
+/*
+ * Moves the clock on one millisecond at a time, calling sys_check_timeouts()
+ * each time.
+ */
+static void prvRun( u32_t ulMilliseconds );
+
+/*
+ * Checks the calls recorded since prvStart() were those in pxExpected, and
+ * prints them if not.  Returns 1 if they were.
+ */
+static int prvCheck( const char *pcTest, const xCall *pxExpected, int iExpected );
+
+/*
+ * Handlers used by the tests.  prvRecord() records the call.  prvChain() and
+ * prvCancel() record it, then set or remove other timeouts.
+ */
+static void prvRecord( void *pvArg );
+static void prvChain( void *pvArg );
+static void prvCancel( void *pvArg );
+
+/*
+ * The handler of the benchmark, which sets its timeout again.
+ */
+static void prvBenchHandler( void *pvArg );
+
+/*
+ * Handlers used by the trace.  prvTick(), also used by the benchmark, sets
+ * itself again every millisecond, so the list always counts from the current
+ * time (see above).
+ */
+static void prvTraceHandlerA( void *pvArg );
+static void prvTraceHandlerB( void *pvArg );
+static void prvTick( void *pvArg );
+
+/*
+ * The number of the argument pvArg.
+ */
+static int prvId( void *pvArg );
+
+/*
+ * Adds ulValue to the digest of the trace.
+ */
+static void prvDigest( unsigned long ulValue );
+
+/*
+ * A pseudo random number.
+ */
+static unsigned long prvRandom( void );
+
+/*
+ * The CPU time used by the process so far, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The clock returned by sys_now(), and the time the current test started. */
+static u32_t ulNow = ( u32_t ) ( 0x100000000ULL - timertestWRAP_AFTER );
+static u32_t ulStart;
+
+/* The handler calls recorded by the current test. */
+static xCall xCalls[ timertestMAX_CALLS ];
+static int iCalls;
+
+/* The arguments passed to the handlers. */
+static char cArgs[ timertestMAX_TIMEOUTS ];
+
+/* The handler calls made by the benchmark. */
+static unsigned long ulBenchCalls;
+
+/* The state of the trace, and of the pseudo random numbers used by it and
+the benchmark. */
+static unsigned long ulTraceCalls;
+static unsigned long ulDigest = 2166136261UL;
+static unsigned long ulRandom;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+static const int iDefaultTimeouts[] = { 10, 100, timertestMAX_TIMEOUTS };
+int iPassed, x;
+
+	for( x = 1; x < argc; x++ )
+	{
+		if( ( atoi( argv[ x ] ) < 1 ) || ( atoi( argv[ x ] ) > timertestMAX_TIMEOUTS ) )
+		{
+			printf( "Usage: %s [timeouts...]\r\n", argv[ 0 ] );
+			printf( "Each number of timeouts must be from 1 to %d.\r\n", timertestMAX_TIMEOUTS );
+			return 1;
+		}
+	}
+
+	memp_init();
+	sys_timeouts_init();
+
+	iPassed = prvTestOrder();
+	iPassed &= prvTestUntimeout();
+	iPassed &= prvTestRestart();
+	printf( "timertest: %s: %s\r\n", SYS_TIMEOUT_WHEEL ? "wheel" : "list", iPassed ? "tests passed" : "FAILED" );
+
+	if( argc > 1 )
+	{
+		for( x = 1; x < argc; x++ )
+		{
+			prvMeasure( atoi( argv[ x ] ) );
+		}
+	}
+	else
+	{
+		for( x = 0; x < ( int ) ( sizeof( iDefaultTimeouts ) / sizeof( iDefaultTimeouts[ 0 ] ) ); x++ )
+		{
+			prvMeasure( iDefaultTimeouts[ x ] );
+		}
+	}
+
+	prvTrace();
+
+	return iPassed ? 0 : 1;
+}
+/*-----------------------------------------------------------*/
+
+u32_t sys_now( void )
+{
+	return ulNow;
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestOrder( void )
+{
+static const xCall xExpected[] =
+{
+	{ 3, 5 }, { 1, 10 }, { 2, 10 }, { 4, 10 }, { 6, 20 }, { 9, 20 }, { 7, 20 }, { 8, 25 }, { 5, 300 }
+};
+
+	prvStart();
+
+	/* Three due at the same time, one before them, and one further away than
+	a turn of the default wheel. */
+	sys_timeout( 10, prvRecord, timertestARG( 1 ) );
+	sys_timeout( 10, prvRecord, timertestARG( 2 ) );
+	sys_timeout( 5, prvRecord, timertestARG( 3 ) );
+	sys_timeout( 10, prvRecord, timertestARG( 4 ) );
+	sys_timeout( 300, prvRecord, timertestARG( 5 ) );
+
+	/* prvChain() sets number 7 to be due at once, which makes it due after
+	number 9, and number 8 to be due 5 milliseconds after prvChain() was. */
+	sys_timeout( 20, prvChain, timertestARG( 6 ) );
+	sys_timeout( 20, prvRecord, timertestARG( 9 ) );
+
+	prvRun( 400 );
+
+	return prvCheck( "order", xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestUntimeout( void )
+{
+static const xCall xExpected[] =
+{
+	{ 3, 10 }, { 2, 20 }, { 1, 30 }, { 8, 35 }, { 5, 40 }
+};
+
+	prvStart();
+
+	/* Number 1 twice, the one set second due first, number 8 twice, the one
+	set first due first, and number 2 twice, due at the same time. */
+	sys_timeout( 30, prvRecord, timertestARG( 1 ) );
+	sys_timeout( 20, prvRecord, timertestARG( 1 ) );
+	sys_timeout( 25, prvRecord, timertestARG( 8 ) );
+	sys_timeout( 35, prvRecord, timertestARG( 8 ) );
+	sys_timeout( 20, prvRecord, timertestARG( 2 ) );
+	sys_timeout( 20, prvRecord, timertestARG( 2 ) );
+	sys_timeout( 10, prvRecord, timertestARG( 3 ) );
+
+	/* prvCancel() removes number 6, due in the same millisecond, and number
+	7. */
+	sys_timeout( 40, prvCancel, timertestARG( 5 ) );
+	sys_timeout( 40, prvRecord, timertestARG( 6 ) );
+	sys_timeout( 50, prvRecord, timertestARG( 7 ) );
+
+	/* These remove the number 1 due at 20, the number 8 due at 25, and one of
+	the number 2s.  Nothing matches the others - number 4 is not pending, and number 3
+	was not set with prvChain(). */
+	sys_untimeout( prvRecord, timertestARG( 1 ) );
+	sys_untimeout( prvRecord, timertestARG( 8 ) );
+	sys_untimeout( prvRecord, timertestARG( 2 ) );
+	sys_untimeout( prvRecord, timertestARG( 4 ) );
+	sys_untimeout( prvChain, timertestARG( 3 ) );
+
+	prvRun( 100 );
+
+	return prvCheck( "untimeout", xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestRestart( void )
+{
+static const xCall xExpected[] =
+{
+	{ 4, 50 }, { 1, 100 + timertestSLEEP_MS }, { 2, 300 + timertestSLEEP_MS }, { 3, 1000 + timertestSLEEP_MS }
+};
+
+	prvStart();
+
+	/* Number 4 is called just before sys_check_timeouts() stops being
+	called, which is the time the list restarts from (see above). */
+	sys_timeout( 50, prvRecord, timertestARG( 4 ) );
+	sys_timeout( 100, prvRecord, timertestARG( 1 ) );
+	sys_timeout( 300, prvRecord, timertestARG( 2 ) );
+	sys_timeout( 1000, prvRecord, timertestARG( 3 ) );
+	prvRun( 50 );
+
+	/* None of the others may be called as soon as the checks start again,
+	which would be at timertestSLEEP_MS + 50. */
+	ulNow += timertestSLEEP_MS;
+	sys_restart_timeouts();
+	prvRun( 1000 );
+
+	return prvCheck( "restart", xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( int iTimeouts )
+{
+unsigned long ulOperation;
+double dStart, dSeconds;
+int x;
+
+	/* A tick keeps the time the list counts from current, as the periodic
+	timers of the stack do. */
+	sys_timeout( 1, prvTick, NULL );
+
+	for( x = 0; x < iTimeouts; x++ )
+	{
+		sys_timeout( timertestMIN_MS + ( prvRandom() % ( timertestMAX_MS - timertestMIN_MS ) ), prvBenchHandler, timertestARG( x ) );
+	}
+
+	ulBenchCalls = 0UL;
+	dStart = prvCPUTime();
+
+	for( ulOperation = 1UL; ulOperation <= timertestOPERATIONS; ulOperation++ )
+	{
+		x = ( int ) ( prvRandom() % ( unsigned long ) iTimeouts );
+		sys_untimeout( prvBenchHandler, timertestARG( x ) );
+		sys_timeout( timertestMIN_MS + ( prvRandom() % ( timertestMAX_MS - timertestMIN_MS ) ), prvBenchHandler, timertestARG( x ) );
+
+		if( ( ulOperation % timertestSTEPS_PER_MS ) == 0UL )
+		{
+			prvRun( 1 );
+		}
+	}
+
+	dSeconds = prvCPUTime() - dStart;
+
+	/* Each argument has exactly one timeout pending. */
+	for( x = 0; x < iTimeouts; x++ )
+	{
+		sys_untimeout( prvBenchHandler, timertestARG( x ) );
+	}
+
+	sys_untimeout( prvTick, NULL );
+
+	printf( "timertest: %s, %d timeouts pending: %.0f ns per sys_untimeout() and sys_timeout(), %lu handlers called\r\n",
+			SYS_TIMEOUT_WHEEL ? "wheel" : "list", iTimeouts, ( dSeconds * 1e9 ) / ( double ) timertestOPERATIONS, ulBenchCalls );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTrace( void )
+{
+unsigned long ulStep;
+void *pvArg;
+
+	prvStart();
+	ulRandom = timertestTRACE_SEED;
+	sys_timeout( 1, prvTick, NULL );
+
+	for( ulStep = 0UL; ulStep < timertestTRACE_STEPS; ulStep++ )
+	{
+		pvArg = timertestARG( prvRandom() % timertestTRACE_ARGS );
+
+		switch( prvRandom() % 10UL )
+		{
+			case 0 :
+				/* Due now or very soon, so there are often several due in
+				the same millisecond. */
+				sys_timeout( prvRandom() % 4UL, prvTraceHandlerA, pvArg );
+				break;
+
+			case 1 :
+			case 2 :
+				sys_timeout( prvRandom() % timertestTRACE_MAX_MS, ( prvRandom() & 1UL ) ? prvTraceHandlerA : prvTraceHandlerB, pvArg );
+				break;
+
+			case 3 :
+				sys_untimeout( ( prvRandom() & 1UL ) ? prvTraceHandlerA : prvTraceHandlerB, pvArg );
+				break;
+
+			case 4 :
+				if( ( prvRandom() % 1000UL ) == 0UL )
+				{
+					/* sys_check_timeouts() is not called for a while. */
+					ulNow += prvRandom() % timertestTRACE_MAX_SLEEP_MS;
+					sys_restart_timeouts();
+					prvDigest( 0UL );
+				}
+				break;
+
+			default :
+				prvRun( 1 );
+				break;
+		}
+	}
+
+	printf( "timertest: trace: %lu steps, %lu handlers called, digest %08lx\r\n", timertestTRACE_STEPS, ulTraceCalls, ulDigest );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStart( void )
+{
+	/* With nothing pending this only sets the time the list counts from. */
+	sys_restart_timeouts();
+	ulStart = ulNow;
+	iCalls = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRun( u32_t ulMilliseconds )
+{
+	while( ulMilliseconds > 0UL )
+	{
+		ulNow++;
+		sys_check_timeouts();
+		ulMilliseconds--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvCheck( const char *pcTest, const xCall *pxExpected, int iExpected )
+{
+int x;
+
+	if( ( iCalls == iExpected ) && ( memcmp( xCalls, pxExpected, ( size_t ) iExpected * sizeof( xCall ) ) == 0 ) )
+	{
+		return 1;
+	}
+
+	printf( "timertest: %s: handlers called", pcTest );
+
+	for( x = 0; x < iCalls; x++ )
+	{
+		printf( " %d@%lu", xCalls[ x ].iId, ( unsigned long ) xCalls[ x ].ulTime );
+	}
+
+	printf( ", not" );
+
+	for( x = 0; x < iExpected; x++ )
+	{
+		printf( " %d@%lu", pxExpected[ x ].iId, ( unsigned long ) pxExpected[ x ].ulTime );
+	}
+
+	printf( "\r\n" );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( void *pvArg )
+{
+	if( iCalls < timertestMAX_CALLS )
+	{
+		xCalls[ iCalls ].iId = prvId( pvArg );
+		xCalls[ iCalls ].ulTime = ulNow - ulStart;
+	}
+
+	iCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvChain( void *pvArg )
+{
+	prvRecord( pvArg );
+	sys_timeout( 0, prvRecord, timertestARG( 7 ) );
+	sys_timeout( 5, prvRecord, timertestARG( 8 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCancel( void *pvArg )
+{
+	prvRecord( pvArg );
+	sys_untimeout( prvRecord, timertestARG( 6 ) );
+	sys_untimeout( prvRecord, timertestARG( 7 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchHandler( void *pvArg )
+{
+	ulBenchCalls++;
+	sys_timeout( timertestMIN_MS + ( prvRandom() % ( timertestMAX_MS - timertestMIN_MS ) ), prvBenchHandler, pvArg );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceHandlerA( void *pvArg )
+{
+void *pvOther;
+
+	ulTraceCalls++;
+	prvDigest( 1UL );
+	prvDigest( ( unsigned long ) prvId( pvArg ) );
+	prvDigest( ( unsigned long ) ( ulNow - ulStart ) );
+
+	/* Set or remove another timeout now and then, including one due in this
+	same millisecond. */
+	pvOther = timertestARG( prvRandom() % timertestTRACE_ARGS );
+
+	switch( prvRandom() % 8UL )
+	{
+		case 0 :
+		case 1 :
+			sys_timeout( prvRandom() % ( timertestTRACE_MAX_MS / 2UL ), ( prvRandom() & 1UL ) ? prvTraceHandlerA : prvTraceHandlerB, pvOther );
+			break;
+
+		case 2 :
+			sys_untimeout( ( prvRandom() & 1UL ) ? prvTraceHandlerA : prvTraceHandlerB, pvOther );
+			break;
+
+		default :
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceHandlerB( void *pvArg )
+{
+	ulTraceCalls++;
+	prvDigest( 2UL );
+	prvDigest( ( unsigned long ) prvId( pvArg ) );
+	prvDigest( ( unsigned long ) ( ulNow - ulStart ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTick( void *pvArg )
+{
+	sys_timeout( 1, prvTick, pvArg );
+}
+/*-----------------------------------------------------------*/
+
+static int prvId( void *pvArg )
+{
+	return ( int ) ( ( char * ) pvArg - cArgs );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDigest( unsigned long ulValue )
+{
+int x;
+
+	/* 32 bit FNV-1a over the four bytes of ulValue. */
+	for( x = 0; x < 4; x++ )
+	{
+		ulDigest ^= ( ulValue >> ( x * 8 ) ) & 0xffUL;
+		ulDigest = ( ulDigest * 16777619UL ) & 0xffffffffUL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	/* The same sequence on every host, unlike rand(). */
+	ulRandom = ( ( ulRandom * 1103515245UL ) + 12345UL ) & 0x7fffffffUL;
+	return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
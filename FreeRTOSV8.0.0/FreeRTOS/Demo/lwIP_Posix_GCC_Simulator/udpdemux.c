@@ -0,0 +1,747 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests and a datagrams per second benchmark of the way udp_input() finds
+ * the pcb of each incoming datagram (see UDP_PCB_HASH in lwip/opt.h).
+ *
+ * Everything runs inside the tcpip thread.  Two network interfaces are
+ * created, 10.0.6.1/24 and 10.0.7.1/24, and datagrams from two peers,
+ * 10.0.6.2 and 10.0.6.3, are built and passed straight to the first one's
+ * ethernet_input().
+ *
+ * The tests bind udpdemuxPCBS pcbs to consecutive ports, then check that:
+ *
+ * - each datagram reaches the pcb bound to its port, and one to a port
+ *   nothing is bound to, or whose pcb was removed, is answered with a port
+ *   unreachable,
+ * - a connected pcb only receives from the peer it is connected to,
+ * - a broadcast reaches the connected pcb of its sender if there is one,
+ *   otherwise the first unconnected pcb bound to its port, counting a pcb
+ *   that was rebound from another port from where it was first bound.
+ *
+ * The trace then runs udpdemuxTRACE_STEPS random binds, rebinds, connects,
+ * disconnects, removes and datagrams, with a fixed seed, over a few ports and
+ * addresses.  It prints a digest of which pcb received each datagram and the
+ * result of each call.  "make check" compares the digest printed with and
+ * without UDP_PCB_HASH, as both must deliver every datagram the same way.
+ *
+ * The benchmark sends datagrams to the udpdemuxPCBS pcbs - to the pcb bound
+ * first, which is at the end of udp_pcbs, to the pcb bound last, and to each
+ * of them in turn.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/inet_chksum.h"
+#include "lwip/ip.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+#include "netif/etharp.h"
+
+/* Demo includes. */
+#include "udpdemux.h"
+
+/* The pcbs bound by the tests and the benchmark, and the first port they are
+bound to. */
+#define udpdemuxPCBS					256
+#define udpdemuxFIRST_PORT				6000
+
+/* The ports used by the connected and broadcast tests. */
+#define udpdemuxCONNECTED_PORT			7000
+#define udpdemuxBROADCAST_PORT			7100
+#define udpdemuxREBOUND_PORT			7200
+#define udpdemuxPREFERRED_PORT			7300
+
+/* The trace - its steps, the pcbs it uses, and the ports it binds them to.
+Two of the ports share a hash bucket. */
+#define udpdemuxTRACE_STEPS				100000UL
+#define udpdemuxTRACE_PCBS				24
+#define udpdemuxTRACE_PORTS				5
+#define udpdemuxTRACE_SEED				12345UL
+
+/* Ids passed to the receive callback of the pcbs that are not numbered. */
+#define udpdemuxTEST_ID					1000L
+#define udpdemuxTRACE_ID				2000L
+#define udpdemuxNONE					( -1L )
+
+/* Defaults used when the arguments are not given on the command line. */
+#define udpdemuxDEFAULT_DATAGRAMS		1000000UL
+
+/* The peers the datagrams come from, and their ports. */
+#define udpdemuxPEERS					2
+#define udpdemuxPEER_PORT				1024
+
+/* The payload of every datagram. */
+#define udpdemuxPAYLOAD					4
+
+/* The largest frame built, including ETH_PAD_SIZE. */
+#define udpdemuxFRAME_SIZE				( ETH_PAD_SIZE + SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN + udpdemuxPAYLOAD )
+
+/* Priority and stack size of the task that runs the tests. */
+#define udpdemuxTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define udpdemuxTASK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 8 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the tcpip thread, then runs prvRunTests() in it.
+ */
+static void prvUdpDemuxTask( void *pvParameters );
+
+/*
+ * The body of the test - runs in the tcpip thread.
+ */
+static void prvRunTests( void *pvParameters );
+
+/*
+ * The tests and the trace.  Each returns pdPASS if it passed.
+ */
+static BaseType_t prvTestPorts( void );
+static BaseType_t prvTestConnected( void );
+static BaseType_t prvTestBroadcast( void );
+static BaseType_t prvTrace( void );
+
+/*
+ * Measures and prints the datagrams per second received.  usPort is the port
+ * they are sent to, or 0 to send them to each of the numbered pcbs in turn.
+ */
+static void prvMeasure( const char *pcName, u16_t usPort );
+
+/*
+ * Creates a pcb, binds it to pxAddress and usPort, and sets its receive
+ * callback to pass lId.
+ */
+static struct udp_pcb *prvBind( ip_addr_t *pxAddress, u16_t usPort, long lId );
+
+/*
+ * Builds a datagram from peer xPeer to pxDestination:usPort in pucFrame, and
+ * returns the length of the frame, including ETH_PAD_SIZE.
+ */
+static u16_t prvBuildFrame( u8_t *pucFrame, BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort );
+
+/*
+ * Receives the frame in pucFrame.
+ */
+static void prvInput( const u8_t *pucFrame, u16_t usLength );
+
+/*
+ * Sends a datagram from peer xPeer to pxDestination:usPort.  Returns the id of
+ * the pcb that received it, or udpdemuxNONE.
+ */
+static long prvDeliver( BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort );
+
+/*
+ * Checks that a datagram from xPeer to pxDestination:usPort is received by the
+ * pcb lExpected, printing pcTest if it is not.  Returns pdPASS if it is.
+ */
+static BaseType_t prvExpect( const char *pcTest, BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort, long lExpected );
+
+/*
+ * Adds ulValue to the digest of the trace.
+ */
+static void prvDigest( unsigned long ulValue );
+
+/*
+ * The next number from the random number generator used by the trace.
+ */
+static unsigned long prvRandom( void );
+
+/*
+ * Network interface and UDP callbacks.
+ */
+static err_t prvNetIfInit( struct netif *pxNetIf );
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p );
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *p, ip_addr_t *pxAddr, u16_t usPort );
+
+/*
+ * The CPU time used by the process, in seconds.
+ */
+static double prvCPUTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The interfaces, their addresses and broadcast addresses, and the peers. */
+static struct netif xNetIf, xSecondNetIf;
+static ip_addr_t xAddress, xSecondAddress, xBroadcast, xLimitedBroadcast;
+static ip_addr_t xPeers[ udpdemuxPEERS ];
+
+/* The frames the interfaces have sent. */
+static unsigned long ulSent = 0UL;
+
+/* The pcbs the tests and the benchmark bind to consecutive ports. */
+static struct udp_pcb *pxPCBs[ udpdemuxPCBS ];
+
+/* The id of the pcb that received the last datagram, and the number of
+datagrams received. */
+static long lReceiver = udpdemuxNONE;
+static unsigned long ulReceived = 0UL;
+
+/* The trace's digest and random number generator. */
+static unsigned long ulDigest = 2166136261UL;
+static unsigned long ulRandom = udpdemuxTRACE_SEED;
+
+/* One frame for each of the numbered pcbs. */
+static u8_t ucFrames[ udpdemuxPCBS ][ udpdemuxFRAME_SIZE ];
+
+/* The number of datagrams each measurement sends. */
+static unsigned long ulDatagrams = udpdemuxDEFAULT_DATAGRAMS;
+
+/* The exit code of the process. */
+static int iResult = 1;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStartUdpDemux( int argc, char *argv[] )
+{
+	if( argc > 0 )
+	{
+		ulDatagrams = strtoul( argv[ 0 ], NULL, 0 );
+	}
+
+	return xTaskCreate( prvUdpDemuxTask, "UdpDemux", udpdemuxTASK_STACK_SIZE, NULL, udpdemuxTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+int iUdpDemuxFinish( void )
+{
+	return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUdpDemuxTask( void *pvParameters )
+{
+sys_sem_t xDone;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	sys_sem_new( &xDone, 0 );
+	tcpip_init( ( tcpip_init_done_fn ) sys_sem_signal, &xDone );
+	sys_sem_wait( &xDone );
+
+	/* lwIP's core functions may only be called from the tcpip thread. */
+	tcpip_callback( prvRunTests, &xDone );
+	sys_sem_wait( &xDone );
+	sys_sem_free( &xDone );
+
+	fflush( stdout );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTests( void *pvParameters )
+{
+ip_addr_t xNetMask, xGateway;
+struct eth_addr xPeerAddress;
+BaseType_t xPassed = pdPASS, x;
+
+	IP4_ADDR( &xNetMask, 255, 255, 255, 0 );
+	IP4_ADDR( &xGateway, 0, 0, 0, 0 );
+	IP4_ADDR( &xAddress, 10, 0, 6, 1 );
+	netif_add( &xNetIf, &xAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xNetIf );
+	IP4_ADDR( &xSecondAddress, 10, 0, 7, 1 );
+	netif_add( &xSecondNetIf, &xSecondAddress, &xNetMask, &xGateway, NULL, prvNetIfInit, ethernet_input );
+	netif_set_up( &xSecondNetIf );
+	IP4_ADDR( &xBroadcast, 10, 0, 6, 255 );
+	ip_addr_copy( xLimitedBroadcast, *IP_ADDR_BROADCAST );
+
+	/* The peers, so port unreachables are sent without an ARP request. */
+	memset( &xPeerAddress, 0x02, sizeof( xPeerAddress ) );
+
+	for( x = 0; x < udpdemuxPEERS; x++ )
+	{
+		IP4_ADDR( &xPeers[ x ], 10, 0, 6, 2 + x );
+		etharp_add_static_entry( &xPeers[ x ], &xPeerAddress );
+	}
+
+	if( ( prvTestPorts() != pdPASS ) || ( prvTestConnected() != pdPASS ) || ( prvTestBroadcast() != pdPASS ) )
+	{
+		xPassed = pdFAIL;
+	}
+
+	printf( "udpdemux: %s: %s\r\n", UDP_PCB_HASH ? "hash" : "list", ( xPassed == pdPASS ) ? "tests passed" : "FAILED" );
+
+	if( prvTrace() != pdPASS )
+	{
+		xPassed = pdFAIL;
+	}
+
+	if( ulDatagrams > 0UL )
+	{
+		prvMeasure( "first bound", udpdemuxFIRST_PORT );
+		prvMeasure( "last bound", udpdemuxFIRST_PORT + udpdemuxPCBS - 1 );
+		prvMeasure( "each in turn", 0 );
+	}
+
+	for( x = 0; x < udpdemuxPCBS; x++ )
+	{
+		if( pxPCBs[ x ] != NULL )
+		{
+			udp_remove( pxPCBs[ x ] );
+		}
+	}
+
+	netif_remove( &xNetIf );
+	netif_remove( &xSecondNetIf );
+
+	iResult = ( xPassed == pdPASS ) ? 0 : 1;
+	sys_sem_signal( ( sys_sem_t * ) pvParameters );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestPorts( void )
+{
+BaseType_t xPassed = pdPASS;
+unsigned long ulUnreachables;
+long x;
+
+	for( x = 0; x < udpdemuxPCBS; x++ )
+	{
+		pxPCBs[ x ] = prvBind( IP_ADDR_ANY, udpdemuxFIRST_PORT + x, x );
+	}
+
+	for( x = 0; x < udpdemuxPCBS; x++ )
+	{
+		xPassed &= prvExpect( "bound port", 0, &xAddress, udpdemuxFIRST_PORT + x, x );
+	}
+
+	/* The pcbs are bound to any address. */
+	xPassed &= prvExpect( "second address", 1, &xSecondAddress, udpdemuxFIRST_PORT + 1, 1 );
+
+	/* A port nothing is bound to, and one whose pcb has been removed. */
+	ulUnreachables = ulSent;
+	xPassed &= prvExpect( "unbound port", 0, &xAddress, udpdemuxFIRST_PORT + udpdemuxPCBS, udpdemuxNONE );
+	udp_remove( pxPCBs[ 3 ] );
+	pxPCBs[ 3 ] = NULL;
+	xPassed &= prvExpect( "removed pcb", 0, &xAddress, udpdemuxFIRST_PORT + 3, udpdemuxNONE );
+	pxPCBs[ 3 ] = prvBind( IP_ADDR_ANY, udpdemuxFIRST_PORT + 3, 3 );
+	xPassed &= prvExpect( "bound again", 0, &xAddress, udpdemuxFIRST_PORT + 3, 3 );
+
+	if( ulSent - ulUnreachables != 2UL )
+	{
+		printf( "udpdemux: %lu port unreachables sent, not 2\r\n", ulSent - ulUnreachables );
+		xPassed = pdFAIL;
+	}
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestConnected( void )
+{
+struct udp_pcb *pxPCB;
+BaseType_t xPassed = pdPASS;
+
+	pxPCB = prvBind( IP_ADDR_ANY, udpdemuxCONNECTED_PORT, udpdemuxTEST_ID );
+	udp_connect( pxPCB, &xPeers[ 0 ], udpdemuxPEER_PORT );
+
+	xPassed &= prvExpect( "connected peer", 0, &xAddress, udpdemuxCONNECTED_PORT, udpdemuxTEST_ID );
+	xPassed &= prvExpect( "other peer", 1, &xAddress, udpdemuxCONNECTED_PORT, udpdemuxNONE );
+	udp_disconnect( pxPCB );
+	xPassed &= prvExpect( "disconnected", 1, &xAddress, udpdemuxCONNECTED_PORT, udpdemuxTEST_ID );
+
+	udp_remove( pxPCB );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestBroadcast( void )
+{
+struct udp_pcb *pxFirst, *pxSecond;
+BaseType_t xPassed = pdPASS;
+
+	/* The most recently bound unconnected pcb is found first. */
+	pxFirst = prvBind( &xAddress, udpdemuxBROADCAST_PORT, udpdemuxTEST_ID );
+	pxSecond = prvBind( &xSecondAddress, udpdemuxBROADCAST_PORT, udpdemuxTEST_ID + 1 );
+	xPassed &= prvExpect( "broadcast", 0, &xBroadcast, udpdemuxBROADCAST_PORT, udpdemuxTEST_ID + 1 );
+	xPassed &= prvExpect( "limited broadcast", 0, &xLimitedBroadcast, udpdemuxBROADCAST_PORT, udpdemuxTEST_ID + 1 );
+	xPassed &= prvExpect( "unicast", 0, &xAddress, udpdemuxBROADCAST_PORT, udpdemuxTEST_ID );
+	udp_remove( pxFirst );
+	udp_remove( pxSecond );
+
+	/* A pcb rebound from another port is found from where it was first
+	bound, so after the pcb bound since. */
+	pxFirst = prvBind( &xSecondAddress, udpdemuxREBOUND_PORT + 1, udpdemuxTEST_ID );
+	pxSecond = prvBind( &xAddress, udpdemuxREBOUND_PORT, udpdemuxTEST_ID + 1 );
+	udp_bind( pxFirst, &xSecondAddress, udpdemuxREBOUND_PORT );
+	xPassed &= prvExpect( "rebound", 0, &xBroadcast, udpdemuxREBOUND_PORT, udpdemuxTEST_ID + 1 );
+	xPassed &= prvExpect( "rebound unicast", 0, &xSecondAddress, udpdemuxREBOUND_PORT, udpdemuxTEST_ID );
+	xPassed &= prvExpect( "old port", 0, &xSecondAddress, udpdemuxREBOUND_PORT + 1, udpdemuxNONE );
+	udp_remove( pxFirst );
+	udp_remove( pxSecond );
+
+	/* The connected pcb of the sender is preferred, wherever it is. */
+	pxFirst = prvBind( &xAddress, udpdemuxPREFERRED_PORT, udpdemuxTEST_ID );
+	pxSecond = prvBind( &xSecondAddress, udpdemuxPREFERRED_PORT, udpdemuxTEST_ID + 1 );
+	udp_connect( pxFirst, &xPeers[ 1 ], udpdemuxPEER_PORT + 1 );
+	xPassed &= prvExpect( "connected broadcast", 1, &xBroadcast, udpdemuxPREFERRED_PORT, udpdemuxTEST_ID );
+	xPassed &= prvExpect( "unconnected broadcast", 0, &xBroadcast, udpdemuxPREFERRED_PORT, udpdemuxTEST_ID + 1 );
+	udp_remove( pxFirst );
+	udp_remove( pxSecond );
+
+	return xPassed;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTrace( void )
+{
+struct udp_pcb *pxTrace[ udpdemuxTRACE_PCBS ];
+ip_addr_t *pxAddresses[ 3 ];
+ip_addr_t *pxDestinations[ 4 ];
+const u16_t usPorts[ udpdemuxTRACE_PORTS ] = { 8000, 8001, 8002, 8000 + UDP_PCB_HASH_SIZE, 8003 };
+unsigned long ulStep, ulDelivered = 0UL;
+UBaseType_t uxSlot;
+long lId;
+
+	pxAddresses[ 0 ] = IP_ADDR_ANY;
+	pxAddresses[ 1 ] = &xAddress;
+	pxAddresses[ 2 ] = &xSecondAddress;
+	pxDestinations[ 0 ] = &xAddress;
+	pxDestinations[ 1 ] = &xSecondAddress;
+	pxDestinations[ 2 ] = &xBroadcast;
+	pxDestinations[ 3 ] = &xLimitedBroadcast;
+	memset( pxTrace, 0x00, sizeof( pxTrace ) );
+
+	for( ulStep = 0UL; ulStep < udpdemuxTRACE_STEPS; ulStep++ )
+	{
+		uxSlot = ( UBaseType_t ) ( prvRandom() % udpdemuxTRACE_PCBS );
+
+		switch( prvRandom() % 10UL )
+		{
+			case 0 :
+			case 1 :
+				/* Bind, or rebind, to a random address and port.  This fails
+				if another pcb has the port. */
+				if( pxTrace[ uxSlot ] == NULL )
+				{
+					pxTrace[ uxSlot ] = udp_new();
+					configASSERT( pxTrace[ uxSlot ] );
+					udp_recv( pxTrace[ uxSlot ], prvUDPReceive, ( void * ) ( udpdemuxTRACE_ID + ( long ) uxSlot ) );
+				}
+
+				prvDigest( ( unsigned long ) udp_bind( pxTrace[ uxSlot ], pxAddresses[ prvRandom() % 3UL ], usPorts[ prvRandom() % udpdemuxTRACE_PORTS ] ) );
+				break;
+
+			case 2 :
+				/* Connect, binding to a free port if not bound. */
+				if( pxTrace[ uxSlot ] != NULL )
+				{
+					lId = ( long ) ( prvRandom() % udpdemuxPEERS );
+					prvDigest( ( unsigned long ) udp_connect( pxTrace[ uxSlot ], &xPeers[ lId ], udpdemuxPEER_PORT + lId ) );
+					prvDigest( pxTrace[ uxSlot ]->local_port );
+				}
+				break;
+
+			case 3 :
+				if( pxTrace[ uxSlot ] != NULL )
+				{
+					udp_disconnect( pxTrace[ uxSlot ] );
+				}
+				break;
+
+			case 4 :
+				if( pxTrace[ uxSlot ] != NULL )
+				{
+					udp_remove( pxTrace[ uxSlot ] );
+					pxTrace[ uxSlot ] = NULL;
+				}
+				break;
+
+			default :
+				lId = ( long ) ( prvRandom() % udpdemuxPEERS );
+				lId = prvDeliver( ( BaseType_t ) lId, pxDestinations[ prvRandom() % 4UL ], usPorts[ prvRandom() % udpdemuxTRACE_PORTS ] );
+				prvDigest( ( unsigned long ) lId );
+
+				if( lId != udpdemuxNONE )
+				{
+					ulDelivered++;
+				}
+				break;
+		}
+	}
+
+	prvDigest( ulSent );
+
+	for( uxSlot = 0; uxSlot < udpdemuxTRACE_PCBS; uxSlot++ )
+	{
+		if( pxTrace[ uxSlot ] != NULL )
+		{
+			udp_remove( pxTrace[ uxSlot ] );
+		}
+	}
+
+	/* The digest is compared with that of the other build by "make check". */
+	printf( "udpdemux: trace: %lu steps, %lu datagrams delivered, digest %08lx\r\n", udpdemuxTRACE_STEPS, ulDelivered, ulDigest );
+
+	return ( ulDelivered > 0UL ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( const char *pcName, u16_t usPort )
+{
+unsigned long ulDatagram;
+u16_t usLength = 0, x;
+double dStart, dSeconds;
+
+	for( x = 0; x < udpdemuxPCBS; x++ )
+	{
+		usLength = prvBuildFrame( ucFrames[ x ], 0, &xAddress, ( usPort != 0 ) ? usPort : udpdemuxFIRST_PORT + x );
+	}
+
+	ulReceived = 0UL;
+	dStart = prvCPUTime();
+
+	for( ulDatagram = 0UL; ulDatagram < ulDatagrams; ulDatagram++ )
+	{
+		prvInput( ucFrames[ ulDatagram % udpdemuxPCBS ], usLength );
+	}
+
+	dSeconds = prvCPUTime() - dStart;
+
+	printf( "udpdemux: %s, %d pcbs, %s: %.3f M datagrams/s, %lu of %lu received\r\n", UDP_PCB_HASH ? "hash" : "list",
+			udpdemuxPCBS, pcName, ( dSeconds > 0.0 ) ? ( ( double ) ulDatagrams / dSeconds / 1e6 ) : 0.0, ulReceived, ulDatagrams );
+}
+/*-----------------------------------------------------------*/
+
+static struct udp_pcb *prvBind( ip_addr_t *pxAddress, u16_t usPort, long lId )
+{
+struct udp_pcb *pxPCB;
+
+	pxPCB = udp_new();
+	configASSERT( pxPCB );
+	udp_recv( pxPCB, prvUDPReceive, ( void * ) lId );
+
+	if( udp_bind( pxPCB, pxAddress, usPort ) != ERR_OK )
+	{
+		printf( "udpdemux: could not bind port %u\r\n", usPort );
+	}
+
+	return pxPCB;
+}
+/*-----------------------------------------------------------*/
+
+static u16_t prvBuildFrame( u8_t *pucFrame, BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort )
+{
+struct eth_hdr *pxEthernet = ( struct eth_hdr * ) pucFrame;
+struct ip_hdr *pxIP = ( struct ip_hdr * ) &pucFrame[ SIZEOF_ETH_HDR ];
+struct udp_hdr *pxUDP = ( struct udp_hdr * ) ( pxIP + 1 );
+u16_t usIPLength = IP_HLEN + UDP_HLEN + udpdemuxPAYLOAD;
+
+	memset( pucFrame, 0x00, udpdemuxFRAME_SIZE );
+	memset( &pucFrame[ SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN ], 0x55, udpdemuxPAYLOAD );
+
+	if( ip4_addr4( pxDestination ) == 255 )
+	{
+		memset( &pxEthernet->dest, 0xff, ETHARP_HWADDR_LEN );
+	}
+	else
+	{
+		SMEMCPY( &pxEthernet->dest, xNetIf.hwaddr, ETHARP_HWADDR_LEN );
+	}
+
+	memset( &pxEthernet->src, 0x02, ETHARP_HWADDR_LEN );
+	pxEthernet->type = PP_HTONS( ETHTYPE_IP );
+
+	IPH_VHLTOS_SET( pxIP, 4, IP_HLEN / 4, 0 );
+	IPH_LEN_SET( pxIP, htons( usIPLength ) );
+	IPH_TTL_SET( pxIP, 64 );
+	IPH_PROTO_SET( pxIP, IP_PROTO_UDP );
+	ip_addr_copy( pxIP->src, xPeers[ xPeer ] );
+	ip_addr_copy( pxIP->dest, *pxDestination );
+	IPH_CHKSUM_SET( pxIP, inet_chksum( pxIP, IP_HLEN ) );
+
+	/* No UDP checksum. */
+	pxUDP->src = htons( udpdemuxPEER_PORT + xPeer );
+	pxUDP->dest = htons( usPort );
+	pxUDP->len = htons( UDP_HLEN + udpdemuxPAYLOAD );
+
+	return SIZEOF_ETH_HDR + usIPLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInput( const u8_t *pucFrame, u16_t usLength )
+{
+struct pbuf *p;
+
+	/* Copied into a pool pbuf, as the skeleton ethernetif.c does. */
+	p = pbuf_alloc( PBUF_RAW, usLength, PBUF_POOL );
+
+	if( p != NULL )
+	{
+		pbuf_take( p, pucFrame, usLength );
+
+		if( xNetIf.input( p, &xNetIf ) != ERR_OK )
+		{
+			pbuf_free( p );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static long prvDeliver( BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort )
+{
+u8_t ucFrame[ udpdemuxFRAME_SIZE ];
+
+	lReceiver = udpdemuxNONE;
+	prvInput( ucFrame, prvBuildFrame( ucFrame, xPeer, pxDestination, usPort ) );
+
+	return lReceiver;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvExpect( const char *pcTest, BaseType_t xPeer, ip_addr_t *pxDestination, u16_t usPort, long lExpected )
+{
+long lId = prvDeliver( xPeer, pxDestination, usPort );
+
+	if( lId != lExpected )
+	{
+		printf( "udpdemux: %s: datagram to port %u received by %ld, not %ld\r\n", pcTest, usPort, lId, lExpected );
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDigest( unsigned long ulValue )
+{
+BaseType_t x;
+
+	/* 32 bit FNV-1a over the four bytes of ulValue. */
+	for( x = 0; x < 4; x++ )
+	{
+		ulDigest ^= ( ulValue >> ( x * 8 ) ) & 0xffUL;
+		ulDigest = ( ulDigest * 16777619UL ) & 0xffffffffUL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	/* The same sequence on every host, unlike rand(). */
+	ulRandom = ( ( ulRandom * 1103515245UL ) + 12345UL ) & 0x7fffffffUL;
+	return ulRandom >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvNetIfInit( struct netif *pxNetIf )
+{
+	pxNetIf->name[ 0 ] = 'u';
+	pxNetIf->name[ 1 ] = 'd';
+	pxNetIf->output = etharp_output;
+	pxNetIf->linkoutput = prvLinkOutput;
+	pxNetIf->mtu = 1500;
+	pxNetIf->hwaddr_len = ETHARP_HWADDR_LEN;
+	memset( pxNetIf->hwaddr, 0x04, ETHARP_HWADDR_LEN );
+	pxNetIf->hwaddr[ 5 ] = ( pxNetIf == &xNetIf ) ? 1 : 2;
+	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvLinkOutput( struct netif *pxNetIf, struct pbuf *p )
+{
+	( void ) pxNetIf;
+	( void ) p;
+
+	ulSent++;
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *p, ip_addr_t *pxAddr, u16_t usPort )
+{
+	( void ) pxPCB;
+	( void ) pxAddr;
+	( void ) usPort;
+
+	lReceiver = ( long ) pvArg;
+	ulReceived++;
+	pbuf_free( p );
+}
+/*-----------------------------------------------------------*/
+
+static double prvCPUTime( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+	return ( double ) xNow.tv_sec + ( ( double ) xNow.tv_nsec * 1e-9 );
+}
+/*-----------------------------------------------------------*/
@@ -77,6 +77,14 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_WAIT_SETS == 1 )
+	#include "waitset.h"
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -115,6 +123,10 @@ typedef struct xEventGroupDefinition
 		UBaseType_t uxEventGroupNumber;
 	#endif
 
+	#if( configUSE_WAIT_SETS == 1 )
+		void *pvWaitSetMember;			/*< The wait set member record that references this event group, or NULL if the event group is not a member of a wait set. */
+	#endif
+
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -129,6 +141,13 @@ typedef struct xEventGroupDefinition
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits );
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	/*
+	 * Copies the state of an event group for the object registry.
+	 */
+	static void prvEventGroupGetSnapshot( void *pvEventGroup, ObjectSnapshot_t *pxSnapshot );
+#endif
+
 /*-----------------------------------------------------------*/
 
 EventGroupHandle_t xEventGroupCreate( void )
@@ -140,6 +159,18 @@ EventGroup_t *pxEventBits;
 	{
 		pxEventBits->uxEventBits = 0;
 		vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+		#if( configUSE_WAIT_SETS == 1 )
+		{
+			pxEventBits->pvWaitSetMember = NULL;
+		}
+		#endif
+
+		#if( configUSE_OBJECT_REGISTRY == 1 )
+		{
+			( void ) xObjectRegistryAdd( pxEventBits, registryTYPE_EVENT_GROUP, NULL, prvEventGroupGetSnapshot );
+		}
+		#endif
 		traceEVENT_GROUP_CREATE( pxEventBits );
 	}
 	else
@@ -547,6 +578,27 @@ BaseType_t xMatchFound = pdFALSE;
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		#if( configUSE_WAIT_SETS == 1 )
+		{
+			if( pxEventBits->pvWaitSetMember != NULL )
+			{
+				/* The wait set can also be updated from interrupts, so is
+				only accessed with interrupts masked.  A task unblocked by the
+				wait set is held in the pending ready list until
+				xTaskResumeAll() performs any yield that is required. */
+				taskENTER_CRITICAL();
+				{
+					( void ) xWaitSetSignalMember( pxEventBits->pvWaitSetMember, uxBitsToSet );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_WAIT_SETS */
 	}
 	( void ) xTaskResumeAll();
 
@@ -563,6 +615,25 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
+		#if( configUSE_OBJECT_REGISTRY == 1 )
+		{
+			vObjectRegistryRemove( pxEventBits );
+		}
+		#endif
+
+		#if( configUSE_WAIT_SETS == 1 )
+		{
+			if( pxEventBits->pvWaitSetMember != NULL )
+			{
+				vWaitSetDetachMember( pxEventBits->pvWaitSetMember );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
 		{
 			/* Unblock the task, returning 0 as the event list is being deleted
@@ -585,6 +656,32 @@ void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_WAIT_SETS == 1 )
+
+	/* For internal use only - called by waitset.c with interrupts masked.  A
+	NULL pvWaitSetMember removes the event group from its wait set. */
+	BaseType_t xEventGroupAttachWaitSetMember( EventGroupHandle_t xEventGroup, void *pvWaitSetMember )
+	{
+	EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+	BaseType_t xReturn;
+
+		if( ( pvWaitSetMember != NULL ) && ( pxEventBits->pvWaitSetMember != NULL ) )
+		{
+			/* Cannot add an event group to more than one wait set. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			pxEventBits->pvWaitSetMember = pvWaitSetMember;
+			xReturn = pdPASS;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_WAIT_SETS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -651,4 +748,15 @@ BaseType_t xWaitConditionMet = pdFALSE;
 		return xReturn;
 	}
 #endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	static void prvEventGroupGetSnapshot( void *pvEventGroup, ObjectSnapshot_t *pxSnapshot )
+	{
+	const EventGroup_t * const pxEventBits = ( const EventGroup_t * ) pvEventGroup;
+
+		pxSnapshot->xValue = ( TickType_t ) pxEventBits->uxEventBits;
+		pxSnapshot->uxWaitingToReceive = listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits ) );
+	}
+#endif
 
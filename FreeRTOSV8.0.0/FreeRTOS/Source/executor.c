@@ -0,0 +1,923 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "event_groups.h"
+#include "waitset.h"
+#include "executor.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not
+configured to include executor functionality. */
+#if ( configUSE_EXECUTORS == 1 )
+
+#if ( configUSE_WAIT_SETS == 0 )
+	#error configUSE_WAIT_SETS must be set to 1 in FreeRTOSConfig.h to use executors.
+#endif
+
+/* The maximum number of wait set events processed each time the executor
+task checks for events.  The events are held on the executor task's stack. */
+#define executorEVENT_BATCH_SIZE		( ( UBaseType_t ) 8U )
+
+/* Values of the ucBlockedOn routine control block member. */
+#define executorNOT_BLOCKED				( ( uint8_t ) 0U )	/* Ready, or running. */
+#define executorBLOCKED_NEW				( ( uint8_t ) 1U )	/* Created, but not yet handed to the executor task. */
+#define executorBLOCKED_DELAY			( ( uint8_t ) 2U )
+#define executorBLOCKED_OBJECT			( ( uint8_t ) 3U )
+#define executorBLOCKED_NOTIFICATION	( ( uint8_t ) 4U )
+
+/* The event group bits that a wait set is asked to report.  Routines test
+their own bits when they run, so the executor is woken by any bit being set.
+The top byte of an event group is reserved for use by the kernel. */
+#if configUSE_16_BIT_TICKS == 1
+	#define executorALL_EVENT_BITS		( ( EventBits_t ) 0x00ffU )
+#else
+	#define executorALL_EVENT_BITS		( ( EventBits_t ) 0x00ffffffUL )
+#endif
+
+/* Records the routines that are waiting for one object.  The object is a
+member of the executor's wait set for as long as a routine is waiting for
+it. */
+typedef struct xEXECUTOR_WAIT_OBJECT
+{
+	List_t xWaitingRoutines;			/*< The routines waiting for the object.  Must be the first member - see prvRemoveFromWaitObject(). */
+	void *pvObject;						/*< The queue, semaphore or event group, or NULL if the record is not in use. */
+} WaitObject_t;
+
+typedef struct xEXECUTOR_DEFINITION
+{
+	List_t xReadyRoutines[ configMAX_EXECUTOR_PRIORITIES ];	/*< Prioritised ready routines. */
+	List_t xDelayedRoutines1;			/*< Delayed routines are referenced from two lists, one for routines that wake before the tick count overflows, and one for routines that wake after. */
+	List_t xDelayedRoutines2;
+	List_t *pxDelayedRoutines;			/*< Points to whichever delayed list is currently in use. */
+	List_t *pxOverflowDelayedRoutines;	/*< Points to the delayed list that holds routines that wake after the tick count has overflowed. */
+	List_t xNotifiedRoutines;			/*< Routines that have been created or notified since the executor task last looked.  Accessed with interrupts masked. */
+	TickType_t xLastTime;				/*< The tick count the last time the delayed lists were checked - used to detect the tick count overflowing. */
+	WaitSetHandle_t xWaitSet;			/*< The executor task blocks on this wait set when no routines are ready. */
+	TaskHandle_t xTask;					/*< The executor task itself. */
+	UBaseType_t uxRoutineCount;			/*< The number of routines that have been handed to the executor task and not yet ended. */
+	UBaseType_t uxMaxWaitObjects;
+	WaitObject_t xWaitObjects[ 1 ];		/*< The structure is allocated with space for uxMaxWaitObjects records. */
+} Executor_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that runs an executor's routines.
+ */
+static void prvExecutorTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call the routine function, then place the routine back into a ready list if
+ * it did not block, or delete it if it ran to its end.
+ */
+static void prvRunRoutine( Executor_t * const pxExecutor, RCB_t * const pxRCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make a routine ready to run, removing it from any delayed or wait object
+ * list it is in.
+ */
+static void prvMakeRoutineReady( Executor_t * const pxExecutor, RCB_t * const pxRCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a routine into a delayed list.  A block time of portMAX_DELAY blocks
+ * indefinitely if INCLUDE_vTaskSuspend is set to 1.
+ */
+static void prvAddRoutineToDelayedList( Executor_t * const pxExecutor, RCB_t * const pxRCB, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make ready any delayed routines whose wake time has been reached, then
+ * return the number of ticks until the next delayed routine wakes.
+ */
+static TickType_t prvProcessDelayedRoutines( Executor_t * const pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make ready every routine that is waiting for pxWaitObject, then release
+ * the record.  Called when the wait set reports that the object was posted
+ * to.
+ */
+static void prvWakeWaitObject( Executor_t * const pxExecutor, WaitObject_t * const pxWaitObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a routine from the list of routines waiting for an object, and
+ * release the record if no other routines are waiting for the object.
+ */
+static void prvRemoveFromWaitObject( Executor_t * const pxExecutor, RCB_t * const pxRCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hand newly created routines, and routines that were waiting for a
+ * notification that has now been received, to the ready lists.
+ */
+static void prvProcessNotifiedRoutines( Executor_t * const pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the highest priority ready routine, or NULL if no routines are ready.
+ */
+static RCB_t *prvGetReadyRoutine( const Executor_t * const pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+ExecutorHandle_t xExecutorCreate( const char * const pcName, UBaseType_t uxMaxWaitObjects, UBaseType_t uxPriority, uint16_t usStackDepth ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+Executor_t *pxExecutor;
+UBaseType_t ux;
+
+	configASSERT( uxMaxWaitObjects > ( UBaseType_t ) 0 );
+
+	pxExecutor = ( Executor_t * ) pvPortMalloc( sizeof( Executor_t ) + ( ( uxMaxWaitObjects - ( UBaseType_t ) 1 ) * sizeof( WaitObject_t ) ) );
+
+	if( pxExecutor != NULL )
+	{
+		for( ux = ( UBaseType_t ) 0; ux < ( UBaseType_t ) configMAX_EXECUTOR_PRIORITIES; ux++ )
+		{
+			vListInitialise( &( pxExecutor->xReadyRoutines[ ux ] ) );
+		}
+
+		for( ux = ( UBaseType_t ) 0; ux < uxMaxWaitObjects; ux++ )
+		{
+			vListInitialise( &( pxExecutor->xWaitObjects[ ux ].xWaitingRoutines ) );
+			pxExecutor->xWaitObjects[ ux ].pvObject = NULL;
+		}
+
+		vListInitialise( &( pxExecutor->xDelayedRoutines1 ) );
+		vListInitialise( &( pxExecutor->xDelayedRoutines2 ) );
+		vListInitialise( &( pxExecutor->xNotifiedRoutines ) );
+		pxExecutor->pxDelayedRoutines = &( pxExecutor->xDelayedRoutines1 );
+		pxExecutor->pxOverflowDelayedRoutines = &( pxExecutor->xDelayedRoutines2 );
+		pxExecutor->xLastTime = xTaskGetTickCount();
+		pxExecutor->uxRoutineCount = ( UBaseType_t ) 0;
+		pxExecutor->uxMaxWaitObjects = uxMaxWaitObjects;
+		pxExecutor->xTask = NULL;
+
+		pxExecutor->xWaitSet = xWaitSetCreate( uxMaxWaitObjects );
+
+		if( pxExecutor->xWaitSet != NULL )
+		{
+			if( xTaskCreate( prvExecutorTask, pcName, usStackDepth, ( void * ) pxExecutor, uxPriority, &( pxExecutor->xTask ) ) != pdPASS )
+			{
+				vWaitSetDelete( pxExecutor->xWaitSet );
+				vPortFree( pxExecutor );
+				pxExecutor = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			vPortFree( pxExecutor );
+			pxExecutor = NULL;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxExecutor != NULL )
+	{
+		traceEXECUTOR_CREATE( pxExecutor );
+	}
+	else
+	{
+		traceEXECUTOR_CREATE_FAILED();
+	}
+
+	return ( ExecutorHandle_t ) pxExecutor;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xExecutorCreateRoutine( ExecutorHandle_t xExecutor, RoutineFunction_t pxRoutineFunction, void *pvParameter, UBaseType_t uxPriority, RoutineHandle_t *pxCreatedRoutine )
+{
+Executor_t * const pxExecutor = ( Executor_t * ) xExecutor;
+RCB_t *pxRCB;
+BaseType_t xReturn;
+
+	configASSERT( pxExecutor );
+	configASSERT( pxRoutineFunction );
+	configASSERT( uxPriority < ( UBaseType_t ) configMAX_EXECUTOR_PRIORITIES );
+
+	pxRCB = ( RCB_t * ) pvPortMalloc( sizeof( RCB_t ) );
+
+	if( pxRCB != NULL )
+	{
+		pxRCB->pxRoutineFunction = pxRoutineFunction;
+		pxRCB->pvParameter = pvParameter;
+		pxRCB->pvExecutor = ( void * ) pxExecutor;
+		pxRCB->uxPriority = uxPriority;
+		pxRCB->uxNotified = pdFALSE;
+		pxRCB->uxState = ( uint16_t ) 0;
+		pxRCB->ucBlockedOn = executorBLOCKED_NEW;
+		pxRCB->xTicksToWait = ( TickType_t ) 0;
+
+		vListInitialiseItem( &( pxRCB->xGenericListItem ) );
+		vListInitialiseItem( &( pxRCB->xEventListItem ) );
+		vListInitialiseItem( &( pxRCB->xNotifyListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxRCB->xGenericListItem ), pxRCB );
+		listSET_LIST_ITEM_OWNER( &( pxRCB->xEventListItem ), pxRCB );
+		listSET_LIST_ITEM_OWNER( &( pxRCB->xNotifyListItem ), pxRCB );
+
+		if( pxCreatedRoutine != NULL )
+		{
+			*pxCreatedRoutine = ( RoutineHandle_t ) pxRCB;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Only the executor task accesses the ready lists, so the new
+		routine is passed to the executor task in the same way as a
+		notification. */
+		taskENTER_CRITICAL();
+		{
+			vListInsertEnd( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) );
+		}
+		taskEXIT_CRITICAL();
+
+		( void ) xWaitSetNotify( pxExecutor->xWaitSet, ( EventBits_t ) 1 );
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xExecutorNotifyRoutine( RoutineHandle_t xRoutine )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xRoutine;
+Executor_t *pxExecutor;
+
+	configASSERT( pxRCB );
+	pxExecutor = ( Executor_t * ) pxRCB->pvExecutor;
+
+	taskENTER_CRITICAL();
+	{
+		pxRCB->uxNotified = pdTRUE;
+
+		if( listIS_CONTAINED_WITHIN( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) ) == pdFALSE )
+		{
+			vListInsertEnd( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xWaitSetNotify( pxExecutor->xWaitSet, ( EventBits_t ) 1 );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xExecutorNotifyRoutineFromISR( RoutineHandle_t xRoutine, BaseType_t *pxHigherPriorityTaskWoken )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xRoutine;
+Executor_t *pxExecutor;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRCB );
+	pxExecutor = ( Executor_t * ) pxRCB->pvExecutor;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxRCB->uxNotified = pdTRUE;
+
+		if( listIS_CONTAINED_WITHIN( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) ) == pdFALSE )
+		{
+			vListInsertEnd( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xWaitSetNotifyFromISR( pxExecutor->xWaitSet, ( EventBits_t ) 1, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void vExecutorDelayRoutine( RoutineHandle_t xHandle, TickType_t xTicksToDelay )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xHandle;
+
+	/* A delay of zero just yields, in which case the routine is placed back
+	into its ready list when it returns to the executor. */
+	if( xTicksToDelay > ( TickType_t ) 0U )
+	{
+		pxRCB->ucBlockedOn = executorBLOCKED_DELAY;
+		prvAddRoutineToDelayedList( ( Executor_t * ) pxRCB->pvExecutor, pxRCB, xTicksToDelay );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vExecutorDelayRoutineUntil( RoutineHandle_t xHandle, TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement )
+{
+TickType_t xTimeToWake, xConstTickCount;
+BaseType_t xShouldDelay = pdFALSE;
+
+	configASSERT( pxPreviousWakeTime );
+	configASSERT( ( xTimeIncrement > 0U ) );
+
+	xConstTickCount = xTaskGetTickCount();
+
+	/* Generate the tick time at which the routine wants to wake, using the
+	same overflow logic as vTaskDelayUntil(). */
+	xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+	if( xConstTickCount < *pxPreviousWakeTime )
+	{
+		/* The tick count has overflowed since this function was last called,
+		so only delay if the wake time has also overflowed and is still in
+		the future. */
+		if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+		{
+			xShouldDelay = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+		{
+			xShouldDelay = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	*pxPreviousWakeTime = xTimeToWake;
+
+	if( xShouldDelay != pdFALSE )
+	{
+		vExecutorDelayRoutine( xHandle, xTimeToWake - xConstTickCount );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vExecutorSetTimeOut( RoutineHandle_t xHandle, TickType_t xTicksToWait )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xHandle;
+
+	pxRCB->xTicksToWait = xTicksToWait;
+
+	if( xTicksToWait != ( TickType_t ) 0U )
+	{
+		vTaskSetTimeOutState( &( pxRCB->xTimeOut ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xExecutorBlockRoutine( RoutineHandle_t xHandle, void *pvObject, BaseType_t xIsEventGroup )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xHandle;
+Executor_t * const pxExecutor = ( Executor_t * ) pxRCB->pvExecutor;
+WaitObject_t *pxWaitObject = NULL;
+UBaseType_t ux;
+BaseType_t xReturn = pdFALSE;
+
+	if( pxRCB->xTicksToWait == ( TickType_t ) 0U )
+	{
+		/* Not blocking, or the block time has already expired. */
+	}
+	else if( xTaskCheckForTimeOut( &( pxRCB->xTimeOut ), &( pxRCB->xTicksToWait ) ) != pdFALSE )
+	{
+		pxRCB->xTicksToWait = ( TickType_t ) 0U;
+	}
+	else if( pvObject == NULL )
+	{
+		/* Waiting for a notification, which only needs the delayed list. */
+		pxRCB->ucBlockedOn = executorBLOCKED_NOTIFICATION;
+		prvAddRoutineToDelayedList( pxExecutor, pxRCB, pxRCB->xTicksToWait );
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		/* Look for a record of routines already waiting for the same object,
+		otherwise use a free record. */
+		for( ux = ( UBaseType_t ) 0; ux < pxExecutor->uxMaxWaitObjects; ux++ )
+		{
+			if( pxExecutor->xWaitObjects[ ux ].pvObject == pvObject )
+			{
+				pxWaitObject = &( pxExecutor->xWaitObjects[ ux ] );
+				break;
+			}
+			else if( ( pxWaitObject == NULL ) && ( pxExecutor->xWaitObjects[ ux ].pvObject == NULL ) )
+			{
+				pxWaitObject = &( pxExecutor->xWaitObjects[ ux ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( ( pxWaitObject != NULL ) && ( pxWaitObject->pvObject == NULL ) )
+		{
+			/* This is the first routine to wait for the object, so add the
+			object to the wait set.  The object is added edge triggered as
+			every waiting routine retries its operation when it runs.  An
+			object that became ready after the routine last tried it is
+			reported by the wait set straight away, so the post is not
+			missed. */
+			if( xIsEventGroup != pdFALSE )
+			{
+				xReturn = xWaitSetAddEventGroup( pxExecutor->xWaitSet, ( EventGroupHandle_t ) pvObject, executorALL_EVENT_BITS, waitsetEDGE_TRIGGERED, ( void * ) pxWaitObject );
+			}
+			else
+			{
+				xReturn = xWaitSetAddQueue( pxExecutor->xWaitSet, ( QueueHandle_t ) pvObject, waitsetEDGE_TRIGGERED, ( void * ) pxWaitObject );
+			}
+
+			if( xReturn != pdFALSE )
+			{
+				pxWaitObject->pvObject = pvObject;
+			}
+			else
+			{
+				/* The object is a member of another wait set or a queue
+				set. */
+				pxWaitObject = NULL;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* If the object cannot be waited for the routine behaves as if the
+		block time expired. */
+		if( pxWaitObject != NULL )
+		{
+			pxRCB->ucBlockedOn = executorBLOCKED_OBJECT;
+			vListInsertEnd( &( pxWaitObject->xWaitingRoutines ), &( pxRCB->xEventListItem ) );
+			prvAddRoutineToDelayedList( pxExecutor, pxRCB, pxRCB->xTicksToWait );
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xExecutorTakeNotification( RoutineHandle_t xHandle )
+{
+RCB_t * const pxRCB = ( RCB_t * ) xHandle;
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = ( BaseType_t ) pxRCB->uxNotified;
+		pxRCB->uxNotified = pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvExecutorTask( void *pvParameters )
+{
+Executor_t * const pxExecutor = ( Executor_t * ) pvParameters;
+WaitSetEvent_t xEvents[ executorEVENT_BATCH_SIZE ];
+UBaseType_t uxEventCount, uxEvent, uxRun;
+TickType_t xTicksToWait;
+RCB_t *pxRCB;
+
+	for( ;; )
+	{
+		/* Run the ready routines, highest priority first.  No more than one
+		routine per routine that exists is run before events are checked
+		again, so routines that keep yielding cannot hold off routines that
+		are waiting for events. */
+		for( uxRun = ( UBaseType_t ) 0; uxRun < pxExecutor->uxRoutineCount; uxRun++ )
+		{
+			pxRCB = prvGetReadyRoutine( pxExecutor );
+
+			if( pxRCB != NULL )
+			{
+				prvRunRoutine( pxExecutor, pxRCB );
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		xTicksToWait = prvProcessDelayedRoutines( pxExecutor );
+
+		if( prvGetReadyRoutine( pxExecutor ) != NULL )
+		{
+			/* Only check for events, do not wait for them. */
+			xTicksToWait = ( TickType_t ) 0U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxEventCount = uxWaitSetWait( pxExecutor->xWaitSet, xEvents, executorEVENT_BATCH_SIZE, xTicksToWait );
+
+		for( uxEvent = ( UBaseType_t ) 0; uxEvent < uxEventCount; uxEvent++ )
+		{
+			if( xEvents[ uxEvent ].pvObject == pxExecutor->xWaitSet )
+			{
+				prvProcessNotifiedRoutines( pxExecutor );
+			}
+			else
+			{
+				prvWakeWaitObject( pxExecutor, ( WaitObject_t * ) xEvents[ uxEvent ].pvUserData );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunRoutine( Executor_t * const pxExecutor, RCB_t * const pxRCB )
+{
+	( void ) uxListRemove( &( pxRCB->xGenericListItem ) );
+	pxRCB->ucBlockedOn = executorNOT_BLOCKED;
+
+	traceEXECUTOR_RUN_ROUTINE( pxExecutor, pxRCB );
+	( pxRCB->pxRoutineFunction )( ( RoutineHandle_t ) pxRCB, pxRCB->pvParameter );
+
+	if( pxRCB->uxState == executorSTATE_COMPLETE )
+	{
+		/* The routine ran to its end so is deleted.  It cannot be blocked,
+		but it might have been notified. */
+		taskENTER_CRITICAL();
+		{
+			if( listIS_CONTAINED_WITHIN( &( pxExecutor->xNotifiedRoutines ), &( pxRCB->xNotifyListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxRCB->xNotifyListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		( pxExecutor->uxRoutineCount )--;
+		vPortFree( pxRCB );
+	}
+	else if( pxRCB->ucBlockedOn == executorNOT_BLOCKED )
+	{
+		/* The routine yielded, so goes to the back of its ready list. */
+		vListInsertEnd( &( pxExecutor->xReadyRoutines[ pxRCB->uxPriority ] ), &( pxRCB->xGenericListItem ) );
+	}
+	else
+	{
+		/* The routine placed itself into a delayed or wait object list. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMakeRoutineReady( Executor_t * const pxExecutor, RCB_t * const pxRCB )
+{
+	if( listLIST_ITEM_CONTAINER( &( pxRCB->xGenericListItem ) ) != NULL )
+	{
+		( void ) uxListRemove( &( pxRCB->xGenericListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxRCB->ucBlockedOn == executorBLOCKED_OBJECT )
+	{
+		prvRemoveFromWaitObject( pxExecutor, pxRCB );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxRCB->ucBlockedOn = executorNOT_BLOCKED;
+	vListInsertEnd( &( pxExecutor->xReadyRoutines[ pxRCB->uxPriority ] ), &( pxRCB->xGenericListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRoutineToDelayedList( Executor_t * const pxExecutor, RCB_t * const pxRCB, const TickType_t xTicksToWait )
+{
+TickType_t xTimeNow, xTimeToWake;
+BaseType_t xBlockIndefinitely = pdFALSE;
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		if( xTicksToWait == portMAX_DELAY )
+		{
+			/* The routine is only referenced from the list of the object it
+			is waiting for, if any. */
+			xBlockIndefinitely = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	if( xBlockIndefinitely == pdFALSE )
+	{
+		/* Sample the time, and switch the delayed lists if the tick count has
+		overflowed, before working out which list the routine belongs in. */
+		( void ) prvProcessDelayedRoutines( pxExecutor );
+
+		xTimeNow = pxExecutor->xLastTime;
+		xTimeToWake = xTimeNow + xTicksToWait;
+		listSET_LIST_ITEM_VALUE( &( pxRCB->xGenericListItem ), xTimeToWake );
+
+		if( xTimeToWake < xTimeNow )
+		{
+			/* The wake time has overflowed. */
+			vListInsert( pxExecutor->pxOverflowDelayedRoutines, &( pxRCB->xGenericListItem ) );
+		}
+		else
+		{
+			vListInsert( pxExecutor->pxDelayedRoutines, &( pxRCB->xGenericListItem ) );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvProcessDelayedRoutines( Executor_t * const pxExecutor )
+{
+TickType_t xTimeNow, xTicksToWait;
+RCB_t *pxRCB;
+List_t *pxTemp;
+
+	xTimeNow = xTaskGetTickCount();
+
+	if( xTimeNow < pxExecutor->xLastTime )
+	{
+		/* The tick count has overflowed.  Everything remaining in the current
+		delayed list must have woken. */
+		while( listLIST_IS_EMPTY( pxExecutor->pxDelayedRoutines ) == pdFALSE )
+		{
+			pxRCB = ( RCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedRoutines );
+			prvMakeRoutineReady( pxExecutor, pxRCB );
+		}
+
+		pxTemp = pxExecutor->pxDelayedRoutines;
+		pxExecutor->pxDelayedRoutines = pxExecutor->pxOverflowDelayedRoutines;
+		pxExecutor->pxOverflowDelayedRoutines = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxExecutor->xLastTime = xTimeNow;
+
+	while( listLIST_IS_EMPTY( pxExecutor->pxDelayedRoutines ) == pdFALSE )
+	{
+		if( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedRoutines ) > xTimeNow )
+		{
+			break;
+		}
+		else
+		{
+			pxRCB = ( RCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedRoutines );
+			prvMakeRoutineReady( pxExecutor, pxRCB );
+		}
+	}
+
+	if( listLIST_IS_EMPTY( pxExecutor->pxDelayedRoutines ) == pdFALSE )
+	{
+		xTicksToWait = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedRoutines ) - xTimeNow;
+	}
+	else if( listLIST_IS_EMPTY( pxExecutor->pxOverflowDelayedRoutines ) == pdFALSE )
+	{
+		/* Wake when the tick count overflows, at which point the delayed
+		lists are switched. */
+		xTicksToWait = ( TickType_t ) 0U - xTimeNow;
+	}
+	else
+	{
+		xTicksToWait = portMAX_DELAY;
+	}
+
+	return xTicksToWait;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeWaitObject( Executor_t * const pxExecutor, WaitObject_t * const pxWaitObject )
+{
+RCB_t *pxRCB;
+
+	/* Every waiting routine retries its operation, and any that fail wait
+	again.  Making the last routine ready releases the record. */
+	while( ( pxWaitObject->pvObject != NULL ) && ( listLIST_IS_EMPTY( &( pxWaitObject->xWaitingRoutines ) ) == pdFALSE ) )
+	{
+		pxRCB = ( RCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxWaitObject->xWaitingRoutines ) );
+		prvMakeRoutineReady( pxExecutor, pxRCB );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFromWaitObject( Executor_t * const pxExecutor, RCB_t * const pxRCB )
+{
+WaitObject_t *pxWaitObject;
+
+	/* The waiting list is the first member of the record. */
+	pxWaitObject = ( WaitObject_t * ) listLIST_ITEM_CONTAINER( &( pxRCB->xEventListItem ) );
+	( void ) uxListRemove( &( pxRCB->xEventListItem ) );
+
+	if( listLIST_IS_EMPTY( &( pxWaitObject->xWaitingRoutines ) ) != pdFALSE )
+	{
+		( void ) xWaitSetRemove( pxExecutor->xWaitSet, pxWaitObject->pvObject );
+		pxWaitObject->pvObject = NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessNotifiedRoutines( Executor_t * const pxExecutor )
+{
+RCB_t *pxRCB;
+
+	for( ;; )
+	{
+		/* Only the notified list is accessed from outside the executor
+		task, so interrupts only need to be masked while a routine is taken
+		from it. */
+		taskENTER_CRITICAL();
+		{
+			if( listLIST_IS_EMPTY( &( pxExecutor->xNotifiedRoutines ) ) == pdFALSE )
+			{
+				pxRCB = ( RCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxExecutor->xNotifiedRoutines ) );
+				( void ) uxListRemove( &( pxRCB->xNotifyListItem ) );
+			}
+			else
+			{
+				pxRCB = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxRCB == NULL )
+		{
+			break;
+		}
+		else if( pxRCB->ucBlockedOn == executorBLOCKED_NEW )
+		{
+			( pxExecutor->uxRoutineCount )++;
+			prvMakeRoutineReady( pxExecutor, pxRCB );
+		}
+		else if( pxRCB->ucBlockedOn == executorBLOCKED_NOTIFICATION )
+		{
+			prvMakeRoutineReady( pxExecutor, pxRCB );
+		}
+		else
+		{
+			/* The routine is not waiting for a notification, so uxNotified
+			stays set until it next waits for one. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static RCB_t *prvGetReadyRoutine( const Executor_t * const pxExecutor )
+{
+UBaseType_t uxPriority = ( UBaseType_t ) configMAX_EXECUTOR_PRIORITIES;
+RCB_t *pxRCB = NULL;
+
+	while( uxPriority > ( UBaseType_t ) 0 )
+	{
+		uxPriority--;
+
+		if( listLIST_IS_EMPTY( &( pxExecutor->xReadyRoutines[ uxPriority ] ) ) == pdFALSE )
+		{
+			pxRCB = ( RCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxExecutor->xReadyRoutines[ uxPriority ] ) );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxRCB;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include executor functionality.  If you want to include executors then
+ensure configUSE_EXECUTORS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_EXECUTORS == 1 */
@@ -102,6 +102,14 @@ is included as it is used by the port layer. */
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #endif
 
+/* Set configUSE_READY_PRIORITY_BITMAP to 1 to select the highest priority
+ready task using a generic two level bitmap, which allows more priorities than
+the port optimised method and takes the same time whatever the number of
+priorities. */
+#ifndef configUSE_READY_PRIORITY_BITMAP
+	#define configUSE_READY_PRIORITY_BITMAP 0
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -163,6 +171,18 @@ is included as it is used by the port layer. */
 	#error Missing definition:  configUSE_16_BIT_TICKS must be defined in FreeRTOSConfig.h as either 1 or 0.  See the Configuration section of the FreeRTOS API documentation for details.
 #endif
 
+/* Set configUSE_64_BIT_TICKS to 1 on ports that support it to make TickType_t
+a 64 bit type.  The tick count then never overflows, so the kernel does not
+need to switch between two delayed task lists or track tick count overflows
+when checking for timeouts. */
+#ifndef configUSE_64_BIT_TICKS
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
+#if ( configUSE_16_BIT_TICKS == 1 ) && ( configUSE_64_BIT_TICKS == 1 )
+	#error configUSE_16_BIT_TICKS and configUSE_64_BIT_TICKS cannot both be set to 1.
+#endif
+
 #if configUSE_CO_ROUTINES != 0
 	#ifndef configMAX_CO_ROUTINE_PRIORITIES
 		#error configMAX_CO_ROUTINE_PRIORITIES must be greater than or equal to 1.
@@ -173,6 +193,18 @@ is included as it is used by the port layer. */
 	#error configMAX_PRIORITIES must be defined to be greater than or equal to 1.
 #endif
 
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+	#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		#error configUSE_READY_PRIORITY_BITMAP and configUSE_PORT_OPTIMISED_TASK_SELECTION cannot both be set to 1.
+	#endif
+
+	#if ( configMAX_PRIORITIES > 1024 )
+		#error configUSE_READY_PRIORITY_BITMAP can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
+	#endif
+
+#endif /* configUSE_READY_PRIORITY_BITMAP */
+
 #ifndef INCLUDE_xTaskGetIdleTaskHandle
 	#define INCLUDE_xTaskGetIdleTaskHandle 0
 #endif
@@ -275,8 +307,141 @@ is included as it is used by the port layer. */
 		#error If configUSE_TIMERS is set to 1 then configTIMER_TASK_STACK_DEPTH must also be defined.
 	#endif /* configTIMER_TASK_STACK_DEPTH */
 
+	/* The maximum number of commands the timer service task receives from the
+	timer queue before applying them.  The messages are held in a static array
+	in timers.c, not on the stack of the timer service task.  Setting 1
+	processes the commands one at a time. */
+	#ifndef configTIMER_COMMAND_BATCH_LENGTH
+		#define configTIMER_COMMAND_BATCH_LENGTH 4
+	#endif
+
+	#if configTIMER_COMMAND_BATCH_LENGTH < 1
+		#error configTIMER_COMMAND_BATCH_LENGTH must be set to a minimum of 1 in FreeRTOSConfig.h
+	#endif
+
 #endif /* configUSE_TIMERS */
 
+#ifndef configUSE_TICK_TIMERS
+	#define configUSE_TICK_TIMERS 0
+#endif
+
+#if configUSE_TICK_TIMERS == 1
+
+	/* The number of slots in the tick timer wheel.  Must be a power of 2. */
+	#ifndef configTICK_TIMER_WHEEL_SIZE
+		#define configTICK_TIMER_WHEEL_SIZE 32
+	#endif
+
+	#if ( ( configTICK_TIMER_WHEEL_SIZE & ( configTICK_TIMER_WHEEL_SIZE - 1 ) ) != 0 ) || ( configTICK_TIMER_WHEEL_SIZE < 2 )
+		#error configTICK_TIMER_WHEEL_SIZE must be a power of 2 that is greater than 1.
+	#endif
+
+	/* The maximum number of tick timer callbacks executed by a single tick
+	interrupt, or 0 for no limit.  Callbacks beyond the limit are deferred to
+	the following tick. */
+	#ifndef configTICK_TIMER_MAX_EXPIRIES_PER_TICK
+		#define configTICK_TIMER_MAX_EXPIRIES_PER_TICK 0
+	#endif
+
+#endif /* configUSE_TICK_TIMERS */
+
+/* Set configUSE_TASK_POOL to 1 to keep the TCB and stack of deleted tasks for
+reuse by tasks created later, instead of returning them to the heap. */
+#ifndef configUSE_TASK_POOL
+	#define configUSE_TASK_POOL 0
+#endif
+
+#if configUSE_TASK_POOL == 1
+
+	#if INCLUDE_vTaskDelete != 1
+		#error INCLUDE_vTaskDelete must be set to 1 in FreeRTOSConfig.h when configUSE_TASK_POOL is set to 1.
+	#endif
+
+	/* The number of stack size buckets in the pool.  Bucket n holds stacks of
+	configMINIMAL_STACK_SIZE << n words.  Tasks with larger stacks, or that use
+	a stack buffer supplied by the application, are never pooled. */
+	#ifndef configTASK_POOL_BUCKETS
+		#define configTASK_POOL_BUCKETS 4
+	#endif
+
+	/* The maximum number of TCB and stack pairs held in each bucket. */
+	#ifndef configTASK_POOL_SIZE
+		#define configTASK_POOL_SIZE 4
+	#endif
+
+	/* Set to 1 to have the idle task refill recycled stacks with the stack
+	fill byte, rather than the task that is being created. */
+	#ifndef configTASK_POOL_LAZY_STACK_FILL
+		#define configTASK_POOL_LAZY_STACK_FILL 0
+	#endif
+
+	#if ( configTASK_POOL_BUCKETS < 1 ) || ( configTASK_POOL_SIZE < 1 )
+		#error configTASK_POOL_BUCKETS and configTASK_POOL_SIZE must be set to a minimum of 1 in FreeRTOSConfig.h
+	#endif
+
+#endif /* configUSE_TASK_POOL */
+
+/* Set configUSE_TASK_RECLAIMER to 1 to free the memory of deleted tasks from a
+dedicated task running at configTASK_RECLAIMER_PRIORITY, rather than from the
+idle task, so memory is reclaimed even on a system that never idles. */
+#ifndef configUSE_TASK_RECLAIMER
+	#define configUSE_TASK_RECLAIMER 0
+#endif
+
+#if configUSE_TASK_RECLAIMER == 1
+
+	#if INCLUDE_vTaskDelete != 1
+		#error INCLUDE_vTaskDelete must be set to 1 in FreeRTOSConfig.h when configUSE_TASK_RECLAIMER is set to 1.
+	#endif
+
+	#ifndef configTASK_RECLAIMER_PRIORITY
+		#define configTASK_RECLAIMER_PRIORITY 1
+	#endif
+
+	#ifndef configTASK_RECLAIMER_STACK_DEPTH
+		#define configTASK_RECLAIMER_STACK_DEPTH configMINIMAL_STACK_SIZE
+	#endif
+
+#endif /* configUSE_TASK_RECLAIMER */
+
+/* The maximum number of deleted tasks freed by the idle or reclaimer task
+before it gives other tasks a chance to run. */
+#ifndef configTASK_RECLAIM_BATCH_SIZE
+	#define configTASK_RECLAIM_BATCH_SIZE 4
+#endif
+
+#if configTASK_RECLAIM_BATCH_SIZE < 1
+	#error configTASK_RECLAIM_BATCH_SIZE must be set to a minimum of 1 in FreeRTOSConfig.h
+#endif
+
+/* Set configTASK_RECLAIM_INLINE to 1 to have vTaskDelete() free a task other
+than the calling task straight away, rather than leaving it for the idle or
+reclaimer task.  Tasks that delete themselves are always freed later.  The task
+pool relies on this, so it is on by default when the pool is used. */
+#ifndef configTASK_RECLAIM_INLINE
+	#define configTASK_RECLAIM_INLINE configUSE_TASK_POOL
+#endif
+
+/* Set configSPLIT_TCB to 1 to move the members of a task control block that
+are not needed to select or switch to a task, such as the task name, trace
+numbers and newlib reent structure, into a separately allocated structure, and
+to align each TCB to a cache line, so a context switch touches fewer cache
+lines.  Kernel aware debuggers that expect the task name in the TCB itself will
+not find it when this is set. */
+#ifndef configSPLIT_TCB
+	#define configSPLIT_TCB 0
+#endif
+
+/* The maximum number of stack words uxTaskGetStackHighWaterMark() and
+uxTaskGetSystemState() check again below a task's last known high water mark,
+per task per call.  Each call still catches normal stack growth in time
+proportional to the growth, but a write further down the stack that skips the
+words in between is only seen once the checks reach it.  0 means no limit, so
+the result is always exact. */
+#ifndef configSTACK_HIGH_WATER_MARK_SCAN_WORDS
+	#define configSTACK_HIGH_WATER_MARK_SCAN_WORDS 0
+#endif
+
 #ifndef INCLUDE_xTaskGetSchedulerState
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
@@ -306,11 +471,41 @@ is included as it is used by the port layer. */
 	#define portSETUP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+/* Set configUSE_OBJECT_REGISTRY to 1 to record every task, queue, semaphore,
+mutex, timer and event group in a table that can be searched by handle, and
+from which a snapshot of every object's state can be taken.  See registry.h.
+The object registry replaces the queue registry, so vQueueAddToRegistry()
+names objects in the object registry instead, and configQUEUE_REGISTRY_SIZE is
+not used. */
+#ifndef configUSE_OBJECT_REGISTRY
+	#define configUSE_OBJECT_REGISTRY 0
+#endif
+
+#if configUSE_OBJECT_REGISTRY == 1
+
+	/* The number of entries in the object registry, which must be a power of
+	two.  One entry is always left unused, so one fewer objects than this can
+	be registered - fewer still while entries left by deleted objects are
+	waiting to be reused. */
+	#ifndef configOBJECT_REGISTRY_SIZE
+		#define configOBJECT_REGISTRY_SIZE 64
+	#endif
+
+	#if ( ( configOBJECT_REGISTRY_SIZE < 2 ) || ( ( configOBJECT_REGISTRY_SIZE & ( configOBJECT_REGISTRY_SIZE - 1 ) ) != 0 ) )
+		#error configOBJECT_REGISTRY_SIZE must be a power of two, and at least 2.
+	#endif
+
+	#if INCLUDE_eTaskGetState != 1
+		#error INCLUDE_eTaskGetState must be set to 1 in FreeRTOSConfig.h when configUSE_OBJECT_REGISTRY is set to 1.
+	#endif
+
+#endif /* configUSE_OBJECT_REGISTRY */
+
 #ifndef configQUEUE_REGISTRY_SIZE
 	#define configQUEUE_REGISTRY_SIZE 0U
 #endif
 
-#if ( configQUEUE_REGISTRY_SIZE < 1 )
+#if ( ( configQUEUE_REGISTRY_SIZE < 1 ) && ( configUSE_OBJECT_REGISTRY == 0 ) )
 	#define vQueueAddToRegistry( xQueue, pcName )
 	#define vQueueUnregisterQueue( xQueue )
 #endif
@@ -559,6 +754,18 @@ is included as it is used by the port layer. */
     #define traceFREE( pvAddress, uiSize )
 #endif
 
+#ifndef traceTICK_TIMER_CREATE
+	#define traceTICK_TIMER_CREATE( pxNewTimer )
+#endif
+
+#ifndef traceTICK_TIMER_CREATE_FAILED
+	#define traceTICK_TIMER_CREATE_FAILED()
+#endif
+
+#ifndef traceTICK_TIMER_EXPIRED
+	#define traceTICK_TIMER_EXPIRED( pxTimer )
+#endif
+
 #ifndef traceEVENT_GROUP_CREATE
 	#define traceEVENT_GROUP_CREATE( xEventGroup )
 #endif
@@ -615,6 +822,62 @@ is included as it is used by the port layer. */
 	#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName)
 #endif
 
+#ifndef traceOBJECT_REGISTRY_FULL
+	#define traceOBJECT_REGISTRY_FULL( pvObject )
+#endif
+
+#ifndef traceWAIT_SET_CREATE
+	#define traceWAIT_SET_CREATE( xWaitSet )
+#endif
+
+#ifndef traceWAIT_SET_CREATE_FAILED
+	#define traceWAIT_SET_CREATE_FAILED()
+#endif
+
+#ifndef traceBLOCKING_ON_WAIT_SET
+	#define traceBLOCKING_ON_WAIT_SET( xWaitSet )
+#endif
+
+#ifndef traceEXECUTOR_CREATE
+	#define traceEXECUTOR_CREATE( xExecutor )
+#endif
+
+#ifndef traceEXECUTOR_CREATE_FAILED
+	#define traceEXECUTOR_CREATE_FAILED()
+#endif
+
+#ifndef traceEXECUTOR_RUN_ROUTINE
+	#define traceEXECUTOR_RUN_ROUTINE( xExecutor, xRoutine )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE
+	#define traceWORK_QUEUE_CREATE( xWorkQueue )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE_FAILED
+	#define traceWORK_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceWORK_QUEUE_DELETE
+	#define traceWORK_QUEUE_DELETE( xWorkQueue )
+#endif
+
+#ifndef traceWORK_ITEM_SUBMIT
+	#define traceWORK_ITEM_SUBMIT( xWorkQueue, pxWorkItem, xTicksToDelay, xReturn )
+#endif
+
+#ifndef traceWORK_ITEM_SUBMIT_FROM_ISR
+	#define traceWORK_ITEM_SUBMIT_FROM_ISR( xWorkQueue, pxWorkItem, xReturn )
+#endif
+
+#ifndef traceWORK_ITEM_STOLEN
+	#define traceWORK_ITEM_STOLEN( xWorkQueue, pxWorkItem )
+#endif
+
+#ifndef traceWORK_ITEM_CANCEL
+	#define traceWORK_ITEM_CANCEL( xWorkQueue, pxWorkItem, xReturn )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -661,6 +924,41 @@ is included as it is used by the port layer. */
 	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+#ifndef portIDLE_TASK_ITERATION
+	#define portIDLE_TASK_ITERATION()
+#endif
+
+/* The size of the data cache lines, in bytes, used to align a TCB when
+configSPLIT_TCB is 1.  Must be a power of 2. */
+#ifndef portCACHE_LINE_SIZE
+	#define portCACHE_LINE_SIZE portBYTE_ALIGNMENT
+#endif
+
+#define portCACHE_LINE_MASK ( portCACHE_LINE_SIZE - 1 )
+
+#if ( ( portCACHE_LINE_SIZE & portCACHE_LINE_MASK ) != 0 )
+	#error portCACHE_LINE_SIZE must be a power of 2.
+#endif
+
+/* Ports set portTICK_TYPE_IS_ATOMIC to 1 if a TickType_t variable can be read
+with a single, uninterruptible access, in which case reading the tick count
+does not need a critical section. */
+#ifndef portTICK_TYPE_IS_ATOMIC
+	#define portTICK_TYPE_IS_ATOMIC 0
+#endif
+
+#if( portTICK_TYPE_IS_ATOMIC == 0 )
+	#define portTICK_TYPE_ENTER_CRITICAL()						portENTER_CRITICAL()
+	#define portTICK_TYPE_EXIT_CRITICAL()						portEXIT_CRITICAL()
+	#define portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR()			portSET_INTERRUPT_MASK_FROM_ISR()
+	#define portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( x )	portCLEAR_INTERRUPT_MASK_FROM_ISR( ( x ) )
+#else
+	#define portTICK_TYPE_ENTER_CRITICAL()
+	#define portTICK_TYPE_EXIT_CRITICAL()
+	#define portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR()			0
+	#define portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( x )	( void ) ( x )
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
 	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
 #endif
@@ -685,6 +983,35 @@ is included as it is used by the port layer. */
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_WAIT_SETS
+	#define configUSE_WAIT_SETS 0
+#endif
+
+#ifndef configUSE_EXECUTORS
+	#define configUSE_EXECUTORS 0
+#endif
+
+#if configUSE_EXECUTORS == 1
+
+	/* The number of routine priorities within each executor. */
+	#ifndef configMAX_EXECUTOR_PRIORITIES
+		#define configMAX_EXECUTOR_PRIORITIES 2
+	#endif
+
+	#if configMAX_EXECUTOR_PRIORITIES < 1
+		#error configMAX_EXECUTOR_PRIORITIES must be set to a minimum of 1 in FreeRTOSConfig.h
+	#endif
+
+#endif /* configUSE_EXECUTORS */
+
+/* Set configSUPPORT_STATIC_ALLOCATION to 1 to allow queues, semaphores and
+mutexes to be created in memory provided by the application, and to prevent
+the kernel freeing stacks that were provided by the application when the task
+that uses them is deleted. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
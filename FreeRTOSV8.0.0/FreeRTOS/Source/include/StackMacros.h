@@ -108,7 +108,7 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack <= pxCurrentTCB->pxStack )										\
 		{																								\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskCOLD( pxCurrentTCB )->pcTaskName );	\
 		}																								\
 	}
 
@@ -124,7 +124,7 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack >= pxCurrentTCB->pxEndOfStack )									\
 		{																								\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskCOLD( pxCurrentTCB )->pcTaskName );	\
 		}																								\
 	}
 
@@ -145,7 +145,7 @@
 		/* Has the extremity of the task stack ever been written over? */																\
 		if( memcmp( ( void * ) pxCurrentTCB->pxStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )			\
 		{																																\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );									\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskCOLD( pxCurrentTCB )->pcTaskName );									\
 		}																																\
 	}
 
@@ -169,7 +169,7 @@
 		/* Has the extremity of the task stack ever been written over? */																\
 		if( memcmp( ( void * ) pcEndOfStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )					\
 		{																																\
-			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );									\
+			vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskCOLD( pxCurrentTCB )->pcTaskName );									\
 		}																																\
 	}
 
@@ -666,6 +666,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup );
 
 /* For internal use only. */
 void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet );
+BaseType_t xEventGroupAttachWaitSetMember( EventGroupHandle_t xEventGroup, void *pvWaitSetMember );
 
 #if (configUSE_TRACE_FACILITY == 1)
 	UBaseType_t uxEventGroupGetNumber( void* xEventGroup );
@@ -0,0 +1,532 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include executor.h"
+#endif
+
+#include "list.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An executor is a single task that runs any number of routines.  Routines
+ * are stackless co-routines, written in the same style as the co-routines
+ * defined in croutine.h, that all share the stack of the executor task.  A
+ * routine costs one small control block, so hundreds of light state machines
+ * (protocol handlers for example) can run without each needing its own task
+ * and stack.
+ *
+ * Unlike croutine.h co-routines, routines are scheduled by the executor task
+ * itself rather than by the idle hook, and a routine can block on:
+ *
+ * + A delay, or a periodic wake time (exDELAY(), exDELAY_UNTIL()).
+ * + A semaphore or mutex (exSEMAPHORE_TAKE()).
+ * + Data arriving on a queue (exQUEUE_RECEIVE()).
+ * + Bits in an event group (exEVENT_GROUP_WAIT_BITS()).
+ * + A notification sent by a task, interrupt, software timer callback or
+ *   other routine (exWAIT_NOTIFICATION(), xExecutorNotifyRoutine()).
+ *
+ * Each executor has its own ready lists, one per routine priority, and its
+ * own delayed lists.  When no routine is ready the executor task blocks on a
+ * wait set (see waitset.h) that contains the objects its routines are
+ * waiting for, so an idle executor uses no CPU time.
+ *
+ * The restrictions that apply to croutine.h co-routines also apply to
+ * routines: the ex... macros can only be used from the routine function
+ * itself (not from functions it calls), variables that must keep their value
+ * across a blocking macro must be declared static (or be held in the
+ * structure passed in as the routine parameter), and at most one blocking
+ * macro can appear on any one source line.  Routines must not call API
+ * functions that block the calling task.
+ *
+ * configUSE_EXECUTORS and configUSE_WAIT_SETS must both be set to 1 in
+ * FreeRTOSConfig.h for the executor API to be available.
+ *
+ * \defgroup Executor
+ */
+
+/**
+ * executor.h
+ *
+ * Types by which executors and routines are referenced.
+ *
+ * \defgroup ExecutorHandle_t ExecutorHandle_t
+ * \ingroup Executor
+ */
+typedef void * ExecutorHandle_t;
+typedef void * RoutineHandle_t;
+
+/* Defines the prototype to which routine functions must conform. */
+typedef void (*RoutineFunction_t)( RoutineHandle_t, void * );
+
+/* Used internally by the routine implementation. */
+#define executorSTATE_COMPLETE	( ( uint16_t ) 0xffffU )
+
+/* Routine control block.  The structure has to be included in the header
+due to the macro implementation of the routine functionality, but its members
+must not be accessed directly. */
+typedef struct xROUTINE_CONTROL_BLOCK
+{
+	RoutineFunction_t pxRoutineFunction;
+	void *pvParameter;					/*< Passed into pxRoutineFunction. */
+	ListItem_t xGenericListItem;		/*< Used to place the routine in the executor's ready and delayed lists. */
+	ListItem_t xEventListItem;			/*< Used to place the routine in the list of routines waiting for an object. */
+	ListItem_t xNotifyListItem;			/*< Used to place the routine in the executor's list of notified routines.  This is the only list accessed from outside the executor task. */
+	void *pvExecutor;					/*< The executor that runs the routine. */
+	TimeOut_t xTimeOut;					/*< Used to track the block time of the current blocking macro. */
+	TickType_t xTicksToWait;
+	UBaseType_t uxPriority;				/*< The priority of the routine in relation to other routines of the same executor. */
+	volatile UBaseType_t uxNotified;	/*< Set by xExecutorNotifyRoutine(), cleared by exWAIT_NOTIFICATION(). */
+	uint16_t uxState;					/*< The point at which the routine resumes. */
+	uint8_t ucBlockedOn;				/*< What the routine is waiting for, if anything. */
+} RCB_t;
+
+/**
+ * executor.h
+ *<pre>
+ ExecutorHandle_t xExecutorCreate( const char * const pcName,
+                                   UBaseType_t uxMaxWaitObjects,
+                                   UBaseType_t uxPriority,
+                                   uint16_t usStackDepth );
+ </pre>
+ *
+ * Create an executor and the task that runs its routines.  This function
+ * cannot be called from an interrupt.
+ *
+ * @param pcName The text name given to the executor task.
+ *
+ * @param uxMaxWaitObjects The maximum number of different queues, semaphores
+ * and event groups that the executor's routines can be blocked on at any one
+ * time.  Any number of routines can be blocked on the same object.  A routine
+ * that tries to block on an object when this many others are already in use,
+ * or on an object that is a member of a queue set or another wait set, does
+ * not block - it behaves as if its block time expired.
+ *
+ * @param uxPriority The priority of the executor task.
+ *
+ * @param usStackDepth The stack depth, in words, of the executor task.  The
+ * stack is shared by all the executor's routines so must be large enough for
+ * the deepest routine.
+ *
+ * @return A handle to the executor, or NULL if there was insufficient FreeRTOS
+ * heap available.
+ *
+ * \defgroup xExecutorCreate xExecutorCreate
+ * \ingroup Executor
+ */
+ExecutorHandle_t xExecutorCreate( const char * const pcName, UBaseType_t uxMaxWaitObjects, UBaseType_t uxPriority, uint16_t usStackDepth ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * executor.h
+ *<pre>
+ BaseType_t xExecutorCreateRoutine( ExecutorHandle_t xExecutor,
+                                    RoutineFunction_t pxRoutineFunction,
+                                    void *pvParameter,
+                                    UBaseType_t uxPriority,
+                                    RoutineHandle_t *pxCreatedRoutine );
+ </pre>
+ *
+ * Create a routine and hand it to an executor to run.  This function can be
+ * called by any task, including by a routine of the same executor, but
+ * cannot be called from an interrupt.
+ *
+ * @param xExecutor The executor that will run the routine.
+ *
+ * @param pxRoutineFunction The routine function.  Routine functions require
+ * the special syntax shown in the example below.
+ *
+ * @param pvParameter The value passed into pxRoutineFunction each time it
+ * runs.
+ *
+ * @param uxPriority The priority of the routine in relation to the other
+ * routines of the same executor.  Must be less than
+ * configMAX_EXECUTOR_PRIORITIES.
+ *
+ * @param pxCreatedRoutine Used to pass back a handle by which the routine
+ * can be notified.  Can be NULL.
+ *
+ * @return pdPASS if the routine was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * Example usage:
+   <pre>
+ // A routine that handles one session.  Each session has its own state
+ // structure, passed in as the routine parameter.
+ void vSessionRoutine( RoutineHandle_t xHandle, void *pvParameter )
+ {
+ Session_t *pxSession = ( Session_t * ) pvParameter;
+
+     // Must start every routine with a call to exSTART().
+     exSTART( xHandle );
+
+     for( ;; )
+     {
+         exSEMAPHORE_TAKE( xHandle, pxSession->xRxSemaphore, pxSession->xTimeout, &( pxSession->xResult ) );
+
+         if( pxSession->xResult == pdFALSE )
+         {
+             // Nothing received within the timeout, so poll the peer.
+             prvSendKeepAlive( pxSession );
+         }
+         else
+         {
+             prvProcessRx( pxSession );
+         }
+     }
+
+     // Must end every routine with a call to exEND().
+     exEND( xHandle );
+ }
+
+ void vStartSessions( void )
+ {
+ ExecutorHandle_t xExecutor;
+ UBaseType_t ux;
+
+     xExecutor = xExecutorCreate( "Sessions", SESSION_COUNT, tskIDLE_PRIORITY + 2, configMINIMAL_STACK_SIZE * 2 );
+
+     for( ux = 0; ux < SESSION_COUNT; ux++ )
+     {
+         xExecutorCreateRoutine( xExecutor, vSessionRoutine, &( xSessions[ ux ] ), 0, NULL );
+     }
+ }
+   </pre>
+ * \defgroup xExecutorCreateRoutine xExecutorCreateRoutine
+ * \ingroup Executor
+ */
+BaseType_t xExecutorCreateRoutine( ExecutorHandle_t xExecutor, RoutineFunction_t pxRoutineFunction, void *pvParameter, UBaseType_t uxPriority, RoutineHandle_t *pxCreatedRoutine ) PRIVILEGED_FUNCTION;
+
+/**
+ * executor.h
+ *<pre>
+ BaseType_t xExecutorNotifyRoutine( RoutineHandle_t xRoutine );
+ </pre>
+ *
+ * Notify a routine.  If the routine is blocked in exWAIT_NOTIFICATION() it is
+ * made ready to run, otherwise its next call to exWAIT_NOTIFICATION() returns
+ * immediately.  Notifications do not count - notifying a routine that is
+ * already notified has no effect.
+ *
+ * This function can be called from tasks, routines and software timer
+ * callback functions, which makes it the way to wake a routine from a
+ * software timer.  It cannot be called from an interrupt.  See
+ * xExecutorNotifyRoutineFromISR().
+ *
+ * @param xRoutine The routine being notified.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xExecutorNotifyRoutine xExecutorNotifyRoutine
+ * \ingroup Executor
+ */
+BaseType_t xExecutorNotifyRoutine( RoutineHandle_t xRoutine ) PRIVILEGED_FUNCTION;
+
+/**
+ * executor.h
+ *<pre>
+ BaseType_t xExecutorNotifyRoutineFromISR( RoutineHandle_t xRoutine,
+                                           BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xExecutorNotifyRoutine() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xRoutine The routine being notified.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if the notification unblocked an executor task that has a priority
+ * above that of the currently running task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xExecutorNotifyRoutineFromISR xExecutorNotifyRoutineFromISR
+ * \ingroup Executor
+ */
+BaseType_t xExecutorNotifyRoutineFromISR( RoutineHandle_t xRoutine, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * executor.h
+ * <pre>
+ exSTART( RoutineHandle_t xHandle );</pre>
+ *
+ * This macro MUST always be called at the start of a routine function.
+ *
+ * \defgroup exSTART exSTART
+ * \ingroup Executor
+ */
+#define exSTART( xHandle ) switch( ( ( RCB_t * )( xHandle ) )->uxState ) { case 0:
+
+/**
+ * executor.h
+ * <pre>
+ exEND( RoutineHandle_t xHandle );</pre>
+ *
+ * This macro MUST always be called at the end of a routine function.  A
+ * routine that runs to its end is deleted.
+ *
+ * \defgroup exEND exEND
+ * \ingroup Executor
+ */
+#define exEND( xHandle ) } ( ( RCB_t * )( xHandle ) )->uxState = executorSTATE_COMPLETE
+
+/*
+ * These macros are intended for internal use by the routine implementation
+ * only.  The macros should not be used directly by application writers.
+ */
+#define exSET_STATE( xHandle ) ( ( RCB_t * )( xHandle ) )->uxState = ( uint16_t ) __LINE__; return; case __LINE__:
+
+/**
+ * executor.h
+ * <pre>
+ exYIELD( RoutineHandle_t xHandle );</pre>
+ *
+ * Let the other ready routines of the same priority run before the calling
+ * routine continues.
+ *
+ * \defgroup exYIELD exYIELD
+ * \ingroup Executor
+ */
+#define exYIELD( xHandle ) exSET_STATE( ( xHandle ) )
+
+/**
+ * executor.h
+ * <pre>
+ exDELAY( RoutineHandle_t xHandle, TickType_t xTicksToDelay );</pre>
+ *
+ * Delay the calling routine for a fixed number of ticks, in the same way as
+ * vTaskDelay().  A delay of 0 is equivalent to exYIELD().
+ *
+ * \defgroup exDELAY exDELAY
+ * \ingroup Executor
+ */
+#define exDELAY( xHandle, xTicksToDelay )											\
+	vExecutorDelayRoutine( ( xHandle ), ( xTicksToDelay ) );						\
+	exSET_STATE( ( xHandle ) )
+
+/**
+ * executor.h
+ * <pre>
+ exDELAY_UNTIL( RoutineHandle_t xHandle,
+                TickType_t *pxPreviousWakeTime,
+                TickType_t xTimeIncrement );</pre>
+ *
+ * Delay the calling routine until a specified time, in the same way as
+ * vTaskDelayUntil().  This is the way to write a periodic routine.
+ *
+ * \defgroup exDELAY_UNTIL exDELAY_UNTIL
+ * \ingroup Executor
+ */
+#define exDELAY_UNTIL( xHandle, pxPreviousWakeTime, xTimeIncrement )				\
+	vExecutorDelayRoutineUntil( ( xHandle ), ( pxPreviousWakeTime ), ( xTimeIncrement ) );	\
+	exSET_STATE( ( xHandle ) )
+
+/**
+ * executor.h
+ * <pre>
+ exSEMAPHORE_TAKE( RoutineHandle_t xHandle,
+                   SemaphoreHandle_t xSemaphore,
+                   TickType_t xTicksToWait,
+                   BaseType_t *pxResult );</pre>
+ *
+ * Take a semaphore or mutex, blocking the calling routine (but not the
+ * executor task) for up to xTicksToWait ticks if it is not available.
+ * *pxResult is set to pdTRUE if the semaphore was taken, or pdFALSE if the
+ * block time expired.  Mutexes taken by routines are held by the executor
+ * task.
+ *
+ * \defgroup exSEMAPHORE_TAKE exSEMAPHORE_TAKE
+ * \ingroup Executor
+ */
+#define exSEMAPHORE_TAKE( xHandle, xSemaphore, xTicksToWait, pxResult )			\
+	vExecutorSetTimeOut( ( xHandle ), ( xTicksToWait ) );							\
+	for( ;; )																		\
+	{																				\
+		*( pxResult ) = xSemaphoreTake( ( xSemaphore ), 0 );						\
+		if( ( *( pxResult ) != pdFALSE ) || ( xExecutorBlockRoutine( ( xHandle ), ( void * ) ( xSemaphore ), pdFALSE ) == pdFALSE ) )	\
+		{																			\
+			break;																	\
+		}																			\
+		exSET_STATE( ( xHandle ) );												\
+	}
+
+/**
+ * executor.h
+ * <pre>
+ exQUEUE_RECEIVE( RoutineHandle_t xHandle,
+                  QueueHandle_t xQueue,
+                  void *pvBuffer,
+                  TickType_t xTicksToWait,
+                  BaseType_t *pxResult );</pre>
+ *
+ * Receive an item from a queue, blocking the calling routine for up to
+ * xTicksToWait ticks if the queue is empty.  *pxResult is set to pdTRUE if an
+ * item was received into pvBuffer, or pdFALSE if the block time expired.
+ *
+ * Routines can only block waiting to receive.  To send to a queue from a
+ * routine use xQueueSend() with a block time of 0.
+ *
+ * \defgroup exQUEUE_RECEIVE exQUEUE_RECEIVE
+ * \ingroup Executor
+ */
+#define exQUEUE_RECEIVE( xHandle, xQueue, pvBuffer, xTicksToWait, pxResult )		\
+	vExecutorSetTimeOut( ( xHandle ), ( xTicksToWait ) );							\
+	for( ;; )																		\
+	{																				\
+		*( pxResult ) = xQueueReceive( ( xQueue ), ( pvBuffer ), 0 );				\
+		if( ( *( pxResult ) != pdFALSE ) || ( xExecutorBlockRoutine( ( xHandle ), ( void * ) ( xQueue ), pdFALSE ) == pdFALSE ) )	\
+		{																			\
+			break;																	\
+		}																			\
+		exSET_STATE( ( xHandle ) );												\
+	}
+
+/**
+ * executor.h
+ * <pre>
+ exEVENT_GROUP_WAIT_BITS( RoutineHandle_t xHandle,
+                          EventGroupHandle_t xEventGroup,
+                          EventBits_t uxBitsToWaitFor,
+                          BaseType_t xClearOnExit,
+                          BaseType_t xWaitForAllBits,
+                          TickType_t xTicksToWait,
+                          EventBits_t *puxBits );</pre>
+ *
+ * Wait for bits in an event group, blocking the calling routine for up to
+ * xTicksToWait ticks.  The parameters have the same meaning as the parameters
+ * of xEventGroupWaitBits(), and *puxBits is set to the value
+ * xEventGroupWaitBits() would have returned.
+ *
+ * \defgroup exEVENT_GROUP_WAIT_BITS exEVENT_GROUP_WAIT_BITS
+ * \ingroup Executor
+ */
+#define exEVENT_GROUP_WAIT_BITS( xHandle, xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait, puxBits )	\
+	vExecutorSetTimeOut( ( xHandle ), ( xTicksToWait ) );							\
+	for( ;; )																		\
+	{																				\
+		*( puxBits ) = xEventGroupWaitBits( ( xEventGroup ), ( uxBitsToWaitFor ), ( xClearOnExit ), ( xWaitForAllBits ), 0 );	\
+		if( ( executorBITS_MATCH( *( puxBits ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) ) != pdFALSE ) || ( xExecutorBlockRoutine( ( xHandle ), ( void * ) ( xEventGroup ), pdTRUE ) == pdFALSE ) )	\
+		{																			\
+			break;																	\
+		}																			\
+		exSET_STATE( ( xHandle ) );												\
+	}
+
+/**
+ * executor.h
+ * <pre>
+ exWAIT_NOTIFICATION( RoutineHandle_t xHandle,
+                      TickType_t xTicksToWait,
+                      BaseType_t *pxResult );</pre>
+ *
+ * Wait for the calling routine to be notified by xExecutorNotifyRoutine() or
+ * xExecutorNotifyRoutineFromISR().  *pxResult is set to pdTRUE if a
+ * notification was received, or pdFALSE if the block time expired.
+ *
+ * \defgroup exWAIT_NOTIFICATION exWAIT_NOTIFICATION
+ * \ingroup Executor
+ */
+#define exWAIT_NOTIFICATION( xHandle, xTicksToWait, pxResult )						\
+	vExecutorSetTimeOut( ( xHandle ), ( xTicksToWait ) );							\
+	for( ;; )																		\
+	{																				\
+		*( pxResult ) = xExecutorTakeNotification( ( xHandle ) );					\
+		if( ( *( pxResult ) != pdFALSE ) || ( xExecutorBlockRoutine( ( xHandle ), NULL, pdFALSE ) == pdFALSE ) )	\
+		{																			\
+			break;																	\
+		}																			\
+		exSET_STATE( ( xHandle ) );												\
+	}
+
+/* Used internally by exEVENT_GROUP_WAIT_BITS(). */
+#define executorBITS_MATCH( uxBits, uxBitsToWaitFor, xWaitForAllBits )			\
+	( ( ( xWaitForAllBits ) != pdFALSE ) ? ( ( ( ( uxBits ) & ( uxBitsToWaitFor ) ) == ( uxBitsToWaitFor ) ) ? pdTRUE : pdFALSE ) : ( ( ( ( uxBits ) & ( uxBitsToWaitFor ) ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE ) )
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the routine macros only.
+ */
+void vExecutorDelayRoutine( RoutineHandle_t xHandle, TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+void vExecutorDelayRoutineUntil( RoutineHandle_t xHandle, TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
+void vExecutorSetTimeOut( RoutineHandle_t xHandle, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xExecutorBlockRoutine( RoutineHandle_t xHandle, void *pvObject, BaseType_t xIsEventGroup ) PRIVILEGED_FUNCTION;
+BaseType_t xExecutorTakeNotification( RoutineHandle_t xHandle ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXECUTOR_H */
+
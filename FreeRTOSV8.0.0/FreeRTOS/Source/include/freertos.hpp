@@ -0,0 +1,415 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef FREERTOS_HPP
+#define FREERTOS_HPP
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include freertos.hpp"
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/*
+ * Header only C++ classes that wrap the task, queue and mutex APIs.  The
+ * classes hold the memory used by the kernel objects they create, so the
+ * amount of RAM each object needs is fixed when the program is compiled, and
+ * an object defined at file scope uses no heap other than the TCB of a task.
+ * Every member function is an inline call to the C API, so using the classes
+ * costs no more code or time than calling the C API directly.
+ *
+ * Requires a C++11 compiler, and configSUPPORT_STATIC_ALLOCATION to be set to
+ * 1 in FreeRTOSConfig.h.
+ */
+
+#if !defined( __cplusplus ) || ( __cplusplus < 201103L )
+	#error freertos.hpp requires a C++11 compiler.
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use freertos.hpp.
+#endif
+
+#include <type_traits>
+
+namespace freertos
+{
+
+/*
+ * The configuration the kernel was built with, as constants that can be used
+ * in static_assert() and template arguments.
+ */
+namespace config
+{
+	constexpr UBaseType_t uxMaxPriorities = ( UBaseType_t ) configMAX_PRIORITIES;
+	constexpr uint16_t usMinimalStackWords = ( uint16_t ) configMINIMAL_STACK_SIZE;
+	constexpr TickType_t xTickRateHz = ( TickType_t ) configTICK_RATE_HZ;
+	constexpr TickType_t xMaxDelay = portMAX_DELAY;
+}
+
+/*
+ * Convert a time in milliseconds to a number of ticks, rounding down.
+ */
+constexpr TickType_t xMsToTicks( const TickType_t xTimeInMs )
+{
+	return xTimeInMs / portTICK_PERIOD_MS;
+}
+
+/*
+ * A task that runs on a stack of usStackWords words held within the object.
+ * The task is created by the constructor and deleted by the destructor, which
+ * does not free the stack as it belongs to the object.
+ *
+ * A task that ends itself must do so using deleteSelf(), not by calling
+ * vTaskDelete( NULL ), so the destructor knows the task has already gone.
+ * Alternatively release() gives up ownership of the task, after which the
+ * destructor does not delete it.  Either way the object must outlive the task
+ * as the task runs on the stack held within the object.
+ *
+ * Example usage:
+   <pre>
+ static void vTaskCode( void *pvParameters );
+
+ static freertos::Task< 256 > xTask( vTaskCode, "Task", tskIDLE_PRIORITY + 1 );
+   </pre>
+ */
+template< uint16_t usStackWords >
+class Task
+{
+	static_assert( usStackWords >= config::usMinimalStackWords, "The stack of a task must be at least configMINIMAL_STACK_SIZE words." );
+
+public:
+	Task( TaskFunction_t pxTaskCode, const char * const pcName, const UBaseType_t uxPriority, void * const pvParameters = NULL ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+		: xHandle( NULL )
+	{
+		configASSERT( ( uxPriority & ~portPRIVILEGE_BIT ) < config::uxMaxPriorities );
+		( void ) xTaskGenericCreate( pxTaskCode, pcName, usStackWords, pvParameters, uxPriority, &xHandle, uxStack, NULL );
+	}
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+		~Task()
+		{
+			/* The critical section stops the task ending itself using
+			deleteSelf() between the handle being checked and the task being
+			deleted. */
+			taskENTER_CRITICAL();
+			{
+				if( xHandle != NULL )
+				{
+					vTaskDelete( xHandle );
+					xHandle = NULL;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		/* Called by the task itself to end itself.  Does not return. */
+		void deleteSelf( void )
+		{
+			taskENTER_CRITICAL();
+			{
+				xHandle = NULL;
+
+				/* The task is removed from the ready list straight away, so
+				never runs again once the critical section is exited - it is ok
+				to yield from within a critical section. */
+				vTaskDelete( NULL );
+			}
+			taskEXIT_CRITICAL();
+		}
+	#endif
+
+	/* Gives up ownership of the task without deleting it, and returns its
+	handle.  Used when the task is to be deleted by other means, for example
+	by itself calling vTaskDelete( NULL ). */
+	TaskHandle_t release( void )
+	{
+	TaskHandle_t xTask;
+
+		taskENTER_CRITICAL();
+		{
+			xTask = xHandle;
+			xHandle = NULL;
+		}
+		taskEXIT_CRITICAL();
+
+		return xTask;
+	}
+
+	Task( const Task & ) = delete;
+	Task &operator=( const Task & ) = delete;
+
+	/* Returns false if the task could not be created because there was not
+	enough heap left to allocate its TCB. */
+	bool created( void ) const { return xHandle != NULL; }
+	TaskHandle_t handle( void ) const { return xHandle; }
+
+	static constexpr uint16_t usStackDepth = usStackWords;
+
+private:
+	StackType_t uxStack[ usStackWords ];
+	TaskHandle_t xHandle;
+};
+
+/*
+ * A queue of up to uxLength items of type ItemType, held within the object.
+ * Items are copied into and out of the queue with memcpy(), so the item type
+ * must be trivially copyable.
+ *
+ * Example usage:
+   <pre>
+ struct Message
+ {
+	uint8_t ucID;
+	uint8_t ucData[ 7 ];
+ };
+
+ static freertos::Queue< Message, 10 > xQueue;
+
+ void vATask( void *pvParameters )
+ {
+ Message xMessage;
+
+	if( xQueue.receive( xMessage, freertos::xMsToTicks( 100 ) ) )
+	{
+		// xMessage holds the item that was at the front of the queue.
+	}
+ }
+   </pre>
+ */
+template< typename ItemType, UBaseType_t uxLength >
+class Queue
+{
+	static_assert( uxLength > 0U, "A queue must be able to hold at least one item." );
+	static_assert( std::is_trivially_copyable< ItemType >::value, "Queue items are copied with memcpy(), so must be trivially copyable." );
+
+public:
+	Queue( void )
+		: xHandle( xQueueCreateStatic( uxLength, sizeof( ItemType ), ucStorage, &xQueueBuffer ) )
+	{
+	}
+
+	~Queue( void )
+	{
+		vQueueDelete( xHandle );
+	}
+
+	Queue( const Queue & ) = delete;
+	Queue &operator=( const Queue & ) = delete;
+
+	bool send( const ItemType &xItem, const TickType_t xTicksToWait = portMAX_DELAY )
+	{
+		return xQueueGenericSend( xHandle, &xItem, xTicksToWait, queueSEND_TO_BACK ) == pdPASS;
+	}
+
+	bool sendToFront( const ItemType &xItem, const TickType_t xTicksToWait = portMAX_DELAY )
+	{
+		return xQueueGenericSend( xHandle, &xItem, xTicksToWait, queueSEND_TO_FRONT ) == pdPASS;
+	}
+
+	bool receive( ItemType &xItem, const TickType_t xTicksToWait = portMAX_DELAY )
+	{
+		return xQueueGenericReceive( xHandle, &xItem, xTicksToWait, pdFALSE ) == pdPASS;
+	}
+
+	bool peek( ItemType &xItem, const TickType_t xTicksToWait = portMAX_DELAY )
+	{
+		return xQueueGenericReceive( xHandle, &xItem, xTicksToWait, pdTRUE ) == pdPASS;
+	}
+
+	bool sendFromISR( const ItemType &xItem, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+		return xQueueGenericSendFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken, queueSEND_TO_BACK ) == pdPASS;
+	}
+
+	bool receiveFromISR( ItemType &xItem, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+		return xQueueReceiveFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken ) == pdPASS;
+	}
+
+	UBaseType_t messagesWaiting( void ) const { return uxQueueMessagesWaiting( xHandle ); }
+	UBaseType_t spacesAvailable( void ) const { return uxQueueSpacesAvailable( xHandle ); }
+	void reset( void ) { ( void ) xQueueReset( xHandle ); }
+	QueueHandle_t handle( void ) const { return xHandle; }
+
+	static constexpr UBaseType_t uxQueueLength = uxLength;
+
+private:
+	StaticQueue_t xQueueBuffer;
+	uint8_t ucStorage[ uxLength * sizeof( ItemType ) ];
+	QueueHandle_t xHandle;
+};
+
+#if ( configUSE_MUTEXES == 1 )
+
+	/*
+	 * A mutex held within the object.  Use LockGuard to take a mutex for the
+	 * duration of a scope.
+	 */
+	class Mutex
+	{
+	public:
+		Mutex( void )
+			: xHandle( xSemaphoreCreateMutexStatic( &xMutexBuffer ) )
+		{
+		}
+
+		~Mutex( void )
+		{
+			vQueueDelete( xHandle );
+		}
+
+		Mutex( const Mutex & ) = delete;
+		Mutex &operator=( const Mutex & ) = delete;
+
+		bool lock( const TickType_t xTicksToWait = portMAX_DELAY ) { return xSemaphoreTake( xHandle, xTicksToWait ) == pdTRUE; }
+		void unlock( void ) { ( void ) xSemaphoreGive( xHandle ); }
+		SemaphoreHandle_t handle( void ) const { return xHandle; }
+
+	private:
+		StaticQueue_t xMutexBuffer;
+		SemaphoreHandle_t xHandle;
+	};
+
+#endif /* configUSE_MUTEXES */
+
+/*
+ * Takes a lock when constructed and gives it back when destroyed.  LockType
+ * can be any class with lock( TickType_t ) and unlock() members, such as
+ * Mutex.  If a block time is given the lock might not be taken, so locked()
+ * must be checked before the protected resource is accessed.
+ *
+ * Example usage:
+   <pre>
+ static freertos::Mutex xMutex;
+
+ void vUpdateSharedResource( void )
+ {
+	freertos::LockGuard< freertos::Mutex > xGuard( xMutex );
+
+	// Access the resource.  The mutex is given back when xGuard goes out of
+	// scope.
+ }
+   </pre>
+ */
+template< typename LockType >
+class LockGuard
+{
+public:
+	explicit LockGuard( LockType &xLockToTake, const TickType_t xTicksToWait = portMAX_DELAY )
+		: xLock( xLockToTake ), xLocked( xLockToTake.lock( xTicksToWait ) )
+	{
+	}
+
+	~LockGuard( void )
+	{
+		if( xLocked )
+		{
+			xLock.unlock();
+		}
+	}
+
+	LockGuard( const LockGuard & ) = delete;
+	LockGuard &operator=( const LockGuard & ) = delete;
+
+	bool locked( void ) const { return xLocked; }
+
+private:
+	LockType &xLock;
+	const bool xLocked;
+};
+
+/*
+ * Enters a critical section when constructed and exits it when destroyed.
+ */
+class CriticalSection
+{
+public:
+	CriticalSection( void ) { taskENTER_CRITICAL(); }
+	~CriticalSection( void ) { taskEXIT_CRITICAL(); }
+
+	CriticalSection( const CriticalSection & ) = delete;
+	CriticalSection &operator=( const CriticalSection & ) = delete;
+};
+
+/*
+ * Suspends the scheduler when constructed and resumes it when destroyed.
+ */
+class SchedulerLock
+{
+public:
+	SchedulerLock( void ) { vTaskSuspendAll(); }
+	~SchedulerLock( void ) { ( void ) xTaskResumeAll(); }
+
+	SchedulerLock( const SchedulerLock & ) = delete;
+	SchedulerLock &operator=( const SchedulerLock & ) = delete;
+};
+
+} /* namespace freertos */
+
+#endif /* FREERTOS_HPP */
+
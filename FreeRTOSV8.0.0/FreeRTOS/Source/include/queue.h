@@ -71,6 +71,11 @@
 	#error "include FreeRTOS.h" must appear in source files before "include queue.h"
 #endif
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* StaticQueue_t contains lists. */
+	#include "list.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -110,6 +115,40 @@ typedef void * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( uint8_t ) 4U )
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/*
+	 * Memory in which a queue, semaphore or mutex can be created by
+	 * xQueueCreateStatic(), xSemaphoreCreateBinaryStatic() or
+	 * xSemaphoreCreateMutexStatic().  The structure has the same size and
+	 * alignment as the queue structure defined in queue.c, but its members
+	 * are not to be accessed by the application.
+	 */
+	typedef struct xSTATIC_QUEUE
+	{
+		void *pvDummy1[ 4 ];
+		List_t xDummy2[ 2 ];
+		UBaseType_t uxDummy3[ 3 ];
+		BaseType_t xDummy4[ 2 ];
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			UBaseType_t uxDummy5;
+			uint8_t ucDummy6;
+		#endif
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+			void *pvDummy7;
+		#endif
+
+		#if ( configUSE_WAIT_SETS == 1 )
+			void *pvDummy8;
+		#endif
+
+		uint8_t ucDummy9;
+	} StaticQueue_t;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * queue. h
  * <pre>
@@ -168,6 +207,58 @@ typedef void * QueueSetMemberHandle_t;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateStatic(
+							  UBaseType_t uxQueueLength,
+							  UBaseType_t uxItemSize,
+							  uint8_t *pucQueueStorage,
+							  StaticQueue_t *pxStaticQueue
+						  );
+ * </pre>
+ *
+ * Creates a new queue instance in memory provided by the caller, so no memory
+ * is allocated.  Only available when configSUPPORT_STATIC_ALLOCATION is set to
+ * 1 in FreeRTOSConfig.h.  vQueueDelete() can be used to delete the queue, but
+ * does not free either block of memory.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorage An array of at least ( uxQueueLength * uxItemSize )
+ * bytes in which the queued items are held.  Can be NULL if uxItemSize is 0.
+ *
+ * @param pxStaticQueue The variable in which the queue structure is held.
+ *
+ * @return A handle to the queue, which is pxStaticQueue cast to a
+ * QueueHandle_t.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+
+ static StaticQueue_t xQueueBuffer;
+ static uint8_t ucQueueStorage[ QUEUE_LENGTH * sizeof( uint32_t ) ];
+
+ void vATask( void *pvParameters )
+ {
+ QueueHandle_t xQueue;
+
+	// Create a queue capable of containing 10 uint32_t values.
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, sizeof( uint32_t ), ucQueueStorage, &xQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxStaticQueue ), queueQUEUE_TYPE_BASE )
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -1476,6 +1567,10 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 void* xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
@@ -1513,7 +1608,7 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t pxMutex ) PRIVILEGED_FUNCTION
  * stores a pointer to the string - so the string must be persistent (global or
  * preferably in ROM/Flash), not on the stack.
  */
-#if configQUEUE_REGISTRY_SIZE > 0
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_OBJECT_REGISTRY == 1 ) )
 	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
@@ -1527,7 +1622,7 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t pxMutex ) PRIVILEGED_FUNCTION
  *
  * @param xQueue The handle of the queue being removed from the registry.
  */
-#if configQUEUE_REGISTRY_SIZE > 0
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_OBJECT_REGISTRY == 1 ) )
 	void vQueueUnregisterQueue( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #endif
 
@@ -1537,6 +1632,15 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t pxMutex ) PRIVILEGED_FUNCTION
  */
 QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 
+/*
+ * Generic version of the function that creates a queue in memory provided by
+ * the caller, which is in turn called by xQueueCreateStatic() and
+ * xSemaphoreCreateBinaryStatic().
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue, const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Queue sets provide a mechanism to allow a task to block (pend) on a read
  * operation from multiple queues or semaphores simultaneously.
@@ -1677,6 +1781,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue ) PRIV
 void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueAttachWaitSetMember( QueueHandle_t xQueue, void *pvWaitSetMember ) PRIVILEGED_FUNCTION;
 
 
 #ifdef __cplusplus
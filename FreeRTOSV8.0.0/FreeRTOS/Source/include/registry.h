@@ -0,0 +1,245 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include registry.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The object registry records every task, queue, semaphore, mutex, software
+ * timer and event group that exists, so a monitoring task can look up any
+ * handle, or take a snapshot of every object, without knowing in advance which
+ * objects the application created.  Objects are added to the registry by the
+ * kernel when they are created and removed when they are deleted.
+ *
+ * The registry is a hash table of configOBJECT_REGISTRY_SIZE entries indexed
+ * by the object's handle, so adding, removing and looking up an object takes
+ * constant time on average.  An object that is created while the registry is
+ * full is not registered, but otherwise works normally.
+ *
+ * Set configUSE_OBJECT_REGISTRY to 1 in FreeRTOSConfig.h to include the
+ * registry.  INCLUDE_eTaskGetState must also be set to 1.
+ */
+
+/* The types of object held in the registry.  The queue types are the
+queueQUEUE_TYPE_ values from queue.h offset by registryTYPE_QUEUE. */
+#define registryTYPE_NONE					( ( uint8_t ) 0U )
+#define registryTYPE_QUEUE					( ( uint8_t ) 1U )
+#define registryTYPE_MUTEX					( ( uint8_t ) 2U )
+#define registryTYPE_COUNTING_SEMAPHORE		( ( uint8_t ) 3U )
+#define registryTYPE_BINARY_SEMAPHORE		( ( uint8_t ) 4U )
+#define registryTYPE_RECURSIVE_MUTEX		( ( uint8_t ) 5U )
+#define registryTYPE_TASK					( ( uint8_t ) 6U )
+#define registryTYPE_TIMER					( ( uint8_t ) 7U )
+#define registryTYPE_EVENT_GROUP			( ( uint8_t ) 8U )
+
+/* For internal use only. */
+#define registryTYPE_FROM_QUEUE_TYPE( ucQueueType ) ( ( uint8_t ) ( registryTYPE_QUEUE + ( ucQueueType ) ) )
+
+/**
+ * The state of one object at the time it was copied by
+ * uxObjectRegistrySnapshot() or xObjectRegistryGetSnapshot().  The meaning of
+ * the members that are not common to all object types depends on ucType.
+ */
+typedef struct xOBJECT_SNAPSHOT
+{
+	void *pvObject;					/*< The handle of the object. */
+	const char *pcName;				/*< The name of the object, or NULL if it does not have one.  Queues, semaphores and mutexes are named by vQueueAddToRegistry(). */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void *pvOwner;					/*< Mutexes: the handle of the task holding the mutex, or NULL if the mutex is available.  Otherwise NULL. */
+	TickType_t xValue;				/*< Tasks: the base priority.  Timers: the period.  Event groups: the event bits.  Recursive mutexes: the number of times the holder has taken the mutex.  Otherwise 0. */
+	UBaseType_t uxLevel;			/*< Queues: the number of items in the queue.  Semaphores and mutexes: the count, which is 1 if a mutex is available.  Tasks: the priority.  Timers: pdTRUE if the timer is active.  Otherwise 0. */
+	UBaseType_t uxCapacity;			/*< Queues: the length.  Semaphores and mutexes: the maximum count.  Tasks: the least number of stack words that have remained unused, as found by the last stack high water mark check, or 0 if stack high water marks are not tracked.  Timers: pdTRUE if the timer auto-reloads.  Otherwise 0. */
+	UBaseType_t uxWaitingToSend;	/*< Queues: the number of tasks blocked waiting to send.  Otherwise 0. */
+	UBaseType_t uxWaitingToReceive;	/*< Queues, semaphores and mutexes: the number of tasks blocked waiting to receive or take.  Event groups: the number of tasks blocked waiting for bits.  Otherwise 0. */
+	uint8_t ucType;					/*< One of the registryTYPE_ values. */
+	uint8_t ucState;				/*< Tasks: the eTaskState of the task.  Otherwise 0. */
+} ObjectSnapshot_t;
+
+/**
+ * registry. h
+ * <pre>UBaseType_t uxObjectRegistrySnapshot( ObjectSnapshot_t * const pxSnapshots, const UBaseType_t uxMaxSnapshots, UBaseType_t * const puxNextEntry );</pre>
+ *
+ * Copies the state of the registered objects into an array.  Each object is
+ * copied in its own short critical section, and the scheduler is never
+ * suspended, so the snapshot does not delay higher priority tasks by more
+ * than the time taken to copy one object.  As objects can be created and
+ * deleted while the snapshot is taken, an object created or deleted part way
+ * through might or might not be included.
+ *
+ * A snapshot can be taken in several calls, each copying at most
+ * uxMaxSnapshots objects, by passing the same puxNextEntry to each call.
+ *
+ * @param pxSnapshots The array into which the objects are copied.
+ *
+ * @param uxMaxSnapshots The number of elements in the pxSnapshots array.
+ *
+ * @param puxNextEntry Set *puxNextEntry to 0 to start a snapshot.  It is
+ * updated to the registry entry at which the next call will continue, and is
+ * set to configOBJECT_REGISTRY_SIZE once every entry has been visited.
+ *
+ * @return The number of objects copied into pxSnapshots.
+ *
+ * Example usage:
+   <pre>
+ void vMonitorTask( void *pvParameters )
+ {
+ ObjectSnapshot_t xSnapshots[ 8 ];
+ UBaseType_t uxEntry, uxCopied, ux;
+
+	for( ;; )
+	{
+		uxEntry = 0;
+
+		while( uxEntry < configOBJECT_REGISTRY_SIZE )
+		{
+			uxCopied = uxObjectRegistrySnapshot( xSnapshots, 8, &uxEntry );
+
+			for( ux = 0; ux < uxCopied; ux++ )
+			{
+				// Export xSnapshots[ ux ].
+			}
+		}
+
+		vTaskDelay( 1000 / portTICK_PERIOD_MS );
+	}
+ }
+   </pre>
+ * \defgroup uxObjectRegistrySnapshot uxObjectRegistrySnapshot
+ * \ingroup ObjectRegistry
+ */
+UBaseType_t uxObjectRegistrySnapshot( ObjectSnapshot_t * const pxSnapshots, const UBaseType_t uxMaxSnapshots, UBaseType_t * const puxNextEntry ) PRIVILEGED_FUNCTION;
+
+/**
+ * registry. h
+ * <pre>BaseType_t xObjectRegistryGetSnapshot( void *pvObject, ObjectSnapshot_t *pxSnapshot );</pre>
+ *
+ * Copies the state of one registered object.
+ *
+ * @param pvObject The handle of the object.
+ *
+ * @param pxSnapshot The structure into which the object's state is copied.
+ *
+ * @return pdPASS if the object is registered, otherwise pdFAIL, in which case
+ * pxSnapshot is not written to.
+ *
+ * \defgroup xObjectRegistryGetSnapshot xObjectRegistryGetSnapshot
+ * \ingroup ObjectRegistry
+ */
+BaseType_t xObjectRegistryGetSnapshot( void *pvObject, ObjectSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+/**
+ * registry. h
+ * <pre>uint8_t ucObjectRegistryGetType( void *pvObject );</pre>
+ *
+ * @return The registryTYPE_ value of the object, or registryTYPE_NONE if
+ * pvObject is not the handle of a registered object.
+ *
+ * \defgroup ucObjectRegistryGetType ucObjectRegistryGetType
+ * \ingroup ObjectRegistry
+ */
+uint8_t ucObjectRegistryGetType( void *pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * registry. h
+ * <pre>BaseType_t xObjectRegistrySetName( void *pvObject, const char *pcName );</pre>
+ *
+ * Sets the name reported for a registered object.  The registry stores only a
+ * pointer to the string, so the string must persist for as long as the
+ * object exists.  Tasks and timers are named when they are created.
+ *
+ * @return pdPASS if the object is registered, otherwise pdFAIL.
+ *
+ * \defgroup xObjectRegistrySetName xObjectRegistrySetName
+ * \ingroup ObjectRegistry
+ */
+BaseType_t xObjectRegistrySetName( void *pvObject, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * THE FOLLOWING FUNCTIONS ARE FOR INTERNAL USE ONLY.
+ *
+ * xObjectRegistryAdd() and vObjectRegistryRemove() are called by the kernel
+ * when an object is created or deleted.  pxSnapshotFunction is implemented by
+ * the file that defines the object, and is called by the registry with
+ * interrupts masked to fill in the members of an ObjectSnapshot_t that depend
+ * on the type of the object.
+ */
+typedef void (*RegistrySnapshotFunction_t)( void *pvObject, ObjectSnapshot_t *pxSnapshot );
+
+BaseType_t xObjectRegistryAdd( void *pvObject, const uint8_t ucType, const char *pcName, RegistrySnapshotFunction_t pxSnapshotFunction ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+void vObjectRegistryRemove( void *pvObject ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGISTRY_H */
+
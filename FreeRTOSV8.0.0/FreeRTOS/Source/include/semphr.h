@@ -180,6 +180,23 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreCreateBinary() xQueueGenericCreate( ( UBaseType_t ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_BINARY_SEMAPHORE )
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateBinaryStatic( StaticQueue_t *pxSemaphoreBuffer )</pre>
+ *
+ * As xSemaphoreCreateBinary(), but the semaphore is created in the variable
+ * pointed to by pxSemaphoreBuffer, so no memory is allocated.  Only available
+ * when configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return Handle to the created semaphore.
+ *
+ * \defgroup xSemaphoreCreateBinaryStatic xSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateBinaryStatic( pxSemaphoreBuffer ) xQueueGenericCreateStatic( ( UBaseType_t ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE )
+#endif
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake(
@@ -688,6 +705,23 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateMutexStatic( StaticQueue_t *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateMutex(), but the mutex is created in the variable pointed
+ * to by pxMutexBuffer, so no memory is allocated.  Only available when
+ * configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return Handle to the created mutex.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -461,7 +461,11 @@ void vTaskAllocateMPURegions( TaskHandle_t xTask, const MemoryRegion_t * const p
  * the idle task is not starved of microcontroller processing time if your
  * application makes any calls to vTaskDelete ().  Memory allocated by the
  * task code is not automatically freed, and should be freed before the task
- * is deleted.
+ * is deleted.  When configUSE_TASK_RECLAIMER is 1 a dedicated reclaimer task
+ * frees the memory instead, and when configTASK_RECLAIM_INLINE is 1 a task
+ * deleted by another task is freed (or recycled, see xTaskPoolPreallocate())
+ * immediately.  uxTaskGetPendingReclaimCount() returns the number of deleted
+ * tasks still waiting to be freed.
  *
  * See the demo application file death.c for sample code that utilises
  * vTaskDelete ().
@@ -487,6 +491,66 @@ void vTaskAllocateMPURegions( TaskHandle_t xTask, const MemoryRegion_t * const p
  */
 void vTaskDelete( TaskHandle_t xTaskToDelete ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>BaseType_t xTaskPoolPreallocate( const uint16_t usStackDepth, UBaseType_t uxCount );</pre>
+ *
+ * configUSE_TASK_POOL must be defined as 1 for this function to be available.
+ * See the configuration section for more information.
+ *
+ * When configUSE_TASK_POOL is 1 the TCB and stack of a deleted task are kept
+ * in a pool, bucketed by stack size, and reused by the next task created with
+ * a stack that fits the same bucket.  A task deleted by another task is
+ * recycled immediately, and a task that deletes itself is recycled by the next
+ * task creation or by the idle task, whichever happens first.
+ *
+ * xTaskPoolPreallocate() fills the pool in advance, so the first tasks
+ * created with a stack of usStackDepth words do not have to allocate memory
+ * either.  The stack depth is rounded up to the size of its bucket.
+ *
+ * @param usStackDepth The stack depth, in words, of the tasks that will be
+ * created from the preallocated entries.  Must not exceed
+ * configMINIMAL_STACK_SIZE << ( configTASK_POOL_BUCKETS - 1 ).
+ *
+ * @param uxCount The number of TCB and stack pairs to add to the pool.  The
+ * pool never holds more than configTASK_POOL_SIZE pairs per bucket, so any
+ * beyond that are not allocated.
+ *
+ * @return pdPASS if the pairs were added to the pool, or
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if the heap ran out first.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( void )
+ {
+	 // Make sure four short lived workers can be created without
+	 // allocating from the heap.
+	 if( xTaskPoolPreallocate( configMINIMAL_STACK_SIZE, 4 ) != pdPASS )
+	 {
+		 // The heap is too small.
+	 }
+ }
+   </pre>
+ * \defgroup xTaskPoolPreallocate xTaskPoolPreallocate
+ * \ingroup Tasks
+ */
+BaseType_t xTaskPoolPreallocate( const uint16_t usStackDepth, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskGetPendingReclaimCount( void );</pre>
+ *
+ * INCLUDE_vTaskDelete must be defined as 1 for this function to be available.
+ * See the configuration section for more information.
+ *
+ * @return The number of deleted tasks whose memory has not yet been freed by
+ * the idle task, or by the reclaimer task if configUSE_TASK_RECLAIMER is 1.
+ *
+ * \defgroup uxTaskGetPendingReclaimCount uxTaskGetPendingReclaimCount
+ * \ingroup Tasks
+ */
+UBaseType_t uxTaskGetPendingReclaimCount( void ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * TASK CONTROL API
  *----------------------------------------------------------*/
@@ -0,0 +1,258 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef TICK_TIMERS_H
+#define TICK_TIMERS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include tick_timers.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Tick timers are software timers that are processed directly by the RTOS
+ * tick interrupt, rather than by the timer service (daemon) task used by the
+ * timers defined in timers.h.  Starting, stopping and changing the period of a
+ * tick timer updates the timer immediately - there is no command queue and no
+ * context switch - and a tick timer callback executes in the same tick
+ * interrupt in which the timer expires, so expiry latency does not depend on
+ * the priority of any task.
+ *
+ * Active tick timers are held in a timing wheel of
+ * configTICK_TIMER_WHEEL_SIZE slots, so starting and stopping a timer, and
+ * finding the timers that expire on a tick, take a constant time that does not
+ * depend on the number of active timers (provided timer periods are spread
+ * across the wheel).
+ *
+ * Tick timer callbacks execute from inside the tick interrupt, so they MUST
+ * be short, MUST NOT attempt to block, and MUST only call API functions that
+ * end in "FromISR".  The number of callbacks executed by a single tick can be
+ * limited by configTICK_TIMER_MAX_EXPIRIES_PER_TICK.
+ *
+ * configUSE_TICK_TIMERS must be set to 1 in FreeRTOSConfig.h for tick timers
+ * to be available.
+ *
+ * \defgroup TickTimer
+ */
+
+/**
+ * Type by which tick timers are referenced.  For example, a call to
+ * xTickTimerCreate() returns a TickTimerHandle_t variable that can then be
+ * used to reference the subject timer in calls to other tick timer API
+ * functions (for example, vTickTimerStart(), vTickTimerStop(), etc.).
+ *
+ * \defgroup TickTimerHandle_t TickTimerHandle_t
+ * \ingroup TickTimer
+ */
+typedef void * TickTimerHandle_t;
+
+/*
+ * Defines the prototype to which tick timer callback functions must conform.
+ * *pxHigherPriorityTaskWoken is passed in as pdFALSE, and should be passed
+ * into any FromISR API function that the callback calls.
+ */
+typedef void (*TickTimerCallbackFunction_t)( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+/**
+ * TickTimerHandle_t xTickTimerCreate( TickType_t xTimerPeriodInTicks,
+ *                                     UBaseType_t uxAutoReload,
+ *                                     void * pvTimerID,
+ *                                     TickTimerCallbackFunction_t pxCallbackFunction );
+ *
+ * Creates a new tick timer instance, and returns a handle by which the created
+ * timer can be referenced.  The timer is created in the dormant state.  This
+ * function cannot be called from an interrupt.
+ *
+ * @param xTimerPeriodInTicks The timer period, in ticks.  Must be greater than
+ * 0.
+ *
+ * @param uxAutoReload If uxAutoReload is set to pdTRUE then the timer will
+ * expire repeatedly with a frequency set by the xTimerPeriodInTicks parameter.
+ * An auto-reload timer is re-armed relative to the time at which it was due
+ * to expire, so it does not drift.  If uxAutoReload is set to pdFALSE then the
+ * timer will be a one-shot timer and enter the dormant state after it expires.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer being created,
+ * and that can be obtained using pvTickTimerGetTimerID().
+ *
+ * @param pxCallbackFunction The function to call from the tick interrupt when
+ * the timer expires.
+ *
+ * @return If the timer is successfully created then a handle to the newly
+ * created timer is returned.  If the timer cannot be created (because there is
+ * insufficient FreeRTOS heap remaining) then NULL is returned.
+ *
+ * Example usage:
+ * @verbatim
+ * // Sample an ADC channel exactly every 5 ticks, and pass the samples to a
+ * // processing task.
+ * void vSampleCallback( TickTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+ * {
+ * uint16_t usSample;
+ *
+ *     usSample = usReadADC();
+ *     xQueueSendFromISR( xSampleQueue, &usSample, pxHigherPriorityTaskWoken );
+ * }
+ *
+ * void vStartSampling( void )
+ * {
+ * TickTimerHandle_t xSampleTimer;
+ *
+ *     xSampleTimer = xTickTimerCreate( 5, pdTRUE, NULL, vSampleCallback );
+ *
+ *     if( xSampleTimer != NULL )
+ *     {
+ *         vTickTimerStart( xSampleTimer );
+ *     }
+ * }
+ * @endverbatim
+ */
+TickTimerHandle_t xTickTimerCreate( const TickType_t xTimerPeriodInTicks, const UBaseType_t uxAutoReload, void * const pvTimerID, TickTimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTickTimerDelete( TickTimerHandle_t xTimer );
+ *
+ * Stops the timer if it is active, then frees the memory allocated to the
+ * timer.  This function cannot be called from an interrupt, and must not be
+ * called for a timer whose callback function is executing.
+ */
+void vTickTimerDelete( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTickTimerStart( TickTimerHandle_t xTimer );
+ *
+ * Starts a dormant timer, or restarts an active timer, so that it expires
+ * xTimerPeriodInTicks ticks after the function is called.  The timer is
+ * updated directly so, unlike xTimerStart(), the function cannot fail and
+ * does not take a block time.
+ *
+ * vTickTimerStartFromISR() is a version that can be called from an interrupt,
+ * including from a tick timer callback function.
+ */
+void vTickTimerStart( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+void vTickTimerStartFromISR( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * Tick timers are restarted by vTickTimerStart(), so resetting a timer is
+ * the same as starting it.
+ */
+#define vTickTimerReset( xTimer ) vTickTimerStart( xTimer )
+#define vTickTimerResetFromISR( xTimer ) vTickTimerStartFromISR( xTimer )
+
+/**
+ * void vTickTimerStop( TickTimerHandle_t xTimer );
+ *
+ * Stops an active timer.  Stopping a timer that is already dormant has no
+ * effect.
+ *
+ * vTickTimerStopFromISR() is a version that can be called from an interrupt,
+ * including from a tick timer callback function.
+ */
+void vTickTimerStop( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+void vTickTimerStopFromISR( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTickTimerChangePeriod( TickTimerHandle_t xTimer, TickType_t xNewPeriod );
+ *
+ * Changes the period of a timer, then starts the timer so it expires
+ * xNewPeriod ticks after the function is called - the same as
+ * xTimerChangePeriod().
+ *
+ * vTickTimerChangePeriodFromISR() is a version that can be called from an
+ * interrupt, including from a tick timer callback function.
+ */
+void vTickTimerChangePeriod( TickTimerHandle_t xTimer, const TickType_t xNewPeriod ) PRIVILEGED_FUNCTION;
+void vTickTimerChangePeriodFromISR( TickTimerHandle_t xTimer, const TickType_t xNewPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTickTimerIsActive( TickTimerHandle_t xTimer );
+ *
+ * Returns pdFALSE if the timer is dormant, otherwise pdTRUE.  A one-shot timer
+ * becomes dormant before its callback function is called.
+ */
+BaseType_t xTickTimerIsActive( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void *pvTickTimerGetTimerID( TickTimerHandle_t xTimer );
+ *
+ * Returns the ID assigned to the timer when it was created.
+ */
+void *pvTickTimerGetTimerID( TickTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+BaseType_t xTickTimerIncrementTick( const TickType_t xTimeNow, const TickType_t xTicksElapsed ) PRIVILEGED_FUNCTION;
+TickType_t xTickTimerGetExpectedIdleTime( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* TICK_TIMERS_H */
+
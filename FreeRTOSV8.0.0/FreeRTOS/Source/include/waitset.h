@@ -0,0 +1,433 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef WAIT_SET_H
+#define WAIT_SET_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include waitset.h"
+#endif
+
+#include "queue.h"
+#include "event_groups.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A wait set allows a task to block on any number of queues, semaphores,
+ * mutexes and event groups at once, and to be told which of them became
+ * ready in a single call.
+ *
+ * Unlike a queue set, posting to a member of a wait set does not copy the
+ * member's handle into a separate queue.  Each member instead holds a list
+ * item that is linked into the wait set's ready list the first time the
+ * member becomes ready, so posting to a member that is already in the ready
+ * list costs no more than checking a pointer.  uxWaitSetWait() then walks the
+ * ready list and returns as many ready members as the caller has room for.
+ *
+ * Each member is either level triggered or edge triggered:
+ *
+ * + A level triggered member is reported by every call to uxWaitSetWait()
+ *   for as long as it remains ready - that is, for as long as the queue
+ *   contains data, the semaphore or mutex is available, or one of the event
+ *   group bits of interest is set.  Members that remain ready are moved to the
+ *   back of the ready list each time they are reported, so a member that is
+ *   always ready cannot starve the others.
+ *
+ * + An edge triggered member is reported once each time it is posted to (or
+ *   has bits set), then not again until it is posted to again.  The reader
+ *   is expected to drain the member after it is reported.
+ *
+ * A wait set can also be notified directly, using xWaitSetNotify() and
+ * xWaitSetNotifyFromISR(), which provides a lightweight signal that does not
+ * need a separate kernel object.
+ *
+ * Readiness is only tracked for receiving (reading a queue, taking a
+ * semaphore or mutex).  Blocking on a wait set that contains a mutex will not
+ * cause the mutex holder to inherit the priority of the blocked task.  A queue
+ * or semaphore cannot be a member of a wait set and a queue set at the same
+ * time, and each object can be a member of only one wait set.
+ *
+ * configUSE_WAIT_SETS must be set to 1 in FreeRTOSConfig.h for the wait set
+ * API to be available.
+ *
+ * \defgroup WaitSet
+ */
+
+/**
+ * waitset.h
+ *
+ * Type by which wait sets are referenced.  For example, a call to
+ * xWaitSetCreate() returns a WaitSetHandle_t variable that can then be used
+ * as a parameter to other wait set functions.
+ *
+ * \defgroup WaitSetHandle_t WaitSetHandle_t
+ * \ingroup WaitSet
+ */
+typedef void * WaitSetHandle_t;
+
+/*
+ * uxFlags values that can be passed into xWaitSetAddQueue() and
+ * xWaitSetAddEventGroup().
+ */
+#define waitsetLEVEL_TRIGGERED	( ( UBaseType_t ) 0x00U )
+#define waitsetEDGE_TRIGGERED	( ( UBaseType_t ) 0x01U )
+
+/*
+ * The structure uxWaitSetWait() fills in for each ready member.
+ *
+ * \defgroup WaitSetEvent_t WaitSetEvent_t
+ * \ingroup WaitSet
+ */
+typedef struct xWAIT_SET_EVENT
+{
+	void *pvObject;				/*< The queue, semaphore, mutex or event group that is ready, or the wait set itself if the event was generated by xWaitSetNotify(). */
+	void *pvUserData;			/*< The value passed into xWaitSetAddQueue() or xWaitSetAddEventGroup() when the member was added.  NULL for notifications. */
+	EventBits_t uxEventBits;	/*< Event groups: the bits of interest that are set (level triggered) or were set since the last report (edge triggered).  Notifications: the notification bits.  Queues: 0. */
+} WaitSetEvent_t;
+
+/**
+ * waitset.h
+ *<pre>
+ WaitSetHandle_t xWaitSetCreate( const UBaseType_t uxMaxMembers );
+ </pre>
+ *
+ * Create a wait set.  The wait set and the records used to track its members
+ * are allocated from the FreeRTOS heap in a single allocation.
+ *
+ * @param uxMaxMembers The maximum number of queues, semaphores, mutexes and
+ * event groups that can be members of the wait set at any one time.
+ *
+ * @return A handle to the created wait set, or NULL if there was insufficient
+ * FreeRTOS heap available.
+ *
+ * \defgroup xWaitSetCreate xWaitSetCreate
+ * \ingroup WaitSet
+ */
+WaitSetHandle_t xWaitSetCreate( const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ void vWaitSetDelete( WaitSetHandle_t xWaitSet );
+ </pre>
+ *
+ * Remove every member from a wait set, then free the wait set.  No task can
+ * be blocked on the wait set when it is deleted.
+ *
+ * @param xWaitSet The wait set being deleted.
+ *
+ * \defgroup vWaitSetDelete vWaitSetDelete
+ * \ingroup WaitSet
+ */
+void vWaitSetDelete( WaitSetHandle_t xWaitSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet,
+                              QueueHandle_t xQueueOrSemaphore,
+                              UBaseType_t uxFlags,
+                              void *pvUserData );
+ </pre>
+ *
+ * Add a queue, semaphore or mutex to a wait set.  The member is ready when
+ * the queue contains data, or when the semaphore or mutex can be taken.
+ * Unlike xQueueAddToSet(), the queue does not need to be empty when it is
+ * added - a member that is already ready is reported by the next call to
+ * uxWaitSetWait().
+ *
+ * @param xWaitSet The wait set to which the queue is being added.
+ *
+ * @param xQueueOrSemaphore The queue, semaphore or mutex being added.
+ *
+ * @param uxFlags Either waitsetLEVEL_TRIGGERED or waitsetEDGE_TRIGGERED.
+ *
+ * @param pvUserData A value that is returned in the pvUserData member of the
+ * WaitSetEvent_t structure each time the member is reported.
+ *
+ * @return pdPASS if the queue was added.  pdFAIL if the wait set is full, or
+ * if the queue is already a member of a wait set or queue set.
+ *
+ * \defgroup xWaitSetAddQueue xWaitSetAddQueue
+ * \ingroup WaitSet
+ */
+BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet, QueueHandle_t xQueueOrSemaphore, UBaseType_t uxFlags, void *pvUserData ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet,
+                                   EventGroupHandle_t xEventGroup,
+                                   const EventBits_t uxBitsToWaitFor,
+                                   UBaseType_t uxFlags,
+                                   void *pvUserData );
+ </pre>
+ *
+ * Add an event group to a wait set.  The member is ready when any of the bits
+ * in uxBitsToWaitFor are set.  The wait set never clears bits in the event
+ * group.
+ *
+ * @param xWaitSet The wait set to which the event group is being added.
+ *
+ * @param xEventGroup The event group being added.
+ *
+ * @param uxBitsToWaitFor The bits of interest.  Must not be zero.
+ *
+ * @param uxFlags Either waitsetLEVEL_TRIGGERED or waitsetEDGE_TRIGGERED.
+ *
+ * @param pvUserData A value that is returned in the pvUserData member of the
+ * WaitSetEvent_t structure each time the member is reported.
+ *
+ * @return pdPASS if the event group was added.  pdFAIL if the wait set is
+ * full, or if the event group is already a member of a wait set.
+ *
+ * \defgroup xWaitSetAddEventGroup xWaitSetAddEventGroup
+ * \ingroup WaitSet
+ */
+BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet, EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, UBaseType_t uxFlags, void *pvUserData ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ BaseType_t xWaitSetRemove( WaitSetHandle_t xWaitSet, void *pvObject );
+ </pre>
+ *
+ * Remove a queue, semaphore, mutex or event group from a wait set.  Objects
+ * that are deleted while they are members of a wait set are removed from the
+ * wait set automatically.
+ *
+ * @param xWaitSet The wait set from which the object is being removed.
+ *
+ * @param pvObject The handle of the object being removed.
+ *
+ * @return pdPASS if the object was removed.  pdFAIL if the object was not a
+ * member of xWaitSet.
+ *
+ * \defgroup xWaitSetRemove xWaitSetRemove
+ * \ingroup WaitSet
+ */
+BaseType_t xWaitSetRemove( WaitSetHandle_t xWaitSet, void *pvObject ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ UBaseType_t uxWaitSetWait( WaitSetHandle_t xWaitSet,
+                            WaitSetEvent_t * const pxEvents,
+                            const UBaseType_t uxMaxEvents,
+                            TickType_t xTicksToWait );
+ </pre>
+ *
+ * Wait for one or more members of a wait set to become ready, or for the wait
+ * set to be notified.  This function cannot be called from an interrupt.
+ *
+ * uxWaitSetWait() does not read from, or take, the ready members itself.  The
+ * caller is expected to do that using the handles returned in pxEvents, using
+ * a block time of zero.
+ *
+ * If more than one task is blocked on the same wait set then each event
+ * (each post to a member, or each notification) unblocks only the highest
+ * priority of the blocked tasks, in the same way that each item sent to a
+ * queue unblocks only one receiving task.  The other tasks remain blocked
+ * until further events occur or their block times expire, even if the task
+ * that was unblocked leaves members ready.
+ *
+ * @param xWaitSet The wait set on which the calling task will (potentially)
+ * block.
+ *
+ * @param pxEvents An array of uxMaxEvents structures into which the ready
+ * members are written.
+ *
+ * @param uxMaxEvents The number of structures in the pxEvents array.  Must be
+ * at least 1.  Ready members that do not fit are returned by the next call.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for a member to become ready.
+ *
+ * @return The number of structures written to pxEvents, which is 0 if
+ * xTicksToWait expired before any member became ready.
+ *
+ * Example usage:
+   <pre>
+	void vServerTask( void *pvParameters )
+	{
+	WaitSetHandle_t xWaitSet;
+	WaitSetEvent_t xEvents[ 4 ];
+	UBaseType_t uxEvent, uxCount;
+
+		xWaitSet = xWaitSetCreate( 3 );
+		xWaitSetAddQueue( xWaitSet, xCommandQueue, waitsetLEVEL_TRIGGERED, NULL );
+		xWaitSetAddQueue( xWaitSet, xRxSemaphore, waitsetLEVEL_TRIGGERED, NULL );
+		xWaitSetAddEventGroup( xWaitSet, xLinkEvents, LINK_UP_BIT | LINK_DOWN_BIT, waitsetEDGE_TRIGGERED, NULL );
+
+		for( ;; )
+		{
+			uxCount = uxWaitSetWait( xWaitSet, xEvents, 4, portMAX_DELAY );
+
+			for( uxEvent = 0; uxEvent < uxCount; uxEvent++ )
+			{
+				if( xEvents[ uxEvent ].pvObject == xCommandQueue )
+				{
+					xQueueReceive( xCommandQueue, &xCommand, 0 );
+					...
+				}
+				else if( xEvents[ uxEvent ].pvObject == xRxSemaphore )
+				{
+					xSemaphoreTake( xRxSemaphore, 0 );
+					...
+				}
+				else
+				{
+					// xEvents[ uxEvent ].uxEventBits holds the link bits
+					// that were set.
+				}
+			}
+		}
+	}
+   </pre>
+ * \defgroup uxWaitSetWait uxWaitSetWait
+ * \ingroup WaitSet
+ */
+UBaseType_t uxWaitSetWait( WaitSetHandle_t xWaitSet, WaitSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ BaseType_t xWaitSetNotify( WaitSetHandle_t xWaitSet, const EventBits_t uxBitsToSet );
+ </pre>
+ *
+ * Notify a wait set directly.  uxBitsToSet is ORed into the wait set's
+ * notification value, and the next call to uxWaitSetWait() reports a single
+ * event that has the wait set itself as its pvObject and the accumulated
+ * notification value as its uxEventBits.  The notification value is cleared
+ * when it is reported.
+ *
+ * This function cannot be called from an interrupt.  See
+ * xWaitSetNotifyFromISR().
+ *
+ * @param xWaitSet The wait set being notified.
+ *
+ * @param uxBitsToSet The bits to set in the notification value.  Must not be
+ * zero.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xWaitSetNotify xWaitSetNotify
+ * \ingroup WaitSet
+ */
+BaseType_t xWaitSetNotify( WaitSetHandle_t xWaitSet, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset.h
+ *<pre>
+ BaseType_t xWaitSetNotifyFromISR( WaitSetHandle_t xWaitSet,
+                                   const EventBits_t uxBitsToSet,
+                                   BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xWaitSetNotify() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xWaitSet The wait set being notified.
+ *
+ * @param uxBitsToSet The bits to set in the notification value.  Must not be
+ * zero.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if the notification unblocked a task that has a priority above that
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt exits.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xWaitSetNotifyFromISR xWaitSetNotifyFromISR
+ * \ingroup WaitSet
+ */
+BaseType_t xWaitSetNotifyFromISR( WaitSetHandle_t xWaitSet, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ *
+ * xWaitSetSignalMember() is called by queue.c and event_groups.c when an
+ * object that is a member of a wait set is posted to or has bits set.  It
+ * must be called with interrupts masked.  It unblocks at most one task - the
+ * highest priority task blocked on the wait set - and returns pdTRUE if that
+ * task has a priority above that of the calling task.
+ *
+ * vWaitSetDetachMember() is called when an object that is a member of a wait
+ * set is deleted.
+ */
+BaseType_t xWaitSetSignalMember( void *pvWaitSetMember, const EventBits_t uxBitsSet ) PRIVILEGED_FUNCTION;
+void vWaitSetDetachMember( void *pvWaitSetMember ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAIT_SET_H */
+
@@ -0,0 +1,408 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include workqueue.h"
+#endif
+
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A work queue is a pool of worker tasks that execute functions on behalf of
+ * other tasks and interrupts.  It provides an alternative to
+ * xTimerPendFunctionCall() for deferred processing that does not funnel all
+ * the deferred work through the single timer service task - so a slow
+ * function does not delay the processing of software timers or of other
+ * deferred interrupt handlers.
+ *
+ * Each worker task owns a list of work items that are waiting to execute.
+ * Work items submitted from outside of the work queue are distributed between
+ * the workers in turn.  Work items submitted by a function that is already
+ * executing in the work queue are placed in the list owned by the worker that
+ * is executing the function.  A worker that has nothing left in its own list
+ * takes (steals) work from the worker that has the most work waiting, so no
+ * worker is idle while work is waiting to execute.
+ *
+ * All the workers in a work queue run at the same priority.  Create one work
+ * queue for each priority band at which deferred work is to execute.
+ *
+ * Work items are allocated by the application, so submitting a work item
+ * never allocates memory and never copies data.  This keeps the
+ * xWorkQueueSubmitFromISR() path short.
+ *
+ * \defgroup WorkQueue
+ */
+
+/**
+ * workqueue.h
+ *
+ * Type by which work queues are referenced.  For example, a call to
+ * xWorkQueueCreate() returns a WorkQueueHandle_t variable that can then be
+ * used as a parameter to other work queue functions.
+ *
+ * \defgroup WorkQueueHandle_t WorkQueueHandle_t
+ * \ingroup WorkQueue
+ */
+typedef void * WorkQueueHandle_t;
+
+/*
+ * Defines the prototype to which functions executed by a work queue must
+ * conform.
+ */
+typedef void (*WorkFunction_t)( void * );
+
+/*
+ * The work item structure.  The application must allocate one WorkItem_t for
+ * each piece of work, and the structure must remain valid until the work item
+ * has executed or been cancelled.  The members of the structure must not be
+ * accessed directly - use vWorkItemInitialise() to set up the structure.
+ *
+ * \defgroup WorkItem_t WorkItem_t
+ * \ingroup WorkQueue
+ */
+typedef struct xWORK_ITEM
+{
+	ListItem_t xWorkListItem;		/*< Used to reference the work item from either a worker list or the delayed work list.  The list item value holds the time at which delayed work becomes ready. */
+	WorkFunction_t pxFunction;		/*< The function executed by the work queue. */
+	void *pvParameter;				/*< The parameter passed into pxFunction. */
+} WorkItem_t;
+
+/**
+ * workqueue.h
+ *<pre>
+ WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+                                     UBaseType_t uxNumberOfWorkers,
+                                     UBaseType_t uxPriority,
+                                     uint16_t usStackDepth );
+ </pre>
+ *
+ * Create a work queue and the worker tasks that execute the work submitted to
+ * it.  This function cannot be called from an interrupt.
+ *
+ * @param pcName The text name given to each worker task.
+ *
+ * @param uxNumberOfWorkers The number of worker tasks to create.  Must be at
+ * least 1.
+ *
+ * @param uxPriority The priority at which all the worker tasks run.
+ *
+ * @param usStackDepth The stack depth, in words, of each worker task.  The
+ * stack must be large enough to hold the stack frame of the deepest function
+ * executed by the work queue.
+ *
+ * @return If the work queue and all its worker tasks were created then a
+ * handle to the work queue is returned.  If there was insufficient FreeRTOS
+ * heap available then NULL is returned.
+ *
+ * Example usage:
+   <pre>
+	// Two workers that execute deferred interrupt processing at a priority
+	// above that of the application tasks.
+	WorkQueueHandle_t xDeferredWork;
+
+	xDeferredWork = xWorkQueueCreate( "DWork", 2, configMAX_PRIORITIES - 1, configMINIMAL_STACK_SIZE * 2 );
+
+	if( xDeferredWork == NULL )
+	{
+		// There was insufficient FreeRTOS heap available.
+	}
+   </pre>
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueue
+ */
+WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, UBaseType_t uxNumberOfWorkers, UBaseType_t uxPriority, uint16_t usStackDepth ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * workqueue.h
+ *<pre>
+ void vWorkItemInitialise( WorkItem_t * const pxWorkItem,
+                           WorkFunction_t pxFunction,
+                           void *pvParameter );
+ </pre>
+ *
+ * Prepare a work item for use.  A work item must be initialised before it is
+ * first submitted, and must not be initialised again while it is waiting to
+ * execute.
+ *
+ * @param pxWorkItem The work item being initialised.
+ *
+ * @param pxFunction The function the work queue executes when the work item
+ * runs.
+ *
+ * @param pvParameter The value passed into pxFunction.
+ *
+ * \defgroup vWorkItemInitialise vWorkItemInitialise
+ * \ingroup WorkQueue
+ */
+void vWorkItemInitialise( WorkItem_t * const pxWorkItem, WorkFunction_t pxFunction, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem );
+ </pre>
+ *
+ * Submit a work item to a work queue.  The work item executes once, in the
+ * context of one of the work queue's worker tasks.
+ *
+ * A work item can be submitted again once it has started executing -
+ * including from within its own function.
+ *
+ * This function cannot be called from an interrupt.  See
+ * xWorkQueueSubmitFromISR().
+ *
+ * @param xWorkQueue The work queue to which the work item is submitted.
+ *
+ * @param pxWorkItem The work item being submitted.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to execute, in which case the work item will still only
+ * execute once.
+ *
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueue
+ */
+#define xWorkQueueSubmit( xWorkQueue, pxWorkItem ) xWorkQueueSubmitDelayed( ( xWorkQueue ), ( pxWorkItem ), 0 )
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueSubmitDelayed( WorkQueueHandle_t xWorkQueue,
+                                     WorkItem_t * const pxWorkItem,
+                                     TickType_t xTicksToDelay );
+ </pre>
+ *
+ * Submit a work item that is not to execute until xTicksToDelay ticks have
+ * passed.  The delay is measured from the time xWorkQueueSubmitDelayed() is
+ * called, in the same way as vTaskDelay().  A delay of 0 is equivalent to
+ * calling xWorkQueueSubmit().
+ *
+ * This function cannot be called from an interrupt.
+ *
+ * @param xWorkQueue The work queue to which the work item is submitted.
+ *
+ * @param pxWorkItem The work item being submitted.
+ *
+ * @param xTicksToDelay The number of ticks to wait before the work item is
+ * made ready to execute.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to execute.
+ *
+ * \defgroup xWorkQueueSubmitDelayed xWorkQueueSubmitDelayed
+ * \ingroup WorkQueue
+ */
+BaseType_t xWorkQueueSubmitDelayed( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem, TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                     WorkItem_t * const pxWorkItem,
+                                     BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt
+ * service routine.  Submitting a work item only links the item into a worker
+ * list and gives a semaphore, so the time spent inside the interrupt is
+ * short and constant.
+ *
+ * @param xWorkQueue The work queue to which the work item is submitted.
+ *
+ * @param pxWorkItem The work item being submitted.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if submitting the work item unblocked a worker task that has a
+ * priority above that of the currently running task.  If
+ * *pxHigherPriorityTaskWoken is set to pdTRUE then a context switch should be
+ * requested before the interrupt exits.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to execute.
+ *
+ * Example usage:
+   <pre>
+	WorkItem_t xRxWork;
+
+	void vRxISR( void )
+	{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		// Clear the interrupt, then defer the processing to the work queue.
+		// xRxWork was initialised using vWorkItemInitialise() before the
+		// interrupt was enabled.
+		xWorkQueueSubmitFromISR( xDeferredWork, &xRxWork, &xHigherPriorityTaskWoken );
+
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	}
+   </pre>
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueue
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem );
+ </pre>
+ *
+ * Remove a work item that is waiting to execute - either because it is
+ * delayed or because it is waiting for a worker to become available.  This
+ * function cannot be called from an interrupt.
+ *
+ * @param xWorkQueue The work queue to which the work item was submitted.
+ *
+ * @param pxWorkItem The work item being cancelled.
+ *
+ * @return pdPASS if the work item was removed before it started executing.
+ * pdFAIL if the work item was not waiting to execute - it may be executing,
+ * may have already executed, or may never have been submitted.
+ *
+ * \defgroup xWorkQueueCancel xWorkQueueCancel
+ * \ingroup WorkQueue
+ */
+BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueFlush( WorkQueueHandle_t xWorkQueue, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Wait for all the work items that are waiting to execute, or are executing,
+ * in a work queue to complete.  Delayed work items are waited for too, so a
+ * flush does not complete before the last delayed item has executed (or been
+ * cancelled).  A work item that keeps submitting itself again prevents the
+ * flush from completing until it stops doing so or xTicksToWait expires.
+ *
+ * This function cannot be called from an interrupt, and must not be called
+ * by a function that is executing in the work queue being flushed.
+ *
+ * @param xWorkQueue The work queue being flushed.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the work queue to become empty.
+ *
+ * @return pdPASS if the work queue became empty.  pdFAIL if xTicksToWait
+ * expired first.
+ *
+ * \defgroup xWorkQueueFlush xWorkQueueFlush
+ * \ingroup WorkQueue
+ */
+BaseType_t xWorkQueueFlush( WorkQueueHandle_t xWorkQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * workqueue.h
+ *<pre>
+ BaseType_t xWorkQueueDelete( WorkQueueHandle_t xWorkQueue );
+ </pre>
+ *
+ * Delete a work queue, its worker tasks, and the memory allocated to them.
+ * The work queue is only deleted if it is empty - no work item is delayed,
+ * waiting to execute or executing.  Use xWorkQueueFlush() and
+ * xWorkQueueCancel() to empty the work queue first, and ensure nothing
+ * submits to the work queue while, or after, it is deleted.
+ *
+ * The worker tasks are deleted using vTaskDelete(), so their memory is
+ * reclaimed in the same way as that of any other deleted task.
+ *
+ * INCLUDE_vTaskDelete must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  This function cannot be called from an interrupt, and
+ * must not be called by a function that is executing in the work queue being
+ * deleted.
+ *
+ * @param xWorkQueue The work queue being deleted.
+ *
+ * @return pdPASS if the work queue was deleted.  pdFAIL if the work queue was
+ * not empty, in which case it has not been changed.
+ *
+ * Example usage:
+   <pre>
+	if( xWorkQueueFlush( xDeferredWork, portMAX_DELAY ) == pdPASS )
+	{
+		// Nothing else submits to xDeferredWork, so it is still empty.
+		xWorkQueueDelete( xDeferredWork );
+		xDeferredWork = NULL;
+	}
+   </pre>
+ * \defgroup xWorkQueueDelete xWorkQueueDelete
+ * \ingroup WorkQueue
+ */
+BaseType_t xWorkQueueDelete( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORK_QUEUE_H */
+
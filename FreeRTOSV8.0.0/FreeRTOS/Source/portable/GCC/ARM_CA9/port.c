@@ -114,6 +114,20 @@
 	#define configCLEAR_TICK_INTERRUPT()
 #endif
 
+#if( configUSE_STACK_GUARD_PAGES == 1 )
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) || ( INCLUDE_pcTaskGetTaskName != 1 ) )
+		#error INCLUDE_xTaskGetCurrentTaskHandle and INCLUDE_pcTaskGetTaskName must be set to 1 when configUSE_STACK_GUARD_PAGES is set to 1.
+	#endif
+
+	/* The number of second level translation tables available for splitting
+	1MB sections into 4KB pages.  One is needed for each 1MB section that
+	contains a guard page, so the default covers a heap of
+	configTOTAL_HEAP_SIZE bytes wherever it is placed. */
+	#ifndef configSTACK_GUARD_PAGE_TABLES
+		#define configSTACK_GUARD_PAGE_TABLES	( ( configTOTAL_HEAP_SIZE >> 20UL ) + 2UL )
+	#endif
+#endif /* configUSE_STACK_GUARD_PAGES */
+
 /* A critical section is exited when the critical section nesting count reaches
 this value. */
 #define portNO_CRITICAL_NESTING			( ( uint32_t ) 0 )
@@ -174,6 +188,27 @@ the CPU itself before modifying certain hardware registers. */
 #define portMAX_8_BIT_VALUE							( ( uint8_t ) 0xff )
 #define portBIT_0_SET								( ( uint8_t ) 0x01 )
 
+/* ARMv7-A short descriptor translation table definitions used to manage stack
+guard pages. */
+#define portPAGE_SIZE								( 4096UL )
+#define portSECTION_SHIFT							( 20UL )
+#define portPAGE_SHIFT								( 12UL )
+#define portTTBR_BASE_MASK							( 0xFFFFC000UL )
+#define portL1_TYPE_MASK							( 0x03UL )
+#define portL1_TYPE_COARSE							( 0x01UL )
+#define portL1_TYPE_SECTION							( 0x02UL )
+#define portL1_SUPERSECTION_BIT						( 1UL << 18UL )
+#define portL1_COARSE_BASE_MASK						( 0xFFFFFC00UL )
+#define portL2_ENTRIES								( 256UL )
+#define portL2_INDEX_MASK							( 0xFFUL )
+#define portL2_TYPE_SMALL_PAGE						( 0x02UL )
+#define portL2_AP_MASK								( ( 0x03UL << 4UL ) | ( 1UL << 9UL ) )
+#define portDFSR_STATUS_MASK						( 0x40FUL )
+#define portDFSR_SECTION_ACCESS_FLAG_FAULT			( 0x003UL )
+#define portDFSR_PAGE_ACCESS_FLAG_FAULT				( 0x006UL )
+#define portDFSR_SECTION_PERMISSION_FAULT			( 0x00DUL )
+#define portDFSR_PAGE_PERMISSION_FAULT				( 0x00FUL )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -182,6 +217,41 @@ the CPU itself before modifying certain hardware registers. */
  */
 extern void vPortRestoreTaskContext( void );
 
+#if( configUSE_STACK_GUARD_PAGES == 1 )
+
+	/*
+	 * Return a pointer to the second level translation table entry that maps
+	 * ulAddress.  If ulAddress is mapped by a 1MB section, and xSplitSection is
+	 * pdTRUE, the section is first replaced by a second level table that maps
+	 * the same memory with the same attributes.  Returns NULL if the address
+	 * is not mapped by a table this port can modify.
+	 */
+	static uint32_t *prvGetPageTableEntry( uint32_t ulAddress, BaseType_t xSplitSection );
+
+	/*
+	 * Remove all access to, or restore access to, the 4KB page at ulAddress.
+	 */
+	static BaseType_t prvSetGuardPage( uint32_t ulAddress, BaseType_t xGuard );
+
+	/*
+	 * Returns pdTRUE if the 4KB page that contains ulAddress is a guard page.
+	 */
+	static BaseType_t prvIsGuardPage( uint32_t ulAddress );
+
+	/*
+	 * Returns pdTRUE if ulFaultStatus, the DFSR value of a data abort, is one
+	 * of the faults an access to a guard page can cause.
+	 */
+	static BaseType_t prvIsGuardPageFault( uint32_t ulFaultStatus );
+
+	/*
+	 * Provided by the application - see the comments above
+	 * configUSE_STACK_GUARD_PAGES in portmacro.h.
+	 */
+	extern void vApplicationStackGuardHook( TaskHandle_t xTask, char *pcTaskName );
+
+#endif /* configUSE_STACK_GUARD_PAGES */
+
 /*-----------------------------------------------------------*/
 
 /* A variable is used to keep track of the critical section nesting.  This
@@ -207,6 +277,17 @@ __attribute__(( used )) const uint32_t ulICCEOIR = portICCEOIR_END_OF_INTERRUPT_
 __attribute__(( used )) const uint32_t ulICCPMR	= portICCPMR_PRIORITY_MASK_REGISTER_ADDRESS;
 __attribute__(( used )) const uint32_t ulMaxAPIPriorityMask = ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
 
+#if( configUSE_STACK_GUARD_PAGES == 1 )
+
+	/* Second level translation tables used to map the 1MB sections that
+	contain guard pages as 4KB pages, and the access permission bits each
+	section had before it was split (restored when a guard page is freed). */
+	static uint32_t ulPageTables[ configSTACK_GUARD_PAGE_TABLES ][ portL2_ENTRIES ] __attribute__(( aligned( 1024 ) ));
+	static uint32_t ulPageTableAccess[ configSTACK_GUARD_PAGE_TABLES ];
+	static UBaseType_t uxPageTablesUsed = 0;
+
+#endif /* configUSE_STACK_GUARD_PAGES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -511,3 +592,250 @@ uint32_t ulReturn;
 #endif /* configASSERT_DEFINED */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STACK_GUARD_PAGES == 1 )
+
+	static uint32_t *prvGetPageTableEntry( uint32_t ulAddress, BaseType_t xSplitSection )
+	{
+	uint32_t ulTTBR0, ulSection, ulAttributes, ulIndex;
+	volatile uint32_t *pulL1Entry;
+	uint32_t *pulTable, *pulReturn = NULL;
+	UBaseType_t uxTable;
+
+		/* Locate the first level entry.  TTBCR.N is assumed to be 0, and the
+		tables are assumed to be flat (virtual address == physical address)
+		mapped. */
+		__asm volatile ( "mrc p15, 0, %0, c2, c0, 0" : "=r" ( ulTTBR0 ) );
+		pulL1Entry = &( ( ( volatile uint32_t * ) ( ulTTBR0 & portTTBR_BASE_MASK ) )[ ulAddress >> portSECTION_SHIFT ] );
+
+		if( ( *pulL1Entry & portL1_TYPE_MASK ) == portL1_TYPE_COARSE )
+		{
+			/* Only tables created by this file are modified, as only for those
+			are the original access permissions known. */
+			pulTable = ( uint32_t * ) ( *pulL1Entry & portL1_COARSE_BASE_MASK );
+
+			for( uxTable = 0; uxTable < uxPageTablesUsed; uxTable++ )
+			{
+				if( pulTable == ulPageTables[ uxTable ] )
+				{
+					pulReturn = &( pulTable[ ( ulAddress >> portPAGE_SHIFT ) & portL2_INDEX_MASK ] );
+					break;
+				}
+			}
+		}
+		else if( ( ( *pulL1Entry & portL1_TYPE_MASK ) == portL1_TYPE_SECTION ) &&
+				 ( ( *pulL1Entry & portL1_SUPERSECTION_BIT ) == 0UL ) &&
+				 ( xSplitSection != pdFALSE ) &&
+				 ( uxPageTablesUsed < ( UBaseType_t ) configSTACK_GUARD_PAGE_TABLES ) )
+		{
+			ulSection = *pulL1Entry;
+			pulTable = ulPageTables[ uxPageTablesUsed ];
+
+			/* Translate the section attributes into small page attributes:
+			XN (bit 4 -> bit 0), C and B (unchanged), AP[1:0] (bits 11:10 ->
+			bits 5:4), TEX (bits 14:12 -> bits 8:6), AP[2] (bit 15 -> bit 9),
+			S (bit 16 -> bit 10) and nG (bit 17 -> bit 11). */
+			ulAttributes = portL2_TYPE_SMALL_PAGE;
+			ulAttributes |= ( ulSection >> 4UL ) & 0x01UL;
+			ulAttributes |= ulSection & 0x0CUL;
+			ulAttributes |= ( ( ulSection >> 10UL ) & 0x03UL ) << 4UL;
+			ulAttributes |= ( ( ulSection >> 12UL ) & 0x07UL ) << 6UL;
+			ulAttributes |= ( ( ulSection >> 15UL ) & 0x07UL ) << 9UL;
+
+			for( ulIndex = 0; ulIndex < portL2_ENTRIES; ulIndex++ )
+			{
+				pulTable[ ulIndex ] = ( ulSection & ~( ( 1UL << portSECTION_SHIFT ) - 1UL ) ) | ( ulIndex << portPAGE_SHIFT ) | ulAttributes;
+				__asm volatile ( "mcr p15, 0, %0, c7, c10, 1" :: "r" ( &( pulTable[ ulIndex ] ) ) : "memory" );
+			}
+
+			ulPageTableAccess[ uxPageTablesUsed ] = ulAttributes & portL2_AP_MASK;
+			uxPageTablesUsed++;
+
+			/* Point the first level entry at the new table, keeping the
+			section's domain (bits 8:5) and NS (bit 19 -> bit 3) settings, then
+			remove the stale section mapping from the TLB. */
+			__asm volatile ( "dsb" ::: "memory" );
+			*pulL1Entry = ( ( uint32_t ) pulTable ) | ( ulSection & ( 0x0FUL << 5UL ) ) | ( ( ( ulSection >> 19UL ) & 0x01UL ) << 3UL ) | portL1_TYPE_COARSE;
+			__asm volatile ( "mcr p15, 0, %0, c7, c10, 1	\n"
+							 "dsb							\n"
+							 "mcr p15, 0, %1, c8, c7, 0	\n"
+							 "dsb							\n"
+							 "isb							\n"
+							 :: "r" ( pulL1Entry ), "r" ( 0 ) : "memory" );
+
+			pulReturn = &( pulTable[ ( ulAddress >> portPAGE_SHIFT ) & portL2_INDEX_MASK ] );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvSetGuardPage( uint32_t ulAddress, BaseType_t xGuard )
+	{
+	uint32_t *pulEntry;
+	BaseType_t xReturn = pdFALSE;
+
+		portENTER_CRITICAL();
+		{
+			pulEntry = prvGetPageTableEntry( ulAddress, xGuard );
+
+			if( pulEntry != NULL )
+			{
+				/* AP[2:0] == 0 denies all accesses.  When access is restored
+				the permissions the whole section had are used. */
+				*pulEntry &= ~portL2_AP_MASK;
+
+				if( xGuard == pdFALSE )
+				{
+					*pulEntry |= ulPageTableAccess[ ( ( uint32_t ) pulEntry - ( uint32_t ) ulPageTables ) / sizeof( ulPageTables[ 0 ] ) ];
+				}
+
+				/* Write the entry back to memory for the table walk, then
+				invalidate the TLB entry for the page. */
+				__asm volatile ( "mcr p15, 0, %0, c7, c10, 1	\n"
+								 "dsb							\n"
+								 "mcr p15, 0, %1, c8, c7, 1	\n"
+								 "dsb							\n"
+								 "isb							\n"
+								 :: "r" ( pulEntry ), "r" ( ulAddress & ~( ( 1UL << portPAGE_SHIFT ) - 1UL ) ) : "memory" );
+
+				xReturn = pdTRUE;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvIsGuardPage( uint32_t ulAddress )
+	{
+	uint32_t *pulEntry;
+	BaseType_t xReturn = pdFALSE;
+
+		pulEntry = prvGetPageTableEntry( ulAddress, pdFALSE );
+
+		if( ( pulEntry != NULL ) && ( ( *pulEntry & portL2_AP_MASK ) == 0UL ) )
+		{
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvIsGuardPageFault( uint32_t ulFaultStatus )
+	{
+	BaseType_t xReturn;
+
+		/* A guard page has AP[2:0] set to 0.  That is a permission fault, or
+		an access flag fault if SCTLR.AFE is set, as AP[0] is then the access
+		flag.  Guard pages are always mapped by second level tables, but the
+		section codes are accepted too as prvIsGuardPage() is the final
+		check. */
+		switch( ulFaultStatus & portDFSR_STATUS_MASK )
+		{
+			case portDFSR_PAGE_PERMISSION_FAULT		:
+			case portDFSR_SECTION_PERMISSION_FAULT	:
+			case portDFSR_PAGE_ACCESS_FLAG_FAULT	:
+			case portDFSR_SECTION_ACCESS_FLAG_FAULT	:
+				xReturn = pdTRUE;
+				break;
+
+			default									:
+				xReturn = pdFALSE;
+				break;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void *pvPortAllocateGuardedStack( size_t xStackSize, StackType_t *puxStackBuffer )
+	{
+	uint8_t *pucGuardPage;
+	void *pvReturn;
+
+		if( puxStackBuffer != NULL )
+		{
+			/* Stacks provided by the application are not guarded. */
+			pvReturn = ( void * ) puxStackBuffer;
+		}
+		else
+		{
+			/* The stack grows down, so the guard page is placed immediately
+			below the lowest address of the stack.  The guard page and the stack
+			are page aligned so the guard page covers nothing but itself. */
+			xStackSize = ( xStackSize + portPAGE_SIZE - 1UL ) & ~( portPAGE_SIZE - 1UL );
+			pucGuardPage = ( uint8_t * ) pvPortMallocAlignedBlock( xStackSize + portPAGE_SIZE, portPAGE_SIZE );
+
+			if( pucGuardPage != NULL )
+			{
+				pvReturn = ( void * ) ( pucGuardPage + portPAGE_SIZE );
+
+				if( prvSetGuardPage( ( uint32_t ) pucGuardPage, pdTRUE ) == pdFALSE )
+				{
+					/* The memory is not mapped in a way that allows a guard page
+					to be created, or configSTACK_GUARD_PAGE_TABLES is too low. */
+					configASSERT( pdFALSE );
+				}
+			}
+			else
+			{
+				pvReturn = NULL;
+			}
+		}
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortFreeGuardedStack( void *pvStack )
+	{
+	uint32_t ulGuardPage = ( uint32_t ) pvStack - portPAGE_SIZE;
+
+		if( pvStack != NULL )
+		{
+			if( ( ( ( uint32_t ) pvStack & ( portPAGE_SIZE - 1UL ) ) == 0UL ) && ( prvIsGuardPage( ulGuardPage ) != pdFALSE ) )
+			{
+				/* The block was allocated by pvPortAllocateGuardedStack().  The
+				guard page is at the start of the block so must be made
+				accessible again before the heap can reuse it. */
+				( void ) prvSetGuardPage( ulGuardPage, pdFALSE );
+				vPortFree( ( void * ) ulGuardPage );
+			}
+			else
+			{
+				vPortFree( pvStack );
+			}
+		}
+	}
+
+#endif /* configUSE_STACK_GUARD_PAGES */
+/*-----------------------------------------------------------*/
+
+void vPortCheckStackGuardFault( void )
+{
+	#if( configUSE_STACK_GUARD_PAGES == 1 )
+	{
+	uint32_t ulFaultStatus, ulFaultAddress;
+
+		__asm volatile ( "mrc p15, 0, %0, c5, c0, 0" : "=r" ( ulFaultStatus ) );
+		__asm volatile ( "mrc p15, 0, %0, c6, c0, 0" : "=r" ( ulFaultAddress ) );
+
+		/* A fault on a guard page means the running task has written past the
+		end of its stack.  The task cannot continue as the access that faulted
+		cannot be completed. */
+		if( ( prvIsGuardPageFault( ulFaultStatus ) != pdFALSE ) && ( prvIsGuardPage( ulFaultAddress ) != pdFALSE ) )
+		{
+			vApplicationStackGuardHook( xTaskGetCurrentTaskHandle(), pcTaskGetTaskName( NULL ) );
+
+			for( ;; );
+		}
+	}
+	#endif /* configUSE_STACK_GUARD_PAGES */
+}
+/*-----------------------------------------------------------*/
@@ -93,8 +93,17 @@ typedef portSTACK_TYPE StackType_t;
 typedef long BaseType_t;
 typedef unsigned long UBaseType_t;
 
-typedef uint32_t TickType_t;
-#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#if( configUSE_64_BIT_TICKS == 1 )
+	typedef uint64_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32-bit architecture, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -103,6 +112,10 @@ typedef uint32_t TickType_t;
 #define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT			8
 
+/* L1 data cache lines are 32 bytes on the Cortex-A9 and 64 bytes on the
+Cortex-A8, so 64 suits both. */
+#define portCACHE_LINE_SIZE			64
+
 /*-----------------------------------------------------------*/
 
 /* Task utilities. */
@@ -157,6 +170,35 @@ before any floating point instructions are executed. */
 void vPortTaskUsesFPU( void );
 #define portTASK_USES_FLOATING_POINT() vPortTaskUsesFPU()
 
+/* When configUSE_STACK_GUARD_PAGES is 1 each task stack is allocated on a 4KB
+page boundary, directly above a page that the MMU is configured to deny all
+access to.  A task that overflows its stack then causes a data abort instead of
+corrupting memory, and vPortCheckStackGuardFault() reports it by calling
+vApplicationStackGuardHook( TaskHandle_t xTask, char *pcTaskName ), which the
+application must provide.  The hook has the same prototype as
+vApplicationStackOverflowHook() but is separate from it, so it is needed
+whatever configCHECK_FOR_STACK_OVERFLOW is set to.  This has no cost on a
+context switch, so configCHECK_FOR_STACK_OVERFLOW can be set to 0.  Stacks use heap_4.c's
+pvPortMallocAlignedBlock() and are rounded up to a whole number of pages, so
+each task uses at least 8KB of heap.  The memory must be flat mapped, and the
+domain it is in must be set to client (not manager) access in the DACR, as
+manager access ignores the access permissions. */
+#ifndef configUSE_STACK_GUARD_PAGES
+	#define configUSE_STACK_GUARD_PAGES 0
+#endif
+
+#if( configUSE_STACK_GUARD_PAGES == 1 )
+	void *pvPortAllocateGuardedStack( size_t xStackSize, StackType_t *puxStackBuffer );
+	void vPortFreeGuardedStack( void *pvStack );
+	#define pvPortMallocAligned( x, puxStackBuffer ) pvPortAllocateGuardedStack( ( x ), ( puxStackBuffer ) )
+	#define vPortFreeAligned( pvBlockToFree ) vPortFreeGuardedStack( pvBlockToFree )
+#endif
+
+/* Must be called from the data abort handler before the application handles
+the abort.  Does not return if the abort was caused by a stack overflow into a
+guard page, otherwise returns without doing anything. */
+void vPortCheckStackGuardFault( void );
+
 #define portLOWEST_INTERRUPT_PRIORITY ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
 #define portLOWEST_USABLE_INTERRUPT_PRIORITY ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
 
@@ -173,6 +215,10 @@ void vPortTaskUsesFPU( void );
 
 #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
+/* Used by the generic ready priority bitmap (configUSE_READY_PRIORITY_BITMAP)
+in place of a portable search. */
+#define portGET_HIGHEST_SET_BIT( ulBitmap ) ( ( UBaseType_t ) ( 31 - __builtin_clz( ( uint32_t ) ( ulBitmap ) ) ) )
+
 #ifdef configASSERT
 	void vPortValidateInterruptPriority( void );
 	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID() 	vPortValidateInterruptPriority()
@@ -0,0 +1,594 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A deterministic, single threaded simulator port for POSIX hosts.
+ *
+ * Unlike the Win32 simulator, which runs each task in a native thread and
+ * generates the tick from a wall clock thread (prvSimulatedPeripheralTimer()),
+ * this port runs every task as a ucontext on a single host thread and drives
+ * the tick from virtual time:
+ *
+ * + While tasks are running the tick advances once every
+ *   configSIM_CALLS_PER_TICK kernel entries.
+ * + When every task is blocked the idle task enters tickless idle and the port
+ *   jumps the tick count straight to the next unblock time, so hours of
+ *   simulated time pass in milliseconds.
+ * + Application interrupts are raised at virtual times chosen by a seeded
+ *   pseudo random generator (see vPortSimInjectInterrupt()), so a run can be
+ *   reproduced exactly by reusing its seed.
+ *
+ * configUSE_TICKLESS_IDLE must be set to 1 in FreeRTOSConfig.h.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configUSE_TICKLESS_IDLE != 1
+	#error The virtual time simulator requires configUSE_TICKLESS_IDLE to be set to 1 in FreeRTOSConfig.h.
+#endif
+
+#define portMAX_INTERRUPTS				( ( uint32_t ) sizeof( uint32_t ) * 8UL ) /* The number of bits in an uint32_t. */
+#define portNO_CRITICAL_NESTING 		( ( uint32_t ) 0 )
+
+/*
+ * Each task executes on its own host stack as a ucontext.  The structure is
+ * allocated by the port, and a pointer to it is placed on the task's own stack
+ * so it can be located from the TCB.  The structures are also kept in a list,
+ * so the structure of a deleted task can be found after its stack has gone -
+ * the stack might have been provided by the application.
+ */
+typedef struct xTHREAD_STATE
+{
+	ucontext_t xContext;			/* Saved host context of the task. */
+	void *pvHostStack;				/* Host stack the context executes on. */
+	TaskFunction_t pxCode;			/* Task entry point. */
+	void *pvParameters;				/* Parameter passed to the entry point. */
+	uint32_t ulCriticalNesting;		/* Critical nesting depth while switched out. */
+	void *pvTCB;					/* The TCB of the task that owns the structure. */
+	struct xTHREAD_STATE *pxNext;	/* The next structure in the list of all the structures. */
+} xThreadState;
+
+/*
+ * Entry point of every task context.  Calls the task function, which must
+ * never return.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Process all the simulated interrupts - each represented by a bit in
+ * ulPendingInterrupts variable - then switch context if required.
+ */
+static void prvProcessSimulatedInterrupts( void );
+
+/*
+ * Interrupt handlers used by the kernel itself.
+ */
+static uint32_t prvProcessYieldInterrupt( void );
+static uint32_t prvProcessTickInterrupt( void );
+
+/*
+ * Called on each kernel entry made with interrupts enabled.  Pends a tick
+ * each time configSIM_CALLS_PER_TICK entries have been counted.
+ */
+static void prvCountKernelEntry( void );
+
+/*
+ * Raise any injected interrupts that are due at the current virtual time.
+ */
+static void prvCheckInjectedInterrupts( void );
+
+/*
+ * Pseudo random interval, in ticks, with a mean of approximately xMeanPeriod.
+ */
+static TickType_t prvRandomInterval( TickType_t xMeanPeriod );
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts waiting to be processed.  This is a bit mask where each
+bit represents one interrupt, so a maximum of 32 interrupts can be simulated. */
+static volatile uint32_t ulPendingInterrupts = 0UL;
+
+/* The critical nesting count for the currently executing task.  This is
+initialised to a non-zero value so interrupts do not become enabled during
+the initialisation phase. */
+static uint32_t ulCriticalNesting = 9999UL;
+
+/* Handlers for all the simulated software interrupts.  The first two positions
+are used for the Yield and Tick interrupts, all the other interrupts can be user
+defined. */
+static uint32_t (*ulIsrHandler[ portMAX_INTERRUPTS ])( void ) = { 0 };
+
+/* Virtual time at which each injected interrupt will next be raised, and the
+mean period between injections (0 if the interrupt is not injected). */
+static uint64_t ullNextInjection[ portMAX_INTERRUPTS ] = { 0 };
+static TickType_t xInjectionPeriod[ portMAX_INTERRUPTS ] = { 0 };
+
+/* Number of ticks that have elapsed since the scheduler started.  Unlike the
+kernel's tick count this never overflows. */
+static uint64_t ullVirtualTime = 0ULL;
+
+/* Kernel entries counted since the last tick was generated. */
+static uint32_t ulKernelEntries = 0UL;
+
+/* State of the xorshift generator used for interrupt injection. */
+static uint32_t ulRandomState = 0x2545F491UL;
+
+/* Context of the thread that called vTaskStartScheduler(), restored by
+vPortEndScheduler(). */
+static ucontext_t xSchedulerContext;
+
+/* Pointer to the TCB of the currently executing task. */
+extern void * volatile pxCurrentTCB;
+
+/* The list of the thread states of all the tasks that have been created and
+not yet cleaned up. */
+static xThreadState *pxThreadStates = NULL;
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static BaseType_t xPortRunning = pdFALSE;
+
+/* Set while simulated interrupt handlers are executing. */
+static BaseType_t xInsideInterrupt = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static xThreadState *prvGetThreadState( void *pvTCB )
+{
+StackType_t *pxTopOfStack;
+
+	/* The top of stack is the first member of the TCB, and the thread state
+	pointer is the only thing this port ever places on the task stack. */
+	pxTopOfStack = *( ( StackType_t ** ) pvTCB );
+	return ( xThreadState * ) *pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState;
+
+	pxThreadState = ( xThreadState * ) malloc( sizeof( xThreadState ) );
+	configASSERT( pxThreadState );
+
+	pxThreadState->pvHostStack = malloc( configSIM_HOST_STACK_SIZE );
+	configASSERT( pxThreadState->pvHostStack );
+
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+	pxThreadState->ulCriticalNesting = portNO_CRITICAL_NESTING;
+	pxThreadState->pvTCB = NULL;
+	pxThreadState->pxNext = NULL;
+
+	( void ) getcontext( &( pxThreadState->xContext ) );
+	pxThreadState->xContext.uc_stack.ss_sp = pxThreadState->pvHostStack;
+	pxThreadState->xContext.uc_stack.ss_size = configSIM_HOST_STACK_SIZE;
+	pxThreadState->xContext.uc_link = NULL;
+	makecontext( &( pxThreadState->xContext ), prvTaskEntry, 0 );
+
+	*pxTopOfStack = ( StackType_t ) pxThreadState;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+xThreadState *pxThreadState = prvGetThreadState( pxCurrentTCB );
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not attempt to return from their implementing function. */
+	configASSERT( pdFALSE );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+xThreadState *pxThreadState;
+
+	/* Install the interrupt handlers used by the scheduler itself. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	pxThreadState = prvGetThreadState( pxCurrentTCB );
+	ulCriticalNesting = pxThreadState->ulCriticalNesting;
+	xPortRunning = pdTRUE;
+
+	/* Start the first task.  This only returns if a task calls
+	vTaskEndScheduler(). */
+	( void ) swapcontext( &xSchedulerContext, &( pxThreadState->xContext ) );
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	xPortRunning = pdFALSE;
+	( void ) setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessTickInterrupt( void )
+{
+	ullVirtualTime++;
+	prvCheckInjectedInterrupts();
+
+	return ( uint32_t ) xTaskIncrementTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSimulatedInterrupts( void )
+{
+uint32_t ulSwitchRequired, i;
+void *pvOldCurrentTCB;
+xThreadState *pxOldThreadState, *pxNewThreadState;
+
+	while( ulPendingInterrupts != 0UL )
+	{
+		/* Handlers run with (simulated) interrupts disabled so API calls made
+		from them cannot recursively process interrupts. */
+		xInsideInterrupt = pdTRUE;
+		ulCriticalNesting++;
+		ulSwitchRequired = pdFALSE;
+
+		for( i = 0; i < portMAX_INTERRUPTS; i++ )
+		{
+			if( ( ulPendingInterrupts & ( 1UL << i ) ) != 0UL )
+			{
+				/* Clear the interrupt pending bit before running the handler
+				in case the handler raises the same interrupt again. */
+				ulPendingInterrupts &= ~( 1UL << i );
+
+				if( ulIsrHandler[ i ] != NULL )
+				{
+					if( ulIsrHandler[ i ]() != pdFALSE )
+					{
+						ulSwitchRequired = pdTRUE;
+					}
+				}
+			}
+		}
+
+		ulCriticalNesting--;
+		xInsideInterrupt = pdFALSE;
+
+		if( ulSwitchRequired != pdFALSE )
+		{
+			pvOldCurrentTCB = pxCurrentTCB;
+
+			/* Select the next task to run. */
+			vTaskSwitchContext();
+
+			/* If the task selected to enter the running state is not the task
+			that is already in the running state then swap host contexts.  This
+			call returns when the old task is next selected to run. */
+			if( pvOldCurrentTCB != pxCurrentTCB )
+			{
+				pxOldThreadState = prvGetThreadState( pvOldCurrentTCB );
+				pxNewThreadState = prvGetThreadState( pxCurrentTCB );
+
+				pxOldThreadState->ulCriticalNesting = ulCriticalNesting;
+				ulCriticalNesting = pxNewThreadState->ulCriticalNesting;
+
+				( void ) swapcontext( &( pxOldThreadState->xContext ), &( pxNewThreadState->xContext ) );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountKernelEntry( void )
+{
+	ulKernelEntries++;
+
+	if( ulKernelEntries >= configSIM_CALLS_PER_TICK )
+	{
+		ulKernelEntries = 0UL;
+		ulPendingInterrupts |= ( 1UL << portINTERRUPT_TICK );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckInjectedInterrupts( void )
+{
+uint32_t i;
+
+	for( i = portINTERRUPT_TICK + 1UL; i < portMAX_INTERRUPTS; i++ )
+	{
+		if( ( xInjectionPeriod[ i ] != ( TickType_t ) 0 ) && ( ullNextInjection[ i ] <= ullVirtualTime ) )
+		{
+			ulPendingInterrupts |= ( 1UL << i );
+			ullNextInjection[ i ] = ullVirtualTime + prvRandomInterval( xInjectionPeriod[ i ] );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvRandomInterval( TickType_t xMeanPeriod )
+{
+	/* xorshift32. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+
+	/* Uniform over [ 1, 2 * xMeanPeriod ]. */
+	return ( TickType_t ) ( 1UL + ( ulRandomState % ( 2UL * ( uint32_t ) xMeanPeriod ) ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+TickType_t xTicksToJump = xExpectedIdleTime;
+BaseType_t xInjecting = pdFALSE;
+eSleepModeStatus eSleepStatus;
+uint32_t i;
+
+	/* Called by the idle task, with the scheduler suspended, when there is
+	nothing to do until xExpectedIdleTime ticks have passed.  Don't jump past
+	the next injected interrupt. */
+	for( i = portINTERRUPT_TICK + 1UL; i < portMAX_INTERRUPTS; i++ )
+	{
+		if( xInjectionPeriod[ i ] != ( TickType_t ) 0 )
+		{
+			xInjecting = pdTRUE;
+
+			if( ( ullNextInjection[ i ] - ullVirtualTime ) < ( uint64_t ) xTicksToJump )
+			{
+				xTicksToJump = ( TickType_t ) ( ullNextInjection[ i ] - ullVirtualTime );
+			}
+		}
+	}
+
+	eSleepStatus = eTaskConfirmSleepModeStatus();
+
+	if( eSleepStatus == eAbortSleep )
+	{
+		/* A task was readied while the scheduler was suspended. */
+	}
+	else if( ( eSleepStatus == eNoTasksWaitingTimeout ) && ( xInjecting == pdFALSE ) )
+	{
+		/* Nothing can ever happen again, so the simulation is complete. */
+		vTaskEndScheduler();
+	}
+	else
+	{
+		/* Step to the tick before the wake time, then deliver the final tick
+		as a normal tick interrupt so the kernel unblocks the waiting task. */
+		if( xTicksToJump > ( TickType_t ) 1 )
+		{
+			vTaskStepTick( xTicksToJump - ( TickType_t ) 1 );
+			ullVirtualTime += ( uint64_t ) ( xTicksToJump - ( TickType_t ) 1 );
+		}
+
+		ulKernelEntries = 0UL;
+		ulPendingInterrupts |= ( 1UL << portINTERRUPT_TICK );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortIdleTaskIteration( void )
+{
+	/* The idle task never blocks, and when tickless idle is not entered (for
+	example because a task of idle priority is ready) it may not make any
+	kernel calls at all.  Count each pass through the idle loop as a kernel
+	entry so virtual time keeps moving and pending interrupts get processed. */
+	vPortEnterCritical();
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetupTCB( void *pvTCB )
+{
+xThreadState *pxThreadState;
+
+	/* The stack is known to be valid while the task is being created, so
+	record which TCB owns the thread state and add it to the list. */
+	pxThreadState = prvGetThreadState( pvTCB );
+	pxThreadState->pvTCB = pvTCB;
+	pxThreadState->pxNext = pxThreadStates;
+	pxThreadStates = pxThreadState;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDeleteThread( void *pvTaskToDelete )
+{
+xThreadState **ppxThreadState, *pxThreadState = NULL;
+
+	/* Only ever called for a task that is not running, so its host stack can
+	be freed.  The thread state is not located through the task's stack as the
+	task might have deleted itself, after which the application is free to
+	reuse a stack it provided. */
+	for( ppxThreadState = &pxThreadStates; *ppxThreadState != NULL; ppxThreadState = &( ( *ppxThreadState )->pxNext ) )
+	{
+		if( ( *ppxThreadState )->pvTCB == pvTaskToDelete )
+		{
+			pxThreadState = *ppxThreadState;
+			*ppxThreadState = pxThreadState->pxNext;
+			break;
+		}
+	}
+
+	configASSERT( pxThreadState );
+
+	free( pxThreadState->pvHostStack );
+	free( pxThreadState );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( xPortRunning );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		ulPendingInterrupts |= ( 1UL << ulInterruptNumber );
+
+		/* The simulated interrupt is now held pending, but don't actually
+		process it yet if this call is within a critical section or an
+		interrupt handler. */
+		if( ( ulCriticalNesting == portNO_CRITICAL_NESTING ) && ( xInsideInterrupt == pdFALSE ) )
+		{
+			prvCountKernelEntry();
+			prvProcessSimulatedInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimSetSeed( uint32_t ulSeed )
+{
+	/* xorshift must not be seeded with 0. */
+	ulRandomState = ( ulSeed != 0UL ) ? ulSeed : 0x2545F491UL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimInjectInterrupt( uint32_t ulInterruptNumber, TickType_t xMeanPeriod )
+{
+	configASSERT( ulInterruptNumber > portINTERRUPT_TICK );
+
+	if( ( ulInterruptNumber > portINTERRUPT_TICK ) && ( ulInterruptNumber < portMAX_INTERRUPTS ) )
+	{
+		vPortEnterCritical();
+		{
+			xInjectionPeriod[ ulInterruptNumber ] = xMeanPeriod;
+
+			if( xMeanPeriod != ( TickType_t ) 0 )
+			{
+				ullNextInjection[ ulInterruptNumber ] = ullVirtualTime + prvRandomInterval( xMeanPeriod );
+			}
+		}
+		vPortExitCritical();
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortSimGetVirtualTime( void )
+{
+uint64_t ullTime;
+
+	/* A pending tick has already reset the entry count, but has not yet
+	advanced ullVirtualTime. */
+	if( ( ulPendingInterrupts & ( 1UL << portINTERRUPT_TICK ) ) != 0UL )
+	{
+		ullTime = ( ullVirtualTime + 1ULL ) * ( uint64_t ) configSIM_CALLS_PER_TICK;
+	}
+	else
+	{
+		ullTime = ( ullVirtualTime * ( uint64_t ) configSIM_CALLS_PER_TICK ) + ( uint64_t ) ulKernelEntries;
+	}
+
+	return ullTime;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	ulCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		ulCriticalNesting--;
+
+		if( ( ulCriticalNesting == portNO_CRITICAL_NESTING ) && ( xPortRunning == pdTRUE ) && ( xInsideInterrupt == pdFALSE ) )
+		{
+			prvCountKernelEntry();
+
+			/* Were any interrupts set to pending while interrupts were
+			(simulated) disabled? */
+			if( ulPendingInterrupts != 0UL )
+			{
+				prvProcessSimulatedInterrupts();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
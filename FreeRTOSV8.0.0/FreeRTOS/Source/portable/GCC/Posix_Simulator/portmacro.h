@@ -0,0 +1,255 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the given hardware
+ * and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions.  The stack type is the width of a host pointer so the
+usStackDepth parameter passed to xTaskCreate() is still specified in words. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uintptr_t
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+	typedef uint64_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#endif
+
+/* Tick count reads are always atomic on a single host thread, but
+portTICK_TYPE_IS_ATOMIC is deliberately left at 0: virtual time advances with
+kernel entries (see configSIM_CALLS_PER_TICK), so a task polling
+xTaskGetTickCount() must still enter a critical section for the tick count to
+move. */
+
+/*-----------------------------------------------------------*/
+
+/* Hardware specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portCACHE_LINE_SIZE			64
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupt numbers.  The first two are used by the kernel itself,
+the remaining numbers (up to 31) can be installed by the application using
+vPortSetInterruptHandler(). */
+#define portINTERRUPT_YIELD				( 0UL )
+#define portINTERRUPT_TICK				( 1UL )
+
+/* Task utilities. */
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber );
+#define portYIELD()					vPortGenerateSimulatedInterrupt( portINTERRUPT_YIELD )
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( ( xSwitchRequired ) != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )		portEND_SWITCHING_ISR( x )
+
+/* Tasks run on host stacks that are allocated by the port, so the host stack
+has to be released when the TCB is freed.  The port records which TCB owns
+each host stack when the task is created. */
+void vPortSetupTCB( void *pvTCB );
+void vPortDeleteThread( void *pvTaskToDelete );
+#define portSETUP_TCB( pxTCB )		vPortSetupTCB( pxTCB )
+#define portCLEAN_UP_TCB( pxTCB )	vPortDeleteThread( pxTCB )
+
+/*-----------------------------------------------------------
+ * Critical section control
+ *----------------------------------------------------------*/
+
+void vPortEnterCritical( void );
+void vPortExitCritical( void );
+
+#define portDISABLE_INTERRUPTS()	vPortEnterCritical()
+#define portENABLE_INTERRUPTS()		vPortExitCritical()
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+
+/*-----------------------------------------------------------
+ * Tickless idle / virtual time
+ *----------------------------------------------------------*/
+
+/* When every task is blocked the idle task calls portSUPPRESS_TICKS_AND_SLEEP()
+and the simulator jumps virtual time straight to the next unblock time (or the
+next injected interrupt, whichever is first) instead of waiting for it. */
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* Called on every pass through the idle task loop so virtual time advances
+even if the idle task makes no other kernel calls. */
+void vPortIdleTaskIteration( void );
+#define portIDLE_TASK_ITERATION()	vPortIdleTaskIteration()
+
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/* Used by the generic ready priority bitmap (configUSE_READY_PRIORITY_BITMAP)
+in place of a portable search. */
+#define portGET_HIGHEST_SET_BIT( ulBitmap ) ( ( UBaseType_t ) ( 31 - __builtin_clz( ( uint32_t ) ( ulBitmap ) ) ) )
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+/*-----------------------------------------------------------
+ * Simulator control.
+ *----------------------------------------------------------*/
+
+/*
+ * Install an interrupt handler to be called when the simulated interrupt
+ * ulInterruptNumber is raised.  The interrupt number must be above any used by
+ * the kernel itself and lower than 32.  Interrupt handler functions must return
+ * a non-zero value if executing the handler resulted in a task switch being
+ * required.
+ */
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) );
+
+/*
+ * Seed the pseudo random generator used to inject interrupts.  Two runs that
+ * use the same seed and the same application produce identical schedules.
+ */
+void vPortSimSetSeed( uint32_t ulSeed );
+
+/*
+ * Raise interrupt ulInterruptNumber at pseudo random virtual times, with an
+ * average of one occurrence every xMeanPeriod ticks.  Passing 0 as xMeanPeriod
+ * stops the injection.
+ */
+void vPortSimInjectInterrupt( uint32_t ulInterruptNumber, TickType_t xMeanPeriod );
+
+/*
+ * The virtual time since the scheduler started, in units of
+ * 1 / configSIM_CALLS_PER_TICK of a tick - in effect a count of the kernel
+ * entries made.  Used to measure latencies shorter than a tick.  The value
+ * depends only on the work the tasks do, so it is the same on every run that
+ * uses the same seed.
+ */
+uint64_t ullPortSimGetVirtualTime( void );
+
+/*
+ * The number of kernel entries (critical section exits and yields) that are
+ * counted as one tick when tasks are running without blocking.  This is what
+ * makes time advance while the system is busy.
+ */
+#ifndef configSIM_CALLS_PER_TICK
+	#define configSIM_CALLS_PER_TICK	1000UL
+#endif
+
+/* Size in bytes of the host stack allocated to each task. */
+#ifndef configSIM_HOST_STACK_SIZE
+	#define configSIM_HOST_STACK_SIZE	( 64UL * 1024UL )
+#endif
+
+#ifdef __cplusplus
+	} /* extern C */
+#endif
+
+#endif /* PORTMACRO_H */
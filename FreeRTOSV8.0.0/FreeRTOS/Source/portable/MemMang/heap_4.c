@@ -68,6 +68,11 @@
  * (coalescences) adjacent memory blocks as they are freed, and in so doing
  * limits memory fragmentation.
  *
+ * pvPortMallocAlignedBlock() allocates a block that starts on a larger
+ * boundary than portBYTE_ALIGNMENT, for example a page aligned task stack.
+ * The space in front of the aligned block is returned to the free list, and
+ * the block is freed with vPortFree() as normal.
+ *
  * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
  * memory management pages of http://www.FreeRTOS.org for more information.
  */
@@ -291,6 +296,156 @@ void *pvReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
+void *pvPortMallocAlignedBlock( size_t xWantedSize, size_t xAlignment )
+{
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+uint8_t *pucAligned = NULL;
+size_t xLeadingBytes = 0;
+void *pvReturn = NULL;
+
+	/* The alignment must be a power of two, and at least the alignment that
+	all blocks are given anyway. */
+	configASSERT( ( xAlignment & ( xAlignment - ( size_t ) 1 ) ) == 0 );
+	configASSERT( xAlignment >= ( size_t ) portBYTE_ALIGNMENT );
+
+	vTaskSuspendAll();
+	{
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( ( xWantedSize & xBlockAllocatedBit ) == 0 ) && ( xWantedSize > 0 ) )
+		{
+			/* As per pvPortMalloc(), make room for the BlockLink_t structure
+			and keep the block size byte aligned. */
+			xWantedSize += heapSTRUCT_SIZE;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Traverse the list from the start (lowest address) block until one
+			is found that can hold the wanted size starting at an aligned
+			address. */
+			pxPreviousBlock = &xStart;
+			pxBlock = xStart.pxNextFreeBlock;
+			while( pxBlock != pxEnd )
+			{
+				pucAligned = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( ( ( uint8_t * ) pxBlock ) + heapSTRUCT_SIZE ) + ( xAlignment - ( size_t ) 1 ) ) & ~( ( portPOINTER_SIZE_TYPE ) xAlignment - ( portPOINTER_SIZE_TYPE ) 1 ) );
+				xLeadingBytes = ( size_t ) ( ( pucAligned - heapSTRUCT_SIZE ) - ( uint8_t * ) pxBlock );
+
+				/* Any space left in front of the aligned block is returned to
+				the free list, so must be large enough to be a block itself. */
+				while( ( xLeadingBytes != 0 ) && ( xLeadingBytes < heapMINIMUM_BLOCK_SIZE ) )
+				{
+					pucAligned += xAlignment;
+					xLeadingBytes += xAlignment;
+				}
+
+				if( ( xLeadingBytes + xWantedSize ) <= pxBlock->xBlockSize )
+				{
+					break;
+				}
+
+				pxPreviousBlock = pxBlock;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+
+			if( pxBlock != pxEnd )
+			{
+				/* This block is being used so must be taken out of the list of
+				free blocks. */
+				pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+				/* Split off the space in front of the aligned address and put
+				it back in the list of free blocks. */
+				if( xLeadingBytes != 0 )
+				{
+					pxNewBlockLink = ( void * ) ( pucAligned - heapSTRUCT_SIZE );
+					pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xLeadingBytes;
+					pxBlock->xBlockSize = xLeadingBytes;
+					prvInsertBlockIntoFreeList( pxBlock );
+					pxBlock = pxNewBlockLink;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* If the block is larger than required it can be split into
+				two, exactly as per pvPortMalloc(). */
+				if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+				{
+					pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+					pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxBlock->xBlockSize = xWantedSize;
+					prvInsertBlockIntoFreeList( ( pxNewBlockLink ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block is being returned - it is allocated and owned by
+				the application and has no "next" block.  It can be freed with
+				vPortFree() as normal. */
+				pxBlock->xBlockSize |= xBlockAllocatedBit;
+				pxBlock->pxNextFreeBlock = NULL;
+				pvReturn = ( void * ) pucAligned;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vPortFree( void *pv )
 {
 uint8_t *puc = ( uint8_t * ) pv;
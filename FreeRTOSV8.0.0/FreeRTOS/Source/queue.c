@@ -79,6 +79,14 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if ( configUSE_WAIT_SETS == 1 )
+	#include "waitset.h"
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -153,6 +161,14 @@ typedef struct QueueDefinition
 		struct QueueDefinition *pxQueueSetContainer;
 	#endif
 
+	#if ( configUSE_WAIT_SETS == 1 )
+		void *pvWaitSetMember;		/*< The wait set member record that references this queue, or NULL if the queue is not a member of a wait set. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the queue was created in memory provided by the application, so must not be freed when the queue is deleted.  StaticQueue_t in queue.h must be kept the same size as this structure. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -163,9 +179,10 @@ typedef xQUEUE Queue_t;
 
 /*
  * The queue registry is just a means for kernel aware debuggers to locate
- * queue structures.  It has no other purpose so is an optional component.
+ * queue structures.  It has no other purpose so is an optional component.  It
+ * is replaced by the object registry when configUSE_OBJECT_REGISTRY is 1.
  */
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_OBJECT_REGISTRY == 0 ) )
 
 	/* The type stored within the queue registry array.  This allows a name
 	to be assigned to each queue making kernel aware debugging a little
@@ -231,6 +248,27 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Initialises the members of a newly allocated queue, semaphore or mutex.
+ * pcQueueStorage is the area in which queued items are held.
+ */
+static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, int8_t *pcQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_MUTEXES == 1 )
+	/*
+	 * Initialises the members of a newly allocated mutex, then gives the mutex
+	 * so it starts in the available state.
+	 */
+	static void prvInitialiseMutex( const uint8_t ucQueueType, Queue_t *pxNewQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	/*
+	 * Copies the state of a queue, semaphore or mutex for the object registry.
+	 */
+	static void prvQueueGetSnapshot( void *pvQueue, ObjectSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -328,25 +366,13 @@ QueueHandle_t xReturn = NULL;
 			pxNewQueue->pcHead = ( int8_t * ) pvPortMalloc( xQueueSizeInBytes );
 			if( pxNewQueue->pcHead != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
-
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
 				}
-				#endif /* configUSE_TRACE_FACILITY */
+				#endif /* configSUPPORT_STATIC_ALLOCATION */
 
-				#if( configUSE_QUEUE_SETS == 1 )
-				{
-					pxNewQueue->pxQueueSetContainer = NULL;
-				}
-				#endif /* configUSE_QUEUE_SETS */
-
-				traceQUEUE_CREATE( pxNewQueue );
+				prvInitialiseNewQueue( uxQueueLength, uxItemSize, pxNewQueue->pcHead, ucQueueType, pxNewQueue );
 				xReturn = pxNewQueue;
 			}
 			else
@@ -371,58 +397,101 @@ QueueHandle_t xReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
-	QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+	QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue, const uint8_t ucQueueType )
 	{
 	Queue_t *pxNewQueue;
 
-		/* Prevent compiler warnings about unused parameters if
-		configUSE_TRACE_FACILITY does not equal 1. */
-		( void ) ucQueueType;
+		/* The application's StaticQueue_t must be able to hold a Queue_t. */
+		configASSERT( sizeof( StaticQueue_t ) == sizeof( Queue_t ) );
+		configASSERT( pxStaticQueue );
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
 
-		/* Allocate the new queue structure. */
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) );
-		if( pxNewQueue != NULL )
+		/* Storage is only optional if nothing is copied into the queue. */
+		configASSERT( ( pucQueueStorage != NULL ) || ( uxItemSize == ( UBaseType_t ) 0 ) );
+
+		pxNewQueue = ( Queue_t * ) pxStaticQueue; /*lint !e740 !e9087 StaticQueue_t is defined to match Queue_t. */
+		pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+		if( pucQueueStorage == NULL )
+		{
+			/* pcHead must not be NULL as that would mark the queue as a mutex,
+			so point it at the queue structure, which is never read from or
+			written to as the item size is 0. */
+			pucQueueStorage = ( uint8_t * ) pxNewQueue;
+		}
+		else
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->u.pcReadFrom = NULL;
+		prvInitialiseNewQueue( uxQueueLength, uxItemSize, ( int8_t * ) pucQueueStorage, ucQueueType, pxNewQueue );
 
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
-			pxNewQueue->uxLength = ( UBaseType_t ) 1U;
-			pxNewQueue->uxItemSize = ( UBaseType_t ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
+		return pxNewQueue;
+	}
 
-			#if ( configUSE_TRACE_FACILITY == 1 )
-			{
-				pxNewQueue->ucQueueType = ucQueueType;
-			}
-			#endif
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-			#if ( configUSE_QUEUE_SETS == 1 )
-			{
-				pxNewQueue->pxQueueSetContainer = NULL;
-			}
-			#endif
+static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, int8_t *pcQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue )
+{
+	/* Remove compiler warnings about unused parameters should
+	configUSE_TRACE_FACILITY not be set to 1. */
+	( void ) ucQueueType;
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+	/* Initialise the queue members as described above where the queue type
+	is defined. */
+	pxNewQueue->pcHead = pcQueueStorage;
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxNewQueue->ucQueueType = ucQueueType;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	#if( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	#if( configUSE_WAIT_SETS == 1 )
+	{
+		pxNewQueue->pvWaitSetMember = NULL;
+	}
+	#endif /* configUSE_WAIT_SETS */
+
+	#if( configUSE_OBJECT_REGISTRY == 1 )
+	{
+		( void ) xObjectRegistryAdd( pxNewQueue, registryTYPE_FROM_QUEUE_TYPE( ucQueueType ), NULL, prvQueueGetSnapshot );
+	}
+	#endif /* configUSE_OBJECT_REGISTRY */
+
+	traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+	{
+	Queue_t *pxNewQueue;
 
-			traceCREATE_MUTEX( pxNewQueue );
+		/* Allocate the new queue structure. */
+		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) );
+		if( pxNewQueue != NULL )
+		{
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
-			/* Start with the semaphore in the expected state. */
-			( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+			prvInitialiseMutex( ucQueueType, pxNewQueue );
 		}
 		else
 		{
@@ -436,6 +505,89 @@ QueueHandle_t xReturn = NULL;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue )
+	{
+	Queue_t *pxNewQueue;
+
+		/* The application's StaticQueue_t must be able to hold a Queue_t. */
+		configASSERT( sizeof( StaticQueue_t ) == sizeof( Queue_t ) );
+		configASSERT( pxStaticQueue );
+
+		pxNewQueue = ( Queue_t * ) pxStaticQueue; /*lint !e740 !e9087 StaticQueue_t is defined to match Queue_t. */
+		pxNewQueue->ucStaticallyAllocated = pdTRUE;
+		prvInitialiseMutex( ucQueueType, pxNewQueue );
+
+		return pxNewQueue;
+	}
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( const uint8_t ucQueueType, Queue_t *pxNewQueue )
+	{
+		/* Prevent compiler warnings about unused parameters if
+		configUSE_TRACE_FACILITY does not equal 1. */
+		( void ) ucQueueType;
+
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->u.pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
+		pxNewQueue->uxLength = ( UBaseType_t ) 1U;
+		pxNewQueue->uxItemSize = ( UBaseType_t ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxNewQueue->ucQueueType = ucQueueType;
+		}
+		#endif
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			pxNewQueue->pxQueueSetContainer = NULL;
+		}
+		#endif
+
+		#if ( configUSE_WAIT_SETS == 1 )
+		{
+			pxNewQueue->pvWaitSetMember = NULL;
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		#if ( configUSE_OBJECT_REGISTRY == 1 )
+		{
+			( void ) xObjectRegistryAdd( pxNewQueue, registryTYPE_FROM_QUEUE_TYPE( ucQueueType ), NULL, prvQueueGetSnapshot );
+		}
+		#endif
+
+		traceCREATE_MUTEX( pxNewQueue );
+
+		/* Start with the semaphore in the expected state. */
+		( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
 	void* xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -689,6 +841,28 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				}
 				#endif /* configUSE_QUEUE_SETS */
 
+				#if ( configUSE_WAIT_SETS == 1 )
+				{
+					if( pxQueue->pvWaitSetMember != NULL )
+					{
+						if( xWaitSetSignalMember( pxQueue->pvWaitSetMember, ( EventBits_t ) 0 ) != pdFALSE )
+						{
+							/* The queue is a member of a wait set, and a
+							higher priority task was blocked on the wait set. */
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_WAIT_SETS */
+
 				taskEXIT_CRITICAL();
 
 				/* Return to the original privilege level before exiting the
@@ -819,6 +993,29 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						mtCOVERAGE_TEST_MARKER();
 					}
 
+					#if ( configUSE_WAIT_SETS == 1 )
+					{
+						if( pxQueue->pvWaitSetMember != NULL )
+						{
+							if( xWaitSetSignalMember( pxQueue->pvWaitSetMember, ( EventBits_t ) 0 ) != pdFALSE )
+							{
+								/* The queue is a member of a wait set, and a
+								higher priority task was blocked on the wait
+								set. */
+								portYIELD_WITHIN_API();
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_WAIT_SETS */
+
 					taskEXIT_CRITICAL();
 					return pdPASS;
 				}
@@ -1152,6 +1349,36 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				++( pxQueue->xTxLock );
 			}
 
+			#if ( configUSE_WAIT_SETS == 1 )
+			{
+				/* The wait set's lists are only ever accessed with interrupts
+				masked, so unlike the queue's own event lists they can be
+				updated even when the queue is locked. */
+				if( pxQueue->pvWaitSetMember != NULL )
+				{
+					if( xWaitSetSignalMember( pxQueue->pvWaitSetMember, ( EventBits_t ) 0 ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_WAIT_SETS */
+
 			xReturn = pdPASS;
 		}
 		else
@@ -1548,16 +1775,53 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( pxQueue );
 
 	traceQUEUE_DELETE( pxQueue );
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	#if ( configUSE_OBJECT_REGISTRY == 1 )
+	{
+		vObjectRegistryRemove( pxQueue );
+	}
+	#elif ( configQUEUE_REGISTRY_SIZE > 0 )
 	{
 		vQueueUnregisterQueue( pxQueue );
 	}
 	#endif
-	if( pxQueue->pcHead != NULL )
+	#if ( configUSE_WAIT_SETS == 1 )
+	{
+		if( pxQueue->pvWaitSetMember != NULL )
+		{
+			vWaitSetDetachMember( pxQueue->pvWaitSetMember );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* The memory used by a statically allocated queue belongs to the
+		application. */
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			if( pxQueue->pcHead != NULL )
+			{
+				vPortFree( pxQueue->pcHead );
+			}
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
 	{
-		vPortFree( pxQueue->pcHead );
+		if( pxQueue->pcHead != NULL )
+		{
+			vPortFree( pxQueue->pcHead );
+		}
+		vPortFree( pxQueue );
 	}
-	vPortFree( pxQueue );
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
 }
 /*-----------------------------------------------------------*/
 
@@ -2151,7 +2415,7 @@ BaseType_t xReturn;
 #endif /* configUSE_CO_ROUTINES */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_OBJECT_REGISTRY == 0 ) )
 
 	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	{
@@ -2180,7 +2444,7 @@ BaseType_t xReturn;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_OBJECT_REGISTRY == 0 ) )
 
 	void vQueueUnregisterQueue( QueueHandle_t xQueue )
 	{
@@ -2207,6 +2471,74 @@ BaseType_t xReturn;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+		/* The queue was added to the object registry when it was created, so
+		only the name needs to be set. */
+		if( xObjectRegistrySetName( xQueue, pcQueueName ) != pdFAIL )
+		{
+			traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	void vQueueUnregisterQueue( QueueHandle_t xQueue )
+	{
+		/* The queue stays in the object registry until it is deleted, but is
+		no longer named. */
+		( void ) xObjectRegistrySetName( xQueue, NULL );
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	static void prvQueueGetSnapshot( void *pvQueue, ObjectSnapshot_t *pxSnapshot )
+	{
+	const Queue_t * const pxQueue = ( const Queue_t * ) pvQueue;
+
+		pxSnapshot->uxLevel = pxQueue->uxMessagesWaiting;
+		pxSnapshot->uxCapacity = pxQueue->uxLength;
+		pxSnapshot->uxWaitingToSend = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) );
+		pxSnapshot->uxWaitingToReceive = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) );
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				pxSnapshot->pvOwner = ( void * ) pxQueue->pxMutexHolder;
+
+				if( pxSnapshot->ucType == registryTYPE_RECURSIVE_MUTEX )
+				{
+					pxSnapshot->xValue = ( TickType_t ) pxQueue->u.uxRecursiveCallCount;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MUTEXES */
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
 	void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait )
@@ -2278,8 +2610,31 @@ BaseType_t xReturn;
 			}
 			else
 			{
-				( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
 				xReturn = pdPASS;
+
+				#if ( configUSE_WAIT_SETS == 1 )
+				{
+					if( ( ( Queue_t * ) xQueueOrSemaphore )->pvWaitSetMember != NULL )
+					{
+						/* Cannot add a queue/semaphore to a queue set if it is
+						already a member of a wait set. */
+						xReturn = pdFAIL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_WAIT_SETS */
+
+				if( xReturn == pdPASS )
+				{
+					( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
 		taskEXIT_CRITICAL();
@@ -2395,6 +2750,59 @@ BaseType_t xReturn;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAIT_SETS == 1 )
+
+	BaseType_t xQueueAttachWaitSetMember( QueueHandle_t xQueue, void *pvWaitSetMember )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+	BaseType_t xReturn = pdPASS;
+
+		configASSERT( pxQueue );
+
+		/* Called by waitset.c with interrupts masked.  A NULL
+		pvWaitSetMember removes the queue from its wait set. */
+		if( pvWaitSetMember == NULL )
+		{
+			pxQueue->pvWaitSetMember = NULL;
+		}
+		else if( pxQueue->pvWaitSetMember != NULL )
+		{
+			/* Cannot add a queue/semaphore to more than one wait set. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					/* Cannot add a queue/semaphore to a wait set if it is
+					already a member of a queue set. */
+					xReturn = pdFAIL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
+			if( xReturn == pdPASS )
+			{
+				pxQueue->pvWaitSetMember = pvWaitSetMember;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_WAIT_SETS */
 
 
 
@@ -0,0 +1,411 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "registry.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not
+configured to include the object registry. */
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+#define registryINDEX_MASK		( ( UBaseType_t ) configOBJECT_REGISTRY_SIZE - ( UBaseType_t ) 1U )
+
+/* Returned by prvFindEntry() if the object is not registered. */
+#define registryNOT_FOUND		( ( UBaseType_t ) configOBJECT_REGISTRY_SIZE )
+
+/* One registered object. */
+typedef struct xREGISTRY_ENTRY
+{
+	void *pvObject;									/*< The handle of the object, or NULL if the entry is not in use. */
+	const char *pcName;								/*< The name of the object, or NULL. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	RegistrySnapshotFunction_t pxSnapshotFunction;	/*< Copies the state of the object into an ObjectSnapshot_t. */
+	uint8_t ucType;									/*< One of the registryTYPE_ values. */
+} RegistryEntry_t;
+
+/* The registry is an open addressed hash table indexed by object handle, and
+collisions are resolved by linear probing.  Registered objects never move, so
+a snapshot taken in several calls sees every object that exists for the
+whole of the snapshot exactly once.  An entry that is removed from the middle
+of a run of used entries is therefore marked as deleted, rather than moving
+later entries back, so searches for the later entries still find them.
+Deleted entries are reused by later objects, and become unused once they are
+at the end of a run.  A search ends at the first unused entry, so at least
+one entry is always left unused - deleted entries count towards the capacity
+of the registry until they become unused. */
+PRIVILEGED_DATA static RegistryEntry_t xRegistry[ configOBJECT_REGISTRY_SIZE ];
+PRIVILEGED_DATA static UBaseType_t uxRegisteredObjects = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static UBaseType_t uxDeletedEntries = ( UBaseType_t ) 0U;
+
+/* The pvObject value of a deleted entry.  The address of the registry itself
+is never the handle of an object. */
+#define registryDELETED			( ( void * ) xRegistry )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the entry at which a search for pvObject starts.
+ */
+static UBaseType_t prvHash( const void * const pvObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the entry that holds pvObject, or registryNOT_FOUND if
+ * pvObject is not registered.  Must be called from a critical section.
+ */
+static UBaseType_t prvFindEntry( const void * const pvObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the state of the object held in pxEntry.  Must be called from a
+ * critical section.
+ */
+static void prvCopyEntry( const RegistryEntry_t * const pxEntry, ObjectSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xObjectRegistryAdd( void *pvObject, const uint8_t ucType, const char *pcName, RegistrySnapshotFunction_t pxSnapshotFunction ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+UBaseType_t uxEntry;
+BaseType_t xReturn;
+
+	configASSERT( pvObject );
+	configASSERT( pxSnapshotFunction );
+
+	taskENTER_CRITICAL();
+	{
+		/* Use the first free entry in the object's run.  Reusing a deleted
+		entry leaves the number of unused entries unchanged so is always
+		possible, but an unused entry can only be taken if another one
+		remains. */
+		uxEntry = prvHash( pvObject );
+
+		while( ( xRegistry[ uxEntry ].pvObject != NULL ) && ( xRegistry[ uxEntry ].pvObject != registryDELETED ) )
+		{
+			uxEntry = ( uxEntry + ( UBaseType_t ) 1U ) & registryINDEX_MASK;
+		}
+
+		if( xRegistry[ uxEntry ].pvObject == registryDELETED )
+		{
+			uxDeletedEntries--;
+			xReturn = pdPASS;
+		}
+		else if( ( uxRegisteredObjects + uxDeletedEntries ) < registryINDEX_MASK )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		if( xReturn != pdFAIL )
+		{
+			xRegistry[ uxEntry ].pcName = pcName;
+			xRegistry[ uxEntry ].pxSnapshotFunction = pxSnapshotFunction;
+			xRegistry[ uxEntry ].ucType = ucType;
+			xRegistry[ uxEntry ].pvObject = pvObject;
+			uxRegisteredObjects++;
+		}
+		else
+		{
+			/* The object still works, but cannot be found in the registry. */
+			traceOBJECT_REGISTRY_FULL( pvObject );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vObjectRegistryRemove( void *pvObject )
+{
+UBaseType_t uxEntry;
+
+	taskENTER_CRITICAL();
+	{
+		uxEntry = prvFindEntry( pvObject );
+
+		if( uxEntry != registryNOT_FOUND )
+		{
+			xRegistry[ uxEntry ].pvObject = registryDELETED;
+			uxRegisteredObjects--;
+			uxDeletedEntries++;
+
+			/* Deleted entries at the end of a run are not needed to find any
+			other entry, so become unused. */
+			while( ( xRegistry[ uxEntry ].pvObject == registryDELETED ) && ( xRegistry[ ( uxEntry + ( UBaseType_t ) 1U ) & registryINDEX_MASK ].pvObject == NULL ) )
+			{
+				xRegistry[ uxEntry ].pvObject = NULL;
+				uxDeletedEntries--;
+				uxEntry = ( uxEntry - ( UBaseType_t ) 1U ) & registryINDEX_MASK;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xObjectRegistrySetName( void *pvObject, const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+UBaseType_t uxEntry;
+BaseType_t xReturn = pdFAIL;
+
+	taskENTER_CRITICAL();
+	{
+		uxEntry = prvFindEntry( pvObject );
+
+		if( uxEntry != registryNOT_FOUND )
+		{
+			xRegistry[ uxEntry ].pcName = pcName;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t ucObjectRegistryGetType( void *pvObject )
+{
+UBaseType_t uxEntry;
+uint8_t ucReturn = registryTYPE_NONE;
+
+	taskENTER_CRITICAL();
+	{
+		uxEntry = prvFindEntry( pvObject );
+
+		if( uxEntry != registryNOT_FOUND )
+		{
+			ucReturn = xRegistry[ uxEntry ].ucType;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ucReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xObjectRegistryGetSnapshot( void *pvObject, ObjectSnapshot_t *pxSnapshot )
+{
+UBaseType_t uxEntry;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxSnapshot );
+
+	taskENTER_CRITICAL();
+	{
+		uxEntry = prvFindEntry( pvObject );
+
+		if( uxEntry != registryNOT_FOUND )
+		{
+			prvCopyEntry( &( xRegistry[ uxEntry ] ), pxSnapshot );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxObjectRegistrySnapshot( ObjectSnapshot_t * const pxSnapshots, const UBaseType_t uxMaxSnapshots, UBaseType_t * const puxNextEntry )
+{
+UBaseType_t uxEntry, uxCopied = ( UBaseType_t ) 0U;
+
+	configASSERT( pxSnapshots );
+	configASSERT( puxNextEntry );
+
+	uxEntry = *puxNextEntry;
+
+	while( ( uxEntry < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE ) && ( uxCopied < uxMaxSnapshots ) )
+	{
+		/* Unused and deleted entries are skipped without entering a critical
+		section.  Reading a pointer is atomic, and the entry is checked again
+		inside the critical section before it is used. */
+		if( ( xRegistry[ uxEntry ].pvObject != NULL ) && ( xRegistry[ uxEntry ].pvObject != registryDELETED ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( xRegistry[ uxEntry ].pvObject != NULL ) && ( xRegistry[ uxEntry ].pvObject != registryDELETED ) )
+				{
+					prvCopyEntry( &( xRegistry[ uxEntry ] ), &( pxSnapshots[ uxCopied ] ) );
+					uxCopied++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxEntry++;
+	}
+
+	*puxNextEntry = uxEntry;
+
+	return uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHash( const void * const pvObject )
+{
+uint32_t ulHash;
+
+	/* Objects are allocated on at least an eight byte boundary on most ports,
+	so the lowest bits carry little information.  The remaining bits are
+	mixed so objects that are allocated close together do not land in
+	adjacent entries. */
+	ulHash = ( uint32_t ) ( ( ( portPOINTER_SIZE_TYPE ) pvObject ) >> 3U );
+	ulHash ^= ulHash >> 16U;
+	ulHash *= 0x45d9f3bUL;
+	ulHash ^= ulHash >> 16U;
+
+	return ( UBaseType_t ) ulHash & registryINDEX_MASK;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindEntry( const void * const pvObject )
+{
+UBaseType_t uxEntry, uxReturn = registryNOT_FOUND;
+
+	if( pvObject != NULL )
+	{
+		uxEntry = prvHash( pvObject );
+
+		while( xRegistry[ uxEntry ].pvObject != NULL )
+		{
+			if( xRegistry[ uxEntry ].pvObject == pvObject )
+			{
+				uxReturn = uxEntry;
+				break;
+			}
+			else
+			{
+				uxEntry = ( uxEntry + ( UBaseType_t ) 1U ) & registryINDEX_MASK;
+			}
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyEntry( const RegistryEntry_t * const pxEntry, ObjectSnapshot_t * const pxSnapshot )
+{
+	pxSnapshot->pvObject = pxEntry->pvObject;
+	pxSnapshot->pcName = pxEntry->pcName;
+	pxSnapshot->pvOwner = NULL;
+	pxSnapshot->xValue = ( TickType_t ) 0U;
+	pxSnapshot->uxLevel = ( UBaseType_t ) 0U;
+	pxSnapshot->uxCapacity = ( UBaseType_t ) 0U;
+	pxSnapshot->uxWaitingToSend = ( UBaseType_t ) 0U;
+	pxSnapshot->uxWaitingToReceive = ( UBaseType_t ) 0U;
+	pxSnapshot->ucType = pxEntry->ucType;
+	pxSnapshot->ucState = ( uint8_t ) 0U;
+
+	/* The file that defines the object fills in the rest. */
+	pxEntry->pxSnapshotFunction( pxEntry->pvObject, pxSnapshot );
+}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+
@@ -76,8 +76,13 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "tick_timers.h"
 #include "StackMacros.h"
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -112,6 +117,45 @@ privileged Vs unprivileged linkage and placement. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if ( configSPLIT_TCB == 1 )
+
+	/*
+	 * The members of a task control block that are not needed to select or
+	 * switch to the task.  When configSPLIT_TCB is 1 they are allocated
+	 * separately from the TCB so the TCB itself fits in fewer cache lines.
+	 */
+	typedef struct tskTaskControlBlockCold
+	{
+		char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+		void				*pvTCBAllocation;	/*< The block of memory the TCB was allocated from, which can start before the TCB as the TCB is aligned to a cache line. */
+
+		#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+			uint16_t		usStackHighWaterMark;	/*< The number of words at the end of the stack found to be unused by the last high water mark check.  Later checks resume from here. */
+			uint16_t		usStackScanIndex;		/*< The next word below usStackHighWaterMark to be checked again, used when the check is bounded by configSTACK_HIGH_WATER_MARK_SCAN_WORDS. */
+		#endif
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+			UBaseType_t		uxTCBNumber;		/*< Stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
+			UBaseType_t  	uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
+		#endif
+
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+			/* See the description of the same member of tskTCB. */
+			struct 	_reent xNewLib_reent;
+		#endif
+
+		#if ( configUSE_TASK_POOL == 1 )
+			UBaseType_t		uxPoolBucket;		/*< The task pool bucket the TCB and stack are returned to when the task is deleted, or tskNOT_POOLED if they are freed instead. */
+		#endif
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			uint8_t			ucStaticStack;		/*< Set to pdTRUE if the stack was provided by the application, so must not be freed when the task is deleted. */
+		#endif
+
+	} TCBCold_t;
+
+#endif /* configSPLIT_TCB */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -129,7 +173,12 @@ typedef struct tskTaskControlBlock
 	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
 	StackType_t			*pxStack;			/*< Points to the start of the stack. */
-	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+	#if ( configSPLIT_TCB == 1 )
+		TCBCold_t		*pxCold;			/*< The members that are not needed to select or switch to the task. */
+	#else
+		char			pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	#endif
 
 	#if ( portSTACK_GROWTH > 0 )
 		StackType_t		*pxEndOfStack;		/*< Points to the end of the stack on architectures where the stack grows up from low memory. */
@@ -139,7 +188,12 @@ typedef struct tskTaskControlBlock
 		UBaseType_t 	uxCriticalNesting; 	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
 	#endif
 
-	#if ( configUSE_TRACE_FACILITY == 1 )
+	#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && ( configSPLIT_TCB == 0 ) )
+		uint16_t		usStackHighWaterMark;	/*< The number of words at the end of the stack found to be unused by the last high water mark check.  Later checks resume from here. */
+		uint16_t		usStackScanIndex;		/*< The next word below usStackHighWaterMark to be checked again, used when the check is bounded by configSTACK_HIGH_WATER_MARK_SCAN_WORDS. */
+	#endif
+
+	#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configSPLIT_TCB == 0 ) )
 		UBaseType_t		uxTCBNumber;		/*< Stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
 		UBaseType_t  	uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
 	#endif
@@ -156,7 +210,7 @@ typedef struct tskTaskControlBlock
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
-	#if ( configUSE_NEWLIB_REENTRANT == 1 )
+	#if ( ( configUSE_NEWLIB_REENTRANT == 1 ) && ( configSPLIT_TCB == 0 ) )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
 		used by the FreeRTOS maintainers themselves.  FreeRTOS is not
@@ -167,12 +221,30 @@ typedef struct tskTaskControlBlock
 		struct 	_reent xNewLib_reent;
 	#endif
 
+	#if ( ( configUSE_TASK_POOL == 1 ) && ( configSPLIT_TCB == 0 ) )
+		UBaseType_t		uxPoolBucket;		/*< The task pool bucket the TCB and stack are returned to when the task is deleted, or tskNOT_POOLED if they are freed instead. */
+	#endif
+
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSPLIT_TCB == 0 ) )
+		uint8_t			ucStaticStack;		/*< Set to pdTRUE if the stack was provided by the application, so must not be freed when the task is deleted. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/*
+ * Returns a pointer to the structure that holds the members of pxTCB that are
+ * moved out of the TCB when configSPLIT_TCB is 1, such as pcTaskName.
+ */
+#if ( configSPLIT_TCB == 1 )
+	#define taskCOLD( pxTCB )	( ( pxTCB )->pxCold )
+#else
+	#define taskCOLD( pxTCB )	( pxTCB )
+#endif
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to to
  * be global, rather than file scope.
@@ -199,6 +271,10 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
 	PRIVILEGED_DATA static volatile UBaseType_t uxTasksDeleted = ( UBaseType_t ) 0U;
 
+	#if ( configUSE_TASK_RECLAIMER == 1 )
+		PRIVILEGED_DATA static List_t xTaskReclaimerWaitList;			/*< Holds the reclaimer task while there is nothing for it to do. */
+	#endif
+
 #endif
 
 #if ( INCLUDE_vTaskSuspend == 1 )
@@ -224,6 +300,19 @@ PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= portMAX_DELAY;
 
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+	/* Two level bitmap of the priorities that have tasks in the Ready state.
+	Bit n of ulReadyPriorityBitmap[ g ] is set when priority ( g * 32 ) + n has
+	a ready task, and bit g of ulReadyPriorityGroups is set when any bit of
+	ulReadyPriorityBitmap[ g ] is set. */
+	#define taskREADY_PRIORITY_GROUPS	( ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 31U ) >> 5U )
+
+	PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0UL;
+	PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityBitmap[ taskREADY_PRIORITY_GROUPS ] = { 0UL };
+
+#endif
+
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
 lists the xStateListItem can be referenced from, if the scheduler is suspended.
@@ -251,6 +340,12 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
  */
 #define tskSTACK_FILL_BYTE	( 0xa5U )
 
+/*
+ * tskSTACK_FILL_BYTE repeated to fill a whole stack word, so the high water
+ * mark can be found a word at a time.
+ */
+#define tskSTACK_FILL_WORD	( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE ) )
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -261,7 +356,7 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -301,6 +396,64 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 	#define taskRESET_READY_PRIORITY( uxPriority )
 	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+	/* If configUSE_READY_PRIORITY_BITMAP is 1 then task selection uses a
+	generic two level bitmap.  The cost of finding the highest priority ready
+	task is two highest-set-bit searches whatever the number of priorities, so
+	configMAX_PRIORITIES can be larger than the number of bits in a word. */
+
+	/* Ports that have a count leading zeros instruction can define
+	portGET_HIGHEST_SET_BIT() to use it.  Otherwise a portable search is used. */
+	#ifdef portGET_HIGHEST_SET_BIT
+		#define taskGET_HIGHEST_SET_BIT( ulBitmap ) portGET_HIGHEST_SET_BIT( ulBitmap )
+	#else
+		#define taskGET_HIGHEST_SET_BIT( ulBitmap ) prvGetHighestSetBit( ulBitmap )
+	#endif
+
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		ulReadyPriorityBitmap[ ( uxPriority ) >> 5U ] |= ( 1UL << ( ( uxPriority ) & 0x1fU ) );			\
+		ulReadyPriorityGroups |= ( 1UL << ( ( uxPriority ) >> 5U ) );									\
+	} /* taskRECORD_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+	UBaseType_t uxTopGroup, uxTopPriority;																\
+																										\
+		/* The idle task is always ready so there is always a bit set. */								\
+		configASSERT( ulReadyPriorityGroups != 0UL );													\
+		uxTopGroup = taskGET_HIGHEST_SET_BIT( ulReadyPriorityGroups );									\
+		uxTopPriority = ( uxTopGroup << 5U ) + taskGET_HIGHEST_SET_BIT( ulReadyPriorityBitmap[ uxTopGroup ] );	\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+	/*-----------------------------------------------------------*/
+
+	/* Clear the bit for a priority that no longer has any ready tasks, and the
+	group bit if that was the last ready priority in its group.  The second
+	parameter is unused, it is kept so the macro can be called from the same
+	places as the port optimised version. */
+	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )									\
+	{																									\
+		ulReadyPriorityBitmap[ ( uxPriority ) >> 5U ] &= ~( 1UL << ( ( uxPriority ) & 0x1fU ) );		\
+		if( ulReadyPriorityBitmap[ ( uxPriority ) >> 5U ] == 0UL )										\
+		{																								\
+			ulReadyPriorityGroups &= ~( 1UL << ( ( uxPriority ) >> 5U ) );								\
+		}																								\
+	}
+
+	#define taskRESET_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == 0 )					\
+		{																								\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+		}																								\
+	}
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -340,7 +493,8 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 /*-----------------------------------------------------------*/
 
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
+count overflows.  A 64 bit tick count never overflows, so then
+pxOverflowDelayedTaskList is never used. */
 #define taskSWITCH_DELAYED_LISTS()																	\
 {																									\
 	List_t *pxTemp;																					\
@@ -443,6 +597,40 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
 	static void prvDeleteTCB( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
 
+	/*
+	 * Free the stack of a task that is being deleted, unless the stack was
+	 * provided by the application when the task was created.
+	 */
+	static void prvFreeStack( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	/*
+	 * Copies the state of a task for the object registry.
+	 */
+	static void prvTaskGetSnapshot( void *pvTask, ObjectSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_POOL == 1 )
+
+	/* TCB and stack pairs of deleted tasks, kept for reuse instead of being
+	freed.  Bucket n holds stacks of configMINIMAL_STACK_SIZE << n words.  While
+	a TCB is in the pool the value of its xGenericListItem is pdTRUE if its
+	stack has been refilled with tskSTACK_FILL_BYTE since it was last used. */
+	PRIVILEGED_DATA static List_t xTaskPool[ configTASK_POOL_BUCKETS ];
+	PRIVILEGED_DATA static BaseType_t xTaskPoolInitialised = pdFALSE;
+
+	/* Value held in the uxPoolBucket member of a TCB that is not returned to
+	the task pool when its task is deleted. */
+	#define tskNOT_POOLED		( ( UBaseType_t ) configTASK_POOL_BUCKETS )
+
+	#if ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+		PRIVILEGED_DATA static volatile UBaseType_t uxTaskPoolUnfilled = ( UBaseType_t ) 0U;	/*< The number of pooled stacks the idle task has still to refill. */
+	#endif
+
 #endif
 
 /*
@@ -450,7 +638,18 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
  * and its TCB deleted.
  */
-static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+static void prvCheckTasksWaitingTermination( UBaseType_t uxMaxToReclaim ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TASK_RECLAIMER == 1 )
+
+	/*
+	 * The reclaimer task, created when the scheduler is started.  It frees the
+	 * memory of deleted tasks in batches of at most configTASK_RECLAIM_BATCH_SIZE
+	 * so memory is reclaimed even if the idle task never runs.
+	 */
+	static portTASK_FUNCTION_PROTO( prvTaskReclaimer, pvParameters );
+
+#endif
 
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
@@ -464,6 +663,48 @@ static void prvAddCurrentTaskToDelayedList( const TickType_t xTimeToWake ) PRIVI
  */
 static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t * const puxStackBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Allocate and free the memory for a TCB alone.  When configSPLIT_TCB is 1
+ * this includes the separately allocated cold members, and the TCB is aligned
+ * to portCACHE_LINE_SIZE.
+ */
+static TCB_t *prvAllocateTCB( void ) PRIVILEGED_FUNCTION;
+static void prvFreeTCB( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TASK_POOL == 1 )
+
+	/*
+	 * Returns the task pool bucket that holds stacks of at least usStackDepth
+	 * words, or tskNOT_POOLED if the stack is too large for any bucket.
+	 */
+	static UBaseType_t prvTaskPoolBucket( const uint16_t usStackDepth ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes a TCB and stack pair from bucket uxBucket of the task pool,
+	 * preferring one whose stack has already been refilled.  Returns NULL if
+	 * the bucket is empty.  *pxStackFilled is set to pdTRUE if the stack of the
+	 * returned TCB does not need to be filled again.
+	 */
+	static TCB_t *prvTakeFromTaskPool( const UBaseType_t uxBucket, BaseType_t * const pxStackFilled ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Places the TCB and stack of a deleted task in the task pool.  Returns
+	 * pdFALSE if they could not be pooled, in which case they must be freed.
+	 */
+	static BaseType_t prvReturnToTaskPool( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	#if ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+
+		/*
+		 * Used only by the idle task.  Refills the stack of one pooled TCB, so
+		 * creating a task from the pool does not have to.
+		 */
+		static void prvFillTaskPoolStack( void ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configUSE_TASK_POOL */
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -485,7 +726,7 @@ static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t *
  */
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
-	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+	static uint16_t prvTaskCheckFreeStackSpace( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -510,6 +751,17 @@ static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t *
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( ( configUSE_READY_PRIORITY_BITMAP == 1 ) && !defined( portGET_HIGHEST_SET_BIT ) )
+
+	/*
+	 * Return the index of the most significant set bit in ulBitmap, which
+	 * must not be zero.  Used by the ready priority bitmap on ports that do
+	 * not provide portGET_HIGHEST_SET_BIT().
+	 */
+	static UBaseType_t prvGetHighestSetBit( uint32_t ulBitmap ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 BaseType_t xTaskGenericCreate( TaskFunction_t pxTaskCode, const char * const pcName, const uint16_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, const MemoryRegion_t * const xRegions ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -647,11 +899,17 @@ TCB_t * pxNewTCB;
 			#if ( configUSE_TRACE_FACILITY == 1 )
 			{
 				/* Add a counter into the TCB for tracing only. */
-				pxNewTCB->uxTCBNumber = uxTaskNumber;
+				taskCOLD( pxNewTCB )->uxTCBNumber = uxTaskNumber;
 			}
 			#endif /* configUSE_TRACE_FACILITY */
 			traceTASK_CREATE( pxNewTCB );
 
+			#if ( configUSE_OBJECT_REGISTRY == 1 )
+			{
+				( void ) xObjectRegistryAdd( pxNewTCB, registryTYPE_TASK, &( taskCOLD( pxNewTCB )->pcTaskName[ 0 ] ), prvTaskGetSnapshot );
+			}
+			#endif /* configUSE_OBJECT_REGISTRY */
+
 			prvAddTaskToReadyList( pxNewTCB );
 
 			xReturn = pdPASS;
@@ -695,6 +953,7 @@ TCB_t * pxNewTCB;
 	void vTaskDelete( TaskHandle_t xTaskToDelete )
 	{
 	TCB_t *pxTCB;
+	BaseType_t xDeleteNow = pdFALSE, xYieldRequired = pdFALSE;
 
 		taskENTER_CRITICAL();
 		{
@@ -702,6 +961,12 @@ TCB_t * pxNewTCB;
 			being deleted. */
 			pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
+			#if ( configUSE_OBJECT_REGISTRY == 1 )
+			{
+				vObjectRegistryRemove( pxTCB );
+			}
+			#endif /* configUSE_OBJECT_REGISTRY */
+
 			/* Remove task from the ready list and place in the	termination list.
 			This will stop the task from be scheduled.  The idle task will check
 			the termination list and free up any memory allocated by the
@@ -725,12 +990,50 @@ TCB_t * pxNewTCB;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xGenericListItem ) );
+			#if ( configTASK_RECLAIM_INLINE == 1 )
+			{
+				/* A task that is not running can have its TCB and stack
+				freed, or returned to the task pool, straight away rather than
+				waiting for the idle or reclaimer task to clean it up. */
+				if( pxTCB != pxCurrentTCB )
+				{
+					--uxCurrentNumberOfTasks;
+					xDeleteNow = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configTASK_RECLAIM_INLINE */
+
+			if( xDeleteNow == pdFALSE )
+			{
+				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xGenericListItem ) );
+
+				/* Increment the ucTasksDeleted variable so the idle task knows
+				there is a task that has been deleted and that it should
+				therefore check the xTasksWaitingTermination list. */
+				++uxTasksDeleted;
 
-			/* Increment the ucTasksDeleted variable so the idle task knows
-			there is a task that has been deleted and that it should therefore
-			check the xTasksWaitingTermination list. */
-			++uxTasksDeleted;
+				#if ( configUSE_TASK_RECLAIMER == 1 )
+				{
+					/* Wake the reclaimer task if it is waiting for work. */
+					if( listLIST_IS_EMPTY( &xTaskReclaimerWaitList ) == pdFALSE )
+					{
+						xYieldRequired = xTaskRemoveFromEventList( &xTaskReclaimerWaitList );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_TASK_RECLAIMER */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
 			/* Increment the uxTaskNumberVariable also so kernel aware debuggers
 			can detect that the task lists need re-generating. */
@@ -740,6 +1043,15 @@ TCB_t * pxNewTCB;
 		}
 		taskEXIT_CRITICAL();
 
+		if( xDeleteNow != pdFALSE )
+		{
+			prvDeleteTCB( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
 		/* Force a reschedule if it is the currently running task that has just
 		been deleted. */
 		if( xSchedulerRunning != pdFALSE )
@@ -761,6 +1073,18 @@ TCB_t * pxNewTCB;
 				/* Reset the next expected unblock time in case it referred to
 				the task that has just been deleted. */
 				prvResetNextTaskUnblockTime();
+
+				/* If the scheduler is suspended xTaskRemoveFromEventList() has
+				already set xYieldPending, so xTaskResumeAll() performs the
+				switch to the reclaimer task. */
+				if( ( xYieldRequired != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
 	}
@@ -768,6 +1092,18 @@ TCB_t * pxNewTCB;
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	UBaseType_t uxTaskGetPendingReclaimCount( void )
+	{
+		/* A critical section is not required because the variables are of type
+		BaseType_t. */
+		return uxTasksDeleted;
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelayUntil == 1 )
 
 	void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement )
@@ -1474,6 +1810,19 @@ BaseType_t xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_TASK_RECLAIMER == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xTaskCreate( prvTaskReclaimer, "Reclaim", configTASK_RECLAIMER_STACK_DEPTH, ( void * ) NULL, ( ( UBaseType_t ) configTASK_RECLAIMER_PRIORITY | portPRIVILEGE_BIT ), NULL ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TASK_RECLAIMER */
+
 	if( xReturn == pdPASS )
 	{
 		/* Interrupts are turned off here, to ensure a tick does not occur
@@ -1487,7 +1836,7 @@ BaseType_t xReturn;
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
 			structure specific to the task that will run first. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+			_impure_ptr = &( taskCOLD( pxCurrentTCB )->xNewLib_reent );
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
@@ -1562,6 +1911,22 @@ void vTaskSuspendAll( void )
 		else
 		{
 			xReturn = xNextTaskUnblockTime - xTickCount;
+
+			#if ( configUSE_TICK_TIMERS == 1 )
+			{
+				/* Don't sleep through the expiry of a tick timer. */
+				const TickType_t xTickTimerIdleTime = xTickTimerGetExpectedIdleTime( xTickCount );
+
+				if( xTickTimerIdleTime < xReturn )
+				{
+					xReturn = xTickTimerIdleTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TICK_TIMERS */
 		}
 
 		return xReturn;
@@ -1667,12 +2032,14 @@ TickType_t xTaskGetTickCount( void )
 {
 TickType_t xTicks;
 
-	/* Critical section required if running on a 16 bit processor. */
-	taskENTER_CRITICAL();
+	/* Critical section required if the tick count cannot be read in a single
+	access, for example on a 16 bit processor.  The port defines it away
+	otherwise. */
+	portTICK_TYPE_ENTER_CRITICAL();
 	{
 		xTicks = xTickCount;
 	}
-	taskEXIT_CRITICAL();
+	portTICK_TYPE_EXIT_CRITICAL();
 
 	return xTicks;
 }
@@ -1699,11 +2066,11 @@ UBaseType_t uxSavedInterruptStatus;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
 	{
 		xReturn = xTickCount;
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1726,7 +2093,7 @@ UBaseType_t uxTaskGetNumberOfTasks( void )
 		/* If null is passed in here then the name of the calling task is being queried. */
 		pxTCB = prvGetTCBFromHandle( xTaskToQuery );
 		configASSERT( pxTCB );
-		return &( pxTCB->pcTaskName[ 0 ] );
+		return &( taskCOLD( pxTCB )->pcTaskName[ 0 ] );
 	}
 
 #endif /* INCLUDE_pcTaskGetTaskName */
@@ -1833,6 +2200,17 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
+
+		#if ( configUSE_TICK_TIMERS == 1 )
+		{
+			/* Tick timers were taken into account when the expected idle
+			time was calculated, but an interrupt that executed while the tick
+			was suppressed may have started a tick timer that has now expired.
+			The scheduler is suspended while the tick is suppressed, so a task
+			unblocked by a callback is readied when the scheduler resumes. */
+			( void ) xTickTimerIncrementTick( xTickCount, xTicksToJump );
+		}
+		#endif /* configUSE_TICK_TIMERS */
 	}
 
 #endif /* configUSE_TICKLESS_IDLE */
@@ -1859,14 +2237,18 @@ BaseType_t xSwitchRequired = pdFALSE;
 			block. */
 			const TickType_t xConstTickCount = xTickCount;
 
-			if( xConstTickCount == ( TickType_t ) 0U )
+			#if ( configUSE_64_BIT_TICKS == 0 )
 			{
-				taskSWITCH_DELAYED_LISTS();
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
+				if( xConstTickCount == ( TickType_t ) 0U )
+				{
+					taskSWITCH_DELAYED_LISTS();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
+			#endif /* configUSE_64_BIT_TICKS */
 
 			/* See if this tick has made a timeout expire.  Tasks are stored in
 			the	queue in the order of their wake time - meaning once one task
@@ -1949,6 +2331,28 @@ BaseType_t xSwitchRequired = pdFALSE;
 					}
 				}
 			}
+
+			/* Process the tick timers that expire on this tick.  Tick timer
+			callbacks execute from here, so can only use the interrupt safe
+			API. */
+			#if ( configUSE_TICK_TIMERS == 1 )
+			{
+				if( xTickTimerIncrementTick( xConstTickCount, ( TickType_t ) 1 ) != pdFALSE )
+				{
+					/* A callback unblocked a task.  As above, that can only
+					cause an immediate context switch if preemption is on. */
+					#if ( configUSE_PREEMPTION == 1 )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TICK_TIMERS */
 		}
 
 		/* Tasks of equal priority to the currently running task will share
@@ -2153,7 +2557,7 @@ void vTaskSwitchContext( void )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
 			structure specific to this task. */
-			_impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+			_impure_ptr = &( taskCOLD( pxCurrentTCB )->xNewLib_reent );
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
@@ -2460,6 +2864,7 @@ BaseType_t xReturn;
 			else /* We are not blocking indefinitely, perform the checks below. */
 		#endif
 
+		#if ( configUSE_64_BIT_TICKS == 0 )
 		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
 		{
 			/* The tick count is greater than the time at which vTaskSetTimeout()
@@ -2468,7 +2873,12 @@ BaseType_t xReturn;
 			passed since vTaskSetTimeout() was called. */
 			xReturn = pdTRUE;
 		}
-		else if( ( xConstTickCount - pxTimeOut->xTimeOnEntering ) < *pxTicksToWait )
+		else
+		#endif /* configUSE_64_BIT_TICKS */
+
+		/* A 64 bit tick count cannot overflow, so only the number of ticks
+		that have passed needs checking. */
+		if( ( xConstTickCount - pxTimeOut->xTimeOnEntering ) < *pxTicksToWait )
 		{
 			/* Not a genuine timeout. Adjust parameters for time remaining. */
 			*pxTicksToWait -= ( xConstTickCount -  pxTimeOut->xTimeOnEntering );
@@ -2502,7 +2912,7 @@ void vTaskMissedYield( void )
 		if( xTask != NULL )
 		{
 			pxTCB = ( TCB_t * ) xTask;
-			uxReturn = pxTCB->uxTaskNumber;
+			uxReturn = taskCOLD( pxTCB )->uxTaskNumber;
 		}
 		else
 		{
@@ -2524,7 +2934,7 @@ void vTaskMissedYield( void )
 		if( xTask != NULL )
 		{
 			pxTCB = ( TCB_t * ) xTask;
-			pxTCB->uxTaskNumber = uxHandle;
+			taskCOLD( pxTCB )->uxTaskNumber = uxHandle;
 		}
 	}
 
@@ -2548,8 +2958,31 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 	for( ;; )
 	{
-		/* See if any tasks have been deleted. */
-		prvCheckTasksWaitingTermination();
+		#if ( configUSE_TASK_RECLAIMER == 0 )
+		{
+			/* See if any tasks have been deleted. */
+			prvCheckTasksWaitingTermination( ( UBaseType_t ) configTASK_RECLAIM_BATCH_SIZE );
+		}
+		#endif
+
+		#if ( ( configUSE_TASK_POOL == 1 ) && ( configTASK_POOL_LAZY_STACK_FILL == 1 ) )
+		{
+			/* Refill the stacks of recycled tasks while there is nothing else
+			to do. */
+			if( uxTaskPoolUnfilled > ( UBaseType_t ) 0U )
+			{
+				prvFillTaskPoolStack();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		/* Give ports that cannot rely on a hardware timer interrupting the
+		idle loop (such as host simulators) a chance to run. */
+		portIDLE_TASK_ITERATION();
 
 		#if ( configUSE_PREEMPTION == 0 )
 		{
@@ -2695,7 +3128,7 @@ UBaseType_t x;
 	/* Store the task name in the TCB. */
 	for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
 	{
-		pxTCB->pcTaskName[ x ] = pcName[ x ];
+		taskCOLD( pxTCB )->pcTaskName[ x ] = pcName[ x ];
 
 		/* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
 		configMAX_TASK_NAME_LEN characters just in case the memory after the
@@ -2712,7 +3145,7 @@ UBaseType_t x;
 
 	/* Ensure the name string is terminated in the case that the string length
 	was greater or equal to configMAX_TASK_NAME_LEN. */
-	pxTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+	taskCOLD( pxTCB )->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
 
 	/* This is used as an array index so must ensure it's not too large.  First
 	remove the privilege bit if one is present. */
@@ -2749,6 +3182,15 @@ UBaseType_t x;
 	}
 	#endif /* portCRITICAL_NESTING_IN_TCB */
 
+	#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+	{
+		/* The whole stack has just been filled, so the first check starts
+		from the top of the stack. */
+		taskCOLD( pxTCB )->usStackHighWaterMark = usStackDepth;
+		taskCOLD( pxTCB )->usStackScanIndex = ( uint16_t ) 0U;
+	}
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 	{
 		pxTCB->pxTaskTag = NULL;
@@ -2775,7 +3217,7 @@ UBaseType_t x;
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 	{
 		/* Initialise this task's Newlib reent structure. */
-		_REENT_INIT_PTR( ( &( pxTCB->xNewLib_reent ) ) );
+		_REENT_INIT_PTR( ( &( taskCOLD( pxTCB )->xNewLib_reent ) ) );
 	}
 	#endif /* configUSE_NEWLIB_REENTRANT */
 }
@@ -2812,6 +3254,12 @@ UBaseType_t uxPriority;
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		vListInitialise( &xTasksWaitingTermination );
+
+		#if ( configUSE_TASK_RECLAIMER == 1 )
+		{
+			vListInitialise( &xTaskReclaimerWaitList );
+		}
+		#endif
 	}
 	#endif /* INCLUDE_vTaskDelete */
 
@@ -2828,114 +3276,564 @@ UBaseType_t uxPriority;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
+static void prvCheckTasksWaitingTermination( UBaseType_t uxMaxToReclaim )
 {
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
-		BaseType_t xListIsEmpty;
+		TCB_t *pxTCB;
 
-		/* ucTasksDeleted is used to prevent vTaskSuspendAll() being called
-		too often in the idle task. */
-		while( uxTasksDeleted > ( UBaseType_t ) 0U )
+		/* uxTasksDeleted is used to prevent a critical section being entered
+		when there is nothing to do.  At most uxMaxToReclaim tasks are freed per
+		call so a burst of deletions cannot hold up the caller for long. */
+		while( ( uxTasksDeleted > ( UBaseType_t ) 0U ) && ( uxMaxToReclaim > ( UBaseType_t ) 0U ) )
 		{
-			vTaskSuspendAll();
-			{
-				xListIsEmpty = listLIST_IS_EMPTY( &xTasksWaitingTermination );
-			}
-			( void ) xTaskResumeAll();
+			pxTCB = NULL;
 
-			if( xListIsEmpty == pdFALSE )
+			taskENTER_CRITICAL();
 			{
-				TCB_t *pxTCB;
-
-				taskENTER_CRITICAL();
+				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
 				{
 					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
 					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
 					--uxCurrentNumberOfTasks;
 					--uxTasksDeleted;
 				}
-				taskEXIT_CRITICAL();
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
 
+			if( pxTCB != NULL )
+			{
 				prvDeleteTCB( pxTCB );
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+
+			uxMaxToReclaim--;
 		}
 	}
+	#else
+	{
+		( void ) uxMaxToReclaim;
+	}
 	#endif /* vTaskDelete */
 }
 /*-----------------------------------------------------------*/
 
-static void prvAddCurrentTaskToDelayedList( const TickType_t xTimeToWake )
-{
-	/* The list item will be inserted in wake time order. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+#if ( configUSE_TASK_RECLAIMER == 1 )
 
-	if( xTimeToWake < xTickCount )
-	{
-		/* Wake time has overflowed.  Place this item in the overflow list. */
-		vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
-	}
-	else
+	static portTASK_FUNCTION( prvTaskReclaimer, pvParameters )
 	{
-		/* The wake time has not overflowed, so the current block list is used. */
-		vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		/* Stop warnings. */
+		( void ) pvParameters;
 
-		/* If the task entering the blocked state was placed at the head of the
-		list of blocked tasks then xNextTaskUnblockTime needs to be updated
-		too. */
-		if( xTimeToWake < xNextTaskUnblockTime )
+		for( ;; )
 		{
-			xNextTaskUnblockTime = xTimeToWake;
-		}
+			prvCheckTasksWaitingTermination( ( UBaseType_t ) configTASK_RECLAIM_BATCH_SIZE );
+
+			if( uxTasksDeleted > ( UBaseType_t ) 0U )
+			{
+				/* More tasks are waiting to be freed.  Let any other task of
+				the same priority run before freeing the next batch. */
+				taskYIELD();
+			}
+			else
+			{
+				/* Wait for vTaskDelete() to add a task to
+				xTasksWaitingTermination.  No task can be deleted between the
+				check and the wait as the scheduler is suspended. */
+				vTaskSuspendAll();
+				{
+					if( uxTasksDeleted == ( UBaseType_t ) 0U )
+					{
+						vTaskPlaceOnEventList( &xTaskReclaimerWaitList, portMAX_DELAY );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_TASK_RECLAIMER */
+/*-----------------------------------------------------------*/
+
+static void prvAddCurrentTaskToDelayedList( const TickType_t xTimeToWake )
+{
+	/* The list item will be inserted in wake time order. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+
+	#if ( configUSE_64_BIT_TICKS == 1 )
+	{
+		/* The tick count cannot overflow, so a wake time before the tick count
+		can only come from a block time that overflowed when it was added to
+		the tick count.  Wait as long as possible instead. */
+		if( xTimeToWake < xTickCount )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), portMAX_DELAY );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+
+		if( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ) ) < xNextTaskUnblockTime )
+		{
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ) );
+		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+	#else
+	{
+		if( xTimeToWake < xTickCount )
+		{
+			/* Wake time has overflowed.  Place this item in the overflow list. */
+			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* The wake time has not overflowed, so the current block list is used. */
+			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+
+			/* If the task entering the blocked state was placed at the head of the
+			list of blocked tasks then xNextTaskUnblockTime needs to be updated
+			too. */
+			if( xTimeToWake < xNextTaskUnblockTime )
+			{
+				xNextTaskUnblockTime = xTimeToWake;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif /* configUSE_64_BIT_TICKS */
 }
 /*-----------------------------------------------------------*/
 
 static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t * const puxStackBuffer )
 {
-TCB_t *pxNewTCB;
+TCB_t *pxNewTCB = NULL;
+size_t xStackDepth = ( size_t ) usStackDepth;
+BaseType_t xStackFilled = pdFALSE;
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+	#if ( configUSE_TASK_POOL == 1 )
+	UBaseType_t uxBucket = tskNOT_POOLED;
 
-	if( pxNewTCB != NULL )
+		if( puxStackBuffer == NULL )
+		{
+			/* Recycle any tasks that deleted themselves so their TCBs and
+			stacks can be reused now, rather than when the idle task runs. */
+			prvCheckTasksWaitingTermination( ( UBaseType_t ) configTASK_RECLAIM_BATCH_SIZE );
+
+			uxBucket = prvTaskPoolBucket( usStackDepth );
+
+			if( uxBucket != tskNOT_POOLED )
+			{
+				pxNewTCB = prvTakeFromTaskPool( uxBucket, &xStackFilled );
+
+				/* If a new stack has to be allocated, allocate the whole of the
+				bucket's stack size so it can be reused by any task that uses
+				the same bucket. */
+				xStackDepth = ( size_t ) configMINIMAL_STACK_SIZE << uxBucket;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	#endif /* configUSE_TASK_POOL */
+
+	if( pxNewTCB == NULL )
+	{
+		pxNewTCB = prvAllocateTCB();
+
+		if( pxNewTCB != NULL )
+		{
+			/* Allocate space for the stack used by the task being created.
+			The base of the stack memory stored in the TCB so the task can
+			be deleted later if required. */
+			pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocAligned( ( xStackDepth * sizeof( StackType_t ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+			if( pxNewTCB->pxStack == NULL )
+			{
+				/* Could not allocate the stack.  Delete the allocated TCB. */
+				prvFreeTCB( pxNewTCB );
+				pxNewTCB = NULL;
+			}
+			else
+			{
+				#if ( configUSE_TASK_POOL == 1 )
+				{
+					taskCOLD( pxNewTCB )->uxPoolBucket = uxBucket;
+				}
+				#endif
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocAligned( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-		if( pxNewTCB->pxStack == NULL )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		if( pxNewTCB != NULL )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
-			pxNewTCB = NULL;
+			if( puxStackBuffer != NULL )
+			{
+				taskCOLD( pxNewTCB )->ucStaticStack = pdTRUE;
+			}
+			else
+			{
+				taskCOLD( pxNewTCB )->ucStaticStack = pdFALSE;
+			}
 		}
 		else
 		{
-			/* Avoid dependency on memset() if it is not required. */
-			#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	if( ( pxNewTCB != NULL ) && ( xStackFilled == pdFALSE ) )
+	{
+		/* Avoid dependency on memset() if it is not required. */
+		#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+		{
+			/* Just to help debugging. */
+			( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( StackType_t ) );
+		}
+		#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) ) */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxNewTCB;
+}
+/*-----------------------------------------------------------*/
+
+static TCB_t *prvAllocateTCB( void )
+{
+TCB_t *pxNewTCB;
+
+	#if ( configSPLIT_TCB == 1 )
+	{
+	TCBCold_t *pxCold;
+	void *pvAllocation = NULL;
+
+		pxNewTCB = NULL;
+		pxCold = ( TCBCold_t * ) pvPortMalloc( sizeof( TCBCold_t ) );
+
+		if( pxCold != NULL )
+		{
+			/* Allocate enough to start the TCB on a cache line boundary, and
+			to own every cache line the TCB touches. */
+			pvAllocation = pvPortMalloc( ( ( sizeof( TCB_t ) + ( size_t ) portCACHE_LINE_MASK ) & ~( size_t ) portCACHE_LINE_MASK ) + ( size_t ) portCACHE_LINE_MASK );
+
+			if( pvAllocation != NULL )
+			{
+				pxNewTCB = ( TCB_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pvAllocation + ( portPOINTER_SIZE_TYPE ) portCACHE_LINE_MASK ) & ~( ( portPOINTER_SIZE_TYPE ) portCACHE_LINE_MASK ) );
+				pxNewTCB->pxCold = pxCold;
+				pxCold->pvTCBAllocation = pvAllocation;
+			}
+			else
 			{
-				/* Just to help debugging. */
-				( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( StackType_t ) );
+				vPortFree( pxCold );
 			}
-			#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) ) */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+	#else
+	{
+		/* Allocate space for the TCB.  Where the memory comes from depends on
+		the implementation of the port malloc function. */
+		pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+	}
+	#endif /* configSPLIT_TCB */
 
 	return pxNewTCB;
 }
 /*-----------------------------------------------------------*/
 
+static void prvFreeTCB( TCB_t *pxTCB )
+{
+	#if ( configSPLIT_TCB == 1 )
+	{
+	TCBCold_t *pxCold = pxTCB->pxCold;
+
+		vPortFree( pxCold->pvTCBAllocation );
+		vPortFree( pxCold );
+	}
+	#else
+	{
+		vPortFree( pxTCB );
+	}
+	#endif /* configSPLIT_TCB */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_POOL == 1 )
+
+	static UBaseType_t prvTaskPoolBucket( const uint16_t usStackDepth )
+	{
+	UBaseType_t uxBucket;
+
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configTASK_POOL_BUCKETS; uxBucket++ )
+		{
+			if( ( uint32_t ) usStackDepth <= ( ( uint32_t ) configMINIMAL_STACK_SIZE << uxBucket ) )
+			{
+				break;
+			}
+		}
+
+		/* Leaving the loop without a match gives tskNOT_POOLED. */
+		return uxBucket;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvTakeFromTaskPool( const UBaseType_t uxBucket, BaseType_t * const pxStackFilled )
+	{
+	TCB_t *pxTCB = NULL;
+	ListItem_t *pxItem;
+	const MiniListItem_t *pxEnd;
+
+		taskENTER_CRITICAL();
+		{
+			if( xTaskPoolInitialised != pdFALSE )
+			{
+				/* Look for a TCB whose stack has already been refilled,
+				otherwise take the first. */
+				pxEnd = ( const MiniListItem_t * ) listGET_END_MARKER( &( xTaskPool[ uxBucket ] ) );
+
+				for( pxItem = listGET_HEAD_ENTRY( &( xTaskPool[ uxBucket ] ) ); pxItem != ( const ListItem_t * ) pxEnd; pxItem = listGET_NEXT( pxItem ) )
+				{
+					if( listGET_LIST_ITEM_VALUE( pxItem ) != ( TickType_t ) pdFALSE )
+					{
+						break;
+					}
+				}
+
+				if( pxItem == ( const ListItem_t * ) pxEnd )
+				{
+					pxItem = listGET_HEAD_ENTRY( &( xTaskPool[ uxBucket ] ) );
+				}
+
+				if( pxItem != ( const ListItem_t * ) pxEnd )
+				{
+					pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+					*pxStackFilled = ( BaseType_t ) listGET_LIST_ITEM_VALUE( pxItem );
+					( void ) uxListRemove( pxItem );
+
+					#if ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+					{
+						if( *pxStackFilled == pdFALSE )
+						{
+							--uxTaskPoolUnfilled;
+						}
+					}
+					#endif
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxTCB;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvReturnToTaskPool( TCB_t *pxTCB )
+	{
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxBucket;
+
+		if( taskCOLD( pxTCB )->uxPoolBucket != tskNOT_POOLED )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( xTaskPoolInitialised == pdFALSE )
+				{
+					for( uxBucket = 0; uxBucket < ( UBaseType_t ) configTASK_POOL_BUCKETS; uxBucket++ )
+					{
+						vListInitialise( &( xTaskPool[ uxBucket ] ) );
+					}
+
+					xTaskPoolInitialised = pdTRUE;
+				}
+
+				if( listCURRENT_LIST_LENGTH( &( xTaskPool[ taskCOLD( pxTCB )->uxPoolBucket ] ) ) < ( UBaseType_t ) configTASK_POOL_SIZE )
+				{
+					/* The stack holds whatever the deleted task left on it. */
+					vListInitialiseItem( &( pxTCB->xGenericListItem ) );
+					listSET_LIST_ITEM_OWNER( &( pxTCB->xGenericListItem ), pxTCB );
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ), ( TickType_t ) pdFALSE );
+					vListInsertEnd( &( xTaskPool[ taskCOLD( pxTCB )->uxPoolBucket ] ), &( pxTCB->xGenericListItem ) );
+
+					#if ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+					{
+						++uxTaskPoolUnfilled;
+					}
+					#endif
+
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configTASK_POOL_LAZY_STACK_FILL == 1 )
+
+		static void prvFillTaskPoolStack( void )
+		{
+		TCB_t *pxTCB = NULL;
+		UBaseType_t uxBucket;
+		ListItem_t *pxItem;
+		const MiniListItem_t *pxEnd;
+
+			/* Remove an unfilled TCB from the pool so it cannot be taken by a
+			task being created while its stack is being filled. */
+			taskENTER_CRITICAL();
+			{
+				for( uxBucket = 0; ( uxBucket < ( UBaseType_t ) configTASK_POOL_BUCKETS ) && ( pxTCB == NULL ); uxBucket++ )
+				{
+					pxEnd = ( const MiniListItem_t * ) listGET_END_MARKER( &( xTaskPool[ uxBucket ] ) );
+
+					for( pxItem = listGET_HEAD_ENTRY( &( xTaskPool[ uxBucket ] ) ); pxItem != ( const ListItem_t * ) pxEnd; pxItem = listGET_NEXT( pxItem ) )
+					{
+						if( listGET_LIST_ITEM_VALUE( pxItem ) == ( TickType_t ) pdFALSE )
+						{
+							pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+							( void ) uxListRemove( pxItem );
+							--uxTaskPoolUnfilled;
+							break;
+						}
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxTCB != NULL )
+			{
+				#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+				{
+					( void ) memset( pxTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( ( size_t ) configMINIMAL_STACK_SIZE << taskCOLD( pxTCB )->uxPoolBucket ) * sizeof( StackType_t ) );
+				}
+				#endif
+
+				taskENTER_CRITICAL();
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ), ( TickType_t ) pdTRUE );
+					vListInsertEnd( &( xTaskPool[ taskCOLD( pxTCB )->uxPoolBucket ] ), &( pxTCB->xGenericListItem ) );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+	#endif /* configTASK_POOL_LAZY_STACK_FILL */
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskPoolPreallocate( const uint16_t usStackDepth, UBaseType_t uxCount )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn = pdPASS;
+
+		configASSERT( prvTaskPoolBucket( usStackDepth ) != tskNOT_POOLED );
+
+		while( ( uxCount > ( UBaseType_t ) 0U ) && ( xReturn == pdPASS ) )
+		{
+			/* Allocate a pair exactly as if a task was being created, but
+			without taking one from the pool, then place it straight in the
+			pool. */
+			pxTCB = prvAllocateTCB();
+
+			if( pxTCB != NULL )
+			{
+				taskCOLD( pxTCB )->uxPoolBucket = prvTaskPoolBucket( usStackDepth );
+				pxTCB->pxStack = ( StackType_t * ) pvPortMallocAligned( ( ( size_t ) configMINIMAL_STACK_SIZE << taskCOLD( pxTCB )->uxPoolBucket ) * sizeof( StackType_t ), NULL );
+
+				if( pxTCB->pxStack == NULL )
+				{
+					prvFreeTCB( pxTCB );
+					pxTCB = NULL;
+				}
+				else if( prvReturnToTaskPool( pxTCB ) == pdFALSE )
+				{
+					/* The bucket is already full, so there is no point
+					allocating any more. */
+					vPortFreeAligned( pxTCB->pxStack );
+					prvFreeTCB( pxTCB );
+					uxCount = ( UBaseType_t ) 1U;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( pxTCB == NULL )
+			{
+				xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+			}
+
+			uxCount--;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_POOL */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	static UBaseType_t prvListTaskWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
@@ -2956,8 +3854,8 @@ TCB_t *pxNewTCB;
 				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
 
 				pxTaskStatusArray[ uxTask ].xHandle = ( TaskHandle_t ) pxNextTCB;
-				pxTaskStatusArray[ uxTask ].pcTaskName = ( const char * ) &( pxNextTCB->pcTaskName [ 0 ] );
-				pxTaskStatusArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
+				pxTaskStatusArray[ uxTask ].pcTaskName = ( const char * ) &( taskCOLD( pxNextTCB )->pcTaskName [ 0 ] );
+				pxTaskStatusArray[ uxTask ].xTaskNumber = taskCOLD( pxNextTCB )->uxTCBNumber;
 				pxTaskStatusArray[ uxTask ].eCurrentState = eState;
 				pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
 
@@ -2996,15 +3894,7 @@ TCB_t *pxNewTCB;
 				}
 				#endif
 
-				#if ( portSTACK_GROWTH > 0 )
-				{
-					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxNextTCB->pxEndOfStack );
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxNextTCB->pxStack );
-				}
-				#endif
+				pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( TCB_t * ) pxNextTCB );
 
 				uxTask++;
 
@@ -3023,19 +3913,101 @@ TCB_t *pxNewTCB;
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
-	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+	static uint16_t prvTaskCheckFreeStackSpace( TCB_t * const pxTCB )
 	{
-	uint32_t ulCount = 0U;
+	const StackType_t *pxEndOfStack;
+	uint16_t usMark, usIndex, usLimit;
+
+		/* Word usIndex of the stack is pxEndOfStack[ -usIndex * portSTACK_GROWTH ],
+		counting from the end of the stack the task has not yet reached. */
+		#if( portSTACK_GROWTH < 0 )
+		{
+			pxEndOfStack = pxTCB->pxStack;
+		}
+		#else
+		{
+			pxEndOfStack = pxTCB->pxEndOfStack;
+		}
+		#endif
 
-		while( *pucStackByte == tskSTACK_FILL_BYTE )
+		/* Several tasks can check the same stack at once, so the mark and the
+		scan position are read and written as a pair inside critical sections.
+		The scan itself runs outside of them. */
+		taskENTER_CRITICAL();
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			ulCount++;
+			usMark = taskCOLD( pxTCB )->usStackHighWaterMark;
+			usIndex = taskCOLD( pxTCB )->usStackScanIndex;
 		}
+		taskEXIT_CRITICAL();
 
-		ulCount /= ( uint32_t ) sizeof( StackType_t );
+		/* The words between the end of the stack and the previous high water
+		mark were all unused when last checked.  The stack normally grows one
+		frame at a time, so first step back over the words used since then. */
+		while( ( usMark > ( uint16_t ) 0U ) && ( pxEndOfStack[ ( 1 - ( int32_t ) usMark ) * portSTACK_GROWTH ] != tskSTACK_FILL_WORD ) )
+		{
+			usMark--;
+		}
 
-		return ( uint16_t ) ulCount;
+		/* A task can also write below its deepest frame without touching the
+		words in between, for example into a large local array.  Check the
+		remaining words for that, at most configSTACK_HIGH_WATER_MARK_SCAN_WORDS
+		of them per call, carrying on from where the last call stopped. */
+		if( usIndex >= usMark )
+		{
+			usIndex = ( uint16_t ) 0U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configSTACK_HIGH_WATER_MARK_SCAN_WORDS > 0 )
+		{
+			if( ( uint32_t ) usMark - ( uint32_t ) usIndex > ( uint32_t ) configSTACK_HIGH_WATER_MARK_SCAN_WORDS )
+			{
+				usLimit = ( uint16_t ) ( usIndex + ( uint16_t ) configSTACK_HIGH_WATER_MARK_SCAN_WORDS );
+			}
+			else
+			{
+				usLimit = usMark;
+			}
+		}
+		#else
+		{
+			usLimit = usMark;
+		}
+		#endif
+
+		while( usIndex < usLimit )
+		{
+			if( pxEndOfStack[ -( int32_t ) usIndex * portSTACK_GROWTH ] != tskSTACK_FILL_WORD )
+			{
+				usMark = usIndex;
+				break;
+			}
+			else
+			{
+				usIndex++;
+			}
+		}
+
+		taskENTER_CRITICAL();
+		{
+			if( taskCOLD( pxTCB )->usStackHighWaterMark >= usMark )
+			{
+				taskCOLD( pxTCB )->usStackHighWaterMark = usMark;
+				taskCOLD( pxTCB )->usStackScanIndex = usIndex;
+			}
+			else
+			{
+				/* Another check finished while this one was scanning and
+				found the stack to be deeper.  Keep its result. */
+				usMark = taskCOLD( pxTCB )->usStackHighWaterMark;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return usMark;
 	}
 
 #endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
@@ -3046,22 +4018,11 @@ TCB_t *pxNewTCB;
 	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
 	{
 	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
 	UBaseType_t uxReturn;
 
 		pxTCB = prvGetTCBFromHandle( xTask );
 
-		#if portSTACK_GROWTH < 0
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-		}
-		#else
-		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-		}
-		#endif
-
-		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pxTCB );
 
 		return uxReturn;
 	}
@@ -3078,15 +4039,89 @@ TCB_t *pxNewTCB;
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up to
-		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		#if ( configUSE_TASK_POOL == 1 )
+		{
+			/* Keep the TCB and stack for reuse if there is room in the pool,
+			otherwise free them as normal. */
+			if( prvReturnToTaskPool( pxTCB ) == pdFALSE )
+			{
+				prvFreeStack( pxTCB );
+				prvFreeTCB( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			/* Free up the memory allocated by the scheduler for the task.  It is up to
+			the task to free any memory allocated at the application level. */
+			prvFreeStack( pxTCB );
+			prvFreeTCB( pxTCB );
+		}
+		#endif /* configUSE_TASK_POOL */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	static void prvFreeStack( TCB_t *pxTCB )
+	{
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			if( taskCOLD( pxTCB )->ucStaticStack == pdFALSE )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	static void prvTaskGetSnapshot( void *pvTask, ObjectSnapshot_t *pxSnapshot )
+	{
+	TCB_t * const pxTCB = ( TCB_t * ) pvTask;
+
+		pxSnapshot->ucState = ( uint8_t ) eTaskGetState( pxTCB );
+		pxSnapshot->uxLevel = pxTCB->uxPriority;
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxSnapshot->xValue = ( TickType_t ) pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxSnapshot->xValue = ( TickType_t ) pxTCB->uxPriority;
+		}
+		#endif /* configUSE_MUTEXES */
+
+		/* The stack is not checked here as that could take a long time with
+		interrupts masked, so the result of the last check is reported. */
+		#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+		{
+			pxSnapshot->uxCapacity = ( UBaseType_t ) taskCOLD( pxTCB )->usStackHighWaterMark;
+		}
+		#endif
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -3112,6 +4147,40 @@ TCB_t *pxTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_READY_PRIORITY_BITMAP == 1 ) && !defined( portGET_HIGHEST_SET_BIT ) )
+
+	static UBaseType_t prvGetHighestSetBit( uint32_t ulBitmap )
+	{
+	/* Index of the highest set bit in each possible nibble value. */
+	static const uint8_t ucHighestBitInNibble[ 16 ] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+	UBaseType_t uxBit = 0U;
+
+		/* Narrow the search down to a nibble with a fixed number of tests so
+		the time taken does not depend on the value being searched. */
+		if( ( ulBitmap & 0xffff0000UL ) != 0UL )
+		{
+			ulBitmap >>= 16U;
+			uxBit += 16U;
+		}
+
+		if( ( ulBitmap & 0x0000ff00UL ) != 0UL )
+		{
+			ulBitmap >>= 8U;
+			uxBit += 8U;
+		}
+
+		if( ( ulBitmap & 0x000000f0UL ) != 0UL )
+		{
+			ulBitmap >>= 4U;
+			uxBit += 4U;
+		}
+
+		return uxBit + ( UBaseType_t ) ucHighestBitInNibble[ ulBitmap & 0x0fUL ];
+	}
+
+#endif /* ( configUSE_READY_PRIORITY_BITMAP == 1 ) && !defined( portGET_HIGHEST_SET_BIT ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -0,0 +1,512 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tick_timers.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include tick timer functionality.  This #if is closed at the very bottom of
+this file.  If you want to include tick timers then ensure configUSE_TICK_TIMERS
+is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TICK_TIMERS == 1 )
+
+/* Mask used to map an expiry time onto a slot of the timer wheel. */
+#define tmrTICK_TIMER_WHEEL_MASK	( ( TickType_t ) configTICK_TIMER_WHEEL_SIZE - ( TickType_t ) 1 )
+
+/* The definition of the tick timers themselves. */
+typedef struct tmrTickTimerControl
+{
+	ListItem_t				xTimerListItem;		/*< Standard linked list item as used by all kernel features for event management.  The item value holds the tick count at which the timer expires. */
+	TickType_t				xTimerPeriodInTicks;/*< How quickly and often the timer expires. */
+	UBaseType_t				uxAutoReload;		/*< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one-shot timer. */
+	void 					*pvTimerID;			/*< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+	TickTimerCallbackFunction_t	pxCallbackFunction;	/*< The function that will be called when the timer expires. */
+} TickTimer_t;
+
+/* The timer wheel.  An active timer is referenced from the slot selected by
+the low bits of its expiry time.  Timers whose period is longer than the wheel
+remain in their slot while the tick count passes the slot more than once. */
+PRIVILEGED_DATA static List_t xTickTimerWheel[ configTICK_TIMER_WHEEL_SIZE ];
+
+/* Timers that have expired but whose callback has not yet been executed. */
+PRIVILEGED_DATA static List_t xExpiredTickTimerList;
+
+/* The number of timers that are referenced from the wheel or the expired
+list.  Allows the idle time calculation to skip the wheel when no timers are
+active. */
+PRIVILEGED_DATA static volatile UBaseType_t uxActiveTickTimers = ( UBaseType_t ) 0U;
+
+PRIVILEGED_DATA static BaseType_t xTickTimerListsInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the wheel and the expired list the first time a tick timer is
+ * created.
+ */
+static void prvCheckForValidListAndWheel( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place the timer in the wheel slot that corresponds to xExpiryTime.  Must be
+ * called with interrupts masked.
+ */
+static void prvInsertTimerInWheel( TickTimer_t * const pxTimer, const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the timer from the wheel or the expired list, if it is in either.
+ * Must be called with interrupts masked.
+ */
+static void prvRemoveTimer( TickTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+TickTimerHandle_t xTickTimerCreate( const TickType_t xTimerPeriodInTicks, const UBaseType_t uxAutoReload, void * const pvTimerID, TickTimerCallbackFunction_t pxCallbackFunction )
+{
+TickTimer_t *pxNewTimer;
+
+	/* 0 is not a valid value for xTimerPeriodInTicks. */
+	configASSERT( ( xTimerPeriodInTicks > 0 ) );
+	configASSERT( pxCallbackFunction );
+
+	pxNewTimer = ( TickTimer_t * ) pvPortMalloc( sizeof( TickTimer_t ) );
+
+	if( pxNewTimer != NULL )
+	{
+		/* The wheel must be initialised before it is used, which may be before
+		the scheduler is started. */
+		prvCheckForValidListAndWheel();
+
+		pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+		pxNewTimer->uxAutoReload = uxAutoReload;
+		pxNewTimer->pvTimerID = pvTimerID;
+		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTimer->xTimerListItem ), pxNewTimer );
+
+		traceTICK_TIMER_CREATE( pxNewTimer );
+	}
+	else
+	{
+		traceTICK_TIMER_CREATE_FAILED();
+	}
+
+	return ( TickTimerHandle_t ) pxNewTimer;
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerDelete( TickTimerHandle_t xTimer )
+{
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+
+	configASSERT( pxTimer );
+
+	taskENTER_CRITICAL();
+	{
+		prvRemoveTimer( pxTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	vPortFree( pxTimer );
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerStart( TickTimerHandle_t xTimer )
+{
+	taskENTER_CRITICAL();
+	{
+		vTickTimerStartFromISR( xTimer );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerStartFromISR( TickTimerHandle_t xTimer )
+{
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxTimer );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvRemoveTimer( pxTimer );
+		prvInsertTimerInWheel( pxTimer, xTaskGetTickCountFromISR() + pxTimer->xTimerPeriodInTicks );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerStop( TickTimerHandle_t xTimer )
+{
+	taskENTER_CRITICAL();
+	{
+		vTickTimerStopFromISR( xTimer );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerStopFromISR( TickTimerHandle_t xTimer )
+{
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxTimer );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvRemoveTimer( pxTimer );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerChangePeriod( TickTimerHandle_t xTimer, const TickType_t xNewPeriod )
+{
+	taskENTER_CRITICAL();
+	{
+		vTickTimerChangePeriodFromISR( xTimer, xNewPeriod );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTickTimerChangePeriodFromISR( TickTimerHandle_t xTimer, const TickType_t xNewPeriod )
+{
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxTimer );
+	configASSERT( ( xNewPeriod > 0 ) );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxTimer->xTimerPeriodInTicks = xNewPeriod;
+		prvRemoveTimer( pxTimer );
+		prvInsertTimerInWheel( pxTimer, xTaskGetTickCountFromISR() + xNewPeriod );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTickTimerIsActive( TickTimerHandle_t xTimer )
+{
+BaseType_t xTimerIsInActiveList;
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+
+	configASSERT( pxTimer );
+
+	/* A single word is read, so no critical section is needed. */
+	xTimerIsInActiveList = ( listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) ) != NULL ) ? pdTRUE : pdFALSE;
+
+	return xTimerIsInActiveList;
+}
+/*-----------------------------------------------------------*/
+
+void *pvTickTimerGetTimerID( TickTimerHandle_t xTimer )
+{
+TickTimer_t * const pxTimer = ( TickTimer_t * ) xTimer;
+
+	configASSERT( pxTimer );
+
+	return pxTimer->pvTimerID;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTickTimerIncrementTick( const TickType_t xTimeNow, const TickType_t xTicksElapsed )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE, xSwitchRequired = pdFALSE;
+TickType_t xSlotTime, xNextExpiryTime;
+UBaseType_t uxSlotsToCheck, uxExpiries = ( UBaseType_t ) 0U;
+List_t *pxSlot;
+ListItem_t *pxItem, *pxNextItem;
+TickTimer_t *pxTimer;
+
+	/* Called by the kernel, with interrupts masked or from the tick interrupt,
+	after the tick count has been incremented by xTicksElapsed to xTimeNow -
+	normally by 1, or by more when the tick has been suppressed.  Nothing needs
+	to be done if no timers are active. */
+	if( ( uxActiveTickTimers != ( UBaseType_t ) 0U ) && ( xTicksElapsed != ( TickType_t ) 0U ) )
+	{
+		/* Each elapsed tick maps to one slot, so no more than the whole wheel
+		needs to be checked however many ticks have elapsed. */
+		if( xTicksElapsed < ( TickType_t ) configTICK_TIMER_WHEEL_SIZE )
+		{
+			uxSlotsToCheck = ( UBaseType_t ) xTicksElapsed;
+		}
+		else
+		{
+			uxSlotsToCheck = ( UBaseType_t ) configTICK_TIMER_WHEEL_SIZE;
+		}
+
+		/* Move the timers that expired during the elapsed ticks to the expired
+		list, oldest slot first.  When one tick has elapsed the timers being
+		looked for are those whose expiry time equals xTimeNow. */
+		while( uxSlotsToCheck > ( UBaseType_t ) 0U )
+		{
+			uxSlotsToCheck--;
+			xSlotTime = xTimeNow - ( TickType_t ) uxSlotsToCheck;
+			pxSlot = &( xTickTimerWheel[ xSlotTime & tmrTICK_TIMER_WHEEL_MASK ] );
+
+			pxItem = listGET_HEAD_ENTRY( pxSlot );
+			while( pxItem != listGET_END_MARKER( pxSlot ) )
+			{
+				pxNextItem = listGET_NEXT( pxItem );
+
+				if( ( TickType_t ) ( xTimeNow - listGET_LIST_ITEM_VALUE( pxItem ) ) < xTicksElapsed )
+				{
+					( void ) uxListRemove( pxItem );
+					vListInsertEnd( &xExpiredTickTimerList, pxItem );
+				}
+				else
+				{
+					/* The timer expires on a later pass of the wheel. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxItem = pxNextItem;
+			}
+		}
+
+		/* Execute the callbacks.  Timers are removed from the expired list
+		before their callback executes, so a callback can start or stop any
+		timer, including its own. */
+		while( listLIST_IS_EMPTY( &xExpiredTickTimerList ) == pdFALSE )
+		{
+			#if ( configTICK_TIMER_MAX_EXPIRIES_PER_TICK > 0 )
+			{
+				if( uxExpiries >= ( UBaseType_t ) configTICK_TIMER_MAX_EXPIRIES_PER_TICK )
+				{
+					/* The remaining callbacks execute on the next tick. */
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configTICK_TIMER_MAX_EXPIRIES_PER_TICK */
+
+			pxTimer = ( TickTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTickTimerList );
+			prvRemoveTimer( pxTimer );
+
+			if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+			{
+				/* Re-arm relative to when the timer should have expired so the
+				period does not drift.  If the callback was deferred by a whole
+				period or more then re-arm relative to the current time instead. */
+				xNextExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) + pxTimer->xTimerPeriodInTicks;
+
+				if( ( TickType_t ) ( xNextExpiryTime - xTimeNow - ( TickType_t ) 1 ) >= pxTimer->xTimerPeriodInTicks )
+				{
+					xNextExpiryTime = xTimeNow + pxTimer->xTimerPeriodInTicks;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvInsertTimerInWheel( pxTimer, xNextExpiryTime );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceTICK_TIMER_EXPIRED( pxTimer );
+			pxTimer->pxCallbackFunction( ( TickTimerHandle_t ) pxTimer, &xHigherPriorityTaskWoken );
+
+			if( xHigherPriorityTaskWoken != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+				xHigherPriorityTaskWoken = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxExpiries++;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Prevent compiler warnings when configTICK_TIMER_MAX_EXPIRIES_PER_TICK is
+	0. */
+	( void ) uxExpiries;
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTickTimerGetExpectedIdleTime( const TickType_t xTimeNow )
+{
+TickType_t xReturn = portMAX_DELAY, xTicks;
+
+	if( uxActiveTickTimers == ( UBaseType_t ) 0U )
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+	else if( listLIST_IS_EMPTY( &xExpiredTickTimerList ) == pdFALSE )
+	{
+		/* Callbacks have been deferred to the next tick. */
+		xReturn = ( TickType_t ) 1U;
+	}
+	else
+	{
+		/* Find the next slot that references a timer.  The timer may not
+		expire until a later pass of the wheel, in which case the processor
+		wakes early, but no timer expiry can be missed. */
+		for( xTicks = ( TickType_t ) 1U; xTicks <= ( TickType_t ) configTICK_TIMER_WHEEL_SIZE; xTicks++ )
+		{
+			if( listLIST_IS_EMPTY( &( xTickTimerWheel[ ( xTimeNow + xTicks ) & tmrTICK_TIMER_WHEEL_MASK ] ) ) == pdFALSE )
+			{
+				xReturn = xTicks;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertTimerInWheel( TickTimer_t * const pxTimer, const TickType_t xExpiryTime )
+{
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+
+	/* The order of timers within a slot does not matter, so the timer is
+	inserted at the end rather than in expiry time order. */
+	vListInsertEnd( &( xTickTimerWheel[ xExpiryTime & tmrTICK_TIMER_WHEEL_MASK ] ), &( pxTimer->xTimerListItem ) );
+	( uxActiveTickTimers )++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimer( TickTimer_t * const pxTimer )
+{
+	if( listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) ) != NULL )
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		( uxActiveTickTimers )--;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckForValidListAndWheel( void )
+{
+UBaseType_t uxSlot;
+
+	taskENTER_CRITICAL();
+	{
+		if( xTickTimerListsInitialised == pdFALSE )
+		{
+			for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTICK_TIMER_WHEEL_SIZE; uxSlot++ )
+			{
+				vListInitialise( &( xTickTimerWheel[ uxSlot ] ) );
+			}
+
+			vListInitialise( &xExpiredTickTimerList );
+			xTickTimerListsInitialised = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include tick timer functionality.  If you want to include tick timers then
+ensure configUSE_TICK_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TICK_TIMERS == 1 */
+
@@ -76,6 +76,10 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	#include "registry.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -161,9 +165,21 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
+/* Timers that have been started, reset or had their period changed by the
+batch of commands being processed, but not yet inserted into an active list.
+A timer is only inserted into the (sorted) active list once per batch, however
+many commands in the batch reference it.  Only the timer service task is
+allowed to access this list. */
+PRIVILEGED_DATA static List_t xStagedTimerList;
+
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 
+/* The batch of commands most recently received from xTimerQueue.  There is
+only one timer service task, so the batch is held here rather than on its
+stack.  Only the timer service task is allowed to access this array. */
+PRIVILEGED_DATA static DaemonTaskMessage_t xReceivedMessages[ configTIMER_COMMAND_BATCH_LENGTH ];
+
 #if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 
 	PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
@@ -188,17 +204,44 @@ static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Called by the timer service task to interpret and process a command it
- * received on the timer queue.
+ * Called by the timer service task to receive and process the commands
+ * waiting on the timer queue, up to configTIMER_COMMAND_BATCH_LENGTH commands
+ * at a time.
  */
 static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Apply a single command received on the timer queue.  Timers that are started
+ * by the command are placed in xStagedTimerList rather than in an active list.
+ */
+static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the timers that were staged while a batch of commands was processed
+ * into the active timer lists.
+ */
+static void prvInsertStagedTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Returns pdTRUE if a timer that is to expire at xNextExpiryTime, following a
+ * command issued at xCommandTime, has already expired at xTimeNow - in which
+ * case it must be processed rather than inserted into an active list.
+ */
+static BaseType_t prvTimerExpiredBeforeInsertion( const Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Re-insert an auto reload timer that expired at xExpiredTime into an active
+ * list.  If the timer's next expiry time has also passed then its callback is
+ * called for each missed period.
+ */
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto reload timer, then call its callback.
@@ -231,6 +274,13 @@ static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIV
  */
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, const BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+	/*
+	 * Copies the state of a timer for the object registry.
+	 */
+	static void prvTimerGetSnapshot( void *pvTimer, ObjectSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 BaseType_t xTimerCreateTimerTask( void )
@@ -294,6 +344,12 @@ Timer_t *pxNewTimer;
 			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+			#if ( configUSE_OBJECT_REGISTRY == 1 )
+			{
+				( void ) xObjectRegistryAdd( pxNewTimer, registryTYPE_TIMER, pcTimerName, prvTimerGetSnapshot );
+			}
+			#endif /* configUSE_OBJECT_REGISTRY */
+
 			traceTIMER_CREATE( pxNewTimer );
 		}
 		else
@@ -365,7 +421,6 @@ DaemonTaskMessage_t xMessage;
 
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
-BaseType_t xResult;
 Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
 
 	/* Remove the timer from the list of active timers.  A check has already
@@ -380,18 +435,7 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 		/* The timer is inserted into a list using a time relative to anything
 		other than the current time.  It will therefore be inserted into the
 		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
 	}
 	else
 	{
@@ -531,11 +575,38 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
-BaseType_t xProcessTimerNow = pdFALSE;
+BaseType_t xProcessTimerNow;
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+	xProcessTimerNow = prvTimerExpiredBeforeInsertion( pxTimer, xNextExpiryTime, xTimeNow, xCommandTime );
+
+	if( xProcessTimerNow == pdFALSE )
+	{
+		if( xNextExpiryTime <= xTimeNow )
+		{
+			/* The expiry time has overflowed. */
+			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+		}
+		else
+		{
+			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTimerExpiredBeforeInsertion( const Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+BaseType_t xProcessTimerNow = pdFALSE;
+
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
@@ -548,7 +619,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
 	else
@@ -562,7 +633,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
 
@@ -570,127 +641,220 @@ BaseType_t xProcessTimerNow = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+	/* If the next expiry time has already passed then the timer expired
+	again before it could be reloaded.  Call its callback for each missed
+	period here, rather than sending a command back to the timer queue. */
+	while( prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
+	{
+		xExpiredTime += pxTimer->xTimerPeriodInTicks;
+		traceTIMER_EXPIRED( pxTimer );
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
-DaemonTaskMessage_t xMessage;
-Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
+UBaseType_t uxMessage, uxMessagesReceived;
+BaseType_t xTimerListsWereSwitched;
 TickType_t xTimeNow;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	do
 	{
-		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+		/* Receive a batch of commands before sampling the time.
+		prvSampleTimeNow() must be called after the messages are received from
+		xTimerQueue so there is no possibility of a higher priority task adding
+		a message to the message queue with a time that is ahead of the timer
+		daemon task (because it pre-empted the timer daemon task after the
+		xTimeNow value was set). */
+		for( uxMessagesReceived = ( UBaseType_t ) 0; uxMessagesReceived < ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH; uxMessagesReceived++ )
 		{
-			/* Negative commands are pended function calls rather than timer
-			commands. */
-			if( xMessage.xMessageID < 0 )
+			if( xQueueReceive( xTimerQueue, &( xReceivedMessages[ uxMessagesReceived ] ), tmrNO_DELAY ) == pdFAIL )
 			{
-				const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
-
-				/* The timer uses the xCallbackParameters member to request a
-				callback be executed.  Check the callback is not NULL. */
-				configASSERT( pxCallback );
-
-				/* Call the function. */
-				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				break;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		#endif /* INCLUDE_xTimerPendFunctionCall */
 
-		/* Commands that are positive are timer commands rather than pended
-		function calls. */
-		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+		if( uxMessagesReceived > ( UBaseType_t ) 0 )
 		{
-			/* The messages uses the xTimerParameters member to work on a
-			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			/* In this case the xTimerListsWereSwitched parameter is not used,
+			but it must be present in the function call.  The time is sampled
+			once for the whole batch. */
+			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+			for( uxMessage = ( UBaseType_t ) 0; uxMessage < uxMessagesReceived; uxMessage++ )
 			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
+				prvProcessCommand( &( xReceivedMessages[ uxMessage ] ), xTimeNow );
 			}
 
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+			/* Only now are the timers started by the batch inserted into the
+			sorted active lists, so a timer that was started, reset or stopped
+			several times within the batch is only inserted once, if at all. */
+			prvInsertStagedTimers( xTimeNow );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+	/* A full batch means there may be more commands waiting. */
+	} while( uxMessagesReceived == ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH );
+}
+/*-----------------------------------------------------------*/
 
-			switch( xMessage.xMessageID )
-			{
-				case tmrCOMMAND_START :
-			    case tmrCOMMAND_START_FROM_ISR :
-			    case tmrCOMMAND_RESET :
-			    case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) == pdTRUE )
+static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage, const TickType_t xTimeNow )
+{
+Timer_t *pxTimer;
+TickType_t xCommandTime;
+
+	#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+	{
+		/* Negative commands are pended function calls rather than timer
+		commands. */
+		if( pxMessage->xMessageID < 0 )
+		{
+			const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
+
+			/* The timer uses the xCallbackParameters member to request a
+			callback be executed.  Check the callback is not NULL. */
+			configASSERT( pxCallback );
+
+			/* Call the function. */
+			pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* INCLUDE_xTimerPendFunctionCall */
+
+	/* Commands that are positive are timer commands rather than pended
+	function calls. */
+	if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+	{
+		/* The messages uses the xTimerParameters member to work on a
+		software timer. */
+		pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+		{
+			/* The timer is in a list, remove it.  The list is either an
+			active list, or xStagedTimerList if an earlier command in the same
+			batch referenced the timer - in which case this command supersedes
+			the earlier one. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+		switch( pxMessage->xMessageID )
+		{
+			case tmrCOMMAND_START :
+		    case tmrCOMMAND_START_FROM_ISR :
+		    case tmrCOMMAND_RESET :
+		    case tmrCOMMAND_RESET_FROM_ISR :
+			case tmrCOMMAND_START_DONT_TRACE :
+				/* Start or restart a timer. */
+				xCommandTime = pxMessage->u.xTimerParameters.xMessageValue;
+
+				if( prvTimerExpiredBeforeInsertion( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime ) != pdFALSE )
+				{
+					/* The timer expired before it was added to the active
+					timer list.  Process it now. */
+					pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+					traceTIMER_EXPIRED( pxTimer );
+
+					if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
 					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
+						prvReloadTimer( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow );
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-					break;
-
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list.
-					There is nothing to do here. */
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can be
-					longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot be
-					zero the next expiry time can only be in the future, meaning
-					(unlike for the xTimerStart() case above) there is no fail case
-					that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					/* The timer has already been removed from the active list,
-					just free up the memory. */
-					vPortFree( pxTimer );
-					break;
-
-				default	:
-					/* Don't expect to get here. */
-					break;
-			}
+				}
+				else
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xCommandTime + pxTimer->xTimerPeriodInTicks );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsertEnd( &xStagedTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				break;
+
+			case tmrCOMMAND_STOP :
+			case tmrCOMMAND_STOP_FROM_ISR :
+				/* The timer has already been removed from the active list.
+				There is nothing to do here. */
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+			case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+				pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+				/* The new period does not really have a reference, and can be
+				longer or shorter than the old one.  The command time is
+				therefore set to the current time, and as the period cannot be
+				zero the next expiry time can only be in the future, meaning
+				(unlike for the xTimerStart() case above) there is no fail case
+				that needs to be handled here.  The timer is staged, like a
+				started timer, so it does not go back through the timer queue
+				or the sorted list more than once per batch. */
+				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xTimeNow + pxTimer->xTimerPeriodInTicks );
+				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+				vListInsertEnd( &xStagedTimerList, &( pxTimer->xTimerListItem ) );
+				break;
+
+			case tmrCOMMAND_DELETE :
+				/* The timer has already been removed from the active list,
+				just free up the memory. */
+				#if ( configUSE_OBJECT_REGISTRY == 1 )
+				{
+					vObjectRegistryRemove( pxTimer );
+				}
+				#endif /* configUSE_OBJECT_REGISTRY */
+				vPortFree( pxTimer );
+				break;
+
+			default	:
+				/* Don't expect to get here. */
+				break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertStagedTimers( const TickType_t xTimeNow )
+{
+Timer_t *pxTimer;
+
+	while( listLIST_IS_EMPTY( &xStagedTimerList ) == pdFALSE )
+	{
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xStagedTimerList );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+		/* Staged timers were checked for having already expired when they
+		were staged, using the same xTimeNow value, so only the list needs to
+		be selected here. */
+		if( listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) <= xTimeNow )
+		{
+			/* The expiry time has overflowed. */
+			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+		}
+		else
+		{
+			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 		}
 	}
 }
@@ -768,6 +932,7 @@ static void prvCheckForValidListAndQueue( void )
 			vListInitialise( &xActiveTimerList2 );
 			pxCurrentTimerList = &xActiveTimerList1;
 			pxOverflowTimerList = &xActiveTimerList2;
+			vListInitialise( &xStagedTimerList );
 			xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
 			configASSERT( xTimerQueue );
 
@@ -868,6 +1033,21 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 #endif /* INCLUDE_xTimerPendFunctionCall */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+	static void prvTimerGetSnapshot( void *pvTimer, ObjectSnapshot_t *pxSnapshot )
+	{
+	const Timer_t * const pxTimer = ( const Timer_t * ) pvTimer;
+
+		/* See xTimerIsTimerActive(). */
+		pxSnapshot->uxLevel = ( UBaseType_t ) !( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) );
+		pxSnapshot->uxCapacity = pxTimer->uxAutoReload;
+		pxSnapshot->xValue = pxTimer->xTimerPeriodInTicks;
+	}
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
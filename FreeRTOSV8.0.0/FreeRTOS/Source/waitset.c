@@ -0,0 +1,692 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "event_groups.h"
+#include "waitset.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not
+configured to include wait set functionality. */
+#if ( configUSE_WAIT_SETS == 1 )
+
+#if( configUSE_PREEMPTION == 0 )
+	/* If the cooperative scheduler is being used then a yield should not be
+	performed just because a higher priority task has been woken. */
+	#define waitsetYIELD_IF_USING_PREEMPTION()
+#else
+	#define waitsetYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* Bits used in the uxFlags member of a wait set member.  The bits below
+waitsetUSER_FLAGS_MASK are passed in by the application. */
+#define waitsetUSER_FLAGS_MASK			( ( UBaseType_t ) 0x0fU )
+#define waitsetMEMBER_IS_EVENT_GROUP	( ( UBaseType_t ) 0x10U )
+
+/* Records the membership of one object in a wait set.  The record is linked
+into the wait set's ready list while the object is, or might be, ready. */
+typedef struct xWAIT_SET_MEMBER
+{
+	ListItem_t xReadyListItem;			/*< Used to reference the member from the wait set's ready list. */
+	void *pvObject;						/*< The queue, semaphore, mutex or event group, or NULL if the record is not in use. */
+	void *pvUserData;					/*< Returned to the application each time the member is reported. */
+	EventBits_t uxBitsToWaitFor;		/*< Event groups only - the bits of interest. */
+	EventBits_t uxBitsSet;				/*< Edge triggered event groups only - the bits of interest set since the member was last reported. */
+	UBaseType_t uxFlags;
+	struct xWAIT_SET_DEFINITION *pxWaitSet;	/*< The wait set to which the member belongs. */
+} WaitSetMember_t;
+
+typedef struct xWAIT_SET_DEFINITION
+{
+	List_t xReadyMembers;				/*< Members that have been posted to since they were last found not to be ready. */
+	List_t xTasksWaitingForEvents;		/*< Tasks blocked in uxWaitSetWait().  Stored in priority order. */
+	EventBits_t uxNotifiedBits;			/*< Bits set by xWaitSetNotify() that have not yet been reported. */
+	UBaseType_t uxMaxMembers;
+	WaitSetMember_t xMembers[ 1 ];		/*< The structure is allocated with space for uxMaxMembers members. */
+} WaitSet_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add pvObject to the wait set.  Implements both xWaitSetAddQueue() and
+ * xWaitSetAddEventGroup().
+ */
+static BaseType_t prvAddMember( WaitSet_t * const pxWaitSet, void *pvObject, const EventBits_t uxBitsToWaitFor, const UBaseType_t uxFlags, void *pvUserData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Tell the object that it is, or is no longer (pvWaitSetMember is NULL), a
+ * member of a wait set.  Must be called with interrupts masked.
+ */
+static BaseType_t prvAttachObject( WaitSetMember_t * const pxMember, void *pvWaitSetMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlink a member from the ready list and mark its record as free.  Must be
+ * called with interrupts masked.
+ */
+static void prvReleaseMember( WaitSetMember_t * const pxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if a read from the member would succeed now (level triggered
+ * readiness), and writes the event group bits of interest that are set to
+ * *puxBits.  Must be called with interrupts masked.
+ */
+static BaseType_t prvIsMemberReady( const WaitSetMember_t * const pxMember, EventBits_t * const puxBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the highest priority task waiting on the wait set, if any.  Must be
+ * called with interrupts masked.  Returns pdTRUE if the unblocked task has a
+ * priority above that of the calling task.
+ */
+static BaseType_t prvUnblockWaitingTask( WaitSet_t * const pxWaitSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fill pxEvents with up to uxMaxEvents events from the wait set's ready list,
+ * and return the number of events written.  Level triggered members that are
+ * still ready remain in the ready list, but are moved to its end.  Must be
+ * called from within a critical section.
+ */
+static UBaseType_t prvCollectEvents( WaitSet_t * const pxWaitSet, WaitSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+WaitSetHandle_t xWaitSetCreate( const UBaseType_t uxMaxMembers )
+{
+WaitSet_t *pxWaitSet;
+UBaseType_t uxMember;
+
+	configASSERT( uxMaxMembers > ( UBaseType_t ) 0 );
+
+	pxWaitSet = ( WaitSet_t * ) pvPortMalloc( sizeof( WaitSet_t ) + ( ( uxMaxMembers - ( UBaseType_t ) 1 ) * sizeof( WaitSetMember_t ) ) );
+
+	if( pxWaitSet != NULL )
+	{
+		vListInitialise( &( pxWaitSet->xReadyMembers ) );
+		vListInitialise( &( pxWaitSet->xTasksWaitingForEvents ) );
+		pxWaitSet->uxNotifiedBits = ( EventBits_t ) 0;
+		pxWaitSet->uxMaxMembers = uxMaxMembers;
+
+		for( uxMember = ( UBaseType_t ) 0; uxMember < uxMaxMembers; uxMember++ )
+		{
+			vListInitialiseItem( &( pxWaitSet->xMembers[ uxMember ].xReadyListItem ) );
+			listSET_LIST_ITEM_OWNER( &( pxWaitSet->xMembers[ uxMember ].xReadyListItem ), &( pxWaitSet->xMembers[ uxMember ] ) );
+			pxWaitSet->xMembers[ uxMember ].pvObject = NULL;
+			pxWaitSet->xMembers[ uxMember ].pxWaitSet = pxWaitSet;
+		}
+
+		traceWAIT_SET_CREATE( pxWaitSet );
+	}
+	else
+	{
+		traceWAIT_SET_CREATE_FAILED();
+	}
+
+	return ( WaitSetHandle_t ) pxWaitSet;
+}
+/*-----------------------------------------------------------*/
+
+void vWaitSetDelete( WaitSetHandle_t xWaitSet )
+{
+WaitSet_t * const pxWaitSet = ( WaitSet_t * ) xWaitSet;
+UBaseType_t uxMember;
+
+	configASSERT( pxWaitSet );
+	configASSERT( listLIST_IS_EMPTY( &( pxWaitSet->xTasksWaitingForEvents ) ) != pdFALSE );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxMember = ( UBaseType_t ) 0; uxMember < pxWaitSet->uxMaxMembers; uxMember++ )
+		{
+			if( pxWaitSet->xMembers[ uxMember ].pvObject != NULL )
+			{
+				( void ) prvAttachObject( &( pxWaitSet->xMembers[ uxMember ] ), NULL );
+				prvReleaseMember( &( pxWaitSet->xMembers[ uxMember ] ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	vPortFree( pxWaitSet );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet, QueueHandle_t xQueueOrSemaphore, UBaseType_t uxFlags, void *pvUserData )
+{
+	configASSERT( xQueueOrSemaphore );
+	configASSERT( ( uxFlags & ~waitsetUSER_FLAGS_MASK ) == ( UBaseType_t ) 0 );
+
+	return prvAddMember( ( WaitSet_t * ) xWaitSet, ( void * ) xQueueOrSemaphore, ( EventBits_t ) 0, uxFlags, pvUserData );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet, EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, UBaseType_t uxFlags, void *pvUserData )
+{
+	configASSERT( xEventGroup );
+	configASSERT( uxBitsToWaitFor != ( EventBits_t ) 0 );
+	configASSERT( ( uxFlags & ~waitsetUSER_FLAGS_MASK ) == ( UBaseType_t ) 0 );
+
+	return prvAddMember( ( WaitSet_t * ) xWaitSet, ( void * ) xEventGroup, uxBitsToWaitFor, uxFlags | waitsetMEMBER_IS_EVENT_GROUP, pvUserData );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAddMember( WaitSet_t * const pxWaitSet, void *pvObject, const EventBits_t uxBitsToWaitFor, const UBaseType_t uxFlags, void *pvUserData )
+{
+WaitSetMember_t *pxMember = NULL;
+UBaseType_t uxMember;
+EventBits_t uxBits;
+BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+
+	configASSERT( pxWaitSet );
+
+	taskENTER_CRITICAL();
+	{
+		/* Find a free member record. */
+		for( uxMember = ( UBaseType_t ) 0; uxMember < pxWaitSet->uxMaxMembers; uxMember++ )
+		{
+			if( pxWaitSet->xMembers[ uxMember ].pvObject == NULL )
+			{
+				pxMember = &( pxWaitSet->xMembers[ uxMember ] );
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxMember != NULL )
+		{
+			pxMember->pvObject = pvObject;
+			pxMember->pvUserData = pvUserData;
+			pxMember->uxBitsToWaitFor = uxBitsToWaitFor;
+			pxMember->uxBitsSet = ( EventBits_t ) 0;
+			pxMember->uxFlags = uxFlags;
+
+			if( prvAttachObject( pxMember, ( void * ) pxMember ) != pdFALSE )
+			{
+				xReturn = pdPASS;
+
+				/* An object that is already ready is reported by the next
+				call to uxWaitSetWait(), whether it is level or edge
+				triggered. */
+				if( prvIsMemberReady( pxMember, &uxBits ) != pdFALSE )
+				{
+					xYieldRequired = xWaitSetSignalMember( ( void * ) pxMember, uxBits );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The object already belongs to a wait set or queue set. */
+				pxMember->pvObject = NULL;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		waitsetYIELD_IF_USING_PREEMPTION();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetRemove( WaitSetHandle_t xWaitSet, void *pvObject )
+{
+WaitSet_t * const pxWaitSet = ( WaitSet_t * ) xWaitSet;
+UBaseType_t uxMember;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxWaitSet );
+	configASSERT( pvObject );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxMember = ( UBaseType_t ) 0; uxMember < pxWaitSet->uxMaxMembers; uxMember++ )
+		{
+			if( pxWaitSet->xMembers[ uxMember ].pvObject == pvObject )
+			{
+				( void ) prvAttachObject( &( pxWaitSet->xMembers[ uxMember ] ), NULL );
+				prvReleaseMember( &( pxWaitSet->xMembers[ uxMember ] ) );
+				xReturn = pdPASS;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxWaitSetWait( WaitSetHandle_t xWaitSet, WaitSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents, TickType_t xTicksToWait )
+{
+WaitSet_t * const pxWaitSet = ( WaitSet_t * ) xWaitSet;
+UBaseType_t uxEventCount;
+BaseType_t xEntryTimeSet = pdFALSE, xBlocked;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxWaitSet );
+	configASSERT( pxEvents );
+	configASSERT( uxMaxEvents > ( UBaseType_t ) 0 );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		xBlocked = pdFALSE;
+
+		/* The ready list and the list of waiting tasks are updated from
+		interrupts, so they are only accessed with interrupts masked.  That
+		also allows the calling task to be placed on the event list without
+		suspending the scheduler or locking each member. */
+		taskENTER_CRITICAL();
+		{
+			uxEventCount = prvCollectEvents( pxWaitSet, pxEvents, uxMaxEvents );
+
+			if( ( uxEventCount == ( UBaseType_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+			{
+				if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					traceBLOCKING_ON_WAIT_SET( pxWaitSet );
+					vTaskPlaceOnEventList( &( pxWaitSet->xTasksWaitingForEvents ), xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlocked != pdFALSE )
+		{
+			/* Wait for a member to be posted to, or for the block time to
+			expire, then look at the ready list again. */
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return uxEventCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetNotify( WaitSetHandle_t xWaitSet, const EventBits_t uxBitsToSet )
+{
+WaitSet_t * const pxWaitSet = ( WaitSet_t * ) xWaitSet;
+
+	configASSERT( pxWaitSet );
+	configASSERT( uxBitsToSet != ( EventBits_t ) 0 );
+
+	taskENTER_CRITICAL();
+	{
+		pxWaitSet->uxNotifiedBits |= uxBitsToSet;
+
+		if( prvUnblockWaitingTask( pxWaitSet ) != pdFALSE )
+		{
+			/* Yes it is ok to do this from within the critical section - the
+			kernel takes care of that. */
+			waitsetYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetNotifyFromISR( WaitSetHandle_t xWaitSet, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+{
+WaitSet_t * const pxWaitSet = ( WaitSet_t * ) xWaitSet;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxWaitSet );
+	configASSERT( uxBitsToSet != ( EventBits_t ) 0 );
+
+	/* See the comments in xQueueGenericSendFromISR() regarding interrupt
+	priorities. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxWaitSet->uxNotifiedBits |= uxBitsToSet;
+
+		if( prvUnblockWaitingTask( pxWaitSet ) != pdFALSE )
+		{
+			if( pxHigherPriorityTaskWoken != NULL )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWaitSetSignalMember( void *pvWaitSetMember, const EventBits_t uxBitsSet )
+{
+WaitSetMember_t * const pxMember = ( WaitSetMember_t * ) pvWaitSetMember;
+WaitSet_t * const pxWaitSet = pxMember->pxWaitSet;
+EventBits_t uxBitsOfInterest = ( EventBits_t ) 0;
+BaseType_t xReturn = pdFALSE;
+
+	/* Event groups only signal the wait set when a bit of interest was
+	set. */
+	if( ( pxMember->uxFlags & waitsetMEMBER_IS_EVENT_GROUP ) != ( UBaseType_t ) 0 )
+	{
+		uxBitsOfInterest = uxBitsSet & pxMember->uxBitsToWaitFor;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ( ( pxMember->uxFlags & waitsetMEMBER_IS_EVENT_GROUP ) == ( UBaseType_t ) 0 ) || ( uxBitsOfInterest != ( EventBits_t ) 0 ) )
+	{
+		pxMember->uxBitsSet |= uxBitsOfInterest;
+
+		/* A member that is already in the ready list does not need to be
+		linked in again, which is what makes repeated posts to the same
+		member cheap. */
+		if( listIS_CONTAINED_WITHIN( &( pxWaitSet->xReadyMembers ), &( pxMember->xReadyListItem ) ) == pdFALSE )
+		{
+			vListInsertEnd( &( pxWaitSet->xReadyMembers ), &( pxMember->xReadyListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = prvUnblockWaitingTask( pxWaitSet );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vWaitSetDetachMember( void *pvWaitSetMember )
+{
+	/* The object is being deleted so does not need to be told it is no
+	longer a member. */
+	taskENTER_CRITICAL();
+	{
+		prvReleaseMember( ( WaitSetMember_t * ) pvWaitSetMember );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAttachObject( WaitSetMember_t * const pxMember, void *pvWaitSetMember )
+{
+BaseType_t xReturn;
+
+	if( ( pxMember->uxFlags & waitsetMEMBER_IS_EVENT_GROUP ) != ( UBaseType_t ) 0 )
+	{
+		xReturn = xEventGroupAttachWaitSetMember( ( EventGroupHandle_t ) pxMember->pvObject, pvWaitSetMember );
+	}
+	else
+	{
+		xReturn = xQueueAttachWaitSetMember( ( QueueHandle_t ) pxMember->pvObject, pvWaitSetMember );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseMember( WaitSetMember_t * const pxMember )
+{
+	if( listIS_CONTAINED_WITHIN( &( pxMember->pxWaitSet->xReadyMembers ), &( pxMember->xReadyListItem ) ) != pdFALSE )
+	{
+		( void ) uxListRemove( &( pxMember->xReadyListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxMember->pvObject = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsMemberReady( const WaitSetMember_t * const pxMember, EventBits_t * const puxBits )
+{
+BaseType_t xReturn;
+
+	if( ( pxMember->uxFlags & waitsetMEMBER_IS_EVENT_GROUP ) != ( UBaseType_t ) 0 )
+	{
+		*puxBits = xEventGroupGetBitsFromISR( ( EventGroupHandle_t ) pxMember->pvObject ) & pxMember->uxBitsToWaitFor;
+		xReturn = ( *puxBits != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		/* Data in a queue, or an available semaphore or mutex. */
+		*puxBits = ( EventBits_t ) 0;
+		xReturn = ( uxQueueMessagesWaitingFromISR( ( QueueHandle_t ) pxMember->pvObject ) != ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTask( WaitSet_t * const pxWaitSet )
+{
+BaseType_t xReturn = pdFALSE;
+
+	if( listLIST_IS_EMPTY( &( pxWaitSet->xTasksWaitingForEvents ) ) == pdFALSE )
+	{
+		xReturn = xTaskRemoveFromEventList( &( pxWaitSet->xTasksWaitingForEvents ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCollectEvents( WaitSet_t * const pxWaitSet, WaitSetEvent_t * const pxEvents, const UBaseType_t uxMaxEvents )
+{
+UBaseType_t uxEventCount = ( UBaseType_t ) 0, uxToInspect;
+WaitSetMember_t *pxMember;
+EventBits_t uxBits;
+
+	if( pxWaitSet->uxNotifiedBits != ( EventBits_t ) 0 )
+	{
+		pxEvents[ uxEventCount ].pvObject = ( void * ) pxWaitSet;
+		pxEvents[ uxEventCount ].pvUserData = NULL;
+		pxEvents[ uxEventCount ].uxEventBits = pxWaitSet->uxNotifiedBits;
+		pxWaitSet->uxNotifiedBits = ( EventBits_t ) 0;
+		uxEventCount++;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Each member is inspected at most once, as level triggered members that
+	are still ready are moved to the end of the list. */
+	uxToInspect = listCURRENT_LIST_LENGTH( &( pxWaitSet->xReadyMembers ) );
+
+	while( ( uxToInspect > ( UBaseType_t ) 0 ) && ( uxEventCount < uxMaxEvents ) )
+	{
+		uxToInspect--;
+
+		pxMember = ( WaitSetMember_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxWaitSet->xReadyMembers ) );
+		( void ) uxListRemove( &( pxMember->xReadyListItem ) );
+
+		if( ( pxMember->uxFlags & waitsetEDGE_TRIGGERED ) != ( UBaseType_t ) 0 )
+		{
+			/* Edge triggered members are reported once per signal, whatever
+			their state now. */
+			pxEvents[ uxEventCount ].pvObject = pxMember->pvObject;
+			pxEvents[ uxEventCount ].pvUserData = pxMember->pvUserData;
+			pxEvents[ uxEventCount ].uxEventBits = pxMember->uxBitsSet;
+			pxMember->uxBitsSet = ( EventBits_t ) 0;
+			uxEventCount++;
+		}
+		else if( prvIsMemberReady( pxMember, &uxBits ) != pdFALSE )
+		{
+			pxEvents[ uxEventCount ].pvObject = pxMember->pvObject;
+			pxEvents[ uxEventCount ].pvUserData = pxMember->pvUserData;
+			pxEvents[ uxEventCount ].uxEventBits = uxBits;
+			uxEventCount++;
+
+			/* Still ready, so keep it in the ready list - behind the members
+			that have not yet been reported. */
+			vListInsertEnd( &( pxWaitSet->xReadyMembers ), &( pxMember->xReadyListItem ) );
+		}
+		else
+		{
+			/* No longer ready, so leave it out of the ready list until it is
+			next posted to. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxEventCount;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include wait set functionality.  If you want to include wait sets then
+ensure configUSE_WAIT_SETS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_WAIT_SETS == 1 */
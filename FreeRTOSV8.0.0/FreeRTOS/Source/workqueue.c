@@ -0,0 +1,845 @@
+/*
+    FreeRTOS V8.0.0 - Copyright (C) 2014 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+
+    1 tab == 4 spaces!
+
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "workqueue.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if ( configUSE_COUNTING_SEMAPHORES == 0 )
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h to use work queues.
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle == 0 )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 in FreeRTOSConfig.h to use work queues.
+#endif
+
+/* The maximum count of the semaphore that counts the work items waiting to
+execute.  Work items are allocated by the application so the count is
+effectively unbounded. */
+#define workqueueMAX_ITEM_COUNT		( ( UBaseType_t ) ~( ( UBaseType_t ) 0U ) )
+
+/* Evaluates to pdTRUE if no work items are delayed, waiting in a worker list
+or executing.  Must be used from within a critical section. */
+#define workqueueIS_EMPTY( pxWorkQueue )																			\
+	( ( ( ( pxWorkQueue )->uxOutstandingItems == ( UBaseType_t ) 0 ) &&												\
+		( listLIST_IS_EMPTY( &( ( pxWorkQueue )->xDelayedItemList1 ) ) != pdFALSE ) &&								\
+		( listLIST_IS_EMPTY( &( ( pxWorkQueue )->xDelayedItemList2 ) ) != pdFALSE ) ) ? pdTRUE : pdFALSE )
+
+/* Structure that holds the state of each worker task. */
+typedef struct xWORK_QUEUE_WORKER
+{
+	List_t xWorkList;					/*< Work items waiting to be executed by this worker.  The worker takes items from the head, other workers steal from the tail. */
+	TaskHandle_t xTask;					/*< The worker task itself. */
+	void *pvOwner;						/*< The work queue to which the worker belongs. */
+} Worker_t;
+
+typedef struct xWORK_QUEUE_DEFINITION
+{
+	SemaphoreHandle_t xItemsAvailable;	/*< Counts the work items waiting in the worker lists.  Idle workers block on this semaphore. */
+	SemaphoreHandle_t xFlushed;			/*< Given when the work queue becomes empty - see workqueueIS_EMPTY(). */
+	List_t xDelayedItemList1;			/*< Delayed work items are referenced from two lists, one for items that become ready before the tick count overflows, and one for items that become ready after. */
+	List_t xDelayedItemList2;
+	List_t *pxDelayedItemList;			/*< Points to whichever delayed list is currently in use. */
+	List_t *pxOverflowDelayedItemList;	/*< Points to the delayed list that holds items that become ready after the tick count has overflowed. */
+	TickType_t xLastTime;				/*< The tick count the last time the delayed lists were checked - used to detect the tick count overflowing. */
+	volatile UBaseType_t uxOutstandingItems; /*< The number of items that are waiting in a worker list or are executing. */
+	UBaseType_t uxNextWorker;			/*< The worker to which the next work item submitted from outside of the work queue will be given. */
+	UBaseType_t uxNumberOfWorkers;
+	Worker_t xWorkers[ 1 ];				/*< The structure is allocated with space for uxNumberOfWorkers workers. */
+} WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that executes work items.  One instance is created for each worker.
+ */
+static void prvWorkerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the worker structure of the calling task if the calling task is a
+ * worker of pxWorkQueue, otherwise return NULL.
+ */
+static Worker_t *prvGetCallingWorker( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place a work item into a worker list.  Must be called from within a
+ * critical section (or with interrupts masked).  Work items submitted from
+ * outside of the work queue are given to each worker in turn.
+ */
+static void prvAddItemToWorker( WorkQueue_t * const pxWorkQueue, Worker_t *pxWorker, WorkItem_t * const pxWorkItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the next work item to be executed by pxWorker.  If pxWorker's own
+ * list is empty a work item is stolen from the worker that has the most items
+ * waiting.  Returns NULL if there are no work items waiting anywhere.
+ */
+static WorkItem_t *prvTakeItem( WorkQueue_t * const pxWorkQueue, Worker_t * const pxWorker ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move any delayed work items that have become ready into the worker lists,
+ * then return the number of ticks until the next delayed item becomes ready.
+ */
+static TickType_t prvProcessDelayedItems( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sample the tick count, and switch the delayed lists if the tick count has
+ * overflowed since it was last sampled.  All the items remaining in the
+ * current delayed list when the tick count overflows are ready, and are moved
+ * into the worker lists.  Must be called from within a critical section.  The
+ * number of work items moved is added to *puxItemsMoved.
+ */
+static TickType_t prvSampleTimeNow( WorkQueue_t * const pxWorkQueue, UBaseType_t * const puxItemsMoved ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, UBaseType_t uxNumberOfWorkers, UBaseType_t uxPriority, uint16_t usStackDepth ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+WorkQueue_t *pxWorkQueue;
+UBaseType_t uxWorker;
+BaseType_t xReturn = pdPASS;
+
+	configASSERT( uxNumberOfWorkers > ( UBaseType_t ) 0 );
+
+	pxWorkQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) + ( ( uxNumberOfWorkers - ( UBaseType_t ) 1 ) * sizeof( Worker_t ) ) );
+
+	if( pxWorkQueue != NULL )
+	{
+		pxWorkQueue->xItemsAvailable = xSemaphoreCreateCounting( workqueueMAX_ITEM_COUNT, ( UBaseType_t ) 0 );
+		pxWorkQueue->xFlushed = xSemaphoreCreateBinary();
+
+		if( ( pxWorkQueue->xItemsAvailable != NULL ) && ( pxWorkQueue->xFlushed != NULL ) )
+		{
+			vListInitialise( &( pxWorkQueue->xDelayedItemList1 ) );
+			vListInitialise( &( pxWorkQueue->xDelayedItemList2 ) );
+			pxWorkQueue->pxDelayedItemList = &( pxWorkQueue->xDelayedItemList1 );
+			pxWorkQueue->pxOverflowDelayedItemList = &( pxWorkQueue->xDelayedItemList2 );
+			pxWorkQueue->xLastTime = xTaskGetTickCount();
+			pxWorkQueue->uxOutstandingItems = ( UBaseType_t ) 0;
+			pxWorkQueue->uxNextWorker = ( UBaseType_t ) 0;
+			pxWorkQueue->uxNumberOfWorkers = uxNumberOfWorkers;
+
+			/* Initialise every worker before any worker task is created as
+			a worker task that runs immediately may attempt to steal from the
+			other workers. */
+			for( uxWorker = ( UBaseType_t ) 0; uxWorker < uxNumberOfWorkers; uxWorker++ )
+			{
+				vListInitialise( &( pxWorkQueue->xWorkers[ uxWorker ].xWorkList ) );
+				pxWorkQueue->xWorkers[ uxWorker ].xTask = NULL;
+				pxWorkQueue->xWorkers[ uxWorker ].pvOwner = ( void * ) pxWorkQueue;
+			}
+
+			for( uxWorker = ( UBaseType_t ) 0; uxWorker < uxNumberOfWorkers; uxWorker++ )
+			{
+				xReturn = xTaskCreate( prvWorkerTask, pcName, usStackDepth, ( void * ) &( pxWorkQueue->xWorkers[ uxWorker ] ), uxPriority, &( pxWorkQueue->xWorkers[ uxWorker ].xTask ) );
+
+				if( xReturn != pdPASS )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		if( xReturn != pdPASS )
+		{
+			/* Nothing can have been submitted to the work queue yet, so it is
+			safe to delete whatever was created. */
+			#if ( INCLUDE_vTaskDelete == 1 )
+			{
+				for( uxWorker = ( UBaseType_t ) 0; uxWorker < uxNumberOfWorkers; uxWorker++ )
+				{
+					if( pxWorkQueue->xWorkers[ uxWorker ].xTask != NULL )
+					{
+						vTaskDelete( pxWorkQueue->xWorkers[ uxWorker ].xTask );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#else
+			{
+				/* Worker tasks cannot be deleted, so the work queue structure
+				cannot be freed if any worker task was created. */
+				configASSERT( pxWorkQueue->xWorkers[ 0 ].xTask == NULL );
+			}
+			#endif /* INCLUDE_vTaskDelete */
+
+			if( pxWorkQueue->xItemsAvailable != NULL )
+			{
+				vSemaphoreDelete( pxWorkQueue->xItemsAvailable );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxWorkQueue->xFlushed != NULL )
+			{
+				vSemaphoreDelete( pxWorkQueue->xFlushed );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vPortFree( pxWorkQueue );
+			pxWorkQueue = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxWorkQueue != NULL )
+	{
+		traceWORK_QUEUE_CREATE( pxWorkQueue );
+	}
+	else
+	{
+		traceWORK_QUEUE_CREATE_FAILED();
+	}
+
+	return ( WorkQueueHandle_t ) pxWorkQueue;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkItemInitialise( WorkItem_t * const pxWorkItem, WorkFunction_t pxFunction, void *pvParameter )
+{
+	configASSERT( pxWorkItem );
+	configASSERT( pxFunction );
+
+	vListInitialiseItem( &( pxWorkItem->xWorkListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxWorkItem->xWorkListItem ), pxWorkItem );
+	pxWorkItem->pxFunction = pxFunction;
+	pxWorkItem->pvParameter = pvParameter;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitDelayed( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem, TickType_t xTicksToDelay )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+Worker_t *pxWorker;
+BaseType_t xReturn;
+TickType_t xTimeNow, xTimeToRun;
+UBaseType_t uxItemsToSignal = ( UBaseType_t ) 0;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkItem );
+
+	/* Work submitted by a function that is already executing in the work
+	queue stays with the worker that is executing the function. */
+	pxWorker = prvGetCallingWorker( pxWorkQueue );
+
+	taskENTER_CRITICAL();
+	{
+		if( listLIST_ITEM_CONTAINER( &( pxWorkItem->xWorkListItem ) ) != NULL )
+		{
+			/* The work item is already waiting to execute. */
+			xReturn = pdFAIL;
+		}
+		else if( xTicksToDelay == ( TickType_t ) 0 )
+		{
+			prvAddItemToWorker( pxWorkQueue, pxWorker, pxWorkItem );
+			uxItemsToSignal++;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xTimeNow = prvSampleTimeNow( pxWorkQueue, &uxItemsToSignal );
+			xTimeToRun = xTimeNow + xTicksToDelay;
+			listSET_LIST_ITEM_VALUE( &( pxWorkItem->xWorkListItem ), xTimeToRun );
+
+			if( xTimeToRun < xTimeNow )
+			{
+				/* The ready time has overflowed. */
+				vListInsert( pxWorkQueue->pxOverflowDelayedItemList, &( pxWorkItem->xWorkListItem ) );
+			}
+			else
+			{
+				vListInsert( pxWorkQueue->pxDelayedItemList, &( pxWorkItem->xWorkListItem ) );
+
+				if( listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItemList ) == ( void * ) pxWorkItem )
+				{
+					/* The new item becomes ready before any other delayed item,
+					so wake a worker to recalculate the time at which it next
+					needs to check the delayed list.  The worker tolerates
+					waking when there is no work to take. */
+					uxItemsToSignal++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	while( uxItemsToSignal > ( UBaseType_t ) 0 )
+	{
+		( void ) xSemaphoreGive( pxWorkQueue->xItemsAvailable );
+		uxItemsToSignal--;
+	}
+
+	traceWORK_ITEM_SUBMIT( xWorkQueue, pxWorkItem, xTicksToDelay, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkItem );
+
+	/* See the comments in xQueueGenericSendFromISR() regarding the interrupt
+	priorities from which this function can be called. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( listLIST_ITEM_CONTAINER( &( pxWorkItem->xWorkListItem ) ) != NULL )
+		{
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			prvAddItemToWorker( pxWorkQueue, NULL, pxWorkItem );
+			xReturn = pdPASS;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		( void ) xSemaphoreGiveFromISR( pxWorkQueue->xItemsAvailable, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceWORK_ITEM_SUBMIT_FROM_ISR( xWorkQueue, pxWorkItem, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue, WorkItem_t * const pxWorkItem )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+BaseType_t xReturn = pdFAIL, xWasReady = pdFALSE, xIsEmpty = pdFALSE;
+void *pvContainer;
+
+	configASSERT( pxWorkQueue );
+	configASSERT( pxWorkItem );
+
+	taskENTER_CRITICAL();
+	{
+		pvContainer = listLIST_ITEM_CONTAINER( &( pxWorkItem->xWorkListItem ) );
+
+		if( pvContainer != NULL )
+		{
+			if( ( pvContainer != ( void * ) &( pxWorkQueue->xDelayedItemList1 ) ) && ( pvContainer != ( void * ) &( pxWorkQueue->xDelayedItemList2 ) ) )
+			{
+				/* The item is in a worker list, so is counted as outstanding. */
+				xWasReady = pdTRUE;
+				( pxWorkQueue->uxOutstandingItems )--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+			xIsEmpty = workqueueIS_EMPTY( pxWorkQueue );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xWasReady != pdFALSE )
+	{
+		/* Remove the count that was given for the cancelled item.  If a
+		worker has already taken the count then the worker will find one less
+		item than it expects, which it tolerates. */
+		( void ) xSemaphoreTake( pxWorkQueue->xItemsAvailable, ( TickType_t ) 0 );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xIsEmpty != pdFALSE )
+	{
+		/* The cancelled item was the last one a flush could be waiting for. */
+		( void ) xSemaphoreGive( pxWorkQueue->xFlushed );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceWORK_ITEM_CANCEL( xWorkQueue, pxWorkItem, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueFlush( WorkQueueHandle_t xWorkQueue, TickType_t xTicksToWait )
+{
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+TimeOut_t xTimeOut;
+BaseType_t xReturn = pdFAIL, xIsEmpty;
+
+	configASSERT( pxWorkQueue );
+
+	/* A function executing in the work queue would wait for itself. */
+	configASSERT( prvGetCallingWorker( pxWorkQueue ) == NULL );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			xIsEmpty = workqueueIS_EMPTY( pxWorkQueue );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xIsEmpty != pdFALSE )
+		{
+			/* Pass the semaphore on in case more than one task is flushing
+			the work queue. */
+			( void ) xSemaphoreGive( pxWorkQueue->xFlushed );
+			xReturn = pdPASS;
+			break;
+		}
+		else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			break;
+		}
+		else
+		{
+			/* The semaphore may have been given by a previous flush, so the
+			work queue is tested again each time it is obtained. */
+			( void ) xSemaphoreTake( pxWorkQueue->xFlushed, xTicksToWait );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	BaseType_t xWorkQueueDelete( WorkQueueHandle_t xWorkQueue )
+	{
+	WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) xWorkQueue;
+	BaseType_t xReturn;
+	UBaseType_t uxWorker;
+
+		configASSERT( pxWorkQueue );
+
+		/* A worker cannot delete itself along with the work queue. */
+		configASSERT( prvGetCallingWorker( pxWorkQueue ) == NULL );
+
+		/* The scheduler is suspended so no worker can run between the work
+		queue being found empty and the worker tasks being deleted.  While the
+		work queue is empty every worker is either blocked on xItemsAvailable
+		or has been pre-empted after completing its last work item, and none
+		of them is inside a critical section, so each can be deleted where it
+		is. */
+		vTaskSuspendAll();
+		{
+			taskENTER_CRITICAL();
+			{
+				xReturn = workqueueIS_EMPTY( pxWorkQueue );
+			}
+			taskEXIT_CRITICAL();
+
+			if( xReturn != pdFALSE )
+			{
+				for( uxWorker = ( UBaseType_t ) 0; uxWorker < pxWorkQueue->uxNumberOfWorkers; uxWorker++ )
+				{
+					vTaskDelete( pxWorkQueue->xWorkers[ uxWorker ].xTask );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( xReturn != pdFALSE )
+		{
+			traceWORK_QUEUE_DELETE( pxWorkQueue );
+
+			vSemaphoreDelete( pxWorkQueue->xItemsAvailable );
+			vSemaphoreDelete( pxWorkQueue->xFlushed );
+			vPortFree( pxWorkQueue );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+Worker_t * const pxWorker = ( Worker_t * ) pvParameters;
+WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) pxWorker->pvOwner;
+WorkItem_t *pxWorkItem;
+TickType_t xTicksToWait;
+BaseType_t xCompleted;
+
+	for( ;; )
+	{
+		xTicksToWait = prvProcessDelayedItems( pxWorkQueue );
+
+		if( xSemaphoreTake( pxWorkQueue->xItemsAvailable, xTicksToWait ) != pdFALSE )
+		{
+			pxWorkItem = prvTakeItem( pxWorkQueue, pxWorker );
+
+			if( pxWorkItem != NULL )
+			{
+				/* The item has been removed from the worker list so it can be
+				submitted again from within its own function. */
+				pxWorkItem->pxFunction( pxWorkItem->pvParameter );
+
+				taskENTER_CRITICAL();
+				{
+					( pxWorkQueue->uxOutstandingItems )--;
+					xCompleted = workqueueIS_EMPTY( pxWorkQueue );
+				}
+				taskEXIT_CRITICAL();
+
+				if( xCompleted != pdFALSE )
+				{
+					( void ) xSemaphoreGive( pxWorkQueue->xFlushed );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Either the semaphore was given to prompt the delayed list
+				to be checked, or another worker already took the item. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* The block time expired, so a delayed item may be ready. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static Worker_t *prvGetCallingWorker( WorkQueue_t * const pxWorkQueue )
+{
+TaskHandle_t xCurrentTask;
+Worker_t *pxReturn = NULL;
+UBaseType_t uxWorker;
+
+	xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	for( uxWorker = ( UBaseType_t ) 0; uxWorker < pxWorkQueue->uxNumberOfWorkers; uxWorker++ )
+	{
+		if( pxWorkQueue->xWorkers[ uxWorker ].xTask == xCurrentTask )
+		{
+			pxReturn = &( pxWorkQueue->xWorkers[ uxWorker ] );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddItemToWorker( WorkQueue_t * const pxWorkQueue, Worker_t *pxWorker, WorkItem_t * const pxWorkItem )
+{
+	if( pxWorker == NULL )
+	{
+		pxWorker = &( pxWorkQueue->xWorkers[ pxWorkQueue->uxNextWorker ] );
+
+		( pxWorkQueue->uxNextWorker )++;
+		if( pxWorkQueue->uxNextWorker >= pxWorkQueue->uxNumberOfWorkers )
+		{
+			pxWorkQueue->uxNextWorker = ( UBaseType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	vListInsertEnd( &( pxWorker->xWorkList ), &( pxWorkItem->xWorkListItem ) );
+	( pxWorkQueue->uxOutstandingItems )++;
+}
+/*-----------------------------------------------------------*/
+
+static WorkItem_t *prvTakeItem( WorkQueue_t * const pxWorkQueue, Worker_t * const pxWorker )
+{
+WorkItem_t *pxWorkItem = NULL;
+Worker_t *pxVictim = NULL;
+UBaseType_t uxWorker, uxMostItems = ( UBaseType_t ) 0;
+
+	taskENTER_CRITICAL();
+	{
+		if( listLIST_IS_EMPTY( &( pxWorker->xWorkList ) ) == pdFALSE )
+		{
+			pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxWorker->xWorkList ) );
+		}
+		else
+		{
+			/* Nothing left in this worker's own list, so steal from the
+			worker that has the most items waiting. */
+			for( uxWorker = ( UBaseType_t ) 0; uxWorker < pxWorkQueue->uxNumberOfWorkers; uxWorker++ )
+			{
+				if( listCURRENT_LIST_LENGTH( &( pxWorkQueue->xWorkers[ uxWorker ].xWorkList ) ) > uxMostItems )
+				{
+					pxVictim = &( pxWorkQueue->xWorkers[ uxWorker ] );
+					uxMostItems = listCURRENT_LIST_LENGTH( &( pxVictim->xWorkList ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( pxVictim != NULL )
+			{
+				/* Steal from the tail - the opposite end to that used by the
+				owner of the list. */
+				pxWorkItem = ( WorkItem_t * ) listGET_LIST_ITEM_OWNER( pxVictim->xWorkList.xListEnd.pxPrevious );
+				traceWORK_ITEM_STOLEN( pxWorkQueue, pxWorkItem );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxWorkItem != NULL )
+		{
+			( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return pxWorkItem;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvProcessDelayedItems( WorkQueue_t * const pxWorkQueue )
+{
+WorkItem_t *pxWorkItem;
+TickType_t xTimeNow, xTicksToWait;
+UBaseType_t uxItemsToSignal = ( UBaseType_t ) 0;
+
+	taskENTER_CRITICAL();
+	{
+		xTimeNow = prvSampleTimeNow( pxWorkQueue, &uxItemsToSignal );
+
+		while( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItemList ) == pdFALSE )
+		{
+			if( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItemList ) > xTimeNow )
+			{
+				break;
+			}
+			else
+			{
+				pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItemList );
+				( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+				prvAddItemToWorker( pxWorkQueue, NULL, pxWorkItem );
+				uxItemsToSignal++;
+			}
+		}
+
+		if( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItemList ) == pdFALSE )
+		{
+			xTicksToWait = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItemList ) - xTimeNow;
+		}
+		else if( listLIST_IS_EMPTY( pxWorkQueue->pxOverflowDelayedItemList ) == pdFALSE )
+		{
+			/* Wake when the tick count overflows, at which point the delayed
+			lists are switched. */
+			xTicksToWait = ( TickType_t ) 0U - xTimeNow;
+		}
+		else
+		{
+			xTicksToWait = portMAX_DELAY;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	while( uxItemsToSignal > ( UBaseType_t ) 0 )
+	{
+		( void ) xSemaphoreGive( pxWorkQueue->xItemsAvailable );
+		uxItemsToSignal--;
+	}
+
+	return xTicksToWait;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvSampleTimeNow( WorkQueue_t * const pxWorkQueue, UBaseType_t * const puxItemsMoved )
+{
+TickType_t xTimeNow;
+WorkItem_t *pxWorkItem;
+List_t *pxTemp;
+
+	xTimeNow = xTaskGetTickCount();
+
+	if( xTimeNow < pxWorkQueue->xLastTime )
+	{
+		/* The tick count has overflowed.  Everything remaining in the current
+		delayed list must have become ready. */
+		while( listLIST_IS_EMPTY( pxWorkQueue->pxDelayedItemList ) == pdFALSE )
+		{
+			pxWorkItem = ( WorkItem_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxWorkQueue->pxDelayedItemList );
+			( void ) uxListRemove( &( pxWorkItem->xWorkListItem ) );
+			prvAddItemToWorker( pxWorkQueue, NULL, pxWorkItem );
+			( *puxItemsMoved )++;
+		}
+
+		pxTemp = pxWorkQueue->pxDelayedItemList;
+		pxWorkQueue->pxDelayedItemList = pxWorkQueue->pxOverflowDelayedItemList;
+		pxWorkQueue->pxOverflowDelayedItemList = pxTemp;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxWorkQueue->xLastTime = xTimeNow;
+
+	return xTimeNow;
+}
+/*-----------------------------------------------------------*/
+